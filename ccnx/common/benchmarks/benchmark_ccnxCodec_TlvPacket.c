@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * Encode and decode throughput of Interests, Content Objects and Controls.
+ *
+ * Each message is built with the public API, encoded with no signer, and the resulting wire format is
+ * decoded.  Two of the packets in codec/schema_v1/testdata are also decoded, to cover the optional headers
+ * and a validation section.  Signing is measured by benchmark_ccnxValidation.
+ *
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_JSON.h>
+
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_PacketEncoder.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_all_fields.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_keyid1_rsasha256.h>
+
+#include "ccnx_Benchmark.h"
+
+#define _benchmarkIterations 200000
+
+// The number of datagrams a receive loop typically gets from one recvmmsg() call
+#define _benchmarkBurstSize 32
+
+#define _benchmarkName "lci:/ccnx/benchmark/video/1080p/segment42"
+#define _benchmarkPayloadSize 1024
+#define _benchmarkControlJson \
+    "{\"CPI_REQUEST\":{\"SEQUENCE\":22,\"REGISTER\":{\"PREFIX\":\"lci:/howdie/stranger\",\"INTERFACE\":55,\"FLAGS\":0,\"PROTOCOL\":\"STATIC\",\"ROUTETYPE\":\"LONGEST\",\"COST\":200}}}"
+
+typedef struct {
+    PARCBuffer *packet;
+    CCNxTlvDictionary *(*create)(void);
+} _DecodeContext;
+
+typedef struct {
+    CCNxTlvDictionary *message;
+} _EncodeContext;
+
+typedef struct {
+    PARCBuffer *packets[_benchmarkBurstSize];
+} _BurstContext;
+
+typedef struct {
+    CCNxTlvDictionary *messages[_benchmarkBurstSize];
+} _EncodeBurstContext;
+
+static void
+_bufferDecode(void *context)
+{
+    _DecodeContext *decode = context;
+
+    CCNxTlvDictionary *dictionary = decode->create();
+    bool success = ccnxCodecTlvPacket_BufferDecode(decode->packet, dictionary);
+    assertTrue(success, "ccnxCodecTlvPacket_BufferDecode failed");
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
+static void
+_lazyDecode(void *context)
+{
+    _DecodeContext *decode = context;
+
+    CCNxTlvDictionary *dictionary = ccnxCodecTlvPacket_LazyDecode(decode->packet);
+    assertNotNull(dictionary, "ccnxCodecTlvPacket_LazyDecode failed");
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
+static void
+_scalarDecodeBurst(void *context)
+{
+    _BurstContext *burst = context;
+
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        CCNxTlvDictionary *dictionary = ccnxCodecTlvPacket_Decode(burst->packets[i]);
+        assertNotNull(dictionary, "ccnxCodecTlvPacket_Decode failed");
+        ccnxTlvDictionary_Release(&dictionary);
+    }
+}
+
+static void
+_batchDecodeBurst(void *context)
+{
+    _BurstContext *burst = context;
+
+    CCNxTlvDictionary *dictionaries[_benchmarkBurstSize];
+    size_t decoded = ccnxCodecTlvPacket_DecodeBatch(burst->packets, _benchmarkBurstSize, dictionaries);
+    assertTrue(decoded == _benchmarkBurstSize, "ccnxCodecTlvPacket_DecodeBatch failed");
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        ccnxTlvDictionary_Release(&dictionaries[i]);
+    }
+}
+
+static void
+_scalarEncodeBurst(void *context)
+{
+    _EncodeBurstContext *burst = context;
+
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_DictionaryEncode(burst->messages[i], NULL);
+        assertNotNull(vec, "ccnxCodecTlvPacket_DictionaryEncode failed");
+        ccnxCodecNetworkBufferIoVec_Release(&vec);
+    }
+}
+
+static void
+_batchEncodeBurst(void *context)
+{
+    _EncodeBurstContext *burst = context;
+
+    struct msghdr headers[_benchmarkBurstSize];
+    struct msghdr *messages[_benchmarkBurstSize];
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        messages[i] = &headers[i];
+    }
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_EncodeBatch(burst->messages, _benchmarkBurstSize, NULL, messages);
+    assertTrue(headers[_benchmarkBurstSize - 1].msg_iovlen > 0, "ccnxCodecTlvPacket_EncodeBatch failed");
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+static void
+_dictionaryEncode(void *context)
+{
+    _EncodeContext *encode = context;
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(encode->message, NULL);
+    assertNotNull(vec, "ccnxCodecSchemaV1PacketEncoder_DictionaryEncode failed");
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+static void
+_benchmarkDecode(CCNxBenchmark *benchmark, const char *name, uint8_t *packet, size_t length, CCNxTlvDictionary *(*create)(void))
+{
+    _DecodeContext context = {
+        .packet = parcBuffer_Wrap(packet, length, 0, length),
+        .create = create
+    };
+
+    char label[64];
+    snprintf(label, sizeof(label), "decode/%s", name);
+    ccnxBenchmark_Run(benchmark, label, _benchmarkIterations, _bufferDecode, &context, length);
+
+    snprintf(label, sizeof(label), "lazydecode/%s", name);
+    ccnxBenchmark_Run(benchmark, label, _benchmarkIterations, _lazyDecode, &context, length);
+
+    parcBuffer_Release(&context.packet);
+}
+
+/**
+ * Decode a receive burst of alternating Interests and Content Objects, one packet at a time
+ * and as a batch.  One operation is the whole burst.
+ */
+static void
+_benchmarkDecodeBurst(CCNxBenchmark *benchmark)
+{
+    _BurstContext context;
+    size_t bytes = 0;
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        if (i % 2 == 0) {
+            context.packets[i] = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields));
+        } else {
+            context.packets[i] = parcBuffer_Wrap(v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256), 0,
+                                                 sizeof(v1_content_nameA_keyid1_rsasha256));
+        }
+        bytes += parcBuffer_Remaining(context.packets[i]);
+    }
+
+    ccnxBenchmark_Run(benchmark, "decode_burst32/scalar", _benchmarkIterations / _benchmarkBurstSize, _scalarDecodeBurst, &context, bytes);
+    ccnxBenchmark_Run(benchmark, "decode_burst32/batch", _benchmarkIterations / _benchmarkBurstSize, _batchDecodeBurst, &context, bytes);
+
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        parcBuffer_Release(&context.packets[i]);
+    }
+}
+
+/**
+ * Encode a send burst of 1 KB Content Objects, one packet at a time and as a batch.
+ * One operation is the whole burst.
+ */
+static void
+_benchmarkEncodeBurst(CCNxBenchmark *benchmark)
+{
+    CCNxName *name = ccnxName_CreateFromURI(_benchmarkName);
+    PARCBuffer *payload = parcBuffer_Allocate(_benchmarkPayloadSize);
+
+    _EncodeBurstContext context;
+    size_t bytes = 0;
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        context.messages[i] = ccnxContentObject_CreateWithDataPayload(name, payload);
+        bytes += _benchmarkPayloadSize;
+    }
+
+    ccnxBenchmark_Run(benchmark, "encode_burst32/scalar", _benchmarkIterations / _benchmarkBurstSize, _scalarEncodeBurst, &context, bytes);
+    ccnxBenchmark_Run(benchmark, "encode_burst32/batch", _benchmarkIterations / _benchmarkBurstSize, _batchEncodeBurst, &context, bytes);
+
+    for (size_t i = 0; i < _benchmarkBurstSize; i++) {
+        ccnxContentObject_Release(&context.messages[i]);
+    }
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
+/**
+ * Encode `message`, then decode the wire format it produced.
+ */
+static void
+_benchmarkEncodeDecode(CCNxBenchmark *benchmark, const char *name, CCNxTlvDictionary *message, CCNxTlvDictionary *(*create)(void))
+{
+    _EncodeContext context = { .message = message };
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, NULL);
+    if (vec == NULL) {
+        ccnxBenchmark_Fail(benchmark, name, "the message does not encode");
+        return;
+    }
+
+    size_t length = ccnxCodecNetworkBufferIoVec_Length(vec);
+    PARCBuffer *wireFormat = parcBuffer_Allocate(length);
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    for (int i = 0; i < ccnxCodecNetworkBufferIoVec_GetCount(vec); i++) {
+        parcBuffer_PutArray(wireFormat, array[i].iov_len, array[i].iov_base);
+    }
+    parcBuffer_Flip(wireFormat);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+    char label[64];
+    snprintf(label, sizeof(label), "encode/%s", name);
+    ccnxBenchmark_Run(benchmark, label, _benchmarkIterations, _dictionaryEncode, &context, length);
+
+    _benchmarkDecode(benchmark, name, parcBuffer_Overlay(wireFormat, 0), length, create);
+
+    parcBuffer_Release(&wireFormat);
+}
+
+static void
+_benchmarkInterest(CCNxBenchmark *benchmark)
+{
+    CCNxName *name = ccnxName_CreateFromURI(_benchmarkName);
+    CCNxInterest *interest = ccnxInterest_CreateSimple(name);
+
+    _benchmarkEncodeDecode(benchmark, "interest", interest, ccnxCodecSchemaV1TlvDictionary_CreateInterest);
+
+    ccnxInterest_Release(&interest);
+    ccnxName_Release(&name);
+}
+
+static void
+_benchmarkContentObject(CCNxBenchmark *benchmark)
+{
+    CCNxName *name = ccnxName_CreateFromURI(_benchmarkName);
+    PARCBuffer *payload = parcBuffer_Allocate(_benchmarkPayloadSize);
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithDataPayload(name, payload);
+
+    _benchmarkEncodeDecode(benchmark, "content_object_1k", contentObject, ccnxCodecSchemaV1TlvDictionary_CreateContentObject);
+
+    ccnxContentObject_Release(&contentObject);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
+static void
+_benchmarkControl(CCNxBenchmark *benchmark)
+{
+    CCNxTlvDictionary *control = ccnxCodecSchemaV1TlvDictionary_CreateControl();
+    PARCJSON *json = parcJSON_ParseString(_benchmarkControlJson);
+    ccnxTlvDictionary_PutJson(control, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD, json);
+
+    _benchmarkEncodeDecode(benchmark, "control", control, ccnxCodecSchemaV1TlvDictionary_CreateControl);
+
+    parcJSON_Release(&json);
+    ccnxTlvDictionary_Release(&control);
+}
+
+int
+main(int argc, char *argv[])
+{
+    CCNxBenchmark *benchmark = ccnxBenchmark_Create("ccnxCodec_TlvPacket", argc, argv);
+
+    _benchmarkInterest(benchmark);
+    _benchmarkContentObject(benchmark);
+    _benchmarkControl(benchmark);
+
+    _benchmarkDecode(benchmark, "interest_all_fields", v1_interest_all_fields, sizeof(v1_interest_all_fields),
+                     ccnxCodecSchemaV1TlvDictionary_CreateInterest);
+    _benchmarkDecode(benchmark, "content_nameA_keyid1_rsasha256", v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256),
+                     ccnxCodecSchemaV1TlvDictionary_CreateContentObject);
+
+    _benchmarkDecodeBurst(benchmark);
+    _benchmarkEncodeBurst(benchmark);
+
+    return ccnxBenchmark_Destroy(&benchmark);
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * CRC32C and SHA256 digests, and encoding a Content Object signed with CRC32C, HMAC-SHA256 and RSA-SHA256.
+ *
+ * The RSA-SHA256 signer is read from test_rsa.p12, which the build copies next to this program.
+ *
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/security/parc_CryptoHasher.h>
+#include <parc/security/parc_PublicKeySignerPkcs12Store.h>
+#include <parc/security/parc_Signer.h>
+
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_PacketEncoder.h>
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
+#include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+#include <ccnx/common/validation/ccnxValidation_RsaSha256.h>
+
+#include "ccnx_Benchmark.h"
+
+#define _benchmarkName "lci:/ccnx/benchmark/video/1080p/segment42"
+#define _benchmarkPayloadSize 1024
+
+#define _rsaKeystore "test_rsa.p12"
+#define _rsaKeystorePassword "blueberry"
+
+typedef struct {
+    PARCCryptoHasher *hasher;
+    PARCBuffer *buffer;
+} _DigestContext;
+
+typedef struct {
+    CCNxContentObject *prototype;
+    PARCSigner *signer;
+} _SignContext;
+
+static void
+_digest(void *context)
+{
+    _DigestContext *data = context;
+
+    parcCryptoHasher_Init(data->hasher);
+    parcCryptoHasher_UpdateBuffer(data->hasher, data->buffer);
+    PARCCryptoHash *hash = parcCryptoHasher_Finalize(data->hasher);
+    parcCryptoHash_Release(&hash);
+}
+
+/*
+ * The encoder stores the signature in the dictionary it encodes, so each call signs a fresh shallow copy
+ * of the prototype.
+ */
+static void
+_signAndEncode(void *context)
+{
+    _SignContext *data = context;
+
+    CCNxTlvDictionary *message = ccnxTlvDictionary_ShallowCopy(data->prototype);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, data->signer);
+    assertNotNull(vec, "ccnxCodecSchemaV1PacketEncoder_DictionaryEncode failed");
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxTlvDictionary_Release(&message);
+}
+
+static void
+_benchmarkDigest(CCNxBenchmark *benchmark, const char *label, PARCCryptoHashType hashType, size_t iterations)
+{
+    _DigestContext context = {
+        .hasher = parcCryptoHasher_Create(hashType),
+        .buffer = parcBuffer_Allocate(_benchmarkPayloadSize)
+    };
+
+    ccnxBenchmark_Run(benchmark, label, iterations, _digest, &context, _benchmarkPayloadSize);
+
+    parcBuffer_Release(&context.buffer);
+    parcCryptoHasher_Release(&context.hasher);
+}
+
+static CCNxContentObject *
+_createContentObject(void)
+{
+    CCNxName *name = ccnxName_CreateFromURI(_benchmarkName);
+    PARCBuffer *payload = parcBuffer_Allocate(_benchmarkPayloadSize);
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithDataPayload(name, payload);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+    return contentObject;
+}
+
+static void
+_benchmarkSign(CCNxBenchmark *benchmark, const char *label, CCNxContentObject *prototype, PARCSigner *signer, size_t iterations)
+{
+    _SignContext context = {
+        .prototype = prototype,
+        .signer    = signer
+    };
+
+    CCNxTlvDictionary *message = ccnxTlvDictionary_ShallowCopy(prototype);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, signer);
+    ccnxTlvDictionary_Release(&message);
+    if (vec == NULL) {
+        ccnxBenchmark_Fail(benchmark, label, "the message does not encode");
+        return;
+    }
+    size_t length = ccnxCodecNetworkBufferIoVec_Length(vec);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+    ccnxBenchmark_Run(benchmark, label, iterations, _signAndEncode, &context, length);
+}
+
+static void
+_benchmarkSignCRC32C(CCNxBenchmark *benchmark)
+{
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+    CCNxContentObject *contentObject = _createContentObject();
+    ccnxValidationCRC32C_Set(contentObject);
+
+    _benchmarkSign(benchmark, "sign/crc32c_content_object_1k", contentObject, signer, 200000);
+
+    ccnxContentObject_Release(&contentObject);
+    parcSigner_Release(&signer);
+}
+
+static void
+_benchmarkSignHmacSha256(CCNxBenchmark *benchmark)
+{
+    PARCBuffer *secretKey = parcBuffer_WrapCString("abcdefghijklmnopqrstuvwxyx");
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(secretKey);
+    parcBuffer_Release(&secretKey);
+
+    CCNxContentObject *contentObject = _createContentObject();
+    const PARCBuffer *keyId = parcCryptoHash_GetDigest(parcSigner_GetVerifierKeyDigest(signer));
+    ccnxValidationHmacSha256_Set(contentObject, keyId);
+
+    _benchmarkSign(benchmark, "sign/hmac_sha256_content_object_1k", contentObject, signer, 200000);
+
+    ccnxContentObject_Release(&contentObject);
+    parcSigner_Release(&signer);
+}
+
+static void
+_benchmarkSignRsaSha256(CCNxBenchmark *benchmark)
+{
+    const char *label = "sign/rsa_sha256_content_object_1k";
+    if (!ccnxBenchmark_IsSelected(benchmark, label)) {
+        return;
+    }
+    if (access(_rsaKeystore, R_OK) != 0) {
+        ccnxBenchmark_Fail(benchmark, label, "cannot read " _rsaKeystore);
+        return;
+    }
+
+    PARCSigner *signer = parcSigner_Create(parcPublicKeySignerPkcs12Store_Open(_rsaKeystore, _rsaKeystorePassword, PARC_HASH_SHA256));
+    CCNxContentObject *contentObject = _createContentObject();
+    const PARCBuffer *keyId = parcCryptoHash_GetDigest(parcSigner_GetVerifierKeyDigest(signer));
+    ccnxValidationRsaSha256_Set(contentObject, keyId, NULL);
+
+    _benchmarkSign(benchmark, label, contentObject, signer, 2000);
+
+    ccnxContentObject_Release(&contentObject);
+    parcSigner_Release(&signer);
+}
+
+int
+main(int argc, char *argv[])
+{
+    CCNxBenchmark *benchmark = ccnxBenchmark_Create("ccnxValidation", argc, argv);
+
+    _benchmarkDigest(benchmark, "digest/crc32c_1k", PARC_HASH_CRC32C, 1000000);
+    _benchmarkDigest(benchmark, "digest/sha256_1k", PARC_HASH_SHA256, 200000);
+
+    _benchmarkSignCRC32C(benchmark);
+    _benchmarkSignHmacSha256(benchmark);
+    _benchmarkSignRsaSha256(benchmark);
+
+    return ccnxBenchmark_Destroy(&benchmark);
+}
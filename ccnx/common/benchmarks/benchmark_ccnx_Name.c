@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * Name parsing, comparison and hashing, and longest prefix match with CCNxNameIndex.
+ *
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <ccnx/common/ccnx_Name.h>
+#include <ccnx/common/ccnx_NameIndex.h>
+
+#include "ccnx_Benchmark.h"
+
+#define _benchmarkIterations 1000000
+
+#define _shortUri "lci:/a/b"
+#define _typicalUri "lci:/ccnx/benchmark/video/1080p/segment42/chunk7"
+#define _typicalUriPrefix "lci:/ccnx/benchmark/video"
+#define _differentLastUri "lci:/ccnx/benchmark/video/1080p/segment42/chunk8"
+
+#define _indexSize 100000
+
+typedef struct {
+    const char *uri;
+    PARCBuffer *encoded;
+    CCNxName *name;
+    CCNxName *other;
+    CCNxNameIndex *index;
+} _NameContext;
+
+// Results are accumulated here so the compiler cannot discard the operations
+static volatile size_t _sink;
+
+static void
+_createFromURI(void *context)
+{
+    _NameContext *data = context;
+    CCNxName *name = ccnxName_CreateFromURI(data->uri);
+    assertNotNull(name, "ccnxName_CreateFromURI failed for %s", data->uri);
+    ccnxName_Release(&name);
+}
+
+static void
+_createFromEncodedSegments(void *context)
+{
+    _NameContext *data = context;
+    CCNxName *name = ccnxName_CreateFromEncodedSegments(data->encoded);
+    assertNotNull(name, "ccnxName_CreateFromEncodedSegments failed");
+    ccnxName_Release(&name);
+}
+
+static void
+_toString(void *context)
+{
+    _NameContext *data = context;
+    char *string = ccnxName_ToString(data->name);
+    parcMemory_Deallocate((void **) &string);
+}
+
+static void
+_copy(void *context)
+{
+    _NameContext *data = context;
+    CCNxName *copy = ccnxName_Copy(data->name);
+    ccnxName_Release(&copy);
+}
+
+static void
+_equals(void *context)
+{
+    _NameContext *data = context;
+    _sink += ccnxName_Equals(data->name, data->other);
+}
+
+static void
+_compare(void *context)
+{
+    _NameContext *data = context;
+    _sink += ccnxName_Compare(data->name, data->other);
+}
+
+static void
+_startsWith(void *context)
+{
+    _NameContext *data = context;
+    _sink += ccnxName_StartsWith(data->name, data->other);
+}
+
+static void
+_hashCode(void *context)
+{
+    _NameContext *data = context;
+    _sink += ccnxName_HashCode(data->name);
+}
+
+static void
+_leftMostHashCode(void *context)
+{
+    _NameContext *data = context;
+    _sink += ccnxName_LeftMostHashCode(data->name, 3);
+}
+
+static void
+_longestPrefixMatch(void *context)
+{
+    _NameContext *data = context;
+    _sink += (ccnxNameIndex_LongestPrefixMatch(data->index, data->name, NULL) != NULL);
+}
+
+static void
+_benchmarkParse(CCNxBenchmark *benchmark)
+{
+    _NameContext context = { .uri = _shortUri };
+    ccnxBenchmark_Run(benchmark, "parse/uri_2_segments", _benchmarkIterations, _createFromURI, &context, 0);
+
+    context.uri = _typicalUri;
+    ccnxBenchmark_Run(benchmark, "parse/uri_7_segments", _benchmarkIterations, _createFromURI, &context, 0);
+
+    CCNxName *name = ccnxName_CreateFromURI(_typicalUri);
+    size_t length = ccnxName_GetEncodedLength(name);
+    context.encoded = parcBuffer_Wrap((void *) ccnxName_GetEncodedSegments(name), length, 0, length);
+    ccnxBenchmark_Run(benchmark, "parse/encoded_7_segments", _benchmarkIterations, _createFromEncodedSegments, &context, length);
+
+    context.name = name;
+    ccnxBenchmark_Run(benchmark, "format/to_string_7_segments", _benchmarkIterations, _toString, &context, 0);
+    ccnxBenchmark_Run(benchmark, "format/copy_7_segments", _benchmarkIterations, _copy, &context, 0);
+
+    parcBuffer_Release(&context.encoded);
+    ccnxName_Release(&name);
+}
+
+static void
+_benchmarkCompare(CCNxBenchmark *benchmark)
+{
+    _NameContext context = {
+        .name  = ccnxName_CreateFromURI(_typicalUri),
+        .other = ccnxName_CreateFromURI(_typicalUri)
+    };
+    ccnxBenchmark_Run(benchmark, "compare/equals_equal", _benchmarkIterations, _equals, &context, 0);
+    ccnxBenchmark_Run(benchmark, "compare/compare_equal", _benchmarkIterations, _compare, &context, 0);
+    ccnxBenchmark_Run(benchmark, "hash/hash_code", _benchmarkIterations, _hashCode, &context, 0);
+    ccnxBenchmark_Run(benchmark, "hash/left_most_hash_code", _benchmarkIterations, _leftMostHashCode, &context, 0);
+    ccnxName_Release(&context.other);
+
+    context.other = ccnxName_CreateFromURI(_differentLastUri);
+    ccnxBenchmark_Run(benchmark, "compare/equals_last_differs", _benchmarkIterations, _equals, &context, 0);
+    ccnxBenchmark_Run(benchmark, "compare/compare_last_differs", _benchmarkIterations, _compare, &context, 0);
+    ccnxName_Release(&context.other);
+
+    context.other = ccnxName_CreateFromURI(_typicalUriPrefix);
+    ccnxBenchmark_Run(benchmark, "compare/starts_with", _benchmarkIterations, _startsWith, &context, 0);
+    ccnxName_Release(&context.other);
+
+    ccnxName_Release(&context.name);
+}
+
+static void
+_benchmarkIndex(CCNxBenchmark *benchmark)
+{
+    if (!ccnxBenchmark_IsSelected(benchmark, "index/longest_prefix_match")) {
+        return;
+    }
+
+    _NameContext context = { .index = ccnxNameIndex_Create() };
+    char uri[64];
+    for (unsigned i = 0; i < _indexSize; i++) {
+        snprintf(uri, sizeof(uri), "lci:/ccnx/route%u/%u", i % 1000, i);
+        CCNxName *route = ccnxName_CreateFromURI(uri);
+        ccnxNameIndex_Insert(context.index, route, NULL);
+        ccnxName_Release(&route);
+    }
+
+    context.name = ccnxName_CreateFromURI("lci:/ccnx/route42/5042/video/segment3/chunk7");
+    ccnxBenchmark_Run(benchmark, "index/longest_prefix_match_hit", _benchmarkIterations, _longestPrefixMatch, &context, 0);
+    ccnxName_Release(&context.name);
+
+    context.name = ccnxName_CreateFromURI("lci:/ccnx/route42/unrouted/video/segment3/chunk7");
+    ccnxBenchmark_Run(benchmark, "index/longest_prefix_match_miss", _benchmarkIterations, _longestPrefixMatch, &context, 0);
+    ccnxName_Release(&context.name);
+
+    ccnxNameIndex_Release(&context.index);
+}
+
+int
+main(int argc, char *argv[])
+{
+    CCNxBenchmark *benchmark = ccnxBenchmark_Create("ccnx_Name", argc, argv);
+
+    _benchmarkParse(benchmark);
+    _benchmarkCompare(benchmark);
+    _benchmarkIndex(benchmark);
+
+    return ccnxBenchmark_Destroy(&benchmark);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * CCNxTlvDictionary create, put and get, using the schema V1 Content Object layout.
+ *
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+#include <ccnx/common/internal/ccnx_TlvDictionary.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+
+#include "ccnx_Benchmark.h"
+
+#define _benchmarkIterations 1000000
+
+typedef struct {
+    PARCBuffer *keyId;
+    PARCBuffer *payload;
+    PARCBuffer *unknown;
+    CCNxName *name;
+    CCNxTlvDictionary *dictionary;
+} _DictionaryContext;
+
+// Results are accumulated here so the compiler cannot discard the operations
+static volatile size_t _sink;
+
+static void
+_put(CCNxTlvDictionary *dictionary, const _DictionaryContext *data)
+{
+    ccnxTlvDictionary_PutName(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME, data->name);
+    ccnxTlvDictionary_PutBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD, data->payload);
+    ccnxTlvDictionary_PutBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYID, data->keyId);
+    ccnxTlvDictionary_PutInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOADTYPE, 0);
+    ccnxTlvDictionary_PutInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_EXPIRY_TIME, 1000);
+    ccnxTlvDictionary_PutInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE, 2);
+    ccnxTlvDictionary_PutListBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_Lists_MESSAGE_LIST, 0x1000, data->unknown);
+    ccnxTlvDictionary_PutListBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_Lists_MESSAGE_LIST, 0x1001, data->unknown);
+}
+
+static void
+_get(const CCNxTlvDictionary *dictionary)
+{
+    _sink += (size_t) ccnxTlvDictionary_GetName(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME);
+    _sink += (size_t) ccnxTlvDictionary_GetBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+    _sink += (size_t) ccnxTlvDictionary_GetBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYID);
+    _sink += ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOADTYPE);
+    _sink += ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_EXPIRY_TIME);
+    _sink += ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE);
+    _sink += (size_t) ccnxTlvDictionary_ListGetByType(dictionary, CCNxCodecSchemaV1TlvDictionary_Lists_MESSAGE_LIST, 0x1001);
+}
+
+static void
+_createRelease(void *context)
+{
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
+static void
+_putGetRelease(void *context)
+{
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    _put(dictionary, context);
+    _get(dictionary);
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
+// A packet with several vendor or experimental fixed headers
+static void
+_customHeaders(void *context)
+{
+    _DictionaryContext *data = context;
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    for (uint32_t key = 0x1000; key < 0x1008; key++) {
+        ccnxTlvDictionary_PutListBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_Lists_HEADERS, key, data->unknown);
+    }
+
+    CCNxTlvDictionaryListIterator iterator = ccnxTlvDictionary_ListIterator(dictionary, CCNxCodecSchemaV1TlvDictionary_Lists_HEADERS);
+    PARCBuffer *buffer;
+    uint32_t key;
+    while (ccnxTlvDictionaryListIterator_Next(&iterator, &buffer, &key)) {
+        _sink += key;
+    }
+    _sink += (size_t) ccnxTlvDictionary_ListGetByType(dictionary, CCNxCodecSchemaV1TlvDictionary_Lists_HEADERS, 0x1000);
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
+static void
+_getOnly(void *context)
+{
+    _DictionaryContext *data = context;
+    _get(data->dictionary);
+}
+
+int
+main(int argc, char *argv[])
+{
+    CCNxBenchmark *benchmark = ccnxBenchmark_Create("ccnx_TlvDictionary", argc, argv);
+
+    _DictionaryContext context = {
+        .keyId   = parcBuffer_Allocate(32),
+        .payload = parcBuffer_Allocate(1024),
+        .unknown = parcBuffer_Allocate(8),
+        .name    = ccnxName_CreateFromURI("lci:/ccnx/benchmark/video/1080p/segment42"),
+    };
+    context.dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    _put(context.dictionary, &context);
+
+    ccnxBenchmark_Run(benchmark, "dictionary/create_release", _benchmarkIterations, _createRelease, &context, 0);
+    ccnxBenchmark_Run(benchmark, "dictionary/create_put8_get7_release", _benchmarkIterations, _putGetRelease, &context, 0);
+    ccnxBenchmark_Run(benchmark, "dictionary/get7", _benchmarkIterations, _getOnly, &context, 0);
+    ccnxBenchmark_Run(benchmark, "dictionary/put_headers8_iterate_release", _benchmarkIterations, _customHeaders, &context, 0);
+
+    ccnxTlvDictionary_SetThreadPoolCapacity(16);
+    ccnxBenchmark_Run(benchmark, "dictionary/create_release_pooled", _benchmarkIterations, _createRelease, &context, 0);
+    ccnxBenchmark_Run(benchmark, "dictionary/create_put8_get7_release_pooled", _benchmarkIterations, _putGetRelease, &context, 0);
+    ccnxBenchmark_Run(benchmark, "dictionary/put_headers8_iterate_release_pooled", _benchmarkIterations, _customHeaders, &context, 0);
+    ccnxTlvDictionary_SetThreadPoolCapacity(0);
+
+    ccnxTlvDictionary_Release(&context.dictionary);
+    ccnxName_Release(&context.name);
+    parcBuffer_Release(&context.unknown);
+    parcBuffer_Release(&context.payload);
+    parcBuffer_Release(&context.keyId);
+
+    return ccnxBenchmark_Destroy(&benchmark);
+}
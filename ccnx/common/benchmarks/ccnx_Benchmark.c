@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+#include "ccnx_Benchmark.h"
+
+struct ccnx_benchmark {
+    const char *suite;
+    bool json;
+    size_t iterations;      // 0 means use each operation's default
+
+    int filterCount;
+    char **filters;
+
+    unsigned failures;
+};
+
+/*
+ * A memory provider that counts allocator calls and passes them through to the memory provider
+ * that was in use when the operation started.
+ */
+static const PARCMemoryInterface *_underlyingMemory;
+static size_t _allocationCount;
+
+static void *
+_countingAllocate(size_t size)
+{
+    _allocationCount++;
+    return ((void *(*)(size_t))_underlyingMemory->Allocate)(size);
+}
+
+static void *
+_countingAllocateAndClear(size_t size)
+{
+    _allocationCount++;
+    return ((void *(*)(size_t))_underlyingMemory->AllocateAndClear)(size);
+}
+
+static int
+_countingMemAlign(void **pointer, size_t alignment, size_t size)
+{
+    _allocationCount++;
+    return ((int (*)(void **, size_t, size_t))_underlyingMemory->MemAlign)(pointer, alignment, size);
+}
+
+static void
+_countingDeallocate(void **pointer)
+{
+    ((void (*)(void **))_underlyingMemory->Deallocate)(pointer);
+}
+
+static void *
+_countingReallocate(void *pointer, size_t newSize)
+{
+    _allocationCount++;
+    return ((void *(*)(void *, size_t))_underlyingMemory->Reallocate)(pointer, newSize);
+}
+
+static char *
+_countingStringDuplicate(const char *string, size_t length)
+{
+    _allocationCount++;
+    return ((char *(*)(const char *, size_t))_underlyingMemory->StringDuplicate)(string, length);
+}
+
+static uint32_t
+_countingOutstanding(void)
+{
+    return ((uint32_t (*)(void))_underlyingMemory->Outstanding)();
+}
+
+static PARCMemoryInterface _countingMemory = {
+    .Allocate         = (uintptr_t) _countingAllocate,
+    .AllocateAndClear = (uintptr_t) _countingAllocateAndClear,
+    .MemAlign         = (uintptr_t) _countingMemAlign,
+    .Deallocate       = (uintptr_t) _countingDeallocate,
+    .Reallocate       = (uintptr_t) _countingReallocate,
+    .StringDuplicate  = (uintptr_t) _countingStringDuplicate,
+    .Outstanding      = (uintptr_t) _countingOutstanding
+};
+
+static void
+_usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [--json] [--iterations N] [filter ...]\n", program);
+    exit(EXIT_FAILURE);
+}
+
+CCNxBenchmark *
+ccnxBenchmark_Create(const char *suite, int argc, char *argv[])
+{
+    CCNxBenchmark *benchmark = parcMemory_AllocateAndClear(sizeof(CCNxBenchmark));
+    assertNotNull(benchmark, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(CCNxBenchmark));
+
+    benchmark->suite = suite;
+    benchmark->filters = parcMemory_AllocateAndClear((argc + 1) * sizeof(char *));
+    assertNotNull(benchmark->filters, "parcMemory_AllocateAndClear(%zu) returned NULL", (argc + 1) * sizeof(char *));
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            benchmark->json = true;
+        } else if (strcmp(argv[i], "--iterations") == 0) {
+            if (++i == argc) {
+                _usage(argv[0]);
+            }
+            char *end;
+            benchmark->iterations = strtoul(argv[i], &end, 10);
+            if (*end != '\0' || benchmark->iterations == 0) {
+                _usage(argv[0]);
+            }
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            _usage(argv[0]);
+        } else {
+            benchmark->filters[benchmark->filterCount++] = argv[i];
+        }
+    }
+
+    if (!benchmark->json) {
+        printf("%-48s %12s %12s %14s %12s\n", suite, "iterations", "ns/op", "ops/s", "allocs/op");
+    }
+    return benchmark;
+}
+
+int
+ccnxBenchmark_Destroy(CCNxBenchmark **benchmarkPtr)
+{
+    CCNxBenchmark *benchmark = *benchmarkPtr;
+    int status = (benchmark->failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    parcMemory_Deallocate((void **) &benchmark->filters);
+    parcMemory_Deallocate((void **) &benchmark);
+    *benchmarkPtr = NULL;
+    return status;
+}
+
+bool
+ccnxBenchmark_IsSelected(const CCNxBenchmark *benchmark, const char *name)
+{
+    if (benchmark->filterCount == 0) {
+        return true;
+    }
+    for (int i = 0; i < benchmark->filterCount; i++) {
+        if (strstr(name, benchmark->filters[i]) != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static double
+_elapsedNanoseconds(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1E9 + (end->tv_nsec - start->tv_nsec);
+}
+
+void
+ccnxBenchmark_Run(CCNxBenchmark *benchmark, const char *name, size_t iterations,
+                  CCNxBenchmarkOperation *operation, void *context, size_t bytesPerOperation)
+{
+    if (!ccnxBenchmark_IsSelected(benchmark, name)) {
+        return;
+    }
+    if (benchmark->iterations > 0) {
+        iterations = benchmark->iterations;
+    }
+
+    size_t warmup = iterations / 10 + 1;
+    for (size_t i = 0; i < warmup; i++) {
+        operation(context);
+    }
+
+    _underlyingMemory = parcMemory_SetInterface(&_countingMemory);
+    if (_underlyingMemory == NULL) {
+        _underlyingMemory = &PARCStdlibMemoryAsPARCMemory;
+    }
+    _allocationCount = 0;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; i < iterations; i++) {
+        operation(context);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    size_t allocations = _allocationCount;
+    parcMemory_SetInterface(_underlyingMemory);
+
+    double nsPerOperation = _elapsedNanoseconds(&start, &end) / iterations;
+    double operationsPerSecond = (nsPerOperation > 0) ? 1E9 / nsPerOperation : 0;
+    double allocationsPerOperation = (double) allocations / iterations;
+
+    if (benchmark->json) {
+        printf("{\"suite\":\"%s\",\"benchmark\":\"%s\",\"iterations\":%zu,\"ns_per_op\":%.1f,\"ops_per_sec\":%.1f,\"allocs_per_op\":%.2f,\"bytes_per_op\":%zu}\n",
+               benchmark->suite, name, iterations, nsPerOperation, operationsPerSecond, allocationsPerOperation, bytesPerOperation);
+    } else {
+        printf("%-48s %12zu %12.1f %14.1f %12.2f\n", name, iterations, nsPerOperation, operationsPerSecond, allocationsPerOperation);
+    }
+    fflush(stdout);
+}
+
+void
+ccnxBenchmark_Fail(CCNxBenchmark *benchmark, const char *name, const char *reason)
+{
+    benchmark->failures++;
+    if (benchmark->json) {
+        printf("{\"suite\":\"%s\",\"benchmark\":\"%s\",\"error\":\"%s\"}\n", benchmark->suite, name, reason);
+    } else {
+        printf("%-48s FAILED: %s\n", name, reason);
+    }
+    fflush(stdout);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file ccnx_Benchmark.h
+ * @brief A minimal harness for the libccnx-common micro benchmarks.
+ *
+ * Each benchmark program creates a CCNxBenchmark from its command line, then calls
+ * {@link ccnxBenchmark_Run} once per operation it measures.  An operation is run a number of times
+ * for warm up, then timed.  While an operation is timed the PARCMemory interface is replaced with one
+ * that counts allocator calls, so the report includes allocations per operation.
+ *
+ * The command line options are common to every benchmark program:
+ *
+ *   - `--json` Write one JSON object per operation, one per line, instead of a table.
+ *   - `--iterations N` Run each operation N times instead of its default count.
+ *   - Any other argument is a filter.  Only the operations whose name contains one of the filters are run.
+ *
+ * A JSON line looks like
+ * @code
+ * {"suite":"ccnxCodec_TlvPacket","benchmark":"decode/interest_all_fields","iterations":100000,"ns_per_op":812.4,"ops_per_sec":1230920.1,"allocs_per_op":11.00,"bytes_per_op":142}
+ * @endcode
+ *
+ * For the codec benchmarks an operation is one packet, so `ops_per_sec` is packets per second.
+ *
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libccnx_ccnx_Benchmark_h
+#define libccnx_ccnx_Benchmark_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+struct ccnx_benchmark;
+/**
+ * @typedef CCNxBenchmark
+ * @brief The options and results of one benchmark program.
+ */
+typedef struct ccnx_benchmark CCNxBenchmark;
+
+/**
+ * One operation under test.  It is called `iterations` times by {@link ccnxBenchmark_Run}.
+ *
+ * @param [in] context The context given to `ccnxBenchmark_Run`.
+ */
+typedef void (CCNxBenchmarkOperation)(void *context);
+
+/**
+ * Create a benchmark from the program's command line.
+ *
+ * @param [in] suite The name of the benchmark program, reported with every result.
+ * @param [in] argc The argument count from `main`.
+ * @param [in] argv The arguments from `main`.
+ *
+ * @return A new CCNxBenchmark, which must be destroyed with {@link ccnxBenchmark_Destroy}.
+ *
+ * Example:
+ * @code
+ * int
+ * main(int argc, char *argv[])
+ * {
+ *     CCNxBenchmark *benchmark = ccnxBenchmark_Create("ccnx_Name", argc, argv);
+ *     ccnxBenchmark_Run(benchmark, "parse/uri", 100000, _parseUri, NULL, 0);
+ *     return ccnxBenchmark_Destroy(&benchmark);
+ * }
+ * @endcode
+ */
+CCNxBenchmark *ccnxBenchmark_Create(const char *suite, int argc, char *argv[]);
+
+/**
+ * Destroy the benchmark.
+ *
+ * @param [in,out] benchmarkPtr A pointer to the benchmark, set to NULL.
+ *
+ * @return An exit status for `main`: 0 if every operation ran, otherwise 1.
+ */
+int ccnxBenchmark_Destroy(CCNxBenchmark **benchmarkPtr);
+
+/**
+ * Determine if the operation `name` passes the command line filters.
+ *
+ * Use this to skip expensive set up for operations that will not be run.
+ *
+ * @param [in] benchmark The benchmark.
+ * @param [in] name The name of the operation.
+ *
+ * @return true The operation will be run by `ccnxBenchmark_Run`.
+ * @return false The operation is filtered out.
+ */
+bool ccnxBenchmark_IsSelected(const CCNxBenchmark *benchmark, const char *name);
+
+/**
+ * Time an operation and report the result.
+ *
+ * The operation is called `iterations / 10` times to warm up, then `iterations` times under the clock
+ * and the counting memory interface.  `iterations` is replaced by the `--iterations` option, if given.
+ *
+ * @param [in] benchmark The benchmark.
+ * @param [in] name The name of the operation.  Names are "<group>/<case>", e.g. "decode/interest".
+ * @param [in] iterations The default number of timed calls.
+ * @param [in] operation The operation to call.
+ * @param [in] context Passed to every call of the operation.
+ * @param [in] bytesPerOperation The number of wire format bytes handled by one call, or 0.
+ */
+void ccnxBenchmark_Run(CCNxBenchmark *benchmark, const char *name, size_t iterations,
+                       CCNxBenchmarkOperation *operation, void *context, size_t bytesPerOperation);
+
+/**
+ * Record that an operation could not be set up.  The benchmark program will exit with a failure status.
+ *
+ * @param [in] benchmark The benchmark.
+ * @param [in] name The name of the operation.
+ * @param [in] reason Why the operation could not be run.
+ */
+void ccnxBenchmark_Fail(CCNxBenchmark *benchmark, const char *name, const char *reason);
+#endif // libccnx_ccnx_Benchmark_h
@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/security/parc_CryptoHasher.h>
+
+#include <ccnx/common/ccnx_NameSegmentNumber.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+
+#include <ccnx/common/ccnx_ChunkingPipeline.h>
+
+/*
+ * The number of chunks each thread gets in a batch.  A batch of a file is read in one call,
+ * so this also sets how much of a file is buffered at a time.
+ */
+#define _chunksPerThread 16
+
+typedef struct ccnx_chunking_pipeline_batch {
+    CCNxContentObject **objects;
+    uint8_t *digests;
+    size_t count;
+
+    // The next chunk to encode, taken with an atomic add by every thread working on the batch
+    size_t next;
+    bool failed;
+} _CCNxChunkingPipelineBatch;
+
+typedef struct ccnx_chunking_pipeline_worker {
+    CCNxChunkingPipeline *pipeline;
+    pthread_t thread;
+    PARCSigner *signer;
+} _CCNxChunkingPipelineWorker;
+
+struct ccnx_chunking_pipeline {
+    size_t chunkSize;
+    size_t batchChunks;
+
+    // The signer given to Create, and the calling thread's view of it (see _ccnxChunkingPipeline_CreateThreadSigner)
+    PARCSigner *signer;
+    PARCSigner *threadSigner;
+    pthread_mutex_t signerLock;
+
+    // The Content Objects and digests of the current batch
+    CCNxContentObject **objects;
+    uint8_t *digests;
+
+    size_t workerCount;
+    _CCNxChunkingPipelineWorker *workers;
+
+    // Protects everything below
+    pthread_mutex_t lock;
+    pthread_cond_t batchReady;
+    pthread_cond_t batchDone;
+    _CCNxChunkingPipelineBatch *batch;
+    uint64_t generation;
+    size_t busyWorkers;
+    bool shutdown;
+};
+
+// ================================================================================
+// Thread signers
+//
+// The codec signs with parcSigner_GetCryptoHasher() followed by parcSigner_SignDigest(), so every
+// thread sharing one PARCSigner would share its hasher.  Each thread instead signs through a
+// PARCSigner of its own that hashes with a private hasher and passes the digest to the shared signer.
+
+typedef struct ccnx_chunking_pipeline_signer {
+    PARCSigner *signer;
+    PARCCryptoHasher *hasher;
+} _CCNxChunkingPipelineSigner;
+
+static void
+_ccnxChunkingPipelineSigner_Destroy(PARCSigningInterface **interfacePtr)
+{
+    PARCSigningInterface *interface = *interfacePtr;
+    _CCNxChunkingPipelineSigner *threadSigner = interface->interfaceContext;
+
+    parcCryptoHasher_Release(&threadSigner->hasher);
+    parcSigner_Release(&threadSigner->signer);
+
+    parcMemory_Deallocate((void **) &threadSigner);
+    parcMemory_Deallocate((void **) &interface);
+    *interfacePtr = NULL;
+}
+
+static PARCCryptoHasher *
+_ccnxChunkingPipelineSigner_GetCryptoHasher(void *interfaceContext)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return threadSigner->hasher;
+}
+
+static PARCSignature *
+_ccnxChunkingPipelineSigner_SignDigest(void *interfaceContext, const PARCCryptoHash *cryptoHash)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return parcSigner_SignDigest(threadSigner->signer, cryptoHash);
+}
+
+static PARCSigningAlgorithm
+_ccnxChunkingPipelineSigner_GetSigningAlgorithm(void *interfaceContext)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return parcSigner_GetSigningAlgorithm(threadSigner->signer);
+}
+
+static PARCCryptoHashType
+_ccnxChunkingPipelineSigner_GetCryptoHashType(void *interfaceContext)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return parcSigner_GetCryptoHashType(threadSigner->signer);
+}
+
+// The key and certificate getters go to the shared signer, which the validation encoder asks for
+// the key to size and fill in the signature block.
+
+static PARCCryptoHash *
+_ccnxChunkingPipelineSigner_GetVerifierKeyDigest(void *interfaceContext)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return parcSigner_GetVerifierKeyDigest(threadSigner->signer);
+}
+
+static PARCCryptoHash *
+_ccnxChunkingPipelineSigner_GetCertificateDigest(void *interfaceContext)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return parcSigner_GetCertificateDigest(threadSigner->signer);
+}
+
+static PARCBuffer *
+_ccnxChunkingPipelineSigner_GetDEREncodedCertificate(void *interfaceContext)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return parcSigner_GetDEREncodedCertificate(threadSigner->signer);
+}
+
+static PARCBuffer *
+_ccnxChunkingPipelineSigner_GetDEREncodedPublicKey(void *interfaceContext)
+{
+    _CCNxChunkingPipelineSigner *threadSigner = interfaceContext;
+    return parcSigner_GetDEREncodedPublicKey(threadSigner->signer);
+}
+
+static const PARCSigningInterface _ccnxChunkingPipelineSigner_Template = {
+    .interfaceContext         = NULL,
+    .Destroy                  = _ccnxChunkingPipelineSigner_Destroy,
+    .GetVerifierKeyDigest     = _ccnxChunkingPipelineSigner_GetVerifierKeyDigest,
+    .GetCertificateDigest     = _ccnxChunkingPipelineSigner_GetCertificateDigest,
+    .GetDEREncodedCertificate = _ccnxChunkingPipelineSigner_GetDEREncodedCertificate,
+    .GetDEREncodedPublicKey   = _ccnxChunkingPipelineSigner_GetDEREncodedPublicKey,
+    .GetCryptoHasher          = _ccnxChunkingPipelineSigner_GetCryptoHasher,
+    .SignDigest               = _ccnxChunkingPipelineSigner_SignDigest,
+    .GetSigningAlgorithm      = _ccnxChunkingPipelineSigner_GetSigningAlgorithm,
+    .GetCryptoHashType        = _ccnxChunkingPipelineSigner_GetCryptoHashType
+};
+
+/**
+ * Creates a signer for one thread that hashes on its own and signs with `signer`.
+ *
+ * A keyed signer's hasher holds its key, so it cannot be replaced by a plain hasher.
+ *
+ * @return NULL `signer` is NULL or keyed
+ */
+static PARCSigner *
+_ccnxChunkingPipeline_CreateThreadSigner(PARCSigner *signer)
+{
+    if (signer == NULL || parcSigner_GetSigningAlgorithm(signer) == PARCSigningAlgorithm_HMAC) {
+        return NULL;
+    }
+
+    _CCNxChunkingPipelineSigner *threadSigner = parcMemory_AllocateAndClear(sizeof(_CCNxChunkingPipelineSigner));
+    assertNotNull(threadSigner, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxChunkingPipelineSigner));
+    threadSigner->signer = parcSigner_Acquire(signer);
+    threadSigner->hasher = parcCryptoHasher_Create(parcSigner_GetCryptoHashType(signer));
+
+    PARCSigningInterface *interface = parcMemory_AllocateAndClear(sizeof(PARCSigningInterface));
+    assertNotNull(interface, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCSigningInterface));
+    *interface = _ccnxChunkingPipelineSigner_Template;
+    interface->interfaceContext = threadSigner;
+
+    return parcSigner_Create(interface);
+}
+
+// ================================================================================
+// Encoding
+
+/**
+ * Encodes, signs and hashes one chunk, and attaches its wire format.
+ *
+ * The ContentObjectHash region, from the end of the fixed and optional headers to the end of the
+ * packet, is put in the dictionary the same way the packet decoder does, so the hash comes from
+ * ccnxWireFormatMessage_CreateContentObjectHash().
+ */
+static bool
+_ccnxChunkingPipeline_EncodeChunk(CCNxChunkingPipeline *pipeline, PARCSigner *threadSigner, CCNxContentObject *object, uint8_t *digest)
+{
+    CCNxCodecNetworkBufferIoVec *iovec;
+    if (pipeline->signer != NULL && threadSigner == NULL) {
+        pthread_mutex_lock(&pipeline->signerLock);
+        iovec = ccnxCodecTlvPacket_DictionaryEncode(object, pipeline->signer);
+        pthread_mutex_unlock(&pipeline->signerLock);
+    } else {
+        iovec = ccnxCodecTlvPacket_DictionaryEncode(object, threadSigner);
+    }
+
+    if (iovec == NULL) {
+        return false;
+    }
+
+    // The fixed header is the start of the first block the encoder wrote
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    trapUnexpectedStateIf(ccnxCodecNetworkBufferIoVec_GetCount(iovec) < 1 || array[0].iov_len < sizeof(CCNxCodecSchemaV1FixedHeader),
+                          "Encoded chunk does not start with a fixed header");
+    const CCNxCodecSchemaV1FixedHeader *header = array[0].iov_base;
+    size_t headerLength = header->headerLength;
+    size_t packetLength = ntohs(header->packetLength);
+
+    ccnxTlvDictionary_PutInteger(object, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart, headerLength);
+    ccnxTlvDictionary_PutInteger(object, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength, packetLength - headerLength);
+    ccnxWireFormatMessage_PutIoVec(object, iovec);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+
+    PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(object);
+    if (hash == NULL) {
+        return false;
+    }
+
+    PARCBuffer *hashDigest = parcCryptoHash_GetDigest(hash);
+    bool success = parcBuffer_Remaining(hashDigest) == CCNxChunkingPipeline_DigestLength;
+    if (success) {
+        memcpy(digest, parcBuffer_Overlay(hashDigest, 0), CCNxChunkingPipeline_DigestLength);
+    }
+    parcCryptoHash_Release(&hash);
+    return success;
+}
+
+static void
+_ccnxChunkingPipeline_EncodeBatch(CCNxChunkingPipeline *pipeline, _CCNxChunkingPipelineBatch *batch, PARCSigner *threadSigner)
+{
+    size_t i;
+    while ((i = __atomic_fetch_add(&batch->next, 1, __ATOMIC_RELAXED)) < batch->count) {
+        uint8_t *digest = &batch->digests[i * CCNxChunkingPipeline_DigestLength];
+        if (!_ccnxChunkingPipeline_EncodeChunk(pipeline, threadSigner, batch->objects[i], digest)) {
+            __atomic_store_n(&batch->failed, true, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void *
+_ccnxChunkingPipeline_WorkerMain(void *arg)
+{
+    _CCNxChunkingPipelineWorker *worker = arg;
+    CCNxChunkingPipeline *pipeline = worker->pipeline;
+
+    uint64_t generation = 0;
+
+    pthread_mutex_lock(&pipeline->lock);
+    while (!pipeline->shutdown) {
+        if (pipeline->generation == generation) {
+            pthread_cond_wait(&pipeline->batchReady, &pipeline->lock);
+            continue;
+        }
+
+        generation = pipeline->generation;
+        _CCNxChunkingPipelineBatch *batch = pipeline->batch;
+        pthread_mutex_unlock(&pipeline->lock);
+
+        _ccnxChunkingPipeline_EncodeBatch(pipeline, batch, worker->signer);
+
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->busyWorkers--;
+        if (pipeline->busyWorkers == 0) {
+            pthread_cond_signal(&pipeline->batchDone);
+        }
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+    return NULL;
+}
+
+// ================================================================================
+// Batches
+
+static CCNxName *
+_ccnxChunkingPipeline_CreateChunkName(const CCNxName *baseName, uint64_t chunk)
+{
+    CCNxName *name = ccnxName_Copy(baseName);
+    CCNxNameSegment *segment = ccnxNameSegmentNumber_Create(CCNxNameLabelType_CHUNK, chunk);
+    ccnxName_Append(name, segment);
+    ccnxNameSegment_Release(&segment);
+    return name;
+}
+
+/**
+ * Produces the chunks of the bytes [start, end) of `view`, which the function may reposition.
+ *
+ * The first chunk is `firstChunk`.  If `isLast`, the final chunk of the batch gets the EndChunkNumber;
+ * an empty last batch is one empty chunk.  The batch must be at most `batchChunks` chunks.
+ */
+static bool
+_ccnxChunkingPipeline_ProduceBatch(CCNxChunkingPipeline *pipeline, const CCNxName *baseName, PARCBuffer *view, size_t start, size_t end,
+                                   uint64_t firstChunk, bool isLast, CCNxChunkingPipelineEmit *emit, void *context)
+{
+    size_t count = (end - start + pipeline->chunkSize - 1) / pipeline->chunkSize;
+    if (count == 0 && isLast) {
+        count = 1;
+    }
+    assertTrue(count <= pipeline->batchChunks, "Batch of %zu chunks is larger than %zu", count, pipeline->batchChunks);
+
+    // Creating the Content Objects touches the shared name and data, so it stays on the calling thread
+    for (size_t i = 0; i < count; i++) {
+        size_t chunkStart = start + i * pipeline->chunkSize;
+        size_t chunkEnd = (end - chunkStart > pipeline->chunkSize) ? chunkStart + pipeline->chunkSize : end;
+        parcBuffer_SetLimit(view, chunkEnd);
+        parcBuffer_SetPosition(view, chunkStart);
+        PARCBuffer *payload = parcBuffer_Slice(view);
+
+        CCNxName *name = _ccnxChunkingPipeline_CreateChunkName(baseName, firstChunk + i);
+        pipeline->objects[i] = ccnxContentObject_CreateWithDataPayload(name, payload);
+        if (isLast && i + 1 == count) {
+            ccnxContentObject_SetFinalChunkNumber(pipeline->objects[i], firstChunk + i);
+        }
+
+        ccnxName_Release(&name);
+        parcBuffer_Release(&payload);
+    }
+
+    _CCNxChunkingPipelineBatch batch = { .objects = pipeline->objects, .digests = pipeline->digests, .count = count, .next = 0, .failed = false };
+
+    // Hand the batch to the workers and work on it alongside them
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->batch = &batch;
+    pipeline->busyWorkers = pipeline->workerCount;
+    pipeline->generation++;
+    pthread_cond_broadcast(&pipeline->batchReady);
+    pthread_mutex_unlock(&pipeline->lock);
+
+    _ccnxChunkingPipeline_EncodeBatch(pipeline, &batch, pipeline->threadSigner);
+
+    pthread_mutex_lock(&pipeline->lock);
+    while (pipeline->busyWorkers > 0) {
+        pthread_cond_wait(&pipeline->batchDone, &pipeline->lock);
+    }
+    pipeline->batch = NULL;
+    pthread_mutex_unlock(&pipeline->lock);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!batch.failed) {
+            emit(context, firstChunk + i, pipeline->objects[i], &pipeline->digests[i * CCNxChunkingPipeline_DigestLength]);
+        }
+        ccnxContentObject_Release(&pipeline->objects[i]);
+    }
+    return !batch.failed;
+}
+
+/**
+ * Reads until `length` bytes are read or end of file.
+ *
+ * @return The number of bytes read, or -1 on a read error
+ */
+static ssize_t
+_ccnxChunkingPipeline_Read(int fd, uint8_t *bytes, size_t length)
+{
+    size_t total = 0;
+    while (total < length) {
+        ssize_t nread = read(fd, &bytes[total], length - total);
+        if (nread == 0) {
+            break;
+        }
+        if (nread < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        total += nread;
+    }
+    return total;
+}
+
+// ================================================================================
+
+static void
+_ccnxChunkingPipeline_FinalRelease(CCNxChunkingPipeline **pipelinePtr)
+{
+    CCNxChunkingPipeline *pipeline = *pipelinePtr;
+
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->shutdown = true;
+    pthread_cond_broadcast(&pipeline->batchReady);
+    pthread_mutex_unlock(&pipeline->lock);
+
+    for (size_t i = 0; i < pipeline->workerCount; i++) {
+        pthread_join(pipeline->workers[i].thread, NULL);
+        if (pipeline->workers[i].signer != NULL) {
+            parcSigner_Release(&pipeline->workers[i].signer);
+        }
+    }
+    if (pipeline->workers != NULL) {
+        parcMemory_Deallocate((void **) &pipeline->workers);
+    }
+
+    parcMemory_Deallocate((void **) &pipeline->objects);
+    parcMemory_Deallocate((void **) &pipeline->digests);
+
+    if (pipeline->threadSigner != NULL) {
+        parcSigner_Release(&pipeline->threadSigner);
+    }
+    if (pipeline->signer != NULL) {
+        parcSigner_Release(&pipeline->signer);
+    }
+
+    pthread_cond_destroy(&pipeline->batchDone);
+    pthread_cond_destroy(&pipeline->batchReady);
+    pthread_mutex_destroy(&pipeline->lock);
+    pthread_mutex_destroy(&pipeline->signerLock);
+}
+
+parcObject_ExtendPARCObject(CCNxChunkingPipeline, _ccnxChunkingPipeline_FinalRelease, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(ccnxChunkingPipeline, CCNxChunkingPipeline);
+
+parcObject_ImplementRelease(ccnxChunkingPipeline, CCNxChunkingPipeline);
+
+CCNxChunkingPipeline *
+ccnxChunkingPipeline_Create(size_t chunkSize, PARCSigner *signer, size_t workerCount)
+{
+    assertTrue(chunkSize > 0, "Parameter chunkSize must be greater than 0");
+
+    CCNxChunkingPipeline *pipeline = parcObject_CreateAndClearInstance(CCNxChunkingPipeline);
+    assertNotNull(pipeline, "parcObject_CreateAndClearInstance returned NULL");
+
+    pipeline->chunkSize = chunkSize;
+    pipeline->batchChunks = (workerCount + 1) * _chunksPerThread;
+    pipeline->signer = (signer == NULL) ? NULL : parcSigner_Acquire(signer);
+    pipeline->threadSigner = _ccnxChunkingPipeline_CreateThreadSigner(signer);
+    pipeline->workerCount = workerCount;
+
+    pipeline->objects = parcMemory_AllocateAndClear(pipeline->batchChunks * sizeof(CCNxContentObject *));
+    assertNotNull(pipeline->objects, "parcMemory_AllocateAndClear(%zu) returned NULL", pipeline->batchChunks * sizeof(CCNxContentObject *));
+    pipeline->digests = parcMemory_Allocate(pipeline->batchChunks * CCNxChunkingPipeline_DigestLength);
+    assertNotNull(pipeline->digests, "parcMemory_Allocate(%zu) returned NULL", pipeline->batchChunks * CCNxChunkingPipeline_DigestLength);
+
+    pthread_mutex_init(&pipeline->signerLock, NULL);
+    pthread_mutex_init(&pipeline->lock, NULL);
+    pthread_cond_init(&pipeline->batchReady, NULL);
+    pthread_cond_init(&pipeline->batchDone, NULL);
+
+    if (workerCount > 0) {
+        pipeline->workers = parcMemory_AllocateAndClear(workerCount * sizeof(_CCNxChunkingPipelineWorker));
+        assertNotNull(pipeline->workers, "parcMemory_AllocateAndClear(%zu) returned NULL", workerCount * sizeof(_CCNxChunkingPipelineWorker));
+
+        for (size_t i = 0; i < workerCount; i++) {
+            pipeline->workers[i].pipeline = pipeline;
+            pipeline->workers[i].signer = _ccnxChunkingPipeline_CreateThreadSigner(signer);
+            int failure = pthread_create(&pipeline->workers[i].thread, NULL, _ccnxChunkingPipeline_WorkerMain, &pipeline->workers[i]);
+            assertFalse(failure, "pthread_create failed: %d", failure);
+        }
+    }
+
+    return pipeline;
+}
+
+size_t
+ccnxChunkingPipeline_GetChunkSize(const CCNxChunkingPipeline *pipeline)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+    return pipeline->chunkSize;
+}
+
+size_t
+ccnxChunkingPipeline_GetWorkerCount(const CCNxChunkingPipeline *pipeline)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+    return pipeline->workerCount;
+}
+
+bool
+ccnxChunkingPipeline_ProduceBuffer(CCNxChunkingPipeline *pipeline, const CCNxName *baseName, const PARCBuffer *data,
+                                   CCNxChunkingPipelineEmit *emit, void *context)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+    assertNotNull(baseName, "Parameter baseName must be non-null");
+    assertNotNull(data, "Parameter data must be non-null");
+    assertNotNull(emit, "Parameter emit must be non-null");
+
+    PARCBuffer *view = parcBuffer_Duplicate(data);
+    size_t end = parcBuffer_Limit(view);
+    size_t batchBytes = pipeline->batchChunks * pipeline->chunkSize;
+
+    bool success = true;
+    uint64_t chunk = 0;
+    size_t start = parcBuffer_Position(view);
+    do {
+        size_t batchEnd = (end - start > batchBytes) ? start + batchBytes : end;
+        success = _ccnxChunkingPipeline_ProduceBatch(pipeline, baseName, view, start, batchEnd, chunk, batchEnd == end, emit, context);
+        chunk += (batchEnd - start) / pipeline->chunkSize;
+        start = batchEnd;
+    } while (success && start < end);
+
+    parcBuffer_Release(&view);
+    return success;
+}
+
+bool
+ccnxChunkingPipeline_ProduceRegion(CCNxChunkingPipeline *pipeline, const CCNxName *baseName, size_t length, const void *region,
+                                   CCNxChunkingPipelineEmit *emit, void *context)
+{
+    assertTrue(length == 0 || region != NULL, "Parameter region must be non-null");
+
+    // parcBuffer_Wrap() does not take NULL, so an empty region is an empty buffer
+    PARCBuffer *data = (length == 0) ? parcBuffer_Allocate(0) : parcBuffer_Wrap((void *) region, length, 0, length);
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, baseName, data, emit, context);
+    parcBuffer_Release(&data);
+    return success;
+}
+
+bool
+ccnxChunkingPipeline_ProduceFile(CCNxChunkingPipeline *pipeline, const CCNxName *baseName, int fd,
+                                 CCNxChunkingPipelineEmit *emit, void *context)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+    assertNotNull(baseName, "Parameter baseName must be non-null");
+    assertNotNull(emit, "Parameter emit must be non-null");
+
+    size_t batchBytes = pipeline->batchChunks * pipeline->chunkSize;
+
+    // A full batch is only the last one if nothing follows it, so one byte is read ahead
+    bool havePending = false;
+    uint8_t pending = 0;
+
+    uint64_t chunk = 0;
+    for (;;) {
+        // Each batch gets its own buffer, as the emitted chunks hold on to their payloads
+        PARCBuffer *data = parcBuffer_Allocate(batchBytes);
+        uint8_t *bytes = parcBuffer_Overlay(data, 0);
+
+        size_t length = 0;
+        if (havePending) {
+            bytes[length++] = pending;
+        }
+        ssize_t nread = _ccnxChunkingPipeline_Read(fd, &bytes[length], batchBytes - length);
+        if (nread >= 0) {
+            length += nread;
+            nread = (length == batchBytes) ? _ccnxChunkingPipeline_Read(fd, &pending, 1) : 0;
+        }
+        if (nread < 0) {
+            parcBuffer_Release(&data);
+            return false;
+        }
+        havePending = (nread == 1);
+
+        bool success = _ccnxChunkingPipeline_ProduceBatch(pipeline, baseName, data, 0, length, chunk, !havePending, emit, context);
+        parcBuffer_Release(&data);
+
+        if (!success || !havePending) {
+            return success;
+        }
+        chunk += pipeline->batchChunks;
+    }
+}
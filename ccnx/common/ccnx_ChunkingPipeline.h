@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file ccnx_ChunkingPipeline.h
+ * @ingroup ContentObject
+ * @brief Splits an object into signed, encoded chunk Content Objects
+ *
+ * A chunking pipeline turns the bytes of an object into the Content Objects `baseName/CHUNK=0`,
+ * `baseName/CHUNK=1`, ... each carrying at most the pipeline's chunk size of payload.  The last chunk
+ * has its EndChunkNumber set (see ccnxContentObject_SetFinalChunkNumber()).  An empty object is one
+ * chunk with an empty payload.
+ *
+ * Chunks are produced in batches.  The calling thread creates the Content Objects of a batch, then
+ * the worker threads and the calling thread together encode, sign and compute the ContentObjectHash of
+ * each one.  The finished chunks are handed to the emit function in chunk order on the calling thread.
+ *
+ * Each thread signs with its own hasher and shares only parcSigner_SignDigest() of the given signer,
+ * so the signer must allow concurrent calls to it.  A keyed signer (HMAC) can only hash with its own
+ * hasher, so chunks are encoded one at a time under a lock with such a signer.
+ *
+ * A pipeline is not thread safe; only one thread may produce at a time.
+ *
+ * @code
+ * {
+ *     CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(4096, signer, 3);
+ *
+ *     int fd = open("index.html", O_RDONLY);
+ *     CCNxName *name = ccnxName_CreateFromURI("lci:/foo/index.html");
+ *     ccnxChunkingPipeline_ProduceFile(pipeline, name, fd, _sendChunk, portal);
+ *     close(fd);
+ *
+ *     ccnxName_Release(&name);
+ *     ccnxChunkingPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+#ifndef libccnx_ccnx_ChunkingPipeline_h
+#define libccnx_ccnx_ChunkingPipeline_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ccnx/common/ccnx_Name.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/security/parc_Signer.h>
+
+/**
+ * The number of bytes in the ContentObjectHash given to a CCNxChunkingPipelineEmit
+ */
+#define CCNxChunkingPipeline_DigestLength 32
+
+struct ccnx_chunking_pipeline;
+/**
+ * @typedef CCNxChunkingPipeline
+ * @brief A worker pool that encodes and signs the chunks of an object
+ */
+typedef struct ccnx_chunking_pipeline CCNxChunkingPipeline;
+
+/**
+ * @typedef CCNxChunkingPipelineEmit
+ * @brief Called for each finished chunk, in chunk order
+ *
+ * `chunkObject` has its wire format encoded and attached (see ccnxWireFormatMessage_GetIoVec()),
+ * and `digest` is its SHA-256 ContentObjectHash, e.g. for ccnxManifestBuilder_AddDigest().  The
+ * pipeline releases `chunkObject` when the function returns, so acquire it to keep it.
+ */
+typedef void (CCNxChunkingPipelineEmit)(void *context, uint64_t chunk, CCNxContentObject *chunkObject, const uint8_t *digest);
+
+/**
+ * Creates a chunking pipeline
+ *
+ * The pipeline starts `workerCount` threads that wait for batches.  The calling thread also encodes
+ * chunks, so a `workerCount` of 0 produces everything on the calling thread.
+ *
+ * @param [in] chunkSize The largest payload of a chunk, greater than 0
+ * @param [in] signer If not NULL, signs every chunk
+ * @param [in] workerCount The number of worker threads to start
+ *
+ * @return non-null An allocated pipeline
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(4096, signer, 3);
+ *     ccnxChunkingPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+CCNxChunkingPipeline *ccnxChunkingPipeline_Create(size_t chunkSize, PARCSigner *signer, size_t workerCount);
+
+/**
+ * Returns a reference counted copy of the pipeline
+ *
+ * @param [in] pipeline An allocated pipeline
+ *
+ * @return non-null A reference counted copy
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxChunkingPipeline *copy = ccnxChunkingPipeline_Acquire(pipeline);
+ *     ccnxChunkingPipeline_Release(&copy);
+ * }
+ * @endcode
+ */
+CCNxChunkingPipeline *ccnxChunkingPipeline_Acquire(const CCNxChunkingPipeline *pipeline);
+
+/**
+ * Releases a reference to the pipeline
+ *
+ * On the final release the worker threads are stopped and joined.
+ *
+ * @param [in,out] pipelinePtr A pointer to the pipeline, will be NULL'd
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(4096, NULL, 0);
+ *     ccnxChunkingPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+void ccnxChunkingPipeline_Release(CCNxChunkingPipeline **pipelinePtr);
+
+/**
+ * The largest payload of a chunk
+ *
+ * @param [in] pipeline An allocated pipeline
+ *
+ * @return number The chunkSize given to ccnxChunkingPipeline_Create()
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t chunkSize = ccnxChunkingPipeline_GetChunkSize(pipeline);
+ * }
+ * @endcode
+ */
+size_t ccnxChunkingPipeline_GetChunkSize(const CCNxChunkingPipeline *pipeline);
+
+/**
+ * The number of worker threads in the pipeline
+ *
+ * @param [in] pipeline An allocated pipeline
+ *
+ * @return number The workerCount given to ccnxChunkingPipeline_Create()
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t workers = ccnxChunkingPipeline_GetWorkerCount(pipeline);
+ * }
+ * @endcode
+ */
+size_t ccnxChunkingPipeline_GetWorkerCount(const CCNxChunkingPipeline *pipeline);
+
+/**
+ * Produces the chunks of the bytes from the position to the limit of a buffer
+ *
+ * The chunk payloads are slices of `data`, so the bytes are not copied.  The position of `data` is not changed.
+ *
+ * @param [in] pipeline An allocated pipeline
+ * @param [in] baseName The name of the object, without a chunk segment
+ * @param [in] data The object
+ * @param [in] emit Called with `context` for every chunk
+ * @param [in] context Passed to `emit`
+ *
+ * @return true Every chunk was emitted
+ * @return false A chunk could not be encoded.  Earlier batches were emitted, the failed batch was not.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *data = parcBuffer_WrapCString("hello world");
+ *     ccnxChunkingPipeline_ProduceBuffer(pipeline, name, data, _sendChunk, portal);
+ *     parcBuffer_Release(&data);
+ * }
+ * @endcode
+ */
+bool ccnxChunkingPipeline_ProduceBuffer(CCNxChunkingPipeline *pipeline, const CCNxName *baseName, const PARCBuffer *data,
+                                        CCNxChunkingPipelineEmit *emit, void *context);
+
+/**
+ * Produces the chunks of a memory region, such as a file mapped with `mmap()`
+ *
+ * The chunk payloads point in to `region`, so the bytes are not copied.  The region must stay mapped
+ * until every emitted chunk, and any wire format taken from it, is released.
+ *
+ * @param [in] pipeline An allocated pipeline
+ * @param [in] baseName The name of the object, without a chunk segment
+ * @param [in] length The number of bytes in the region
+ * @param [in] region The object
+ * @param [in] emit Called with `context` for every chunk
+ * @param [in] context Passed to `emit`
+ *
+ * @return true Every chunk was emitted
+ * @return false As for ccnxChunkingPipeline_ProduceBuffer()
+ *
+ * Example:
+ * @code
+ * {
+ *     struct stat st;
+ *     fstat(fd, &st);
+ *     void *region = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+ *     ccnxChunkingPipeline_ProduceRegion(pipeline, name, st.st_size, region, _sendChunk, portal);
+ *     munmap(region, st.st_size);
+ * }
+ * @endcode
+ */
+bool ccnxChunkingPipeline_ProduceRegion(CCNxChunkingPipeline *pipeline, const CCNxName *baseName, size_t length, const void *region,
+                                        CCNxChunkingPipelineEmit *emit, void *context);
+
+/**
+ * Produces the chunks of everything read from a file descriptor until end of file
+ *
+ * The descriptor is read sequentially, one batch of chunks at a time, so it may be a pipe or socket.
+ * Each batch is read in to one buffer that the chunk payloads share.
+ *
+ * @param [in] pipeline An allocated pipeline
+ * @param [in] baseName The name of the object, without a chunk segment
+ * @param [in] fd A descriptor open for reading
+ * @param [in] emit Called with `context` for every chunk
+ * @param [in] context Passed to `emit`
+ *
+ * @return true Every chunk was emitted
+ * @return false A read failed (see `errno`) or a chunk could not be encoded.  Earlier batches were
+ *               emitted without an EndChunkNumber.
+ *
+ * Example:
+ * @code
+ * {
+ *     int fd = open("index.html", O_RDONLY);
+ *     ccnxChunkingPipeline_ProduceFile(pipeline, name, fd, _sendChunk, portal);
+ *     close(fd);
+ * }
+ * @endcode
+ */
+bool ccnxChunkingPipeline_ProduceFile(CCNxChunkingPipeline *pipeline, const CCNxName *baseName, int fd,
+                                      CCNxChunkingPipelineEmit *emit, void *context);
+#endif // libccnx_ccnx_ChunkingPipeline_h
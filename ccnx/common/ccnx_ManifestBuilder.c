@@ -0,0 +1,584 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/uio.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/security/parc_CryptoHasher.h>
+
+#include <ccnx/common/ccnx_NameSegmentNumber.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_LinkCodec.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_ManifestCodec.h>
+
+#include <ccnx/common/ccnx_ManifestBuilder.h>
+
+/*
+ * One level of the tree.  `section` is the open manifest, or NULL if the level has none;
+ * its single name entry (index 0) names the level below.
+ */
+typedef struct ccnx_manifest_builder_level {
+    CCNxName *prefix;               // the manifests of this level are prefix/CHUNK=k
+    CCNxName *name;                 // the name of the open manifest
+    CCNxManifestSection *section;
+    size_t capacity;                // the digests the open manifest can hold
+    uint64_t emitted;               // manifests finished at this level
+} _CCNxManifestBuilderLevel;
+
+typedef struct ccnx_manifest_builder_batch {
+    PARCBuffer **packets;
+    uint8_t *digests;
+    size_t count;
+
+    // The next packet to hash, taken with an atomic add by every thread working on the batch
+    size_t next;
+    bool failed;
+} _CCNxManifestBuilderBatch;
+
+typedef struct ccnx_manifest_builder_worker {
+    CCNxManifestBuilder *builder;
+    pthread_t thread;
+    PARCCryptoHasher *hasher;
+} _CCNxManifestBuilderWorker;
+
+struct ccnx_manifest_builder {
+    CCNxName *manifestName;
+    CCNxName *dataName;
+    size_t maxManifestSize;
+    PARCSigner *signer;
+    CCNxManifestBuilderEmit *emit;
+    void *context;
+
+    _CCNxManifestBuilderLevel *levels;
+    size_t levelCount;
+
+    uint64_t chunkCount;
+    uint64_t manifestCount;
+    bool finished;
+
+    // The calling thread's hasher and the digests of the current AddPackets batch
+    PARCCryptoHasher *hasher;
+    uint8_t *scratch;
+    size_t scratchCapacity;
+
+    size_t workerCount;
+    _CCNxManifestBuilderWorker *workers;
+
+    // Protects everything below
+    pthread_mutex_t lock;
+    pthread_cond_t batchReady;
+    pthread_cond_t batchDone;
+    _CCNxManifestBuilderBatch *batch;
+    uint64_t generation;
+    size_t busyWorkers;
+    bool shutdown;
+};
+
+// ================================================================================
+// Hashing
+
+/**
+ * Computes the ContentObjectHash of an encoded V1 Content Object.
+ *
+ * The hash covers the packet from the end of the fixed and optional headers to the end of the
+ * packet, as in ccnxWireFormatMessage_CreateContentObjectHash(), without decoding it.
+ */
+static bool
+_ccnxManifestBuilder_HashPacket(PARCCryptoHasher *hasher, int iovcnt, const struct iovec iov[iovcnt], uint8_t *digest)
+{
+    CCNxCodecSchemaV1FixedHeader header;
+    uint8_t *headerBytes = (uint8_t *) &header;
+    size_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        if (total < sizeof(header)) {
+            size_t copy = sizeof(header) - total;
+            if (copy > iov[i].iov_len) {
+                copy = iov[i].iov_len;
+            }
+            memcpy(&headerBytes[total], iov[i].iov_base, copy);
+        }
+        total += iov[i].iov_len;
+    }
+
+    if (total < sizeof(header)
+        || header.version != CCNxTlvDictionary_SchemaVersion_V1
+        || header.packetType != CCNxCodecSchemaV1Types_PacketType_ContentObject) {
+        return false;
+    }
+
+    size_t packetLength = ntohs(header.packetLength);
+    size_t headerLength = header.headerLength;
+    if (packetLength > total || headerLength < sizeof(header) || headerLength >= packetLength) {
+        return false;
+    }
+
+    parcCryptoHasher_Init(hasher);
+    size_t offset = 0;
+    for (int i = 0; i < iovcnt && offset < packetLength; i++) {
+        size_t start = (offset < headerLength) ? headerLength : offset;
+        size_t end = (offset + iov[i].iov_len < packetLength) ? offset + iov[i].iov_len : packetLength;
+        if (start < end) {
+            parcCryptoHasher_UpdateBytes(hasher, (const uint8_t *) iov[i].iov_base + (start - offset), end - start);
+        }
+        offset += iov[i].iov_len;
+    }
+    PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
+
+    PARCBuffer *hashDigest = parcCryptoHash_GetDigest(hash);
+    bool success = parcBuffer_Remaining(hashDigest) == CCNxManifestSection_DigestLength;
+    if (success) {
+        memcpy(digest, parcBuffer_Overlay(hashDigest, 0), CCNxManifestSection_DigestLength);
+    }
+    parcCryptoHash_Release(&hash);
+    return success;
+}
+
+static void
+_ccnxManifestBuilder_HashBatch(_CCNxManifestBuilderBatch *batch, PARCCryptoHasher **hasherPtr)
+{
+    if (*hasherPtr == NULL) {
+        *hasherPtr = parcCryptoHasher_Create(PARC_HASH_SHA256);
+    }
+
+    size_t i;
+    while ((i = __atomic_fetch_add(&batch->next, 1, __ATOMIC_RELAXED)) < batch->count) {
+        PARCBuffer *packet = batch->packets[i];
+        struct iovec iov = { .iov_base = parcBuffer_Overlay(packet, 0), .iov_len = parcBuffer_Remaining(packet) };
+        if (!_ccnxManifestBuilder_HashPacket(*hasherPtr, 1, &iov, &batch->digests[i * CCNxManifestSection_DigestLength])) {
+            __atomic_store_n(&batch->failed, true, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void *
+_ccnxManifestBuilder_WorkerMain(void *arg)
+{
+    _CCNxManifestBuilderWorker *worker = arg;
+    CCNxManifestBuilder *builder = worker->builder;
+
+    uint64_t generation = 0;
+
+    pthread_mutex_lock(&builder->lock);
+    while (!builder->shutdown) {
+        if (builder->generation == generation) {
+            pthread_cond_wait(&builder->batchReady, &builder->lock);
+            continue;
+        }
+
+        generation = builder->generation;
+        _CCNxManifestBuilderBatch *batch = builder->batch;
+        pthread_mutex_unlock(&builder->lock);
+
+        _ccnxManifestBuilder_HashBatch(batch, &worker->hasher);
+
+        pthread_mutex_lock(&builder->lock);
+        builder->busyWorkers--;
+        if (builder->busyWorkers == 0) {
+            pthread_cond_signal(&builder->batchDone);
+        }
+    }
+    pthread_mutex_unlock(&builder->lock);
+
+    if (worker->hasher != NULL) {
+        parcCryptoHasher_Release(&worker->hasher);
+    }
+    return NULL;
+}
+
+// ================================================================================
+// The tree
+
+static CCNxName *
+_ccnxManifestBuilder_CreateNumberedName(const CCNxName *prefix, CCNxNameLabelType type, uint64_t number)
+{
+    CCNxName *name = ccnxName_Copy(prefix);
+    CCNxNameSegment *segment = ccnxNameSegmentNumber_Create(type, number);
+    ccnxName_Append(name, segment);
+    ccnxNameSegment_Release(&segment);
+    return name;
+}
+
+static _CCNxManifestBuilderLevel *
+_ccnxManifestBuilder_GetLevel(CCNxManifestBuilder *builder, size_t level)
+{
+    if (level == builder->levelCount) {
+        size_t size = (level + 1) * sizeof(_CCNxManifestBuilderLevel);
+        builder->levels = parcMemory_Reallocate(builder->levels, size);
+        assertNotNull(builder->levels, "parcMemory_Reallocate(%zu) returned NULL", size);
+
+        _CCNxManifestBuilderLevel *newLevel = &builder->levels[level];
+        memset(newLevel, 0, sizeof(_CCNxManifestBuilderLevel));
+        newLevel->prefix = _ccnxManifestBuilder_CreateNumberedName(builder->manifestName, CCNxManifestBuilder_LevelLabelType, level);
+        builder->levelCount++;
+    }
+    return &builder->levels[level];
+}
+
+/**
+ * Opens a manifest at `level` whose first digest is child `firstChild` of the level below,
+ * and works out how many digests fit in `maxManifestSize`.
+ */
+static void
+_ccnxManifestBuilder_OpenManifest(CCNxManifestBuilder *builder, size_t level, uint64_t firstChild)
+{
+    _CCNxManifestBuilderLevel *open = &builder->levels[level];
+    const CCNxName *childPrefix = (level == 0) ? builder->dataName : builder->levels[level - 1].prefix;
+
+    open->name = _ccnxManifestBuilder_CreateNumberedName(open->prefix, CCNxNameLabelType_CHUNK, open->emitted);
+    open->section = ccnxManifestSection_CreateWithCapacity(NULL, open->capacity);
+    ccnxManifestSection_AddName(open->section, childPrefix, firstChild);
+
+    // Name link and payload section TLs, plus the TL and name index of the one hash group.
+    // The root may get a shorter name than this, never a longer one.
+    CCNxLink *link = ccnxLink_Create(open->name, NULL, NULL);
+    size_t overhead = 4 + ccnxCodecSchemaV1LinkCodec_GetEncodedLength(link)
+                      + 4 + ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(open->section) + 8;
+    ccnxLink_Release(&link);
+
+    assertTrue(overhead + 2 * CCNxManifestSection_DigestLength <= builder->maxManifestSize,
+               "A manifest of %zu bytes cannot hold two digests after %zu bytes of names", builder->maxManifestSize, overhead);
+    open->capacity = (builder->maxManifestSize - overhead) / CCNxManifestSection_DigestLength;
+}
+
+/**
+ * Encodes the open manifest at `level` as a Content Object with its wire format attached.
+ *
+ * The payload is written with the section codec rather than from a CCNxManifest, as a
+ * CCNxManifest carries a signature and here the signature belongs to the Content Object.
+ */
+static CCNxContentObject *
+_ccnxManifestBuilder_EncodeManifest(const CCNxName *name, const CCNxManifestSection *section, PARCSigner *signer)
+{
+    CCNxLink *link = ccnxLink_Create(name, NULL, NULL);
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_Manifest_NameLink, (uint16_t) ccnxCodecSchemaV1LinkCodec_GetEncodedLength(link));
+    ccnxCodecSchemaV1LinkCodec_Encode(encoder, link);
+    ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_Manifest_PayloadSection,
+                                        (uint16_t) ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(section));
+    ccnxCodecSchemaV1ManifestCodec_EncodeSection(encoder, section);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+    PARCBuffer *payload = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxLink_Release(&link);
+
+    CCNxContentObject *object = ccnxContentObject_CreateWithDataPayload(name, NULL);
+    ccnxContentObject_SetPayload(object, CCNxPayloadType_MANIFEST, payload);
+    parcBuffer_Release(&payload);
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncode(object, signer);
+    if (iovec == NULL) {
+        ccnxContentObject_Release(&object);
+        return NULL;
+    }
+    ccnxWireFormatMessage_PutIoVec(object, iovec);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+
+    return object;
+}
+
+static bool _ccnxManifestBuilder_Push(CCNxManifestBuilder *builder, size_t level, size_t count, const uint8_t *digests, uint64_t firstChild);
+
+/**
+ * Emits the open manifest at `level` and, unless it is the root, adds its hash one level up
+ */
+static bool
+_ccnxManifestBuilder_CloseManifest(CCNxManifestBuilder *builder, size_t level, bool isRoot)
+{
+    _CCNxManifestBuilderLevel *open = &builder->levels[level];
+
+    CCNxContentObject *object =
+        _ccnxManifestBuilder_EncodeManifest(isRoot ? builder->manifestName : open->name, open->section, isRoot ? builder->signer : NULL);
+
+    ccnxName_Release(&open->name);
+    ccnxManifestSection_Release(&open->section);
+    uint64_t child = open->emitted++;
+
+    if (object == NULL) {
+        return false;
+    }
+
+    uint8_t digest[CCNxManifestSection_DigestLength];
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxWireFormatMessage_GetIoVec(object);
+    bool success = _ccnxManifestBuilder_HashPacket(builder->hasher, ccnxCodecNetworkBufferIoVec_GetCount(iovec),
+                                                   ccnxCodecNetworkBufferIoVec_GetArray(iovec), digest);
+
+    builder->manifestCount++;
+    builder->emit(builder->context, object, isRoot);
+    ccnxContentObject_Release(&object);
+
+    if (success && !isRoot) {
+        success = _ccnxManifestBuilder_Push(builder, level + 1, 1, digest, child);
+    }
+    return success;
+}
+
+/**
+ * Adds digests of consecutive children to `level`.
+ *
+ * A full manifest is only closed when the next digest arrives, so that if nothing else arrives
+ * ccnxManifestBuilder_Finish() can make it the root instead of giving it a parent of one.
+ */
+static bool
+_ccnxManifestBuilder_Push(CCNxManifestBuilder *builder, size_t level, size_t count, const uint8_t *digests, uint64_t firstChild)
+{
+    _CCNxManifestBuilderLevel *open = _ccnxManifestBuilder_GetLevel(builder, level);
+
+    while (count > 0) {
+        if (open->section != NULL && ccnxManifestSection_GetHashCount(open->section) == open->capacity) {
+            if (!_ccnxManifestBuilder_CloseManifest(builder, level, false)) {
+                return false;
+            }
+            // Closing may have added a level and moved the array
+            open = &builder->levels[level];
+        }
+        if (open->section == NULL) {
+            _ccnxManifestBuilder_OpenManifest(builder, level, firstChild);
+        }
+
+        size_t room = open->capacity - ccnxManifestSection_GetHashCount(open->section);
+        size_t batch = (count < room) ? count : room;
+        ccnxManifestSection_AddHashArray(open->section, 0, batch, digests);
+
+        digests += batch * CCNxManifestSection_DigestLength;
+        count -= batch;
+        firstChild += batch;
+    }
+    return true;
+}
+
+// ================================================================================
+
+static void
+_ccnxManifestBuilder_FinalRelease(CCNxManifestBuilder **builderPtr)
+{
+    CCNxManifestBuilder *builder = *builderPtr;
+
+    pthread_mutex_lock(&builder->lock);
+    builder->shutdown = true;
+    pthread_cond_broadcast(&builder->batchReady);
+    pthread_mutex_unlock(&builder->lock);
+
+    for (size_t i = 0; i < builder->workerCount; i++) {
+        pthread_join(builder->workers[i].thread, NULL);
+    }
+    if (builder->workers != NULL) {
+        parcMemory_Deallocate((void **) &builder->workers);
+    }
+
+    for (size_t i = 0; i < builder->levelCount; i++) {
+        _CCNxManifestBuilderLevel *level = &builder->levels[i];
+        ccnxName_Release(&level->prefix);
+        if (level->section != NULL) {
+            ccnxName_Release(&level->name);
+            ccnxManifestSection_Release(&level->section);
+        }
+    }
+    if (builder->levels != NULL) {
+        parcMemory_Deallocate((void **) &builder->levels);
+    }
+    if (builder->scratch != NULL) {
+        parcMemory_Deallocate((void **) &builder->scratch);
+    }
+
+    parcCryptoHasher_Release(&builder->hasher);
+    if (builder->signer != NULL) {
+        parcSigner_Release(&builder->signer);
+    }
+    ccnxName_Release(&builder->manifestName);
+    ccnxName_Release(&builder->dataName);
+
+    pthread_cond_destroy(&builder->batchDone);
+    pthread_cond_destroy(&builder->batchReady);
+    pthread_mutex_destroy(&builder->lock);
+}
+
+parcObject_ExtendPARCObject(CCNxManifestBuilder, _ccnxManifestBuilder_FinalRelease, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(ccnxManifestBuilder, CCNxManifestBuilder);
+
+parcObject_ImplementRelease(ccnxManifestBuilder, CCNxManifestBuilder);
+
+CCNxManifestBuilder *
+ccnxManifestBuilder_Create(const CCNxName *manifestName, const CCNxName *dataName, size_t maxManifestSize,
+                           PARCSigner *signer, size_t workerCount, CCNxManifestBuilderEmit *emit, void *context)
+{
+    assertNotNull(manifestName, "Parameter manifestName must be non-null");
+    assertNotNull(dataName, "Parameter dataName must be non-null");
+    assertNotNull(emit, "Parameter emit must be non-null");
+    assertTrue(maxManifestSize <= UINT16_MAX, "Parameter maxManifestSize must be at most %u, got %zu", UINT16_MAX, maxManifestSize);
+
+    CCNxManifestBuilder *builder = parcObject_CreateAndClearInstance(CCNxManifestBuilder);
+    assertNotNull(builder, "parcObject_CreateAndClearInstance returned NULL");
+
+    builder->manifestName = ccnxName_Acquire(manifestName);
+    builder->dataName = ccnxName_Acquire(dataName);
+    builder->maxManifestSize = maxManifestSize;
+    builder->signer = (signer == NULL) ? NULL : parcSigner_Acquire(signer);
+    builder->emit = emit;
+    builder->context = context;
+    builder->hasher = parcCryptoHasher_Create(PARC_HASH_SHA256);
+    builder->workerCount = workerCount;
+
+    pthread_mutex_init(&builder->lock, NULL);
+    pthread_cond_init(&builder->batchReady, NULL);
+    pthread_cond_init(&builder->batchDone, NULL);
+
+    if (workerCount > 0) {
+        builder->workers = parcMemory_AllocateAndClear(workerCount * sizeof(_CCNxManifestBuilderWorker));
+        assertNotNull(builder->workers, "parcMemory_AllocateAndClear(%zu) returned NULL", workerCount * sizeof(_CCNxManifestBuilderWorker));
+
+        for (size_t i = 0; i < workerCount; i++) {
+            builder->workers[i].builder = builder;
+            int failure = pthread_create(&builder->workers[i].thread, NULL, _ccnxManifestBuilder_WorkerMain, &builder->workers[i]);
+            assertFalse(failure, "pthread_create failed: %d", failure);
+        }
+    }
+
+    return builder;
+}
+
+bool
+ccnxManifestBuilder_AddDigestArray(CCNxManifestBuilder *builder, size_t count, const uint8_t *digests)
+{
+    assertNotNull(builder, "Parameter builder must be non-null");
+    assertTrue(count == 0 || digests != NULL, "Parameter digests must be non-null");
+
+    if (builder->finished) {
+        return false;
+    }
+
+    uint64_t firstChunk = builder->chunkCount;
+    builder->chunkCount += count;
+    return _ccnxManifestBuilder_Push(builder, 0, count, digests, firstChunk);
+}
+
+bool
+ccnxManifestBuilder_AddDigest(CCNxManifestBuilder *builder, const uint8_t *digest)
+{
+    return ccnxManifestBuilder_AddDigestArray(builder, 1, digest);
+}
+
+bool
+ccnxManifestBuilder_AddPackets(CCNxManifestBuilder *builder, size_t count, PARCBuffer *packets[count])
+{
+    assertNotNull(builder, "Parameter builder must be non-null");
+    assertTrue(count == 0 || packets != NULL, "Parameter packets must be non-null");
+
+    if (builder->finished) {
+        return false;
+    }
+
+    size_t size = count * CCNxManifestSection_DigestLength;
+    if (size > builder->scratchCapacity) {
+        if (builder->scratch != NULL) {
+            parcMemory_Deallocate((void **) &builder->scratch);
+        }
+        builder->scratch = parcMemory_Allocate(size);
+        assertNotNull(builder->scratch, "parcMemory_Allocate(%zu) returned NULL", size);
+        builder->scratchCapacity = size;
+    }
+
+    _CCNxManifestBuilderBatch batch = { .packets = packets, .digests = builder->scratch, .count = count, .next = 0, .failed = false };
+
+    // Hand the batch to the workers and work on it alongside them
+    pthread_mutex_lock(&builder->lock);
+    builder->batch = &batch;
+    builder->busyWorkers = builder->workerCount;
+    builder->generation++;
+    pthread_cond_broadcast(&builder->batchReady);
+    pthread_mutex_unlock(&builder->lock);
+
+    _ccnxManifestBuilder_HashBatch(&batch, &builder->hasher);
+
+    pthread_mutex_lock(&builder->lock);
+    while (builder->busyWorkers > 0) {
+        pthread_cond_wait(&builder->batchDone, &builder->lock);
+    }
+    builder->batch = NULL;
+    pthread_mutex_unlock(&builder->lock);
+
+    if (batch.failed) {
+        return false;
+    }
+    return ccnxManifestBuilder_AddDigestArray(builder, count, builder->scratch);
+}
+
+bool
+ccnxManifestBuilder_Finish(CCNxManifestBuilder *builder)
+{
+    assertNotNull(builder, "Parameter builder must be non-null");
+
+    if (builder->finished) {
+        return false;
+    }
+    builder->finished = true;
+
+    // Close each level bottom up.  The first level that is the top of the tree and has not
+    // emitted a manifest holds the root.
+    for (size_t level = 0; ; level++) {
+        _CCNxManifestBuilderLevel *open = _ccnxManifestBuilder_GetLevel(builder, level);
+
+        if (level + 1 == builder->levelCount && open->emitted == 0) {
+            if (open->section == NULL) {
+                _ccnxManifestBuilder_OpenManifest(builder, level, 0);
+            }
+            return _ccnxManifestBuilder_CloseManifest(builder, level, true);
+        }
+
+        if (open->section != NULL) {
+            if (!_ccnxManifestBuilder_CloseManifest(builder, level, false)) {
+                return false;
+            }
+        }
+    }
+}
+
+uint64_t
+ccnxManifestBuilder_GetChunkCount(const CCNxManifestBuilder *builder)
+{
+    assertNotNull(builder, "Parameter builder must be non-null");
+    return builder->chunkCount;
+}
+
+uint64_t
+ccnxManifestBuilder_GetManifestCount(const CCNxManifestBuilder *builder)
+{
+    assertNotNull(builder, "Parameter builder must be non-null");
+    return builder->manifestCount;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file ccnx_ManifestBuilder.h
+ * @ingroup ContentObject
+ * @brief Builds a tree of manifests over the chunks of an object as the chunks are produced
+ *
+ * A manifest builder takes the ContentObjectHash of each data chunk, in chunk order, and packs
+ * the digests into manifests of at most a given size.  When a manifest is full it is encoded as a
+ * Content Object, handed to the emit function, and its own ContentObjectHash is added to a manifest
+ * one level up.  ccnxManifestBuilder_Finish() closes every level and emits the root last.
+ *
+ * The builder only keeps one open manifest per level of the tree, so its memory is bounded by the
+ * manifest size times the depth of the tree, however large the object.
+ *
+ * Names:
+ *   - Each data chunk is `dataName/CHUNK=n`, starting at chunk 0.  A leaf manifest has one name entry,
+ *     `dataName` with the chunk of its first digest, and its digests are consecutive chunks.
+ *   - The manifests at level L (leaves are level 0) are `manifestName/App:0=L/CHUNK=k`, numbered from 0
+ *     at each level.  A manifest at level L + 1 has one name entry for the level L prefix.
+ *   - The root is `manifestName`.  It is the only manifest signed with the builder's signer; every other
+ *     manifest is reached through a hash in its parent.
+ *
+ * Digests can be given directly, or as encoded V1 Content Object packets that the builder hashes,
+ * optionally across a pool of worker threads.
+ *
+ * A builder is not thread safe; only one thread may call it at a time.
+ *
+ * @code
+ * {
+ *     CCNxName *manifestName = ccnxName_CreateFromURI("lci:/foo/bar/manifest");
+ *     CCNxName *dataName = ccnxName_CreateFromURI("lci:/foo/bar");
+ *     CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(manifestName, dataName, 4096, signer, 3, _sendManifest, portal);
+ *
+ *     while (...) {
+ *         ccnxManifestBuilder_AddPackets(builder, count, encodedChunks);
+ *     }
+ *     ccnxManifestBuilder_Finish(builder);
+ *
+ *     ccnxManifestBuilder_Release(&builder);
+ * }
+ * @endcode
+ */
+#ifndef libccnx_ccnx_ManifestBuilder_h
+#define libccnx_ccnx_ManifestBuilder_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ccnx/common/ccnx_Name.h>
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_ManifestSection.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/security/parc_Signer.h>
+
+/**
+ * The label type of the name segment that holds the level of an interior manifest
+ */
+#define CCNxManifestBuilder_LevelLabelType CCNxNameLabelType_App(0)
+
+struct ccnx_manifest_builder;
+/**
+ * @typedef CCNxManifestBuilder
+ * @brief Packs chunk digests into a tree of manifests as they are produced
+ */
+typedef struct ccnx_manifest_builder CCNxManifestBuilder;
+
+/**
+ * @typedef CCNxManifestBuilderEmit
+ * @brief Called for each finished manifest
+ *
+ * `manifestObject` is a Content Object with a Manifest payload whose wire format is already encoded
+ * and attached (see ccnxWireFormatMessage_GetIoVec()).  The builder releases it when the function
+ * returns, so acquire it to keep it.  Manifests are emitted children first and the root last,
+ * with `isRoot` true.
+ */
+typedef void (CCNxManifestBuilderEmit)(void *context, CCNxContentObject *manifestObject, bool isRoot);
+
+/**
+ * Creates a manifest builder
+ *
+ * `maxManifestSize` limits the encoded manifest payload, not the whole packet.  It must leave room
+ * for at least two digests after the name link and name entry.
+ *
+ * The builder starts `workerCount` threads to hash packets given to ccnxManifestBuilder_AddPackets().
+ * The calling thread also hashes, so a `workerCount` of 0 hashes on the calling thread only.
+ *
+ * @param [in] manifestName The name of the root manifest, and the prefix of the interior manifests
+ * @param [in] dataName The name of the data, without a chunk segment
+ * @param [in] maxManifestSize The largest encoded manifest payload, at most UINT16_MAX
+ * @param [in] signer If not NULL, signs the root manifest
+ * @param [in] workerCount The number of worker threads to start
+ * @param [in] emit Called for each finished manifest
+ * @param [in] context Passed to `emit`
+ *
+ * @return non-null An allocated builder
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(manifestName, dataName, 4096, NULL, 0, _sendManifest, portal);
+ *     ccnxManifestBuilder_Release(&builder);
+ * }
+ * @endcode
+ */
+CCNxManifestBuilder *ccnxManifestBuilder_Create(const CCNxName *manifestName, const CCNxName *dataName, size_t maxManifestSize,
+                                                PARCSigner *signer, size_t workerCount, CCNxManifestBuilderEmit *emit, void *context);
+
+/**
+ * Returns a reference counted copy of the builder
+ *
+ * @param [in] builder An allocated builder
+ *
+ * @return non-null A reference counted copy
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestBuilder *copy = ccnxManifestBuilder_Acquire(builder);
+ *     ccnxManifestBuilder_Release(&copy);
+ * }
+ * @endcode
+ */
+CCNxManifestBuilder *ccnxManifestBuilder_Acquire(const CCNxManifestBuilder *builder);
+
+/**
+ * Releases a reference to the builder
+ *
+ * On the final release the worker threads are stopped.  Manifests that were not finished are discarded.
+ *
+ * @param [in,out] builderPtr A pointer to the builder, will be NULL'd
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(manifestName, dataName, 4096, NULL, 0, _sendManifest, portal);
+ *     ccnxManifestBuilder_Release(&builder);
+ * }
+ * @endcode
+ */
+void ccnxManifestBuilder_Release(CCNxManifestBuilder **builderPtr);
+
+/**
+ * Adds the ContentObjectHash of the next data chunk
+ *
+ * @param [in] builder An allocated builder
+ * @param [in] digest `CCNxManifestSection_DigestLength` bytes of SHA-256 ContentObjectHash
+ *
+ * @return true The digest was added
+ * @return false The builder is finished, or a manifest could not be encoded
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(chunk);
+ *     ccnxManifestBuilder_AddDigest(builder, parcBuffer_Overlay(parcCryptoHash_GetDigest(hash), 0));
+ *     parcCryptoHash_Release(&hash);
+ * }
+ * @endcode
+ */
+bool ccnxManifestBuilder_AddDigest(CCNxManifestBuilder *builder, const uint8_t *digest);
+
+/**
+ * Adds the ContentObjectHashes of the next `count` data chunks
+ *
+ * The digests are copied into the open manifests with one copy per manifest.
+ *
+ * @param [in] builder An allocated builder
+ * @param [in] count The number of digests
+ * @param [in] digests `count * CCNxManifestSection_DigestLength` bytes, in chunk order
+ *
+ * @return true The digests were added
+ * @return false The builder is finished, or a manifest could not be encoded
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestBuilder_AddDigestArray(builder, ccnxManifestSection_GetHashCount(section), ccnxManifestSection_GetDigestArray(section));
+ * }
+ * @endcode
+ */
+bool ccnxManifestBuilder_AddDigestArray(CCNxManifestBuilder *builder, size_t count, const uint8_t *digests);
+
+/**
+ * Hashes the next `count` data chunks and adds their ContentObjectHashes
+ *
+ * Each packet is an encoded V1 Content Object, from its fixed header to the end of the packet.
+ * The packets are hashed by the worker threads and the calling thread together.
+ *
+ * @param [in] builder An allocated builder
+ * @param [in] count The number of packets
+ * @param [in] packets The encoded packets in chunk order, from the position to the limit of each buffer
+ *
+ * @return true Every packet was hashed and added
+ * @return false A packet is not a V1 Content Object, in which case none of them are added, or as for ccnxManifestBuilder_AddDigestArray()
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestBuilder_AddPackets(builder, count, encodedChunks);
+ * }
+ * @endcode
+ */
+bool ccnxManifestBuilder_AddPackets(CCNxManifestBuilder *builder, size_t count, PARCBuffer *packets[count]);
+
+/**
+ * Emits every open manifest, ending with the root
+ *
+ * A builder with no chunks emits an empty root.  After this call the builder accepts no more chunks.
+ *
+ * @param [in] builder An allocated builder
+ *
+ * @return true The root was emitted
+ * @return false The builder was already finished, or a manifest could not be encoded
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestBuilder_Finish(builder);
+ * }
+ * @endcode
+ */
+bool ccnxManifestBuilder_Finish(CCNxManifestBuilder *builder);
+
+/**
+ * The number of data chunks added so far
+ *
+ * @param [in] builder An allocated builder
+ *
+ * @return number The number of digests added, which is also the next chunk number
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t endChunk = ccnxManifestBuilder_GetChunkCount(builder) - 1;
+ * }
+ * @endcode
+ */
+uint64_t ccnxManifestBuilder_GetChunkCount(const CCNxManifestBuilder *builder);
+
+/**
+ * The number of manifests emitted so far
+ *
+ * @param [in] builder An allocated builder
+ *
+ * @return number The number of times the emit function was called
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t manifests = ccnxManifestBuilder_GetManifestCount(builder);
+ * }
+ * @endcode
+ */
+uint64_t ccnxManifestBuilder_GetManifestCount(const CCNxManifestBuilder *builder);
+#endif // libccnx_ccnx_ManifestBuilder_h
@@ -31,162 +31,194 @@
 #include <config.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 #include <LongBow/runtime.h>
 
 #include <parc/algol/parc_Object.h>
-#include <parc/algol/parc_ArrayList.h>
 
 #include <ccnx/common/ccnx_ManifestSection.h>
 
+struct ccnx_manifest_section_name_entry {
+    size_t chunk;
+    CCNxName *mediaName;
+    size_t hashCount;          // hashes added under this name so far
+};
+typedef struct ccnx_manifest_section_name_entry _CCNxManifestSectionNameEntry;
+
+/*
+ * Hash entry i is the CCNxManifestSection_DigestLength bytes at digests[i * CCNxManifestSection_DigestLength],
+ * it belongs to name entry nameIndexes[i] and is chunk (chunk + chunkOffsets[i]) of that name.
+ * All three arrays hold hashCapacity entries.
+ */
 struct ccnx_manifest_section {
     CCNxLink *acsLink;         // optional
 
-    PARCList *listOfNames;     // optional
+    _CCNxManifestSectionNameEntry *names;
     size_t numberOfNames;
+    size_t nameCapacity;
 
-    PARCList *listOfHashes;    // optional
+    uint8_t *digests;
+    uint32_t *nameIndexes;
+    uint32_t *chunkOffsets;
     size_t numberOfHashes;
-};
+    size_t hashCapacity;
 
-struct ccnx_manifest_section_name_entry {
-    size_t chunk;
-    CCNxName *mediaName;
-};
-typedef struct ccnx_manifest_section_name_entry _CCNxManifestSectionNameEntry;
+    // Only allocated if ccnxManifestSection_GetHashAtIndex() is used, one lazily created buffer per hash entry
+    PARCBuffer **hashBuffers;
 
-struct ccnx_manifest_section_hash_entry {
-    size_t nameIndex;
-    PARCBuffer *hash;
+    // Only allocated if ccnxManifestSection_FindDigest() is used.  An open addressing table of
+    // (hash index + 1), 0 is an empty slot.  The first indexedHashes hash entries are in the table.
+    // It is updated under _ccnxManifestSection_IndexLock and indexedHashes is stored last.
+    uint32_t *digestSlots;
+    size_t digestSlotMask;
+    size_t indexedHashes;
 };
-typedef struct ccnx_manifest_section_hash_entry _CCNxManifestSectionHashEntry;
+
+// Serializes building the digest index of any section; lookups in an up to date index do not take it
+static pthread_mutex_t _ccnxManifestSection_IndexLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Private functions
 
 static void
-_ccnxManifestSectionNameEntry_FinalRelease(_CCNxManifestSectionNameEntry **nameP)
+_ccnxManifestSection_EnsureNameCapacity(CCNxManifestSection *section, size_t count)
 {
-    if ((*nameP)->mediaName != NULL) {
-        ccnxName_Release(&(*nameP)->mediaName);
+    if (count > section->nameCapacity) {
+        size_t capacity = (section->nameCapacity < 2) ? 4 : section->nameCapacity * 2;
+        if (capacity < count) {
+            capacity = count;
+        }
+        section->names = parcMemory_Reallocate(section->names, capacity * sizeof(_CCNxManifestSectionNameEntry));
+        assertNotNull(section->names, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(_CCNxManifestSectionNameEntry));
+        section->nameCapacity = capacity;
     }
 }
 
-static bool
-_ccnxManifestSectionNameEntry_Equals(const _CCNxManifestSectionNameEntry *objectA, const _CCNxManifestSectionNameEntry *objectB)
+static void
+_ccnxManifestSection_EnsureHashCapacity(CCNxManifestSection *section, size_t count)
 {
-    if (objectA == objectB) {
-        return true;
-    }
-    if (objectA == NULL || objectB == NULL) {
-        return false;
-    }
-    if (objectA->chunk == objectB->chunk) {
-        if (ccnxName_Equals(objectA->mediaName, objectB->mediaName)) {
-            return true;
+    if (count > section->hashCapacity) {
+        size_t capacity = (section->hashCapacity < 8) ? 16 : section->hashCapacity * 2;
+        if (capacity < count) {
+            capacity = count;
+        }
+        section->digests = parcMemory_Reallocate(section->digests, capacity * CCNxManifestSection_DigestLength);
+        assertNotNull(section->digests, "parcMemory_Reallocate(%zu) returned NULL", capacity * CCNxManifestSection_DigestLength);
+        section->nameIndexes = parcMemory_Reallocate(section->nameIndexes, capacity * sizeof(uint32_t));
+        assertNotNull(section->nameIndexes, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(uint32_t));
+        section->chunkOffsets = parcMemory_Reallocate(section->chunkOffsets, capacity * sizeof(uint32_t));
+        assertNotNull(section->chunkOffsets, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(uint32_t));
+
+        if (section->hashBuffers != NULL) {
+            section->hashBuffers = parcMemory_Reallocate(section->hashBuffers, capacity * sizeof(PARCBuffer *));
+            assertNotNull(section->hashBuffers, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(PARCBuffer *));
+            memset(&section->hashBuffers[section->hashCapacity], 0, (capacity - section->hashCapacity) * sizeof(PARCBuffer *));
         }
+        section->hashCapacity = capacity;
     }
-    return false;
 }
 
-parcObject_ExtendPARCObject(_CCNxManifestSectionNameEntry, _ccnxManifestSectionNameEntry_FinalRelease,
-                            NULL, NULL, _ccnxManifestSectionNameEntry_Equals, NULL, NULL, NULL);
-
-static void
-_ccnxManifestSectionHashEntry_FinalRelease(_CCNxManifestSectionHashEntry **hashP)
+// Digests are normally SHA-256 output; the multiply spreads out any that are not
+static inline size_t
+_ccnxManifestSection_DigestSlot(const uint8_t *digest)
 {
-    if ((*hashP)->hash != NULL) {
-        parcBuffer_Release(&(*hashP)->hash);
-    }
+    uint64_t word;
+    memcpy(&word, digest, sizeof(word));
+    return (size_t) (word * 0x9E3779B97F4A7C15ULL >> 32);
 }
 
-
-static bool
-_ccnxManifestSectionHashEntry_Equals(const _CCNxManifestSectionHashEntry *objectA, const _CCNxManifestSectionHashEntry *objectB)
+static void
+_ccnxManifestSection_IndexDigest(CCNxManifestSection *section, size_t index)
 {
-    if (objectA == objectB) {
-        return true;
-    }
-    if (objectA == NULL || objectB == NULL) {
-        return false;
+    size_t slot = _ccnxManifestSection_DigestSlot(&section->digests[index * CCNxManifestSection_DigestLength]) & section->digestSlotMask;
+    while (section->digestSlots[slot] != 0) {
+        slot = (slot + 1) & section->digestSlotMask;
     }
-    if (objectA->nameIndex == objectB->nameIndex) {
-        if (parcBuffer_Equals(objectA->hash, objectB->hash)) {
-            return true;
-        }
-    }
-    return false;
+    section->digestSlots[slot] = (uint32_t) (index + 1);
 }
 
-
-parcObject_ExtendPARCObject(_CCNxManifestSectionHashEntry, _ccnxManifestSectionHashEntry_FinalRelease,
-                            NULL, NULL, _ccnxManifestSectionHashEntry_Equals, NULL, NULL, NULL);
-
-// Private functions
-
-static _CCNxManifestSectionNameEntry *
-_ccnxManifestSection_CreateNameEntry(size_t chunk, const CCNxName *name)
+/**
+ * Bring the digest index up to date with the hash entries, keeping the table at most half full.
+ * The caller holds _ccnxManifestSection_IndexLock.
+ */
+static void
+_ccnxManifestSection_UpdateDigestIndexLocked(CCNxManifestSection *section)
 {
-    _CCNxManifestSectionNameEntry *entry = parcObject_CreateAndClearInstance(_CCNxManifestSectionNameEntry);
-    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxManifestSectionNameEntry));
-
-    if (entry != NULL) {
-        entry->chunk = chunk;
-        entry->mediaName = ccnxName_Acquire(name);
+    if (section->indexedHashes == section->numberOfHashes && section->digestSlots != NULL) {
+        return;
     }
 
-    return entry;
-}
+    assertTrue(section->numberOfHashes < UINT32_MAX, "Too many hash entries to index: %zu", section->numberOfHashes);
 
-static _CCNxManifestSectionHashEntry *
-_ccnxManifestSection_CreateHashEntry(size_t nameIndex, const PARCBuffer *hash)
-{
-    _CCNxManifestSectionHashEntry *entry = parcObject_CreateAndClearInstance(_CCNxManifestSectionHashEntry);
-    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxManifestSectionHashEntry));
+    size_t slotCount = section->digestSlotMask + 1;
+    if (section->digestSlots == NULL || section->numberOfHashes * 2 > slotCount) {
+        slotCount = 16;
+        while (slotCount < section->numberOfHashes * 2) {
+            slotCount *= 2;
+        }
 
-    if (entry != NULL) {
-        entry->nameIndex = nameIndex;
-        entry->hash = parcBuffer_Acquire(hash);
+        if (section->digestSlots != NULL) {
+            parcMemory_Deallocate((void **) &section->digestSlots);
+        }
+        section->digestSlots = parcMemory_AllocateAndClear(slotCount * sizeof(uint32_t));
+        assertNotNull(section->digestSlots, "parcMemory_AllocateAndClear(%zu) returned NULL", slotCount * sizeof(uint32_t));
+        section->digestSlotMask = slotCount - 1;
+        __atomic_store_n(&section->indexedHashes, 0, __ATOMIC_RELAXED);
     }
 
-    return entry;
-}
-
-static void
-_ccnxManifestSectionNameEntry_Release(_CCNxManifestSectionNameEntry **entryP)
-{
-    parcObject_Release((void **) entryP);
+    // Indexing in order means a probe meets the lowest index of a repeated digest first
+    for (size_t i = section->indexedHashes; i < section->numberOfHashes; i++) {
+        _ccnxManifestSection_IndexDigest(section, i);
+    }
+    __atomic_store_n(&section->indexedHashes, section->numberOfHashes, __ATOMIC_RELEASE);
 }
 
+/**
+ * Bring the digest index up to date.  Once it is, lookups only read it, so several threads may
+ * look up at once; only a lookup that finds the index out of date takes the lock and updates it.
+ */
 static void
-_ccnxManifestSectionHashEntry_Release(_CCNxManifestSectionHashEntry **entryP)
-{
-    parcObject_Release((void **) entryP);
-}
-
-static _CCNxManifestSectionNameEntry *
-_getNameEntryFromHashIndex(const CCNxManifestSection *section, size_t index)
+_ccnxManifestSection_UpdateDigestIndex(CCNxManifestSection *section)
 {
-    _CCNxManifestSectionHashEntry *hashEntry = (_CCNxManifestSectionHashEntry *)parcList_GetAtIndex(section->listOfHashes, index);
-    size_t nameIndex = hashEntry->nameIndex;
-    _CCNxManifestSectionNameEntry *nameEntry = (_CCNxManifestSectionNameEntry *)parcList_GetAtIndex(section->listOfNames, nameIndex);
-    return nameEntry;
-}
+    if (__atomic_load_n(&section->indexedHashes, __ATOMIC_ACQUIRE) == section->numberOfHashes && section->digestSlots != NULL) {
+        return;
+    }
 
-static PARCBuffer *
-_ccnxManifestSection_GetHashEntryDigest(const _CCNxManifestSectionHashEntry *entry)
-{
-    return entry->hash;
+    pthread_mutex_lock(&_ccnxManifestSection_IndexLock);
+    _ccnxManifestSection_UpdateDigestIndexLocked(section);
+    pthread_mutex_unlock(&_ccnxManifestSection_IndexLock);
 }
 
 static void
 _ccnxManifestSection_FinalRelease(CCNxManifestSection **sectionP)
 {
-    if ((*sectionP)->acsLink != NULL) {
-        ccnxLink_Release(&(*sectionP)->acsLink);
+    CCNxManifestSection *section = *sectionP;
+    if (section->acsLink != NULL) {
+        ccnxLink_Release(&section->acsLink);
     }
-    if ((*sectionP)->listOfHashes != NULL) {
-        parcList_Release(&(*sectionP)->listOfHashes);
+
+    for (size_t i = 0; i < section->numberOfNames; i++) {
+        ccnxName_Release(&section->names[i].mediaName);
     }
-    if ((*sectionP)->listOfNames != NULL) {
-        parcList_Release(&(*sectionP)->listOfNames);
+    if (section->names != NULL) {
+        parcMemory_Deallocate((void **) &section->names);
+    }
+
+    if (section->hashBuffers != NULL) {
+        for (size_t i = 0; i < section->numberOfHashes; i++) {
+            if (section->hashBuffers[i] != NULL) {
+                parcBuffer_Release(&section->hashBuffers[i]);
+            }
+        }
+        parcMemory_Deallocate((void **) &section->hashBuffers);
+    }
+    if (section->digestSlots != NULL) {
+        parcMemory_Deallocate((void **) &section->digestSlots);
+    }
+    if (section->digests != NULL) {
+        parcMemory_Deallocate((void **) &section->digests);
+        parcMemory_Deallocate((void **) &section->nameIndexes);
+        parcMemory_Deallocate((void **) &section->chunkOffsets);
     }
 }
 
@@ -199,37 +231,36 @@ parcObject_ImplementRelease(ccnxManifestSection, CCNxManifestSection);
 // Public functions
 
 CCNxManifestSection *
-ccnxManifestSection_Create(CCNxLink *acsLink)
+ccnxManifestSection_CreateWithCapacity(CCNxLink *acsLink, size_t hashCapacity)
 {
     CCNxManifestSection *section = parcObject_CreateAndClearInstance(CCNxManifestSection);
 
     if (section != NULL) {
         section->acsLink = acsLink == NULL ? NULL : ccnxLink_Acquire(acsLink);
-
-        PARCArrayList *hashList = parcArrayList_Create((void (*)(void **))_ccnxManifestSectionHashEntry_Release);
-        section->listOfHashes = parcList((PARCObject *)hashList, PARCArrayListAsPARCList);
-        section->numberOfHashes = 0;
-
-        PARCArrayList *nameList = parcArrayList_Create((void (*)(void **))_ccnxManifestSectionNameEntry_Release);
-        section->listOfNames = parcList((PARCObject *)nameList, PARCArrayListAsPARCList);
-        section->numberOfNames = 0;
+        _ccnxManifestSection_EnsureHashCapacity(section, hashCapacity);
     }
 
     return section;
 }
 
+CCNxManifestSection *
+ccnxManifestSection_Create(CCNxLink *acsLink)
+{
+    return ccnxManifestSection_CreateWithCapacity(acsLink, 0);
+}
+
 CCNxName *
 ccnxManifestSection_GetNameFromHashIndex(const CCNxManifestSection *section, size_t index)
 {
-    _CCNxManifestSectionNameEntry *nameEntry = _getNameEntryFromHashIndex(section, index);
-    return nameEntry->mediaName;
+    assertTrue(index < section->numberOfHashes, "Hash index %zu out of range %zu", index, section->numberOfHashes);
+    return section->names[section->nameIndexes[index]].mediaName;
 }
 
 size_t
 ccnxManifestSection_GetNameChunkFromHashIndex(const CCNxManifestSection *section, size_t index)
 {
-    _CCNxManifestSectionNameEntry *nameEntry = _getNameEntryFromHashIndex(section, index);
-    return nameEntry->chunk;
+    assertTrue(index < section->numberOfHashes, "Hash index %zu out of range %zu", index, section->numberOfHashes);
+    return section->names[section->nameIndexes[index]].chunk + section->chunkOffsets[index];
 }
 
 CCNxLink *
@@ -250,32 +281,208 @@ ccnxManifestSection_GetHashCount(const CCNxManifestSection *section)
     return section->numberOfHashes;
 }
 
+const uint8_t *
+ccnxManifestSection_GetDigestAtIndex(const CCNxManifestSection *section, size_t index)
+{
+    assertTrue(index < section->numberOfHashes, "Hash index %zu out of range %zu", index, section->numberOfHashes);
+    return &section->digests[index * CCNxManifestSection_DigestLength];
+}
+
+const uint8_t *
+ccnxManifestSection_GetDigestArray(const CCNxManifestSection *section)
+{
+    return section->digests;
+}
+
 PARCBuffer *
 ccnxManifestSection_GetHashAtIndex(const CCNxManifestSection *section, size_t index)
 {
-    _CCNxManifestSectionHashEntry *hashEntry =
-        (_CCNxManifestSectionHashEntry *)parcList_GetAtIndex(section->listOfHashes, index);
-    PARCBuffer *retBuffer = _ccnxManifestSection_GetHashEntryDigest(hashEntry);
-    return retBuffer;
+    assertTrue(index < section->numberOfHashes, "Hash index %zu out of range %zu", index, section->numberOfHashes);
+
+    // The buffers are a cache of the digest array, so this does not change the section's value.
+    // Readers on several threads may race to create them; the first compare-and-swap wins and
+    // the others free their copy.
+    CCNxManifestSection *cache = (CCNxManifestSection *) section;
+    PARCBuffer **hashBuffers = __atomic_load_n(&cache->hashBuffers, __ATOMIC_ACQUIRE);
+    if (hashBuffers == NULL) {
+        PARCBuffer **created = parcMemory_AllocateAndClear(cache->hashCapacity * sizeof(PARCBuffer *));
+        assertNotNull(created, "parcMemory_AllocateAndClear(%zu) returned NULL", cache->hashCapacity * sizeof(PARCBuffer *));
+        if (__atomic_compare_exchange_n(&cache->hashBuffers, &hashBuffers, created, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            hashBuffers = created;
+        } else {
+            parcMemory_Deallocate((void **) &created);
+        }
+    }
+
+    PARCBuffer *hash = __atomic_load_n(&hashBuffers[index], __ATOMIC_ACQUIRE);
+    if (hash == NULL) {
+        PARCBuffer *buffer = parcBuffer_Allocate(CCNxManifestSection_DigestLength);
+        parcBuffer_PutArray(buffer, CCNxManifestSection_DigestLength, ccnxManifestSection_GetDigestAtIndex(section, index));
+        parcBuffer_Flip(buffer);
+        if (__atomic_compare_exchange_n(&hashBuffers[index], &hash, buffer, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            hash = buffer;
+        } else {
+            parcBuffer_Release(&buffer);
+        }
+    }
+
+    return hash;
 }
 
 bool
 ccnxManifestSection_AddNameEntry(CCNxManifestSection *section, const CCNxName *name, size_t chunk, const PARCBuffer *digest)
 {
-    _CCNxManifestSectionNameEntry *nameEntry = _ccnxManifestSection_CreateNameEntry(chunk, name);
-    _CCNxManifestSectionHashEntry *hashEntry = _ccnxManifestSection_CreateHashEntry(section->numberOfNames, digest);
+    if (parcBuffer_Remaining(digest) != CCNxManifestSection_DigestLength) {
+        return false;
+    }
+
+    size_t nameIndex = ccnxManifestSection_AddName(section, name, chunk);
+    return ccnxManifestSection_AddHash(section, nameIndex, digest);
+}
+
+size_t
+ccnxManifestSection_AddName(CCNxManifestSection *section, const CCNxName *name, size_t chunk)
+{
+    assertTrue(section->numberOfNames < UINT32_MAX, "Too many name entries");
+    _ccnxManifestSection_EnsureNameCapacity(section, section->numberOfNames + 1);
+
+    size_t nameIndex = section->numberOfNames;
+    section->names[nameIndex].chunk = chunk;
+    section->names[nameIndex].mediaName = ccnxName_Acquire(name);
+    section->names[nameIndex].hashCount = 0;
+    section->numberOfNames++;
 
-    // Add elements to both lists
-    bool successful = parcList_Add(section->listOfNames, (void *) nameEntry);
-    if (successful) {
-        section->numberOfNames++;
+    return nameIndex;
+}
+
+bool
+ccnxManifestSection_AddHashArray(CCNxManifestSection *section, size_t nameIndex, size_t count, const uint8_t *digests)
+{
+    if (nameIndex >= section->numberOfNames) {
+        return false;
     }
-    successful = parcList_Add(section->listOfHashes, (void *) hashEntry);
-    if (successful) {
-        section->numberOfHashes++;
+
+    _CCNxManifestSectionNameEntry *entry = &section->names[nameIndex];
+    assertTrue(entry->hashCount + count <= UINT32_MAX, "Too many hashes under name entry %zu", nameIndex);
+
+    _ccnxManifestSection_EnsureHashCapacity(section, section->numberOfHashes + count);
+
+    memcpy(&section->digests[section->numberOfHashes * CCNxManifestSection_DigestLength], digests, count * CCNxManifestSection_DigestLength);
+    for (size_t i = 0; i < count; i++) {
+        section->nameIndexes[section->numberOfHashes + i] = (uint32_t) nameIndex;
+        section->chunkOffsets[section->numberOfHashes + i] = (uint32_t) (entry->hashCount + i);
     }
+    section->numberOfHashes += count;
+    entry->hashCount += count;
 
-    return successful;
+    return true;
+}
+
+bool
+ccnxManifestSection_AddHash(CCNxManifestSection *section, size_t nameIndex, const PARCBuffer *digest)
+{
+    if (parcBuffer_Remaining(digest) != CCNxManifestSection_DigestLength) {
+        return false;
+    }
+
+    // Overlay(0) returns the current position without moving it
+    return ccnxManifestSection_AddHashArray(section, nameIndex, 1, parcBuffer_Overlay((PARCBuffer *) digest, 0));
+}
+
+CCNxName *
+ccnxManifestSection_GetNameAtIndex(const CCNxManifestSection *section, size_t nameIndex)
+{
+    assertTrue(nameIndex < section->numberOfNames, "Name index %zu out of range %zu", nameIndex, section->numberOfNames);
+    return section->names[nameIndex].mediaName;
+}
+
+size_t
+ccnxManifestSection_GetChunkAtIndex(const CCNxManifestSection *section, size_t nameIndex)
+{
+    assertTrue(nameIndex < section->numberOfNames, "Name index %zu out of range %zu", nameIndex, section->numberOfNames);
+    return section->names[nameIndex].chunk;
+}
+
+size_t
+ccnxManifestSection_GetNameIndexFromHashIndex(const CCNxManifestSection *section, size_t index)
+{
+    assertTrue(index < section->numberOfHashes, "Hash index %zu out of range %zu", index, section->numberOfHashes);
+    return section->nameIndexes[index];
+}
+
+void
+ccnxManifestSection_BuildDigestIndex(CCNxManifestSection *section)
+{
+    _ccnxManifestSection_UpdateDigestIndex(section);
+}
+
+bool
+ccnxManifestSection_FindDigest(const CCNxManifestSection *section, const uint8_t *digest, size_t *hashIndexPtr)
+{
+    if (section->numberOfHashes == 0) {
+        return false;
+    }
+
+    // The index is a cache of the digest array, so this does not change the section's value
+    CCNxManifestSection *cache = (CCNxManifestSection *) section;
+    _ccnxManifestSection_UpdateDigestIndex(cache);
+
+    size_t slot = _ccnxManifestSection_DigestSlot(digest) & cache->digestSlotMask;
+    while (cache->digestSlots[slot] != 0) {
+        size_t index = cache->digestSlots[slot] - 1;
+        if (memcmp(&cache->digests[index * CCNxManifestSection_DigestLength], digest, CCNxManifestSection_DigestLength) == 0) {
+            *hashIndexPtr = index;
+            return true;
+        }
+        slot = (slot + 1) & cache->digestSlotMask;
+    }
+    return false;
+}
+
+bool
+ccnxManifestSection_FindHash(const CCNxManifestSection *section, const PARCCryptoHash *hash, size_t *nameIndexPtr, size_t *chunkPtr)
+{
+    PARCBuffer *digest = parcCryptoHash_GetDigest(hash);
+    if (parcCryptoHash_GetDigestType(hash) != PARC_HASH_SHA256 || parcBuffer_Remaining(digest) != CCNxManifestSection_DigestLength) {
+        return false;
+    }
+
+    size_t hashIndex;
+    if (!ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(digest, 0), &hashIndex)) {
+        return false;
+    }
+
+    size_t nameIndex = section->nameIndexes[hashIndex];
+    if (nameIndexPtr != NULL) {
+        *nameIndexPtr = nameIndex;
+    }
+    if (chunkPtr != NULL) {
+        *chunkPtr = section->names[nameIndex].chunk + section->chunkOffsets[hashIndex];
+    }
+    return true;
+}
+
+CCNxManifestSectionHashIterator
+ccnxManifestSection_HashIterator(const CCNxManifestSection *section)
+{
+    CCNxManifestSectionHashIterator iterator = { .section = section, .position = 0 };
+    return iterator;
+}
+
+bool
+ccnxManifestSectionHashIterator_Next(CCNxManifestSectionHashIterator *iterator, const uint8_t **digestPtr, size_t *nameIndexPtr)
+{
+    const CCNxManifestSection *section = iterator->section;
+    if (iterator->position >= section->numberOfHashes) {
+        return false;
+    }
+
+    *digestPtr = &section->digests[iterator->position * CCNxManifestSection_DigestLength];
+    if (nameIndexPtr != NULL) {
+        *nameIndexPtr = section->nameIndexes[iterator->position];
+    }
+    iterator->position++;
+    return true;
 }
 
 bool
@@ -290,21 +497,18 @@ ccnxManifestSection_Equals(const CCNxManifestSection *objectA, const CCNxManifes
     if (ccnxLink_Equals(objectA->acsLink, objectB->acsLink)) {
         if (objectA->numberOfHashes == objectB->numberOfHashes) {
             if (objectA->numberOfNames == objectB->numberOfNames) {
-                for (size_t i = 0; i < parcList_Size(objectA->listOfHashes); i++) {
-                    _CCNxManifestSectionHashEntry *entryA =
-                        (_CCNxManifestSectionHashEntry *)parcList_GetAtIndex(objectA->listOfHashes, i);
-                    _CCNxManifestSectionHashEntry *entryB =
-                        (_CCNxManifestSectionHashEntry *)parcList_GetAtIndex(objectB->listOfHashes, i);
-                    if (!_ccnxManifestSectionHashEntry_Equals(entryA, entryB)) {
+                size_t hashCount = objectA->numberOfHashes;
+                if (hashCount > 0) {
+                    if (memcmp(objectA->digests, objectB->digests, hashCount * CCNxManifestSection_DigestLength) != 0) {
+                        return false;
+                    }
+                    if (memcmp(objectA->nameIndexes, objectB->nameIndexes, hashCount * sizeof(uint32_t)) != 0) {
                         return false;
                     }
                 }
-                for (size_t i = 0; i < parcList_Size(objectA->listOfNames); i++) {
-                    _CCNxManifestSectionNameEntry *entryA =
-                        (_CCNxManifestSectionNameEntry *)parcList_GetAtIndex(objectA->listOfNames, i);
-                    _CCNxManifestSectionNameEntry *entryB =
-                        (_CCNxManifestSectionNameEntry *)parcList_GetAtIndex(objectB->listOfNames, i);
-                    if (!_ccnxManifestSectionNameEntry_Equals(entryA, entryB)) {
+                for (size_t i = 0; i < objectA->numberOfNames; i++) {
+                    if (objectA->names[i].chunk != objectB->names[i].chunk
+                        || !ccnxName_Equals(objectA->names[i].mediaName, objectB->names[i].mediaName)) {
                         return false;
                     }
                 }
@@ -39,8 +39,8 @@
 #include <ccnx/common/ccnx_Link.h>
 
 #include <parc/security/parc_Signature.h>
+#include <parc/security/parc_CryptoHash.h>
 #include <parc/algol/parc_Buffer.h>
-#include <parc/algol/parc_List.h>
 #include <parc/algol/parc_Memory.h>
 
 struct ccnx_manifest_section;
@@ -48,9 +48,28 @@ struct ccnx_manifest_section;
 /**
  * @typedef CCNxManifestSection
  * @brief A section in a generic Manifest (metadata or payload)
+ *
+ * A section stores its hash digests in one contiguous array of fixed-width SHA-256 entries,
+ * with a parallel array of name indexes, so every accessor is O(1) and no object is created per entry.
  */
 typedef struct ccnx_manifest_section CCNxManifestSection;
 
+/**
+ * The length of every hash digest in a section (SHA-256)
+ */
+#define CCNxManifestSection_DigestLength 32
+
+/**
+ * @typedef CCNxManifestSectionHashIterator
+ * @brief Walks the hash entries of a section from index 0, see {@link ccnxManifestSection_HashIterator}.
+ *
+ * The fields are private.  The iterator is a value on the caller's stack and needs no release.
+ */
+typedef struct ccnx_manifest_section_hash_iterator {
+    const CCNxManifestSection *section;
+    size_t position;
+} CCNxManifestSectionHashIterator;
+
 /**
  * Create a new {@link CCNxManifestSection} instance.
  *
@@ -74,6 +93,30 @@ typedef struct ccnx_manifest_section CCNxManifestSection;
  */
 CCNxManifestSection *ccnxManifestSection_Create(CCNxLink *acsLink);
 
+/**
+ * Create a new {@link CCNxManifestSection} instance with room for `hashCapacity` hash entries.
+ *
+ * The section grows as needed; sizing it up front avoids reallocating the digest array
+ * while a large manifest is built or decoded.
+ *
+ * @param [in] acsLink - A pointer to a {@link CCNxLink} to the ACS - optional.
+ * @param [in] hashCapacity - The number of hash entries to allocate, may be 0.
+ *
+ * @return A pointer to a {@link CCNxManifestSection} instance, or NULL if an error or out of memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestSection *section = ccnxManifestSection_CreateWithCapacity(NULL, 2048);
+ *
+ *     ...
+ *
+ *     ccnxManifestSection_Release(&section);
+ * }
+ * @endcode
+ */
+CCNxManifestSection *ccnxManifestSection_CreateWithCapacity(CCNxLink *acsLink, size_t hashCapacity);
+
 /**
  * Increase the number of references to an instance of this object.
  *
@@ -145,9 +188,9 @@ void ccnxManifestSection_AssertValid(const CCNxManifestSection *manifest);
  * @param [in] section - A {@link CCNxManifestSection} instance.
  * @param [in] name - The {@link CCNxName} instance to add.
  * @param [in] chunk - The chunk for the name entry.
- * @param [in] digest - The hash digest of the name entry.
+ * @param [in] digest - The hash digest of the name entry, `CCNxManifestSection_DigestLength` bytes.
  *
- * @return True if the name was added successful, False otherwise.
+ * @return True if the name was added successful, False if the digest is not `CCNxManifestSection_DigestLength` bytes.
  *
  * Example:
  * @code
@@ -167,6 +210,81 @@ void ccnxManifestSection_AssertValid(const CCNxManifestSection *manifest);
  */
 bool ccnxManifestSection_AddNameEntry(CCNxManifestSection *section, const CCNxName *name, size_t chunk, const PARCBuffer *digest);
 
+/**
+ * Add a name entry to the {@link CCNxManifestSection} without a hash digest.
+ *
+ * Name entries are numbered in the order they are added, starting at 0.  Use the returned
+ * index with `ccnxManifestSection_AddHash()` to add one or more digests under the name.
+ * The digests are for consecutive chunks of the name: the first one added is chunk @p chunk,
+ * the next one is chunk @p chunk + 1, and so on.
+ *
+ * @param [in] section - A {@link CCNxManifestSection} instance.
+ * @param [in] name - The {@link CCNxName} instance to add.
+ * @param [in] chunk - The chunk of the first digest added under the name.
+ *
+ * @return The index of the new name entry.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+ *
+ *     CCNxName *name = ccnxName_CreateFromURI("lci:/some/content");
+ *     size_t nameIndex = ccnxManifestSection_AddName(section, name, 0);
+ *     ccnxManifestSection_AddHash(section, nameIndex, firstDigest);
+ *     ccnxManifestSection_AddHash(section, nameIndex, secondDigest);
+ *
+ *     ccnxName_Release(&name);
+ *     ccnxManifestSection_Release(&section);
+ * }
+ * @endcode
+ */
+size_t ccnxManifestSection_AddName(CCNxManifestSection *section, const CCNxName *name, size_t chunk);
+
+/**
+ * Add a hash digest under an existing name entry of the {@link CCNxManifestSection}.
+ *
+ * @param [in] section - A {@link CCNxManifestSection} instance.
+ * @param [in] nameIndex - The index of a name entry, as returned by `ccnxManifestSection_AddName()`.
+ * @param [in] digest - The hash digest to add, `CCNxManifestSection_DigestLength` bytes.
+ *
+ * @return True if the hash was added, False if @p nameIndex is not a name entry or the digest is the wrong length.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t nameIndex = ccnxManifestSection_AddName(section, name, 0);
+ *     ccnxManifestSection_AddHash(section, nameIndex, digest);
+ * }
+ * @endcode
+ */
+bool ccnxManifestSection_AddHash(CCNxManifestSection *section, size_t nameIndex, const PARCBuffer *digest);
+
+/**
+ * Add `count` packed hash digests under an existing name entry of the {@link CCNxManifestSection}.
+ *
+ * The digests are copied with one memcpy, so a decoder can add a run of digests
+ * straight from a packet without creating a buffer per digest.
+ *
+ * @param [in] section - A {@link CCNxManifestSection} instance.
+ * @param [in] nameIndex - The index of a name entry, as returned by `ccnxManifestSection_AddName()`.
+ * @param [in] count - The number of digests.
+ * @param [in] digests - `count * CCNxManifestSection_DigestLength` bytes.
+ *
+ * @return True if the hashes were added, False if @p nameIndex is not a name entry.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t digests[2 * CCNxManifestSection_DigestLength];
+ *     // fill in the digests
+ *     size_t nameIndex = ccnxManifestSection_AddName(section, name, 0);
+ *     ccnxManifestSection_AddHashArray(section, nameIndex, 2, digests);
+ * }
+ * @endcode
+ */
+bool ccnxManifestSection_AddHashArray(CCNxManifestSection *section, size_t nameIndex, size_t count, const uint8_t *digests);
+
 /**
  * Get a {@link CCNxLink} for the Access Control Specification for the {@link CCNxManifestSection}.
  *
@@ -270,7 +388,8 @@ CCNxName *ccnxManifestSection_GetNameFromHashIndex(const CCNxManifestSection *se
  * @param [in] section A pointer to the {@link CCNxManifestSection} from which to extract the media name at @p index.
  * @param [in] index The index into @p section from which to extract the media name.
  *
- * @return The chunk number associated with the name of the specified hash entry.
+ * @return The chunk number of the specified hash entry: the chunk of its name entry plus the
+ *         number of hashes added under that name before it.
  *
  * Example:
  * @code
@@ -291,9 +410,68 @@ CCNxName *ccnxManifestSection_GetNameFromHashIndex(const CCNxManifestSection *se
  */
 size_t ccnxManifestSection_GetNameChunkFromHashIndex(const CCNxManifestSection *section, size_t index);
 
+/**
+ * Get the media name of a name entry of a {@link CCNxManifestSection}.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ * @param [in] nameIndex The index of the name entry, less than `ccnxManifestSection_GetNameCount()`.
+ *
+ * @return A pointer to the {@link CCNxName} of the name entry.
+ *
+ * Example:
+ * @code
+ * {
+ *     for (size_t i = 0; i < ccnxManifestSection_GetNameCount(section); i++) {
+ *         CCNxName *name = ccnxManifestSection_GetNameAtIndex(section, i);
+ *         size_t chunk = ccnxManifestSection_GetChunkAtIndex(section, i);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxName *ccnxManifestSection_GetNameAtIndex(const CCNxManifestSection *section, size_t nameIndex);
+
+/**
+ * Get the chunk number of a name entry of a {@link CCNxManifestSection}.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ * @param [in] nameIndex The index of the name entry, less than `ccnxManifestSection_GetNameCount()`.
+ *
+ * @return The chunk number of the name entry.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t chunk = ccnxManifestSection_GetChunkAtIndex(section, 0);
+ * }
+ * @endcode
+ */
+size_t ccnxManifestSection_GetChunkAtIndex(const CCNxManifestSection *section, size_t nameIndex);
+
+/**
+ * Get the index of the name entry that a hash entry of a {@link CCNxManifestSection} belongs to.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ * @param [in] index The index of the hash entry, less than `ccnxManifestSection_GetHashCount()`.
+ *
+ * @return The name index of the hash entry.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t nameIndex = ccnxManifestSection_GetNameIndexFromHashIndex(section, 0);
+ *     CCNxName *name = ccnxManifestSection_GetNameAtIndex(section, nameIndex);
+ * }
+ * @endcode
+ */
+size_t ccnxManifestSection_GetNameIndexFromHashIndex(const CCNxManifestSection *section, size_t index);
+
 /**
  * Get the hash at an index into a {@link CCNxManifestSection}.
  *
+ * The buffer is owned by the section and is created the first time the index is asked for.
+ * Several threads may ask at once, and all of them get the same buffer.
+ * `ccnxManifestSection_GetDigestAtIndex()` reads the same digest without creating anything.
+ *
  * @param [in] section A pointer to the {@link CCNxManifestSection} from which to get the hashe at @p index.
  * @param [in] index An index into @p section from which to get the hash.
  *
@@ -318,6 +496,172 @@ size_t ccnxManifestSection_GetNameChunkFromHashIndex(const CCNxManifestSection *
  */
 PARCBuffer *ccnxManifestSection_GetHashAtIndex(const CCNxManifestSection *section, size_t index);
 
+/**
+ * Get the digest of a hash entry of a {@link CCNxManifestSection}.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ * @param [in] index The index of the hash entry, less than `ccnxManifestSection_GetHashCount()`.
+ *
+ * @return `CCNxManifestSection_DigestLength` bytes owned by the section, valid until the next hash is added.
+ *
+ * Example:
+ * @code
+ * {
+ *     const uint8_t *digest = ccnxManifestSection_GetDigestAtIndex(section, 0);
+ *     bool match = memcmp(digest, received, CCNxManifestSection_DigestLength) == 0;
+ * }
+ * @endcode
+ */
+const uint8_t *ccnxManifestSection_GetDigestAtIndex(const CCNxManifestSection *section, size_t index);
+
+/**
+ * Get all the digests of a {@link CCNxManifestSection} as one array.
+ *
+ * Hash entry `i` is at offset `i * CCNxManifestSection_DigestLength`.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ *
+ * @return `ccnxManifestSection_GetHashCount() * CCNxManifestSection_DigestLength` bytes owned by the section,
+ *         valid until the next hash is added.  May be NULL if the section has no hashes.
+ *
+ * Example:
+ * @code
+ * {
+ *     const uint8_t *digests = ccnxManifestSection_GetDigestArray(section);
+ *     size_t length = ccnxManifestSection_GetHashCount(section) * CCNxManifestSection_DigestLength;
+ * }
+ * @endcode
+ */
+const uint8_t *ccnxManifestSection_GetDigestArray(const CCNxManifestSection *section);
+
+/**
+ * Build the digest index used by {@link ccnxManifestSection_FindDigest}.
+ *
+ * ccnxManifestSection_FindDigest() builds the index on its first lookup.  Calling this once the
+ * hashes are added, before the section is shared between threads, keeps that work off the lookups.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestSection_AddHashArray(section, nameIndex, count, digests);
+ *     ccnxManifestSection_BuildDigestIndex(section);
+ *
+ *     size_t hashIndex;
+ *     bool found = ccnxManifestSection_FindDigest(section, digest, &hashIndex);
+ * }
+ * @endcode
+ */
+void ccnxManifestSection_BuildDigestIndex(CCNxManifestSection *section);
+
+/**
+ * Find the hash entry of a {@link CCNxManifestSection} with the given digest.
+ *
+ * The first lookup builds a hash index over the section's digests; later lookups are O(1).
+ * Hashes added after the index is built are indexed on the next lookup.  If the same digest
+ * appears more than once, the lowest hash index is returned.
+ *
+ * The index is a cache inside the section.  Lookups from several threads may run at once; the
+ * first one after hashes are added updates the index under a lock.  Adding hashes must not run
+ * concurrently with any other use of the section.  Call ccnxManifestSection_BuildDigestIndex()
+ * before sharing a section to build the index up front.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ * @param [in] digest `CCNxManifestSection_DigestLength` bytes to look up.
+ * @param [out] hashIndexPtr If found, the index of the hash entry.
+ *
+ * @return true The digest is in the section and its index is in hashIndexPtr.
+ * @return false The digest is not in the section.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t hashIndex;
+ *     if (ccnxManifestSection_FindDigest(section, digest, &hashIndex)) {
+ *         _markReceived(hashIndex);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxManifestSection_FindDigest(const CCNxManifestSection *section, const uint8_t *digest, size_t *hashIndexPtr);
+
+/**
+ * Find the name entry satisfied by a Content Object with the given hash.
+ *
+ * This is {@link ccnxManifestSection_FindDigest} for a ContentObjectHash, such as the one from
+ * `ccnxWireFormatMessage_CreateContentObjectHash()`.  A hash that is not SHA-256 is never found.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ * @param [in] hash The hash of a received Content Object.
+ * @param [out] nameIndexPtr If found and non-NULL, the name index of the matching hash entry.
+ * @param [out] chunkPtr If found and non-NULL, the chunk number of the matching hash entry.
+ *
+ * @return true The hash is in the section.
+ * @return false The hash is not in the section.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(message);
+ *     size_t nameIndex;
+ *     size_t chunk;
+ *     if (ccnxManifestSection_FindHash(section, hash, &nameIndex, &chunk)) {
+ *         // the Content Object is chunk `chunk` of ccnxManifestSection_GetNameAtIndex(section, nameIndex)
+ *     }
+ *     parcCryptoHash_Release(&hash);
+ * }
+ * @endcode
+ */
+bool ccnxManifestSection_FindHash(const CCNxManifestSection *section, const PARCCryptoHash *hash, size_t *nameIndexPtr, size_t *chunkPtr);
+
+/**
+ * Create an iterator over the hash entries of a {@link CCNxManifestSection}.
+ *
+ * The iterator returns the hash entries in index order at O(1) per entry and creates no objects.
+ * Adding hashes while iterating is not supported.
+ *
+ * @param [in] section A pointer to the {@link CCNxManifestSection}.
+ *
+ * @return An iterator positioned before the first hash entry.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestSectionHashIterator iterator = ccnxManifestSection_HashIterator(section);
+ *     const uint8_t *digest;
+ *     size_t nameIndex;
+ *     while (ccnxManifestSectionHashIterator_Next(&iterator, &digest, &nameIndex)) {
+ *         _verifyChunk(ccnxManifestSection_GetNameAtIndex(section, nameIndex), digest);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxManifestSectionHashIterator ccnxManifestSection_HashIterator(const CCNxManifestSection *section);
+
+/**
+ * Advance the iterator and return the next hash entry.
+ *
+ * @param [in,out] iterator An iterator from {@link ccnxManifestSection_HashIterator}.
+ * @param [out] digestPtr If there is a next entry, its `CCNxManifestSection_DigestLength` byte digest.
+ * @param [out] nameIndexPtr If there is a next entry and this is non-NULL, its name index.
+ *
+ * @return true The entry was returned in digestPtr and nameIndexPtr.
+ * @return false The iterator is at the end of the section.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestSectionHashIterator iterator = ccnxManifestSection_HashIterator(section);
+ *     const uint8_t *digest;
+ *     while (ccnxManifestSectionHashIterator_Next(&iterator, &digest, NULL)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxManifestSectionHashIterator_Next(CCNxManifestSectionHashIterator *iterator, const uint8_t **digestPtr, size_t *nameIndexPtr);
+
 /**
  * Determine if two {@link CCNxManifestSection} instances are equal.
  *
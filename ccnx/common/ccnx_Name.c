@@ -40,32 +40,269 @@
 
 #include <parc/algol/parc_Hash.h>
 #include <parc/algol/parc_Memory.h>
-#include <parc/algol/parc_ArrayList.h>
 #include <parc/algol/parc_URI.h>
 #include <parc/algol/parc_URIPath.h>
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Object.h>
 
+/*
+ * A name is kept in its wire format: the segments are TLV encoded back to back
+ * (2 byte type, 2 byte length, value) exactly as they appear inside a Name TLV.
+ * Equality and prefix tests are then a memcmp over one contiguous array.
+ */
+#define _CCNxName_SegmentHeaderLength 4
+
 struct ccnx_name {
-    PARCArrayList *segments;
+    uint8_t *encoded;
+    size_t encodedLength;
+    size_t encodedCapacity;
+
+    // prefixHashes[i] is the hash of segments 0 through i, segmentHashes[i] the hash of segment i alone.
+    // Both are computed as segments are added so ccnxName_LeftMostHashCode() is a lookup.
+    // prefixHashes is the start of one allocation that also holds segmentHashes, offsets and encoded.
+    PARCHashCode *prefixHashes;
+    PARCHashCode *segmentHashes;
+
+    // offsets[i] is the position of segment i's TLV header in `encoded`
+    uint32_t *offsets;
+    size_t segmentCount;
+    size_t segmentCapacity;
+
+    // segments[i] is the CCNxNameSegment given to ccnxName_Append() or created by the
+    // first ccnxName_GetSegment(), NULL until then.  The array itself is only allocated when needed.
+    CCNxNameSegment **segments;
+
+    // The number of segments whose label carries a parameter, which the wire format does not hold
+    size_t parameterCount;
 };
 
+static inline uint16_t
+_ccnxName_ReadUint16(const uint8_t *p)
+{
+    return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+static inline uint16_t
+_ccnxName_SegmentType(const CCNxName *name, size_t index)
+{
+    return _ccnxName_ReadUint16(&name->encoded[name->offsets[index]]);
+}
+
+static inline uint16_t
+_ccnxName_SegmentLength(const CCNxName *name, size_t index)
+{
+    return _ccnxName_ReadUint16(&name->encoded[name->offsets[index] + 2]);
+}
+
+static inline const uint8_t *
+_ccnxName_SegmentValue(const CCNxName *name, size_t index)
+{
+    return &name->encoded[name->offsets[index] + _CCNxName_SegmentHeaderLength];
+}
+
+/**
+ * The number of bytes of `encoded` used by the first `count` segments.
+ */
+static inline size_t
+_ccnxName_EncodedPrefixLength(const CCNxName *name, size_t count)
+{
+    return (count < name->segmentCount) ? name->offsets[count] : name->encodedLength;
+}
+
+static void
+_ccnxName_ReleaseSegments(CCNxName *name, size_t from)
+{
+    if (name->segments != NULL) {
+        for (size_t i = from; i < name->segmentCount; i++) {
+            if (name->segments[i] != NULL) {
+                if (ccnxNameSegment_GetParameter(name->segments[i]) != NULL) {
+                    name->parameterCount--;
+                }
+                ccnxNameSegment_Release(&name->segments[i]);
+            }
+        }
+    }
+}
+
 static void
 _destroy(CCNxName **pointer)
 {
     CCNxName *name = *pointer;
 
-    parcArrayList_Destroy(&name->segments);
+    _ccnxName_ReleaseSegments(name, 0);
+    if (name->segments != NULL) {
+        parcMemory_Deallocate((void **) &name->segments);
+    }
+    if (name->prefixHashes != NULL) {
+        // also frees segmentHashes, offsets and encoded, see _ccnxName_EnsureCapacity()
+        parcMemory_Deallocate((void **) &name->prefixHashes);
+    }
 }
 
 parcObject_ExtendPARCObject(CCNxName, _destroy, ccnxName_Copy, ccnxName_ToString, ccnxName_Equals, ccnxName_Compare, ccnxName_HashCode, NULL);
 
+/**
+ * Make room for `segments` more segments holding `bytes` more encoded bytes.
+ *
+ * The hash tables, the offset table and the encoded segments share one allocation, in that order.
+ */
+static void
+_ccnxName_EnsureCapacity(CCNxName *name, size_t segments, size_t bytes)
+{
+    size_t segmentCapacity = name->segmentCapacity;
+    if (name->segmentCount + segments > segmentCapacity) {
+        segmentCapacity *= 2;
+        if (segmentCapacity < name->segmentCount + segments) {
+            segmentCapacity = name->segmentCount + segments;
+        }
+    }
+
+    size_t encodedCapacity = name->encodedCapacity;
+    if (name->encodedLength + bytes > encodedCapacity) {
+        encodedCapacity *= 2;
+        if (encodedCapacity < name->encodedLength + bytes) {
+            encodedCapacity = name->encodedLength + bytes;
+        }
+    }
+
+    if (segmentCapacity != name->segmentCapacity || encodedCapacity != name->encodedCapacity) {
+        size_t size = segmentCapacity * (2 * sizeof(PARCHashCode) + sizeof(uint32_t)) + encodedCapacity;
+        PARCHashCode *prefixHashes = parcMemory_Allocate(size);
+        assertNotNull(prefixHashes, "parcMemory_Allocate(%zu) returned NULL", size);
+        PARCHashCode *segmentHashes = &prefixHashes[segmentCapacity];
+        uint32_t *offsets = (uint32_t *) &segmentHashes[segmentCapacity];
+        uint8_t *encoded = (uint8_t *) &offsets[segmentCapacity];
+
+        if (name->prefixHashes != NULL) {
+            memcpy(prefixHashes, name->prefixHashes, name->segmentCount * sizeof(PARCHashCode));
+            memcpy(segmentHashes, name->segmentHashes, name->segmentCount * sizeof(PARCHashCode));
+            memcpy(offsets, name->offsets, name->segmentCount * sizeof(uint32_t));
+            memcpy(encoded, name->encoded, name->encodedLength);
+            parcMemory_Deallocate((void **) &name->prefixHashes);
+        }
+
+        if (name->segments != NULL && segmentCapacity != name->segmentCapacity) {
+            name->segments = parcMemory_Reallocate(name->segments, segmentCapacity * sizeof(CCNxNameSegment *));
+            assertNotNull(name->segments, "parcMemory_Reallocate(%zu) returned NULL", segmentCapacity * sizeof(CCNxNameSegment *));
+            memset(&name->segments[name->segmentCapacity], 0, (segmentCapacity - name->segmentCapacity) * sizeof(CCNxNameSegment *));
+        }
+
+        name->prefixHashes = prefixHashes;
+        name->segmentHashes = segmentHashes;
+        name->offsets = offsets;
+        name->encoded = encoded;
+        name->segmentCapacity = segmentCapacity;
+        name->encodedCapacity = encodedCapacity;
+    }
+}
+
+/**
+ * The segments array, allocating it on first use.
+ *
+ * ccnxName_GetSegment() calls this on a `const` name that other threads may be reading, so the
+ * array is published with a compare-and-swap and a thread that loses the race frees its own.
+ */
+static CCNxNameSegment **
+_ccnxName_GetSegmentsArray(CCNxName *name)
+{
+    CCNxNameSegment **segments = __atomic_load_n(&name->segments, __ATOMIC_ACQUIRE);
+    if (segments == NULL && name->segmentCapacity > 0) {
+        CCNxNameSegment **fresh = parcMemory_AllocateAndClear(name->segmentCapacity * sizeof(CCNxNameSegment *));
+        assertNotNull(fresh, "parcMemory_AllocateAndClear(%zu) returned NULL", name->segmentCapacity * sizeof(CCNxNameSegment *));
+        if (__atomic_compare_exchange_n(&name->segments, &segments, fresh, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            segments = fresh;
+        } else {
+            parcMemory_Deallocate((void **) &fresh);
+        }
+    }
+    return segments;
+}
+
+/**
+ * Add the segment whose TLV starts at `offset` in `encoded` to the offset and hash tables.
+ */
+static void
+_ccnxName_IndexSegment(CCNxName *name, size_t offset)
+{
+    size_t index = name->segmentCount;
+    name->offsets[index] = (uint32_t) offset;
+
+    size_t length = _CCNxName_SegmentHeaderLength + _ccnxName_ReadUint16(&name->encoded[offset + 2]);
+    PARCHashCode segmentHash = parcHashCode_Hash(&name->encoded[offset], length);
+    name->segmentHashes[index] = segmentHash;
+
+    PARCHashCode prefixHash = (index == 0) ? 0 : name->prefixHashes[index - 1];
+    name->prefixHashes[index] = parcHashCode_HashHashCode(prefixHash, segmentHash);
+
+    name->segmentCount++;
+}
+
+static void
+_ccnxName_AppendTypeValue(CCNxName *name, uint16_t type, size_t length, const uint8_t *value)
+{
+    trapIllegalValueIf(length > UINT16_MAX, "Name segment too long!  length %zu maximum %u", length, UINT16_MAX);
+
+    _ccnxName_EnsureCapacity(name, 1, _CCNxName_SegmentHeaderLength + length);
+
+    uint8_t *p = &name->encoded[name->encodedLength];
+    p[0] = (uint8_t) (type >> 8);
+    p[1] = (uint8_t) type;
+    p[2] = (uint8_t) (length >> 8);
+    p[3] = (uint8_t) length;
+    if (length > 0) {
+        memcpy(&p[_CCNxName_SegmentHeaderLength], value, length);
+    }
+
+    _ccnxName_IndexSegment(name, name->encodedLength);
+    name->encodedLength += _CCNxName_SegmentHeaderLength + length;
+}
+
 CCNxName *
 ccnxName_Create(void)
 {
-    CCNxName *result = parcObject_CreateInstance(CCNxName);
+    CCNxName *result = parcObject_CreateAndClearInstance(CCNxName);
 
-    result->segments = parcArrayList_Create((void (*)(void **))ccnxNameSegment_Release);
+    return result;
+}
+
+CCNxName *
+ccnxName_CreateFromEncodedSegments(const PARCBuffer *encodedSegments)
+{
+    size_t length = parcBuffer_Remaining(encodedSegments);
+    const uint8_t *encoded = parcBuffer_Overlay((PARCBuffer *) encodedSegments, 0);
+    return ccnxName_CreateFromEncodedArray(length, encoded);
+}
+
+CCNxName *
+ccnxName_CreateFromEncodedArray(size_t length, const uint8_t encoded[length])
+{
+    // Count the segments first so the offset table is allocated once
+    size_t segmentCount = 0;
+    size_t position = 0;
+    while (position + _CCNxName_SegmentHeaderLength <= length) {
+        uint16_t type = _ccnxName_ReadUint16(&encoded[position]);
+        if (type == CCNxNameLabelType_BADNAME) {
+            return NULL;
+        }
+        position += _CCNxName_SegmentHeaderLength + _ccnxName_ReadUint16(&encoded[position + 2]);
+        segmentCount++;
+    }
+
+    if (position != length) {
+        // a segment runs past the end of the name
+        return NULL;
+    }
+
+    CCNxName *result = ccnxName_Create();
+    if (result != NULL && length > 0) {
+        _ccnxName_EnsureCapacity(result, segmentCount, length);
+        memcpy(result->encoded, encoded, length);
+        result->encodedLength = length;
+
+        for (position = 0; position < length; position += _CCNxName_SegmentHeaderLength + _ccnxName_ReadUint16(&encoded[position + 2])) {
+            _ccnxName_IndexSegment(result, position);
+        }
+    }
 
     return result;
 }
@@ -86,13 +323,8 @@ ccnxName_IsValid(const CCNxName *name)
     bool result = false;
 
     if (name != NULL) {
-        result = true;
-        for (size_t i = 0; i < parcArrayList_Size(name->segments); i++) {
-            CCNxNameSegment *segment = (CCNxNameSegment *)parcArrayList_Get(name->segments, i);
-            if (ccnxNameSegment_IsValid(segment) == false) {
-                result = false;
-                break;
-            }
+        if (name->segmentCount <= name->segmentCapacity && name->encodedLength <= name->encodedCapacity) {
+            result = (name->segmentCount == 0) || (name->offsets[name->segmentCount - 1] < name->encodedLength);
         }
     }
 
@@ -106,18 +338,47 @@ ccnxName_Copy(const CCNxName *originalName)
 
     CCNxName *result = ccnxName_Create();
 
-    if (result != NULL) {
-        for (int i = 0; i < ccnxName_GetSegmentCount(originalName); i++) {
-            CCNxNameSegment *component = ccnxName_GetSegment(originalName, i);
-            CCNxNameSegment *copy = ccnxNameSegment_Copy(component);
-            ccnxName_Append(result, copy);
-            ccnxNameSegment_Release(&copy);
+    if (result != NULL && originalName->segmentCount > 0) {
+        _ccnxName_EnsureCapacity(result, originalName->segmentCount, originalName->encodedLength);
+        memcpy(result->encoded, originalName->encoded, originalName->encodedLength);
+        memcpy(result->prefixHashes, originalName->prefixHashes, originalName->segmentCount * sizeof(PARCHashCode));
+        memcpy(result->segmentHashes, originalName->segmentHashes, originalName->segmentCount * sizeof(PARCHashCode));
+        memcpy(result->offsets, originalName->offsets, originalName->segmentCount * sizeof(uint32_t));
+        result->encodedLength = originalName->encodedLength;
+        result->segmentCount = originalName->segmentCount;
+
+        // Only a label parameter is not in the encoded form, so only those segments need copying
+        if (originalName->parameterCount > 0) {
+            CCNxNameSegment **segments = _ccnxName_GetSegmentsArray(result);
+            for (size_t i = 0; i < originalName->segmentCount; i++) {
+                CCNxNameSegment *segment = originalName->segments[i];
+                if (segment != NULL && ccnxNameSegment_GetParameter(segment) != NULL) {
+                    segments[i] = ccnxNameSegment_Copy(segment);
+                    result->parameterCount++;
+                }
+            }
         }
     }
 
     return result;
 }
 
+/**
+ * Compare the label parameters of two names with identical encodings.
+ */
+static bool
+_ccnxName_ParametersEqual(const CCNxName *a, const CCNxName *b)
+{
+    for (size_t i = 0; i < a->segmentCount; i++) {
+        PARCBuffer *parameterA = (a->segments == NULL || a->segments[i] == NULL) ? NULL : ccnxNameSegment_GetParameter(a->segments[i]);
+        PARCBuffer *parameterB = (b->segments == NULL || b->segments[i] == NULL) ? NULL : ccnxNameSegment_GetParameter(b->segments[i]);
+        if (!parcBuffer_Equals(parameterA, parameterB)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool
 ccnxName_Equals(const CCNxName *a, const CCNxName *b)
 {
@@ -127,13 +388,13 @@ ccnxName_Equals(const CCNxName *a, const CCNxName *b)
     if (a == NULL || b == NULL) {
         return false;
     }
-    if (ccnxName_GetSegmentCount(a) == ccnxName_GetSegmentCount(b)) {
-        for (int i = 0; i < ccnxName_GetSegmentCount(a); i++) {
-            if (!ccnxNameSegment_Equals(ccnxName_GetSegment(a, i), ccnxName_GetSegment(b, i))) {
-                return false;
+    if (a->segmentCount == b->segmentCount && a->encodedLength == b->encodedLength) {
+        if (a->encodedLength == 0 || memcmp(a->encoded, b->encoded, a->encodedLength) == 0) {
+            if (a->parameterCount == 0 && b->parameterCount == 0) {
+                return true;
             }
+            return _ccnxName_ParametersEqual(a, b);
         }
-        return true;
     }
     return false;
 }
@@ -167,7 +428,8 @@ ccnxName_FromLCIURI(const PARCURI *uri)
                 ccnxName_Release(&result);
                 break;
             }
-            parcArrayList_Add(result->segments, segment);
+            ccnxName_Append(result, segment);
+            ccnxNameSegment_Release(&segment);
         }
     }
 
@@ -203,10 +465,8 @@ ccnxName_CreateFromBuffer(const PARCBuffer *buffer)
 CCNxName *
 ccnxName_ComposeNAME(const CCNxName *name, const char *suffix)
 {
-    CCNxNameSegment *suffixSegment = ccnxNameSegment_CreateTypeValueArray(CCNxNameLabelType_NAME, strlen(suffix), suffix);
-
-    CCNxName *result = ccnxName_Append(ccnxName_Copy(name), suffixSegment);
-    ccnxNameSegment_Release(&suffixSegment);
+    CCNxName *result = ccnxName_Copy(name);
+    _ccnxName_AppendTypeValue(result, CCNxNameLabelType_NAME, strlen(suffix), (const uint8_t *) suffix);
 
     return result;
 }
@@ -217,11 +477,33 @@ ccnxName_Append(CCNxName *name, const CCNxNameSegment *segment)
     ccnxName_OptionalAssertValid(name);
     ccnxNameSegment_OptionalAssertValid(segment);
 
-    parcArrayList_Add(name->segments, (PARCObject *)ccnxNameSegment_Acquire(segment));
+    PARCBuffer *value = ccnxNameSegment_GetValue(segment);
+    size_t length = parcBuffer_Remaining(value);
+    const uint8_t *bytes = (length > 0) ? parcBuffer_Overlay(value, 0) : NULL;
+    _ccnxName_AppendTypeValue(name, (uint16_t) ccnxNameSegment_GetType(segment), length, bytes);
+
+    // Keep the caller's segment so ccnxName_GetSegment() does not have to rebuild it
+    CCNxNameSegment **segments = _ccnxName_GetSegmentsArray(name);
+    segments[name->segmentCount - 1] = ccnxNameSegment_Acquire(segment);
+    if (ccnxNameSegment_GetParameter(segment) != NULL) {
+        name->parameterCount++;
+    }
 
     return name;
 }
 
+const uint8_t *
+ccnxName_GetEncodedSegments(const CCNxName *name)
+{
+    return name->encoded;
+}
+
+size_t
+ccnxName_GetEncodedLength(const CCNxName *name)
+{
+    return name->encodedLength;
+}
+
 PARCBufferComposer *
 ccnxName_BuildString(const CCNxName *name, PARCBufferComposer *composer)
 {
@@ -260,13 +542,34 @@ ccnxName_ToString(const CCNxName *name)
 CCNxNameSegment *
 ccnxName_GetSegment(const CCNxName *name, size_t index)
 {
-    return (CCNxNameSegment *)parcArrayList_Get(name->segments, index);
+    trapOutOfBoundsIf(index >= name->segmentCount, "Index %zu out of range, name has %zu segments", index, name->segmentCount);
+
+    // The segment object is only built the first time someone asks for it.  Readers on other
+    // threads may race to build it, so it is published with a compare-and-swap.
+    CCNxNameSegment **segments = _ccnxName_GetSegmentsArray((CCNxName *) name);
+    CCNxNameSegment *segment = __atomic_load_n(&segments[index], __ATOMIC_ACQUIRE);
+    if (segment == NULL) {
+        size_t length = _ccnxName_SegmentLength(name, index);
+        PARCBuffer *value = parcBuffer_Allocate(length);
+        parcBuffer_PutArray(value, length, _ccnxName_SegmentValue(name, index));
+        parcBuffer_Flip(value);
+
+        CCNxNameSegment *fresh = ccnxNameSegment_CreateTypeValue(_ccnxName_SegmentType(name, index), value);
+        parcBuffer_Release(&value);
+
+        if (__atomic_compare_exchange_n(&segments[index], &segment, fresh, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            segment = fresh;
+        } else {
+            ccnxNameSegment_Release(&fresh);
+        }
+    }
+    return segment;
 }
 
 size_t
 ccnxName_GetSegmentCount(const CCNxName *name)
 {
-    return parcArrayList_Size(name->segments);
+    return name->segmentCount;
 }
 
 int
@@ -293,12 +596,20 @@ ccnxName_Compare(const CCNxName *name1, const CCNxName *name2)
 
     int result = 0;
 
-    for (size_t i = 0; i < mininimumSegments; i++) {
-        CCNxNameSegment *segment1 = ccnxName_GetSegment(name1, i);
-        CCNxNameSegment *segment2 = ccnxName_GetSegment(name2, i);
-        result = ccnxNameSegment_Compare(segment1, segment2);
-        if (result != 0) {
-            break;
+    // Same order as ccnxNameSegment_Compare(): shorter segments first, then by value.
+    // The type only breaks ties, so that Compare agrees with Equals.
+    for (size_t i = 0; i < mininimumSegments && result == 0; i++) {
+        uint16_t length1 = _ccnxName_SegmentLength(name1, i);
+        uint16_t length2 = _ccnxName_SegmentLength(name2, i);
+        if (length1 != length2) {
+            result = (length1 < length2) ? -1 : +1;
+        } else {
+            result = memcmp(_ccnxName_SegmentValue(name1, i), _ccnxName_SegmentValue(name2, i), length1);
+            if (result == 0) {
+                uint16_t type1 = _ccnxName_SegmentType(name1, i);
+                uint16_t type2 = _ccnxName_SegmentType(name2, i);
+                result = (type1 == type2) ? 0 : ((type1 < type2) ? -1 : +1);
+            }
         }
     }
 
@@ -316,7 +627,7 @@ ccnxName_Compare(const CCNxName *name1, const CCNxName *name2)
         }
     }
 
-    return result;
+    return (result < 0) ? -1 : ((result > 0) ? +1 : 0);
 }
 
 PARCHashCode
@@ -332,13 +643,7 @@ ccnxName_LeftMostHashCode(const CCNxName *name, size_t count)
         count = ccnxName_GetSegmentCount(name);
     }
 
-    PARCHashCode result = 0;
-    for (int i = 0; i < count; i++) {
-        PARCHashCode hashCode = ccnxNameSegment_HashCode(ccnxName_GetSegment(name, i));
-        parcHashCode_HashHashCode(result, hashCode);
-    }
-
-    return result;
+    return (count == 0) ? 0 : name->prefixHashes[count - 1];
 }
 
 /**
@@ -359,10 +664,11 @@ ccnxName_Trim(CCNxName *name, size_t numberToRemove)
         numberToRemove = ccnxName_GetSegmentCount(name);
     }
 
-    for (int i = 0; i < numberToRemove; i++) {
-        size_t lastItem = parcArrayList_Size(name->segments);
-        parcArrayList_RemoveAndDestroyAtIndex(name->segments, lastItem - 1);
-    }
+    size_t remaining = name->segmentCount - numberToRemove;
+    _ccnxName_ReleaseSegments(name, remaining);
+    name->encodedLength = _ccnxName_EncodedPrefixLength(name, remaining);
+    name->segmentCount = remaining;
+
     return name;
 }
 
@@ -373,15 +679,12 @@ ccnxName_StartsWith(const CCNxName *name, const CCNxName *prefix)
         return false;
     }
 
-    for (int i = 0; i < ccnxName_GetSegmentCount(prefix); i++) {
-        CCNxNameSegment *prefix_comp = ccnxName_GetSegment(prefix, i);
-        CCNxNameSegment *other_comp = ccnxName_GetSegment(name, i);
-
-        if (ccnxNameSegment_Compare(prefix_comp, other_comp) != 0) {
-            return false;
-        }
+    // The TLV encoding is self-delimiting, so equal bytes up to the same segment boundary means equal segments
+    size_t length = prefix->encodedLength;
+    if (_ccnxName_EncodedPrefixLength(name, prefix->segmentCount) != length) {
+        return false;
     }
-    return true;
+    return (length == 0) || (memcmp(name->encoded, prefix->encoded, length) == 0);
 }
 
 void
@@ -144,6 +144,57 @@ CCNxName *ccnxName_CreateFormatString(const char * restrict format, ...);
  */
 CCNxName *ccnxName_CreateFromBuffer(const PARCBuffer *buffer);
 
+/**
+ * Create a new instance of `CCNxName` from the value of a Name TLV: the TLV encoded
+ * name segments, back to back, from the buffer's position to its limit.
+ *
+ * The bytes are copied, the buffer's position is not changed.
+ * This is how the decoder builds names, no `CCNxNameSegment` is created.
+ *
+ * @param [in] encodedSegments The encoded segments.
+ * @return non-NULL A pointer to a `CCNxName` instance.
+ * @return NULL A segment runs past the end of the buffer or has type 0.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t encoded[] = { 0x00, 0x01, 0x00, 0x04, 'p', 'a', 'r', 'c' };
+ *     PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+ *     CCNxName *name = ccnxName_CreateFromEncodedSegments(buffer);
+ *
+ *     ccnxName_Release(&name);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ *
+ * @see ccnxName_GetEncodedSegments
+ */
+CCNxName *ccnxName_CreateFromEncodedSegments(const PARCBuffer *encodedSegments);
+
+/**
+ * Create a new instance of `CCNxName` from `length` bytes of TLV encoded name segments.
+ *
+ * As ccnxName_CreateFromEncodedSegments(), for a value that is not in a `PARCBuffer`.
+ *
+ * @param [in] length The number of bytes in @p encoded.
+ * @param [in] encoded The encoded segments, copied.
+ * @return non-NULL A pointer to a `CCNxName` instance.
+ * @return NULL A segment runs past the end of the array or has type 0.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t encoded[] = { 0x00, 0x01, 0x00, 0x04, 'p', 'a', 'r', 'c' };
+ *     CCNxName *name = ccnxName_CreateFromEncodedArray(sizeof(encoded), encoded);
+ *
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ *
+ * @see ccnxName_CreateFromEncodedSegments
+ */
+CCNxName *ccnxName_CreateFromEncodedArray(size_t length, const uint8_t encoded[length]);
+
 /**
  * Increase the number of references to a `CCNxName` instance.
  *
@@ -525,6 +576,10 @@ int ccnxName_Compare(const CCNxName *name1, const CCNxName *name2);
  * Return a pointer to the {@link CCNxNameSegment} instance for the specified `CCNxName` at the given index.
  * The index must be greater than or equal to zero and less than {@link ccnxName_GetSegmentCount}().
  *
+ * The name stores its segments in encoded form.  The `CCNxNameSegment` is created the first
+ * time it is asked for and is then kept for the life of the name (or until it is trimmed).
+ * Creating it is safe while other threads read the same name, every caller gets the same instance.
+ *
  * @param [in] name The target `CCNxName`
  * @param [in] index The index into the @p name from which to retrieve the `CCNxNameSegment`.
  *
@@ -563,6 +618,51 @@ CCNxNameSegment *ccnxName_GetSegment(const CCNxName *name, size_t index);
  */
 size_t ccnxName_GetSegmentCount(const CCNxName *name);
 
+/**
+ * Get the TLV encoded segments of the specified `CCNxName`.
+ *
+ * The name segments are held back to back in wire format (2 byte type, 2 byte length, value),
+ * which is the value of a Name TLV.  Label parameters are not part of the encoding.
+ * The memory belongs to the name and is only valid until the name is modified or released.
+ *
+ * @param [in] name A pointer to an instance of `CCNxName`.
+ *
+ * @return A pointer to {@link ccnxName_GetEncodedLength}() bytes, may be NULL if the length is 0.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxName_CreateFromURI("lci:/parc/csl");
+ *     ccnxCodecTlvEncoder_AppendArray(encoder, 0x0000,
+ *                                     ccnxName_GetEncodedLength(name), ccnxName_GetEncodedSegments(name));
+ *
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ *
+ * @see ccnxName_CreateFromEncodedSegments
+ */
+const uint8_t *ccnxName_GetEncodedSegments(const CCNxName *name);
+
+/**
+ * Get the length in bytes of the TLV encoded segments of the specified `CCNxName`.
+ *
+ * @param [in] name A pointer to an instance of `CCNxName`.
+ *
+ * @return The number of bytes at {@link ccnxName_GetEncodedSegments}().
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxName_CreateFromURI("lci:/parc/csl");
+ *     size_t length = ccnxName_GetEncodedLength(name);
+ *
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ */
+size_t ccnxName_GetEncodedLength(const CCNxName *name);
+
 /**
  * Return a hashcode for the given `CCNxName`.
  *
@@ -601,6 +701,10 @@ PARCHashCode ccnxName_HashCode(const CCNxName *name);
  *
  * See @{link ccnxName_HashCode} for more information.
  *
+ * The hash of every prefix is computed once, when the segment is added to the name,
+ * so this is a constant time lookup that does not allocate.
+ * It equals `ccnxName_HashCode()` of the name trimmed to @p count segments.
+ *
  * @param [in] name A pointer to a `CCNxName` instance.
  * @param [in] count The number, starting from the left, of path segments to use to compute the hash.
  *
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#include <ccnx/common/ccnx_NameIndex.h>
+
+// The table never gets more than half full, which keeps probe sequences for misses short.
+// Most longest prefix match probes are misses.
+#define _CCNxNameIndex_InitialCapacity 16
+
+typedef struct ccnx_name_index_entry {
+    PARCHashCode hash;      // ccnxName_HashCode(name)
+    size_t segmentCount;    // ccnxName_GetSegmentCount(name)
+    CCNxName *name;         // NULL for an empty slot
+    void *value;
+} _CCNxNameIndexEntry;
+
+struct ccnx_name_index {
+    _CCNxNameIndexEntry *entries;
+    size_t capacity;        // always a power of 2
+    size_t count;
+
+    // lengthCounts[k] is the number of entries with k segments.
+    // A longest prefix match only probes the lengths in use.
+    size_t *lengthCounts;
+    size_t lengthCapacity;
+};
+
+static void
+_ccnxNameIndex_FinalRelease(CCNxNameIndex **indexP)
+{
+    CCNxNameIndex *index = *indexP;
+
+    for (size_t i = 0; i < index->capacity; i++) {
+        if (index->entries[i].name != NULL) {
+            ccnxName_Release(&index->entries[i].name);
+        }
+    }
+    parcMemory_Deallocate((void **) &index->entries);
+    if (index->lengthCounts != NULL) {
+        parcMemory_Deallocate((void **) &index->lengthCounts);
+    }
+}
+
+parcObject_ExtendPARCObject(CCNxNameIndex, _ccnxNameIndex_FinalRelease, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(ccnxNameIndex, CCNxNameIndex);
+
+parcObject_ImplementRelease(ccnxNameIndex, CCNxNameIndex);
+
+CCNxNameIndex *
+ccnxNameIndex_Create(void)
+{
+    CCNxNameIndex *result = parcObject_CreateAndClearInstance(CCNxNameIndex);
+    if (result != NULL) {
+        result->capacity = _CCNxNameIndex_InitialCapacity;
+        result->entries = parcMemory_AllocateAndClear(result->capacity * sizeof(_CCNxNameIndexEntry));
+        assertNotNull(result->entries, "parcMemory_AllocateAndClear(%zu) returned NULL", result->capacity * sizeof(_CCNxNameIndexEntry));
+    }
+    return result;
+}
+
+size_t
+ccnxNameIndex_Size(const CCNxNameIndex *index)
+{
+    return index->count;
+}
+
+/**
+ * Find the slot holding the first `segmentCount` segments of `name`, whose hash is `hash`.
+ *
+ * @return The slot index, or -1 if there is no such entry.
+ */
+static ssize_t
+_ccnxNameIndex_Find(const CCNxNameIndex *index, const CCNxName *name, size_t segmentCount, PARCHashCode hash)
+{
+    size_t mask = index->capacity - 1;
+    for (size_t slot = hash & mask; index->entries[slot].name != NULL; slot = (slot + 1) & mask) {
+        const _CCNxNameIndexEntry *entry = &index->entries[slot];
+        // The entry has exactly segmentCount segments, so StartsWith means it equals that prefix of name
+        if (entry->hash == hash && entry->segmentCount == segmentCount && ccnxName_StartsWith(name, entry->name)) {
+            return (ssize_t) slot;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Put an entry in the first free slot of its probe sequence.  The entry must not already be in the table.
+ */
+static void
+_ccnxNameIndex_Place(_CCNxNameIndexEntry *entries, size_t capacity, const _CCNxNameIndexEntry *entry)
+{
+    size_t mask = capacity - 1;
+    size_t slot = entry->hash & mask;
+    while (entries[slot].name != NULL) {
+        slot = (slot + 1) & mask;
+    }
+    entries[slot] = *entry;
+}
+
+static void
+_ccnxNameIndex_Grow(CCNxNameIndex *index)
+{
+    size_t capacity = index->capacity * 2;
+    _CCNxNameIndexEntry *entries = parcMemory_AllocateAndClear(capacity * sizeof(_CCNxNameIndexEntry));
+    assertNotNull(entries, "parcMemory_AllocateAndClear(%zu) returned NULL", capacity * sizeof(_CCNxNameIndexEntry));
+
+    for (size_t i = 0; i < index->capacity; i++) {
+        if (index->entries[i].name != NULL) {
+            _ccnxNameIndex_Place(entries, capacity, &index->entries[i]);
+        }
+    }
+
+    parcMemory_Deallocate((void **) &index->entries);
+    index->entries = entries;
+    index->capacity = capacity;
+}
+
+static void
+_ccnxNameIndex_CountLength(CCNxNameIndex *index, size_t segmentCount)
+{
+    if (segmentCount >= index->lengthCapacity) {
+        size_t capacity = (index->lengthCapacity == 0) ? 16 : index->lengthCapacity;
+        while (capacity <= segmentCount) {
+            capacity *= 2;
+        }
+        index->lengthCounts = parcMemory_Reallocate(index->lengthCounts, capacity * sizeof(size_t));
+        assertNotNull(index->lengthCounts, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(size_t));
+        memset(&index->lengthCounts[index->lengthCapacity], 0, (capacity - index->lengthCapacity) * sizeof(size_t));
+        index->lengthCapacity = capacity;
+    }
+    index->lengthCounts[segmentCount]++;
+}
+
+bool
+ccnxNameIndex_Insert(CCNxNameIndex *index, const CCNxName *name, void *value)
+{
+    assertNotNull(index, "Parameter index must be non-null");
+    assertNotNull(name, "Parameter name must be non-null");
+
+    size_t segmentCount = ccnxName_GetSegmentCount(name);
+    PARCHashCode hash = ccnxName_HashCode(name);
+    if (_ccnxNameIndex_Find(index, name, segmentCount, hash) >= 0) {
+        return false;
+    }
+
+    if (2 * (index->count + 1) > index->capacity) {
+        _ccnxNameIndex_Grow(index);
+    }
+
+    _CCNxNameIndexEntry entry = {
+        .hash         = hash,
+        .segmentCount = segmentCount,
+        .name         = ccnxName_Acquire(name),
+        .value        = value
+    };
+    _ccnxNameIndex_Place(index->entries, index->capacity, &entry);
+    _ccnxNameIndex_CountLength(index, segmentCount);
+    index->count++;
+    return true;
+}
+
+bool
+ccnxNameIndex_Remove(CCNxNameIndex *index, const CCNxName *name, void **valuePtr)
+{
+    assertNotNull(index, "Parameter index must be non-null");
+    assertNotNull(name, "Parameter name must be non-null");
+
+    size_t segmentCount = ccnxName_GetSegmentCount(name);
+    ssize_t found = _ccnxNameIndex_Find(index, name, segmentCount, ccnxName_HashCode(name));
+    if (found < 0) {
+        return false;
+    }
+
+    size_t hole = (size_t) found;
+    if (valuePtr != NULL) {
+        *valuePtr = index->entries[hole].value;
+    }
+    ccnxName_Release(&index->entries[hole].name);
+    index->lengthCounts[segmentCount]--;
+    index->count--;
+
+    // Backward shift: move later entries of the probe sequence into the hole, so no tombstones are needed
+    size_t mask = index->capacity - 1;
+    for (size_t slot = (hole + 1) & mask; index->entries[slot].name != NULL; slot = (slot + 1) & mask) {
+        size_t home = index->entries[slot].hash & mask;
+        // The entry may move to the hole only if the hole lies between its home slot and its current slot
+        bool movable = (hole <= slot) ? (home <= hole || home > slot) : (home <= hole && home > slot);
+        if (movable) {
+            index->entries[hole] = index->entries[slot];
+            hole = slot;
+        }
+    }
+    memset(&index->entries[hole], 0, sizeof(_CCNxNameIndexEntry));
+
+    return true;
+}
+
+bool
+ccnxNameIndex_Get(const CCNxNameIndex *index, const CCNxName *name, void **valuePtr)
+{
+    assertNotNull(index, "Parameter index must be non-null");
+    assertNotNull(name, "Parameter name must be non-null");
+
+    ssize_t found = _ccnxNameIndex_Find(index, name, ccnxName_GetSegmentCount(name), ccnxName_HashCode(name));
+    if (found >= 0 && valuePtr != NULL) {
+        *valuePtr = index->entries[found].value;
+    }
+    return (found >= 0);
+}
+
+/**
+ * The longest prefix length worth probing for `name`.
+ */
+static size_t
+_ccnxNameIndex_LongestLength(const CCNxNameIndex *index, const CCNxName *name)
+{
+    size_t longest = ccnxName_GetSegmentCount(name);
+    if (longest >= index->lengthCapacity) {
+        longest = (index->lengthCapacity == 0) ? 0 : index->lengthCapacity - 1;
+    }
+    return longest;
+}
+
+const CCNxName *
+ccnxNameIndex_LongestPrefixMatch(const CCNxNameIndex *index, const CCNxName *name, void **valuePtr)
+{
+    assertNotNull(index, "Parameter index must be non-null");
+    assertNotNull(name, "Parameter name must be non-null");
+
+    if (index->count > 0) {
+        for (size_t length = _ccnxNameIndex_LongestLength(index, name) + 1; length-- > 0; ) {
+            if (index->lengthCounts[length] > 0) {
+                ssize_t found = _ccnxNameIndex_Find(index, name, length, ccnxName_LeftMostHashCode(name, length));
+                if (found >= 0) {
+                    if (valuePtr != NULL) {
+                        *valuePtr = index->entries[found].value;
+                    }
+                    return index->entries[found].name;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+size_t
+ccnxNameIndex_ForEachPrefix(const CCNxNameIndex *index, const CCNxName *name, CCNxNameIndexCallback *callback, void *context)
+{
+    assertNotNull(index, "Parameter index must be non-null");
+    assertNotNull(name, "Parameter name must be non-null");
+    assertNotNull(callback, "Parameter callback must be non-null");
+
+    size_t visited = 0;
+    if (index->count > 0) {
+        for (size_t length = _ccnxNameIndex_LongestLength(index, name) + 1; length-- > 0; ) {
+            if (index->lengthCounts[length] > 0) {
+                ssize_t found = _ccnxNameIndex_Find(index, name, length, ccnxName_LeftMostHashCode(name, length));
+                if (found >= 0) {
+                    visited++;
+                    if (!callback(index->entries[found].name, index->entries[found].value, context)) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return visited;
+}
+
+size_t
+ccnxNameIndex_ForEachUnder(const CCNxNameIndex *index, const CCNxName *prefix, CCNxNameIndexCallback *callback, void *context)
+{
+    assertNotNull(index, "Parameter index must be non-null");
+    assertNotNull(prefix, "Parameter prefix must be non-null");
+    assertNotNull(callback, "Parameter callback must be non-null");
+
+    size_t visited = 0;
+    for (size_t i = 0; i < index->capacity; i++) {
+        const _CCNxNameIndexEntry *entry = &index->entries[i];
+        if (entry->name != NULL && ccnxName_StartsWith(entry->name, prefix)) {
+            visited++;
+            if (!callback(entry->name, entry->value, context)) {
+                break;
+            }
+        }
+    }
+    return visited;
+}
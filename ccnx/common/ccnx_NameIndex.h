@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file ccnx_NameIndex.h
+ * @ingroup Naming
+ * @brief An index of `CCNxName` prefixes with exact and longest prefix match lookup.
+ *
+ * The index is a table of name prefixes, each mapped to a caller supplied value.
+ * It is an open addressing hash table keyed on the prefix hash codes cached in every
+ * `CCNxName` (see {@link ccnxName_LeftMostHashCode}).  A longest prefix match probes the table
+ * once for each prefix length that has at least one entry, longest first, and confirms a
+ * candidate with one memcmp over the encoded name.  Lookups do not allocate memory.
+ *
+ * The index holds a reference to every name inserted.  A name must not be modified while it is in an index.
+ * Values are not owned by the index, they are neither acquired nor released.
+ *
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+#ifndef libccnx_ccnx_NameIndex_h
+#define libccnx_ccnx_NameIndex_h
+
+#include <stdbool.h>
+
+#include <ccnx/common/ccnx_Name.h>
+
+struct ccnx_name_index;
+/**
+ * @typedef CCNxNameIndex
+ * @brief A table of name prefixes supporting exact and longest prefix match.
+ */
+typedef struct ccnx_name_index CCNxNameIndex;
+
+/**
+ * The function called for each entry visited by {@link ccnxNameIndex_ForEachPrefix} and {@link ccnxNameIndex_ForEachUnder}.
+ *
+ * @param [in] name The name of the entry.
+ * @param [in] value The value of the entry.
+ * @param [in] context The context given to the iterating function.
+ *
+ * @return true To continue the iteration.
+ * @return false To stop the iteration.
+ */
+typedef bool (CCNxNameIndexCallback)(const CCNxName *name, void *value, void *context);
+
+/**
+ * Create an empty `CCNxNameIndex`.
+ *
+ * @return non-NULL A pointer to a `CCNxNameIndex` instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameIndex *index = ccnxNameIndex_Create();
+ *
+ *     ccnxNameIndex_Release(&index);
+ * }
+ * @endcode
+ */
+CCNxNameIndex *ccnxNameIndex_Create(void);
+
+/**
+ * Increase the number of references to a `CCNxNameIndex`.
+ *
+ * Note that a new `CCNxNameIndex` is not created,
+ * only that the given `CCNxNameIndex` reference count is incremented.
+ * Discard the reference by invoking {@link ccnxNameIndex_Release}.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ * @return The value of the input parameter @p index.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameIndex *index = ccnxNameIndex_Create();
+ *     CCNxNameIndex *reference = ccnxNameIndex_Acquire(index);
+ *
+ *     ccnxNameIndex_Release(&index);
+ *     ccnxNameIndex_Release(&reference);
+ * }
+ * @endcode
+ */
+CCNxNameIndex *ccnxNameIndex_Acquire(const CCNxNameIndex *index);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the names in the index are released.  The values are not touched.
+ *
+ * @param [in,out] indexP A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameIndex *index = ccnxNameIndex_Create();
+ *
+ *     ccnxNameIndex_Release(&index);
+ * }
+ * @endcode
+ */
+void ccnxNameIndex_Release(CCNxNameIndex **indexP);
+
+/**
+ * The number of entries in the index.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ *
+ * @return The number of entries.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameIndex *index = ccnxNameIndex_Create();
+ *     size_t size = ccnxNameIndex_Size(index);
+ *
+ *     ccnxNameIndex_Release(&index);
+ * }
+ * @endcode
+ */
+size_t ccnxNameIndex_Size(const CCNxNameIndex *index);
+
+/**
+ * Add @p name to the index with the given value.
+ *
+ * The index acquires a reference to @p name.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ * @param [in] name The name to add.
+ * @param [in] value The value to associate with @p name, may be NULL.
+ *
+ * @return true The name was added.
+ * @return false The name is already in the index, the index is not changed.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameIndex *index = ccnxNameIndex_Create();
+ *     CCNxName *prefix = ccnxName_CreateFromURI("lci:/parc/csl");
+ *
+ *     ccnxNameIndex_Insert(index, prefix, faceList);
+ *
+ *     ccnxName_Release(&prefix);
+ *     ccnxNameIndex_Release(&index);
+ * }
+ * @endcode
+ */
+bool ccnxNameIndex_Insert(CCNxNameIndex *index, const CCNxName *name, void *value);
+
+/**
+ * Remove @p name from the index.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ * @param [in] name The name to remove.
+ * @param [out] valuePtr If not NULL, receives the value the name was associated with.
+ *
+ * @return true The name was removed.
+ * @return false The name was not in the index.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *value;
+ *     if (ccnxNameIndex_Remove(index, prefix, &value)) {
+ *         faceList_Release(&value);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxNameIndex_Remove(CCNxNameIndex *index, const CCNxName *name, void **valuePtr);
+
+/**
+ * Find the entry that exactly matches @p name.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ * @param [in] name The name to look up.
+ * @param [out] valuePtr If not NULL, receives the value of the entry.
+ *
+ * @return true There is an entry for @p name.
+ * @return false There is no entry for @p name.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *value;
+ *     bool found = ccnxNameIndex_Get(index, prefix, &value);
+ * }
+ * @endcode
+ */
+bool ccnxNameIndex_Get(const CCNxNameIndex *index, const CCNxName *name, void **valuePtr);
+
+/**
+ * Find the entry with the longest name that is a prefix of @p name.
+ *
+ * An entry for a name equal to @p name is its longest prefix.
+ * An entry for the name with no segments matches every name.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ * @param [in] name The name to look up.
+ * @param [out] valuePtr If not NULL, receives the value of the matching entry.
+ *
+ * @return non-NULL The name of the matching entry, owned by the index.
+ * @return NULL No entry is a prefix of @p name.
+ *
+ * Example:
+ * @code
+ * {
+ *     void *faceList;
+ *     const CCNxName *match = ccnxNameIndex_LongestPrefixMatch(fib, ccnxInterest_GetName(interest), &faceList);
+ *     if (match != NULL) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+const CCNxName *ccnxNameIndex_LongestPrefixMatch(const CCNxNameIndex *index, const CCNxName *name, void **valuePtr);
+
+/**
+ * Call @p callback for every entry that is a prefix of @p name, longest first.
+ *
+ * The index must not be modified during the iteration.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ * @param [in] name The name whose prefixes to visit.
+ * @param [in] callback The function to call for each entry.
+ * @param [in] context Passed to @p callback.
+ *
+ * @return The number of entries visited.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxNameIndex_ForEachPrefix(index, name, _addFaces, faceSet);
+ * }
+ * @endcode
+ */
+size_t ccnxNameIndex_ForEachPrefix(const CCNxNameIndex *index, const CCNxName *name, CCNxNameIndexCallback *callback, void *context);
+
+/**
+ * Call @p callback for every entry whose name starts with @p prefix, in no particular order.
+ *
+ * This visits every entry in the index, so it is linear in the size of the index.
+ * The index must not be modified during the iteration.
+ *
+ * @param [in] index A pointer to a `CCNxNameIndex` instance.
+ * @param [in] prefix The prefix to visit the entries under.
+ * @param [in] callback The function to call for each entry.
+ * @param [in] context Passed to @p callback.
+ *
+ * @return The number of entries visited.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxNameIndex_ForEachUnder(index, prefix, _unregister, producer);
+ * }
+ * @endcode
+ */
+size_t ccnxNameIndex_ForEachUnder(const CCNxNameIndex *index, const CCNxName *prefix, CCNxNameIndexCallback *callback, void *context);
+#endif // libccnx_ccnx_NameIndex_h
@@ -45,6 +45,9 @@
 #include <ccnx/common/ccnx_NameSegment.h>
 
 struct ccnx_name_segment {
+    // NULL for a segment created from just a type (e.g. by the decoder), which
+    // saves allocating a label object per segment.  The label only matters when
+    // it carries a parameter; otherwise `type` is all we need.
     const CCNxNameLabel *label;
     CCNxNameLabelType type;
     PARCBuffer *value;
@@ -56,7 +59,9 @@ _ccnxNameSegment_destroy(CCNxNameSegment **segmentP)
     assertNotNull(segmentP, "Parameter must be a non-null pointer to a CCNxNameSegment pointer.");
 
     CCNxNameSegment *segment = *segmentP;
-    ccnxNameLabel_Release((CCNxNameLabel **) &(segment->label));
+    if (segment->label != NULL) {
+        ccnxNameLabel_Release((CCNxNameLabel **) &(segment->label));
+    }
     parcBuffer_Release(&segment->value);
 }
 
@@ -83,11 +88,15 @@ CCNxNameSegment *
 ccnxNameSegment_CreateTypeValue(CCNxNameLabelType type, const PARCBuffer *value)
 {
     CCNxNameSegment *result = NULL;
-    CCNxNameLabel *label = ccnxNameLabel_Create(type, NULL);
 
-    if (label != NULL) {
-        result = ccnxNameSegment_CreateLabelValue(label, value);
-        ccnxNameLabel_Release(&label);
+    // Same validity rule as ccnxNameLabel_Create(), without creating the label
+    if (type != CCNxNameLabelType_BADNAME && type != CCNxNameLabelType_Unknown) {
+        result = parcObject_CreateInstance(CCNxNameSegment);
+        if (result != NULL) {
+            result->label = NULL;
+            result->type = type;
+            result->value = parcBuffer_Acquire(value);
+        }
     }
     return result;
 }
@@ -136,10 +145,14 @@ ccnxNameSegment_Copy(const CCNxNameSegment *segment)
 {
     PARCBuffer *value = parcBuffer_Copy(segment->value);
 
-    CCNxNameLabel *label = ccnxNameLabel_Copy(segment->label);
-
-    CCNxNameSegment *result = ccnxNameSegment_CreateLabelValue(label, value);
-    ccnxNameLabel_Release(&label);
+    CCNxNameSegment *result;
+    if (segment->label == NULL) {
+        result = ccnxNameSegment_CreateTypeValue(segment->type, value);
+    } else {
+        CCNxNameLabel *label = ccnxNameLabel_Copy(segment->label);
+        result = ccnxNameSegment_CreateLabelValue(label, value);
+        ccnxNameLabel_Release(&label);
+    }
 
     parcBuffer_Release(&value);
     return result;
@@ -155,9 +168,14 @@ ccnxNameSegment_Equals(const CCNxNameSegment *segmentA, const CCNxNameSegment *s
     } else if (segmentA == NULL || segmentB == NULL) {
         result = false;
     } else {
-        if (ccnxNameLabel_Equals(segmentA->label, segmentB->label)) {
-            if (parcBuffer_Equals(ccnxNameSegment_GetValue(segmentA), ccnxNameSegment_GetValue(segmentB))) {
-                result = true;
+        // Equivalent to ccnxNameLabel_Equals(), but works when either label was never created
+        if (segmentA->type == segmentB->type) {
+            PARCBuffer *parameterA = ccnxNameSegment_GetParameter(segmentA);
+            PARCBuffer *parameterB = ccnxNameSegment_GetParameter(segmentB);
+            if (parcBuffer_Equals(parameterA, parameterB)) {
+                if (parcBuffer_Equals(ccnxNameSegment_GetValue(segmentA), ccnxNameSegment_GetValue(segmentB))) {
+                    result = true;
+                }
             }
         }
     }
@@ -193,7 +211,7 @@ ccnxNameSegment_Compare(const CCNxNameSegment *segmentA, const CCNxNameSegment *
 CCNxNameLabelType
 ccnxNameSegment_GetType(const CCNxNameSegment *segment)
 {
-    return ccnxNameLabel_GetType(segment->label);
+    return segment->type;
 }
 
 size_t
@@ -208,10 +226,22 @@ ccnxNameSegment_GetValue(const CCNxNameSegment *segment)
     return segment->value;
 }
 
+PARCBuffer *
+ccnxNameSegment_GetParameter(const CCNxNameSegment *segment)
+{
+    return (segment->label == NULL) ? NULL : ccnxNameLabel_GetParameter(segment->label);
+}
+
 PARCBufferComposer *
 ccnxNameSegment_BuildString(const CCNxNameSegment *segment, PARCBufferComposer *composer)
 {
-    ccnxNameLabel_BuildString(segment->label, composer);
+    if (segment->label != NULL) {
+        ccnxNameLabel_BuildString(segment->label, composer);
+    } else {
+        CCNxNameLabel *label = ccnxNameLabel_Create(segment->type, NULL);
+        ccnxNameLabel_BuildString(label, composer);
+        ccnxNameLabel_Release(&label);
+    }
 
     if (ccnxNameSegment_Length(segment) > 0) {
         PARCURISegment *uriSegment = parcURISegment_CreateFromBuffer(ccnxNameSegment_GetValue(segment));
@@ -226,17 +256,18 @@ ccnxNameSegment_BuildString(const CCNxNameSegment *segment, PARCBufferComposer *
 PARCHashCode
 ccnxNameSegment_HashCode(const CCNxNameSegment *segment)
 {
-    PARCHash32Bits *hash = parcHash32Bits_Create();
-
-    parcHash32Bits_Update(hash, &segment->type, sizeof(segment->type));
-    if (parcBuffer_Remaining(segment->value) > 0) {
-        parcHash32Bits_UpdateUint32(hash, parcBuffer_HashCode(segment->value));
+    // Hash the segment as if TLV encoded, which is what a CCNxName hashes, without allocating a hasher
+    size_t length = parcBuffer_Remaining(segment->value);
+    uint8_t header[4] = {
+        (uint8_t) (segment->type >> 8), (uint8_t) segment->type,
+        (uint8_t) (length >> 8),        (uint8_t) length
+    };
+
+    PARCHashCode result = parcHashCode_Hash(header, sizeof(header));
+    if (length > 0) {
+        result = parcHashCode_HashImpl(parcBuffer_Overlay(segment->value, 0), length, result);
     }
 
-    uint32_t result = parcHash32Bits_Hash(hash);
-
-    parcHash32Bits_Release(&hash);
-
     return result;
 }
 
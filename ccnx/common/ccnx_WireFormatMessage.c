@@ -310,6 +310,13 @@ ccnxWireFormatMessage_Release(CCNxWireFormatMessage **message)
     ccnxTlvDictionary_Release(message);
 }
 
+CCNxWireFormatMessage *
+ccnxWireFormatMessage_Clone(CCNxWireFormatMessage *message)
+{
+    ccnxWireFormatMessage_OptionalAssertValid(message);
+    return ccnxTlvDictionary_Clone(message);
+}
+
 void
 ccnxWireFormatMessage_SetHopLimit(CCNxWireFormatMessage *message, uint32_t hoplimit)
 {
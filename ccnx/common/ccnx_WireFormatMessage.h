@@ -398,9 +398,39 @@ CCNxWireFormatMessage *ccnxWireFormatMessage_Acquire(const CCNxWireFormatMessage
  */
 void ccnxWireFormatMessage_Release(CCNxWireFormatMessage **messageP);
 
+/**
+ * Create a clone of a message that shares its wire format until one of them changes a header.
+ *
+ * Creating the clone does not copy the packet.  Changing a header of the message or of a clone,
+ * for example with {@link ccnxWireFormatMessage_SetHopLimit}, first gives that message a private
+ * copy of the fixed and optional headers.  The rest of the packet stays shared.  A message whose
+ * headers were copied holds its wire format as an io vector, see {@link ccnxWireFormatMessage_GetIoVec}.
+ *
+ * @param [in] message The message to clone
+ *
+ * @return A new message, release it with {@link ccnxWireFormatMessage_Release}
+ *
+ * Example:
+ * @code
+ * {
+ *     for (int i = 0; i < faceCount; i++) {
+ *         CCNxWireFormatMessage *clone = ccnxWireFormatMessage_Clone(message);
+ *         ccnxWireFormatMessage_SetHopLimit(clone, hopLimit - 1);
+ *         CCNxCodecNetworkBufferIoVec *vec = ccnxWireFormatMessage_GetIoVec(clone);
+ *         writev(faces[i], ccnxCodecNetworkBufferIoVec_GetArray(vec), ccnxCodecNetworkBufferIoVec_GetCount(vec));
+ *         ccnxWireFormatMessage_Release(&clone);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxWireFormatMessage *ccnxWireFormatMessage_Clone(CCNxWireFormatMessage *message);
+
 /**
  * Write a hoplimit to a messages attached wire format io vectors or buffers
  *
+ * If the message shares its wire format with a clone (see {@link ccnxWireFormatMessage_Clone}),
+ * the message is first given a private copy of the headers, so the clones are not changed.
+ *
  * @param [in] message
  * @param [in] hoplimit
  *
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <LongBow/runtime.h>
+
+#include <ccnx/common/codec/ccnxCodec_MemoryBlockPool.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+// Blocks handed out start on this boundary
+#define _CCNxCodecMemoryBlockPool_Alignment 64
+
+#define _CCNxCodecMemoryBlockPool_HugePageSize (2 * 1024 * 1024)
+
+typedef struct ccnx_codec_memory_block_pool_block _CCNxCodecMemoryBlockPoolBlock;
+typedef struct ccnx_codec_memory_block_pool_thread _CCNxCodecMemoryBlockPoolThread;
+
+/*
+ * Sits immediately before the memory given to the caller.  `owner` is the thread whose free
+ * list the block goes back to and whose statistics count it.  An oversized block came from
+ * parcMemory and goes back there.
+ */
+struct ccnx_codec_memory_block_pool_block {
+    _CCNxCodecMemoryBlockPoolBlock *next;
+    _CCNxCodecMemoryBlockPoolThread *owner;
+    bool oversized;
+};
+
+// Sits at the start of each mapped slab, before the first block header
+typedef struct ccnx_codec_memory_block_pool_slab {
+    struct ccnx_codec_memory_block_pool_slab *next;
+    size_t length;
+} _CCNxCodecMemoryBlockPoolSlab;
+
+#define _CCNxCodecMemoryBlockPool_FirstBlockOffset (_CCNxCodecMemoryBlockPool_Alignment - sizeof(_CCNxCodecMemoryBlockPoolBlock))
+
+// Ends a thread's returned list once the thread has exited, so later releases go to the orphans
+#define _CCNxCodecMemoryBlockPool_Closed ((_CCNxCodecMemoryBlockPoolBlock *) 1)
+
+struct ccnx_codec_memory_block_pool_thread {
+    // Links every thread's state in the pool so the final release can free them
+    _CCNxCodecMemoryBlockPoolThread *next;
+    CCNxCodecMemoryBlockPool *pool;
+
+    _CCNxCodecMemoryBlockPoolBlock *freeList;
+
+    // Blocks this thread allocated that other threads released.  Other threads push with atomic
+    // operations and this thread takes the whole list when its free list runs dry.
+    _CCNxCodecMemoryBlockPoolBlock *returned;
+
+    // The part of this thread's newest slab not yet handed out
+    uint8_t *carve;
+    size_t carveRemaining;
+
+    // Blocks this thread allocated, and of those the ones it released itself and the ones other
+    // threads released (changed with atomic operations).  statistics.outstanding is derived from them.
+    uint64_t allocated;
+    uint64_t released;
+    uint64_t remoteReleased;
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+};
+
+struct ccnx_codec_memory_block_pool {
+    size_t blockSize;
+    size_t stride;              /**< blockSize plus header, rounded up to the alignment */
+    size_t blocksPerSlab;
+    size_t slabLength;
+    bool useHugePages;
+
+    pthread_key_t threadKey;
+
+    // These are shared by all threads and only changed with atomic operations
+    _CCNxCodecMemoryBlockPoolSlab *slabs;
+    _CCNxCodecMemoryBlockPoolThread *threads;
+    _CCNxCodecMemoryBlockPoolBlock *orphans;
+    size_t slabCount;
+};
+
+// ================================================================================
+
+static void
+_ccnxCodecMemoryBlockPool_PushOrphans(CCNxCodecMemoryBlockPool *pool, _CCNxCodecMemoryBlockPoolBlock *first, _CCNxCodecMemoryBlockPoolBlock *last)
+{
+    _CCNxCodecMemoryBlockPoolBlock *head = __atomic_load_n(&pool->orphans, __ATOMIC_RELAXED);
+    do {
+        last->next = head;
+    } while (!__atomic_compare_exchange_n(&pool->orphans, &head, first, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/**
+ * Give a block released on another thread back to its owner, or to the orphans if the owner has exited.
+ */
+static void
+_ccnxCodecMemoryBlockPool_ReturnBlock(_CCNxCodecMemoryBlockPoolBlock *block)
+{
+    _CCNxCodecMemoryBlockPoolThread *owner = block->owner;
+    _CCNxCodecMemoryBlockPoolBlock *head = __atomic_load_n(&owner->returned, __ATOMIC_RELAXED);
+    do {
+        if (head == _CCNxCodecMemoryBlockPool_Closed) {
+            block->next = NULL;
+            _ccnxCodecMemoryBlockPool_PushOrphans(owner->pool, block, block);
+            return;
+        }
+        block->next = head;
+    } while (!__atomic_compare_exchange_n(&owner->returned, &head, block, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static int64_t
+_ccnxCodecMemoryBlockPool_Outstanding(_CCNxCodecMemoryBlockPoolThread *thread)
+{
+    return (int64_t) (thread->allocated - thread->released - __atomic_load_n(&thread->remoteReleased, __ATOMIC_RELAXED));
+}
+
+static _CCNxCodecMemoryBlockPoolBlock *
+_ccnxCodecMemoryBlockPool_CarveBlock(_CCNxCodecMemoryBlockPoolThread *thread)
+{
+    _CCNxCodecMemoryBlockPoolBlock *block = (_CCNxCodecMemoryBlockPoolBlock *) thread->carve;
+    block->owner = thread;
+    block->next = NULL;
+    block->oversized = false;
+    thread->carve += thread->pool->stride;
+    thread->carveRemaining--;
+    return block;
+}
+
+/**
+ * Called by pthreads when a thread that used the pool exits.
+ *
+ * The thread state stays on the pool's list until the final release, but its free blocks, the
+ * blocks other threads returned to it and the uncarved part of its slab go to the orphan list
+ * for other threads.  Closing the returned list sends blocks released later to the orphans too.
+ */
+static void
+_ccnxCodecMemoryBlockPool_ThreadExit(void *context)
+{
+    _CCNxCodecMemoryBlockPoolThread *thread = context;
+
+    _CCNxCodecMemoryBlockPoolBlock *returned = __atomic_exchange_n(&thread->returned, _CCNxCodecMemoryBlockPool_Closed, __ATOMIC_ACQUIRE);
+    while (returned != NULL) {
+        _CCNxCodecMemoryBlockPoolBlock *block = returned;
+        returned = block->next;
+        block->next = thread->freeList;
+        thread->freeList = block;
+    }
+
+    while (thread->carveRemaining > 0) {
+        _CCNxCodecMemoryBlockPoolBlock *block = _ccnxCodecMemoryBlockPool_CarveBlock(thread);
+        block->next = thread->freeList;
+        thread->freeList = block;
+    }
+
+    if (thread->freeList != NULL) {
+        _CCNxCodecMemoryBlockPoolBlock *last = thread->freeList;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        _ccnxCodecMemoryBlockPool_PushOrphans(thread->pool, thread->freeList, last);
+        thread->freeList = NULL;
+    }
+}
+
+static _CCNxCodecMemoryBlockPoolThread *
+_ccnxCodecMemoryBlockPool_GetThread(CCNxCodecMemoryBlockPool *pool)
+{
+    _CCNxCodecMemoryBlockPoolThread *thread = pthread_getspecific(pool->threadKey);
+    if (thread == NULL) {
+        thread = parcMemory_AllocateAndClear(sizeof(_CCNxCodecMemoryBlockPoolThread));
+        assertNotNull(thread, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxCodecMemoryBlockPoolThread));
+        thread->pool = pool;
+
+        thread->next = __atomic_load_n(&pool->threads, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&pool->threads, &thread->next, thread, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            // thread->next was updated with the current head, try again
+        }
+
+        pthread_setspecific(pool->threadKey, thread);
+    }
+    return thread;
+}
+
+static uint8_t *
+_ccnxCodecMemoryBlockPool_MapSlab(CCNxCodecMemoryBlockPool *pool)
+{
+    void *memory = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if (pool->useHugePages) {
+        memory = mmap(NULL, pool->slabLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+
+    if (memory == MAP_FAILED) {
+        memory = mmap(NULL, pool->slabLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if (memory == MAP_FAILED) {
+        trapOutOfMemory("Could not map a slab of %zu bytes", pool->slabLength);
+    }
+
+    _CCNxCodecMemoryBlockPoolSlab *slab = memory;
+    slab->length = pool->slabLength;
+    slab->next = __atomic_load_n(&pool->slabs, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&pool->slabs, &slab->next, slab, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        // slab->next was updated with the current head, try again
+    }
+    __atomic_add_fetch(&pool->slabCount, 1, __ATOMIC_RELAXED);
+
+    return (uint8_t *) memory + _CCNxCodecMemoryBlockPool_FirstBlockOffset;
+}
+
+/**
+ * The thread's free list is empty.  Take back every block other threads returned, or else every
+ * orphaned block, or else carve from a slab.
+ */
+static _CCNxCodecMemoryBlockPoolBlock *
+_ccnxCodecMemoryBlockPool_Refill(_CCNxCodecMemoryBlockPoolThread *thread)
+{
+    CCNxCodecMemoryBlockPool *pool = thread->pool;
+
+    _CCNxCodecMemoryBlockPoolBlock *returned = __atomic_exchange_n(&thread->returned, NULL, __ATOMIC_ACQUIRE);
+    if (returned != NULL) {
+        thread->freeList = returned->next;
+        return returned;
+    }
+
+    if (thread->carveRemaining == 0) {
+        _CCNxCodecMemoryBlockPoolBlock *orphans = __atomic_exchange_n(&pool->orphans, NULL, __ATOMIC_ACQUIRE);
+        if (orphans != NULL) {
+            // Adopt them, so releasing them on this thread puts them back on this thread's free list
+            for (_CCNxCodecMemoryBlockPoolBlock *block = orphans; block != NULL; block = block->next) {
+                block->owner = thread;
+            }
+            thread->freeList = orphans->next;
+            return orphans;
+        }
+
+        thread->carve = _ccnxCodecMemoryBlockPool_MapSlab(pool);
+        thread->carveRemaining = pool->blocksPerSlab;
+    }
+
+    return _ccnxCodecMemoryBlockPool_CarveBlock(thread);
+}
+
+static size_t
+_ccnxCodecMemoryBlockPool_Allocate(void *userarg, size_t bytes, void **output)
+{
+    CCNxCodecMemoryBlockPool *pool = userarg;
+    _CCNxCodecMemoryBlockPoolThread *thread = _ccnxCodecMemoryBlockPool_GetThread(pool);
+
+    _CCNxCodecMemoryBlockPoolBlock *block;
+    size_t granted;
+
+    if (bytes > pool->blockSize) {
+        block = parcMemory_Allocate(sizeof(_CCNxCodecMemoryBlockPoolBlock) + bytes);
+        if (block == NULL) {
+            *output = NULL;
+            return 0;
+        }
+        block->owner = thread;
+        block->oversized = true;
+        granted = bytes;
+        thread->statistics.misses++;
+    } else if (thread->freeList != NULL) {
+        block = thread->freeList;
+        thread->freeList = block->next;
+        granted = pool->blockSize;
+        thread->statistics.hits++;
+    } else {
+        block = _ccnxCodecMemoryBlockPool_Refill(thread);
+        granted = pool->blockSize;
+        thread->statistics.misses++;
+    }
+
+    thread->allocated++;
+    thread->statistics.outstanding = _ccnxCodecMemoryBlockPool_Outstanding(thread);
+    if (thread->statistics.outstanding > thread->statistics.highWater) {
+        thread->statistics.highWater = thread->statistics.outstanding;
+    }
+
+    *output = (uint8_t *) block + sizeof(_CCNxCodecMemoryBlockPoolBlock);
+    return granted;
+}
+
+static void
+_ccnxCodecMemoryBlockPool_Deallocate(void *userarg, void **memoryPtr)
+{
+    CCNxCodecMemoryBlockPool *pool = userarg;
+    _CCNxCodecMemoryBlockPoolThread *thread = _ccnxCodecMemoryBlockPool_GetThread(pool);
+
+    _CCNxCodecMemoryBlockPoolBlock *block =
+        (_CCNxCodecMemoryBlockPoolBlock *) ((uint8_t *) *memoryPtr - sizeof(_CCNxCodecMemoryBlockPoolBlock));
+
+    // The block counts against the thread that allocated it, wherever it is released
+    _CCNxCodecMemoryBlockPoolThread *owner = block->owner;
+    assertTrue(owner->pool == pool, "Block %p belongs to pool %p, not %p", *memoryPtr, (void *) owner->pool, (void *) pool);
+    if (owner == thread) {
+        thread->released++;
+    } else {
+        __atomic_add_fetch(&owner->remoteReleased, 1, __ATOMIC_RELAXED);
+    }
+
+    if (block->oversized) {
+        parcMemory_Deallocate((void **) &block);
+    } else if (owner == thread) {
+        block->next = thread->freeList;
+        thread->freeList = block;
+    } else {
+        _ccnxCodecMemoryBlockPool_ReturnBlock(block);
+    }
+
+    *memoryPtr = NULL;
+}
+
+const CCNxCodecNetworkBufferMemoryBlockFunctions PooledMemoryBlock = {
+    .allocator   = &_ccnxCodecMemoryBlockPool_Allocate,
+    .deallocator = &_ccnxCodecMemoryBlockPool_Deallocate
+};
+
+// ================================================================================
+
+static void
+_ccnxCodecMemoryBlockPool_FinalRelease(CCNxCodecMemoryBlockPool **poolPtr)
+{
+    CCNxCodecMemoryBlockPool *pool = *poolPtr;
+
+    // Deleting the key does not call the exit destructor, which is what we want as the
+    // slabs are about to go away.
+    pthread_setspecific(pool->threadKey, NULL);
+    pthread_key_delete(pool->threadKey);
+
+    while (pool->threads != NULL) {
+        _CCNxCodecMemoryBlockPoolThread *thread = pool->threads;
+        pool->threads = thread->next;
+        parcMemory_Deallocate((void **) &thread);
+    }
+
+    while (pool->slabs != NULL) {
+        _CCNxCodecMemoryBlockPoolSlab *slab = pool->slabs;
+        pool->slabs = slab->next;
+        munmap(slab, slab->length);
+    }
+}
+
+parcObject_ExtendPARCObject(CCNxCodecMemoryBlockPool, _ccnxCodecMemoryBlockPool_FinalRelease, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(ccnxCodecMemoryBlockPool, CCNxCodecMemoryBlockPool);
+
+parcObject_ImplementRelease(ccnxCodecMemoryBlockPool, CCNxCodecMemoryBlockPool);
+
+CCNxCodecMemoryBlockPool *
+ccnxCodecMemoryBlockPool_Create(size_t blockSize, size_t blocksPerSlab, bool useHugePages)
+{
+    assertTrue(blockSize > 0, "Parameter blockSize must be positive");
+    assertTrue(blocksPerSlab > 0, "Parameter blocksPerSlab must be positive");
+    trapIllegalValueIf(sizeof(_CCNxCodecMemoryBlockPoolSlab) > _CCNxCodecMemoryBlockPool_FirstBlockOffset,
+                       "Slab header does not fit before the first block");
+
+    CCNxCodecMemoryBlockPool *pool = parcObject_CreateInstance(CCNxCodecMemoryBlockPool);
+    assertNotNull(pool, "parcObject_CreateInstance returned NULL");
+
+    size_t alignment = _CCNxCodecMemoryBlockPool_Alignment;
+    pool->blockSize = blockSize;
+    pool->stride = (sizeof(_CCNxCodecMemoryBlockPoolBlock) + blockSize + alignment - 1) / alignment * alignment;
+    pool->useHugePages = useHugePages;
+
+    pool->slabLength = _CCNxCodecMemoryBlockPool_FirstBlockOffset + pool->stride * blocksPerSlab;
+    if (useHugePages) {
+        size_t hugePage = _CCNxCodecMemoryBlockPool_HugePageSize;
+        pool->slabLength = (pool->slabLength + hugePage - 1) / hugePage * hugePage;
+    }
+    pool->blocksPerSlab = (pool->slabLength - _CCNxCodecMemoryBlockPool_FirstBlockOffset) / pool->stride;
+
+    pool->slabs = NULL;
+    pool->threads = NULL;
+    pool->orphans = NULL;
+    pool->slabCount = 0;
+
+    int failure = pthread_key_create(&pool->threadKey, _ccnxCodecMemoryBlockPool_ThreadExit);
+    assertFalse(failure, "pthread_key_create failed: %d", failure);
+
+    return pool;
+}
+
+size_t
+ccnxCodecMemoryBlockPool_GetBlockSize(const CCNxCodecMemoryBlockPool *pool)
+{
+    assertNotNull(pool, "Parameter pool must be non-null");
+    return pool->blockSize;
+}
+
+void
+ccnxCodecMemoryBlockPool_GetStatistics(CCNxCodecMemoryBlockPool *pool, CCNxCodecMemoryBlockPoolStatistics *statistics)
+{
+    assertNotNull(pool, "Parameter pool must be non-null");
+    assertNotNull(statistics, "Parameter statistics must be non-null");
+
+    _CCNxCodecMemoryBlockPoolThread *thread = _ccnxCodecMemoryBlockPool_GetThread(pool);
+    *statistics = thread->statistics;
+    statistics->outstanding = _ccnxCodecMemoryBlockPool_Outstanding(thread);
+    statistics->slabs = __atomic_load_n(&pool->slabCount, __ATOMIC_RELAXED);
+}
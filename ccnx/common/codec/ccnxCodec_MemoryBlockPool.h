@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file ccnxCodec_MemoryBlockPool
+ * @brief A per-thread slab pool of fixed-size memory blocks for CCNxCodecNetworkBuffer
+ *
+ * ParcMemoryMemoryBlock calls parcMemory_Allocate() every time a network buffer adds a block.
+ * A memory block pool carves fixed-size blocks out of large slabs and keeps released blocks on
+ * a free list owned by the calling thread, so once the pool is warm an encoder or receive path
+ * does not allocate.  Use PooledMemoryBlock as the memory block functions and the pool as the userarg.
+ *
+ * Each thread has its own free list, so allocating and releasing a block takes no lock and no
+ * atomic operation.  A block may be released on a different thread than the one that allocated it;
+ * it is then pushed on to the allocating thread's returned list with an atomic operation, and that
+ * thread takes the whole list back when its free list runs dry.  So a producer thread that hands
+ * its buffers to a consumer keeps reusing the same blocks.  When a thread exits, its free and
+ * returned blocks are handed back to the pool and the next thread that runs dry takes them.
+ *
+ * Slabs are only returned to the system when the pool is finally released.  A network buffer does not
+ * hold a reference to its userarg, so every network buffer using the pool must be released first.
+ *
+ * A request larger than the block size is passed through to parcMemory_Allocate() and counted as a miss.
+ *
+ * @code
+ * {
+ *     CCNxCodecMemoryBlockPool *pool = ccnxCodecMemoryBlockPool_Create(4096, 256, false);
+ *
+ *     CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&PooledMemoryBlock, pool);
+ *     ccnxCodecNetworkBuffer_PutUint32(netbuff, 0x01020304);
+ *     ccnxCodecNetworkBuffer_Release(&netbuff);
+ *
+ *     ccnxCodecMemoryBlockPool_Release(&pool);
+ * }
+ * @endcode
+ *
+ */
+#ifndef libccnx_ccnxCodec_MemoryBlockPool_h
+#define libccnx_ccnxCodec_MemoryBlockPool_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+
+struct ccnx_codec_memory_block_pool;
+/**
+ * @typedef CCNxCodecMemoryBlockPool
+ * @brief A pool of fixed-size memory blocks carved from slabs
+ */
+typedef struct ccnx_codec_memory_block_pool CCNxCodecMemoryBlockPool;
+
+/**
+ * @typedef CCNxCodecMemoryBlockPoolStatistics
+ * @brief The calling thread's view of a CCNxCodecMemoryBlockPool
+ *
+ * All counters except `slabs` are for the calling thread only.  `outstanding` counts the blocks
+ * the calling thread allocated that are not yet released, on whichever thread they are released.
+ */
+typedef struct ccnx_codec_memory_block_pool_statistics {
+    uint64_t hits;          /**< Allocations served from the thread's free list */
+    uint64_t misses;        /**< Allocations that took blocks from a slab, another thread, or parcMemory */
+    int64_t outstanding;    /**< Blocks allocated minus blocks released */
+    int64_t highWater;      /**< The largest value of outstanding */
+    size_t slabs;           /**< Slabs mapped by the pool (all threads) */
+} CCNxCodecMemoryBlockPoolStatistics;
+
+/**
+ * Use these memory block functions with a CCNxCodecMemoryBlockPool as the userarg.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&PooledMemoryBlock, pool);
+ * }
+ * @endcode
+ */
+extern const CCNxCodecNetworkBufferMemoryBlockFunctions PooledMemoryBlock;
+
+/**
+ * Creates a pool of fixed-size memory blocks.
+ *
+ * Every block granted has exactly `blockSize` bytes and starts on a cache line boundary.  A network
+ * buffer asks for its data plus a cache line of header.  ccnxCodecNetworkBuffer_Create() never asks
+ * for more than 2048 bytes, so a block size of 2048 covers both its first block and its expansion
+ * blocks.  A buffer made with ccnxCodecNetworkBuffer_CreateWithSizeHint() needs the rounded hint plus a cache line.
+ *
+ * If `useHugePages` is true, slabs are rounded up to a multiple of 2 MB and mapped with huge pages
+ * where the platform supports it.  If the huge page mapping fails, the slab is mapped with normal pages.
+ *
+ * @param [in] blockSize The bytes granted per allocation, must be positive.
+ * @param [in] blocksPerSlab The minimum number of blocks carved from each slab, must be positive.
+ * @param [in] useHugePages If true, try to back slabs with huge pages.
+ *
+ * @return non-null An allocated pool
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecMemoryBlockPool *pool = ccnxCodecMemoryBlockPool_Create(4096, 512, true);
+ *     ccnxCodecMemoryBlockPool_Release(&pool);
+ * }
+ * @endcode
+ */
+CCNxCodecMemoryBlockPool *ccnxCodecMemoryBlockPool_Create(size_t blockSize, size_t blocksPerSlab, bool useHugePages);
+
+/**
+ * Returns a reference counted copy of the pool
+ *
+ * @param [in] pool An allocated pool
+ *
+ * @return non-null A reference counted copy
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecMemoryBlockPool *copy = ccnxCodecMemoryBlockPool_Acquire(pool);
+ *     ccnxCodecMemoryBlockPool_Release(&copy);
+ * }
+ * @endcode
+ */
+CCNxCodecMemoryBlockPool *ccnxCodecMemoryBlockPool_Acquire(const CCNxCodecMemoryBlockPool *pool);
+
+/**
+ * Releases a reference to the pool
+ *
+ * On the final release every slab is unmapped.  No block from the pool may still be in use and no other
+ * thread may be allocating from it.
+ *
+ * @param [in,out] poolPtr A pointer to the pool, will be NULL'd
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecMemoryBlockPool *pool = ccnxCodecMemoryBlockPool_Create(4096, 256, false);
+ *     ccnxCodecMemoryBlockPool_Release(&pool);
+ * }
+ * @endcode
+ */
+void ccnxCodecMemoryBlockPool_Release(CCNxCodecMemoryBlockPool **poolPtr);
+
+/**
+ * The number of bytes granted for each block
+ *
+ * @param [in] pool An allocated pool
+ *
+ * @return number The block size given to ccnxCodecMemoryBlockPool_Create()
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecMemoryBlockPool *pool = ccnxCodecMemoryBlockPool_Create(4096, 256, false);
+ *     size_t blockSize = ccnxCodecMemoryBlockPool_GetBlockSize(pool);
+ *     // blockSize == 4096
+ *     ccnxCodecMemoryBlockPool_Release(&pool);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecMemoryBlockPool_GetBlockSize(const CCNxCodecMemoryBlockPool *pool);
+
+/**
+ * Fills in the calling thread's statistics
+ *
+ * @param [in] pool An allocated pool
+ * @param [out] statistics Filled in with the calling thread's counters and the pool's slab count
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecMemoryBlockPoolStatistics statistics;
+ *     ccnxCodecMemoryBlockPool_GetStatistics(pool, &statistics);
+ *     printf("hits %" PRIu64 " misses %" PRIu64 "\n", statistics.hits, statistics.misses);
+ * }
+ * @endcode
+ */
+void ccnxCodecMemoryBlockPool_GetStatistics(CCNxCodecMemoryBlockPool *pool, CCNxCodecMemoryBlockPoolStatistics *statistics);
+#endif // libccnx_ccnxCodec_MemoryBlockPool_h
@@ -69,6 +69,7 @@
 
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
 #include <parc/algol/parc_Memory.h>
 #include <LongBow/runtime.h>
 
@@ -89,12 +90,30 @@ struct ccnx_codec_network_buffer_memory {
 
 struct ccnx_codec_network_buffer_iovec {
     CCNxCodecNetworkBuffer *networkBuffer;
+
+    // A header copy shares the rest of its memory with one of these.  Its private
+    // header bytes are allocated after array[].
+    CCNxCodecNetworkBufferIoVec *sharedVec;
+    PARCBuffer *sharedBuffer;
+
     unsigned refcount;
     size_t totalBytes;
     int iovcnt;
     struct iovec array[];
 };
 
+/*
+ * A block whose memory is a caller's PARCBuffer, from ccnxCodecNetworkBuffer_PutBufferReference().
+ * The unused end of the block before it becomes the `continuation` block, so writes after the
+ * reference do not need a new allocation.  Both headers live here and are freed with the network buffer.
+ */
+typedef struct ccnx_codec_network_buffer_reference {
+    struct ccnx_codec_network_buffer_reference *next;
+    PARCBuffer *buffer;
+    CCNxCodecNetworkBufferMemory block;
+    CCNxCodecNetworkBufferMemory continuation;
+} _CCNxCodecNetworkBufferReference;
+
 struct ccnx_codec_network_buffer {
     size_t position;
     size_t capacity;         /**< Bytes allocated */
@@ -103,6 +122,14 @@ struct ccnx_codec_network_buffer {
     CCNxCodecNetworkBufferMemory *head;
     CCNxCodecNetworkBufferMemory *tail;
 
+    size_t blockSize;        /**< Bytes to ask for when adding a memory block */
+
+    // The block from ccnxCodecNetworkBuffer_CreateFromArray(), its memory is not in-line
+    CCNxCodecNetworkBufferMemory *wrapped;
+
+    // Blocks from ccnxCodecNetworkBuffer_PutBufferReference()
+    _CCNxCodecNetworkBufferReference *references;
+
     void *userarg;
     CCNxCodecNetworkBufferMemoryBlockFunctions memoryFunctions;
     unsigned refcount;
@@ -110,7 +137,26 @@ struct ccnx_codec_network_buffer {
 
 // ================================================================================
 
-#define INLINE_POSITION(block) ((uint8_t *) block + sizeof(CCNxCodecNetworkBufferMemory))
+// The build detects the cache line size, but getconf reports 0 on some systems
+#if defined(LEVEL1_DCACHE_LINESIZE) && (LEVEL1_DCACHE_LINESIZE + 0) >= 16
+#define _CCNxCodecNetworkBuffer_CacheLineSize ((size_t) LEVEL1_DCACHE_LINESIZE)
+#else
+#define _CCNxCodecNetworkBuffer_CacheLineSize ((size_t) 64)
+#endif
+
+#define _CCNxCodecNetworkBuffer_RoundToCacheLine(bytes) \
+    (((bytes) + _CCNxCodecNetworkBuffer_CacheLineSize - 1) / _CCNxCodecNetworkBuffer_CacheLineSize * _CCNxCodecNetworkBuffer_CacheLineSize)
+
+// If the allocator returns cache line aligned memory and grants enough of it, the header is
+// padded so the in-line data starts on a cache line too.
+#define ALIGNED_HEADER_SIZE _CCNxCodecNetworkBuffer_RoundToCacheLine(sizeof(CCNxCodecNetworkBufferMemory))
+
+// The first block of ccnxCodecNetworkBuffer_Create() holds a 1500 byte MTU packet
+static const size_t _ccnxCodecNetworkBuffer_DefaultFirstBlockSize = 1536;
+
+// Expansion blocks are sized so the header and the data together are a 2048 byte allocation,
+// which a memory block pool of 2048 byte blocks serves without falling back to parcMemory.
+static const size_t _ccnxCodecNetworkBuffer_DefaultBlockSize = 2048 - ALIGNED_HEADER_SIZE;
 
 static CCNxCodecNetworkBufferMemory *
 _ccnxCodecNetworkBufferMemory_Allocate(CCNxCodecNetworkBuffer *buffer, size_t bytes)
@@ -118,21 +164,27 @@ _ccnxCodecNetworkBufferMemory_Allocate(CCNxCodecNetworkBuffer *buffer, size_t by
     assertNotNull(buffer->memoryFunctions.allocator, "Allocator must be non-null to allocate memory!");
 
     CCNxCodecNetworkBufferMemory *block;
-    size_t totalAllocation = bytes + sizeof(CCNxCodecNetworkBufferMemory);
+    size_t totalAllocation = bytes + ALIGNED_HEADER_SIZE;
     size_t actual = buffer->memoryFunctions.allocator(buffer->userarg, totalAllocation, (void **) &block);
 
-    if (actual > sizeof(CCNxCodecNetworkBufferMemory)) {
+    // An allocator may grant less than asked.  Only pay for the padding if a cache line of data is left.
+    size_t headerSize = sizeof(CCNxCodecNetworkBufferMemory);
+    if (actual >= ALIGNED_HEADER_SIZE + _CCNxCodecNetworkBuffer_CacheLineSize) {
+        headerSize = ALIGNED_HEADER_SIZE;
+    }
+
+    if (actual > headerSize) {
         block->next = NULL;
         block->begin = 0;
-        block->capacity = actual - sizeof(CCNxCodecNetworkBufferMemory);
+        block->capacity = actual - headerSize;
         block->limit = 0;
 
-        block->memory = INLINE_POSITION(block);
+        block->memory = (uint8_t *) block + headerSize;
         return block;
     }
 
     // Need a de-allocator, see case 1006
-    trapOutOfMemory("Wanted %zu got %zu, minimum required %zu", totalAllocation, actual, sizeof(CCNxCodecNetworkBufferMemory));
+    trapOutOfMemory("Wanted %zu got %zu, minimum required %zu", totalAllocation, actual, headerSize);
     return NULL;
 }
 
@@ -190,8 +242,16 @@ _ccnxCodecNetworkBufferMemory_Release(CCNxCodecNetworkBuffer *buffer, CCNxCodecN
 
     assertNull(memory->next, "memory->next is not null");
 
+    // Reference blocks and their continuations are freed with the network buffer
+    for (_CCNxCodecNetworkBufferReference *reference = buffer->references; reference; reference = reference->next) {
+        if (memory == &reference->block || memory == &reference->continuation) {
+            *memoryPtr = NULL;
+            return;
+        }
+    }
+
     // If the memory is not in-line, free it with the deallocator
-    if (memory->memory == INLINE_POSITION(memory)) {
+    if (memory != buffer->wrapped) {
         if (buffer->memoryFunctions.deallocator) {
             buffer->memoryFunctions.deallocator(buffer->userarg, (void **) memoryPtr);
         }
@@ -200,6 +260,7 @@ _ccnxCodecNetworkBufferMemory_Release(CCNxCodecNetworkBuffer *buffer, CCNxCodecN
             buffer->memoryFunctions.deallocator(buffer->userarg, (void **) &memory->memory);
         }
         parcMemory_Deallocate((void **) &memory);
+        buffer->wrapped = NULL;
     }
 
 
@@ -228,8 +289,7 @@ _ccnxCodecNetworkBufferMemory_ContainsPosition(CCNxCodecNetworkBufferMemory *mem
 static void
 _ccnxCodecNetworkBuffer_Expand(CCNxCodecNetworkBuffer *buffer)
 {
-    size_t allocationSize = 2048;
-    CCNxCodecNetworkBufferMemory *memory = _ccnxCodecNetworkBufferMemory_Allocate(buffer, allocationSize);
+    CCNxCodecNetworkBufferMemory *memory = _ccnxCodecNetworkBufferMemory_Allocate(buffer, buffer->blockSize);
 
     buffer->capacity += memory->capacity;
 
@@ -325,8 +385,8 @@ _ccnxCodecNetworkBuffer_EnsureRemaining(CCNxCodecNetworkBuffer *buffer, size_t l
 static size_t
 _ccnxCodecNetworkBuffer_ParcMemoryAllocator(void *userarg, size_t bytes, void **output)
 {
-    *output = parcMemory_Allocate(bytes);
-    if (*output) {
+    *output = NULL;
+    if (parcMemory_MemAlign(output, _CCNxCodecNetworkBuffer_CacheLineSize, bytes) == 0 && *output) {
         return bytes;
     }
     return 0;
@@ -354,15 +414,41 @@ ccnxCodecNetworkBuffer_Allocate(const CCNxCodecNetworkBufferMemoryBlockFunctions
     buffer->position = 0;
     memcpy(&buffer->memoryFunctions, memoryFunctions, sizeof(CCNxCodecNetworkBufferMemoryBlockFunctions));
     buffer->userarg = userarg;
+    buffer->blockSize = _ccnxCodecNetworkBuffer_DefaultBlockSize;
+    buffer->wrapped = NULL;
+    buffer->references = NULL;
     return buffer;
 }
 
 CCNxCodecNetworkBuffer *
 ccnxCodecNetworkBuffer_Create(const CCNxCodecNetworkBufferMemoryBlockFunctions *memoryFunctions, void *userarg)
 {
+    return ccnxCodecNetworkBuffer_CreateWithCapacity(memoryFunctions, userarg, _ccnxCodecNetworkBuffer_DefaultFirstBlockSize);
+}
+
+CCNxCodecNetworkBuffer *
+ccnxCodecNetworkBuffer_CreateWithSizeHint(const CCNxCodecNetworkBufferMemoryBlockFunctions *memoryFunctions, void *userarg, size_t sizeHint)
+{
+    assertTrue(sizeHint > 0, "Parameter sizeHint must be positive");
+
+    size_t blockSize = _CCNxCodecNetworkBuffer_RoundToCacheLine(sizeHint);
+    CCNxCodecNetworkBuffer *buffer = ccnxCodecNetworkBuffer_CreateWithCapacity(memoryFunctions, userarg, blockSize);
+
+    // A packet bigger than the hint grows by blocks of the hint, but never by tiny blocks
+    if (blockSize > buffer->blockSize) {
+        buffer->blockSize = blockSize;
+    }
+    return buffer;
+}
+
+CCNxCodecNetworkBuffer *
+ccnxCodecNetworkBuffer_CreateWithCapacity(const CCNxCodecNetworkBufferMemoryBlockFunctions *memoryFunctions, void *userarg, size_t capacity)
+{
+    assertTrue(capacity > 0, "Parameter capacity must be positive");
+
     CCNxCodecNetworkBuffer *buffer = ccnxCodecNetworkBuffer_Allocate(memoryFunctions, userarg);
 
-    buffer->head = _ccnxCodecNetworkBufferMemory_Allocate(buffer, 1536);
+    buffer->head = _ccnxCodecNetworkBufferMemory_Allocate(buffer, capacity);
     buffer->tail = buffer->head;
     buffer->current = buffer->head;
     buffer->capacity = buffer->head->capacity;
@@ -376,6 +462,7 @@ ccnxCodecNetworkBuffer_CreateFromArray(const CCNxCodecNetworkBufferMemoryBlockFu
     CCNxCodecNetworkBuffer *buffer = ccnxCodecNetworkBuffer_Allocate(memoryFunctions, userarg);
 
     buffer->head = _ccnxCodecNetworkBufferMemory_Wrap(buffer, length, memory);
+    buffer->wrapped = buffer->head;
     buffer->tail = buffer->head;
     buffer->current = buffer->head;
     buffer->capacity = buffer->head->capacity;
@@ -412,6 +499,12 @@ ccnxCodecNetworkBuffer_Release(CCNxCodecNetworkBuffer **bufferPtr)
             _ccnxCodecNetworkBufferMemory_Release(buffer, &buffer->head);
             buffer->head = next;
         }
+        while (buffer->references) {
+            _CCNxCodecNetworkBufferReference *reference = buffer->references;
+            buffer->references = reference->next;
+            parcBuffer_Release(&reference->buffer);
+            parcMemory_Deallocate((void **) &reference);
+        }
         parcMemory_Deallocate((void **) &buffer);
     }
     *bufferPtr = NULL;
@@ -511,6 +604,16 @@ ccnxCodecNetworkBuffer_Finalize(CCNxCodecNetworkBuffer *buffer)
         buffer->current->limit = relativePosition;
         buffer->tail = buffer->current;
     }
+
+    // Nothing was written after the last buffer reference, so do not leave an empty iovec entry
+    for (_CCNxCodecNetworkBufferReference *reference = buffer->references; reference; reference = reference->next) {
+        if (buffer->tail == &reference->continuation && reference->continuation.limit == 0) {
+            reference->block.next = NULL;
+            buffer->tail = &reference->block;
+            buffer->current = buffer->tail;
+            break;
+        }
+    }
 }
 
 static inline void
@@ -534,39 +637,86 @@ ccnxCodecNetworkBuffer_PutUint8(CCNxCodecNetworkBuffer *buffer, uint8_t value)
     _ccnxCodecNetworkBuffer_PutUint8(buffer, value);
 }
 
+/*
+ * Convert a host integer to network byte order.  The result is stored with memcpy, which
+ * compiles to a single (possibly unaligned) store.
+ */
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define _ccnxCodecNetworkBuffer_HostToBig16(value) __builtin_bswap16(value)
+#define _ccnxCodecNetworkBuffer_HostToBig32(value) __builtin_bswap32(value)
+#define _ccnxCodecNetworkBuffer_HostToBig64(value) __builtin_bswap64(value)
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define _ccnxCodecNetworkBuffer_HostToBig16(value) (value)
+#define _ccnxCodecNetworkBuffer_HostToBig32(value) (value)
+#define _ccnxCodecNetworkBuffer_HostToBig64(value) (value)
+#else
+#define _ccnxCodecNetworkBuffer_HostToBigN(bits) \
+    static inline uint ## bits ## _t \
+    _ccnxCodecNetworkBuffer_HostToBig ## bits(uint ## bits ## _t value) \
+    { \
+        uint ## bits ## _t result; \
+        uint8_t *bytes = (uint8_t *) &result; \
+        for (size_t i = 0; i < sizeof(result); i++) { \
+            bytes[i] = (uint8_t) (value >> ((sizeof(result) - 1 - i) * 8)); \
+        } \
+        return result; \
+    }
+_ccnxCodecNetworkBuffer_HostToBigN(16)
+_ccnxCodecNetworkBuffer_HostToBigN(32)
+_ccnxCodecNetworkBuffer_HostToBigN(64)
+#endif
+
+/**
+ * Write `length` bytes that are already in network byte order.
+ *
+ * If the current block has room, this is one memcpy and one limit update.  Only at a
+ * block boundary do we fall back to the byte-by-byte path, which may span two blocks.
+ */
+static inline void
+_ccnxCodecNetworkBuffer_PutBigEndian(CCNxCodecNetworkBuffer *buffer, size_t length, const void *bigEndian)
+{
+    size_t relativePosition = buffer->position - buffer->current->begin;
+    if (buffer->current->capacity - relativePosition < length) {
+        _ccnxCodecNetworkBuffer_EnsureRemaining(buffer, length);
+        relativePosition = buffer->position - buffer->current->begin;
+
+        if (buffer->current->capacity - relativePosition < length) {
+            const uint8_t *bytes = bigEndian;
+            for (size_t i = 0; i < length; i++) {
+                _ccnxCodecNetworkBuffer_PutUint8(buffer, bytes[i]);
+            }
+            return;
+        }
+    }
+
+    memcpy(&buffer->current->memory[relativePosition], bigEndian, length);
+
+    relativePosition += length;
+    if (relativePosition > buffer->current->limit) {
+        buffer->current->limit = relativePosition;
+    }
+    buffer->position += length;
+}
+
 void
 ccnxCodecNetworkBuffer_PutUint16(CCNxCodecNetworkBuffer *buffer, uint16_t value)
 {
-    _ccnxCodecNetworkBuffer_EnsureRemaining(buffer, 2);
-
-    _ccnxCodecNetworkBuffer_PutUint8(buffer, value >> 8);
-    _ccnxCodecNetworkBuffer_PutUint8(buffer, value & 0xFF);
+    uint16_t bigEndian = _ccnxCodecNetworkBuffer_HostToBig16(value);
+    _ccnxCodecNetworkBuffer_PutBigEndian(buffer, sizeof(bigEndian), &bigEndian);
 }
 
 void
 ccnxCodecNetworkBuffer_PutUint32(CCNxCodecNetworkBuffer *buffer, uint32_t value)
 {
-    _ccnxCodecNetworkBuffer_EnsureRemaining(buffer, 4);
-
-    for (int i = sizeof(uint32_t) - 1; i > 0; i--) {
-        uint8_t b = value >> (i * 8) & 0xFF;
-        _ccnxCodecNetworkBuffer_PutUint8(buffer, b);
-    }
-
-    _ccnxCodecNetworkBuffer_PutUint8(buffer, value & 0xFF);
+    uint32_t bigEndian = _ccnxCodecNetworkBuffer_HostToBig32(value);
+    _ccnxCodecNetworkBuffer_PutBigEndian(buffer, sizeof(bigEndian), &bigEndian);
 }
 
 void
 ccnxCodecNetworkBuffer_PutUint64(CCNxCodecNetworkBuffer *buffer, uint64_t value)
 {
-    _ccnxCodecNetworkBuffer_EnsureRemaining(buffer, 8);
-
-    for (int i = sizeof(uint64_t) - 1; i > 0; i--) {
-        uint8_t b = value >> (i * 8) & 0xFF;
-        _ccnxCodecNetworkBuffer_PutUint8(buffer, b);
-    }
-
-    _ccnxCodecNetworkBuffer_PutUint8(buffer, value & 0xFF);
+    uint64_t bigEndian = _ccnxCodecNetworkBuffer_HostToBig64(value);
+    _ccnxCodecNetworkBuffer_PutBigEndian(buffer, sizeof(bigEndian), &bigEndian);
 }
 
 void
@@ -610,6 +760,53 @@ ccnxCodecNetworkBuffer_PutBuffer(CCNxCodecNetworkBuffer *buffer, PARCBuffer *val
     }
 }
 
+void
+ccnxCodecNetworkBuffer_PutBufferReference(CCNxCodecNetworkBuffer *buffer, PARCBuffer *value)
+{
+    assertNotNull(buffer, "Parameter buffer must be non-null");
+    assertNotNull(value, "Parameter value must be non-null");
+    assertTrue(buffer->position == _ccnxCodecNetworkBuffer_Limit(buffer),
+               "Can only reference a buffer at the end, position %zu limit %zu", buffer->position, _ccnxCodecNetworkBuffer_Limit(buffer));
+
+    size_t length = parcBuffer_Remaining(value);
+    if (length == 0) {
+        return;
+    }
+
+    _CCNxCodecNetworkBufferReference *reference = parcMemory_AllocateAndClear(sizeof(_CCNxCodecNetworkBufferReference));
+    assertNotNull(reference, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxCodecNetworkBufferReference));
+    reference->buffer = parcBuffer_Acquire(value);
+    reference->next = buffer->references;
+    buffer->references = reference;
+
+    CCNxCodecNetworkBufferMemory *previous = buffer->tail;
+    size_t unused = previous->capacity - previous->limit;
+
+    reference->block.begin = previous->begin + previous->limit;
+    reference->block.capacity = length;
+    reference->block.limit = length;
+    reference->block.memory = parcBuffer_Overlay(value, 0);
+
+    previous->capacity = previous->limit;
+    previous->next = &reference->block;
+    buffer->tail = &reference->block;
+    buffer->capacity += length;
+
+    // If there is a useful amount of space left in the previous block, keep writing there
+    if (unused >= _CCNxCodecNetworkBuffer_CacheLineSize) {
+        reference->continuation.begin = reference->block.begin + length;
+        reference->continuation.capacity = unused;
+        reference->continuation.limit = 0;
+        reference->continuation.memory = previous->memory + previous->limit;
+
+        reference->block.next = &reference->continuation;
+        buffer->tail = &reference->continuation;
+    }
+
+    buffer->current = buffer->tail;
+    buffer->position += length;
+}
+
 PARCBuffer *
 ccnxCodecNetworkBuffer_CreateParcBuffer(CCNxCodecNetworkBuffer *buffer)
 {
@@ -645,13 +842,14 @@ ccnxCodecNetworkBuffer_ComputeSignature(CCNxCodecNetworkBuffer *buffer, size_t s
         PARCCryptoHasher *hasher = parcSigner_GetCryptoHasher(signer);
         parcCryptoHasher_Init(hasher);
 
+        // Walk every block, skipping those before the signed area, until the area is hashed
         size_t position = start;
         CCNxCodecNetworkBufferMemory *block = buffer->head;
-        while (block && position < block->begin + block->limit) {
+        while (block && position < end) {
             if (_ccnxCodecNetworkBufferMemory_ContainsPosition(block, position)) {
                 // determine if we're going all the way to the block's end or are we
                 // stopping early because that's the end of the designated area
-                size_t roof = (end > block->begin + block->limit) ? block->limit : end;
+                size_t roof = (end > block->begin + block->limit) ? block->begin + block->limit : end;
                 size_t length = roof - position;
 
                 // now calculate the relative offset in the block so we can update the hash
@@ -721,6 +919,8 @@ ccnxCodecNetworkBuffer_CreateIoVec(CCNxCodecNetworkBuffer *buffer)
     assertNotNull(vec, "parcMemory_Allocate(%zu) returned NULL", allocationSize);
     vec->refcount = 1;
     vec->networkBuffer = ccnxCodecNetworkBuffer_Acquire(buffer);
+    vec->sharedVec = NULL;
+    vec->sharedBuffer = NULL;
     vec->iovcnt = (int) blockCount;
     vec->totalBytes = 0;
 
@@ -735,6 +935,132 @@ ccnxCodecNetworkBuffer_CreateIoVec(CCNxCodecNetworkBuffer *buffer)
     return vec;
 }
 
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecNetworkBuffer_CreateIoVecRanges(CCNxCodecNetworkBuffer *buffer, size_t count, const size_t ends[count], size_t firstIndex[count + 1])
+{
+    assertNotNull(buffer, "Parameter buffer must be non-null");
+    assertTrue(count == 0 || ends != NULL, "Parameter ends must be non-null");
+    assertNotNull(firstIndex, "Parameter firstIndex must be non-null");
+
+    // Each range boundary can split at most one block
+    size_t maximumCount = _ccnxCodecNetworkBuffer_BlockCount(buffer) + count;
+    size_t allocationSize = sizeof(CCNxCodecNetworkBufferIoVec) + sizeof(struct iovec) * maximumCount;
+
+    CCNxCodecNetworkBufferIoVec *vec = parcMemory_Allocate(allocationSize);
+    assertNotNull(vec, "parcMemory_Allocate(%zu) returned NULL", allocationSize);
+    vec->refcount = 1;
+    vec->networkBuffer = ccnxCodecNetworkBuffer_Acquire(buffer);
+    vec->sharedVec = NULL;
+    vec->sharedBuffer = NULL;
+    vec->totalBytes = 0;
+
+    size_t limit = _ccnxCodecNetworkBuffer_Limit(buffer);
+    CCNxCodecNetworkBufferMemory *block = buffer->head;
+    size_t position = 0;
+    size_t index = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        assertTrue(ends[i] >= position && ends[i] <= limit, "Range %zu end %zu out of order or beyond limit %zu", i, ends[i], limit);
+
+        firstIndex[i] = index;
+        while (position < ends[i]) {
+            while (position >= block->begin + block->limit) {
+                block = block->next;
+            }
+
+            size_t blockEnd = block->begin + block->limit;
+            size_t end = (ends[i] < blockEnd) ? ends[i] : blockEnd;
+            vec->array[index].iov_base = block->memory + (position - block->begin);
+            vec->array[index].iov_len = end - position;
+            index++;
+            position = end;
+        }
+    }
+    firstIndex[count] = index;
+
+    vec->iovcnt = (int) index;
+    vec->totalBytes = position;
+    return vec;
+}
+
+/**
+ * Allocate an io vector whose first element is a private copy of `headerLength` bytes
+ * and with room for `sharedCount` more elements.
+ */
+static CCNxCodecNetworkBufferIoVec *
+_ccnxCodecNetworkBufferIoVec_AllocateHeaderCopy(size_t headerLength, size_t sharedCount)
+{
+    size_t arraySize = sizeof(struct iovec) * (1 + sharedCount);
+    size_t allocationSize = sizeof(CCNxCodecNetworkBufferIoVec) + arraySize + headerLength;
+
+    CCNxCodecNetworkBufferIoVec *vec = parcMemory_Allocate(allocationSize);
+    assertNotNull(vec, "parcMemory_Allocate(%zu) returned NULL", allocationSize);
+    vec->refcount = 1;
+    vec->networkBuffer = NULL;
+    vec->sharedVec = NULL;
+    vec->sharedBuffer = NULL;
+    vec->iovcnt = 1;
+    vec->totalBytes = headerLength;
+    vec->array[0].iov_base = (uint8_t *) vec->array + arraySize;
+    vec->array[0].iov_len = headerLength;
+    return vec;
+}
+
+static void
+_ccnxCodecNetworkBufferIoVec_AppendShared(CCNxCodecNetworkBufferIoVec *vec, uint8_t *base, size_t length)
+{
+    if (length > 0) {
+        vec->array[vec->iovcnt].iov_base = base;
+        vec->array[vec->iovcnt].iov_len = length;
+        vec->iovcnt++;
+        vec->totalBytes += length;
+    }
+}
+
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecNetworkBufferIoVec_CreateHeaderCopy(CCNxCodecNetworkBufferIoVec *vec, size_t headerLength)
+{
+    assertNotNull(vec, "Parameter vec must be non-null");
+    assertTrue(headerLength <= vec->totalBytes, "headerLength %zu beyond the vector length %zu", headerLength, vec->totalBytes);
+
+    CCNxCodecNetworkBufferIoVec *copy = _ccnxCodecNetworkBufferIoVec_AllocateHeaderCopy(headerLength, vec->iovcnt);
+    copy->sharedVec = ccnxCodecNetworkBufferIoVec_Acquire(vec);
+
+    uint8_t *header = copy->array[0].iov_base;
+    size_t copied = 0;
+    for (int i = 0; i < vec->iovcnt; i++) {
+        uint8_t *base = vec->array[i].iov_base;
+        size_t length = vec->array[i].iov_len;
+        if (copied < headerLength) {
+            size_t chunk = (length < headerLength - copied) ? length : headerLength - copied;
+            memcpy(header + copied, base, chunk);
+            copied += chunk;
+            base += chunk;
+            length -= chunk;
+        }
+        _ccnxCodecNetworkBufferIoVec_AppendShared(copy, base, length);
+    }
+
+    return copy;
+}
+
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecNetworkBufferIoVec_CreateHeaderCopyFromBuffer(const PARCBuffer *wireFormat, size_t headerLength)
+{
+    assertNotNull(wireFormat, "Parameter wireFormat must be non-null");
+    size_t remaining = parcBuffer_Remaining(wireFormat);
+    assertTrue(headerLength <= remaining, "headerLength %zu beyond the buffer remaining %zu", headerLength, remaining);
+
+    CCNxCodecNetworkBufferIoVec *copy = _ccnxCodecNetworkBufferIoVec_AllocateHeaderCopy(headerLength, 1);
+    copy->sharedBuffer = parcBuffer_Acquire(wireFormat);
+
+    uint8_t *base = parcBuffer_Overlay(copy->sharedBuffer, 0);
+    memcpy(copy->array[0].iov_base, base, headerLength);
+    _ccnxCodecNetworkBufferIoVec_AppendShared(copy, base + headerLength, remaining - headerLength);
+
+    return copy;
+}
+
 CCNxCodecNetworkBufferIoVec *
 ccnxCodecNetworkBufferIoVec_Acquire(CCNxCodecNetworkBufferIoVec *vec)
 {
@@ -754,12 +1080,27 @@ ccnxCodecNetworkBufferIoVec_Release(CCNxCodecNetworkBufferIoVec **vecPtr)
 
     vec->refcount--;
     if (vec->refcount == 0) {
-        ccnxCodecNetworkBuffer_Release(&vec->networkBuffer);
+        if (vec->networkBuffer) {
+            ccnxCodecNetworkBuffer_Release(&vec->networkBuffer);
+        }
+        if (vec->sharedVec) {
+            ccnxCodecNetworkBufferIoVec_Release(&vec->sharedVec);
+        }
+        if (vec->sharedBuffer) {
+            parcBuffer_Release(&vec->sharedBuffer);
+        }
         parcMemory_Deallocate((void **) &vec);
     }
     *vecPtr = NULL;
 }
 
+unsigned
+ccnxCodecNetworkBufferIoVec_GetReferenceCount(const CCNxCodecNetworkBufferIoVec *vec)
+{
+    assertNotNull(vec, "Parameter vec must be non-null");
+    return vec->refcount;
+}
+
 int
 ccnxCodecNetworkBufferIoVec_GetCount(CCNxCodecNetworkBufferIoVec *vec)
 {
@@ -808,15 +1149,35 @@ ccnxCodecNetworkBufferIoVec_Equals(const CCNxCodecNetworkBufferIoVec *a, const C
     }
 
     // both are non-null
-    bool equals = false;
-    if (a->totalBytes == b->totalBytes) {
-        PARCBuffer *abuffer = ccnxCodecNetworkBuffer_CreateParcBuffer(a->networkBuffer);
-        PARCBuffer *bbuffer = ccnxCodecNetworkBuffer_CreateParcBuffer(b->networkBuffer);
+    if (a->totalBytes != b->totalBytes) {
+        return false;
+    }
 
-        equals = parcBuffer_Equals(abuffer, bbuffer);
+    // walk both vectors in parallel, the extents need not line up
+    int ai = 0, bi = 0;
+    size_t aoffset = 0, boffset = 0;
+    size_t compared = 0;
+    while (compared < a->totalBytes) {
+        if (aoffset == a->array[ai].iov_len) {
+            ai++;
+            aoffset = 0;
+            continue;
+        }
+        if (boffset == b->array[bi].iov_len) {
+            bi++;
+            boffset = 0;
+            continue;
+        }
 
-        parcBuffer_Release(&abuffer);
-        parcBuffer_Release(&bbuffer);
+        size_t aremaining = a->array[ai].iov_len - aoffset;
+        size_t bremaining = b->array[bi].iov_len - boffset;
+        size_t length = (aremaining < bremaining) ? aremaining : bremaining;
+        if (memcmp((uint8_t *) a->array[ai].iov_base + aoffset, (uint8_t *) b->array[bi].iov_base + boffset, length) != 0) {
+            return false;
+        }
+        aoffset += length;
+        boffset += length;
+        compared += length;
     }
-    return equals;
+    return true;
 }
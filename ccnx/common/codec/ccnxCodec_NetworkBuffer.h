@@ -40,7 +40,7 @@
  *
  * A network buffer uses a CCNxCodecNetworkBufferMemoryBlockFunctions structure for an allocator and de-allocator.  The allocator is called
  * to add more memory to the scatter/gather list of memory buffers and the de-allocator is used to return those
- * buffers to the owner.  A user could point to "ParcMemoryMemoryBlock" to use the normal parcMemory_allocate() and
+ * buffers to the owner.  A user could point to "ParcMemoryMemoryBlock" to use cache line aligned parcMemory_MemAlign() and
  * parcMemory_deallocate() functions.  Or, they can use their own or wrap event buffers or wrap kernel memory blocks.
  *
  * The user can address the memory using a linearized position with ccnxCodecNetworkBuffer_Position() and ccnxCodecNetworkBuffer_SetPosition().
@@ -130,6 +130,57 @@ extern const CCNxCodecNetworkBufferMemoryBlockFunctions ParcMemoryMemoryBlock;
  */
 CCNxCodecNetworkBuffer *ccnxCodecNetworkBuffer_Create(const CCNxCodecNetworkBufferMemoryBlockFunctions *blockFunctions, void *userarg);
 
+/**
+ * Creates a `CCNxCodecNetworkBuffer` whose first memory block holds `capacity` bytes.
+ *
+ * Like ccnxCodecNetworkBuffer_Create(), but the caller picks the size of the first block.
+ * If the caller knows the exact number of bytes it will write, every write lands in
+ * one contiguous block and ccnxCodecNetworkBuffer_CreateIoVec() returns a single iovec.
+ * Writing past `capacity` still works, it expands the buffer as usual.
+ *
+ * @param [in] blockFunctions The allocator/de-allocator to use.
+ * @param [in] userarg Passed to all calls to the blockFunctions, may be NULL.
+ * @param [in] capacity The number of bytes in the first memory block, must be positive.
+ *
+ * @return non-null An allocated memory block using memory from blockFunctions.
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBuffer * netbuffer = ccnxCodecNetworkBuffer_CreateWithCapacity(&ParcMemoryMemoryBlock, NULL, 64);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBuffer *ccnxCodecNetworkBuffer_CreateWithCapacity(const CCNxCodecNetworkBufferMemoryBlockFunctions *blockFunctions, void *userarg, size_t capacity);
+
+/**
+ * Creates a `CCNxCodecNetworkBuffer` sized for packets of about `sizeHint` bytes.
+ *
+ * Use the expected packet size or the interface MTU (e.g. 9000 for a jumbo frame link) as the hint.
+ * The first memory block holds at least `sizeHint` bytes, rounded up to a whole number of cache
+ * lines, so a packet of that size is one block and one iovec.  If the buffer must grow, it adds
+ * blocks of the same size (or the default block size, if that is larger).
+ *
+ * ccnxCodecNetworkBuffer_Create() uses a 1536 byte first block and expansion blocks whose
+ * bookkeeping header and data together are a 2048 byte allocation.
+ *
+ * @param [in] blockFunctions The allocator/de-allocator to use.
+ * @param [in] userarg Passed to all calls to the blockFunctions, may be NULL.
+ * @param [in] sizeHint The expected number of bytes to write, must be positive.
+ *
+ * @return non-null An allocated memory block using memory from blockFunctions.
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBuffer * netbuffer = ccnxCodecNetworkBuffer_CreateWithSizeHint(&ParcMemoryMemoryBlock, NULL, 9000);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBuffer *ccnxCodecNetworkBuffer_CreateWithSizeHint(const CCNxCodecNetworkBufferMemoryBlockFunctions *blockFunctions, void *userarg, size_t sizeHint);
+
 /**
  * Create a `CCNxCodecNetworkBuffer` from a buffer block.
  *
@@ -493,6 +544,41 @@ void ccnxCodecNetworkBuffer_PutArray(CCNxCodecNetworkBuffer *buffer, size_t leng
  */
 void ccnxCodecNetworkBuffer_PutBuffer(CCNxCodecNetworkBuffer *buffer, PARCBuffer *value);
 
+/**
+ * Appends a PARCBuffer by reference instead of copying it
+ *
+ * The remaining bytes of `value` become their own memory block in the network buffer, so an iovec
+ * created afterwards points straight at the caller's memory.  The network buffer acquires a reference
+ * to `value` and releases it when the network buffer is released.  Any unused space in the block
+ * before the reference is used for the bytes written after it.
+ *
+ * The cursor must be at the limit of the network buffer.  The referenced bytes are read-only:
+ * the network buffer never writes to them, so do not move the cursor back into them and write.
+ * The caller must not modify the bytes of `value` until the network buffer and every iovec or
+ * PARCBuffer created from it have been released.
+ *
+ * Appending a zero length buffer does nothing.
+ *
+ * @param [in,out] buffer An allocated `CCNxCodecNetworkBuffer`.
+ * @param [in] value The bytes from the position to the limit are appended.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+ *     ccnxCodecNetworkBuffer_PutUint32(netbuff, 0x01020304);
+ *     ccnxCodecNetworkBuffer_PutBufferReference(netbuff, payload);
+ *     ccnxCodecNetworkBuffer_PutUint16(netbuff, 0x0506);
+ *
+ *     CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+ *     // the second iovec entry points at the memory of payload
+ *     ccnxCodecNetworkBufferIoVec_Release(&vec);
+ *     ccnxCodecNetworkBuffer_Release(&netbuff);
+ * }
+ * @endcode
+ */
+void ccnxCodecNetworkBuffer_PutBufferReference(CCNxCodecNetworkBuffer *buffer, PARCBuffer *value);
+
 /**
  * Creates a linearized memory buffer.
  *
@@ -636,6 +722,41 @@ void ccnxCodecNetworkBuffer_Display(const CCNxCodecNetworkBuffer *netbuff, unsig
  */
 CCNxCodecNetworkBufferIoVec *ccnxCodecNetworkBuffer_CreateIoVec(CCNxCodecNetworkBuffer *buffer);
 
+/**
+ * Creates an IoVec of consecutive byte ranges of the buffer, each starting a new iovec element
+ *
+ * Range `i` is the bytes from `ends[i - 1]` (or 0) up to `ends[i]`.  Where a range starts or ends inside
+ * a memory block, the block is split across two iovec elements, so the elements of range `i` are
+ * `array[firstIndex[i]]` through `array[firstIndex[i + 1] - 1]`.  An empty range has no elements.
+ * Each range can be handed to a separate `sendmsg()`, or one `sendmmsg()` for all of them.
+ *
+ * Like `ccnxCodecNetworkBuffer_CreateIoVec()`, this is zero-copy and acquires a reference to the buffer.
+ *
+ * @param [in] buffer An allocated `CCNxCodecNetworkBuffer` (will acquire a reference to it).
+ * @param [in] count The number of ranges
+ * @param [in] ends The end of each range.  Must be non-decreasing and not beyond the buffer limit.
+ * @param [out] firstIndex Array of `count + 1` elements.  `firstIndex[count]` is the total element count.
+ *
+ * @return non-null An allocated {@link CCNxCodecNetworkBufferIoVec}, you must call {@link ccnxCodecNetworkBufferIoVec_Release}
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t ends[] = { firstPacketLength, firstPacketLength + secondPacketLength };
+ *     size_t firstIndex[3];
+ *     CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVecRanges(netbuff, 2, ends, firstIndex);
+ *     const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+ *
+ *     // the second packet
+ *     writev(fd, &iov[firstIndex[1]], firstIndex[2] - firstIndex[1]);
+ *
+ *     ccnxCodecNetworkBufferIoVec_Release(&vec);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecNetworkBuffer_CreateIoVecRanges(CCNxCodecNetworkBuffer *buffer, size_t count,
+                                                                      const size_t ends[count], size_t firstIndex[count + 1]);
+
 /**
  * Increase the number of references to a `CCNxCodecNetworkBufferIoVec`.
  *
@@ -693,6 +814,76 @@ CCNxCodecNetworkBufferIoVec *ccnxCodecNetworkBufferIoVec_Acquire(CCNxCodecNetwor
  */
 void ccnxCodecNetworkBufferIoVec_Release(CCNxCodecNetworkBufferIoVec **vecPtr);
 
+/**
+ * Create an io vector with a private copy of the first `headerLength` bytes of `vec`
+ *
+ * The first element of the new io vector is the private copy, which may be written without
+ * changing `vec`.  The remaining elements point in to the memory of `vec`, which the new
+ * io vector holds a reference to.  This is how a packet shared by several messages is given
+ * per-message header changes without copying the whole packet.
+ *
+ * @param [in] vec The io vector to copy
+ * @param [in] headerLength The number of leading bytes to copy, at most the length of `vec`
+ *
+ * @return non-null A new io vector with the same contents as `vec`
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferIoVec *copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopy(vec, 8);
+ *     uint8_t *header = ccnxCodecNetworkBufferIoVec_GetArray(copy)[0].iov_base;
+ *     header[4] = hopLimit;
+ *     // vec is unchanged
+ *     ccnxCodecNetworkBufferIoVec_Release(&copy);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecNetworkBufferIoVec_CreateHeaderCopy(CCNxCodecNetworkBufferIoVec *vec, size_t headerLength);
+
+/**
+ * Create an io vector with a private copy of the first `headerLength` bytes of `wireFormat`
+ *
+ * Like {@link ccnxCodecNetworkBufferIoVec_CreateHeaderCopy}, for a packet held in a PARCBuffer.
+ * The io vector covers the buffer from its position to its limit.  The new io vector holds a
+ * reference to `wireFormat`, so do not change the buffer's position or limit while it is in use.
+ *
+ * @param [in] wireFormat The packet
+ * @param [in] headerLength The number of leading bytes to copy, at most the remaining bytes of `wireFormat`
+ *
+ * @return non-null A new io vector with the same contents as `wireFormat`
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferIoVec *copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopyFromBuffer(packet, 8);
+ *     writev(fh, ccnxCodecNetworkBufferIoVec_GetArray(copy), ccnxCodecNetworkBufferIoVec_GetCount(copy));
+ *     ccnxCodecNetworkBufferIoVec_Release(&copy);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecNetworkBufferIoVec_CreateHeaderCopyFromBuffer(const PARCBuffer *wireFormat, size_t headerLength);
+
+/**
+ * Returns the number of references to the io vector
+ *
+ * An io vector with more than one reference may be in use elsewhere and should not be written.
+ *
+ * @param [in] vec An allocated `CCNxCodecNetworkBufferIoVec`.
+ *
+ * @return The reference count
+ *
+ * Example:
+ * @code
+ * {
+ *     if (ccnxCodecNetworkBufferIoVec_GetReferenceCount(vec) > 1) {
+ *         CCNxCodecNetworkBufferIoVec *copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopy(vec, headerLength);
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+unsigned ccnxCodecNetworkBufferIoVec_GetReferenceCount(const CCNxCodecNetworkBufferIoVec *vec);
+
 /**
  * Returns the number of extents in the iovec.
  *
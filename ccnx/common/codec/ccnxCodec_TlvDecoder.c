@@ -34,6 +34,8 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
 #include <LongBow/runtime.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Buffer.h>
@@ -41,73 +43,333 @@
 
 #include <ccnx/common/codec/ccnxCodec_TlvDecoder.h>
 
+/**
+ * The number of container decoders that are carved out of the root decoder's allocation.
+ * A V1 packet nests at most 3 deep (packet, message, name), so this covers normal
+ * decoding without touching the allocator.  Beyond this, containers are allocated.
+ */
+#define _CCNxCodecTlvDecoder_PoolSize 8
+
 struct ccnx_codec_tlv_decoder {
-    // we use a read only buffer because we want independent
-    // position and limit from whatever the user gives us.
+    // All offsets are absolute byte offsets in to the root's memory.  'start' is
+    // where this decoder begins, so ccnxCodecTlvDecoder_Position() is (position - start).
+    size_t start;
+    size_t position;
+    size_t limit;
+
+    // Contiguous mode.  The root holds a read only slice of the user's buffer
+    // because we want independent position and limit from whatever the user gives us.
+    // Containers borrow the root's slice.
     PARCBuffer *buffer;
+    const uint8_t *base;
+
+    // Scatter-gather mode (buffer == NULL).  The root holds a reference to vec.
+    CCNxCodecNetworkBufferIoVec *vec;
+    const struct iovec *iov;
+    int iovcnt;
+
+    // Cached cursor: iov[blockIndex] begins at absolute offset blockBegin.
+    // The decoder mostly moves forward, so this makes each seek O(1).
+    int blockIndex;
+    size_t blockBegin;
 
     CCNxCodecError *error;
+
+    // For a container, the decoder it was carved from.  NULL for a root.
+    CCNxCodecTlvDecoder *root;
+
+    // Root only: pool of container decoders.  'outstanding' counts all live containers
+    // (pooled or not).  If the root is destroyed while containers are live, it is
+    // freed when the last container is destroyed.
+    CCNxCodecTlvDecoder *pool;
+    uint32_t poolInUse;
+    unsigned outstanding;
+    bool destroyPending;
 };
 
+// ===========================================================================
+// Scatter-gather primitives
+
+/**
+ * Moves the cached block cursor so iov[blockIndex] contains `offset`.
+ *
+ * @return The number of contiguous bytes available at `offset` in the current block
+ */
+static size_t
+_ioVec_Seek(CCNxCodecTlvDecoder *decoder, size_t offset)
+{
+    while (offset < decoder->blockBegin) {
+        decoder->blockIndex--;
+        decoder->blockBegin -= decoder->iov[decoder->blockIndex].iov_len;
+    }
+
+    while (decoder->blockIndex < decoder->iovcnt &&
+           offset >= decoder->blockBegin + decoder->iov[decoder->blockIndex].iov_len) {
+        decoder->blockBegin += decoder->iov[decoder->blockIndex].iov_len;
+        decoder->blockIndex++;
+    }
+
+    assertTrue(decoder->blockIndex < decoder->iovcnt, "Offset %zu beyond end of iovec", offset);
+    return decoder->blockBegin + decoder->iov[decoder->blockIndex].iov_len - offset;
+}
+
+static inline uint8_t *
+_ioVec_Pointer(const CCNxCodecTlvDecoder *decoder, size_t offset)
+{
+    return (uint8_t *) decoder->iov[decoder->blockIndex].iov_base + (offset - decoder->blockBegin);
+}
+
+/**
+ * Copies `length` bytes starting at absolute `offset` to `output`, crossing block boundaries as needed.
+ */
+static void
+_ioVec_Copy(CCNxCodecTlvDecoder *decoder, size_t offset, size_t length, uint8_t output[length])
+{
+    while (length > 0) {
+        size_t available = _ioVec_Seek(decoder, offset);
+        size_t chunk = (available < length) ? available : length;
+        memcpy(output, _ioVec_Pointer(decoder, offset), chunk);
+        output += chunk;
+        offset += chunk;
+        length -= chunk;
+    }
+}
+
+/**
+ * Returns a pointer to `length` contiguous bytes at the current position.  If the bytes
+ * straddle a block boundary, they are copied to `scratch`.
+ */
+static const uint8_t *
+_ioVec_Peek(CCNxCodecTlvDecoder *decoder, size_t length, uint8_t scratch[length])
+{
+    if (_ioVec_Seek(decoder, decoder->position) >= length) {
+        return _ioVec_Pointer(decoder, decoder->position);
+    }
+    _ioVec_Copy(decoder, decoder->position, length, scratch);
+    return scratch;
+}
+
+/**
+ * Returns a PARCBuffer of the next `length` bytes.  If the bytes are in a single block,
+ * the buffer wraps that memory in place (0-copy), otherwise the bytes are copied to
+ * a new buffer.
+ */
+static PARCBuffer *
+_ioVec_Value(CCNxCodecTlvDecoder *decoder, size_t length)
+{
+    PARCBuffer *value;
+    if (length == 0) {
+        value = parcBuffer_Allocate(0);
+    } else if (_ioVec_Seek(decoder, decoder->position) >= length) {
+        value = parcBuffer_Wrap(_ioVec_Pointer(decoder, decoder->position), length, 0, length);
+    } else {
+        value = parcBuffer_Allocate(length);
+        _ioVec_Copy(decoder, decoder->position, length, parcBuffer_Overlay(value, 0));
+        parcBuffer_Rewind(value);
+    }
+    return value;
+}
+
+// ===========================================================================
+// Mode independent primitives
+
+static inline size_t
+_remaining(const CCNxCodecTlvDecoder *decoder)
+{
+    return decoder->limit - decoder->position;
+}
+
+/**
+ * Reads a `length` byte network byte order integer at the current position and advances.
+ */
+static uint64_t
+_getNetworkInteger(CCNxCodecTlvDecoder *decoder, size_t length)
+{
+    assertTrue(_remaining(decoder) >= length,
+               "Read of %zu bytes with only %zu remaining", length, _remaining(decoder));
+
+    uint8_t scratch[8];
+    const uint8_t *p;
+    if (decoder->buffer) {
+        p = decoder->base + decoder->position;
+    } else {
+        p = _ioVec_Peek(decoder, length, scratch);
+    }
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; i++) {
+        value = value << 8 | p[i];
+    }
+
+    decoder->position += length;
+    return value;
+}
+
+/**
+ * Returns a PARCBuffer of the next `length` bytes and advances.
+ */
+static PARCBuffer *
+_getValue(CCNxCodecTlvDecoder *decoder, size_t length)
+{
+    PARCBuffer *value;
+    if (decoder->buffer) {
+        // The root's slice is private to the decoder, so we can move its limit and
+        // position to make the value in a single slice.
+        parcBuffer_SetLimit(decoder->buffer, decoder->position + length);
+        parcBuffer_SetPosition(decoder->buffer, decoder->position);
+        value = parcBuffer_Slice(decoder->buffer);
+    } else {
+        value = _ioVec_Value(decoder, length);
+    }
+
+    decoder->position += length;
+    return value;
+}
+
+// ===========================================================================
+
+static CCNxCodecTlvDecoder *
+_ccnxCodecTlvDecoder_CreateRoot(void)
+{
+    // The root and its pool of container decoders are a single allocation
+    size_t size = sizeof(CCNxCodecTlvDecoder) * (1 + _CCNxCodecTlvDecoder_PoolSize);
+    CCNxCodecTlvDecoder *decoder = parcMemory_AllocateAndClear(size);
+    assertNotNull(decoder, "parcMemory_AllocateAndClear(%zu) returned NULL", size);
+
+    decoder->pool = decoder + 1;
+    return decoder;
+}
+
 CCNxCodecTlvDecoder *
 ccnxCodecTlvDecoder_Create(PARCBuffer *buffer)
 {
     assertNotNull(buffer, "Parameter buffer must be non-null");
 
-    CCNxCodecTlvDecoder *decoder = parcMemory_AllocateAndClear(sizeof(CCNxCodecTlvDecoder));
-    assertNotNull(decoder, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(CCNxCodecTlvDecoder));
+    CCNxCodecTlvDecoder *decoder = _ccnxCodecTlvDecoder_CreateRoot();
 
     // create a reference but with independent position + limit from what the user gives us
     decoder->buffer = parcBuffer_Slice(buffer);
+    decoder->limit = parcBuffer_Remaining(decoder->buffer);
+    if (decoder->limit > 0) {
+        decoder->base = parcBuffer_Overlay(decoder->buffer, 0);
+    }
 
     return decoder;
 }
 
+CCNxCodecTlvDecoder *
+ccnxCodecTlvDecoder_CreateFromIoVec(CCNxCodecNetworkBufferIoVec *vec)
+{
+    assertNotNull(vec, "Parameter vec must be non-null");
+
+    CCNxCodecTlvDecoder *decoder = _ccnxCodecTlvDecoder_CreateRoot();
+
+    decoder->vec = ccnxCodecNetworkBufferIoVec_Acquire(vec);
+    decoder->iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    decoder->iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
+    decoder->limit = ccnxCodecNetworkBufferIoVec_Length(vec);
+
+    return decoder;
+}
+
+static void
+_ccnxCodecTlvDecoder_FreeRoot(CCNxCodecTlvDecoder *root)
+{
+    if (root->buffer) {
+        parcBuffer_Release(&root->buffer);
+    }
+
+    if (root->vec) {
+        ccnxCodecNetworkBufferIoVec_Release(&root->vec);
+    }
+
+    parcMemory_Deallocate((void **) &root);
+}
+
 void
 ccnxCodecTlvDecoder_Destroy(CCNxCodecTlvDecoder **decoderPtr)
 {
     assertNotNull(decoderPtr, "Parameter must be non-null double pointer");
     assertNotNull(*decoderPtr, "Parameter must dereferecne to non-null pointer");
     CCNxCodecTlvDecoder *decoder = *decoderPtr;
-    parcBuffer_Release(&decoder->buffer);
-
 
     if (decoder->error) {
         ccnxCodecError_Release(&decoder->error);
     }
 
-    parcMemory_Deallocate((void **) &decoder);
+    CCNxCodecTlvDecoder *root = decoder->root;
+    if (root == NULL) {
+        if (decoder->outstanding == 0) {
+            _ccnxCodecTlvDecoder_FreeRoot(decoder);
+        } else {
+            decoder->destroyPending = true;
+        }
+    } else {
+        ptrdiff_t slot = decoder - root->pool;
+        if (slot >= 0 && slot < _CCNxCodecTlvDecoder_PoolSize) {
+            root->poolInUse &= ~(1u << slot);
+        } else {
+            parcMemory_Deallocate((void **) &decoder);
+        }
+
+        root->outstanding--;
+        if (root->destroyPending && root->outstanding == 0) {
+            _ccnxCodecTlvDecoder_FreeRoot(root);
+        }
+    }
+
     *decoderPtr = NULL;
 }
 
+void
+ccnxCodecTlvDecoder_Reset(CCNxCodecTlvDecoder *decoder, PARCBuffer *buffer)
+{
+    assertNotNull(decoder, "Parameter decoder must be non-null");
+    assertNotNull(buffer, "Parameter buffer must be non-null");
+    assertNull(decoder->root, "Only a root decoder may be reset");
+    assertNotNull(decoder->buffer, "Only a decoder created from a PARCBuffer may be reset");
+    assertTrue(decoder->outstanding == 0, "Cannot reset a decoder with %u live containers", decoder->outstanding);
+
+    if (decoder->error) {
+        ccnxCodecError_Release(&decoder->error);
+    }
+    parcBuffer_Release(&decoder->buffer);
+
+    decoder->buffer = parcBuffer_Slice(buffer);
+    decoder->start = 0;
+    decoder->position = 0;
+    decoder->limit = parcBuffer_Remaining(decoder->buffer);
+    decoder->base = (decoder->limit > 0) ? parcBuffer_Overlay(decoder->buffer, 0) : NULL;
+}
+
 bool
 ccnxCodecTlvDecoder_IsEmpty(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return (!parcBuffer_HasRemaining(decoder->buffer));
+    return _remaining(decoder) == 0;
 }
 
 bool
 ccnxCodecTlvDecoder_EnsureRemaining(CCNxCodecTlvDecoder *decoder, size_t bytes)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_Remaining(decoder->buffer) >= bytes;
+    return _remaining(decoder) >= bytes;
 }
 
 size_t
 ccnxCodecTlvDecoder_Remaining(const CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_Remaining(decoder->buffer);
+    return _remaining(decoder);
 }
 
 uint16_t
 ccnxCodecTlvDecoder_PeekType(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    size_t position = parcBuffer_Position(decoder->buffer);
-    uint16_t type = parcBuffer_GetUint16(decoder->buffer);
-    parcBuffer_SetPosition(decoder->buffer, position);
+    size_t position = decoder->position;
+    uint16_t type = (uint16_t) _getNetworkInteger(decoder, 2);
+    decoder->position = position;
     return type;
 }
 
@@ -115,14 +377,14 @@ uint16_t
 ccnxCodecTlvDecoder_GetType(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_GetUint16(decoder->buffer);
+    return (uint16_t) _getNetworkInteger(decoder, 2);
 }
 
 uint16_t
 ccnxCodecTlvDecoder_GetLength(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_GetUint16(decoder->buffer);
+    return (uint16_t) _getNetworkInteger(decoder, 2);
 }
 
 PARCBuffer *
@@ -132,12 +394,28 @@ ccnxCodecTlvDecoder_GetValue(CCNxCodecTlvDecoder *decoder, uint16_t length)
     PARCBuffer *value = NULL;
 
     if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
-        value = parcBuffer_Slice(decoder->buffer);
-        parcBuffer_SetLimit(value, length);
+        value = _getValue(decoder, length);
+    }
+
+    return value;
+}
+
+const uint8_t *
+ccnxCodecTlvDecoder_OverlayValue(CCNxCodecTlvDecoder *decoder, uint16_t length)
+{
+    assertNotNull(decoder, "Parameter decoder must be non-null");
+    const uint8_t *value = NULL;
+
+    if (length > 0 && _remaining(decoder) >= length) {
+        if (decoder->buffer) {
+            value = decoder->base + decoder->position;
+        } else if (_ioVec_Seek(decoder, decoder->position) >= length) {
+            value = _ioVec_Pointer(decoder, decoder->position);
+        }
 
-        size_t position = parcBuffer_Position(decoder->buffer);
-        position += length;
-        parcBuffer_SetPosition(decoder->buffer, position);
+        if (value != NULL) {
+            decoder->position += length;
+        }
     }
 
     return value;
@@ -164,24 +442,52 @@ ccnxCodecTlvDecoder_GetContainer(CCNxCodecTlvDecoder *decoder, uint16_t length)
 {
     CCNxCodecTlvDecoder *innerDecoder = NULL;
     if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
-        PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
-        innerDecoder = ccnxCodecTlvDecoder_Create(value);
-        parcBuffer_Release(&value);
+        CCNxCodecTlvDecoder *root = (decoder->root == NULL) ? decoder : decoder->root;
+
+        // Take a decoder from the root's pool, or allocate one if they are all in use
+        if (root->poolInUse != (1u << _CCNxCodecTlvDecoder_PoolSize) - 1) {
+            int slot = 0;
+            while (root->poolInUse & (1u << slot)) {
+                slot++;
+            }
+            root->poolInUse |= (1u << slot);
+            innerDecoder = &root->pool[slot];
+        } else {
+            innerDecoder = parcMemory_Allocate(sizeof(CCNxCodecTlvDecoder));
+            assertNotNull(innerDecoder, "parcMemory_Allocate(%zu) returned NULL", sizeof(CCNxCodecTlvDecoder));
+        }
+        root->outstanding++;
+
+        // The inner decoder shares the root's memory and block cursor, but
+        // covers only the container's bytes.  Nothing is copied.
+        *innerDecoder = *decoder;
+        innerDecoder->start = decoder->position;
+        innerDecoder->limit = decoder->position + length;
+        innerDecoder->error = NULL;
+        innerDecoder->root = root;
+        innerDecoder->pool = NULL;
+        innerDecoder->poolInUse = 0;
+        innerDecoder->outstanding = 0;
+        innerDecoder->destroyPending = false;
+
+        decoder->position += length;
     }
     return innerDecoder;
 }
 
-bool
-ccnxCodecTlvDecoder_GetUint8(CCNxCodecTlvDecoder *decoder, uint16_t type, uint8_t *output)
+/**
+ * Reads a TLV whose value is a fixed-length network byte order integer.
+ */
+static bool
+_getFixedLengthInteger(CCNxCodecTlvDecoder *decoder, uint16_t type, size_t valueLength, uint64_t *output)
 {
-    const size_t valueLength = 1;
     bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
+    if (_remaining(decoder) >= 4 + valueLength) {
         if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
             // advance the buffer
             (void) ccnxCodecTlvDecoder_GetType(decoder);
             if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint8(decoder->buffer);
+                *output = _getNetworkInteger(decoder, valueLength);
                 success = true;
             }
         }
@@ -189,20 +495,24 @@ ccnxCodecTlvDecoder_GetUint8(CCNxCodecTlvDecoder *decoder, uint16_t type, uint8_
     return success;
 }
 
+bool
+ccnxCodecTlvDecoder_GetUint8(CCNxCodecTlvDecoder *decoder, uint16_t type, uint8_t *output)
+{
+    uint64_t value;
+    bool success = _getFixedLengthInteger(decoder, type, 1, &value);
+    if (success) {
+        *output = (uint8_t) value;
+    }
+    return success;
+}
+
 bool
 ccnxCodecTlvDecoder_GetUint16(CCNxCodecTlvDecoder *decoder, uint16_t type, uint16_t *output)
 {
-    const size_t valueLength = 2;
-    bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
-        if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
-            // advance the buffer
-            (void) ccnxCodecTlvDecoder_GetType(decoder);
-            if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint16(decoder->buffer);
-                success = true;
-            }
-        }
+    uint64_t value;
+    bool success = _getFixedLengthInteger(decoder, type, 2, &value);
+    if (success) {
+        *output = (uint16_t) value;
     }
     return success;
 }
@@ -210,17 +520,10 @@ ccnxCodecTlvDecoder_GetUint16(CCNxCodecTlvDecoder *decoder, uint16_t type, uint1
 bool
 ccnxCodecTlvDecoder_GetUint32(CCNxCodecTlvDecoder *decoder, uint16_t type, uint32_t *output)
 {
-    const size_t valueLength = 4;
-    bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
-        if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
-            // advance the buffer
-            (void) ccnxCodecTlvDecoder_GetType(decoder);
-            if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint32(decoder->buffer);
-                success = true;
-            }
-        }
+    uint64_t value;
+    bool success = _getFixedLengthInteger(decoder, type, 4, &value);
+    if (success) {
+        *output = (uint32_t) value;
     }
     return success;
 }
@@ -228,19 +531,7 @@ ccnxCodecTlvDecoder_GetUint32(CCNxCodecTlvDecoder *decoder, uint16_t type, uint3
 bool
 ccnxCodecTlvDecoder_GetUint64(CCNxCodecTlvDecoder *decoder, uint16_t type, uint64_t *output)
 {
-    const size_t valueLength = 8;
-    bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
-        if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
-            // advance the buffer
-            (void) ccnxCodecTlvDecoder_GetType(decoder);
-            if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint64(decoder->buffer);
-                success = true;
-            }
-        }
-    }
-    return success;
+    return _getFixedLengthInteger(decoder, type, 8, output);
 }
 
 
@@ -248,7 +539,14 @@ size_t
 ccnxCodecTlvDecoder_Position(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_Position(decoder->buffer);
+    return decoder->position - decoder->start;
+}
+
+size_t
+ccnxCodecTlvDecoder_AbsolutePosition(const CCNxCodecTlvDecoder *decoder)
+{
+    assertNotNull(decoder, "Parameter decoder must be non-null");
+    return decoder->position;
 }
 
 bool
@@ -256,10 +554,8 @@ ccnxCodecTlvDecoder_Advance(CCNxCodecTlvDecoder *decoder, uint16_t length)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
     bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= length) {
-        size_t position = parcBuffer_Position(decoder->buffer);
-        position += length;
-        parcBuffer_SetPosition(decoder->buffer, position);
+    if (_remaining(decoder) >= length) {
+        decoder->position += length;
         success = true;
     }
     return success;
@@ -287,7 +583,14 @@ bool
 ccnxCodecTlvDecoder_GetVarInt(CCNxCodecTlvDecoder *decoder, uint16_t length, uint64_t *output)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return ccnxCodecTlvDecoder_BufferToVarInt(decoder->buffer, length, output);
+    assertNotNull(output, "Parameter output must be non-null");
+
+    bool success = false;
+    if (length >= 1 && length <= 8 && _remaining(decoder) >= length) {
+        *output = _getNetworkInteger(decoder, length);
+        success = true;
+    }
+    return success;
 }
 
 bool
@@ -146,7 +146,8 @@ typedef struct ccnx_codec_tlv_decoder CCNxCodecTlvDecoder;
  * Walks through a TLV-encoded buffer returning buffer slices of the
  * original.  These are 0-copy operations.
  *
- * The decoder should be based on the CCNxCodecNetworkBufferIoVec, see case 1009
+ * To decode a scatter-gather list without first linearizing it, use
+ * `ccnxCodecTlvDecoder_CreateFromIoVec()`.
  *
  * @param [in] buffer The buffer to parse, must be ready to read.
  *
@@ -164,6 +165,38 @@ typedef struct ccnx_codec_tlv_decoder CCNxCodecTlvDecoder;
  */
 CCNxCodecTlvDecoder *ccnxCodecTlvDecoder_Create(PARCBuffer *buffer);
 
+/**
+ * Decodes a TLV-encoded scatter-gather list without linearizing it
+ *
+ * Walks the iovec array in place.  A value that lies within a single iovec
+ * is returned as a PARCBuffer wrapping that memory (0-copy).  Only a value that
+ * straddles two or more iovecs is copied.  Containers returned by
+ * `ccnxCodecTlvDecoder_GetContainer()` share the same iovec array.
+ *
+ * The decoder acquires a reference to `vec`.  Buffers returned by the decoder
+ * point in to the memory of `vec`, so the caller must keep `vec` alive for as long
+ * as it uses those buffers (e.g. for the life of the decoded dictionary).
+ *
+ * `ccnxCodecTlvDecoder_Position()` is relative to the start of the vec.
+ *
+ * @param [in] vec The scatter-gather list to parse
+ *
+ * @return non-null A TLV decoder
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+ *      uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+ *      ...
+ *      ccnxCodecTlvDecoder_Destroy(&decoder);
+ *      ccnxCodecNetworkBufferIoVec_Release(&vec);
+ * }
+ * @endcode
+ */
+CCNxCodecTlvDecoder *ccnxCodecTlvDecoder_CreateFromIoVec(CCNxCodecNetworkBufferIoVec *vec);
+
 /**
  * Releases the tlv decoder.
  *
@@ -183,6 +216,36 @@ CCNxCodecTlvDecoder *ccnxCodecTlvDecoder_Create(PARCBuffer *buffer);
  */
 void ccnxCodecTlvDecoder_Destroy(CCNxCodecTlvDecoder **decoderPtr);
 
+/**
+ * Points a root decoder at a new packet buffer, reusing its allocation
+ *
+ * Equivalent to destroying `decoder` and calling `ccnxCodecTlvDecoder_Create(buffer)`,
+ * but without going through the allocator.  This lets a receive loop decode a burst
+ * of packets with a single decoder.  Any error from the previous packet is cleared.
+ *
+ * The decoder must be a root decoder (not a container), it must be in contiguous mode
+ * (created with `ccnxCodecTlvDecoder_Create()`), and all of its containers must have
+ * been destroyed.  Buffers returned before the reset remain valid.
+ *
+ * @param [in] decoder A root decoder
+ * @param [in] buffer The next buffer to parse
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(packets[0]);
+ *      for (size_t i = 0; i < count; i++) {
+ *          if (i > 0) {
+ *              ccnxCodecTlvDecoder_Reset(decoder, packets[i]);
+ *          }
+ *          ...
+ *      }
+ *      ccnxCodecTlvDecoder_Destroy(&decoder);
+ * }
+ * @endcode
+ */
+void ccnxCodecTlvDecoder_Reset(CCNxCodecTlvDecoder *decoder, PARCBuffer *buffer);
+
 /**
  * Tests if there is anything left to decode
  *
@@ -341,6 +404,32 @@ uint16_t ccnxCodecTlvDecoder_GetLength(CCNxCodecTlvDecoder *decoder);
  */
 PARCBuffer *ccnxCodecTlvDecoder_GetValue(CCNxCodecTlvDecoder *decoder, uint16_t length);
 
+/**
+ * Returns a pointer to the next `length` bytes and advances past them, without creating a buffer
+ *
+ * The bytes are not copied.  The pointer is valid as long as the memory the decoder reads from.
+ * For a decoder from ccnxCodecTlvDecoder_CreateFromIoVec() the bytes must be in one block.
+ *
+ * @param [in] decoder The decoder
+ * @param [in] length The number of bytes
+ *
+ * @return non-null A pointer to `length` contiguous bytes
+ * @return null Fewer than `length` bytes remain, `length` is 0, or the bytes span two blocks.  The decoder does not move.
+ *
+ * Example:
+ * @code
+ * {
+ *      PARCBuffer *input = parcBuffer_Wrap((uint8_t[]) {0xAA, 0xBB, 0x00, 0x04, 0x01, 0x02, 0x03, 0x04}, 8, 0, 8);
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(input);
+ *      (void) ccnxCodecTlvDecoder_GetType(decoder);
+ *      unsigned length = ccnxCodecTlvDecoder_GetLength(decoder);
+ *      const uint8_t *value = ccnxCodecTlvDecoder_OverlayValue(decoder, length);
+ *      // value[0] == 0x01
+ * }
+ * @endcode
+ */
+const uint8_t *ccnxCodecTlvDecoder_OverlayValue(CCNxCodecTlvDecoder *decoder, uint16_t length);
+
 /**
  * Ensure the current position is of type `type', then return a buffer of the value
  *
@@ -378,7 +467,13 @@ PARCBuffer *ccnxCodecTlvDecoder_GetBuffer(CCNxCodecTlvDecoder *decoder, uint16_t
  * Returns a TLV decoder that represents the "slice" of the input buffer from
  * the current position up to the current position plus `length'.
  *
- * @param [<#in out in,out#>] <#name#> <#description#>
+ * The sub-decoder shares the memory of the top-level decoder and normally comes from
+ * a small pool allocated with it, so it does not copy the container or call the allocator.
+ * Decoders may be destroyed in any order; the top-level decoder's memory is freed
+ * once it and all its sub-decoders are destroyed.
+ *
+ * @param [in] decoder An allocated CCNxCodecTlvDecoder
+ * @param [in] length The length of the container's value
  *
  * @return non-null A new sub-decoder
  * @return null An error, such as input underrun
@@ -548,6 +643,32 @@ bool ccnxCodecTlvDecoder_GetUint64(CCNxCodecTlvDecoder *decoder, uint16_t type,
  */
 size_t ccnxCodecTlvDecoder_Position(CCNxCodecTlvDecoder *decoder);
 
+/**
+ * Returns the current byte position relative to the start of the top-level decoder
+ *
+ * For a decoder from ccnxCodecTlvDecoder_Create() this is the same as
+ * ccnxCodecTlvDecoder_Position().  For a container from ccnxCodecTlvDecoder_GetContainer()
+ * it is the position in the packet, not in the container.
+ *
+ * @param [in] decoder An allocated CCNxCodecTlvDecoder
+ *
+ * @return number The byte offset from the start of the top-level decoder
+ *
+ * Example:
+ * @code
+ * {
+ *      PARCBuffer *buffer = parcBuffer_Wrap((uint8_t[]) { 0x00, 0x01, 0x00, 0x02, 0xAA, 0xBB }, 6, 0, 6);
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+ *      (void) ccnxCodecTlvDecoder_GetType(decoder);
+ *      uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+ *      CCNxCodecTlvDecoder *inner = ccnxCodecTlvDecoder_GetContainer(decoder, length);
+ *      // ccnxCodecTlvDecoder_Position(inner) == 0
+ *      // ccnxCodecTlvDecoder_AbsolutePosition(inner) == 4
+ * }
+ * @endcode
+ */
+size_t ccnxCodecTlvDecoder_AbsolutePosition(const CCNxCodecTlvDecoder *decoder);
+
 /**
  * Advance the decoder a given number of bytes
  *
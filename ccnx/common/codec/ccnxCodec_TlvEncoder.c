@@ -59,19 +59,31 @@ struct ccnx_codec_tlv_encoder {
     PARCSigner *signer;
 };
 
-CCNxCodecTlvEncoder *
-ccnxCodecTlvEncoder_Create(void)
+static CCNxCodecTlvEncoder *
+_ccnxCodecTlvEncoder_Create(CCNxCodecNetworkBuffer *buffer)
 {
     CCNxCodecTlvEncoder *encoder = parcMemory_AllocateAndClear(sizeof(CCNxCodecTlvEncoder));
     assertNotNull(encoder, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(CCNxCodecTlvEncoder));
 
-    encoder->buffer = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+    encoder->buffer = buffer;
     encoder->signatureStartEndSet = NONE_SET;
     encoder->error = NULL;
 
     return encoder;
 }
 
+CCNxCodecTlvEncoder *
+ccnxCodecTlvEncoder_Create(void)
+{
+    return _ccnxCodecTlvEncoder_Create(ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL));
+}
+
+CCNxCodecTlvEncoder *
+ccnxCodecTlvEncoder_CreateWithCapacity(size_t capacity)
+{
+    return _ccnxCodecTlvEncoder_Create(ccnxCodecNetworkBuffer_CreateWithCapacity(&ParcMemoryMemoryBlock, NULL, capacity));
+}
+
 void
 ccnxCodecTlvEncoder_Destroy(CCNxCodecTlvEncoder **encoderPtr)
 {
@@ -114,6 +126,20 @@ ccnxCodecTlvEncoder_AppendBuffer(CCNxCodecTlvEncoder *encoder, uint16_t type, PA
     return bytes;
 }
 
+size_t
+ccnxCodecTlvEncoder_AppendBufferReference(CCNxCodecTlvEncoder *encoder, uint16_t type, PARCBuffer *value)
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    assertTrue(parcBuffer_Remaining(value) <= UINT16_MAX, "Value length too long, got %zu maximum %u\n", parcBuffer_Remaining(value), UINT16_MAX);
+
+    size_t bytes = 4 + parcBuffer_Remaining(value);
+    ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
+    ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, parcBuffer_Remaining(value));
+    ccnxCodecNetworkBuffer_PutBufferReference(encoder->buffer, value);
+
+    return bytes;
+}
+
 size_t
 ccnxCodecTlvEncoder_AppendArray(CCNxCodecTlvEncoder *encoder, uint16_t type, uint16_t length, const uint8_t array[length])
 {
@@ -197,6 +223,12 @@ _ccnxCodecTlvEncoder_ComputeVarIntLength(uint64_t value)
     return length;
 }
 
+unsigned
+ccnxCodecTlvEncoder_ComputeVarIntLength(uint64_t value)
+{
+    return _ccnxCodecTlvEncoder_ComputeVarIntLength(value);
+}
+
 size_t
 ccnxCodecTlvEncoder_AppendVarInt(CCNxCodecTlvEncoder *encoder, uint16_t type, uint64_t value)
 {
@@ -279,6 +311,13 @@ ccnxCodecTlvEncoder_CreateIoVec(CCNxCodecTlvEncoder *encoder)
     return ccnxCodecNetworkBuffer_CreateIoVec(encoder->buffer);
 }
 
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecTlvEncoder_CreateIoVecRanges(CCNxCodecTlvEncoder *encoder, size_t count, const size_t ends[count], size_t firstIndex[count + 1])
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    return ccnxCodecNetworkBuffer_CreateIoVecRanges(encoder->buffer, count, ends, firstIndex);
+}
+
 size_t
 ccnxCodecTlvEncoder_AppendRawArray(CCNxCodecTlvEncoder *encoder, size_t length, uint8_t array[length])
 {
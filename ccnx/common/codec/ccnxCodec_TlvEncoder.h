@@ -122,6 +122,32 @@ typedef struct ccnx_codec_tlv_encoder CCNxCodecTlvEncoder;
  */
 CCNxCodecTlvEncoder *ccnxCodecTlvEncoder_Create(void);
 
+/**
+ * Creates a TLV encoder whose output buffer starts with `capacity` bytes
+ *
+ * Use this when the encoded length is known in advance, for example from
+ * ccnxCodecSchemaV1PacketEncoder_GetEncodedLength().  If exactly `capacity` bytes
+ * are written, the encoding lies in one contiguous memory block and
+ * ccnxCodecTlvEncoder_CreateIoVec() returns a single iovec.
+ *
+ * @param [in] capacity The initial buffer size in bytes, must be positive
+ *
+ * @return non-null A TLV encoder
+ *
+ * Example:
+ * @code
+ * {
+ *      ssize_t length = ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(packetDictionary, NULL);
+ *      CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_CreateWithCapacity(length);
+ *      ccnxCodecSchemaV1PacketEncoder_Encode(encoder, packetDictionary);
+ *      ccnxCodecTlvEncoder_Finalize(encoder);
+ *      CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+ *      ccnxCodecTlvEncoder_Destroy(&encoder);
+ * }
+ * @endcode
+ */
+CCNxCodecTlvEncoder *ccnxCodecTlvEncoder_CreateWithCapacity(size_t capacity);
+
 /**
  * Destroys the TLV encoder and all internal state
  *
@@ -187,6 +213,35 @@ CCNxCodecTlvEncoder *ccnxCodecTlvEncoder_Initialize(CCNxCodecTlvEncoder *encoder
  */
 size_t ccnxCodecTlvEncoder_AppendBuffer(CCNxCodecTlvEncoder *encoder, uint16_t type, PARCBuffer *value);
 
+/**
+ * Appends a TL container and a PARCBuffer by reference
+ *
+ * Like ccnxCodecTlvEncoder_AppendBuffer(), but the value is not copied.  The encoder keeps a reference
+ * to `value` and the iovec from ccnxCodecTlvEncoder_CreateIoVec() points at its memory.  The caller
+ * must not modify the bytes of `value` until the encoder and the iovec have been released.
+ *
+ * The encoder must be positioned at its end (i.e. not re-writing earlier bytes).
+ *
+ * @param [in] encoder The encoder to append to
+ * @param [in] type    The TLV type
+ * @param [in] value   The length is the remaining buffer size
+ *
+ * @return number The total bytes of the TLV, including the T and L.
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+ *      ccnxCodecTlvEncoder_Initialize(encoder);
+ *      ccnxCodecTlvEncoder_AppendBufferReference(encoder, 1, payload);
+ *      ccnxCodecTlvEncoder_Finalize(encoder);
+ *      CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+ *      ccnxCodecTlvEncoder_Destroy(&encoder);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecTlvEncoder_AppendBufferReference(CCNxCodecTlvEncoder *encoder, uint16_t type, PARCBuffer *value);
+
 /**
  * Appends a "TL" container then the bytes of the array
  *
@@ -505,6 +560,38 @@ PARCBuffer *ccnxCodecTlvEncoder_CreateBuffer(CCNxCodecTlvEncoder *encoder);
  */
 CCNxCodecNetworkBufferIoVec *ccnxCodecTlvEncoder_CreateIoVec(CCNxCodecTlvEncoder *encoder);
 
+/**
+ * Creates a vectored I/O representation of consecutive byte ranges of the encoder
+ *
+ * Used when several packets are encoded back to back in one encoder.  `ends[i]` is the
+ * encoder position after packet `i`, and the iovec elements of packet `i` are
+ * `array[firstIndex[i]]` through `array[firstIndex[i + 1] - 1]`.
+ * See ccnxCodecNetworkBuffer_CreateIoVecRanges().
+ *
+ * @param [in] encoder An allocated CCNxCodecTlvEncoder
+ * @param [in] count The number of ranges
+ * @param [in] ends The end position of each range
+ * @param [out] firstIndex Array of `count + 1` elements, the first iovec element of each range
+ *
+ * @return non-null An allocated CCNxCodecNetworkBufferIoVec, use CCNxCodecNetworkBufferIoVec_Release() on it
+ *
+ * Example:
+ * @code
+ * {
+ *      size_t ends[2];
+ *      size_t firstIndex[3];
+ *      ccnxCodecTlvEncoder_AppendBuffer(encoder, 1, first);
+ *      ends[0] = ccnxCodecTlvEncoder_Position(encoder);
+ *      ccnxCodecTlvEncoder_AppendBuffer(encoder, 1, second);
+ *      ends[1] = ccnxCodecTlvEncoder_Position(encoder);
+ *      ccnxCodecTlvEncoder_Finalize(encoder);
+ *      CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvEncoder_CreateIoVecRanges(encoder, 2, ends, firstIndex);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecTlvEncoder_CreateIoVecRanges(CCNxCodecTlvEncoder *encoder, size_t count,
+                                                                   const size_t ends[count], size_t firstIndex[count + 1]);
+
 /**
  * Marks the current position as the start of the signature
  *
@@ -765,4 +852,23 @@ PARCSigner *ccnxCodecTlvEncoder_GetSigner(const CCNxCodecTlvEncoder *encoder);
  */
 size_t ccnxCodecTlvEncoder_AppendVarInt(CCNxCodecTlvEncoder *encoder, uint16_t type, uint64_t value);
 
+/**
+ * Returns the number of value bytes ccnxCodecTlvEncoder_AppendVarInt() uses for `value`
+ *
+ * The total TLV length appended is 4 more than this, for the T and L.
+ *
+ * @param [in] value The value of the varint
+ *
+ * @return number Between 1 and 8
+ *
+ * Example:
+ * @code
+ * {
+ *      unsigned length = ccnxCodecTlvEncoder_ComputeVarIntLength(0x0000000000102300);
+ *      // length = 3
+ * }
+ * @endcode
+ */
+unsigned ccnxCodecTlvEncoder_ComputeVarIntLength(uint64_t value);
+
 #endif // libccnx_ccnx_TlvEncoder_h
@@ -32,6 +32,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <LongBow/runtime.h>
+#include <parc/algol/parc_Memory.h>
 #include <arpa/inet.h>
 #include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
@@ -42,12 +43,10 @@
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
 
 static CCNxTlvDictionary *
-_decodeV1(PARCBuffer *packetBuffer)
+_createV1Dictionary(CCNxCodecSchemaV1Types_PacketType packetType)
 {
     CCNxTlvDictionary *packetDictionary = NULL;
 
-    CCNxCodecSchemaV1Types_PacketType packetType = (CCNxCodecSchemaV1Types_PacketType) parcBuffer_GetAtIndex(packetBuffer, 1);
-
     switch (packetType) {
         case CCNxCodecSchemaV1Types_PacketType_Interest:
             packetDictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
@@ -69,8 +68,22 @@ _decodeV1(PARCBuffer *packetBuffer)
             // unknown type
             break;
     }
+    return packetDictionary;
+}
 
+static CCNxTlvDictionary *
+_decodeV1Packet(PARCBuffer *packetBuffer, bool lazy)
+{
+    CCNxCodecSchemaV1Types_PacketType packetType = (CCNxCodecSchemaV1Types_PacketType) parcBuffer_GetAtIndex(packetBuffer, 1);
+
+    CCNxTlvDictionary *packetDictionary = _createV1Dictionary(packetType);
     if (packetDictionary) {
+        if (lazy) {
+            // The decoder and the lazy source both start at the current position of
+            // packetBuffer, so decoder positions are offsets in the lazy source.
+            ccnxTlvDictionary_SetLazySource(packetDictionary, packetBuffer);
+        }
+
         bool success = ccnxCodecSchemaV1PacketDecoder_BufferDecode(packetBuffer, packetDictionary);
         if (!success) {
             ccnxTlvDictionary_Release(&packetDictionary);
@@ -79,12 +92,24 @@ _decodeV1(PARCBuffer *packetBuffer)
     return packetDictionary;
 }
 
+static CCNxTlvDictionary *
+_decodeV1(PARCBuffer *packetBuffer)
+{
+    return _decodeV1Packet(packetBuffer, false);
+}
+
 CCNxTlvDictionary *
 ccnxCodecTlvPacket_Decode(PARCBuffer *packetBuffer)
 {
     return   _decodeV1(packetBuffer);
 }
 
+CCNxTlvDictionary *
+ccnxCodecTlvPacket_LazyDecode(PARCBuffer *packetBuffer)
+{
+    return _decodeV1Packet(packetBuffer, true);
+}
+
 bool
 ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary)
 {
@@ -107,8 +132,77 @@ ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *pac
 }
 
 /*
- * We don't have an iovec based decoder yet, so linearize the memory and use a PARCBuffer
- * See case 903.
+ * Hints the cache to load the fixed header of the packet we will decode next.
+ */
+static inline void
+_prefetchHeader(PARCBuffer *packetBuffer)
+{
+#if defined(__GNUC__)
+    if (packetBuffer != NULL && parcBuffer_Remaining(packetBuffer) > 0) {
+        __builtin_prefetch(parcBuffer_Overlay(packetBuffer, 0));
+    }
+#endif
+}
+
+/*
+ * One root decoder is reset for each packet in the burst, so the decoder and its
+ * container pool are allocated once.  A packet that is not a well formed V1 packet
+ * gets a NULL entry in `out`; the other packets are still decoded.
+ */
+size_t
+ccnxCodecTlvPacket_DecodeBatch(PARCBuffer *packets[], size_t count, CCNxTlvDictionary *out[])
+{
+    assertTrue(count == 0 || packets != NULL, "Parameter packets must be non-null");
+    assertTrue(count == 0 || out != NULL, "Parameter out must be non-null");
+
+    CCNxCodecTlvDecoder *decoder = NULL;
+    size_t decoded = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + 1 < count) {
+            _prefetchHeader(packets[i + 1]);
+        }
+
+        out[i] = NULL;
+
+        PARCBuffer *packetBuffer = packets[i];
+        if (packetBuffer == NULL || parcBuffer_Remaining(packetBuffer) < sizeof(CCNxCodecSchemaV1FixedHeader)) {
+            continue;
+        }
+
+        const uint8_t *header = parcBuffer_Overlay(packetBuffer, 0);
+        if (header[0] != CCNxTlvDictionary_SchemaVersion_V1) {
+            continue;
+        }
+
+        CCNxTlvDictionary *packetDictionary = _createV1Dictionary((CCNxCodecSchemaV1Types_PacketType) header[1]);
+        if (packetDictionary == NULL) {
+            continue;
+        }
+
+        if (decoder == NULL) {
+            decoder = ccnxCodecTlvDecoder_Create(packetBuffer);
+        } else {
+            ccnxCodecTlvDecoder_Reset(decoder, packetBuffer);
+        }
+
+        if (ccnxCodecSchemaV1PacketDecoder_Decode(decoder, packetDictionary)) {
+            out[i] = packetDictionary;
+            decoded++;
+        } else {
+            ccnxTlvDictionary_Release(&packetDictionary);
+        }
+    }
+
+    if (decoder) {
+        ccnxCodecTlvDecoder_Destroy(&decoder);
+    }
+    return decoded;
+}
+
+/*
+ * Decodes directly from the scatter-gather list.  Values that fall inside one iovec
+ * are wrapped in place, so the caller must keep the vec alive as long as the dictionary.
  */
 bool
 ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDictionary *packetDictionary)
@@ -116,28 +210,31 @@ ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDictiona
     size_t iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
     const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
 
-    PARCBuffer *buffer = NULL;
-    if (iovcnt == 1) {
-        buffer = parcBuffer_Wrap(array[0].iov_base, array[0].iov_len, 0, array[0].iov_len);
-    } else if (iovcnt > 1) {
-        // figure out total size, then linearize it
-        size_t totalbytes = 0;
-        for (int i = 0; i < iovcnt; i++) {
-            totalbytes += array[i].iov_len;
-        }
+    if (iovcnt == 0 || ccnxCodecNetworkBufferIoVec_Length(vec) == 0) {
+        return false;
+    }
 
-        buffer = parcBuffer_Allocate(totalbytes);
-        for (int i = 0; i < iovcnt; i++) {
-            parcBuffer_PutArray(buffer, array[i].iov_len, array[i].iov_base);
+    // Determine the version from the first byte of the packet.  Skip over any
+    // leading empty iovecs.
+    size_t index = 0;
+    while (array[index].iov_len == 0) {
+        index++;
+    }
+    uint8_t version = ((const uint8_t *) array[index].iov_base)[0];
+
+    bool success = false;
+    switch (version) {
+        case CCNxTlvDictionary_SchemaVersion_V1: {
+            CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+            success = ccnxCodecSchemaV1PacketDecoder_Decode(decoder, packetDictionary);
+            ccnxCodecTlvDecoder_Destroy(&decoder);
+            break;
         }
 
-        parcBuffer_Flip(buffer);
-    } else {
-        return false;
+        default:
+            // will return false
+            break;
     }
-
-    bool success = ccnxCodecTlvPacket_BufferDecode(buffer, packetDictionary);
-    parcBuffer_Release(&buffer);
     return success;
 }
 
@@ -159,6 +256,46 @@ ccnxCodecTlvPacket_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSig
     return iovec;
 }
 
+ssize_t
+ccnxCodecTlvPacket_GetEncodedLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
+{
+    CCNxTlvDictionary_SchemaVersion version = ccnxTlvDictionary_GetSchemaVersion(packetDictionary);
+
+    ssize_t length = -1;
+    switch (version) {
+        case CCNxTlvDictionary_SchemaVersion_V1:
+            length = ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(packetDictionary, signer);
+            break;
+
+        default:
+            // will return -1
+            break;
+    }
+    return length;
+}
+
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecTlvPacket_EncodeBatch(CCNxTlvDictionary *packetDictionaries[], size_t count, PARCSigner *signer, struct msghdr *messages[])
+{
+    assertTrue(count == 0 || messages != NULL, "Parameter messages must be non-null");
+
+    size_t *firstIndex = parcMemory_Allocate(sizeof(size_t) * (count + 1));
+    assertNotNull(firstIndex, "parcMemory_Allocate(%zu) returned NULL", sizeof(size_t) * (count + 1));
+
+    // V1 is the only schema, the batch encoder skips any other version
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_BatchEncode(packetDictionaries, count, signer, firstIndex);
+
+    struct iovec *array = (struct iovec *) ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    for (size_t i = 0; i < count; i++) {
+        size_t iovlen = firstIndex[i + 1] - firstIndex[i];
+        messages[i]->msg_iov = (iovlen > 0) ? &array[firstIndex[i]] : NULL;
+        messages[i]->msg_iovlen = iovlen;
+    }
+
+    parcMemory_Deallocate((void **) &firstIndex);
+    return vec;
+}
+
 size_t
 ccnxCodecTlvPacket_GetPacketLength(PARCBuffer *packetBuffer)
 {
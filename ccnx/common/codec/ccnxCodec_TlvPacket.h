@@ -37,6 +37,8 @@
 #ifndef TransportRTA_rta_TlvPacketDecoder_h
 #define TransportRTA_rta_TlvPacketDecoder_h
 
+#include <sys/socket.h>
+
 #include <parc/algol/parc_Buffer.h>
 #include <parc/security/parc_Signer.h>
 
@@ -62,6 +64,34 @@
  */
 CCNxTlvDictionary *ccnxCodecTlvPacket_Decode(PARCBuffer *packetBuffer);
 
+/**
+ * Decodes a packet in to a dictionary, deferring the creation of opaque values
+ *
+ * Walks the whole packet and checks it the same as ccnxCodecTlvPacket_Decode(), but fields that
+ * are stored as a PARCBuffer (payload, KeyId and hash restrictions, validation fields, signature,
+ * optional headers and unknown TLVs) are only recorded as an offset and length.  The PARCBuffer
+ * is created the first time it is read from the dictionary.  The name and integer fields are
+ * decoded as usual.
+ *
+ * The dictionary holds a reference to the packet memory, the same as with ccnxCodecTlvPacket_Decode().
+ *
+ * @param [in] packetBuffer The wire format representation of a packet
+ *
+ * @retval non-null An allocated dictionary
+ * @retval null An error
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *interest = ccnxCodecTlvPacket_LazyDecode(packetBuffer);
+ *     CCNxName *name = ccnxInterest_GetName(interest);
+ *     // The payload is only sliced out of packetBuffer if ccnxInterest_GetPayload() is called
+ *     ccnxTlvDictionary_Release(&interest);
+ * }
+ * @endcode
+ */
+CCNxTlvDictionary *ccnxCodecTlvPacket_LazyDecode(PARCBuffer *packetBuffer);
+
 /**
  * <#One Line Description#>
  *
@@ -79,17 +109,62 @@ CCNxTlvDictionary *ccnxCodecTlvPacket_Decode(PARCBuffer *packetBuffer);
 bool ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary);
 
 /**
- * <#One Line Description#>
+ * Decodes a burst of packets, such as those returned by one `recvmmsg()` call
  *
- * <#Paragraphs Of Explanation#>
+ * Produces the same dictionaries as calling ccnxCodecTlvPacket_Decode() on each packet,
+ * but amortizes the decoder setup over the whole burst and prefetches the header of
+ * the next packet while decoding the current one.
  *
- * @param [<#in out in,out#>] <#name#> <#description#>
+ * Each buffer must point to byte 0 of a FixedHeader.  `out[i]` is set to the decoded
+ * dictionary for `packets[i]`, or NULL if that packet is NULL, too short, not a V1 packet,
+ * or does not decode.  A bad packet does not stop the rest of the burst.  The caller
+ * must release each non-null entry of `out`.
  *
- * @retval <#value#> <#explanation#>
+ * @param [in] packets An array of `count` wire format packets
+ * @param [in] count The number of packets
+ * @param [out] out An array of `count` dictionary pointers
+ *
+ * @return The number of packets that decoded successfully
  *
  * Example:
  * @code
- * <#example#>
+ * {
+ *     CCNxTlvDictionary *dictionaries[count];
+ *     ccnxCodecTlvPacket_DecodeBatch(packets, count, dictionaries);
+ *     for (size_t i = 0; i < count; i++) {
+ *         if (dictionaries[i]) {
+ *             ...
+ *             ccnxTlvDictionary_Release(&dictionaries[i]);
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+size_t ccnxCodecTlvPacket_DecodeBatch(PARCBuffer *packets[], size_t count, CCNxTlvDictionary *out[]);
+
+/**
+ * Decodes a packet held in a scatter-gather list
+ *
+ * The packet is decoded in place, without first copying it to a contiguous buffer.
+ * Values that lie within a single iovec are wrapped, not copied, so `vec` must remain
+ * valid for as long as `packetDictionary` is in use.  Only values that straddle an
+ * iovec boundary are copied.
+ *
+ * @param [in] vec The wire format packet
+ * @param [in] packetDictionary The dictionary to decode in to
+ *
+ * @retval true The packet decoded successfully
+ * @retval false A decoding error or unsupported version
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+ *      bool success = ccnxCodecTlvPacket_IoVecDecode(vec, dictionary);
+ *      ...
+ *      ccnxTlvDictionary_Release(&dictionary);
+ *      ccnxCodecNetworkBufferIoVec_Release(&vec);
+ * }
  * @endcode
  */
 bool ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDictionary *packetDictionary);
@@ -120,6 +195,73 @@ bool ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDic
  */
 CCNxCodecNetworkBufferIoVec *ccnxCodecTlvPacket_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
 
+/**
+ * Computes the exact wire format length ccnxCodecTlvPacket_DictionaryEncode() will produce
+ *
+ * Nothing is encoded, so this is a cheap way for a caller to preallocate a send buffer.
+ * If the dictionary has no validation payload and `signer` would compute a signature,
+ * the length is only known when the signer's signatures have a fixed length.
+ *
+ * @param [in] packetDictionary The dictionary representation of the packet to encode
+ * @param [in] signer The signer that will be passed to ccnxCodecTlvPacket_DictionaryEncode(), may be NULL
+ *
+ * @retval positive The number of bytes in the encoded packet
+ * @retval -1 Unknown schema, the packet cannot be encoded, or the signature length is not known before signing
+ *
+ * Example:
+ * @code
+ * {
+ *      ssize_t length = ccnxCodecTlvPacket_GetEncodedLength(dictionary, NULL);
+ *      if (length > 0 && length <= mtu) {
+ *          CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_DictionaryEncode(dictionary, NULL);
+ *          ...
+ *      }
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecTlvPacket_GetEncodedLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
+
+/**
+ * Encode several packet dictionaries in to one set of iovecs ready for `sendmmsg()`
+ *
+ * All packets are encoded with one encoder in to one chain of memory blocks, which saves the
+ * per-packet encoder and buffer setup of ccnxCodecTlvPacket_DictionaryEncode().  The `msg_iov`
+ * and `msg_iovlen` of `*messages[i]` are set to the wire format of `packetDictionaries[i]`; the
+ * other fields (e.g. `msg_name` for an unconnected socket) are left for the caller.
+ * On Linux, point `messages[i]` at `&mmsg[i].msg_hdr` of a `struct mmsghdr` array and pass that
+ * array straight to `sendmmsg()`.
+ *
+ * A dictionary that is not schema V1 or fails to encode gets `msg_iovlen` 0 and a NULL `msg_iov`.
+ *
+ * The iovecs point in to the returned IoVec, so it must not be released until the
+ * messages have been sent.
+ *
+ * @param [in] packetDictionaries An array of `count` dictionaries to encode
+ * @param [in] count The number of dictionaries
+ * @param [in] signer If not NULL will be used to sign each packet that does not carry its own validation
+ * @param [in] messages An array of `count` pointers to the message headers to fill in
+ *
+ * @return non-null The IoVec that owns the wire format of all the packets
+ *
+ * Example:
+ * @code
+ * {
+ *     struct mmsghdr mmsg[count];
+ *     struct msghdr *messages[count];
+ *     memset(mmsg, 0, sizeof(mmsg));
+ *     for (size_t i = 0; i < count; i++) {
+ *         messages[i] = &mmsg[i].msg_hdr;
+ *     }
+ *
+ *     CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_EncodeBatch(contentObjects, count, NULL, messages);
+ *     sendmmsg(fd, mmsg, count, 0);
+ *     ccnxCodecNetworkBufferIoVec_Release(&vec);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecTlvPacket_EncodeBatch(CCNxTlvDictionary *packetDictionaries[], size_t count, PARCSigner *signer,
+                                                            struct msghdr *messages[]);
+
 /**
  * Return the length of the wire format packet based on information in the header
  *
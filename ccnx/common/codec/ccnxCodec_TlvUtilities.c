@@ -84,15 +84,26 @@ bool
 ccnxCodecTlvUtilities_PutAsName(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary, uint16_t type, uint16_t length, int arrayKey)
 {
     bool success = false;
-        CCNxName *name = ccnxCodecSchemaV1NameCodec_DecodeValue(decoder, length);
+    CCNxName *name = ccnxCodecSchemaV1NameCodec_DecodeValue(decoder, length);
+    if (name != NULL) {
         success = ccnxTlvDictionary_PutName(packetDictionary, arrayKey, name);
         ccnxName_Release(&name);
+    }
     return success;
 }
 
 bool
 ccnxCodecTlvUtilities_PutAsBuffer(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary, uint16_t type, uint16_t length, int arrayKey)
 {
+    if (ccnxTlvDictionary_IsLazy(packetDictionary)) {
+        // Only record where the value is, the dictionary slices it if someone asks
+        size_t offset = ccnxCodecTlvDecoder_AbsolutePosition(decoder);
+        if (ccnxCodecTlvDecoder_Advance(decoder, length)) {
+            return ccnxTlvDictionary_PutLazyBuffer(packetDictionary, arrayKey, offset, length);
+        }
+        return false;
+    }
+
     PARCBuffer *buffer = ccnxCodecTlvDecoder_GetValue(decoder, length);
     bool success = ccnxTlvDictionary_PutBuffer(packetDictionary, arrayKey, buffer);
     parcBuffer_Release(&buffer);
@@ -102,6 +113,14 @@ ccnxCodecTlvUtilities_PutAsBuffer(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionar
 bool
 ccnxCodecTlvUtilities_PutAsListBuffer(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary, uint16_t type, uint16_t length, int listKey)
 {
+    if (ccnxTlvDictionary_IsLazy(packetDictionary)) {
+        size_t offset = ccnxCodecTlvDecoder_AbsolutePosition(decoder);
+        if (ccnxCodecTlvDecoder_Advance(decoder, length)) {
+            return ccnxTlvDictionary_PutLazyListBuffer(packetDictionary, listKey, type, offset, length);
+        }
+        return false;
+    }
+
     PARCBuffer *buffer = ccnxCodecTlvDecoder_GetValue(decoder, length);
     bool success = ccnxTlvDictionary_PutListBuffer(packetDictionary, listKey, type, buffer);
     parcBuffer_Release(&buffer);
@@ -154,6 +173,26 @@ ccnxCodecTlvUtilities_EncodeCustomList(CCNxCodecTlvEncoder *encoder, CCNxTlvDict
     return length;
 }
 
+ssize_t
+ccnxCodecTlvUtilities_GetCustomListLength(CCNxTlvDictionary *packetDictionary, int listKey)
+{
+    ssize_t length = 0;
+
+    size_t size = ccnxTlvDictionary_ListSize(packetDictionary, listKey);
+    for (int i = 0; i < size; i++) {
+        PARCBuffer *buffer;
+        uint32_t key;
+
+        if (!ccnxTlvDictionary_ListGetByPosition(packetDictionary, listKey, i, &buffer, &key)) {
+            return -1;
+        }
+
+        length += 4 + parcBuffer_Remaining(buffer);
+    }
+
+    return length;
+}
+
 bool
 ccnxCodecTlvUtilities_GetVarInt(PARCBuffer *input, size_t length, uint64_t *output)
 {
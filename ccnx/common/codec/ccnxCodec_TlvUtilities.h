@@ -166,6 +166,9 @@ ccnxCodecTlvUtilities_DecodeSubcontainer(CCNxCodecTlvDecoder *decoder, CCNxTlvDi
  * Reads the next 'length' bytes from the decoder and wraps it in a PARCBuffer.  The buffer is saved in the packetDictionary
  * under the key 'arrayKey'.
  *
+ * If the dictionary is lazy (see ccnxTlvDictionary_SetLazySource()), only the position of the value
+ * is saved and the PARCBuffer is created when the dictionary entry is first read.
+ *
  * It is an error if there are not 'length' bytes remaining in the decoder.
  *
  * @param [in] decoder The input to read
@@ -285,7 +288,8 @@ ccnxCodecTlvUtilities_PutAsName(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary
  * Reads 'length' bytes from the decoder and appends a PARCBuffer to a list in packetDictionary
  *
  * Saves a buffer as part of a List in the packet dictionary.  This is primarily used for unknown TLV types that
- * do not have a specific decoder.
+ * do not have a specific decoder.  As with ccnxCodecTlvUtilities_PutAsBuffer(), a lazy dictionary
+ * only saves the position of the value.
  *
  * @param [in] decoder The decoder to read
  * @param [in] packetDictionary The dictionary to append the buffer in
@@ -381,6 +385,28 @@ ccnxCodecTlvUtilities_NestedEncode(CCNxCodecTlvEncoder *outerEncoder, CCNxTlvDic
 ssize_t
 ccnxCodecTlvUtilities_EncodeCustomList(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary, int listKey);
 
+/**
+ * Returns the bytes ccnxCodecTlvUtilities_EncodeCustomList() would append for 'listKey'
+ *
+ * Each list entry is a TLV with a 4 byte T and L, so this is 4 plus the remaining
+ * bytes of each entry.
+ *
+ * @param [in] packetDictionary The dictionary to read from
+ * @param [in] listKey The list key to read from packetDictionary
+ *
+ * @return non-negative The encoded length of the list, 0 if it is empty
+ * @return -1 An entry could not be read
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecTlvUtilities_GetCustomListLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_Lists_HEADERS);
+ * }
+ * @endcode
+ */
+ssize_t
+ccnxCodecTlvUtilities_GetCustomListLength(CCNxTlvDictionary *packetDictionary, int listKey);
+
 
 /**
  * Parses the input buffer as a VarInt
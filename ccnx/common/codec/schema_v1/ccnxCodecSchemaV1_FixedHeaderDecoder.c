@@ -33,6 +33,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <LongBow/runtime.h>
 
@@ -56,22 +57,46 @@ static const int _fixedHeader_HeaderLengthOffset = 7;
 bool
 ccnxCodecSchemaV1FixedHeaderDecoder_Decode(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary)
 {
-    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, _fixedHeaderBytes)) {
-        PARCBuffer *buffer = ccnxCodecTlvDecoder_GetValue(decoder, _fixedHeaderBytes);
-        bool success = ccnxTlvDictionary_PutBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_FixedHeader, buffer);
+    CCNxCodecSchemaV1FixedHeader header;
+    return ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader(decoder, packetDictionary, &header);
+}
 
-        // validation
-        parcBuffer_SetPosition(buffer, _fixedHeader_VersionOffset);
-        uint8_t version = parcBuffer_GetUint8(buffer);
+bool
+ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary,
+                                                 CCNxCodecSchemaV1FixedHeader *header)
+{
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, _fixedHeaderBytes)) {
+        bool success = false;
+        PARCBuffer *buffer = NULL;
+        const uint8_t *bytes = NULL;
+
+        if (ccnxTlvDictionary_IsLazy(packetDictionary)) {
+            // Only record where the header is, the dictionary slices it if someone asks
+            size_t offset = ccnxCodecTlvDecoder_AbsolutePosition(decoder);
+            bytes = ccnxCodecTlvDecoder_OverlayValue(decoder, _fixedHeaderBytes);
+            if (bytes != NULL) {
+                success = ccnxTlvDictionary_PutLazyBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_FixedHeader,
+                                                          offset, _fixedHeaderBytes);
+            }
+        }
 
-        parcBuffer_SetPosition(buffer, _fixedHeader_PacketLengthOffset);
-        uint16_t packetLength = parcBuffer_GetUint16(buffer);
+        if (bytes == NULL) {
+            buffer = ccnxCodecTlvDecoder_GetValue(decoder, _fixedHeaderBytes);
+            success = ccnxTlvDictionary_PutBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_FixedHeader, buffer);
+            bytes = parcBuffer_Overlay(buffer, 0);
+        }
 
-        parcBuffer_SetPosition(buffer, _fixedHeader_HopLimitOffset);
-        uint8_t hopLimit = parcBuffer_GetUint8(buffer);
+        // validation
+        uint8_t version = bytes[_fixedHeader_VersionOffset];
+        uint16_t packetLength = (uint16_t) ((bytes[_fixedHeader_PacketLengthOffset] << 8) | bytes[_fixedHeader_PacketLengthOffset + 1]);
+        uint8_t hopLimit = bytes[_fixedHeader_HopLimitOffset];
+        uint8_t headerLength = bytes[_fixedHeader_HeaderLengthOffset];
 
-        parcBuffer_SetPosition(buffer, _fixedHeader_HeaderLengthOffset);
-        uint8_t headerLength = parcBuffer_GetUint8(buffer);
+        header->version = version;
+        header->packetType = bytes[_fixedHeader_PacketTypeOffset];
+        header->packetLength = packetLength;
+        memcpy(header->reserved, &bytes[_fixedHeader_HopLimitOffset], sizeof(header->reserved));
+        header->headerLength = headerLength;
 
         if (version != 1) {
             CCNxCodecError *error = ccnxCodecError_Create(TLV_ERR_VERSION, __func__, __LINE__, _fixedHeader_VersionOffset);
@@ -96,7 +121,9 @@ ccnxCodecSchemaV1FixedHeaderDecoder_Decode(CCNxCodecTlvDecoder *decoder, CCNxTlv
         }
 
         // decoder now points to just past the fixed header
-        parcBuffer_Release(&buffer);
+        if (buffer != NULL) {
+            parcBuffer_Release(&buffer);
+        }
 
         // Set the hoplimit in the dictionary.
         ccnxTlvDictionary_PutInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_HOPLIMIT, hopLimit);
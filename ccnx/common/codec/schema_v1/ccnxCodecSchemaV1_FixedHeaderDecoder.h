@@ -38,6 +38,8 @@
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
 #include <ccnx/common/codec/ccnxCodec_TlvDecoder.h>
 
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
+
 /**
  * The decode a V1 fixed header
  *
@@ -58,6 +60,32 @@
  */
 bool ccnxCodecSchemaV1FixedHeaderDecoder_Decode(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * The decode a V1 fixed header and return its length fields
+ *
+ * As ccnxCodecSchemaV1FixedHeaderDecoder_Decode(), and also fills in `header` in host byte order,
+ * so the packet decoder does not read the fields back from the dictionary.
+ *
+ * @param [in] decoder The decoder to parse
+ * @param [in] dictionary The results go directly in to the provided dictionary.
+ * @param [out] header The version, packet type, packet length and header length of the fixed header
+ *
+ * @return true Fully parsed, `header` is filled in
+ * @return false Error decoding, decoder is left pointing to the first byte of the error
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecSchemaV1FixedHeader header;
+ *     if (ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader(decoder, dictionary, &header)) {
+ *         size_t optionalHeaderLength = header.headerLength - sizeof(CCNxCodecSchemaV1FixedHeader);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary,
+                                                      CCNxCodecSchemaV1FixedHeader *header);
+
 /**
  * A convenience function to return the version
  *
@@ -73,6 +73,29 @@ ccnxCodecSchemaV1LinkCodec_Encode(CCNxCodecTlvEncoder *encoder, const CCNxLink *
     return length;
 }
 
+ssize_t
+ccnxCodecSchemaV1LinkCodec_GetEncodedLength(const CCNxLink *link)
+{
+    const CCNxName *name = ccnxLink_GetName(link);
+    if (name == NULL) {
+        return -1;
+    }
+
+    ssize_t length = ccnxCodecSchemaV1NameCodec_GetEncodedLength(name);
+
+    PARCBuffer *keyid = ccnxLink_GetKeyID(link);
+    if (keyid) {
+        length += 4 + parcBuffer_Remaining(keyid);
+    }
+
+    PARCBuffer *hash = ccnxLink_GetContentObjectHash(link);
+    if (hash) {
+        length += 4 + parcBuffer_Remaining(hash);
+    }
+
+    return length;
+}
+
 typedef struct decoded_link {
     CCNxName *linkName;
     PARCBuffer *linkKeyId;
@@ -63,6 +63,29 @@
  */
 ssize_t ccnxCodecSchemaV1LinkCodec_Encode(CCNxCodecTlvEncoder *encoder, const CCNxLink *link);
 
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1LinkCodec_Encode() would append for the link
+ *
+ * Like the encoder, this does not include a TL container around the link.
+ *
+ * @param [in] link The link to measure
+ *
+ * @return non-negative The encoded length of the link's inner TLVs
+ * @return -1 The link has no name
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1LinkCodec_GetEncodedLength(link);
+ *     if (length > 0) {
+ *         ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_CCNxMessage_Payload, length);
+ *         ccnxCodecSchemaV1LinkCodec_Encode(encoder, link);
+ *     }
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1LinkCodec_GetEncodedLength(const CCNxLink *link);
+
 /**
  * The decoder points to the first byte of the "value" of something that is a Link
  *
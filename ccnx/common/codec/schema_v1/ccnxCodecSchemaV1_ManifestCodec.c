@@ -0,0 +1,688 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Buffer.h>
+
+#include <ccnx/common/codec/ccnxCodec_TlvUtilities.h>
+
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_NameCodec.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_LinkCodec.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_ManifestCodec.h>
+
+// The most digests that fit in one HashGroup after its 4-byte name index
+#define _maxDigestsPerGroup ((UINT16_MAX - 4) / CCNxCodecSchemaV1ManifestCodec_DigestLength)
+
+static void
+_setEncoderError(CCNxCodecTlvEncoder *encoder, CCNxCodecErrorCodes code, int line)
+{
+    CCNxCodecError *error = ccnxCodecError_Create(code, __func__, line, ccnxCodecTlvEncoder_Position(encoder));
+    ccnxCodecTlvEncoder_SetError(encoder, error);
+    ccnxCodecError_Release(&error);
+}
+
+static void
+_setDecoderError(CCNxCodecTlvDecoder *decoder, CCNxCodecErrorCodes code, int line)
+{
+    CCNxCodecError *error = ccnxCodecError_Create(code, __func__, line, ccnxCodecTlvDecoder_Position(decoder));
+    ccnxCodecTlvDecoder_SetError(decoder, error);
+    ccnxCodecError_Release(&error);
+}
+
+// ==========================================================================
+// Encoder
+
+/**
+ * The number of hash entries, starting at `start`, that go in one HashGroup.
+ * They share a name index and there are at most _maxDigestsPerGroup of them.
+ */
+static size_t
+_hashGroupLength(const CCNxManifestSection *section, size_t start, size_t hashCount)
+{
+    size_t nameIndex = ccnxManifestSection_GetNameIndexFromHashIndex(section, start);
+    size_t end = start + 1;
+    while (end < hashCount && end - start < _maxDigestsPerGroup
+           && ccnxManifestSection_GetNameIndexFromHashIndex(section, end) == nameIndex) {
+        end++;
+    }
+    return end - start;
+}
+
+static size_t
+_nameEntryValueLength(const CCNxManifestSection *section, size_t nameIndex)
+{
+    return ccnxCodecSchemaV1NameCodec_GetEncodedLength(ccnxManifestSection_GetNameAtIndex(section, nameIndex))
+           + 4 + ccnxCodecTlvEncoder_ComputeVarIntLength(ccnxManifestSection_GetChunkAtIndex(section, nameIndex));
+}
+
+ssize_t
+ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(const CCNxManifestSection *section)
+{
+    ssize_t length = 0;
+
+    CCNxLink *acsLink = ccnxManifestSection_GetACSLink(section);
+    if (acsLink) {
+        ssize_t linkLength = ccnxCodecSchemaV1LinkCodec_GetEncodedLength(acsLink);
+        if (linkLength < 0 || linkLength > UINT16_MAX) {
+            return -1;
+        }
+        length += 4 + linkLength;
+    }
+
+    size_t nameCount = ccnxManifestSection_GetNameCount(section);
+    for (size_t i = 0; i < nameCount; i++) {
+        size_t valueLength = _nameEntryValueLength(section, i);
+        if (valueLength > UINT16_MAX) {
+            return -1;
+        }
+        length += 4 + valueLength;
+    }
+
+    size_t hashCount = ccnxManifestSection_GetHashCount(section);
+    size_t start = 0;
+    while (start < hashCount) {
+        size_t digests = _hashGroupLength(section, start, hashCount);
+        length += 4 + 4 + digests * CCNxCodecSchemaV1ManifestCodec_DigestLength;
+        start += digests;
+    }
+
+    return length;
+}
+
+static size_t
+_encodeHashGroup(CCNxCodecTlvEncoder *encoder, const CCNxManifestSection *section, size_t start, size_t digests)
+{
+    size_t length = ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_ManifestSection_HashGroup,
+                                                        (uint16_t) (4 + digests * CCNxCodecSchemaV1ManifestCodec_DigestLength));
+
+    uint32_t nameIndex = (uint32_t) ccnxManifestSection_GetNameIndexFromHashIndex(section, start);
+    uint8_t networkIndex[4] = { nameIndex >> 24, nameIndex >> 16, nameIndex >> 8, nameIndex };
+    length += ccnxCodecTlvEncoder_AppendRawArray(encoder, sizeof(networkIndex), networkIndex);
+
+    // The section stores the digests of a group back to back, as they are on the wire
+    length += ccnxCodecTlvEncoder_AppendRawArray(encoder, digests * CCNxCodecSchemaV1ManifestCodec_DigestLength,
+                                                 (uint8_t *) ccnxManifestSection_GetDigestAtIndex(section, start));
+
+    return length;
+}
+
+ssize_t
+ccnxCodecSchemaV1ManifestCodec_EncodeSection(CCNxCodecTlvEncoder *encoder, const CCNxManifestSection *section)
+{
+    // Measuring first validates the section, so nothing is appended for a section we cannot encode
+    ssize_t expected = ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(section);
+    if (expected < 0) {
+        _setEncoderError(encoder, TLV_ERR_TOO_LONG, __LINE__);
+        return -1;
+    }
+
+    ssize_t length = 0;
+
+    CCNxLink *acsLink = ccnxManifestSection_GetACSLink(section);
+    if (acsLink) {
+        length += ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_ManifestSection_AcsLink,
+                                                      (uint16_t) ccnxCodecSchemaV1LinkCodec_GetEncodedLength(acsLink));
+        length += ccnxCodecSchemaV1LinkCodec_Encode(encoder, acsLink);
+    }
+
+    size_t nameCount = ccnxManifestSection_GetNameCount(section);
+    for (size_t i = 0; i < nameCount; i++) {
+        length += ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_ManifestSection_NameEntry,
+                                                      (uint16_t) _nameEntryValueLength(section, i));
+        length += ccnxCodecSchemaV1NameCodec_Encode(encoder, CCNxCodecSchemaV1Types_ManifestNameEntry_Name,
+                                                    ccnxManifestSection_GetNameAtIndex(section, i));
+        length += ccnxCodecTlvEncoder_AppendVarInt(encoder, CCNxCodecSchemaV1Types_ManifestNameEntry_Chunk,
+                                                   ccnxManifestSection_GetChunkAtIndex(section, i));
+    }
+
+    size_t hashCount = ccnxManifestSection_GetHashCount(section);
+    size_t start = 0;
+    while (start < hashCount) {
+        size_t digests = _hashGroupLength(section, start, hashCount);
+        length += _encodeHashGroup(encoder, section, start, digests);
+        start += digests;
+    }
+
+    assertTrue(length == expected, "Encoded %zd bytes, expected %zd", length, expected);
+    return length;
+}
+
+static ssize_t
+_encodeSectionContainer(CCNxCodecTlvEncoder *encoder, uint16_t type, const CCNxManifestSection *section)
+{
+    ssize_t sectionLength = ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(section);
+    ssize_t length = ccnxCodecTlvEncoder_AppendContainer(encoder, type, (uint16_t) sectionLength);
+    return length + ccnxCodecSchemaV1ManifestCodec_EncodeSection(encoder, section);
+}
+
+ssize_t
+ccnxCodecSchemaV1ManifestCodec_GetEncodedLength(const CCNxManifest *manifest)
+{
+    CCNxLink *nameLink = ccnxManifest_GetNameLink(manifest);
+    if (nameLink == NULL) {
+        return -1;
+    }
+
+    ssize_t linkLength = ccnxCodecSchemaV1LinkCodec_GetEncodedLength(nameLink);
+    if (linkLength < 0 || linkLength > UINT16_MAX) {
+        return -1;
+    }
+    ssize_t length = 4 + linkLength;
+
+    CCNxManifestSection *sections[] = { ccnxManifest_GetMetadataSection(manifest), ccnxManifest_GetPayloadSection(manifest) };
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        if (sections[i]) {
+            ssize_t sectionLength = ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(sections[i]);
+            if (sectionLength < 0 || sectionLength > UINT16_MAX) {
+                return -1;
+            }
+            length += 4 + sectionLength;
+        }
+    }
+
+    return length;
+}
+
+ssize_t
+ccnxCodecSchemaV1ManifestCodec_Encode(CCNxCodecTlvEncoder *encoder, const CCNxManifest *manifest)
+{
+    ssize_t expected = ccnxCodecSchemaV1ManifestCodec_GetEncodedLength(manifest);
+    if (expected < 0) {
+        CCNxCodecErrorCodes code = (ccnxManifest_GetNameLink(manifest) == NULL) ? TLV_MISSING_MANDATORY : TLV_ERR_TOO_LONG;
+        _setEncoderError(encoder, code, __LINE__);
+        return -1;
+    }
+
+    CCNxLink *nameLink = ccnxManifest_GetNameLink(manifest);
+    ssize_t length = ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_Manifest_NameLink,
+                                                         (uint16_t) ccnxCodecSchemaV1LinkCodec_GetEncodedLength(nameLink));
+    length += ccnxCodecSchemaV1LinkCodec_Encode(encoder, nameLink);
+
+    CCNxManifestSection *metadata = ccnxManifest_GetMetadataSection(manifest);
+    if (metadata) {
+        length += _encodeSectionContainer(encoder, CCNxCodecSchemaV1Types_Manifest_MetadataSection, metadata);
+    }
+
+    CCNxManifestSection *payload = ccnxManifest_GetPayloadSection(manifest);
+    if (payload) {
+        length += _encodeSectionContainer(encoder, CCNxCodecSchemaV1Types_Manifest_PayloadSection, payload);
+    }
+
+    return length;
+}
+
+// ==========================================================================
+// Decoder
+
+/**
+ * Decodes the value of a NameEntry and adds it to the section
+ */
+static int
+_decodeNameEntry(CCNxCodecTlvDecoder *decoder, CCNxManifestSection *section)
+{
+    int errorCode = TLV_ERR_NO_ERROR;
+
+    CCNxName *name = NULL;
+    uint64_t chunk = 0;
+    bool hasChunk = false;
+
+    while (errorCode == TLV_ERR_NO_ERROR && ccnxCodecTlvDecoder_EnsureRemaining(decoder, 4)) {
+        uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+        uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+
+        if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
+            switch (type) {
+                case CCNxCodecSchemaV1Types_ManifestNameEntry_Name:
+                    if (name == NULL) {
+                        name = ccnxCodecSchemaV1NameCodec_DecodeValue(decoder, length);
+                        if (name == NULL) {
+                            errorCode = TLV_ERR_DECODE;
+                        }
+                    } else {
+                        errorCode = TLV_ERR_DUPLICATE_FIELD;
+                    }
+                    break;
+
+                case CCNxCodecSchemaV1Types_ManifestNameEntry_Chunk:
+                    if (!hasChunk) {
+                        hasChunk = ccnxCodecTlvDecoder_GetVarInt(decoder, length, &chunk);
+                        if (!hasChunk) {
+                            errorCode = TLV_ERR_DECODE;
+                        }
+                    } else {
+                        errorCode = TLV_ERR_DUPLICATE_FIELD;
+                    }
+                    break;
+
+                default:
+                    // we do not support unknown TLVs
+                    errorCode = TLV_ERR_DECODE;
+                    break;
+            }
+        } else {
+            errorCode = TLV_ERR_TOO_LONG;
+        }
+    }
+
+    if (errorCode == TLV_ERR_NO_ERROR && !ccnxCodecTlvDecoder_IsEmpty(decoder)) {
+        errorCode = TLV_ERR_TOO_LONG;
+    }
+
+    if (errorCode == TLV_ERR_NO_ERROR && (name == NULL || !hasChunk)) {
+        errorCode = TLV_MISSING_MANDATORY;
+    }
+
+    if (errorCode == TLV_ERR_NO_ERROR) {
+        ccnxManifestSection_AddName(section, name, (size_t) chunk);
+    }
+
+    if (name) {
+        ccnxName_Release(&name);
+    }
+
+    return errorCode;
+}
+
+/**
+ * Decodes the value of a HashGroup and adds its digests to the section
+ */
+static int
+_decodeHashGroup(CCNxCodecTlvDecoder *decoder, uint16_t length, CCNxManifestSection *section)
+{
+    if (length < 4 + CCNxCodecSchemaV1ManifestCodec_DigestLength || (length - 4) % CCNxCodecSchemaV1ManifestCodec_DigestLength != 0) {
+        return TLV_ERR_NOT_FIXED_SIZE;
+    }
+
+    PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
+    const uint8_t *bytes = parcBuffer_Overlay(value, 0);
+
+    int errorCode = TLV_ERR_NO_ERROR;
+    uint32_t nameIndex = ((uint32_t) bytes[0] << 24) | ((uint32_t) bytes[1] << 16) | ((uint32_t) bytes[2] << 8) | bytes[3];
+    size_t count = (length - 4) / CCNxCodecSchemaV1ManifestCodec_DigestLength;
+    if (!ccnxManifestSection_AddHashArray(section, nameIndex, count, &bytes[4])) {
+        errorCode = TLV_ERR_DECODE;
+    }
+
+    parcBuffer_Release(&value);
+    return errorCode;
+}
+
+typedef struct decoded_section {
+    CCNxLink *acsLink;
+    CCNxManifestSection *section;
+} _DecodedSection;
+
+static int
+_decodeSectionField(CCNxCodecTlvDecoder *decoder, _DecodedSection *decoded)
+{
+    int errorCode = TLV_ERR_NO_ERROR;
+
+    uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
+        if (type != CCNxCodecSchemaV1Types_ManifestSection_AcsLink && decoded->section == NULL) {
+            // The section is created when the first field after the (optional) ACS link arrives
+            decoded->section = ccnxManifestSection_Create(NULL);
+        }
+
+        switch (type) {
+            case CCNxCodecSchemaV1Types_ManifestSection_AcsLink:
+                // The ACS link is only allowed as the first field
+                if (decoded->section == NULL) {
+                    CCNxCodecTlvDecoder *linkDecoder = ccnxCodecTlvDecoder_GetContainer(decoder, length);
+                    decoded->acsLink = ccnxCodecSchemaV1LinkCodec_DecodeValue(linkDecoder, length);
+                    ccnxCodecTlvDecoder_Destroy(&linkDecoder);
+                    if (decoded->acsLink != NULL) {
+                        decoded->section = ccnxManifestSection_Create(decoded->acsLink);
+                    } else {
+                        errorCode = TLV_ERR_DECODE;
+                    }
+                } else {
+                    errorCode = (decoded->acsLink == NULL) ? TLV_ERR_DECODE : TLV_ERR_DUPLICATE_FIELD;
+                }
+                break;
+
+            case CCNxCodecSchemaV1Types_ManifestSection_NameEntry: {
+                CCNxCodecTlvDecoder *entryDecoder = ccnxCodecTlvDecoder_GetContainer(decoder, length);
+                errorCode = _decodeNameEntry(entryDecoder, decoded->section);
+                ccnxCodecTlvDecoder_Destroy(&entryDecoder);
+                break;
+            }
+
+            case CCNxCodecSchemaV1Types_ManifestSection_HashGroup:
+                errorCode = _decodeHashGroup(decoder, length, decoded->section);
+                break;
+
+            default:
+                // we do not support unknown TLVs
+                errorCode = TLV_ERR_DECODE;
+                break;
+        }
+    } else {
+        errorCode = TLV_ERR_TOO_LONG;
+    }
+
+    return errorCode;
+}
+
+CCNxManifestSection *
+ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(CCNxCodecTlvDecoder *decoder, uint16_t sectionLength)
+{
+    int errorCode = TLV_ERR_NO_ERROR;
+
+    _DecodedSection decoded;
+    memset(&decoded, 0, sizeof(_DecodedSection));
+
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, sectionLength)) {
+        CCNxCodecTlvDecoder *sectionDecoder = ccnxCodecTlvDecoder_GetContainer(decoder, sectionLength);
+        while (errorCode == TLV_ERR_NO_ERROR && ccnxCodecTlvDecoder_EnsureRemaining(sectionDecoder, 4)) {
+            errorCode = _decodeSectionField(sectionDecoder, &decoded);
+        }
+        if (errorCode == TLV_ERR_NO_ERROR && !ccnxCodecTlvDecoder_IsEmpty(sectionDecoder)) {
+            errorCode = TLV_ERR_TOO_LONG;
+        }
+        ccnxCodecTlvDecoder_Destroy(&sectionDecoder);
+    } else {
+        errorCode = TLV_ERR_TOO_LONG;
+    }
+
+    if (errorCode == TLV_ERR_NO_ERROR && decoded.section == NULL) {
+        // an empty section
+        decoded.section = ccnxManifestSection_Create(NULL);
+    }
+
+    if (errorCode != TLV_ERR_NO_ERROR) {
+        _setDecoderError(decoder, errorCode, __LINE__);
+        if (decoded.section) {
+            ccnxManifestSection_Release(&decoded.section);
+        }
+    }
+
+    if (decoded.acsLink) {
+        ccnxLink_Release(&decoded.acsLink);
+    }
+
+    return decoded.section;
+}
+
+typedef struct decoded_manifest {
+    CCNxLink *nameLink;
+    CCNxManifestSection *metadata;
+    CCNxManifestSection *payload;
+} _DecodedManifest;
+
+static int
+_decodeManifestField(CCNxCodecTlvDecoder *decoder, _DecodedManifest *decoded)
+{
+    int errorCode = TLV_ERR_NO_ERROR;
+
+    uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
+        switch (type) {
+            case CCNxCodecSchemaV1Types_Manifest_NameLink:
+                if (decoded->nameLink == NULL) {
+                    CCNxCodecTlvDecoder *linkDecoder = ccnxCodecTlvDecoder_GetContainer(decoder, length);
+                    decoded->nameLink = ccnxCodecSchemaV1LinkCodec_DecodeValue(linkDecoder, length);
+                    ccnxCodecTlvDecoder_Destroy(&linkDecoder);
+                    if (decoded->nameLink == NULL) {
+                        errorCode = TLV_ERR_DECODE;
+                    }
+                } else {
+                    errorCode = TLV_ERR_DUPLICATE_FIELD;
+                }
+                break;
+
+            case CCNxCodecSchemaV1Types_Manifest_MetadataSection:
+                if (decoded->metadata == NULL) {
+                    decoded->metadata = ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(decoder, length);
+                    if (decoded->metadata == NULL) {
+                        errorCode = TLV_ERR_DECODE;
+                    }
+                } else {
+                    errorCode = TLV_ERR_DUPLICATE_FIELD;
+                }
+                break;
+
+            case CCNxCodecSchemaV1Types_Manifest_PayloadSection:
+                if (decoded->payload == NULL) {
+                    decoded->payload = ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(decoder, length);
+                    if (decoded->payload == NULL) {
+                        errorCode = TLV_ERR_DECODE;
+                    }
+                } else {
+                    errorCode = TLV_ERR_DUPLICATE_FIELD;
+                }
+                break;
+
+            default:
+                // we do not support unknown TLVs
+                errorCode = TLV_ERR_DECODE;
+                break;
+        }
+    } else {
+        errorCode = TLV_ERR_TOO_LONG;
+    }
+
+    return errorCode;
+}
+
+static void
+_decodedManifestCleanup(_DecodedManifest *decoded)
+{
+    if (decoded->nameLink) {
+        ccnxLink_Release(&decoded->nameLink);
+    }
+
+    if (decoded->metadata) {
+        ccnxManifestSection_Release(&decoded->metadata);
+    }
+
+    if (decoded->payload) {
+        ccnxManifestSection_Release(&decoded->payload);
+    }
+}
+
+CCNxManifest *
+ccnxCodecSchemaV1ManifestCodec_DecodeValue(CCNxCodecTlvDecoder *decoder, uint16_t manifestLength, PARCSignature *signature)
+{
+    assertNotNull(signature, "Parameter signature must be non-null");
+
+    int errorCode = TLV_ERR_NO_ERROR;
+
+    CCNxManifest *manifest = NULL;
+
+    _DecodedManifest decoded;
+    memset(&decoded, 0, sizeof(_DecodedManifest));
+
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, manifestLength)) {
+        CCNxCodecTlvDecoder *manifestDecoder = ccnxCodecTlvDecoder_GetContainer(decoder, manifestLength);
+        while (errorCode == TLV_ERR_NO_ERROR && ccnxCodecTlvDecoder_EnsureRemaining(manifestDecoder, 4)) {
+            errorCode = _decodeManifestField(manifestDecoder, &decoded);
+        }
+        if (errorCode == TLV_ERR_NO_ERROR && !ccnxCodecTlvDecoder_IsEmpty(manifestDecoder)) {
+            errorCode = TLV_ERR_TOO_LONG;
+        }
+        ccnxCodecTlvDecoder_Destroy(&manifestDecoder);
+    } else {
+        errorCode = TLV_ERR_TOO_LONG;
+    }
+
+    if (errorCode == TLV_ERR_NO_ERROR && decoded.nameLink == NULL) {
+        errorCode = TLV_MISSING_MANDATORY;
+    }
+
+    if (errorCode != TLV_ERR_NO_ERROR) {
+        _setDecoderError(decoder, errorCode, __LINE__);
+    } else {
+        manifest = ccnxManifest_Create(signature, decoded.nameLink, decoded.metadata, decoded.payload);
+    }
+
+    // cleanup any partial memory allocations
+    _decodedManifestCleanup(&decoded);
+
+    return manifest;
+}
+
+// ==========================================================================
+// Streaming hash array decoder
+
+static inline uint16_t
+_readUint16(const uint8_t *p)
+{
+    return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+static inline uint32_t
+_readUint32(const uint8_t *p)
+{
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+/**
+ * Walks the TLVs of one section value, copying hash entries and counting them in `*countPtr`.
+ * Only the TL framing and name entry count are checked; name entries are not decoded.
+ */
+static bool
+_scanSection(const uint8_t *p, size_t remaining, size_t capacity, uint8_t *digests, uint32_t *nameIndexes, size_t *countPtr)
+{
+    size_t nameCount = 0;
+    bool first = true;
+
+    while (remaining >= 4) {
+        uint16_t type = _readUint16(p);
+        uint16_t length = _readUint16(p + 2);
+        p += 4;
+        remaining -= 4;
+
+        if (length > remaining) {
+            return false;
+        }
+
+        switch (type) {
+            case CCNxCodecSchemaV1Types_ManifestSection_AcsLink:
+                if (!first) {
+                    return false;
+                }
+                break;
+
+            case CCNxCodecSchemaV1Types_ManifestSection_NameEntry:
+                nameCount++;
+                break;
+
+            case CCNxCodecSchemaV1Types_ManifestSection_HashGroup: {
+                if (length < 4 + CCNxCodecSchemaV1ManifestCodec_DigestLength || (length - 4) % CCNxCodecSchemaV1ManifestCodec_DigestLength != 0) {
+                    return false;
+                }
+
+                uint32_t nameIndex = _readUint32(p);
+                if (nameIndex >= nameCount) {
+                    return false;
+                }
+
+                size_t groupCount = (length - 4) / CCNxCodecSchemaV1ManifestCodec_DigestLength;
+                size_t count = *countPtr;
+                if (count < capacity) {
+                    size_t copies = (capacity - count < groupCount) ? capacity - count : groupCount;
+                    memcpy(digests + count * CCNxCodecSchemaV1ManifestCodec_DigestLength, p + 4,
+                           copies * CCNxCodecSchemaV1ManifestCodec_DigestLength);
+                    if (nameIndexes) {
+                        for (size_t i = 0; i < copies; i++) {
+                            nameIndexes[count + i] = nameIndex;
+                        }
+                    }
+                }
+                *countPtr = count + groupCount;
+                break;
+            }
+
+            default:
+                return false;
+        }
+
+        first = false;
+        p += length;
+        remaining -= length;
+    }
+
+    return remaining == 0;
+}
+
+bool
+ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(PARCBuffer *payload, CCNxCodecSchemaV1Types_Manifest sectionType,
+                                               size_t capacity, uint8_t *digests, uint32_t *nameIndexes, size_t *countPtr)
+{
+    assertTrue(sectionType == CCNxCodecSchemaV1Types_Manifest_MetadataSection || sectionType == CCNxCodecSchemaV1Types_Manifest_PayloadSection,
+               "Parameter sectionType must be a manifest section, got %d", sectionType);
+    assertTrue(capacity == 0 || digests != NULL, "Parameter digests must be non-null with a capacity of %zu", capacity);
+    assertNotNull(countPtr, "Parameter countPtr must be non-null");
+
+    *countPtr = 0;
+
+    size_t remaining = parcBuffer_Remaining(payload);
+    const uint8_t *p = parcBuffer_Overlay(payload, 0);
+
+    bool success = true;
+    bool found = false;
+    while (success && remaining >= 4) {
+        uint16_t type = _readUint16(p);
+        uint16_t length = _readUint16(p + 2);
+        p += 4;
+        remaining -= 4;
+
+        if (length > remaining) {
+            success = false;
+        } else if (type == sectionType) {
+            if (found) {
+                success = false;
+            } else {
+                found = true;
+                success = _scanSection(p, length, capacity, digests, nameIndexes, countPtr);
+            }
+        } else if (type != CCNxCodecSchemaV1Types_Manifest_NameLink && type != CCNxCodecSchemaV1Types_Manifest_MetadataSection
+                   && type != CCNxCodecSchemaV1Types_Manifest_PayloadSection) {
+            success = false;
+        }
+
+        if (success) {
+            p += length;
+            remaining -= length;
+        }
+    }
+
+    return success && remaining == 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file ccnxCodecSchemaV1_ManifestCodec.h
+ * @brief Encode and decode the payload of a ContentObject whose PayloadType is Manifest
+ *
+ * A Manifest is a well-known value, not a TLV field.  The payload holds an optional name Link and
+ * up to one metadata section and one payload section:
+ *
+ * @code
+ * Manifest    := [NameLink] [MetadataSection] [PayloadSection]
+ * Section     := [AcsLink] *NameEntry *HashGroup
+ * NameEntry   := Name Chunk
+ * HashGroup   := NameIndex (4 bytes) 1*Digest (32 bytes each)
+ * @endcode
+ *
+ * A HashGroup carries consecutive hash entries that share a name entry.  Its digests are packed
+ * back to back without per-entry TLVs, so ccnxCodecSchemaV1ManifestCodec_DecodeHashArray() can copy a
+ * section's digests straight out of the payload in to a caller's array.  Name entries are numbered
+ * in the order they appear and must precede any HashGroup that refers to them.  The AcsLink,
+ * if present, must be the first field of a section.
+ *
+ * The manifest signature is not part of the payload; it is carried in the ContentObject's ValidationPayload.
+ *
+ */
+
+#ifndef CCNxCodecSchemaV1_ManifestCodec_h
+#define CCNxCodecSchemaV1_ManifestCodec_h
+
+#include <ccnx/common/ccnx_Manifest.h>
+#include <ccnx/common/ccnx_ManifestSection.h>
+#include <ccnx/common/codec/ccnxCodec_TlvEncoder.h>
+#include <ccnx/common/codec/ccnxCodec_TlvDecoder.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
+
+/**
+ * The length of every digest in a HashGroup (SHA-256), the same as a CCNxManifestSection digest
+ */
+#define CCNxCodecSchemaV1ManifestCodec_DigestLength CCNxManifestSection_DigestLength
+
+/**
+ * Encodes the manifest, but without a "TL" container
+ *
+ * The manifest signature is not encoded.  If the manifest has no name link or a section is longer
+ * than a TLV can hold, nothing is appended and the function returns -1 with an error in the encoder.
+ *
+ * @param [in] encoder The manifest will be appended to the encoder
+ * @param [in] manifest The manifest to append
+ *
+ * @retval non-negative The number of bytes appended to the encoder
+ * @retval negative An error, look at the CCNxCodecError of the encoder
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1ManifestCodec_GetEncodedLength(manifest);
+ *     if (length > 0) {
+ *         ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_CCNxMessage_Payload, length);
+ *         ccnxCodecSchemaV1ManifestCodec_Encode(encoder, manifest);
+ *     }
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1ManifestCodec_Encode(CCNxCodecTlvEncoder *encoder, const CCNxManifest *manifest);
+
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1ManifestCodec_Encode() would append for the manifest
+ *
+ * @param [in] manifest The manifest to measure
+ *
+ * @return non-negative The encoded length of the manifest's inner TLVs
+ * @return -1 The manifest cannot be encoded
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1ManifestCodec_GetEncodedLength(manifest);
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1ManifestCodec_GetEncodedLength(const CCNxManifest *manifest);
+
+/**
+ * The decoder points to the first byte of the "value" of a Manifest
+ *
+ * For a ContentObject of type Manifest, the decoder should point to the first byte of the Payload.
+ * The signature is the one from the ContentObject's ValidationPayload, it is stored in the
+ * returned manifest.  Unknown fields are an error.
+ *
+ * @param [in] decoder The Tlv Decoder pointing to the start of the Manifest value
+ * @param [in] length The length of the Manifest value
+ * @param [in] signature The signature of the ContentObject carrying the manifest
+ *
+ * @return non-null A parsed manifest
+ * @return null An error, check the decoder's error message
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(payload);
+ *     CCNxManifest *manifest = ccnxCodecSchemaV1ManifestCodec_DecodeValue(decoder, parcBuffer_Remaining(payload), signature);
+ *     ccnxCodecTlvDecoder_Destroy(&decoder);
+ * }
+ * @endcode
+ */
+CCNxManifest *ccnxCodecSchemaV1ManifestCodec_DecodeValue(CCNxCodecTlvDecoder *decoder, uint16_t length, PARCSignature *signature);
+
+/**
+ * Encodes a manifest section, but without a "TL" container
+ *
+ * @param [in] encoder The section will be appended to the encoder
+ * @param [in] section The section to append
+ *
+ * @retval non-negative The number of bytes appended to the encoder
+ * @retval negative An error, look at the CCNxCodecError of the encoder
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(section);
+ *     ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_Manifest_PayloadSection, length);
+ *     ccnxCodecSchemaV1ManifestCodec_EncodeSection(encoder, section);
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1ManifestCodec_EncodeSection(CCNxCodecTlvEncoder *encoder, const CCNxManifestSection *section);
+
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1ManifestCodec_EncodeSection() would append for the section
+ *
+ * @param [in] section The section to measure
+ *
+ * @return non-negative The encoded length of the section's inner TLVs
+ * @return -1 A name entry or the ACS link is longer than a TLV can hold
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(section);
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(const CCNxManifestSection *section);
+
+/**
+ * The decoder points to the first byte of the "value" of a manifest section
+ *
+ * @param [in] decoder The Tlv Decoder pointing to the start of the section value
+ * @param [in] length The length of the section value
+ *
+ * @return non-null A parsed section
+ * @return null An error, check the decoder's error message
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestSection *section = ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(decoder, length);
+ * }
+ * @endcode
+ */
+CCNxManifestSection *ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(CCNxCodecTlvDecoder *decoder, uint16_t length);
+
+/**
+ * Copies the hash entries of one section of a manifest payload in to a caller's arrays
+ *
+ * Walks the payload from its current position to its limit without creating any objects and
+ * without moving the buffer's position.  Digests are copied in wire order, entry `i` occupies
+ * `digests[i * CCNxCodecSchemaV1ManifestCodec_DigestLength]` and its name index is `nameIndexes[i]`.
+ *
+ * At most `capacity` entries are copied, but `*countPtr` is always set to the number of hash entries
+ * in the section.  Call once with a capacity of 0 to size the arrays.  A payload without the
+ * requested section has 0 entries.
+ *
+ * @param [in] payload The manifest payload, positioned at the first byte of the Manifest value
+ * @param [in] sectionType CCNxCodecSchemaV1Types_Manifest_MetadataSection or CCNxCodecSchemaV1Types_Manifest_PayloadSection
+ * @param [in] capacity The number of entries the arrays can hold
+ * @param [out] digests `capacity * CCNxCodecSchemaV1ManifestCodec_DigestLength` bytes, may be NULL if capacity is 0
+ * @param [out] nameIndexes `capacity` name indexes, may be NULL
+ * @param [out] countPtr The number of hash entries in the section
+ *
+ * @return true The payload is a well formed manifest
+ * @return false The payload is malformed, the arrays may be partially filled
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t count;
+ *     if (ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(payload, CCNxCodecSchemaV1Types_Manifest_PayloadSection, 0, NULL, NULL, &count)) {
+ *         uint8_t *digests = parcMemory_Allocate(count * CCNxCodecSchemaV1ManifestCodec_DigestLength);
+ *         ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(payload, CCNxCodecSchemaV1Types_Manifest_PayloadSection, count, digests, NULL, &count);
+ *         // verify each chunk against digests
+ *         parcMemory_Deallocate((void **) &digests);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(PARCBuffer *payload, CCNxCodecSchemaV1Types_Manifest sectionType,
+                                                    size_t capacity, uint8_t *digests, uint32_t *nameIndexes, size_t *countPtr);
+#endif // CCNxCodecSchemaV1_ManifestCodec_h
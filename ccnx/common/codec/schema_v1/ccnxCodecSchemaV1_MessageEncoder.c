@@ -67,13 +67,23 @@ _encodeName(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
     return length;
 }
 
+/*
+ * A payload at least this long is put in the encoder by reference instead of copied.  Below it,
+ * the copy is cheaper than the extra iovec entry.
+ */
+static const size_t _payloadReferenceThreshold = 1024;
+
 static ssize_t
 _encodePayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
 {
     ssize_t length = 0;
     PARCBuffer *buffer = ccnxTlvDictionary_GetBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
     if (buffer != NULL) {
-        length = ccnxCodecTlvEncoder_AppendBuffer(encoder, CCNxCodecSchemaV1Types_CCNxMessage_Payload, buffer);
+        if (parcBuffer_Remaining(buffer) >= _payloadReferenceThreshold) {
+            length = ccnxCodecTlvEncoder_AppendBufferReference(encoder, CCNxCodecSchemaV1Types_CCNxMessage_Payload, buffer);
+        } else {
+            length = ccnxCodecTlvEncoder_AppendBuffer(encoder, CCNxCodecSchemaV1Types_CCNxMessage_Payload, buffer);
+        }
     }
     return length;
 }
@@ -87,6 +97,7 @@ _encodeJsonPayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictio
         char *jsonString = parcJSON_ToCompactString(json);
         size_t len = strlen(jsonString);
         length = ccnxCodecTlvEncoder_AppendArray(encoder, CCNxCodecSchemaV1Types_CCNxMessage_Payload, len, (uint8_t *) jsonString);
+        parcMemory_Deallocate((void **) &jsonString);
     }
     return length;
 }
@@ -309,3 +320,123 @@ ccnxCodecSchemaV1MessageEncoder_Encode(CCNxCodecTlvEncoder *encoder, CCNxTlvDict
 
     return length;
 }
+
+// ==================================================================
+// Sizing
+
+static size_t
+_getBufferLength(CCNxTlvDictionary *packetDictionary, int key)
+{
+    size_t length = 0;
+    PARCBuffer *buffer = ccnxTlvDictionary_GetBuffer(packetDictionary, key);
+    if (buffer != NULL) {
+        length = 4 + parcBuffer_Remaining(buffer);
+    }
+    return length;
+}
+
+static ssize_t
+_getNameLength(CCNxTlvDictionary *packetDictionary)
+{
+    ssize_t length = -1;
+    CCNxName *name = ccnxTlvDictionary_GetName(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME);
+    if (name != NULL) {
+        length = ccnxCodecSchemaV1NameCodec_GetEncodedLength(name);
+    }
+    return length;
+}
+
+static size_t
+_getJsonPayloadLength(CCNxTlvDictionary *packetDictionary)
+{
+    size_t length = 0;
+    PARCJSON *json = ccnxTlvDictionary_GetJson(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+    if (json != NULL) {
+        char *jsonString = parcJSON_ToCompactString(json);
+        length = 4 + strlen(jsonString);
+        parcMemory_Deallocate((void **) &jsonString);
+    }
+    return length;
+}
+
+static size_t
+_getContentObjectFieldsLength(CCNxTlvDictionary *packetDictionary)
+{
+    size_t length = 0;
+
+    if (ccnxTlvDictionary_IsValueInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOADTYPE)) {
+        length += 4 + 1;
+    } else if (ccnxTlvDictionary_IsValueBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOADTYPE)) {
+        length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOADTYPE);
+    }
+
+    if (ccnxTlvDictionary_IsValueInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_EXPIRY_TIME)) {
+        length += 4 + 8;
+    } else if (ccnxTlvDictionary_IsValueBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_EXPIRY_TIME)) {
+        length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_EXPIRY_TIME);
+    }
+
+    if (ccnxTlvDictionary_IsValueInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_ENDSEGMENT)) {
+        uint64_t endChunkId = ccnxTlvDictionary_GetInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_ENDSEGMENT);
+        length += 4 + ccnxCodecTlvEncoder_ComputeVarIntLength(endChunkId);
+    } else {
+        length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_ENDSEGMENT);
+    }
+
+    length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+    return length;
+}
+
+static size_t
+_getInterestFieldsLength(CCNxTlvDictionary *packetDictionary)
+{
+    size_t length = 0;
+    length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_KEYID_RESTRICTION);
+    length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_OBJHASH_RESTRICTION);
+    length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+    return length;
+}
+
+ssize_t
+ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(CCNxTlvDictionary *packetDictionary)
+{
+    assertNotNull(packetDictionary, "Parameter packetDictionary must be non-null");
+
+    // All message types must have a name
+    ssize_t length = _getNameLength(packetDictionary);
+    if (length < 0) {
+        return length;
+    }
+
+    if (ccnxTlvDictionary_IsInterest(packetDictionary) || ccnxTlvDictionary_IsInterestReturn(packetDictionary)) {
+        length += _getInterestFieldsLength(packetDictionary);
+    } else if (ccnxTlvDictionary_IsContentObject(packetDictionary)) {
+        length += _getContentObjectFieldsLength(packetDictionary);
+    } else if (ccnxTlvDictionary_IsControl(packetDictionary)) {
+        length += _getJsonPayloadLength(packetDictionary);
+    } else {
+        return -1;
+    }
+
+    ssize_t customLength = ccnxCodecTlvUtilities_GetCustomListLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_Lists_MESSAGE_LIST);
+    if (customLength < 0) {
+        return customLength;
+    }
+
+    return length + customLength;
+}
+
+size_t
+ccnxCodecSchemaV1MessageEncoder_GetPayloadReferenceLength(CCNxTlvDictionary *packetDictionary)
+{
+    assertNotNull(packetDictionary, "Parameter packetDictionary must be non-null");
+
+    size_t length = 0;
+    if (!ccnxTlvDictionary_IsControl(packetDictionary)) {
+        PARCBuffer *buffer = ccnxTlvDictionary_GetBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+        if (buffer != NULL && parcBuffer_Remaining(buffer) >= _payloadReferenceThreshold) {
+            length = parcBuffer_Remaining(buffer);
+        }
+    }
+    return length;
+}
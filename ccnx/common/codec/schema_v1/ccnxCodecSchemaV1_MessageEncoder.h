@@ -57,4 +57,50 @@
  */
 ssize_t ccnxCodecSchemaV1MessageEncoder_Encode(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1MessageEncoder_Encode() would append
+ *
+ * This is the length of the message body, not including the message TL container.
+ * A Control message's JSON payload is serialized to measure it.
+ *
+ * @param [in] packetDictionary The fields to encode
+ *
+ * @return non-negative Total bytes the message body will use
+ * @return -1 An error, e.g. there is no Name or the dictionary is not a known message type
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t innerLength = ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(packetDictionary);
+ *     if (innerLength >= 0) {
+ *         ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_MessageType_ContentObject, innerLength);
+ *         ccnxCodecSchemaV1MessageEncoder_Encode(encoder, packetDictionary);
+ *     }
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(CCNxTlvDictionary *packetDictionary);
+
+/**
+ * Returns the number of payload bytes ccnxCodecSchemaV1MessageEncoder_Encode() appends by reference
+ *
+ * A large payload is not copied in to the encoder: the encoder keeps a reference to the payload
+ * buffer and the iovec points at its memory.  The caller must not modify the payload until the
+ * iovec is released.  This returns how many bytes of the encoded length are referenced, so a caller
+ * sizing the encoder's memory can leave them out.
+ *
+ * @param [in] packetDictionary The fields to encode
+ *
+ * @return number The payload bytes encoded by reference, 0 if the payload is copied or missing
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(packetDictionary);
+ *     size_t copied = length - ccnxCodecSchemaV1MessageEncoder_GetPayloadReferenceLength(packetDictionary);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecSchemaV1MessageEncoder_GetPayloadReferenceLength(CCNxTlvDictionary *packetDictionary);
+
 #endif // TransportRTA_ccnxCodecSchemaV1_MessageEncoder_h
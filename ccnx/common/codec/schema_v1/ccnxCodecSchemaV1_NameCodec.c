@@ -46,21 +46,21 @@ ccnxCodecSchemaV1NameCodec_Encode(CCNxCodecTlvEncoder *encoder, uint16_t type, c
     assertNotNull(encoder, "Parameter encoder must be non-null");
     assertNotNull(name, "Parameter name must be non-null");
 
-    size_t containerPosition = ccnxCodecTlvEncoder_Position(encoder);
-    size_t containerLength = ccnxCodecTlvEncoder_AppendContainer(encoder, type, 0);
+    // The name already holds its segments in wire format
+    size_t length = ccnxName_GetEncodedLength(name);
+    assertTrue(length <= UINT16_MAX, "Name too long!  length %zu maximum %u", length, UINT16_MAX);
 
-    size_t segmentCount = ccnxName_GetSegmentCount(name);
-    size_t innerLength = 0;
-    for (int i = 0; i < segmentCount; i++) {
-        CCNxNameSegment *segment = ccnxName_GetSegment(name, i);
-
-        innerLength += ccnxCodecSchemaV1NameSegmentCodec_Encode(encoder, segment);
+    if (length == 0) {
+        return ccnxCodecTlvEncoder_AppendContainer(encoder, type, 0);
     }
+    return ccnxCodecTlvEncoder_AppendArray(encoder, type, (uint16_t) length, ccnxName_GetEncodedSegments(name));
+}
 
-    // now go back and fixup the container's length
-    ccnxCodecTlvEncoder_SetContainerLength(encoder, containerPosition, innerLength);
-
-    return containerLength + innerLength;
+size_t
+ccnxCodecSchemaV1NameCodec_GetEncodedLength(const CCNxName *name)
+{
+    assertNotNull(name, "Parameter name must be non-null");
+    return 4 + ccnxName_GetEncodedLength(name);
 }
 
 CCNxName *
@@ -86,13 +86,14 @@ ccnxCodecSchemaV1NameCodec_DecodeValue(CCNxCodecTlvDecoder *decoder, uint16_t le
 {
     CCNxName *name = NULL;
     if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
-        name = ccnxName_Create();
-        size_t nameEnd = ccnxCodecTlvDecoder_Position(decoder) + length;
-
-        while (ccnxCodecTlvDecoder_Position(decoder) < nameEnd) {
-            CCNxNameSegment *segment = ccnxCodecSchemaV1NameSegmentCodec_Decode(decoder);
-            ccnxName_Append(name, segment);
-            ccnxNameSegment_Release(&segment);
+        // The name copies the segments, so only make a buffer if they are not contiguous
+        const uint8_t *encoded = ccnxCodecTlvDecoder_OverlayValue(decoder, length);
+        if (encoded != NULL) {
+            name = ccnxName_CreateFromEncodedArray(length, encoded);
+        } else {
+            PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
+            name = ccnxName_CreateFromEncodedSegments(value);
+            parcBuffer_Release(&value);
         }
     }
     return name;
@@ -57,6 +57,27 @@
  */
 size_t ccnxCodecSchemaV1NameCodec_Encode(CCNxCodecTlvEncoder *encoder, uint16_t type, const CCNxName *name);
 
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1NameCodec_Encode() would append for the name
+ *
+ * This is the 4 byte TL container plus the wire format segments.
+ *
+ * @param [in] name The name to measure
+ *
+ * @return bytes The encoded length of the Name TLV
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxName_CreateFromCString("lci:/apple/pie");
+ *     size_t length = ccnxCodecSchemaV1NameCodec_GetEncodedLength(name);
+ *     // length = 4 + 9 + 7
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecSchemaV1NameCodec_GetEncodedLength(const CCNxName *name);
+
 /**
  * Decode the buffer as a CCNxName beginning at the current position
  *
@@ -176,3 +176,56 @@ ccnxCodecSchemaV1OptionalHeadersEncoder_Encode(CCNxCodecTlvEncoder *optionalHead
 
     return result;
 }
+
+// ==================================================================
+// Sizing
+
+/**
+ * The length of a header that may be an Integer (encoded as a VarInt) or a Buffer
+ */
+static size_t
+_GetVarIntOrBufferLength(CCNxTlvDictionary *packetDictionary, int key)
+{
+    size_t length = 0;
+    if (ccnxTlvDictionary_IsValueInteger(packetDictionary, key)) {
+        length = 4 + ccnxCodecTlvEncoder_ComputeVarIntLength(ccnxTlvDictionary_GetInteger(packetDictionary, key));
+    } else if (ccnxTlvDictionary_IsValueBuffer(packetDictionary, key)) {
+        length = 4 + parcBuffer_Remaining(ccnxTlvDictionary_GetBuffer(packetDictionary, key));
+    }
+    return length;
+}
+
+static size_t
+_GetBufferLength(CCNxTlvDictionary *packetDictionary, int key)
+{
+    size_t length = 0;
+    PARCBuffer *buffer = ccnxTlvDictionary_GetBuffer(packetDictionary, key);
+    if (buffer != NULL) {
+        length = 4 + parcBuffer_Remaining(buffer);
+    }
+    return length;
+}
+
+ssize_t
+ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength(CCNxTlvDictionary *packetDictionary)
+{
+    assertNotNull(packetDictionary, "Parameter packetDictionary must be non-null");
+
+    ssize_t length = 0;
+    if (ccnxTlvDictionary_IsInterest(packetDictionary) || ccnxTlvDictionary_IsInterestReturn(packetDictionary)) {
+        length += _GetBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_INTFRAG);
+        length += _GetVarIntOrBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_InterestLifetime);
+    } else if (ccnxTlvDictionary_IsContentObject(packetDictionary)) {
+        length += _GetBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_OBJFRAG);
+        length += _GetVarIntOrBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_RecommendedCacheTime);
+    } else if (!ccnxTlvDictionary_IsControl(packetDictionary)) {
+        return -1;
+    }
+
+    ssize_t customLength = ccnxCodecTlvUtilities_GetCustomListLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_Lists_HEADERS);
+    if (customLength < 0) {
+        return customLength;
+    }
+
+    return length + customLength;
+}
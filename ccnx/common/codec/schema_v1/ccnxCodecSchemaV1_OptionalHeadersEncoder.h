@@ -56,4 +56,23 @@
  */
 ssize_t ccnxCodecSchemaV1OptionalHeadersEncoder_Encode(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1OptionalHeadersEncoder_Encode() would append
+ *
+ * Nothing is written, so this can be used to size the output buffer before encoding.
+ *
+ * @param [in] packetDictionary The dictionary containing the optional headers
+ *
+ * @return non-negative Total bytes the optional headers will use
+ * @return -1 An error, e.g. the dictionary is not a known packet type
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength(packetDictionary);
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength(CCNxTlvDictionary *packetDictionary);
+
 #endif // TransportRTA_ccnxCodecSchemaV1_OptionalHeadersEncoder_h
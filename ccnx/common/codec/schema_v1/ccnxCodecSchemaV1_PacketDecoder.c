@@ -49,6 +49,7 @@
 typedef struct rta_tlv_schema_v1_data {
     CCNxCodecTlvDecoder *decoder;
     CCNxTlvDictionary *packetDictionary;
+    CCNxCodecSchemaV1FixedHeader fixedHeader;
 } _CCNxCodecSchemaV1Data;
 
 /**
@@ -67,7 +68,8 @@ typedef struct rta_tlv_schema_v1_data {
 static bool
 _decodeOptionalHeaders(_CCNxCodecSchemaV1Data *data)
 {
-    size_t optionalHeaderLength = ccnxCodecSchemaV1FixedHeaderDecoder_GetOptionalHeaderLength(data->packetDictionary);
+    // ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader ensures that HeaderLength is at least the fixed header
+    size_t optionalHeaderLength = data->fixedHeader.headerLength - sizeof(CCNxCodecSchemaV1FixedHeader);
     CCNxCodecTlvDecoder *optionalHeaderDecoder = ccnxCodecTlvDecoder_GetContainer(data->decoder, optionalHeaderLength);
 
     bool success = ccnxCodecSchemaV1OptionalHeadersDecoder_Decode(optionalHeaderDecoder, data->packetDictionary);
@@ -148,8 +150,8 @@ _decodeMessage(_CCNxCodecSchemaV1Data *data)
         }
 
         // cross check with the fixed header value
-        // ccnxCodecSchemaV1FixedHeaderDecoder_Decode ensures that PacketLength is not less than HeaderLength
-        size_t messageLength = ccnxCodecSchemaV1FixedHeaderDecoder_GetPacketLength(data->packetDictionary) - ccnxCodecSchemaV1FixedHeaderDecoder_GetHeaderLength(data->packetDictionary);
+        // ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader ensures that PacketLength is not less than HeaderLength
+        size_t messageLength = data->fixedHeader.packetLength - data->fixedHeader.headerLength;
 
         if (tlv_length <= messageLength && ccnxCodecTlvDecoder_EnsureRemaining(data->decoder, tlv_length)) {
             // This decode is for the "value" of the message, it does not include the wrapper
@@ -248,7 +250,7 @@ ccnxCodecSchemaV1PacketDecoder_Decode(CCNxCodecTlvDecoder *packetDecoder, CCNxTl
     data.packetDictionary = packetDictionary;
     data.decoder = packetDecoder;
 
-    if (ccnxCodecSchemaV1FixedHeaderDecoder_Decode(data.decoder, data.packetDictionary)) {
+    if (ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader(data.decoder, data.packetDictionary, &data.fixedHeader)) {
         if (_decodeOptionalHeaders(&data)) {
             // Record the position we'd start the signature verification at
             size_t signatureStartPosition = ccnxCodecTlvDecoder_Position(data.decoder);
@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <sys/time.h>
 #include <inttypes.h>
+#include <stddef.h>
 
 #include <LongBow/runtime.h>
 #include <parc/algol/parc_Memory.h>
@@ -126,6 +127,31 @@ _encodeOptionalHeaders(CCNxCodecTlvEncoder *optionalHeaderEncoder, CCNxTlvDictio
     return optionalHeadersLength;
 }
 
+/**
+ * The number of bytes _encodeCPI() will append.  A JSON payload is serialized to measure it.
+ */
+static size_t
+_getCPILength(CCNxTlvDictionary *packetDictionary)
+{
+    size_t payloadLength = 0;
+
+    if (ccnxTlvDictionary_IsValueJson(packetDictionary,
+                                      CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD)) {
+        PARCJSON *json = ccnxTlvDictionary_GetJson(packetDictionary,
+                                                   CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+        if (json) {
+            char *jsonString = parcJSON_ToCompactString(json);
+            payloadLength = strlen(jsonString);
+            parcMemory_Deallocate((void **) &jsonString);
+        }
+    } else {
+        PARCBuffer *payload = ccnxTlvDictionary_GetBuffer(packetDictionary,
+                                                          CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+        payloadLength = parcBuffer_Remaining(payload);
+    }
+    return payloadLength;
+}
+
 /**
  * CPI payload is simply a dump of the PAYLOAD dictionary entry.
  *
@@ -172,10 +198,60 @@ _encodeCPI(CCNxCodecTlvEncoder *cpiEncoder, CCNxTlvDictionary *packetDictionary)
     return payloadLength;
 }
 
+/**
+ * Determine the fixed header PacketType and the message TLV type from the kind of message
+ *
+ * @return true The dictionary is a known message type
+ * @return false Unknown message type
+ */
+static bool
+_getMessageTypes(CCNxTlvDictionary *packetDictionary, CCNxCodecSchemaV1Types_PacketType *packetTypePtr, uint16_t *messageTypePtr)
+{
+    bool known = true;
+
+    if (ccnxTlvDictionary_IsInterest(packetDictionary)) {
+        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_Interest;
+        *messageTypePtr = CCNxCodecSchemaV1Types_MessageType_Interest;
+    } else if (ccnxTlvDictionary_IsInterestReturn(packetDictionary)) {
+        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_InterestReturn;
+        *messageTypePtr = CCNxCodecSchemaV1Types_MessageType_Interest;
+    } else if (ccnxTlvDictionary_IsContentObject(packetDictionary)) {
+        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_ContentObject;
+        *messageTypePtr = CCNxCodecSchemaV1Types_MessageType_ContentObject;
+    } else if (ccnxTlvDictionary_IsControl(packetDictionary)) {
+        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_Control;
+        *messageTypePtr = CCNxCodecSchemaV1Types_MessageType_Control;
+    } else {
+        known = false;
+    }
+    return known;
+}
+
+/**
+ * The length of the message body, not including the message TL container
+ *
+ * @return non-negative The inner length of the message
+ * @return -1 Unknown message type or a mandatory field is missing
+ */
+static ssize_t
+_getMessageInnerLength(CCNxTlvDictionary *packetDictionary)
+{
+    ssize_t innerLength = -1;
+    if (ccnxTlvDictionary_IsControl(packetDictionary)) {
+        innerLength = _getCPILength(packetDictionary);
+    } else if (ccnxTlvDictionary_IsInterest(packetDictionary) ||
+               ccnxTlvDictionary_IsInterestReturn(packetDictionary) ||
+               ccnxTlvDictionary_IsContentObject(packetDictionary)) {
+        innerLength = ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(packetDictionary);
+    }
+    return innerLength;
+}
+
 /**
  * Encode the CCNx Message
  *
- * <#Paragraphs Of Explanation#>
+ * The message body is measured first, so the TL container is written once with its
+ * final length followed by the body.
  *
  * @param [out] packetTypePtr The type to use for the PacketType based on the message type
  *
@@ -190,34 +266,26 @@ _encodeCPI(CCNxCodecTlvEncoder *cpiEncoder, CCNxTlvDictionary *packetDictionary)
 static ssize_t
 _encodeMessage(CCNxCodecTlvEncoder *packetEncoder, CCNxTlvDictionary *packetDictionary, CCNxCodecSchemaV1Types_PacketType *packetTypePtr)
 {
-    ssize_t startPosition = ccnxCodecTlvEncoder_Position(packetEncoder);
     ssize_t innerLength = -1;
+    uint16_t messageType;
 
     // what kind of message is it?  need this to set the packetTypePtr
-
-    if (ccnxTlvDictionary_IsInterest(packetDictionary)) {
-        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_Interest;
-        ccnxCodecTlvEncoder_AppendContainer(packetEncoder, CCNxCodecSchemaV1Types_MessageType_Interest, 0);
-        innerLength = ccnxCodecSchemaV1MessageEncoder_Encode(packetEncoder, packetDictionary);
-    } else if (ccnxTlvDictionary_IsInterestReturn(packetDictionary)) {
-        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_InterestReturn;
-        ccnxCodecTlvEncoder_AppendContainer(packetEncoder, CCNxCodecSchemaV1Types_MessageType_Interest, 0);
-        innerLength = ccnxCodecSchemaV1MessageEncoder_Encode(packetEncoder, packetDictionary);
-    } else if (ccnxTlvDictionary_IsContentObject(packetDictionary)) {
-        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_ContentObject;
-        ccnxCodecTlvEncoder_AppendContainer(packetEncoder, CCNxCodecSchemaV1Types_MessageType_ContentObject, 0);
-        innerLength = ccnxCodecSchemaV1MessageEncoder_Encode(packetEncoder, packetDictionary);
-    } else if (ccnxTlvDictionary_IsControl(packetDictionary)) {
-        *packetTypePtr = CCNxCodecSchemaV1Types_PacketType_Control;
-        ccnxCodecTlvEncoder_AppendContainer(packetEncoder, CCNxCodecSchemaV1Types_MessageType_Control, 0);
-        innerLength = _encodeCPI(packetEncoder, packetDictionary);
+    if (_getMessageTypes(packetDictionary, packetTypePtr, &messageType)) {
+        ssize_t expectedLength = _getMessageInnerLength(packetDictionary);
+        if (expectedLength >= 0) {
+            ccnxCodecTlvEncoder_AppendContainer(packetEncoder, messageType, expectedLength);
+            if (ccnxTlvDictionary_IsControl(packetDictionary)) {
+                innerLength = _encodeCPI(packetEncoder, packetDictionary);
+            } else {
+                innerLength = ccnxCodecSchemaV1MessageEncoder_Encode(packetEncoder, packetDictionary);
+            }
+            trapUnexpectedStateIf(innerLength >= 0 && innerLength != expectedLength,
+                                  "message encoded %zd bytes, expected %zd", innerLength, expectedLength);
+        }
     }
 
     if (innerLength >= 0) {
-        // For a 0 length message, we do not backup and erase the TLV container.
-        ccnxCodecTlvEncoder_SetContainerLength(packetEncoder, startPosition, innerLength);
-        ssize_t endPosition = ccnxCodecTlvEncoder_Position(packetEncoder);
-        innerLength = endPosition - startPosition;
+        innerLength += 4;
     } else {
         CCNxCodecError *error = ccnxCodecError_Create(TLV_MISSING_MANDATORY, __func__, __LINE__, ccnxCodecTlvEncoder_Position(packetEncoder));
         ccnxCodecTlvEncoder_SetError(packetEncoder, error);
@@ -227,26 +295,35 @@ _encodeMessage(CCNxCodecTlvEncoder *packetEncoder, CCNxTlvDictionary *packetDict
     return innerLength;
 }
 
+/**
+ * A packet needs a Validation Algorithm if it names a CryptoSuite.
+ * Temporary exception for Content Objects, which are all signed if the codec has a signer.
+ */
+static bool
+_wantsValidation(CCNxTlvDictionary *packetDictionary)
+{
+    return ccnxValidationFacadeV1_HasCryptoSuite(packetDictionary) || ccnxTlvDictionary_IsContentObject(packetDictionary);
+}
+
 static ssize_t
 _encodeValidationAlg(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
 {
     ssize_t innerLength = 0;
 
     // There must be a CryptoSuite in the packet to sign it.
-    // Temporary exception for Content Objects, which are all signed if the codec has a signer.
-    if (ccnxValidationFacadeV1_HasCryptoSuite(packetDictionary) || ccnxTlvDictionary_IsContentObject(packetDictionary)) {
-        ssize_t startPosition = ccnxCodecTlvEncoder_Position(encoder);
-
-        ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_MessageType_ValidationAlg, 0);
-        innerLength = ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(encoder, packetDictionary);
-
-        if (innerLength == 0) {
-            // backup and erase the container
-            ccnxCodecTlvEncoder_SetPosition(encoder, startPosition);
-        } else if (innerLength >= 0) {
-            ccnxCodecTlvEncoder_SetContainerLength(encoder, startPosition, innerLength);
-            ssize_t endPosition = ccnxCodecTlvEncoder_Position(encoder);
-            return endPosition - startPosition;
+    if (_wantsValidation(packetDictionary)) {
+        ssize_t expectedLength = ccnxCodecSchemaV1ValidationEncoder_GetAlgLength(packetDictionary, ccnxCodecTlvEncoder_GetSigner(encoder));
+
+        // A 0 length means there is no algorithm, so no container either
+        if (expectedLength > 0) {
+            ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_MessageType_ValidationAlg, expectedLength);
+            innerLength = ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(encoder, packetDictionary);
+            if (innerLength >= 0) {
+                trapUnexpectedStateIf(innerLength != expectedLength, "ValidationAlg encoded %zd bytes, expected %zd", innerLength, expectedLength);
+                return 4 + innerLength;
+            }
+        } else {
+            innerLength = expectedLength;
         }
     }
 
@@ -256,21 +333,136 @@ _encodeValidationAlg(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDict
 static ssize_t
 _encodeValidationPayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
 {
-    ssize_t startPosition = ccnxCodecTlvEncoder_Position(encoder);
-
-    ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_MessageType_ValidationPayload, 0);
-    ssize_t innerLength = ccnxCodecSchemaV1ValidationEncoder_EncodePayload(encoder, packetDictionary);
-
-    if (innerLength == 0) {
-        // backup and erase the container
-        ccnxCodecTlvEncoder_SetPosition(encoder, startPosition);
-    } else if (innerLength > 0) {
-        ccnxCodecTlvEncoder_SetContainerLength(encoder, startPosition, innerLength);
-        ssize_t endPosition = ccnxCodecTlvEncoder_Position(encoder);
-        return endPosition - startPosition;
+    // Fills in the signature first if the encoder must compute it, so we know the length
+    ssize_t expectedLength = ccnxCodecSchemaV1ValidationEncoder_Sign(encoder, packetDictionary);
+
+    if (expectedLength > 0) {
+        ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_MessageType_ValidationPayload, expectedLength);
+        ssize_t innerLength = ccnxCodecSchemaV1ValidationEncoder_EncodePayload(encoder, packetDictionary);
+        if (innerLength < 0) {
+            return innerLength;
+        }
+        trapUnexpectedStateIf(innerLength != expectedLength, "ValidationPayload encoded %zd bytes, expected %zd", innerLength, expectedLength);
+        return 4 + innerLength;
     }
 
-    return innerLength;
+    return expectedLength;
+}
+
+/**
+ * The encoded size of each section of a packet, including its TL container
+ */
+typedef struct packet_lengths {
+    size_t optionalHeaders;
+    size_t message;
+    size_t validationAlg;      /**< 0 if there is no validation */
+    ssize_t validationPayload; /**< 0 if there is none, -1 if the signer will compute it with an unknown length */
+} _PacketLengths;
+
+/**
+ * Measure each section of the packet without encoding it
+ *
+ * @param [in] signer The signer the encoder will use, may be NULL
+ * @param [out] lengths The section lengths
+ *
+ * @return TLV_ERR_NO_ERROR The lengths are set
+ * @return other The error the encoder would have reported
+ */
+static CCNxCodecErrorCodes
+_computeLengths(CCNxTlvDictionary *packetDictionary, PARCSigner *signer, _PacketLengths *lengths)
+{
+    memset(lengths, 0, sizeof(_PacketLengths));
+
+    ssize_t optionalHeadersLength = ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength(packetDictionary);
+    if (optionalHeadersLength < 0) {
+        return TLV_ERR_PACKETTYPE;
+    }
+    lengths->optionalHeaders = optionalHeadersLength;
+
+    ssize_t messageLength = _getMessageInnerLength(packetDictionary);
+    if (messageLength < 0) {
+        return TLV_MISSING_MANDATORY;
+    }
+    lengths->message = 4 + messageLength;
+
+    if (_wantsValidation(packetDictionary)) {
+        ssize_t algLength = ccnxCodecSchemaV1ValidationEncoder_GetAlgLength(packetDictionary, signer);
+        if (algLength < 0) {
+            return TLV_MISSING_MANDATORY;
+        }
+
+        if (algLength > 0) {
+            lengths->validationAlg = 4 + algLength;
+
+            ssize_t payloadLength = ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(packetDictionary, signer);
+            lengths->validationPayload = (payloadLength > 0) ? 4 + payloadLength : payloadLength;
+        }
+    }
+
+    return TLV_ERR_NO_ERROR;
+}
+
+/**
+ * Encode the packet forward-only, using the section lengths from _computeLengths()
+ *
+ * The fixed header and every TL container are written once with their final lengths.  The
+ * only exception is a signature computed by the encoder's signer whose length is not known
+ * until the protected region is signed.  In that case the 2 byte PacketLength of the fixed
+ * header is put after signing.
+ */
+static ssize_t
+_encodeWithLengths(CCNxCodecTlvEncoder *packetEncoder, CCNxTlvDictionary *packetDictionary, const _PacketLengths *lengths)
+{
+    CCNxCodecSchemaV1Types_PacketType packetType;
+    uint16_t messageType;
+    _getMessageTypes(packetDictionary, &packetType, &messageType);
+
+    size_t headerLength = sizeof(CCNxCodecSchemaV1FixedHeader) + lengths->optionalHeaders;
+    size_t packetLength = headerLength + lengths->message + lengths->validationAlg;
+    if (lengths->validationPayload > 0) {
+        packetLength += lengths->validationPayload;
+    }
+
+    size_t fixedHeaderPosition = ccnxCodecTlvEncoder_Position(packetEncoder);
+    _encodeFixedHeader(packetEncoder, packetDictionary, packetType, headerLength, packetLength);
+
+    ssize_t optionalHeadersLength = _encodeOptionalHeaders(packetEncoder, packetDictionary);
+    if (optionalHeadersLength < 0) {
+        return -1;
+    }
+
+    ccnxCodecTlvEncoder_MarkSignatureStart(packetEncoder);
+
+    ssize_t messageLength = _encodeMessage(packetEncoder, packetDictionary, &packetType);
+    if (messageLength < 0) {
+        return -1;
+    }
+
+    // validation is optional, so it's ok if its 0 length
+    if (lengths->validationAlg > 0) {
+        if (_encodeValidationAlg(packetEncoder, packetDictionary) < 0) {
+            return -1;
+        }
+        ccnxCodecTlvEncoder_MarkSignatureEnd(packetEncoder);
+
+        ssize_t validationPayloadLength = _encodeValidationPayload(packetEncoder, packetDictionary);
+        if (validationPayloadLength < 0) {
+            return -1;
+        }
+
+        if (validationPayloadLength != lengths->validationPayload) {
+            // The signer just computed a signature whose length we could not predict, so now we know the packet length
+            packetLength += validationPayloadLength - ((lengths->validationPayload > 0) ? lengths->validationPayload : 0);
+            ccnxCodecTlvEncoder_PutUint16(packetEncoder,
+                                          fixedHeaderPosition + offsetof(CCNxCodecSchemaV1FixedHeader, packetLength),
+                                          (uint16_t) packetLength);
+        }
+    }
+
+    ssize_t length = ccnxCodecTlvEncoder_Position(packetEncoder) - fixedHeaderPosition;
+    trapUnexpectedStateIf(packetLength != length, "packet length %zu not equal to measured length %zd", packetLength, length);
+
+    return length;
 }
 
 // =====================================================
@@ -281,7 +473,13 @@ ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCNxTlvDictionary *packetDiction
 {
     CCNxCodecNetworkBufferIoVec *outputBuffer = NULL;
 
-    CCNxCodecTlvEncoder *packetEncoder = ccnxCodecTlvEncoder_Create();
+    // If we know the exact length, the packet is encoded in to a single memory block.  A large
+    // payload is referenced rather than copied, so it does not need room in that block.
+    ssize_t expectedLength = ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(packetDictionary, signer);
+    if (expectedLength > 0) {
+        expectedLength -= ccnxCodecSchemaV1MessageEncoder_GetPayloadReferenceLength(packetDictionary);
+    }
+    CCNxCodecTlvEncoder *packetEncoder = (expectedLength > 0) ? ccnxCodecTlvEncoder_CreateWithCapacity(expectedLength) : ccnxCodecTlvEncoder_Create();
 
     if (signer) {
         ccnxCodecTlvEncoder_SetSigner(packetEncoder, signer);
@@ -308,53 +506,79 @@ ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCNxTlvDictionary *packetDiction
     return outputBuffer;
 }
 
-ssize_t
-ccnxCodecSchemaV1PacketEncoder_Encode(CCNxCodecTlvEncoder *packetEncoder, CCNxTlvDictionary *packetDictionary)
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecSchemaV1PacketEncoder_BatchEncode(CCNxTlvDictionary *packetDictionaries[], size_t count, PARCSigner *signer, size_t firstIndex[])
 {
-    ssize_t length = -1;
+    assertTrue(count == 0 || packetDictionaries != NULL, "Parameter packetDictionaries must be non-null");
+    assertNotNull(firstIndex, "Parameter firstIndex must be non-null");
 
-    // We will need to go back and fixedup the headers
-    ssize_t fixedHeaderPosition = ccnxCodecTlvEncoder_Position(packetEncoder);
-    ssize_t fixedHeaderLength = _encodeFixedHeader(packetEncoder, packetDictionary, -1, 0, 0);
+    size_t *ends = NULL;
+    if (count > 0) {
+        ends = parcMemory_Allocate(sizeof(size_t) * count);
+        assertNotNull(ends, "parcMemory_Allocate(%zu) returned NULL", sizeof(size_t) * count);
+    }
 
-    ssize_t optionalHeadersLength = _encodeOptionalHeaders(packetEncoder, packetDictionary);
+    CCNxCodecTlvEncoder *packetEncoder = ccnxCodecTlvEncoder_Create();
 
-    if (optionalHeadersLength >= 0) {
-        ccnxCodecTlvEncoder_MarkSignatureStart(packetEncoder);
+    if (signer) {
+        ccnxCodecTlvEncoder_SetSigner(packetEncoder, signer);
+    }
 
-        CCNxCodecSchemaV1Types_PacketType messageType = -1;
-        ssize_t messageLength = _encodeMessage(packetEncoder, packetDictionary, &messageType);
-        if (messageLength >= 0) {
-            // validation is optional, so it's ok if its 0 length
-            ssize_t validationAlgLength = _encodeValidationAlg(packetEncoder, packetDictionary);
-            ssize_t validationPayloadLength = 0;
-            if (validationAlgLength > 0) {
-                ccnxCodecTlvEncoder_MarkSignatureEnd(packetEncoder);
+    for (size_t i = 0; i < count; i++) {
+        CCNxTlvDictionary *packetDictionary = packetDictionaries[i];
+        size_t startPosition = ccnxCodecTlvEncoder_Position(packetEncoder);
 
-                validationPayloadLength = _encodeValidationPayload(packetEncoder, packetDictionary);
-            }
+        ssize_t encodedLength = -1;
+        if (packetDictionary && ccnxTlvDictionary_GetSchemaVersion(packetDictionary) == CCNxTlvDictionary_SchemaVersion_V1) {
+            encodedLength = ccnxCodecSchemaV1PacketEncoder_Encode(packetEncoder, packetDictionary);
+        }
 
-            if (validationAlgLength >= 0 && validationPayloadLength >= 0) {
-                // now fix up the fixed header
-                size_t endPosition = ccnxCodecTlvEncoder_Position(packetEncoder);
+        if (encodedLength <= 0) {
+            // Drop whatever was written for this packet, the next one starts in its place
+            ccnxCodecTlvEncoder_ClearError(packetEncoder);
+            ccnxCodecTlvEncoder_SetPosition(packetEncoder, startPosition);
+            ccnxCodecTlvEncoder_Finalize(packetEncoder);
+        }
 
-                size_t headerLength = fixedHeaderLength + optionalHeadersLength;
-                size_t packetLength = headerLength + messageLength + validationAlgLength + validationPayloadLength;
+        ends[i] = ccnxCodecTlvEncoder_Position(packetEncoder);
+    }
 
-                // Will this work for InterestReturn?  As long as _encodeMessage returns InterestReturn it
-                // will be ok.
-                int packetType = messageType;
+    ccnxCodecTlvEncoder_Finalize(packetEncoder);
+    CCNxCodecNetworkBufferIoVec *outputBuffer = ccnxCodecTlvEncoder_CreateIoVecRanges(packetEncoder, count, ends, firstIndex);
 
-                ccnxCodecTlvEncoder_SetPosition(packetEncoder, fixedHeaderPosition);
-                _encodeFixedHeader(packetEncoder, packetDictionary, packetType, headerLength, packetLength);
-                ccnxCodecTlvEncoder_SetPosition(packetEncoder, endPosition);
-                length = endPosition - fixedHeaderPosition;
+    ccnxCodecTlvEncoder_Destroy(&packetEncoder);
+    if (ends) {
+        parcMemory_Deallocate((void **) &ends);
+    }
 
-                trapUnexpectedStateIf(packetLength != length, "packet length %zu not equal to measured length %zd", packetLength, length);
-            }
-        }
+    return outputBuffer;
+}
+
+ssize_t
+ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
+{
+    assertNotNull(packetDictionary, "Parameter packetDictionary must be non-null");
+
+    _PacketLengths lengths;
+    if (_computeLengths(packetDictionary, signer, &lengths) != TLV_ERR_NO_ERROR || lengths.validationPayload < 0) {
+        return -1;
     }
 
-    return length;
+    return sizeof(CCNxCodecSchemaV1FixedHeader) + lengths.optionalHeaders + lengths.message +
+           lengths.validationAlg + lengths.validationPayload;
 }
 
+ssize_t
+ccnxCodecSchemaV1PacketEncoder_Encode(CCNxCodecTlvEncoder *packetEncoder, CCNxTlvDictionary *packetDictionary)
+{
+    _PacketLengths lengths;
+    CCNxCodecErrorCodes errorCode = _computeLengths(packetDictionary, ccnxCodecTlvEncoder_GetSigner(packetEncoder), &lengths);
+    if (errorCode != TLV_ERR_NO_ERROR) {
+        CCNxCodecError *error = ccnxCodecError_Create(errorCode, __func__, __LINE__, ccnxCodecTlvEncoder_Position(packetEncoder));
+        ccnxCodecTlvEncoder_SetError(packetEncoder, error);
+        ccnxCodecError_Release(&error);
+        return -1;
+    }
+
+    return _encodeWithLengths(packetEncoder, packetDictionary, &lengths);
+}
@@ -73,6 +73,70 @@
  */
 CCNxCodecNetworkBufferIoVec *ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
 
+/**
+ * Encode several packetDictionaries to wire format with one encoder
+ *
+ * Each dictionary is encoded as with ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(), but all of
+ * them are appended to the same encoder and memory blocks, so the encoder and buffer setup is paid
+ * once for the batch.  The iovec elements of packet `i` are `array[firstIndex[i]]` through
+ * `array[firstIndex[i + 1] - 1]` of the returned IoVec.
+ *
+ * A dictionary that is NULL, not schema V1, or fails to encode has no elements
+ * (`firstIndex[i] == firstIndex[i + 1]`) and does not affect the others.
+ *
+ * @param [in] packetDictionaries An array of `count` dictionaries to encode
+ * @param [in] count The number of dictionaries
+ * @param [in] signer If not NULL will be used to sign each packet that does not carry its own validation
+ * @param [out] firstIndex Array of `count + 1` elements, the first iovec element of each packet
+ *
+ * @return non-null An IoVec holding all the packets, it must be released after they have been sent
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t firstIndex[count + 1];
+ *     CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_BatchEncode(contentObjects, count, NULL, firstIndex);
+ *     const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+ *     for (size_t i = 0; i < count; i++) {
+ *         writev(fd, &iov[firstIndex[i]], (int) (firstIndex[i + 1] - firstIndex[i]));
+ *     }
+ *     ccnxCodecNetworkBufferIoVec_Release(&vec);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecSchemaV1PacketEncoder_BatchEncode(CCNxTlvDictionary *packetDictionaries[], size_t count,
+                                                                        PARCSigner *signer, size_t firstIndex[]);
+
+/**
+ * Computes the exact wire format length of the packetDictionary without encoding it
+ *
+ * The length is what ccnxCodecSchemaV1PacketEncoder_Encode() will append with `signer` set on the
+ * encoder, so the caller can size its output, e.g. with ccnxCodecTlvEncoder_CreateWithCapacity().
+ *
+ * If the dictionary has no ValidationPayload, `signer` computes the signature while encoding.  The
+ * length is still known when the signer's signatures have a fixed length (CRC32C, HMAC and RSA, see
+ * ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength()).
+ *
+ * @param [in] packetDictionary The dictionary representation of the packet to encode
+ * @param [in] signer The signer that will be used to encode, may be NULL
+ *
+ * @retval positive The number of bytes in the encoded packet
+ * @retval -1 The packet cannot be encoded, or the signer's signature length is not known before signing
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t length = ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(packetDictionary, NULL);
+ *     if (length > 0) {
+ *         CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_CreateWithCapacity(length);
+ *         ccnxCodecSchemaV1PacketEncoder_Encode(encoder, packetDictionary);
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
+
 /**
  * Encode a packetDictionary to wire format.
  *
@@ -146,6 +146,47 @@ typedef enum rta_tlv_schema_v1_link_types {
     CCNxCodecSchemaV1Types_Link_ContentObjectHashRestriction = 0x0002,
 } CCNxCodecSchemaV1Types_Link;
 
+// ==================================================
+// Manifest
+
+/**
+ * @typedef CCNxCodecSchemaV1Types_Manifest
+ * @abstract The well-known keys for the MANIFEST body
+ * @constant CCNxCodecSchemaV1Types_Manifest_NameLink The Link naming the manifest
+ * @constant CCNxCodecSchemaV1Types_Manifest_MetadataSection A container of CCNxCodecSchemaV1Types_ManifestSection
+ * @constant CCNxCodecSchemaV1Types_Manifest_PayloadSection A container of CCNxCodecSchemaV1Types_ManifestSection
+ */
+typedef enum rta_tlv_schema_v1_manifest_types {
+    CCNxCodecSchemaV1Types_Manifest_NameLink = 0x0001,
+    CCNxCodecSchemaV1Types_Manifest_MetadataSection = 0x0002,
+    CCNxCodecSchemaV1Types_Manifest_PayloadSection = 0x0003,
+} CCNxCodecSchemaV1Types_Manifest;
+
+/**
+ * @typedef CCNxCodecSchemaV1Types_ManifestSection
+ * @abstract The well-known keys inside a manifest section
+ * @constant CCNxCodecSchemaV1Types_ManifestSection_AcsLink The Link to the access control specification
+ * @constant CCNxCodecSchemaV1Types_ManifestSection_NameEntry A container of CCNxCodecSchemaV1Types_ManifestNameEntry
+ * @constant CCNxCodecSchemaV1Types_ManifestSection_HashGroup A 4-byte name index followed by one or more SHA-256 digests
+ * @discussion Name entries are numbered in the order they appear, starting at 0.
+ */
+typedef enum rta_tlv_schema_v1_manifest_section_types {
+    CCNxCodecSchemaV1Types_ManifestSection_AcsLink = 0x0001,
+    CCNxCodecSchemaV1Types_ManifestSection_NameEntry = 0x0002,
+    CCNxCodecSchemaV1Types_ManifestSection_HashGroup = 0x0003,
+} CCNxCodecSchemaV1Types_ManifestSection;
+
+/**
+ * @typedef CCNxCodecSchemaV1Types_ManifestNameEntry
+ * @abstract The well-known keys inside a manifest name entry
+ * @constant CCNxCodecSchemaV1Types_ManifestNameEntry_Name The media name
+ * @constant CCNxCodecSchemaV1Types_ManifestNameEntry_Chunk The starting chunk number, as a VarInt
+ */
+typedef enum rta_tlv_schema_v1_manifest_name_entry_types {
+    CCNxCodecSchemaV1Types_ManifestNameEntry_Name = 0x0000,
+    CCNxCodecSchemaV1Types_ManifestNameEntry_Chunk = 0x0001,
+} CCNxCodecSchemaV1Types_ManifestNameEntry;
+
 // ==================================================
 // Interest Return
 
@@ -181,9 +181,8 @@ ccnxCodecSchemaV1ValidationDecoder_DecodePayload(CCNxCodecTlvDecoder *decoder, C
     // A 0-length payload is treaded like an error
     size_t remaining = ccnxCodecTlvDecoder_Remaining(decoder);
     if (remaining > 0) {
-        PARCBuffer *payload = ccnxCodecTlvDecoder_GetValue(decoder, remaining);
-        success = ccnxTlvDictionary_PutBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD, payload);
-        parcBuffer_Release(&payload);
+        success = ccnxCodecTlvUtilities_PutAsBuffer(decoder, packetDictionary, CCNxCodecSchemaV1Types_MessageType_ValidationPayload,
+                                                    (uint16_t) remaining, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
     }
     return success;
 }
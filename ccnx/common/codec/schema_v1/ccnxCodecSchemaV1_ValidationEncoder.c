@@ -31,6 +31,9 @@
 
 #include <config.h>
 #include <sys/time.h>
+
+#include <LongBow/runtime.h>
+
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
 
@@ -38,6 +41,7 @@
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_ValidationEncoder.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_LinkCodec.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_NameCodec.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_CryptoSuite.h>
 
 static ssize_t
@@ -87,20 +91,13 @@ _encodeKeyName(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary
         PARCBuffer *hash = ccnxTlvDictionary_GetBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYNAME_OBJHASH);
         CCNxLink *link = ccnxLink_Create(keyname, keyid, hash);
 
-        size_t startPosition = ccnxCodecTlvEncoder_Position(encoder);
-        ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_ValidationAlg_KeyName, 0);
-        ssize_t innerLength = ccnxCodecSchemaV1LinkCodec_Encode(encoder, link);
-
-        if (innerLength == 0) {
-            // backup and erase the container
-            ccnxCodecTlvEncoder_SetPosition(encoder, startPosition);
-        } else if (innerLength > 0) {
-            ccnxCodecTlvEncoder_SetContainerLength(encoder, startPosition, innerLength);
-            ssize_t endPosition = ccnxCodecTlvEncoder_Position(encoder);
-            length = endPosition - startPosition;
-        } else {
-            // an error signal
-            length = innerLength;
+        // The link length is known up front, so write the container once and append the link
+        ssize_t linkLength = ccnxCodecSchemaV1LinkCodec_GetEncodedLength(link);
+        if (linkLength > 0) {
+            ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_ValidationAlg_KeyName, linkLength);
+            ssize_t innerLength = ccnxCodecSchemaV1LinkCodec_Encode(encoder, link);
+            trapUnexpectedStateIf(innerLength != linkLength, "Link encoded %zd bytes, expected %zd", innerLength, linkLength);
+            length = 4 + innerLength;
         }
 
         ccnxLink_Release(&link);
@@ -185,45 +182,114 @@ _encodeAlgParameters(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDict
     return length;
 }
 
-ssize_t
-ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
+/**
+ * Determine the CryptoSuite from the dictionary, or for a ContentObject, from the signer
+ */
+static bool
+_getCryptoSuite(CCNxTlvDictionary *packetDictionary, PARCSigner *signer, CCNxCodecSchemaV1TlvDictionary_CryptoSuite *suitePtr)
 {
-    ssize_t length = 0;
     bool haveCryptoSuite = false;
-    CCNxCodecSchemaV1TlvDictionary_CryptoSuite suite;
 
     if (ccnxTlvDictionary_IsValueInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE)) {
         // try from dictionary
 
         PARCCryptoSuite parcSuite = (PARCCryptoSuite) ccnxTlvDictionary_GetInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE);
 
-        haveCryptoSuite = ccnxCodecSchemaV1CryptoSuite_ParcToTlv(parcSuite, &suite);
+        haveCryptoSuite = ccnxCodecSchemaV1CryptoSuite_ParcToTlv(parcSuite, suitePtr);
     } else if (ccnxTlvDictionary_IsContentObject(packetDictionary)) {
         // deduce from the signer
 
-        PARCSigner *signer = ccnxCodecTlvEncoder_GetSigner(encoder);
         if (signer != NULL) {
             PARCCryptoHashType hashType = parcSigner_GetCryptoHashType(signer);
             PARCSigningAlgorithm signAlg = parcSigner_GetSigningAlgorithm(signer);
 
-            if (ccnxCodecSchemaV1CryptoSuite_SignAndHashToTlv(signAlg, hashType, &suite)) {
+            if (ccnxCodecSchemaV1CryptoSuite_SignAndHashToTlv(signAlg, hashType, suitePtr)) {
                 haveCryptoSuite = true;
             }
         }
     }
 
-    if (haveCryptoSuite) {
-        // write the TL container then encode any enclosed TLVs
-        ssize_t startPosition = ccnxCodecTlvEncoder_Position(encoder);
+    return haveCryptoSuite;
+}
+
+static size_t
+_getBufferLength(CCNxTlvDictionary *packetDictionary, int key)
+{
+    size_t length = 0;
+    PARCBuffer *buffer = ccnxTlvDictionary_GetBuffer(packetDictionary, key);
+    if (buffer != NULL) {
+        length = 4 + parcBuffer_Remaining(buffer);
+    }
+    return length;
+}
+
+/**
+ * The number of bytes _encodeAlgParameters() will append.  Mirrors each of the _encodeX() functions.
+ */
+static ssize_t
+_getAlgParametersLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
+{
+    ssize_t length = 0;
+
+    length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYID);
+    length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEY);
+    length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CERT);
+
+    CCNxName *keyname = ccnxTlvDictionary_GetName(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYNAME_NAME);
+    if (keyname) {
+        // The KeyName is encoded as a Link: the name plus optional keyid and hash restrictions
+        length += 4 + ccnxCodecSchemaV1NameCodec_GetEncodedLength(keyname);
+        length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYNAME_KEYID);
+        length += _getBufferLength(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYNAME_OBJHASH);
+    }
+
+    bool haveSignTime = ccnxTlvDictionary_IsValueInteger(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_SIGNTIME);
+    if (!haveSignTime && signer) {
+        PARCSigningAlgorithm alg = parcSigner_GetSigningAlgorithm(signer);
+        haveSignTime = (alg != PARCSigningAlgortihm_NULL && alg != PARCSigningAlgorithm_UNKNOWN);
+    }
+    if (haveSignTime) {
+        length += 4 + 8;
+    }
+
+    return length;
+}
+
+ssize_t
+ccnxCodecSchemaV1ValidationEncoder_GetAlgLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
+{
+    assertNotNull(packetDictionary, "Parameter packetDictionary must be non-null");
+
+    ssize_t length = 0;
+    CCNxCodecSchemaV1TlvDictionary_CryptoSuite suite;
+    if (_getCryptoSuite(packetDictionary, signer, &suite)) {
+        ssize_t innerLength = _getAlgParametersLength(packetDictionary, signer);
+        length = (innerLength < 0) ? innerLength : 4 + innerLength;
+    }
+    return length;
+}
 
-        ccnxCodecTlvEncoder_AppendContainer(encoder, suite, 0);
+ssize_t
+ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
+{
+    ssize_t length = 0;
+    CCNxCodecSchemaV1TlvDictionary_CryptoSuite suite;
+    PARCSigner *signer = ccnxCodecTlvEncoder_GetSigner(encoder);
+
+    if (_getCryptoSuite(packetDictionary, signer, &suite)) {
+        // write the TL container with its final length, then encode any enclosed TLVs
+        ssize_t expectedLength = _getAlgParametersLength(packetDictionary, signer);
+        if (expectedLength < 0) {
+            return expectedLength;
+        }
+
+        ccnxCodecTlvEncoder_AppendContainer(encoder, suite, expectedLength);
         ssize_t innerLength = _encodeAlgParameters(encoder, packetDictionary);
 
         // 0 inner length is acceptable
         if (innerLength >= 0) {
-            ccnxCodecTlvEncoder_SetContainerLength(encoder, startPosition, innerLength);
-            ssize_t endPosition = ccnxCodecTlvEncoder_Position(encoder);
-            length = endPosition - startPosition;
+            trapUnexpectedStateIf(innerLength != expectedLength, "Alg parameters encoded %zd bytes, expected %zd", innerLength, expectedLength);
+            length = 4 + innerLength;
         } else {
             // an error signal
             length = innerLength;
@@ -232,11 +298,153 @@ ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(CCNxCodecTlvEncoder *encoder, CCNxT
     return length;
 }
 
+/**
+ * Reads the tag and length of a DER element at `*position` and moves `*position` to its value
+ *
+ * @return non-negative The length of the value
+ * @return -1 The tag is not `tag` or the element does not fit in `derLength` bytes
+ */
+static ssize_t
+_derReadHeader(const uint8_t *der, size_t derLength, size_t *position, uint8_t tag)
+{
+    if (*position + 2 > derLength || der[*position] != tag) {
+        return -1;
+    }
+
+    size_t valueLength = der[*position + 1];
+    *position += 2;
+
+    // The long form gives the number of length bytes that follow, 2 is plenty for a public key
+    if (valueLength & 0x80) {
+        size_t count = valueLength & 0x7F;
+        if (count == 0 || count > 2 || *position + count > derLength) {
+            return -1;
+        }
+        valueLength = 0;
+        for (size_t i = 0; i < count; i++) {
+            valueLength = (valueLength << 8) | der[(*position)++];
+        }
+    }
+
+    if (*position + valueLength > derLength) {
+        return -1;
+    }
+    return valueLength;
+}
+
+/**
+ * The length of the modulus of a DER encoded RSA SubjectPublicKeyInfo, which is the length of
+ * every signature made with the key.
+ *
+ * @return positive The modulus length in bytes
+ * @return -1 The key could not be parsed
+ */
+static ssize_t
+_rsaModulusLength(PARCBuffer *derPublicKey)
+{
+    const uint8_t *der = parcBuffer_Overlay(derPublicKey, 0);
+    size_t derLength = parcBuffer_Remaining(derPublicKey);
+    size_t position = 0;
+
+    // SEQUENCE { SEQUENCE algorithm, BIT STRING { SEQUENCE { INTEGER modulus, INTEGER exponent } } }
+    if (_derReadHeader(der, derLength, &position, 0x30) < 0) {
+        return -1;
+    }
+
+    ssize_t algorithmLength = _derReadHeader(der, derLength, &position, 0x30);
+    if (algorithmLength < 0) {
+        return -1;
+    }
+    position += algorithmLength;
+
+    // The first byte of the bit string is the number of unused bits, always 0 for a key
+    if (_derReadHeader(der, derLength, &position, 0x03) < 1 || der[position++] != 0) {
+        return -1;
+    }
+
+    if (_derReadHeader(der, derLength, &position, 0x30) < 0) {
+        return -1;
+    }
+
+    ssize_t modulusLength = _derReadHeader(der, derLength, &position, 0x02);
+    if (modulusLength < 1) {
+        return -1;
+    }
+
+    // A positive INTEGER whose high bit is set has a leading 0 byte that is not in the signature
+    while (modulusLength > 1 && der[position] == 0) {
+        position++;
+        modulusLength--;
+    }
+    return modulusLength;
+}
+
+/**
+ * The length of the signatures `signer` computes, if it is known before signing
+ *
+ * @return positive The signature length
+ * @return -1 The length is only known after signing
+ */
+static ssize_t
+_getSignatureLength(PARCSigner *signer)
+{
+    ssize_t length = -1;
+    switch (parcSigner_GetSigningAlgorithm(signer)) {
+        case PARCSigningAlgortihm_NULL:
+            // The CRC32C "signer" has no signing algorithm
+            if (parcSigner_GetCryptoHashType(signer) == PARC_HASH_CRC32C) {
+                length = 4;
+            }
+            break;
+
+        case PARCSigningAlgorithm_HMAC:
+            switch (parcSigner_GetCryptoHashType(signer)) {
+                case PARC_HASH_SHA256:
+                    length = 32;
+                    break;
+                case PARC_HASH_SHA512:
+                    length = 64;
+                    break;
+                default:
+                    break;
+            }
+            break;
+
+        case PARCSigningAlgorithm_RSA: {
+            PARCBuffer *derPublicKey = parcSigner_GetDEREncodedPublicKey(signer);
+            if (derPublicKey) {
+                length = _rsaModulusLength(derPublicKey);
+                parcBuffer_Release(&derPublicKey);
+            }
+            break;
+        }
+
+        default:
+            // DSA and ECDSA signatures vary in length
+            break;
+    }
+    return length;
+}
+
 ssize_t
-ccnxCodecSchemaV1ValidationEncoder_EncodePayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
+ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
 {
+    assertNotNull(packetDictionary, "Parameter packetDictionary must be non-null");
+
     ssize_t length = 0;
+    PARCBuffer *sigbits = ccnxTlvDictionary_GetBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
+    if (sigbits) {
+        length = parcBuffer_Remaining(sigbits);
+    } else if (signer) {
+        // The signature does not exist until the protected region is encoded, but its length may be fixed
+        length = _getSignatureLength(signer);
+    }
+    return length;
+}
 
+ssize_t
+ccnxCodecSchemaV1ValidationEncoder_Sign(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
+{
     if (!ccnxTlvDictionary_IsValueBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD)) {
         // try to compute a signature
 
@@ -255,8 +463,16 @@ ccnxCodecSchemaV1ValidationEncoder_EncodePayload(CCNxCodecTlvEncoder *encoder, C
         }
     }
 
-    PARCBuffer *sigbits = ccnxTlvDictionary_GetBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
-    if (sigbits) {
+    return ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(packetDictionary, NULL);
+}
+
+ssize_t
+ccnxCodecSchemaV1ValidationEncoder_EncodePayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
+{
+    ssize_t length = 0;
+
+    if (ccnxCodecSchemaV1ValidationEncoder_Sign(encoder, packetDictionary) > 0) {
+        PARCBuffer *sigbits = ccnxTlvDictionary_GetBuffer(packetDictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
         size_t remaining = parcBuffer_Remaining(sigbits);
         uint8_t *overlay = parcBuffer_Overlay(sigbits, 0);
         length = ccnxCodecTlvEncoder_AppendRawArray(encoder, remaining, overlay);
@@ -64,6 +64,27 @@
  */
 ssize_t ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1ValidationEncoder_EncodeAlg() would append
+ *
+ * `signer` stands in for the encoder's signer: it is used to deduce the CryptoSuite of
+ * a ContentObject and decides if a signing time will be added.
+ *
+ * @param [in] packetDictionary The dictionary containing the validation fields
+ * @param [in] signer The signer the encoder will use, may be NULL
+ *
+ * @return non-negative Total bytes the validation algorithm will use, 0 if there is none
+ * @return -1 An error
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t algLength = ccnxCodecSchemaV1ValidationEncoder_GetAlgLength(packetDictionary, signer);
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1ValidationEncoder_GetAlgLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
+
 /**
  * Appends the Validation Payload to the packet encoder
  *
@@ -89,4 +110,56 @@ ssize_t ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(CCNxCodecTlvEncoder *encode
  */
 ssize_t ccnxCodecSchemaV1ValidationEncoder_EncodePayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * Returns the number of bytes ccnxCodecSchemaV1ValidationEncoder_EncodePayload() would append
+ *
+ * If the dictionary already has a Validation Payload, this is its length.  If it does not
+ * and `signer` is non-NULL, the encoder will compute the signature over the encoded packet.
+ * Its length is then the signer's signature length: 4 bytes for CRC32C, the digest length
+ * for HMAC and the modulus length for RSA.  Other signers, such as DSA, make signatures
+ * whose length is not known before signing.
+ *
+ * @param [in] packetDictionary The dictionary containing the validation fields
+ * @param [in] signer The signer the encoder will use, may be NULL
+ *
+ * @return non-negative Total bytes the validation payload will use, 0 if there is none
+ * @return -1 The length is only known after signing
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t payloadLength = ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(packetDictionary, signer);
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
+
+/**
+ * Computes the signature, if needed, and stores it as the Validation Payload in the dictionary
+ *
+ * If the dictionary has no Validation Payload and the encoder has a signer, this signs the
+ * protected region marked with ccnxCodecTlvEncoder_MarkSignatureStart() and
+ * ccnxCodecTlvEncoder_MarkSignatureEnd().  Nothing is appended to the encoder, so the caller
+ * can write the ValidationPayload TL container with the returned length before calling
+ * ccnxCodecSchemaV1ValidationEncoder_EncodePayload().
+ *
+ * @param [in] encoder The encoder holding the protected region and the signer
+ * @param [in] packetDictionary The dictionary to store the signature in
+ *
+ * @return non-negative The length of the Validation Payload, 0 if there is none
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxCodecTlvEncoder_MarkSignatureEnd(encoder);
+ *     ssize_t payloadLength = ccnxCodecSchemaV1ValidationEncoder_Sign(encoder, packetDictionary);
+ *     if (payloadLength > 0) {
+ *         ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_MessageType_ValidationPayload, payloadLength);
+ *         ccnxCodecSchemaV1ValidationEncoder_EncodePayload(encoder, packetDictionary);
+ *     }
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1ValidationEncoder_Sign(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary);
+
 #endif /* defined(__CCNx_Common__ccnxCodecSchemaV1_ValidationEncoder__) */
@@ -108,6 +108,8 @@ LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodecSchemaV1_FixedHeaderDecoder)
 LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_Decode_Underrun);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader_Lazy);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_GetHeaderLength);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_GetPacketType);
@@ -181,6 +183,34 @@ LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_GetPacketType)
     assertTrue(packetType == data->packetType, "Wrong packetType, got %d expected %d", packetType, data->packetType);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    // The test header is version 0, which fails validation, but its fields are still returned
+    CCNxCodecSchemaV1FixedHeader header;
+    ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader(data->decoder, data->dictionary, &header);
+    assertTrue(header.packetType == data->packetType, "Wrong packetType, got %u expected %u", header.packetType, data->packetType);
+    assertTrue(header.packetLength == data->packetLength, "Wrong packetLength, got %u expected %u", header.packetLength, data->packetLength);
+    assertTrue(header.headerLength == data->headerLength, "Wrong headerLength, got %u expected %u", header.headerLength, data->headerLength);
+    assertTrue(ccnxTlvDictionary_GetBuffer(data->dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_FixedHeader) != NULL,
+               "The fixed header should be in the dictionary");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader_Lazy)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->dictionary, data->fixedHeader);
+
+    // The test header is version 0, which fails validation, but its fields are still returned
+    CCNxCodecSchemaV1FixedHeader header;
+    ccnxCodecSchemaV1FixedHeaderDecoder_DecodeHeader(data->decoder, data->dictionary, &header);
+    assertTrue(header.packetLength == data->packetLength, "Wrong packetLength, got %u expected %u", header.packetLength, data->packetLength);
+
+    // The header is only sliced when it is asked for
+    int hopLimit = ccnxCodecSchemaV1FixedHeaderDecoder_GetHopLimit(data->dictionary);
+    assertTrue(hopLimit == data->hopLimit, "Wrong hopLimit, got %d expected %d", hopLimit, data->hopLimit);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1FixedHeaderDecoder_GetPacketLength)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
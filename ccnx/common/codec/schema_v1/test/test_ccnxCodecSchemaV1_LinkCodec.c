@@ -64,6 +64,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecLink_DecodeValue_Underrun);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1LinkCodec_Encode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1LinkCodec_GetEncodedLength);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -451,6 +452,28 @@ LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1LinkCodec_Encode)
     ccnxCodecTlvEncoder_Destroy(&encoder);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1LinkCodec_GetEncodedLength)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/2=rope");
+    PARCBuffer *keyid = parcBuffer_WrapCString("keyid");
+    PARCBuffer *hash = parcBuffer_WrapCString("hash");
+
+    CCNxLink *nameOnly = ccnxLink_Create(name, NULL, NULL);
+    CCNxLink *allFields = ccnxLink_Create(name, keyid, hash);
+
+    ssize_t length = ccnxCodecSchemaV1LinkCodec_GetEncodedLength(nameOnly);
+    assertTrue(length == 12, "Wrong length, expected 12 got %zd", length);
+
+    length = ccnxCodecSchemaV1LinkCodec_GetEncodedLength(allFields);
+    assertTrue(length == 12 + 4 + 5 + 4 + 4, "Wrong length, expected %d got %zd", 12 + 4 + 5 + 4 + 4, length);
+
+    ccnxLink_Release(&allFields);
+    ccnxLink_Release(&nameOnly);
+    parcBuffer_Release(&hash);
+    parcBuffer_Release(&keyid);
+    ccnxName_Release(&name);
+}
+
 int
 main(int argc, char *argv[])
 {
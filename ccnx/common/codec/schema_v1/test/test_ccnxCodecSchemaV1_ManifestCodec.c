@@ -0,0 +1,727 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxCodecSchemaV1_ManifestCodec.c"
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+#include <sys/time.h>
+
+#include <ccnx/common/codec/ccnxCodec_Error.h>
+
+typedef struct test_data {
+    PARCBuffer *signatureBits;
+    PARCSignature *signature;
+    CCNxName *acsName;
+    CCNxLink *acsLink;
+    CCNxName *manifestName;
+    CCNxLink *nameLink;
+    CCNxName *nameA;
+    CCNxName *nameB;
+} TestData;
+
+static PARCBuffer *
+_createDigest(uint8_t fill)
+{
+    PARCBuffer *digest = parcBuffer_Allocate(CCNxCodecSchemaV1ManifestCodec_DigestLength);
+    for (size_t i = 0; i < CCNxCodecSchemaV1ManifestCodec_DigestLength; i++) {
+        parcBuffer_PutUint8(digest, (uint8_t) (fill + i));
+    }
+    return parcBuffer_Flip(digest);
+}
+
+/*
+ * Name entry 0 (nameA, chunk 3) has digests 0x10 and 0x20, name entry 1 (nameB, chunk 300) has digest 0x30,
+ * then name entry 0 again has digest 0x40.
+ */
+static CCNxManifestSection *
+_createSection(TestData *data, CCNxLink *acsLink)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(acsLink);
+    size_t indexA = ccnxManifestSection_AddName(section, data->nameA, 3);
+    size_t indexB = ccnxManifestSection_AddName(section, data->nameB, 300);
+
+    uint8_t fills[] = { 0x10, 0x20, 0x30, 0x40 };
+    size_t nameIndexes[] = { indexA, indexA, indexB, indexA };
+    for (size_t i = 0; i < sizeof(fills); i++) {
+        PARCBuffer *digest = _createDigest(fills[i]);
+        ccnxManifestSection_AddHash(section, nameIndexes[i], digest);
+        parcBuffer_Release(&digest);
+    }
+    return section;
+}
+
+static PARCBuffer *
+_encodeManifest(const CCNxManifest *manifest)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ssize_t length = ccnxCodecSchemaV1ManifestCodec_Encode(encoder, manifest);
+    assertTrue(length > 0, "Could not encode manifest: %s", ccnxCodecError_ToString(ccnxCodecTlvEncoder_GetError(encoder)));
+    ccnxCodecTlvEncoder_Finalize(encoder);
+    PARCBuffer *buffer = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    return buffer;
+}
+
+static PARCBuffer *
+_encodeSection(const CCNxManifestSection *section)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ssize_t length = ccnxCodecSchemaV1ManifestCodec_EncodeSection(encoder, section);
+    assertTrue(length >= 0, "Could not encode section: %s", ccnxCodecError_ToString(ccnxCodecTlvEncoder_GetError(encoder)));
+    ccnxCodecTlvEncoder_Finalize(encoder);
+    PARCBuffer *buffer = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    return buffer;
+}
+
+/*
+ * Decodes a section and returns the decoder's error code, releasing any section decoded
+ */
+static CCNxCodecErrorCodes
+_decodeSectionError(uint8_t *encoded, size_t length)
+{
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, length, 0, length);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxManifestSection *section = ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(decoder, (uint16_t) length);
+
+    CCNxCodecErrorCodes code = TLV_ERR_NO_ERROR;
+    if (section) {
+        ccnxManifestSection_Release(&section);
+    } else {
+        code = ccnxCodecError_GetErrorCode(ccnxCodecTlvDecoder_GetError(decoder));
+    }
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&buffer);
+    return code;
+}
+
+LONGBOW_TEST_RUNNER(ccnxCodecSchemaV1_ManifestCodec)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxCodecSchemaV1_ManifestCodec)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodecSchemaV1_ManifestCodec)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_EncodeSection_WireFormat);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_Encode_TooLong);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_GetEncodedLength);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_RoundTrip);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_NoSections);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_NoNameLink);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_DupSection);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_SharedName);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_UnknownNameIndex);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_LateAcsLink);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_ShortDigest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_MissingChunk);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray_PartialCapacity);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray_MissingSection);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray_Malformed);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+
+    data->signatureBits = parcBuffer_Allocate(10);
+    data->signature = parcSignature_Create(PARCSigningAlgorithm_RSA, PARC_HASH_SHA256, data->signatureBits);
+    data->acsName = ccnxName_CreateFromURI("lci:/foo/bar/manifest/acs");
+    data->acsLink = ccnxLink_Create(data->acsName, NULL, NULL);
+    data->manifestName = ccnxName_CreateFromURI("lci:/foo/bar/manifest");
+    data->nameLink = ccnxLink_Create(data->manifestName, NULL, NULL);
+    data->nameA = ccnxName_CreateFromURI("lci:/foo/bar/a");
+    data->nameB = ccnxName_CreateFromURI("lci:/foo/bar/b");
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    parcSignature_Release(&data->signature);
+    parcBuffer_Release(&data->signatureBits);
+    ccnxLink_Release(&data->acsLink);
+    ccnxName_Release(&data->acsName);
+    ccnxLink_Release(&data->nameLink);
+    ccnxName_Release(&data->manifestName);
+    ccnxName_Release(&data->nameA);
+    ccnxName_Release(&data->nameB);
+    parcMemory_Deallocate((void **) &data);
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_EncodeSection_WireFormat)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/2=ab");
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    ccnxManifestSection_AddName(section, name, 5);
+
+    PARCBuffer *first = _createDigest(0x00);
+    PARCBuffer *second = _createDigest(0x80);
+    ccnxManifestSection_AddHash(section, 0, first);
+    ccnxManifestSection_AddHash(section, 0, second);
+
+    uint8_t truth[] = {
+        // -- name entry
+        0x00, 0x02, 0x00, 15,
+        0x00, 0x00, 0x00,  6,
+        0x00, 0x02, 0x00,  2,
+        'a',  'b',
+        0x00, 0x01, 0x00,  1,
+        0x05,
+        // -- hash group of 2 digests for name index 0
+        0x00, 0x03, 0x00, 68,
+        0x00, 0x00, 0x00, 0x00,
+    };
+
+    PARCBuffer *encoded = _encodeSection(section);
+    size_t expectedLength = sizeof(truth) + 2 * CCNxCodecSchemaV1ManifestCodec_DigestLength;
+    assertTrue(parcBuffer_Remaining(encoded) == expectedLength,
+               "Wrong length, expected %zu got %zu", expectedLength, parcBuffer_Remaining(encoded));
+
+    const uint8_t *bytes = parcBuffer_Overlay(encoded, 0);
+    assertTrue(memcmp(bytes, truth, sizeof(truth)) == 0, "Wrong encoding")
+    {
+        parcBuffer_Display(encoded, 3);
+    }
+    for (size_t i = 0; i < 2 * CCNxCodecSchemaV1ManifestCodec_DigestLength; i++) {
+        assertTrue(bytes[sizeof(truth) + i] == (uint8_t) (i < 32 ? i : 0x80 + i - 32), "Wrong digest byte %zu", i);
+    }
+
+    parcBuffer_Release(&encoded);
+    parcBuffer_Release(&first);
+    parcBuffer_Release(&second);
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&name);
+}
+
+/*
+ * A section with more digests than fit in a 16-bit TLV length cannot be put in a manifest
+ */
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_Encode_TooLong)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    size_t nameIndex = ccnxManifestSection_AddName(section, data->nameA, 0);
+    PARCBuffer *digest = _createDigest(0);
+    for (size_t i = 0; i < UINT16_MAX / CCNxCodecSchemaV1ManifestCodec_DigestLength + 1; i++) {
+        ccnxManifestSection_AddHash(section, nameIndex, digest);
+    }
+    CCNxManifest *manifest = ccnxManifest_Create(data->signature, data->nameLink, NULL, section);
+
+    assertTrue(ccnxCodecSchemaV1ManifestCodec_GetEncodedLength(manifest) == -1, "Expected -1 length for an oversized section");
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ssize_t length = ccnxCodecSchemaV1ManifestCodec_Encode(encoder, manifest);
+    assertTrue(length == -1, "Expected -1, got %zd", length);
+    assertTrue(ccnxCodecTlvEncoder_Position(encoder) == 0, "Expected nothing appended, position %zu", ccnxCodecTlvEncoder_Position(encoder));
+    CCNxCodecErrorCodes code = ccnxCodecError_GetErrorCode(ccnxCodecTlvEncoder_GetError(encoder));
+    assertTrue(code == TLV_ERR_TOO_LONG, "Expected TLV_ERR_TOO_LONG, got %d", code);
+
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxManifest_Release(&manifest);
+    parcBuffer_Release(&digest);
+    ccnxManifestSection_Release(&section);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestSection *section = _createSection(data, data->acsLink);
+
+    ssize_t length = ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(section);
+    PARCBuffer *encoded = _encodeSection(section);
+    assertTrue(length == parcBuffer_Remaining(encoded), "Expected %zu, got %zd", parcBuffer_Remaining(encoded), length);
+
+    parcBuffer_Release(&encoded);
+    ccnxManifestSection_Release(&section);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_GetEncodedLength)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestSection *metadata = _createSection(data, NULL);
+    CCNxManifestSection *payload = _createSection(data, data->acsLink);
+    CCNxManifest *manifest = ccnxManifest_Create(data->signature, data->nameLink, metadata, payload);
+
+    ssize_t length = ccnxCodecSchemaV1ManifestCodec_GetEncodedLength(manifest);
+    PARCBuffer *encoded = _encodeManifest(manifest);
+    assertTrue(length == parcBuffer_Remaining(encoded), "Expected %zu, got %zd", parcBuffer_Remaining(encoded), length);
+
+    parcBuffer_Release(&encoded);
+    ccnxManifest_Release(&manifest);
+    ccnxManifestSection_Release(&metadata);
+    ccnxManifestSection_Release(&payload);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_RoundTrip)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestSection *metadata = _createSection(data, NULL);
+    CCNxManifestSection *payload = _createSection(data, data->acsLink);
+    CCNxManifest *truth = ccnxManifest_Create(data->signature, data->nameLink, metadata, payload);
+
+    PARCBuffer *encoded = _encodeManifest(truth);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(encoded);
+    CCNxManifest *test = ccnxCodecSchemaV1ManifestCodec_DecodeValue(decoder, (uint16_t) parcBuffer_Remaining(encoded), data->signature);
+    assertNotNull(test, "Got null manifest: %s", ccnxCodecError_ToString(ccnxCodecTlvDecoder_GetError(decoder)));
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(decoder), "Decoder did not consume the manifest");
+
+    assertTrue(ccnxLink_Equals(data->nameLink, ccnxManifest_GetNameLink(test)), "Wrong name link");
+    assertTrue(ccnxManifestSection_Equals(metadata, ccnxManifest_GetMetadataSection(test)), "Wrong metadata section");
+    assertTrue(ccnxManifestSection_Equals(payload, ccnxManifest_GetPayloadSection(test)), "Wrong payload section");
+
+    ccnxManifest_Release(&test);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&encoded);
+    ccnxManifest_Release(&truth);
+    ccnxManifestSection_Release(&metadata);
+    ccnxManifestSection_Release(&payload);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_NoSections)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifest *truth = ccnxManifest_Create(data->signature, data->nameLink, NULL, NULL);
+
+    PARCBuffer *encoded = _encodeManifest(truth);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(encoded);
+    CCNxManifest *test = ccnxCodecSchemaV1ManifestCodec_DecodeValue(decoder, (uint16_t) parcBuffer_Remaining(encoded), data->signature);
+    assertNotNull(test, "Got null manifest: %s", ccnxCodecError_ToString(ccnxCodecTlvDecoder_GetError(decoder)));
+    assertNull(ccnxManifest_GetMetadataSection(test), "Got a metadata section without the wire encoding for it");
+    assertNull(ccnxManifest_GetPayloadSection(test), "Got a payload section without the wire encoding for it");
+
+    ccnxManifest_Release(&test);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&encoded);
+    ccnxManifest_Release(&truth);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_NoNameLink)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    uint8_t encoded[] = {
+        // -- empty payload section
+        0x00, 0x03, 0x00, 0x00,
+    };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxManifest *test = ccnxCodecSchemaV1ManifestCodec_DecodeValue(decoder, sizeof(encoded), data->signature);
+    assertNull(test, "Should have returned NULL for a manifest without a name link");
+    CCNxCodecErrorCodes code = ccnxCodecError_GetErrorCode(ccnxCodecTlvDecoder_GetError(decoder));
+    assertTrue(code == TLV_MISSING_MANDATORY, "Expected TLV_MISSING_MANDATORY, got %d", code);
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeValue_DupSection)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    uint8_t encoded[] = {
+        // -- name link
+        0x00, 0x01, 0x00, 8,
+        0x00, 0x00, 0x00, 4,
+        0x00, 0x02, 0x00, 0,
+        // -- two empty payload sections
+        0x00, 0x03, 0x00, 0,
+        0x00, 0x03, 0x00, 0,
+    };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxManifest *test = ccnxCodecSchemaV1ManifestCodec_DecodeValue(decoder, sizeof(encoded), data->signature);
+    assertNull(test, "Should have returned NULL for a duplicate section");
+    CCNxCodecErrorCodes code = ccnxCodecError_GetErrorCode(ccnxCodecTlvDecoder_GetError(decoder));
+    assertTrue(code == TLV_ERR_DUPLICATE_FIELD, "Expected TLV_ERR_DUPLICATE_FIELD, got %d", code);
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_SharedName)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestSection *truth = _createSection(data, data->acsLink);
+
+    PARCBuffer *encoded = _encodeSection(truth);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(encoded);
+    CCNxManifestSection *test = ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(decoder, (uint16_t) parcBuffer_Remaining(encoded));
+    assertNotNull(test, "Got null section: %s", ccnxCodecError_ToString(ccnxCodecTlvDecoder_GetError(decoder)));
+
+    assertTrue(ccnxManifestSection_GetNameCount(test) == 2, "Expected 2 names, got %zu", ccnxManifestSection_GetNameCount(test));
+    assertTrue(ccnxManifestSection_GetHashCount(test) == 4, "Expected 4 hashes, got %zu", ccnxManifestSection_GetHashCount(test));
+    assertTrue(ccnxManifestSection_GetNameChunkFromHashIndex(test, 2) == 300, "Wrong chunk for hash 2");
+    assertTrue(ccnxManifestSection_GetNameChunkFromHashIndex(test, 3) == 5, "Wrong chunk for hash 3, the third under name A");
+    assertTrue(ccnxName_Equals(data->nameA, ccnxManifestSection_GetNameFromHashIndex(test, 3)), "Wrong name for hash 3");
+    assertTrue(ccnxLink_Equals(data->acsLink, ccnxManifestSection_GetACSLink(test)), "Wrong ACS link");
+    assertTrue(ccnxManifestSection_Equals(truth, test), "Decoded section does not equal the original");
+
+    ccnxManifestSection_Release(&test);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&encoded);
+    ccnxManifestSection_Release(&truth);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_UnknownNameIndex)
+{
+    uint8_t encoded[4 + 4 + CCNxCodecSchemaV1ManifestCodec_DigestLength] = {
+        // -- hash group for name index 0, but there are no name entries
+        0x00, 0x03, 0x00, 4 + CCNxCodecSchemaV1ManifestCodec_DigestLength,
+        0x00, 0x00, 0x00, 0x00,
+    };
+
+    CCNxCodecErrorCodes code = _decodeSectionError(encoded, sizeof(encoded));
+    assertTrue(code == TLV_ERR_DECODE, "Expected TLV_ERR_DECODE, got %d", code);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_LateAcsLink)
+{
+    uint8_t encoded[] = {
+        // -- name entry
+        0x00, 0x02, 0x00, 13,
+        0x00, 0x00, 0x00, 4,
+        0x00, 0x02, 0x00, 0,
+        0x00, 0x01, 0x00, 1,
+        0x00,
+        // -- acs link after a name entry
+        0x00, 0x01, 0x00, 8,
+        0x00, 0x00, 0x00, 4,
+        0x00, 0x02, 0x00, 0,
+    };
+
+    CCNxCodecErrorCodes code = _decodeSectionError(encoded, sizeof(encoded));
+    assertTrue(code == TLV_ERR_DECODE, "Expected TLV_ERR_DECODE, got %d", code);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_ShortDigest)
+{
+    uint8_t encoded[] = {
+        // -- name entry
+        0x00, 0x02, 0x00, 13,
+        0x00, 0x00, 0x00, 4,
+        0x00, 0x02, 0x00, 0,
+        0x00, 0x01, 0x00, 1,
+        0x00,
+        // -- hash group with a 4 byte digest
+        0x00, 0x03, 0x00, 8,
+        0x00, 0x00, 0x00, 0x00,
+        0xa0, 0xa1, 0xa2, 0xa3,
+    };
+
+    CCNxCodecErrorCodes code = _decodeSectionError(encoded, sizeof(encoded));
+    assertTrue(code == TLV_ERR_NOT_FIXED_SIZE, "Expected TLV_ERR_NOT_FIXED_SIZE, got %d", code);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue_MissingChunk)
+{
+    uint8_t encoded[] = {
+        // -- name entry without a chunk
+        0x00, 0x02, 0x00, 8,
+        0x00, 0x00, 0x00, 4,
+        0x00, 0x02, 0x00, 0,
+    };
+
+    CCNxCodecErrorCodes code = _decodeSectionError(encoded, sizeof(encoded));
+    assertTrue(code == TLV_MISSING_MANDATORY, "Expected TLV_MISSING_MANDATORY, got %d", code);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestSection *metadata = ccnxManifestSection_Create(NULL);
+    CCNxManifestSection *payload = _createSection(data, data->acsLink);
+    CCNxManifest *manifest = ccnxManifest_Create(data->signature, data->nameLink, metadata, payload);
+    PARCBuffer *encoded = _encodeManifest(manifest);
+
+    size_t count = 99;
+    bool success = ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(encoded, CCNxCodecSchemaV1Types_Manifest_PayloadSection, 0, NULL, NULL, &count);
+    assertTrue(success, "Expected a well formed payload");
+    assertTrue(count == 4, "Expected 4 hashes, got %zu", count);
+
+    uint8_t digests[4 * CCNxCodecSchemaV1ManifestCodec_DigestLength];
+    uint32_t nameIndexes[4];
+    success = ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(encoded, CCNxCodecSchemaV1Types_Manifest_PayloadSection, 4, digests, nameIndexes, &count);
+    assertTrue(success, "Expected a well formed payload");
+    assertTrue(parcBuffer_Position(encoded) == 0, "The payload position moved to %zu", parcBuffer_Position(encoded));
+
+    for (size_t i = 0; i < count; i++) {
+        PARCBuffer *truth = ccnxManifestSection_GetHashAtIndex(payload, i);
+        assertTrue(memcmp(parcBuffer_Overlay(truth, 0), &digests[i * CCNxCodecSchemaV1ManifestCodec_DigestLength],
+                          CCNxCodecSchemaV1ManifestCodec_DigestLength) == 0, "Wrong digest %zu", i);
+        assertTrue(nameIndexes[i] == ccnxManifestSection_GetNameIndexFromHashIndex(payload, i), "Wrong name index %zu", i);
+    }
+
+    success = ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(encoded, CCNxCodecSchemaV1Types_Manifest_MetadataSection, 4, digests, nameIndexes, &count);
+    assertTrue(success && count == 0, "Expected an empty metadata section, got %zu", count);
+
+    parcBuffer_Release(&encoded);
+    ccnxManifest_Release(&manifest);
+    ccnxManifestSection_Release(&metadata);
+    ccnxManifestSection_Release(&payload);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray_PartialCapacity)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestSection *payload = _createSection(data, NULL);
+    CCNxManifest *manifest = ccnxManifest_Create(data->signature, data->nameLink, NULL, payload);
+    PARCBuffer *encoded = _encodeManifest(manifest);
+
+    // One spare digest past the capacity must not be written
+    uint8_t digests[4 * CCNxCodecSchemaV1ManifestCodec_DigestLength];
+    memset(digests, 0xff, sizeof(digests));
+
+    size_t count;
+    bool success = ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(encoded, CCNxCodecSchemaV1Types_Manifest_PayloadSection, 3, digests, NULL, &count);
+    assertTrue(success, "Expected a well formed payload");
+    assertTrue(count == 4, "Expected 4 hashes, got %zu", count);
+    assertTrue(digests[2 * CCNxCodecSchemaV1ManifestCodec_DigestLength] == 0x30, "Wrong third digest");
+    assertTrue(digests[3 * CCNxCodecSchemaV1ManifestCodec_DigestLength] == 0xff, "Wrote past the capacity");
+
+    parcBuffer_Release(&encoded);
+    ccnxManifest_Release(&manifest);
+    ccnxManifestSection_Release(&payload);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray_MissingSection)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifest *manifest = ccnxManifest_Create(data->signature, data->nameLink, NULL, NULL);
+    PARCBuffer *encoded = _encodeManifest(manifest);
+
+    size_t count = 99;
+    bool success = ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(encoded, CCNxCodecSchemaV1Types_Manifest_PayloadSection, 0, NULL, NULL, &count);
+    assertTrue(success, "Expected a well formed payload");
+    assertTrue(count == 0, "Expected 0 hashes, got %zu", count);
+
+    parcBuffer_Release(&encoded);
+    ccnxManifest_Release(&manifest);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray_Malformed)
+{
+    uint8_t overrun[] = {
+        // -- payload section longer than the payload
+        0x00, 0x03, 0x00, 8,
+        0x00, 0x02, 0x00, 0,
+    };
+
+    uint8_t unknownName[4 + 4 + 4 + CCNxCodecSchemaV1ManifestCodec_DigestLength] = {
+        // -- payload section with a hash group for a name entry that does not exist
+        0x00, 0x03, 0x00, 4 + 4 + CCNxCodecSchemaV1ManifestCodec_DigestLength,
+        0x00, 0x03, 0x00, 4 + CCNxCodecSchemaV1ManifestCodec_DigestLength,
+        0x00, 0x00, 0x00, 0x00,
+    };
+
+    uint8_t unknownField[] = {
+        0x00, 0x09, 0x00, 0,
+    };
+
+    struct {
+        uint8_t *encoded;
+        size_t length;
+    } vectors[] = {
+        { overrun,      sizeof(overrun)      },
+        { unknownName,  sizeof(unknownName)  },
+        { unknownField, sizeof(unknownField) },
+    };
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        PARCBuffer *buffer = parcBuffer_Wrap(vectors[i].encoded, vectors[i].length, 0, vectors[i].length);
+        size_t count;
+        bool success = ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(buffer, CCNxCodecSchemaV1Types_Manifest_PayloadSection, 0, NULL, NULL, &count);
+        assertFalse(success, "Expected vector %zu to be malformed", i);
+        parcBuffer_Release(&buffer);
+    }
+}
+
+// ==================================================================================
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _hashGroupLength);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * A run of hashes under one name is split in to groups that fit a 16-bit TLV length
+ */
+LONGBOW_TEST_CASE(Local, _hashGroupLength)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    size_t first = ccnxManifestSection_AddName(section, name, 0);
+    size_t second = ccnxManifestSection_AddName(section, name, 1);
+
+    PARCBuffer *digest = _createDigest(0);
+    size_t runLength = _maxDigestsPerGroup + 10;
+    for (size_t i = 0; i < runLength; i++) {
+        ccnxManifestSection_AddHash(section, first, digest);
+    }
+    ccnxManifestSection_AddHash(section, second, digest);
+    size_t hashCount = ccnxManifestSection_GetHashCount(section);
+
+    assertTrue(_hashGroupLength(section, 0, hashCount) == _maxDigestsPerGroup,
+               "Expected a full group of %d, got %zu", _maxDigestsPerGroup, _hashGroupLength(section, 0, hashCount));
+    assertTrue(_hashGroupLength(section, _maxDigestsPerGroup, hashCount) == 10,
+               "Expected the rest of the run, got %zu", _hashGroupLength(section, _maxDigestsPerGroup, hashCount));
+    assertTrue(_hashGroupLength(section, runLength, hashCount) == 1,
+               "Expected a group of 1, got %zu", _hashGroupLength(section, runLength, hashCount));
+    assertTrue(4 + _maxDigestsPerGroup * CCNxCodecSchemaV1ManifestCodec_DigestLength <= UINT16_MAX, "Group does not fit a TLV");
+
+    parcBuffer_Release(&digest);
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&name);
+}
+
+// ==================================================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Compares the cost of copying a full section of digests out of the payload with decoding the section
+ */
+LONGBOW_TEST_CASE(Performance, ccnxCodecSchemaV1ManifestCodec_DecodeHashArray)
+{
+    const size_t hashCount = 2000;
+    const int passes = 1000;
+
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    size_t nameIndex = ccnxManifestSection_AddName(section, name, 0);
+    for (size_t i = 0; i < hashCount; i++) {
+        PARCBuffer *digest = _createDigest((uint8_t) i);
+        ccnxManifestSection_AddHash(section, nameIndex, digest);
+        parcBuffer_Release(&digest);
+    }
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_Manifest_PayloadSection,
+                                        (uint16_t) ccnxCodecSchemaV1ManifestCodec_GetSectionEncodedLength(section));
+    ccnxCodecSchemaV1ManifestCodec_EncodeSection(encoder, section);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+    PARCBuffer *payload = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+
+    uint8_t *digests = parcMemory_Allocate(hashCount * CCNxCodecSchemaV1ManifestCodec_DigestLength);
+    struct timeval t0, t1, t2;
+
+    gettimeofday(&t0, NULL);
+    for (int pass = 0; pass < passes; pass++) {
+        size_t count;
+        ccnxCodecSchemaV1ManifestCodec_DecodeHashArray(payload, CCNxCodecSchemaV1Types_Manifest_PayloadSection, hashCount, digests, NULL, &count);
+    }
+    gettimeofday(&t1, NULL);
+    for (int pass = 0; pass < passes; pass++) {
+        CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(payload);
+        (void) ccnxCodecTlvDecoder_GetType(decoder);
+        uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+        CCNxManifestSection *test = ccnxCodecSchemaV1ManifestCodec_DecodeSectionValue(decoder, length);
+        ccnxManifestSection_Release(&test);
+        ccnxCodecTlvDecoder_Destroy(&decoder);
+    }
+    gettimeofday(&t2, NULL);
+
+    timersub(&t1, &t0, &t1);
+    timersub(&t2, &t0, &t2);
+    timersub(&t2, &t1, &t2);
+    printf("%zu hashes x %d passes: hash array %.6f sec, section %.6f sec\n", hashCount, passes,
+           t1.tv_sec + t1.tv_usec * 1E-6, t2.tv_sec + t2.tv_usec * 1E-6);
+
+    parcMemory_Deallocate((void **) &digests);
+    parcBuffer_Release(&payload);
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&name);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxCodecSchemaV1_ManifestCodec);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -119,6 +119,11 @@ LONGBOW_TEST_CASE(ContentObject, Interest)
 
     testCompareEncoderToBuffer(encoder, truth);
 
+    // The message TL container is not part of the message encoder's length
+    ssize_t expectedLength = ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(interest);
+    assertTrue(expectedLength + 4 == parcBuffer_Remaining(truth), "Wrong encoded length, got %zd expected %zu",
+               expectedLength, parcBuffer_Remaining(truth) - 4);
+
     ccnxCodecTlvEncoder_Destroy(&encoder);
     parcBuffer_Release(&truth);
     parcBuffer_Release(&payload);
@@ -204,6 +209,11 @@ LONGBOW_TEST_CASE(ContentObject, ContentObject)
 
     testCompareEncoderToBuffer(encoder, truth);
 
+    // The message TL container is not part of the message encoder's length
+    ssize_t expectedLength = ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(contentobject);
+    assertTrue(expectedLength + 4 == parcBuffer_Remaining(truth), "Wrong encoded length, got %zd expected %zu",
+               expectedLength, parcBuffer_Remaining(truth) - 4);
+
     ccnxCodecTlvEncoder_Destroy(&encoder);
     parcBuffer_Release(&truth);
     parcBuffer_Release(&payload);
@@ -298,6 +308,7 @@ LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, _encodeName);
     LONGBOW_RUN_TEST_CASE(Local, _encodePayload);
+    LONGBOW_RUN_TEST_CASE(Local, _encodePayload_Reference);
     LONGBOW_RUN_TEST_CASE(Local, _encodePayloadType);
     LONGBOW_RUN_TEST_CASE(Local, _encodeExpiryTime);
     LONGBOW_RUN_TEST_CASE(Local, _encodeEndChunkNumber);
@@ -396,6 +407,37 @@ LONGBOW_TEST_CASE(Local, _encodePayload)
     ccnxTlvDictionary_Release(&dictionary);
 }
 
+LONGBOW_TEST_CASE(Local, _encodePayload_Reference)
+{
+    size_t payloadLength = 2000;
+    PARCBuffer *buffer = parcBuffer_Allocate(payloadLength);
+    for (size_t i = 0; i < payloadLength; i++) {
+        parcBuffer_PutUint8(buffer, (uint8_t) i);
+    }
+    parcBuffer_Flip(buffer);
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    ccnxTlvDictionary_PutBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD, buffer);
+
+    size_t referenced = ccnxCodecSchemaV1MessageEncoder_GetPayloadReferenceLength(dictionary);
+    assertTrue(referenced == payloadLength, "Wrong reference length, got %zu expected %zu", referenced, payloadLength);
+
+    ssize_t length = _encodePayload(encoder, dictionary);
+    assertTrue(length == 4 + payloadLength, "Wrong length, got %zd expected %zu", length, 4 + payloadLength);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == 2, "Wrong iovcnt, got %d expected 2", ccnxCodecNetworkBufferIoVec_GetCount(vec));
+    assertTrue(iov[1].iov_base == parcBuffer_Overlay(buffer, 0), "Payload should be referenced, not copied");
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcBuffer_Release(&buffer);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
 LONGBOW_TEST_CASE(Local, _encodePayloadType)
 {
     CCNxPayloadType type = CCNxPayloadType_MANIFEST;
@@ -594,6 +636,7 @@ LONGBOW_TEST_CASE(UnknownType, Unknown)
     CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
     ssize_t length = ccnxCodecSchemaV1MessageEncoder_Encode(encoder, unknown);
     assertTrue(length < 0, "Did not get error return when encoding unknown type");
+    assertTrue(ccnxCodecSchemaV1MessageEncoder_GetEncodedLength(unknown) < 0, "Did not get error length for unknown type");
 
     CCNxCodecError *error = ccnxCodecTlvEncoder_GetError(encoder);
     assertNotNull(error, "encoder did not set the error");
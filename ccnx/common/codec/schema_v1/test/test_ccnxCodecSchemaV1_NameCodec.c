@@ -53,7 +53,9 @@ LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_Decode_RightType);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_Decode_WrongType);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_Decode_SegmentOverrun);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_Encode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1NameCodec_GetEncodedLength);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -105,6 +107,20 @@ LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_Decode_WrongType)
     parcBuffer_Release(&decodeBuffer);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_Decode_SegmentOverrun)
+{
+    // The name is 6 bytes but its segment claims 10 bytes of value
+    uint8_t decodeBytes[] = { 0x10, 0x20, 0x00, 0x06, 0x00, CCNxNameLabelType_NAME, 0x00, 0x0A, 'b', 'r', 'a', 'n', 'd', 'y', 'w', 'i', 'n', 'e' };
+    PARCBuffer *decodeBuffer = parcBuffer_Wrap(decodeBytes, sizeof(decodeBytes), 0, sizeof(decodeBytes));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(decodeBuffer);
+    CCNxName *test = ccnxCodecSchemaV1NameCodec_Decode(decoder, 0x1020);
+
+    assertNull(test, "Name should have returned NULL because a segment runs past the end of the name");
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&decodeBuffer);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_Encode)
 {
     uint8_t truthBytes[] = { 0x10, 0x20, 0x00, 0x0E, 0x00, CCNxNameLabelType_NAME, 0x00, 0x0A, 'b', 'r', 'a', 'n', 'd', 'y', 'w', 'i', 'n', 'e' };
@@ -140,6 +156,19 @@ LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_Encode)
     parcBuffer_Release(&truth);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1NameCodec_GetEncodedLength)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/2=apple/2=pie");
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    size_t length = ccnxCodecSchemaV1NameCodec_Encode(encoder, 0x1020, name);
+    size_t test = ccnxCodecSchemaV1NameCodec_GetEncodedLength(name);
+    assertTrue(test == length, "Wrong length, expected %zu got %zu", length, test);
+
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxName_Release(&name);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -80,6 +80,7 @@ LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodecSchemaV0_OptionalHeadersEncoder)
 LONGBOW_TEST_FIXTURE(Interest)
 {
     LONGBOW_RUN_TEST_CASE(Interest, ccnxCodecSchemaV1OptionalHeadersEncoder_Encode);
+    LONGBOW_RUN_TEST_CASE(Interest, ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Interest)
@@ -120,11 +121,20 @@ LONGBOW_TEST_CASE(Interest, ccnxCodecSchemaV1OptionalHeadersEncoder_Encode)
     testCompareEncoderToBuffer(data->encoder, data->memoryRegion);
 }
 
+LONGBOW_TEST_CASE(Interest, ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ssize_t length = ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength(data->dictionary);
+    assertTrue(length == parcBuffer_Remaining(data->memoryRegion), "Wrong length, got %zd expected %zu",
+               length, parcBuffer_Remaining(data->memoryRegion));
+}
+
 // ==================================================================================
 
 LONGBOW_TEST_FIXTURE(ContentObject)
 {
     LONGBOW_RUN_TEST_CASE(ContentObject, ccnxCodecSchemaV1OptionalHeadersEncoder_Encode);
+    LONGBOW_RUN_TEST_CASE(ContentObject, ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(ContentObject)
@@ -166,6 +176,14 @@ LONGBOW_TEST_CASE(ContentObject, ccnxCodecSchemaV1OptionalHeadersEncoder_Encode)
     testCompareEncoderToBuffer(data->encoder, data->memoryRegion);
 }
 
+LONGBOW_TEST_CASE(ContentObject, ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ssize_t length = ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength(data->dictionary);
+    assertTrue(length == parcBuffer_Remaining(data->memoryRegion), "Wrong length, got %zd expected %zu",
+               length, parcBuffer_Remaining(data->memoryRegion));
+}
+
 // ==================================================================================
 
 LONGBOW_TEST_FIXTURE(UnknownType)
@@ -195,6 +213,7 @@ LONGBOW_TEST_CASE(UnknownType, Unknown)
     CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
     ssize_t length = ccnxCodecSchemaV1OptionalHeadersEncoder_Encode(encoder, unknown);
     assertTrue(length < 0, "Did not get error return when encoding unknown type");
+    assertTrue(ccnxCodecSchemaV1OptionalHeadersEncoder_GetEncodedLength(unknown) < 0, "Did not get error length for unknown type");
 
     CCNxCodecError *error = ccnxCodecTlvEncoder_GetError(encoder);
     assertNotNull(error, "encoder did not set the error");
@@ -52,6 +52,8 @@ LONGBOW_TEST_RUNNER(ccnxCodecSchemaV1_PacketEncoder)
     LONGBOW_RUN_TEST_FIXTURE(InterestReturn);
     LONGBOW_RUN_TEST_FIXTURE(Control);
     LONGBOW_RUN_TEST_FIXTURE(UnknownType);
+    LONGBOW_RUN_TEST_FIXTURE(Batch);
+    LONGBOW_RUN_TEST_FIXTURE(EncodedLength);
     LONGBOW_RUN_TEST_FIXTURE(Local);
 }
 
@@ -683,6 +685,339 @@ LONGBOW_TEST_CASE(UnknownType, unknown)
 
 // =========================================================================
 
+LONGBOW_TEST_FIXTURE(Batch)
+{
+    LONGBOW_RUN_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode);
+    LONGBOW_RUN_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode_Errors);
+    LONGBOW_RUN_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode_Empty);
+    LONGBOW_RUN_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode_Signed);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Batch)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Batch)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Copy iovec elements [first, last) to a PARCBuffer
+ */
+static PARCBuffer *
+_batchPacket(CCNxCodecNetworkBufferIoVec *vec, size_t first, size_t last)
+{
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    size_t length = 0;
+    for (size_t i = first; i < last; i++) {
+        length += array[i].iov_len;
+    }
+
+    PARCBuffer *packet = parcBuffer_Allocate(length);
+    for (size_t i = first; i < last; i++) {
+        parcBuffer_PutArray(packet, array[i].iov_len, array[i].iov_base);
+    }
+    return parcBuffer_Flip(packet);
+}
+
+static void
+_assertBatchPacketEqualsSigned(CCNxCodecNetworkBufferIoVec *batch, size_t firstIndex[], size_t i, CCNxTlvDictionary *message, PARCSigner *signer)
+{
+    CCNxCodecNetworkBufferIoVec *truthVec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, signer);
+    PARCBuffer *truth = _batchPacket(truthVec, 0, ccnxCodecNetworkBufferIoVec_GetCount(truthVec));
+    PARCBuffer *test = _batchPacket(batch, firstIndex[i], firstIndex[i + 1]);
+
+    assertTrue(parcBuffer_Equals(truth, test), "Batch packet %zu does not match DictionaryEncode", i)
+    {
+        parcBuffer_Display(truth, 3);
+        parcBuffer_Display(test, 3);
+    }
+
+    parcBuffer_Release(&test);
+    parcBuffer_Release(&truth);
+    ccnxCodecNetworkBufferIoVec_Release(&truthVec);
+}
+
+static void
+_assertBatchPacketEquals(CCNxCodecNetworkBufferIoVec *batch, size_t firstIndex[], size_t i, CCNxTlvDictionary *message)
+{
+    _assertBatchPacketEqualsSigned(batch, firstIndex, i, message, NULL);
+}
+
+LONGBOW_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/batch/encode");
+    PARCBuffer *payload = parcBuffer_Allocate(2000);
+    for (size_t i = 0; i < 2000; i++) {
+        parcBuffer_PutUint8(payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(payload);
+
+    // The 2000 byte payloads do not fit in one memory block, so packets start and end inside blocks
+    CCNxTlvDictionary *messages[] = {
+        ccnxInterest_CreateSimple(name),
+        ccnxContentObject_CreateWithDataPayload(name, payload),
+        ccnxContentObject_CreateWithDataPayload(name, payload),
+        ccnxInterest_CreateSimple(name),
+    };
+    size_t count = sizeof(messages) / sizeof(messages[0]);
+    size_t firstIndex[count + 1];
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_BatchEncode(messages, count, NULL, firstIndex);
+    assertNotNull(vec, "Got null batch");
+    assertTrue(firstIndex[count] == (size_t) ccnxCodecNetworkBufferIoVec_GetCount(vec),
+               "Wrong element count, got %zu expected %d", firstIndex[count], ccnxCodecNetworkBufferIoVec_GetCount(vec));
+
+    for (size_t i = 0; i < count; i++) {
+        assertTrue(firstIndex[i + 1] > firstIndex[i], "Packet %zu has no iovec elements", i);
+        _assertBatchPacketEquals(vec, firstIndex, i, messages[i]);
+        ccnxTlvDictionary_Release(&messages[i]);
+    }
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
+/*
+ * Packets that do not encode get no iovec elements and do not disturb their neighbors
+ */
+LONGBOW_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode_Errors)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/batch/encode");
+
+    CCNxTlvDictionary *messages[] = {
+        ccnxInterest_CreateSimple(name),
+        NULL,
+        ccnxTlvDictionary_Create(20, 20),
+        ccnxCodecSchemaV1TlvDictionary_CreateInterest(),
+        ccnxInterest_CreateSimple(name),
+    };
+    size_t count = sizeof(messages) / sizeof(messages[0]);
+    size_t firstIndex[count + 1];
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_BatchEncode(messages, count, NULL, firstIndex);
+
+    assertTrue(firstIndex[1] == firstIndex[2], "A NULL dictionary should have no elements");
+    assertTrue(firstIndex[2] == firstIndex[3], "An unknown dictionary should have no elements");
+    assertTrue(firstIndex[3] == firstIndex[4], "An Interest without a name should have no elements");
+    _assertBatchPacketEquals(vec, firstIndex, 0, messages[0]);
+    _assertBatchPacketEquals(vec, firstIndex, 4, messages[4]);
+
+    for (size_t i = 0; i < count; i++) {
+        if (messages[i]) {
+            ccnxTlvDictionary_Release(&messages[i]);
+        }
+    }
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxName_Release(&name);
+}
+
+/*
+ * Every packet of a signed batch is signed over its own bytes, including the packets that start
+ * past the first memory block.  Each one must match the same packet encoded and signed on its own.
+ */
+LONGBOW_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode_Signed)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/batch/signed");
+    PARCBuffer *payload = parcBuffer_Allocate(700);
+    for (size_t i = 0; i < 700; i++) {
+        parcBuffer_PutUint8(payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(payload);
+
+    // Two copies of each packet, so the batch cannot leave a signature behind for the truth to reuse
+    enum { count = 8 };
+    CCNxTlvDictionary *messages[count];
+    CCNxTlvDictionary *truths[count];
+    for (size_t i = 0; i < count; i++) {
+        messages[i] = ccnxContentObject_CreateWithDataPayload(name, payload);
+        ccnxValidationCRC32C_Set(messages[i]);
+        truths[i] = ccnxContentObject_CreateWithDataPayload(name, payload);
+        ccnxValidationCRC32C_Set(truths[i]);
+    }
+    size_t firstIndex[count + 1];
+
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_BatchEncode(messages, count, signer, firstIndex);
+    assertNotNull(vec, "Got null batch");
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(vec) > 3 * 1536,
+               "The batch should span several memory blocks, got %zu bytes", ccnxCodecNetworkBufferIoVec_Length(vec));
+
+    for (size_t i = 0; i < count; i++) {
+        assertTrue(firstIndex[i + 1] > firstIndex[i], "Packet %zu has no iovec elements", i);
+        _assertBatchPacketEqualsSigned(vec, firstIndex, i, truths[i], signer);
+        ccnxTlvDictionary_Release(&messages[i]);
+        ccnxTlvDictionary_Release(&truths[i]);
+    }
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Batch, ccnxCodecSchemaV1PacketEncoder_BatchEncode_Empty)
+{
+    size_t firstIndex[1];
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_BatchEncode(NULL, 0, NULL, firstIndex);
+    assertTrue(firstIndex[0] == 0, "Wrong element count, got %zu expected 0", firstIndex[0]);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(vec) == 0, "Wrong length, got %zu expected 0", ccnxCodecNetworkBufferIoVec_Length(vec));
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+// =========================================================================
+
+LONGBOW_TEST_FIXTURE(EncodedLength)
+{
+    LONGBOW_RUN_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength);
+    LONGBOW_RUN_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength_Validation);
+    LONGBOW_RUN_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength_Signer);
+    LONGBOW_RUN_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength_Errors);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(EncodedLength)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(EncodedLength)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * The computed length must equal the encoded length, and DictionaryEncode should use one memory block
+ */
+static void
+_assertEncodedLength(CCNxTlvDictionary *message)
+{
+    ssize_t expected = ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(message, NULL);
+    assertTrue(expected > 0, "Got error length %zd", expected);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, NULL);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(vec) == expected, "Wrong length, got %zu expected %zd",
+               ccnxCodecNetworkBufferIoVec_Length(vec), expected);
+
+    // The headers are in one memory block, a large payload is a second iovec pointing at the payload buffer
+    int expectedCount = 1;
+    if (ccnxCodecSchemaV1MessageEncoder_GetPayloadReferenceLength(message) > 0) {
+        PARCBuffer *payload = ccnxTlvDictionary_GetBuffer(message, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+        const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+        assertTrue(iov[1].iov_base == parcBuffer_Overlay(payload, 0), "Payload was copied, expected a reference");
+        expectedCount = 2;
+    }
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == expectedCount, "Expected %d iovec, got %d",
+               expectedCount, ccnxCodecNetworkBufferIoVec_GetCount(vec));
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/encoded/length");
+    PARCBuffer *keyid = parcBuffer_WrapCString("keyid");
+    PARCBuffer *hash = parcBuffer_WrapCString("content object hash");
+
+    // Larger than the default first memory block, so it would span blocks without sizing, and
+    // large enough to be encoded by reference
+    PARCBuffer *payload = parcBuffer_Allocate(3000);
+    for (size_t i = 0; i < 3000; i++) {
+        parcBuffer_PutUint8(payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(payload);
+
+    CCNxTlvDictionary *interest = ccnxInterest_Create(name, 300000, keyid, hash);
+    CCNxTlvDictionary *simple = ccnxInterest_CreateSimple(name);
+    CCNxTlvDictionary *content = ccnxContentObject_CreateWithDataPayload(name, payload);
+    ccnxContentObject_SetExpiryTime(content, 1234567890);
+    ccnxContentObject_SetFinalChunkNumber(content, 0x10203);
+
+    _assertEncodedLength(interest);
+    _assertEncodedLength(simple);
+    _assertEncodedLength(content);
+
+    ccnxTlvDictionary_Release(&content);
+    ccnxTlvDictionary_Release(&simple);
+    ccnxTlvDictionary_Release(&interest);
+    parcBuffer_Release(&payload);
+    parcBuffer_Release(&hash);
+    parcBuffer_Release(&keyid);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength_Validation)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/encoded/length");
+    CCNxName *keyname = ccnxName_CreateFromURI("lci:/key/name");
+    PARCBuffer *keyid = parcBuffer_WrapCString("keyid");
+    PARCBuffer *signature = parcBuffer_WrapCString("not really a signature");
+
+    CCNxTlvDictionary *content = ccnxContentObject_CreateWithDataPayload(name, NULL);
+    ccnxTlvDictionary_PutInteger(content, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE, PARCCryptoSuite_RSA_SHA256);
+    ccnxTlvDictionary_PutBuffer(content, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYID, keyid);
+    ccnxTlvDictionary_PutName(content, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYNAME_NAME, keyname);
+    ccnxTlvDictionary_PutBuffer(content, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYNAME_KEYID, keyid);
+    ccnxTlvDictionary_PutInteger(content, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_SIGNTIME, 1000);
+    ccnxTlvDictionary_PutBuffer(content, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD, signature);
+
+    _assertEncodedLength(content);
+
+    ccnxTlvDictionary_Release(&content);
+    parcBuffer_Release(&signature);
+    parcBuffer_Release(&keyid);
+    ccnxName_Release(&keyname);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength_Signer)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/encoded/length");
+    PARCBuffer *payload = parcBuffer_WrapCString("signed payload");
+    CCNxTlvDictionary *content = ccnxContentObject_CreateWithDataPayload(name, payload);
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+
+    // The CRC32C signature is computed while encoding, but its length is known up front
+    ssize_t expected = ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(content, signer);
+    assertTrue(expected > 0, "Got error length %zd", expected);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(content, signer);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(vec) == expected, "Wrong length, got %zu expected %zd",
+               ccnxCodecNetworkBufferIoVec_Length(vec), expected);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == 1, "Expected 1 iovec, got %d", ccnxCodecNetworkBufferIoVec_GetCount(vec));
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcSigner_Release(&signer);
+    ccnxTlvDictionary_Release(&content);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(EncodedLength, ccnxCodecSchemaV1PacketEncoder_GetEncodedLength_Errors)
+{
+    CCNxTlvDictionary *unknown = ccnxTlvDictionary_Create(20, 20);
+    CCNxTlvDictionary *noname = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+
+    assertTrue(ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(unknown, NULL) == -1, "Unknown type should have no length");
+    assertTrue(ccnxCodecSchemaV1PacketEncoder_GetEncodedLength(noname, NULL) == -1, "Interest without a name should have no length");
+
+    ccnxTlvDictionary_Release(&noname);
+    ccnxTlvDictionary_Release(&unknown);
+}
+
+// =========================================================================
+
 LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, _getHopLimit_Present);
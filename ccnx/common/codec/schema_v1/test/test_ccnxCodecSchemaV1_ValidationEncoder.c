@@ -70,6 +70,8 @@ LONGBOW_TEST_FIXTURE(EncodeAlg)
     LONGBOW_RUN_TEST_CASE(EncodeAlg, HMAC_SHA256);
     LONGBOW_RUN_TEST_CASE(EncodeAlg, RSA_SHA256);
     LONGBOW_RUN_TEST_CASE(EncodeAlg, DeduceFromSigner);
+    LONGBOW_RUN_TEST_CASE(EncodeAlg, ccnxCodecSchemaV1ValidationEncoder_GetAlgLength);
+    LONGBOW_RUN_TEST_CASE(EncodeAlg, ccnxCodecSchemaV1ValidationEncoder_GetAlgLength_None);
 
     LONGBOW_RUN_TEST_CASE(EncodeAlg, _encodeCertificate);
     LONGBOW_RUN_TEST_CASE(EncodeAlg, _encodePublicKey);
@@ -232,6 +234,46 @@ LONGBOW_TEST_CASE(EncodeAlg, DeduceFromSigner)
     parcSigner_Release(&signer);
 }
 
+/*
+ * The computed length must match what EncodeAlg appends, including the KeyName link and signing time
+ */
+LONGBOW_TEST_CASE(EncodeAlg, ccnxCodecSchemaV1ValidationEncoder_GetAlgLength)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/2=apple/2=pie");
+    PARCBuffer *keyid = parcBuffer_WrapCString("keyid");
+    PARCBuffer *hash = parcBuffer_WrapCString("hash");
+    CCNxLink *link = ccnxLink_Create(name, keyid, hash);
+
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    ccnxTlvDictionary_PutInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE, PARCCryptoSuite_RSA_SHA256);
+    ccnxTlvDictionary_PutBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYID, keyid);
+    ccnxTlvDictionary_PutInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_SIGNTIME, 0x0102030405);
+    ccnxValidationFacadeV1_SetKeyName(dictionary, link);
+
+    ssize_t expected = ccnxCodecSchemaV1ValidationEncoder_GetAlgLength(dictionary, NULL);
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ssize_t length = ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(encoder, dictionary);
+    assertTrue(length == expected, "Wrong length, expected %zd got %zd", expected, length);
+    assertTrue(ccnxCodecTlvEncoder_Position(encoder) == expected, "Wrong position, expected %zd got %zu",
+               expected, ccnxCodecTlvEncoder_Position(encoder));
+
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxTlvDictionary_Release(&dictionary);
+    ccnxLink_Release(&link);
+    parcBuffer_Release(&hash);
+    parcBuffer_Release(&keyid);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(EncodeAlg, ccnxCodecSchemaV1ValidationEncoder_GetAlgLength_None)
+{
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    ssize_t length = ccnxCodecSchemaV1ValidationEncoder_GetAlgLength(dictionary, NULL);
+    assertTrue(length == 0, "Wrong length, expected 0 got %zd", length);
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
 // =======
 
 LONGBOW_TEST_CASE(EncodeAlg, _encodeCertificate)
@@ -462,6 +504,10 @@ LONGBOW_TEST_FIXTURE(EncodePayload)
 {
     LONGBOW_RUN_TEST_CASE(EncodePayload, payload_Specified);
     LONGBOW_RUN_TEST_CASE(EncodePayload, payload_Generated);
+    LONGBOW_RUN_TEST_CASE(EncodePayload, ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength);
+    LONGBOW_RUN_TEST_CASE(EncodePayload, ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength_Hmac);
+    LONGBOW_RUN_TEST_CASE(EncodePayload, _rsaModulusLength);
+    LONGBOW_RUN_TEST_CASE(EncodePayload, _rsaModulusLength_Invalid);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(EncodePayload)
@@ -564,6 +610,85 @@ LONGBOW_TEST_CASE(EncodePayload, payload_Generated)
     parcBuffer_Release(&test);
 }
 
+LONGBOW_TEST_CASE(EncodePayload, ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength)
+{
+    uint8_t encoded[] = { 0x11, 0x22, 0x33, 0x44 };
+    PARCBuffer *payload = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+
+    ssize_t length = ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(dictionary, NULL);
+    assertTrue(length == 0, "No payload and no signer, expected 0 got %zd", length);
+
+    length = ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(dictionary, signer);
+    assertTrue(length == 4, "The signer computes a CRC32C payload, expected 4 got %zd", length);
+
+    ccnxValidationFacadeV1_SetPayload(dictionary, payload);
+    length = ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(dictionary, signer);
+    assertTrue(length == sizeof(encoded), "Wrong length, expected %zu got %zd", sizeof(encoded), length);
+
+    ccnxTlvDictionary_Release(&dictionary);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&payload);
+}
+
+LONGBOW_TEST_CASE(EncodePayload, ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength_Hmac)
+{
+    PARCBuffer *password = parcBuffer_Wrap("password", 8, 0, 8);
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(password);
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+
+    ssize_t length = ccnxCodecSchemaV1ValidationEncoder_GetPayloadLength(dictionary, signer);
+    assertTrue(length == 32, "The signer computes an HMAC-SHA256 payload, expected 32 got %zd", length);
+
+    ccnxTlvDictionary_Release(&dictionary);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&password);
+}
+
+/*
+ * A SubjectPublicKeyInfo shaped like a 1024-bit RSA key: the modulus INTEGER is 129 bytes with a
+ * leading 0, the exponent is 65537.
+ */
+static PARCBuffer *
+_createRsaPublicKey(size_t modulusLength)
+{
+    uint8_t header[] = {
+        0x30, 0x81, 0x9f,
+        0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00,
+        0x03, 0x81, 0x8d, 0x00,
+        0x30, 0x81, 0x89,
+        0x02, 0x81, 0x81, 0x00
+    };
+    uint8_t exponent[] = { 0x02, 0x03, 0x01, 0x00, 0x01 };
+
+    PARCBuffer *der = parcBuffer_Allocate(sizeof(header) + modulusLength + sizeof(exponent));
+    parcBuffer_PutArray(der, sizeof(header), header);
+    for (size_t i = 0; i < modulusLength; i++) {
+        parcBuffer_PutUint8(der, 0xC5);
+    }
+    parcBuffer_PutArray(der, sizeof(exponent), exponent);
+    return parcBuffer_Flip(der);
+}
+
+LONGBOW_TEST_CASE(EncodePayload, _rsaModulusLength)
+{
+    PARCBuffer *der = _createRsaPublicKey(128);
+    ssize_t length = _rsaModulusLength(der);
+    assertTrue(length == 128, "Wrong modulus length, expected 128 got %zd", length);
+    parcBuffer_Release(&der);
+}
+
+LONGBOW_TEST_CASE(EncodePayload, _rsaModulusLength_Invalid)
+{
+    // the lengths in the header say 128 modulus bytes, but only 16 follow
+    PARCBuffer *der = _createRsaPublicKey(16);
+    ssize_t length = _rsaModulusLength(der);
+    assertTrue(length == -1, "Truncated key should have no modulus length, got %zd", length);
+    parcBuffer_Release(&der);
+}
+
 // =========================================================================
 
 int
@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxCodec_MemoryBlockPool.c"
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct test_data {
+    CCNxCodecMemoryBlockPool *pool;
+} TestData;
+
+static TestData *
+_commonSetup(void)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+    data->pool = ccnxCodecMemoryBlockPool_Create(4096, 16, false);
+    return data;
+}
+
+static void
+_commonTeardown(TestData *data)
+{
+    ccnxCodecMemoryBlockPool_Release(&data->pool);
+    parcMemory_Deallocate((void **) &data);
+}
+
+LONGBOW_TEST_RUNNER(ccnxCodec_MemoryBlockPool)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxCodec_MemoryBlockPool)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodec_MemoryBlockPool)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecMemoryBlockPool_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecMemoryBlockPool_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecMemoryBlockPool_Create_HugePages);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecMemoryBlockPool_GetBlockSize);
+
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_Allocate);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_Allocate_Reuse);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_Allocate_NextSlab);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_Allocate_Oversized);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_ThreadExit);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_ReleaseOnOtherThread);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_ReleaseAfterOwnerExit);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_AdoptOrphans);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_NetworkBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, PooledMemoryBlock_NetworkBuffer_DefaultBlocks);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    longBowTestCase_SetClipBoardData(testCase, _commonSetup());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _commonTeardown(longBowTestCase_GetClipBoardData(testCase));
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecMemoryBlockPool_Acquire)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxCodecMemoryBlockPool *copy = ccnxCodecMemoryBlockPool_Acquire(data->pool);
+    assertTrue(copy == data->pool, "Acquire should return the same pool");
+    ccnxCodecMemoryBlockPool_Release(&copy);
+    assertNull(copy, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecMemoryBlockPool_Create)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    assertTrue(data->pool->stride % _CCNxCodecMemoryBlockPool_Alignment == 0, "Stride %zu not aligned", data->pool->stride);
+    assertTrue(data->pool->stride >= 4096 + sizeof(_CCNxCodecMemoryBlockPoolBlock), "Stride %zu too small", data->pool->stride);
+    assertTrue(data->pool->blocksPerSlab == 16, "Wrong blocks per slab, expected 16 got %zu", data->pool->blocksPerSlab);
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.slabs == 0, "Should not map a slab before the first allocation, got %zu", statistics.slabs);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecMemoryBlockPool_Create_HugePages)
+{
+    CCNxCodecMemoryBlockPool *pool = ccnxCodecMemoryBlockPool_Create(4096, 16, true);
+    assertTrue(pool->slabLength % _CCNxCodecMemoryBlockPool_HugePageSize == 0, "Slab length %zu not a multiple of the huge page size", pool->slabLength);
+    assertTrue(pool->blocksPerSlab >= 16, "Should carve at least 16 blocks per slab, got %zu", pool->blocksPerSlab);
+
+    // Works whether or not the system has huge pages reserved
+    void *memory;
+    size_t granted = PooledMemoryBlock.allocator(pool, 100, &memory);
+    assertTrue(granted == 4096, "Wrong grant, expected 4096 got %zu", granted);
+    memset(memory, 0xAA, granted);
+    PooledMemoryBlock.deallocator(pool, &memory);
+
+    ccnxCodecMemoryBlockPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecMemoryBlockPool_GetBlockSize)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    size_t blockSize = ccnxCodecMemoryBlockPool_GetBlockSize(data->pool);
+    assertTrue(blockSize == 4096, "Wrong block size, expected 4096 got %zu", blockSize);
+}
+
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_Allocate)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    void *memory;
+    size_t granted = PooledMemoryBlock.allocator(data->pool, 1000, &memory);
+    assertTrue(granted == 4096, "Wrong grant, expected 4096 got %zu", granted);
+    assertTrue((uintptr_t) memory % _CCNxCodecMemoryBlockPool_Alignment == 0, "Block %p not aligned", memory);
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.misses == 1, "Expected 1 miss, got %" PRIu64, statistics.misses);
+    assertTrue(statistics.hits == 0, "Expected 0 hits, got %" PRIu64, statistics.hits);
+    assertTrue(statistics.outstanding == 1, "Expected 1 outstanding, got %" PRId64, statistics.outstanding);
+    assertTrue(statistics.slabs == 1, "Expected 1 slab, got %zu", statistics.slabs);
+
+    PooledMemoryBlock.deallocator(data->pool, &memory);
+    assertNull(memory, "Deallocator did not null the pointer");
+
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.outstanding == 0, "Expected 0 outstanding, got %" PRId64, statistics.outstanding);
+    assertTrue(statistics.highWater == 1, "Expected high water 1, got %" PRId64, statistics.highWater);
+}
+
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_Allocate_Reuse)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    void *first;
+    void *second;
+    PooledMemoryBlock.allocator(data->pool, 4096, &first);
+    void *expected = first;
+    PooledMemoryBlock.deallocator(data->pool, &first);
+
+    PooledMemoryBlock.allocator(data->pool, 4096, &second);
+    assertTrue(second == expected, "Should have reused the released block");
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.hits == 1, "Expected 1 hit, got %" PRIu64, statistics.hits);
+    assertTrue(statistics.misses == 1, "Expected 1 miss, got %" PRIu64, statistics.misses);
+
+    PooledMemoryBlock.deallocator(data->pool, &second);
+}
+
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_Allocate_NextSlab)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    size_t count = data->pool->blocksPerSlab + 1;
+    void *blocks[count];
+    for (size_t i = 0; i < count; i++) {
+        PooledMemoryBlock.allocator(data->pool, 2048, &blocks[i]);
+        memset(blocks[i], (int) i, 4096);
+    }
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.slabs == 2, "Expected 2 slabs, got %zu", statistics.slabs);
+    assertTrue(statistics.highWater == (int64_t) count, "Expected high water %zu, got %" PRId64, count, statistics.highWater);
+
+    for (size_t i = 0; i < count; i++) {
+        assertTrue(((uint8_t *) blocks[i])[4095] == (uint8_t) i, "Block %zu was overwritten", i);
+        PooledMemoryBlock.deallocator(data->pool, &blocks[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_Allocate_Oversized)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    void *memory;
+    size_t granted = PooledMemoryBlock.allocator(data->pool, 10000, &memory);
+    assertTrue(granted == 10000, "Wrong grant, expected 10000 got %zu", granted);
+    memset(memory, 0, granted);
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.misses == 1, "Expected 1 miss, got %" PRIu64, statistics.misses);
+    assertTrue(statistics.slabs == 0, "Oversized block should not map a slab, got %zu", statistics.slabs);
+
+    PooledMemoryBlock.deallocator(data->pool, &memory);
+}
+
+static void *
+_allocateAndExit(void *arg)
+{
+    CCNxCodecMemoryBlockPool *pool = arg;
+    void *memory;
+    PooledMemoryBlock.allocator(pool, 100, &memory);
+    PooledMemoryBlock.deallocator(pool, &memory);
+    return NULL;
+}
+
+/*
+ * A thread that exits gives its free blocks and the rest of its slab to the pool.  The next
+ * thread to run dry takes them instead of mapping a slab.
+ */
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_ThreadExit)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _allocateAndExit, data->pool);
+    pthread_join(thread, NULL);
+
+    assertNotNull(data->pool->orphans, "Exiting thread should have left its blocks to the pool");
+
+    size_t count = data->pool->blocksPerSlab;
+    void *blocks[count];
+    for (size_t i = 0; i < count; i++) {
+        PooledMemoryBlock.allocator(data->pool, 100, &blocks[i]);
+    }
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.slabs == 1, "Should have reused the exited thread's slab, got %zu slabs", statistics.slabs);
+    assertTrue(statistics.misses == 1, "Expected 1 miss to take the orphans, got %" PRIu64, statistics.misses);
+
+    for (size_t i = 0; i < count; i++) {
+        PooledMemoryBlock.deallocator(data->pool, &blocks[i]);
+    }
+}
+
+typedef struct consumer {
+    CCNxCodecMemoryBlockPool *pool;
+    int blocks[2];      /**< The producer writes block pointers here, NULL to stop */
+    int done[2];        /**< The consumer writes a byte here after releasing each round */
+    CCNxCodecMemoryBlockPoolStatistics statistics;  /**< The consumer's statistics when it stopped */
+} _Consumer;
+
+static void *
+_consumeBlocks(void *arg)
+{
+    _Consumer *consumer = arg;
+    void *memory;
+    while (read(consumer->blocks[0], &memory, sizeof(memory)) == sizeof(memory) && memory != NULL) {
+        PooledMemoryBlock.deallocator(consumer->pool, &memory);
+        if (write(consumer->done[1], "", 1) != 1) {
+            break;
+        }
+    }
+    ccnxCodecMemoryBlockPool_GetStatistics(consumer->pool, &consumer->statistics);
+    return NULL;
+}
+
+/*
+ * A producer that hands every block to a long lived consumer gets the blocks back, so the
+ * pool does not keep mapping slabs.  The releases count against the producer.
+ */
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_ReleaseOnOtherThread)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    _Consumer consumer = { .pool = data->pool };
+    assertTrue(pipe(consumer.blocks) == 0 && pipe(consumer.done) == 0, "Could not create pipes");
+    pthread_t thread;
+    pthread_create(&thread, NULL, _consumeBlocks, &consumer);
+
+    size_t rounds = data->pool->blocksPerSlab * 10;
+    for (size_t i = 0; i < rounds; i++) {
+        void *memory;
+        PooledMemoryBlock.allocator(data->pool, 100, &memory);
+        assertTrue(write(consumer.blocks[1], &memory, sizeof(memory)) == sizeof(memory), "Could not send the block");
+        char ack;
+        assertTrue(read(consumer.done[0], &ack, 1) == 1, "Consumer did not release the block");
+    }
+
+    void *stop = NULL;
+    assertTrue(write(consumer.blocks[1], &stop, sizeof(stop)) == sizeof(stop), "Could not stop the consumer");
+    pthread_join(thread, NULL);
+    close(consumer.blocks[0]);
+    close(consumer.blocks[1]);
+    close(consumer.done[0]);
+    close(consumer.done[1]);
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.slabs == 1, "Released blocks should return to the producer, got %zu slabs after %zu rounds",
+               statistics.slabs, rounds);
+    assertTrue(statistics.outstanding == 0, "Expected 0 outstanding on the producer, got %" PRId64, statistics.outstanding);
+    assertTrue(statistics.highWater == 1, "Expected high water 1 on the producer, got %" PRId64, statistics.highWater);
+    assertTrue(consumer.statistics.outstanding == 0, "Expected 0 outstanding on the consumer, got %" PRId64, consumer.statistics.outstanding);
+}
+
+static void *
+_allocateAndKeep(void *arg)
+{
+    void *memory;
+    PooledMemoryBlock.allocator(arg, 100, &memory);
+    return memory;
+}
+
+/*
+ * A block released after its owning thread exited goes to the orphans for other threads
+ */
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_ReleaseAfterOwnerExit)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    pthread_t thread;
+    void *memory;
+    pthread_create(&thread, NULL, _allocateAndKeep, data->pool);
+    pthread_join(thread, &memory);
+
+    data->pool->orphans = NULL;
+    PooledMemoryBlock.deallocator(data->pool, &memory);
+
+    _CCNxCodecMemoryBlockPoolBlock *orphans = data->pool->orphans;
+    assertNotNull(orphans, "The block should have gone to the orphans");
+    assertNull(orphans->next, "Expected only the released block in the orphans");
+}
+
+/*
+ * Orphaned blocks taken by a thread become its own, so releasing one goes back to its free list
+ */
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_AdoptOrphans)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    pthread_t thread;
+    void *kept;
+    pthread_create(&thread, NULL, _allocateAndKeep, data->pool);
+    pthread_join(thread, &kept);
+    assertNotNull(data->pool->orphans, "The exited thread's uncarved blocks should be orphans");
+
+    void *memory;
+    PooledMemoryBlock.allocator(data->pool, 100, &memory);
+    _CCNxCodecMemoryBlockPoolThread *self = _ccnxCodecMemoryBlockPool_GetThread(data->pool);
+    _CCNxCodecMemoryBlockPoolBlock *block = (_CCNxCodecMemoryBlockPoolBlock *) ((uint8_t *) memory - sizeof(_CCNxCodecMemoryBlockPoolBlock));
+    assertTrue(block->owner == self, "An adopted block should belong to this thread");
+    for (_CCNxCodecMemoryBlockPoolBlock *free = self->freeList; free != NULL; free = free->next) {
+        assertTrue(free->owner == self, "Every adopted block should belong to this thread");
+    }
+
+    _CCNxCodecMemoryBlockPoolBlock *orphans = data->pool->orphans;
+    PooledMemoryBlock.deallocator(data->pool, &memory);
+    assertTrue(self->freeList == block, "The adopted block should go back to this thread's free list");
+    assertTrue(data->pool->orphans == orphans, "The adopted block should not go back to the orphans");
+
+    PooledMemoryBlock.deallocator(data->pool, &kept);
+}
+
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_NetworkBuffer)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    for (int i = 0; i < 2; i++) {
+        CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&PooledMemoryBlock, data->pool);
+        uint8_t array[5000];
+        memset(array, i, sizeof(array));
+        ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(array), array);
+
+        PARCBuffer *buffer = ccnxCodecNetworkBuffer_CreateParcBuffer(netbuff);
+        assertTrue(parcBuffer_Remaining(buffer) == sizeof(array), "Wrong length, expected %zu got %zu", sizeof(array), parcBuffer_Remaining(buffer));
+        parcBuffer_Release(&buffer);
+        ccnxCodecNetworkBuffer_Release(&netbuff);
+    }
+
+    // The first buffer maps a slab, the second one runs entirely from the free list
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(data->pool, &statistics);
+    assertTrue(statistics.outstanding == 0, "Expected 0 outstanding, got %" PRId64, statistics.outstanding);
+    assertTrue(statistics.hits == statistics.misses, "Second buffer should only hit, got %" PRIu64 " hits %" PRIu64 " misses",
+               statistics.hits, statistics.misses);
+}
+
+/*
+ * A pool of 2048 byte blocks serves the first and expansion blocks of ccnxCodecNetworkBuffer_Create(),
+ * header included, so nothing falls through to parcMemory.
+ */
+LONGBOW_TEST_CASE(Global, PooledMemoryBlock_NetworkBuffer_DefaultBlocks)
+{
+    CCNxCodecMemoryBlockPool *pool = ccnxCodecMemoryBlockPool_Create(2048, 16, false);
+
+    for (int i = 0; i < 2; i++) {
+        CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&PooledMemoryBlock, pool);
+        uint8_t array[6000];
+        memset(array, i, sizeof(array));
+        ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(array), array);
+        ccnxCodecNetworkBuffer_Release(&netbuff);
+    }
+
+    // 1536 + 3 * 1984 bytes, so each buffer takes 4 blocks.  The first buffer carves them from one slab.
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(pool, &statistics);
+    assertTrue(statistics.slabs == 1, "Expected 1 slab, got %zu", statistics.slabs);
+    assertTrue(statistics.hits == statistics.misses && statistics.hits > 0,
+               "Second buffer should only hit, got %" PRIu64 " hits %" PRIu64 " misses", statistics.hits, statistics.misses);
+
+    ccnxCodecMemoryBlockPool_Release(&pool);
+}
+
+// =========================================================================
+
+static void
+_benchmarkNetworkBuffer(const char *label, const CCNxCodecNetworkBufferMemoryBlockFunctions *functions, void *userarg, unsigned reps)
+{
+    uint8_t array[3000];
+    memset(array, 0, sizeof(array));
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (unsigned i = 0; i < reps; i++) {
+        CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(functions, userarg);
+        ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(array), array);
+        ccnxCodecNetworkBuffer_Release(&netbuff);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double nanoseconds = (t1.tv_sec - t0.tv_sec) * 1E9 + (t1.tv_nsec - t0.tv_nsec);
+    printf("%-40s %10.1f ns/packet\n", label, nanoseconds / reps);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, PooledMemoryBlock_NetworkBuffer);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Performance, PooledMemoryBlock_NetworkBuffer)
+{
+    unsigned reps = 100000;
+    CCNxCodecMemoryBlockPool *pool = ccnxCodecMemoryBlockPool_Create(4096, 256, true);
+
+    _benchmarkNetworkBuffer("ParcMemoryMemoryBlock", &ParcMemoryMemoryBlock, NULL, reps);
+    _benchmarkNetworkBuffer("PooledMemoryBlock", &PooledMemoryBlock, pool, reps);
+
+    CCNxCodecMemoryBlockPoolStatistics statistics;
+    ccnxCodecMemoryBlockPool_GetStatistics(pool, &statistics);
+    printf("pool hits %" PRIu64 " misses %" PRIu64 " high water %" PRId64 " slabs %zu\n",
+           statistics.hits, statistics.misses, statistics.highWater, statistics.slabs);
+
+    ccnxCodecMemoryBlockPool_Release(&pool);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxCodec_MemoryBlockPool);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -39,10 +39,13 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <arpa/inet.h>
+#include <time.h>
 
 #include <parc/security/parc_PublicKeySignerPkcs12Store.h>
 #include <parc/security/parc_Security.h>
 
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
+
 typedef struct test_data {
     CCNxCodecNetworkBuffer *buffer;
 } TestData;
@@ -71,6 +74,7 @@ LONGBOW_TEST_RUNNER(ccnx_NetworkBuffer)
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
     LONGBOW_RUN_TEST_FIXTURE(SetLimit);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -92,10 +96,15 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_Acquire);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_ComputeSignature);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_ComputeSignature_LaterBlock);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_Create);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateFromArray);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithCapacity);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithSizeHint);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithSizeHint_Small);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateIoVec);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateIoVecRanges);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_Display);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_GetUint8);
@@ -108,9 +117,14 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutArray_NoSpace);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutArray_SpanThree);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBufferReference);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBufferReference_FullBlock);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBufferReference_Empty);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint16);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint16_ExactFit);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint64);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint64_withnext);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint8_SpaceOk);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint8_SpaceToZero);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint8_NoSpace);
@@ -127,6 +141,11 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_GetCount);
     LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_Length);
     LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_Display);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_GetReferenceCount);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_CreateHeaderCopy);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_CreateHeaderCopy_SpansBlocks);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_CreateHeaderCopyFromBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNetworkbufferIoVec_Equals_DifferentExtents);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -228,6 +247,53 @@ LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_ComputeSignature)
     parcSecurity_Fini();
 }
 
+/*
+ * Signed areas that start in the second block, one ending in that block and one running to the
+ * limit, must be signed over exactly their bytes.
+ */
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_ComputeSignature_LaterBlock)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    uint8_t bytes[6000];
+    for (size_t i = 0; i < sizeof(bytes); i++) {
+        bytes[i] = (uint8_t) (i * 7);
+    }
+    ccnxCodecNetworkBuffer_PutArray(data->buffer, sizeof(bytes), bytes);
+    ccnxCodecNetworkBuffer_Finalize(data->buffer);
+
+    CCNxCodecNetworkBufferMemory *second = data->buffer->head->next;
+    assertNotNull(second, "Expected the bytes to span several blocks");
+    assertNotNull(second->next, "Expected the bytes to span at least three blocks");
+
+    size_t ranges[][2] = {
+        { second->begin + 10, second->begin + second->limit - 10 },
+        { second->begin + 1,  sizeof(bytes)                      },
+    };
+
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        size_t start = ranges[i][0];
+        size_t end = ranges[i][1];
+
+        PARCSignature *test = ccnxCodecNetworkBuffer_ComputeSignature(data->buffer, start, end, signer);
+
+        PARCCryptoHasher *hasher = parcSigner_GetCryptoHasher(signer);
+        parcCryptoHasher_Init(hasher);
+        parcCryptoHasher_UpdateBytes(hasher, &bytes[start], end - start);
+        PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
+        PARCSignature *truth = parcSigner_SignDigest(signer, hash);
+
+        assertTrue(parcBuffer_Equals(parcSignature_GetSignature(truth), parcSignature_GetSignature(test)),
+                   "Wrong signature for range %zu [%zu, %zu)", i, start, end);
+
+        parcSignature_Release(&truth);
+        parcCryptoHash_Release(&hash);
+        parcSignature_Release(&test);
+    }
+    parcSigner_Release(&signer);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_Create)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -268,6 +334,71 @@ LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateFromArray)
 }
 
 
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithCapacity)
+{
+    size_t capacity = 3000;
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_CreateWithCapacity(&ParcMemoryMemoryBlock, NULL, capacity);
+    assertTrue(netbuff->head->capacity == capacity, "Wrong capacity, got %zu expected %zu", netbuff->head->capacity, capacity);
+
+    for (size_t i = 0; i < capacity; i++) {
+        ccnxCodecNetworkBuffer_PutUint8(netbuff, (uint8_t) i);
+    }
+    assertTrue(netbuff->head == netbuff->tail, "Filling to capacity should not add a memory block");
+
+    // It still grows past the capacity
+    ccnxCodecNetworkBuffer_PutUint8(netbuff, 0);
+    assertTrue(netbuff->head != netbuff->tail, "Writing past capacity should add a memory block");
+    assertTrue(ccnxCodecNetworkBuffer_Position(netbuff) == capacity + 1, "Wrong position, got %zu expected %zu",
+               ccnxCodecNetworkBuffer_Position(netbuff), capacity + 1);
+
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithSizeHint)
+{
+    size_t sizeHint = 9000;
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_CreateWithSizeHint(&ParcMemoryMemoryBlock, NULL, sizeHint);
+    assertTrue(netbuff->head->capacity >= sizeHint, "Capacity %zu smaller than the hint %zu", netbuff->head->capacity, sizeHint);
+    assertTrue(netbuff->head->capacity % _CCNxCodecNetworkBuffer_CacheLineSize == 0,
+               "Capacity %zu not a multiple of the cache line", netbuff->head->capacity);
+    assertTrue((uintptr_t) netbuff->head->memory % _CCNxCodecNetworkBuffer_CacheLineSize == 0,
+               "Memory %p not cache line aligned", (void *) netbuff->head->memory);
+
+    uint8_t array[9000];
+    memset(array, 0x5A, sizeof(array));
+    ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(array), array);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == 1, "A packet of the hinted size should be one iovec, got %d",
+               ccnxCodecNetworkBufferIoVec_GetCount(vec));
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+    // Growing past the hint adds a block of the same size
+    ccnxCodecNetworkBuffer_PutArray(netbuff, netbuff->head->capacity - sizeof(array), array);
+    ccnxCodecNetworkBuffer_PutUint8(netbuff, 0);
+    assertTrue(netbuff->tail->capacity == netbuff->head->capacity, "Expansion block wrong size, got %zu expected %zu",
+               netbuff->tail->capacity, netbuff->head->capacity);
+
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithSizeHint_Small)
+{
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_CreateWithSizeHint(&ParcMemoryMemoryBlock, NULL, 100);
+    size_t expected = _CCNxCodecNetworkBuffer_RoundToCacheLine(100);
+    assertTrue(netbuff->head->capacity == expected, "Wrong capacity, got %zu expected %zu", netbuff->head->capacity, expected);
+
+    // A small hint does not make small expansion blocks
+    uint8_t array[expected];
+    memset(array, 0x5A, sizeof(array));
+    ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(array), array);
+    ccnxCodecNetworkBuffer_PutUint8(netbuff, 0);
+    assertTrue(netbuff->tail->capacity == _ccnxCodecNetworkBuffer_DefaultBlockSize, "Expansion block wrong size, got %zu expected %zu",
+               netbuff->tail->capacity, _ccnxCodecNetworkBuffer_DefaultBlockSize);
+
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateIoVec)
 {
     // Write an array that will span 3 blocks
@@ -292,6 +423,44 @@ LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateIoVec)
     ccnxCodecNetworkBufferIoVec_Release(&vec);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateIoVecRanges)
+{
+    // Write an array that will span 5 blocks: the 1536 byte first block, three default blocks and the rest
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    size_t arrayLength = 8192;
+    uint8_t array[arrayLength];
+    for (size_t i = 0; i < arrayLength; i++) {
+        array[i] = i;
+    }
+    ccnxCodecNetworkBuffer_PutArray(data->buffer, arrayLength, array);
+
+    // inside the first block, empty, to the end of the first block, across one boundary, across two boundaries
+    size_t ends[] = { 100, 100, 1536, 4000, 8192 };
+    size_t count = sizeof(ends) / sizeof(ends[0]);
+    size_t firstIndex[count + 1];
+    size_t truthIndex[] = { 0, 1, 1, 2, 4, 7 };
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVecRanges(data->buffer, count, ends, firstIndex);
+    for (size_t i = 0; i <= count; i++) {
+        assertTrue(firstIndex[i] == truthIndex[i], "Wrong firstIndex[%zu], got %zu expected %zu", i, firstIndex[i], truthIndex[i]);
+    }
+    assertTrue(vec->iovcnt == 7, "iovcnt wrong got %d expected %d", vec->iovcnt, 7);
+    assertTrue(vec->totalBytes == arrayLength, "Wrong total bytes, got %zu expected %zu", vec->totalBytes, arrayLength);
+
+    // each range must hold exactly its bytes of the pattern
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = firstIndex[i]; j < firstIndex[i + 1]; j++) {
+            assertTrue(memcmp(iov[j].iov_base, &array[offset], iov[j].iov_len) == 0, "Wrong bytes in element %zu", j);
+            offset += iov[j].iov_len;
+        }
+        assertTrue(offset == ends[i], "Range %zu ends at %zu expected %zu", i, offset, ends[i]);
+    }
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
 /*
  * not much to do excpet make sure there's no leaks or assertions
  */
@@ -395,6 +564,77 @@ LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBuffer)
     parcBuffer_Release(&buffer);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBufferReference)
+{
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+    uint8_t array[3000];
+    for (size_t i = 0; i < sizeof(array); i++) {
+        array[i] = i;
+    }
+    PARCBuffer *payload = parcBuffer_Wrap(array, sizeof(array), 0, sizeof(array));
+
+    ccnxCodecNetworkBuffer_PutUint32(netbuff, 0x01020304);
+    ccnxCodecNetworkBuffer_PutBufferReference(netbuff, payload);
+    ccnxCodecNetworkBuffer_PutUint16(netbuff, 0x0506);
+
+    size_t expectedLength = 4 + sizeof(array) + 2;
+    assertTrue(netbuff->position == expectedLength, "Wrong position, got %zu expected %zu", netbuff->position, expectedLength);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == 3, "Wrong iovcnt, got %d expected 3", ccnxCodecNetworkBufferIoVec_GetCount(vec));
+    assertTrue(iov[1].iov_base == array, "Payload iovec should point at the caller's memory");
+    assertTrue(iov[1].iov_len == sizeof(array), "Wrong payload iovec length, got %zu", iov[1].iov_len);
+    assertTrue(iov[2].iov_base == (uint8_t *) iov[0].iov_base + 4, "Trailer should be written in the first block after the header");
+
+    PARCBuffer *flat = ccnxCodecNetworkBuffer_CreateParcBuffer(netbuff);
+    assertTrue(parcBuffer_Remaining(flat) == expectedLength, "Wrong flat length, got %zu expected %zu", parcBuffer_Remaining(flat), expectedLength);
+    assertTrue(parcBuffer_GetAtIndex(flat, 3) == 0x04, "Wrong header byte");
+    assertTrue(memcmp(parcBuffer_Overlay(flat, 0) + 4, array, sizeof(array)) == 0, "Wrong payload bytes");
+    assertTrue(parcBuffer_GetAtIndex(flat, expectedLength - 1) == 0x06, "Wrong trailer byte");
+
+    parcBuffer_Release(&flat);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+    parcBuffer_Release(&payload);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBufferReference_FullBlock)
+{
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+    size_t fill = netbuff->head->capacity;
+    uint8_t header[fill];
+    memset(header, 0x5A, fill);
+    ccnxCodecNetworkBuffer_PutArray(netbuff, fill, header);
+
+    uint8_t array[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    PARCBuffer *payload = parcBuffer_Wrap(array, sizeof(array), 0, sizeof(array));
+    ccnxCodecNetworkBuffer_PutBufferReference(netbuff, payload);
+    parcBuffer_Release(&payload);
+
+    // No room left in the first block, so the trailer goes in a new block
+    ccnxCodecNetworkBuffer_PutUint8(netbuff, 0xFF);
+
+    assertTrue(_ccnxCodecNetworkBuffer_BlockCount(netbuff) == 3, "Wrong block count, got %zu expected 3", _ccnxCodecNetworkBuffer_BlockCount(netbuff));
+    assertTrue(ccnxCodecNetworkBuffer_GetUint8(netbuff, fill + 7) == 8, "Wrong payload byte");
+    assertTrue(ccnxCodecNetworkBuffer_GetUint8(netbuff, fill + 8) == 0xFF, "Wrong trailer byte");
+
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutBufferReference_Empty)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *payload = parcBuffer_Allocate(0);
+
+    size_t blocks = _ccnxCodecNetworkBuffer_BlockCount(data->buffer);
+    ccnxCodecNetworkBuffer_PutBufferReference(data->buffer, payload);
+    assertTrue(_ccnxCodecNetworkBuffer_BlockCount(data->buffer) == blocks, "An empty reference should not add a block");
+    assertNull(data->buffer->references, "An empty reference should not be kept");
+
+    parcBuffer_Release(&payload);
+}
+
 
 LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint16)
 {
@@ -430,6 +670,62 @@ LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint64)
     }
 }
 
+/*
+ * The current block has exactly 2 bytes left.  The uint16 should fill the block without
+ * allocating another one.
+ */
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint16_ExactFit)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    size_t start = data->buffer->current->capacity - 2;
+    data->buffer->current->limit = start;
+    data->buffer->position = start;
+
+    ccnxCodecNetworkBuffer_PutUint16(data->buffer, 0x1234);
+    assertTrue(data->buffer->position == start + 2, "Wrong position, got %zu expected %zu", data->buffer->position, start + 2);
+    assertTrue(data->buffer->head == data->buffer->tail, "Should not have allocated another block");
+    assertTrue(data->buffer->current->limit == data->buffer->current->capacity,
+               "Wrong limit, got %zu expected %zu", data->buffer->current->limit, data->buffer->current->capacity);
+
+    uint8_t truthValue[] = { 0x12, 0x34 };
+    assertTrue(memcmp(&data->buffer->current->memory[start], truthValue, sizeof(truthValue)) == 0, "wrong memory")
+    {
+        ccnxCodecNetworkBuffer_Display(data->buffer, 0);
+    }
+}
+
+/*
+ * The current block only has 3 bytes left and there is a next block.  The uint64 must
+ * be split 3 and 5 bytes over the two blocks.
+ */
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_PutUint64_withnext)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    size_t start = data->buffer->current->capacity - 3;
+    size_t nextPosition = start + 8;
+
+    data->buffer->current->limit = data->buffer->current->capacity;
+    data->buffer->position = data->buffer->current->limit;
+    _ccnxCodecNetworkBuffer_AllocateIfNeeded(data->buffer);
+
+    ccnxCodecNetworkBuffer_SetPosition(data->buffer, start);
+    ccnxCodecNetworkBuffer_PutUint64(data->buffer, 0xABCDEF0122334455);
+    assertTrue(data->buffer->position == nextPosition, "Wrong position, got %zu expected %zu", data->buffer->position, nextPosition);
+
+    uint8_t truthValue[] = { 0xAB, 0xCD, 0xEF, 0x01, 0x22, 0x33, 0x44, 0x55 };
+    assertTrue(memcmp(&data->buffer->head->memory[start], truthValue, 3) == 0, "wrong memory in first buffer")
+    {
+        ccnxCodecNetworkBuffer_Display(data->buffer, 0);
+    }
+
+    assertTrue(memcmp(&data->buffer->tail->memory[0], truthValue + 3, 5) == 0, "wrong memory in second buffer")
+    {
+        ccnxCodecNetworkBuffer_Display(data->buffer, 0);
+    }
+}
+
 /*
  * Put a uint32 in to a block with plenty of space
  */
@@ -729,6 +1025,126 @@ LONGBOW_TEST_CASE(Global, ccnxNetworkbufferIoVec_Display)
     ccnxCodecNetworkBufferIoVec_Release(&vec);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxNetworkbufferIoVec_GetReferenceCount)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(data->buffer);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetReferenceCount(vec) == 1, "Wrong refcount, got %u expected 1", ccnxCodecNetworkBufferIoVec_GetReferenceCount(vec));
+
+    CCNxCodecNetworkBufferIoVec *second = ccnxCodecNetworkBufferIoVec_Acquire(vec);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetReferenceCount(vec) == 2, "Wrong refcount, got %u expected 2", ccnxCodecNetworkBufferIoVec_GetReferenceCount(vec));
+
+    ccnxCodecNetworkBufferIoVec_Release(&second);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+static void
+_assertHeaderCopy(CCNxCodecNetworkBufferIoVec *vec, size_t headerLength)
+{
+    CCNxCodecNetworkBufferIoVec *copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopy(vec, headerLength);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Equals(vec, copy), "The header copy should equal the original");
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetReferenceCount(vec) == 2, "The header copy should hold a reference to the original");
+
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(copy);
+    assertTrue(iov[0].iov_len == headerLength, "Wrong header length, got %zu expected %zu", iov[0].iov_len, headerLength);
+
+    // writing the private header must not change the original
+    memset(iov[0].iov_base, 0xFF, headerLength);
+    assertFalse(ccnxCodecNetworkBufferIoVec_Equals(vec, copy), "Writing the header copy changed the original");
+
+    ccnxCodecNetworkBufferIoVec_Release(&copy);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetReferenceCount(vec) == 1, "Releasing the header copy should release the original");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNetworkbufferIoVec_CreateHeaderCopy)
+{
+    // Write an array that will span 3 blocks
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    size_t arrayLength = 8192;
+    uint8_t array[arrayLength];
+    for (size_t i = 0; i < arrayLength; i++) {
+        array[i] = i;
+    }
+
+    ccnxCodecNetworkBuffer_PutArray(data->buffer, arrayLength, array);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(data->buffer);
+
+    _assertHeaderCopy(vec, 8);
+
+    // only the header is copied, the rest of the first extent and the other extents are shared
+    CCNxCodecNetworkBufferIoVec *copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopy(vec, 8);
+    const struct iovec *original = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(copy);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(copy) == ccnxCodecNetworkBufferIoVec_GetCount(vec) + 1,
+               "Wrong count, got %d expected %d", ccnxCodecNetworkBufferIoVec_GetCount(copy), ccnxCodecNetworkBufferIoVec_GetCount(vec) + 1);
+    assertTrue(iov[1].iov_base == (uint8_t *) original[0].iov_base + 8, "The rest of the first extent should be shared");
+    assertTrue(iov[2].iov_base == original[1].iov_base, "The second extent should be shared");
+    ccnxCodecNetworkBufferIoVec_Release(&copy);
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNetworkbufferIoVec_CreateHeaderCopy_SpansBlocks)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    size_t arrayLength = 8192;
+    uint8_t array[arrayLength];
+    for (size_t i = 0; i < arrayLength; i++) {
+        array[i] = i;
+    }
+
+    ccnxCodecNetworkBuffer_PutArray(data->buffer, arrayLength, array);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(data->buffer);
+    const struct iovec *original = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+
+    // a header ending exactly at the first extent, and one ending inside the second
+    _assertHeaderCopy(vec, original[0].iov_len);
+    _assertHeaderCopy(vec, original[0].iov_len + 10);
+    _assertHeaderCopy(vec, arrayLength);
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNetworkbufferIoVec_CreateHeaderCopyFromBuffer)
+{
+    uint8_t array[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    PARCBuffer *buffer = parcBuffer_Wrap(array, sizeof(array), 2, sizeof(array));
+
+    CCNxCodecNetworkBufferIoVec *copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopyFromBuffer(buffer, 4);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(copy) == sizeof(array) - 2,
+               "Wrong length, got %zu expected %zu", ccnxCodecNetworkBufferIoVec_Length(copy), sizeof(array) - 2);
+
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(copy);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(copy) == 2, "Wrong count, got %d expected 2", ccnxCodecNetworkBufferIoVec_GetCount(copy));
+    assertTrue(iov[0].iov_len == 4 && memcmp(iov[0].iov_base, &array[2], 4) == 0, "Wrong header copy");
+    assertTrue(iov[0].iov_base != &array[2], "The header should be a copy");
+    assertTrue(iov[1].iov_base == &array[6] && iov[1].iov_len == 6, "The rest of the buffer should be shared");
+
+    parcBuffer_Release(&buffer);
+    ccnxCodecNetworkBufferIoVec_Release(&copy);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNetworkbufferIoVec_Equals_DifferentExtents)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    uint8_t array[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    ccnxCodecNetworkBuffer_PutArray(data->buffer, sizeof(array), array);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(data->buffer);
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, sizeof(array), 0, sizeof(array));
+    CCNxCodecNetworkBufferIoVec *split = ccnxCodecNetworkBufferIoVec_CreateHeaderCopyFromBuffer(buffer, 5);
+    parcBuffer_Release(&buffer);
+
+    assertTrue(ccnxCodecNetworkBufferIoVec_Equals(vec, split), "Vectors with the same bytes in different extents should be equal");
+    assertTrue(ccnxCodecNetworkBufferIoVec_Equals(split, vec), "Equals should be symmetric");
+
+    ((uint8_t *) ccnxCodecNetworkBufferIoVec_GetArray(split)[0].iov_base)[4] = 0;
+    assertFalse(ccnxCodecNetworkBufferIoVec_Equals(vec, split), "Vectors with different bytes should not be equal");
+
+    ccnxCodecNetworkBufferIoVec_Release(&split);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
 // =====================================================================
 
 LONGBOW_TEST_FIXTURE(SetLimit)
@@ -761,19 +1177,23 @@ typedef struct setlimit_s {
     PARCBuffer *truth;
 } SetLimitData;
 
+// Where 'block 2' begins in the diagram below, 3577 with 2048 byte expansion blocks
+#define _SetLimitTailBegin (_ccnxCodecNetworkBuffer_DefaultFirstBlockSize + _ccnxCodecNetworkBuffer_DefaultBlockSize - 7)
+
 /*
- * In this test, SetLimit is called when we are at position 4036
+ * In this test, SetLimit is called at positions around 'block 2'.  B is the default
+ * expansion block size.
  *
  *    (always in ABSOLUTE bytes)
- *                                                                         position = 4077
- *    begin = 0                  begin = 1536               begin = 3577   |
+ *                                                                         position = 1536 + B - 7 + 500
+ *    begin = 0                  begin = 1536               begin = 1536 + B - 7
  *    |                          |                          |              |
  *   +--------------------------+--------------------------+--------------------------+
  *   |         block 0          |         block 1          |         block 2          |
  *   +--------------------------+--------------------------+--------------------------+
  *                             |                       |                   |          |
- *                          capacity = 1536        capacity = 2048         |      capacity = 2048
- *                          limit = 1536           limit = 2041        limit = 500
+ *                          capacity = 1536        capacity = B            |      capacity = B
+ *                          limit = 1536           limit = B - 7       limit = 500
  *    (always in RELATIVE bytes)
  */
 static SetLimitData
@@ -783,7 +1203,7 @@ _allocateData(void)
 
     data.netbuff = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
 
-    size_t buffer1_length = 3577;
+    size_t buffer1_length = _SetLimitTailBegin;
     uint8_t buffer1[buffer1_length];
     memset(buffer1, 0x11, buffer1_length);
 
@@ -791,15 +1211,16 @@ _allocateData(void)
     assertTrue(data.netbuff->position == buffer1_length, "Wrong position, expected %zu got %zu", buffer1_length, data.netbuff->position);
 
     // we should be in 'block1' in the diagram
-    assertTrue(data.netbuff->current->limit == 2041, "wrong limit, expected %u got %zu", 2041, data.netbuff->current->limit);
+    size_t block1Limit = _ccnxCodecNetworkBuffer_DefaultBlockSize - 7;
+    assertTrue(data.netbuff->current->limit == block1Limit, "wrong limit, expected %zu got %zu", block1Limit, data.netbuff->current->limit);
 
-    // now allocate the second buffer to move to 'block 2'.  this should freeze 'block 1' at 2000 bytes.
+    // now allocate the second buffer to move to 'block 2'.  this should freeze 'block 1' at B - 7 bytes.
 
     // now we need to write it at 8 bytes to get block 1 to freeze
     uint64_t x = 0x1234567812345678ULL;
 
     ccnxCodecNetworkBuffer_PutUint64(data.netbuff, x);
-    assertTrue(data.netbuff->position == 3585, "Wrong position, expected %u got %zu", 3585, data.netbuff->position);
+    assertTrue(data.netbuff->position == _SetLimitTailBegin + 8, "Wrong position, expected %zu got %zu", _SetLimitTailBegin + 8, data.netbuff->position);
     assertTrue(data.netbuff->current->limit == 8, "wrong limit, expected %u got %zu", 8, data.netbuff->current->limit);
 
     size_t buffer2_length = 492;
@@ -808,7 +1229,7 @@ _allocateData(void)
 
     ccnxCodecNetworkBuffer_PutArray(data.netbuff, buffer2_length, buffer2);
 
-    assertTrue(data.netbuff->position == 4077, "Wrong position, expected %u got %zu", 4077, data.netbuff->current->limit);
+    assertTrue(data.netbuff->position == _SetLimitTailBegin + 500, "Wrong position, expected %zu got %zu", _SetLimitTailBegin + 500, data.netbuff->position);
     assertTrue(data.netbuff->current->limit == 500, "wrong limit, expected %u got %zu", 500, data.netbuff->current->limit);
 
     data.truth = parcBuffer_Allocate(buffer1_length + buffer2_length + 8);
@@ -849,38 +1270,35 @@ _runDataTest(size_t position)
 }
 
 /*
- * In this test, SetLimit is called when we are at position 4077
+ * In this test, SetLimit is called when we are at the end of 'block 2'
  */
 LONGBOW_TEST_CASE(SetLimit, ccnxCodecNetworkBuffer_Finalize_EndOfTail)
 {
-    _runDataTest(4077);
+    _runDataTest(_SetLimitTailBegin + 500);
 }
 
 /*
- * In this test, SetLimit is called when we are at position 4000, which
- * is in the middle of 'block 2'
+ * In this test, SetLimit is called in the middle of 'block 2'
  */
 LONGBOW_TEST_CASE(SetLimit, ccnxCodecNetworkBuffer_Finalize_MidOfTail)
 {
-    _runDataTest(4000);
+    _runDataTest(_SetLimitTailBegin + 423);
 }
 
 /*
- * In this test, SetLimit is called when we are at position 3577, which
- * is in the start of 'block 2'
+ * In this test, SetLimit is called at the start of 'block 2'
  */
 LONGBOW_TEST_CASE(SetLimit, ccnxCodecNetworkBuffer_Finalize_StartOfTail)
 {
-    _runDataTest(3577);
+    _runDataTest(_SetLimitTailBegin);
 }
 
 /*
- * In this test, SetLimit is called when we are at position 3576, which
- * is the last byte of 'block 1'
+ * In this test, SetLimit is called at the last byte of 'block 1'
  */
 LONGBOW_TEST_CASE(SetLimit, ccnxCodecNetworkBuffer_Finalize_EndOfMid)
 {
-    _runDataTest(3576);
+    _runDataTest(_SetLimitTailBegin - 1);
 }
 
 /*
@@ -947,6 +1365,78 @@ LONGBOW_TEST_CASE(Local, _ccnxCodecNetworkBufferMemory_Allocate)
     _ccnxCodecNetworkBufferMemory_Release(data->buffer, &memory);
 }
 
+// =========================================================================
+
+/*
+ * A header-heavy packet: an 8-byte fixed header followed by small TLVs, so almost every
+ * write is a 2, 4 or 8 byte integer.  This is the shape of an Interest or a Manifest.
+ */
+typedef void (*_PutIntegers)(CCNxCodecNetworkBuffer *buffer, uint16_t type, uint64_t value);
+
+static void
+_putIntegersByByte(CCNxCodecNetworkBuffer *buffer, uint16_t type, uint64_t value)
+{
+    ccnxCodecNetworkBuffer_PutUint8(buffer, type >> 8);
+    ccnxCodecNetworkBuffer_PutUint8(buffer, type & 0xFF);
+    ccnxCodecNetworkBuffer_PutUint8(buffer, 0);
+    ccnxCodecNetworkBuffer_PutUint8(buffer, 8);
+    for (int i = sizeof(uint64_t) - 1; i >= 0; i--) {
+        ccnxCodecNetworkBuffer_PutUint8(buffer, (value >> (i * 8)) & 0xFF);
+    }
+}
+
+static void
+_putIntegersByWord(CCNxCodecNetworkBuffer *buffer, uint16_t type, uint64_t value)
+{
+    ccnxCodecNetworkBuffer_PutUint16(buffer, type);
+    ccnxCodecNetworkBuffer_PutUint16(buffer, 8);
+    ccnxCodecNetworkBuffer_PutUint64(buffer, value);
+}
+
+static void
+_benchmarkHeaders(const char *label, _PutIntegers put, unsigned reps)
+{
+    const unsigned tlvsPerPacket = 100;
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (unsigned i = 0; i < reps; i++) {
+        CCNxCodecNetworkBuffer *buffer = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+        ccnxCodecNetworkBuffer_PutUint32(buffer, 0x01000000);
+        ccnxCodecNetworkBuffer_PutUint32(buffer, 0x00000008);
+        for (unsigned j = 0; j < tlvsPerPacket; j++) {
+            put(buffer, j, (uint64_t) i * j);
+        }
+        ccnxCodecNetworkBuffer_Release(&buffer);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double nanoseconds = (t1.tv_sec - t0.tv_sec) * 1E9 + (t1.tv_nsec - t0.tv_nsec);
+    printf("%-40s %10.1f ns/packet\n", label, nanoseconds / reps);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecNetworkBuffer_PutHeaders);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxCodecNetworkBuffer_PutHeaders)
+{
+    unsigned reps = 100000;
+    _benchmarkHeaders("headers PutUint8", _putIntegersByByte, reps);
+    _benchmarkHeaders("headers PutUint16/PutUint64", _putIntegersByWord, reps);
+}
+
 int
 main(int argc, char *argv[])
 {
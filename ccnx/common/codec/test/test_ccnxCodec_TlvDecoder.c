@@ -43,6 +43,7 @@ LONGBOW_TEST_RUNNER(parc_Tlv)
     // Test Fixtures are run in the order specified, but all tests should be idempotent.
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Decoder);
+    LONGBOW_RUN_TEST_FIXTURE(IoVec);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -63,13 +64,19 @@ LONGBOW_TEST_RUNNER_TEARDOWN(parc_Tlv)
 LONGBOW_TEST_FIXTURE(Decoder)
 {
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Create);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Reset);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetLength);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetType);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_PeekType);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetValue);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetValue_TooLong);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_OverlayValue);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_OverlayValue_TooLong);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer_TooLong);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer_NoAllocation);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer_PoolExhausted);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Destroy_OuterBeforeInner);
 
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_IsEmpty_True);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_IsEmpty_False);
@@ -137,6 +144,41 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Create)
     assertTrue(before == after, "Memory leak, expected %zu got %zu bytes\n", before, after);
 }
 
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Reset)
+{
+    uint8_t first[] = { 0x00, 0x01, 0x00, 0x02, 0xAA, 0xBB };
+    uint8_t second[] = { 0x00, 0x03, 0x00, 0x01, 0xCC, 0xFF, 0xFF };
+    PARCBuffer *firstBuffer = parcBuffer_Wrap(first, sizeof(first), 0, sizeof(first));
+    PARCBuffer *secondBuffer = parcBuffer_Wrap(second, sizeof(second), 0, sizeof(second));
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(firstBuffer);
+    assertTrue(ccnxCodecTlvDecoder_GetType(decoder) == 1, "Wrong type in first buffer");
+
+    // leave an error behind to make sure it is cleared
+    CCNxCodecError *error = ccnxCodecError_Create(TLV_ERR_TOO_LONG, __func__, __LINE__, 0);
+    ccnxCodecTlvDecoder_SetError(decoder, error);
+    ccnxCodecError_Release(&error);
+
+    size_t before = parcMemory_Outstanding();
+    ccnxCodecTlvDecoder_Reset(decoder, secondBuffer);
+    size_t after = parcMemory_Outstanding();
+    assertTrue(after <= before, "Reset should not allocate, before %zu after %zu", before, after);
+
+    assertNull(ccnxCodecTlvDecoder_GetError(decoder), "Reset should clear the error");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 0, "Wrong position after reset, got %zu", ccnxCodecTlvDecoder_Position(decoder));
+    assertTrue(ccnxCodecTlvDecoder_GetType(decoder) == 3, "Wrong type in second buffer");
+    assertTrue(ccnxCodecTlvDecoder_GetLength(decoder) == 1, "Wrong length in second buffer");
+    PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, 1);
+    assertTrue(parcBuffer_GetUint8(value) == 0xCC, "Wrong value in second buffer");
+    assertTrue(ccnxCodecTlvDecoder_EnsureRemaining(decoder, 2), "Limit should be the second buffer");
+    assertFalse(ccnxCodecTlvDecoder_EnsureRemaining(decoder, 3), "Limit should be the second buffer");
+
+    parcBuffer_Release(&value);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&secondBuffer);
+    parcBuffer_Release(&firstBuffer);
+}
+
 LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetLength)
 {
     /**
@@ -159,9 +201,9 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetLength)
     // we're calling this on byte 0, so the "length" will be 0x0001
     uint16_t length = ccnxCodecTlvDecoder_GetLength(outerDecoder);
 
-    assertTrue(parcBuffer_Position(outerDecoder->buffer) == 2,
+    assertTrue(ccnxCodecTlvDecoder_Position(outerDecoder) == 2,
                "Did not advance buffer to right spot, expected %u got %zu",
-               2, parcBuffer_Position(outerDecoder->buffer));
+               2, ccnxCodecTlvDecoder_Position(outerDecoder));
 
     assertTrue(length == 1, "Wrong length expected %u got %u", 1, length);
 
@@ -189,9 +231,9 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetType)
 
     uint16_t type = ccnxCodecTlvDecoder_GetType(outerDecoder);
 
-    assertTrue(parcBuffer_Position(outerDecoder->buffer) == 2,
+    assertTrue(ccnxCodecTlvDecoder_Position(outerDecoder) == 2,
                "Did not advance buffer to right spot, expected %u got %zu",
-               2, parcBuffer_Position(outerDecoder->buffer));
+               2, ccnxCodecTlvDecoder_Position(outerDecoder));
 
     assertTrue(type == 1, "Wrong type expected %u got %u", 1, type);
 
@@ -219,9 +261,9 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_PeekType)
 
     uint16_t type = ccnxCodecTlvDecoder_PeekType(outerDecoder);
 
-    assertTrue(parcBuffer_Position(outerDecoder->buffer) == 0,
+    assertTrue(ccnxCodecTlvDecoder_Position(outerDecoder) == 0,
                "Did not advance buffer to right spot, expected %u got %zu",
-               0, parcBuffer_Position(outerDecoder->buffer));
+               0, ccnxCodecTlvDecoder_Position(outerDecoder));
 
     assertTrue(type == 1, "Wrong type expected %u got %u", 1, type);
 
@@ -293,6 +335,42 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetValue_TooLong)
     ccnxCodecTlvDecoder_Destroy(&outerDecoder);
 }
 
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_OverlayValue)
+{
+    uint8_t truthBytes[] = { 0x00, 0x02, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o' };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 0, sizeof(truthBytes));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+    const uint8_t *value = ccnxCodecTlvDecoder_OverlayValue(decoder, length);
+
+    assertTrue(value == &truthBytes[4], "Value was copied, expected a pointer in to the buffer");
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(decoder), "Decoder should be empty");
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+}
+
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_OverlayValue_TooLong)
+{
+    uint8_t truthBytes[] = { 0x00, 0x02, 0x00, 0x99, 'h', 'e', 'l', 'l', 'o' };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 0, sizeof(truthBytes));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+    const uint8_t *value = ccnxCodecTlvDecoder_OverlayValue(decoder, length);
+
+    assertNull(value, "Value should be null because of buffer underrun");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 4, "Decoder should not move, got position %zu", ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+}
+
 LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_IsEmpty_True)
 {
     /**
@@ -734,6 +812,99 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer_TooLong)
     ccnxCodecTlvDecoder_Destroy(&outerDecoder);
 }
 
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer_NoAllocation)
+{
+    uint8_t truthBytes[] = {
+        0x00, 0x01, 0x00, 0x09,
+        0x00, 0x02, 0x00, 0x05,'h',  'e', 'l', 'l', 'o',
+    };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 0, sizeof(truthBytes));
+    CCNxCodecTlvDecoder *outerDecoder = ccnxCodecTlvDecoder_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    (void) ccnxCodecTlvDecoder_GetType(outerDecoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(outerDecoder);
+
+    // containers come from the pool in the outer decoder's allocation
+    uint32_t before = parcMemory_Outstanding();
+    CCNxCodecTlvDecoder *innerDecoder = ccnxCodecTlvDecoder_GetContainer(outerDecoder, length);
+    uint32_t after = parcMemory_Outstanding();
+    assertTrue(before == after, "GetContainer should not allocate, outstanding was %u now %u", before, after);
+
+    ccnxCodecTlvDecoder_Destroy(&innerDecoder);
+    assertTrue(parcMemory_Outstanding() == before, "Destroying a container should not deallocate");
+    ccnxCodecTlvDecoder_Destroy(&outerDecoder);
+}
+
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer_PoolExhausted)
+{
+    // Nest more containers than the pool holds, each { T = i, L = 4 * (depth - i - 1) }.
+    // The last TLV is empty.
+    const int depth = _CCNxCodecTlvDecoder_PoolSize + 2;
+    uint8_t truthBytes[4 * depth];
+    for (int i = 0; i < depth; i++) {
+        uint16_t length = (uint16_t) (4 * (depth - i - 1));
+        truthBytes[4 * i + 0] = 0;
+        truthBytes[4 * i + 1] = (uint8_t) i;
+        truthBytes[4 * i + 2] = (uint8_t) (length >> 8);
+        truthBytes[4 * i + 3] = (uint8_t) length;
+    }
+
+    PARCBuffer *buffer = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 0, sizeof(truthBytes));
+    CCNxCodecTlvDecoder *decoders[depth];
+    decoders[0] = ccnxCodecTlvDecoder_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    for (int i = 1; i < depth; i++) {
+        uint16_t type = ccnxCodecTlvDecoder_GetType(decoders[i - 1]);
+        assertTrue(type == i - 1, "Wrong type at depth %d, got %u", i, type);
+        uint16_t length = ccnxCodecTlvDecoder_GetLength(decoders[i - 1]);
+        decoders[i] = ccnxCodecTlvDecoder_GetContainer(decoders[i - 1], length);
+        assertNotNull(decoders[i], "Got null container at depth %d", i);
+        assertTrue(ccnxCodecTlvDecoder_Remaining(decoders[i]) == length,
+                   "Wrong remaining at depth %d, got %zu expected %u", i, ccnxCodecTlvDecoder_Remaining(decoders[i]), length);
+    }
+
+    assertTrue(ccnxCodecTlvDecoder_GetType(decoders[depth - 1]) == depth - 1, "Wrong innermost type");
+    assertTrue(ccnxCodecTlvDecoder_GetLength(decoders[depth - 1]) == 0, "Wrong innermost length");
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(decoders[depth - 1]), "Innermost container should be empty");
+
+    for (int i = depth - 1; i >= 0; i--) {
+        ccnxCodecTlvDecoder_Destroy(&decoders[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Destroy_OuterBeforeInner)
+{
+    uint8_t truthBytes[] = {
+        0x00, 0x01, 0x00, 0x09,
+        0x00, 0x02, 0x00, 0x05,'h',  'e', 'l', 'l', 'o',
+    };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 0, sizeof(truthBytes));
+    CCNxCodecTlvDecoder *outerDecoder = ccnxCodecTlvDecoder_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    (void) ccnxCodecTlvDecoder_GetType(outerDecoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(outerDecoder);
+    CCNxCodecTlvDecoder *innerDecoder = ccnxCodecTlvDecoder_GetContainer(outerDecoder, length);
+
+    // The inner decoder lives in the outer decoder's memory, so it must stay usable
+    ccnxCodecTlvDecoder_Destroy(&outerDecoder);
+
+    PARCBuffer *test = ccnxCodecTlvDecoder_GetBuffer(innerDecoder, 2);
+    PARCBuffer *truth = parcBuffer_Wrap(&truthBytes[8], 5, 0, 5);
+    assertTrue(parcBuffer_Equals(test, truth), "Wrong value from inner decoder")
+    {
+        parcBuffer_Display(test, 3);
+    }
+
+    parcBuffer_Release(&truth);
+    parcBuffer_Release(&test);
+    ccnxCodecTlvDecoder_Destroy(&innerDecoder);
+}
+
 LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Advance_Good)
 {
     PARCBuffer *buffer = parcBuffer_Wrap((uint8_t[]) { 0xFF, 0xFF, 0x00, 0x04, 0xFF, 0x01, 0x02, 0x03 }, 8, 0, 8);
@@ -811,6 +982,267 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetVarInt)
 
 // ============================================
 
+LONGBOW_TEST_FIXTURE(IoVec)
+{
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_CreateFromIoVec);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetValue_InBlock);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetValue_Straddle);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_OverlayValue_Straddle);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetContainer);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetUint64_Straddle);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetVarInt);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_Advance_TooLong);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(IoVec)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(IoVec)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static size_t
+_cappedAllocator(void *userarg, size_t bytes, void **output)
+{
+    size_t *maxallocation = userarg;
+    if (bytes > *maxallocation) {
+        bytes = *maxallocation;
+    }
+
+    *output = parcMemory_Allocate(bytes);
+    return (*output != NULL) ? bytes : 0;
+}
+
+static void
+_cappedDeallocator(void *userarg, void **memory)
+{
+    parcMemory_Deallocate((void **) memory);
+}
+
+static const CCNxCodecNetworkBufferMemoryBlockFunctions _cappedMemoryBlock = {
+    .allocator   = &_cappedAllocator,
+    .deallocator = &_cappedDeallocator
+};
+
+/**
+ * Creates a scatter-gather list of `bytes`.  The memory blocks are capped at `maxallocation`
+ * bytes including the network buffer's bookkeeping, so a small value gives many small iovecs.
+ */
+static CCNxCodecNetworkBufferIoVec *
+_createIoVec(size_t length, const uint8_t bytes[length], size_t maxallocation)
+{
+    static size_t cap;
+    cap = maxallocation;
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&_cappedMemoryBlock, &cap);
+    ccnxCodecNetworkBuffer_PutArray(netbuff, length, bytes);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+    return vec;
+}
+
+// Large enough that everything is in one block
+#define ONE_BLOCK 4096
+
+// After bookkeeping this leaves a few bytes per block (8 on LP64), so TLVs straddle blocks
+#define SMALL_BLOCK 48
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_CreateFromIoVec)
+{
+    uint8_t truthBytes[] = { 0x00, 0x01, 0x00, 0x00 };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, ONE_BLOCK);
+
+    size_t before = parcMemory_Outstanding();
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    assertTrue(ccnxCodecTlvDecoder_Remaining(decoder) == sizeof(truthBytes),
+               "Wrong remaining, expected %zu got %zu", sizeof(truthBytes), ccnxCodecTlvDecoder_Remaining(decoder));
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    size_t after = parcMemory_Outstanding();
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    assertTrue(before == after, "Memory leak, expected %zu got %zu bytes\n", before, after);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetValue_InBlock)
+{
+    uint8_t truthBytes[] = { 0x00, 0x02, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o' };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, ONE_BLOCK);
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+    PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
+
+    PARCBuffer *truth = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 4, sizeof(truthBytes));
+    assertTrue(parcBuffer_Equals(truth, value), "Wrong value");
+
+    // A value inside one block must wrap the iovec memory, not copy it
+    assertTrue(parcBuffer_Overlay(value, 0) == (uint8_t *) iov[0].iov_base + 4, "Value was copied, expected in-place wrap");
+
+    parcBuffer_Release(&truth);
+    parcBuffer_Release(&value);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetValue_Straddle)
+{
+    uint8_t truthBytes[] = {
+        0x00, 0x02, 0x00, 0x14,
+        'i',  't',  ' ',  'w', 'a', 's', ' ', 'a', ' ', 'd', 'a', 'r', 'k', ' ', 'a', 'n', 'd', ' ', 's', 't'
+    };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, SMALL_BLOCK);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) > 1, "Test requires several iovecs");
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+    PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
+
+    PARCBuffer *truth = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 4, sizeof(truthBytes));
+    assertTrue(type == 2, "Wrong type, expected 2 got %u", type);
+    assertTrue(parcBuffer_Equals(truth, value), "Wrong value");
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(decoder), "Decoder should be empty");
+
+    parcBuffer_Release(&truth);
+    parcBuffer_Release(&value);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_OverlayValue_Straddle)
+{
+    uint8_t truthBytes[] = {
+        0x00, 0x02, 0x00, 0x14,
+        'i',  't',  ' ',  'w', 'a', 's', ' ', 'a', ' ', 'd', 'a', 'r', 'k', ' ', 'a', 'n', 'd', ' ', 's', 't'
+    };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, SMALL_BLOCK);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) > 1, "Test requires several iovecs");
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+    size_t position = ccnxCodecTlvDecoder_Position(decoder);
+
+    assertNull(ccnxCodecTlvDecoder_OverlayValue(decoder, length), "A value across blocks has no single pointer");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == position, "Decoder should not move");
+
+    // The fallback still works
+    PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
+    PARCBuffer *truth = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 4, sizeof(truthBytes));
+    assertTrue(parcBuffer_Equals(truth, value), "Wrong value");
+
+    parcBuffer_Release(&truth);
+    parcBuffer_Release(&value);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetContainer)
+{
+    /**
+     *   { T = 1,  L = 19 },
+     *      { T = 2, L = 5, V = "hello" }
+     *      { T = 3, L = 6, V = "mr tlv" }
+     */
+    uint8_t truthBytes[] = {
+        0x00, 0x01, 0x00, 0x13,
+        0x00, 0x02, 0x00, 0x05,'h',  'e', 'l', 'l', 'o',
+        0x00, 0x03, 0x00, 0x06,'m',  'r', ' ', 't', 'l', 'v'
+    };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, SMALL_BLOCK);
+
+    CCNxCodecTlvDecoder *outerDecoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    (void) ccnxCodecTlvDecoder_GetType(outerDecoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(outerDecoder);
+    CCNxCodecTlvDecoder *innerDecoder = ccnxCodecTlvDecoder_GetContainer(outerDecoder, length);
+    assertNotNull(innerDecoder, "Got a null decoder for a valid slice");
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(outerDecoder), "Outer decoder should be at the end");
+    assertTrue(ccnxCodecTlvDecoder_Position(innerDecoder) == 0, "Wrong position, expected 0 got %zu", ccnxCodecTlvDecoder_Position(innerDecoder));
+    assertTrue(ccnxCodecTlvDecoder_Remaining(innerDecoder) == 19, "Wrong remaining, expected 19 got %zu", ccnxCodecTlvDecoder_Remaining(innerDecoder));
+
+    PARCBuffer *hello = ccnxCodecTlvDecoder_GetBuffer(innerDecoder, 2);
+    PARCBuffer *mrtlv = ccnxCodecTlvDecoder_GetBuffer(innerDecoder, 3);
+    assertNotNull(hello, "Did not decode type 2");
+    assertNotNull(mrtlv, "Did not decode type 3");
+    assertTrue(ccnxCodecTlvDecoder_Position(innerDecoder) == 19, "Wrong position, expected 19 got %zu", ccnxCodecTlvDecoder_Position(innerDecoder));
+
+    PARCBuffer *truthHello = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 8, 13);
+    PARCBuffer *truthMrTlv = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 17, 23);
+    assertTrue(parcBuffer_Equals(truthHello, hello), "Wrong value for type 2");
+    assertTrue(parcBuffer_Equals(truthMrTlv, mrtlv), "Wrong value for type 3");
+
+    parcBuffer_Release(&truthHello);
+    parcBuffer_Release(&truthMrTlv);
+    parcBuffer_Release(&hello);
+    parcBuffer_Release(&mrtlv);
+    ccnxCodecTlvDecoder_Destroy(&innerDecoder);
+    ccnxCodecTlvDecoder_Destroy(&outerDecoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetUint64_Straddle)
+{
+    uint8_t truthBytes[] = { 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, SMALL_BLOCK);
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    (void) ccnxCodecTlvDecoder_GetLength(decoder);
+
+    uint64_t value;
+    bool success = ccnxCodecTlvDecoder_GetUint64(decoder, 0x0001, &value);
+    assertTrue(success, "Failed to get value");
+    assertTrue(value == 0x0102030405060708ULL, "Wrong value, got %" PRIx64, value);
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_GetVarInt)
+{
+    uint8_t truthBytes[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x23, 0x00 };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, SMALL_BLOCK);
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    ccnxCodecTlvDecoder_Advance(decoder, 6);
+
+    uint64_t value;
+    bool success = ccnxCodecTlvDecoder_GetVarInt(decoder, 3, &value);
+    assertTrue(success, "Failed to get varint");
+    assertTrue(value == 0x102300, "Wrong value, got %" PRIx64, value);
+
+    success = ccnxCodecTlvDecoder_GetVarInt(decoder, 1, &value);
+    assertFalse(success, "Should have failed reading past the end");
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_Advance_TooLong)
+{
+    uint8_t truthBytes[] = { 0xFF, 0xFF, 0x00, 0x04, 0xFF, 0x01, 0x02, 0x03 };
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(sizeof(truthBytes), truthBytes, SMALL_BLOCK);
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    bool success = ccnxCodecTlvDecoder_Advance(decoder, 9);
+    assertFalse(success, "Should have failed to advance beyond the end");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 0, "Position should not have moved, got %zu", ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+// ============================================
+
 int
 main(int argc, char *argv[])
 {
@@ -67,19 +67,23 @@ LONGBOW_TEST_FIXTURE(Encoder)
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendRawArray);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendBuffer);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendBuffer_TestReturn);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendBufferReference);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendContainer);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendUint8);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendUint16);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendUint32);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendUint64);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendVarInt);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_ComputeVarIntLength);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_PutUint8);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_PutUint16);
 
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Create);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateWithCapacity);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize_TrimLimit_Buffer);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize_TrimLimit_IoVec);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateIoVecRanges);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Initialize);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Initialize_Twice);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Position);
@@ -278,6 +282,41 @@ LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendBuffer_TestReturn)
     parcBuffer_Release(&hello);
 }
 
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendBufferReference)
+{
+    uint8_t truthString[] = { 0x00, 0x02, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o', 0x00, 0x03, 0x00, 0x00 };
+    PARCBuffer *truth = parcBuffer_Wrap(truthString, sizeof(truthString), 0, sizeof(truthString));
+
+    uint8_t helloString[] = "hello";
+    PARCBuffer *hello = parcBuffer_Wrap(helloString, 5, 0, 5);
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_Initialize(encoder);
+
+    size_t length = ccnxCodecTlvEncoder_AppendBufferReference(encoder, 2, hello);
+    assertTrue(length == 9, "AppendBufferReference returned wrong length, expected 9 got %zu", length);
+    parcBuffer_Release(&hello);
+
+    ccnxCodecTlvEncoder_AppendContainer(encoder, 3, 0);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    assertTrue(iov[1].iov_base == helloString, "The value should be referenced, not copied");
+
+    PARCBuffer *encoded = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+    assertTrue(parcBuffer_Equals(truth, encoded), "Buffer mismatch")
+    {
+        parcBuffer_Display(truth, 3);
+        parcBuffer_Display(encoded, 3);
+    }
+
+    parcBuffer_Release(&encoded);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    parcBuffer_Release(&truth);
+}
+
 LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendContainer)
 {
     uint8_t truthString[] = { 0x00, 0x02, 0xF1, 0x07 };
@@ -326,6 +365,28 @@ LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Create)
 /**
  * Check for memory leaks
  */
+/*
+ * Writing exactly the capacity keeps the encoding in one memory block
+ */
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateWithCapacity)
+{
+    uint8_t array[2000];
+    memset(array, 0xA5, sizeof(array));
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_CreateWithCapacity(4 + sizeof(array));
+    ccnxCodecTlvEncoder_AppendArray(encoder, 1, sizeof(array), array);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == 1, "Wrong iovec count, got %d expected 1",
+               ccnxCodecNetworkBufferIoVec_GetCount(vec));
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(vec) == 4 + sizeof(array), "Wrong length, got %zu expected %zu",
+               ccnxCodecNetworkBufferIoVec_Length(vec), 4 + sizeof(array));
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+}
+
 LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize)
 {
     size_t before = parcMemory_Outstanding();
@@ -381,6 +442,31 @@ LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize_TrimLimit_IoVec)
     ccnxCodecTlvEncoder_Destroy(&encoder);
 }
 
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateIoVecRanges)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+
+    uint8_t array[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    size_t ends[2];
+    size_t firstIndex[3];
+
+    ccnxCodecTlvEncoder_AppendRawArray(encoder, 3, array);
+    ends[0] = ccnxCodecTlvEncoder_Position(encoder);
+    ccnxCodecTlvEncoder_AppendRawArray(encoder, 5, array + 3);
+    ends[1] = ccnxCodecTlvEncoder_Position(encoder);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+
+    CCNxCodecNetworkBufferIoVec *iov = ccnxCodecTlvEncoder_CreateIoVecRanges(encoder, 2, ends, firstIndex);
+    const struct iovec *array0 = ccnxCodecNetworkBufferIoVec_GetArray(iov);
+    assertTrue(firstIndex[0] == 0 && firstIndex[1] == 1 && firstIndex[2] == 2, "Wrong firstIndex {%zu, %zu, %zu}",
+               firstIndex[0], firstIndex[1], firstIndex[2]);
+    assertTrue(array0[0].iov_len == 3 && array0[1].iov_len == 5, "Wrong range lengths %zu and %zu", array0[0].iov_len, array0[1].iov_len);
+    assertTrue(memcmp(array0[1].iov_base, array + 3, 5) == 0, "Wrong bytes in the second range");
+
+    ccnxCodecNetworkBufferIoVec_Release(&iov);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+}
+
 /**
  * Check for memory leaks and correct isInitialized state
  */
@@ -602,6 +688,19 @@ LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_AppendVarInt)
     }
 }
 
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_ComputeVarIntLength)
+{
+    uint64_t values[] = { 0, 0xFF, 0x0100, 0x102300, 0x0000000100000000ULL, 0xFFFFFFFFFFFFFFFFULL };
+
+    for (int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+        size_t appended = ccnxCodecTlvEncoder_AppendVarInt(encoder, 1, values[i]);
+        unsigned test = ccnxCodecTlvEncoder_ComputeVarIntLength(values[i]);
+        assertTrue(test + 4 == appended, "Index %d: computed %u but appended %zu", i, test, appended);
+        ccnxCodecTlvEncoder_Destroy(&encoder);
+    }
+}
+
 LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_MarkSignatureEnd)
 {
     CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
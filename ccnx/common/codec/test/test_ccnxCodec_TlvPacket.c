@@ -39,9 +39,11 @@
 #include <config.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <time.h>
 
 #include "../ccnxCodec_TlvPacket.c"
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 
 #include <LongBow/unit-test.h>
 
@@ -64,6 +66,7 @@ LONGBOW_TEST_RUNNER(rta_TlvPacket)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -85,12 +88,20 @@ LONGBOW_TEST_FIXTURE(Global)
 
     LONGBOW_RUN_TEST_CASE(Global, rtaTlvPacket_IoVecDecode_OneBuffer);
     LONGBOW_RUN_TEST_CASE(Global, rtaTlvPacket_IoVecDecode_SeveralBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_IoVecDecode_SmallBuffers);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncode_V1);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncode_VFF);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_GetEncodedLength);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_EncodeBatch);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_Decode_V1);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_Decode_VFF);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_Interest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_ContentObject);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch_Errors);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch_Empty);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_EncodeWithSignature);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_GetPacketLength);
@@ -193,6 +204,16 @@ runIoVecTest(AllocatorArg maxalloc)
     bool success = ccnxCodecTlvPacket_IoVecDecode(vec, output);
     assertTrue(success, "Failed to decode buffer in iovec format");
 
+    // The scatter-gather decode must produce the same dictionary as the linear decode
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields));
+    CCNxTlvDictionary *truth = ccnxTlvDictionary_Create(CCNxCodecSchemaV1TlvDictionary_MessageFastArray_END, CCNxCodecSchemaV1TlvDictionary_Lists_END);
+    ccnxTlvDictionary_SetMessageType_Interest(truth, CCNxTlvDictionary_SchemaVersion_V1);
+    success = ccnxCodecTlvPacket_BufferDecode(packetBuffer, truth);
+    assertTrue(success, "Failed to decode buffer in linear format");
+    assertTrue(ccnxTlvDictionary_Equals(truth, output), "IoVec decode does not match buffer decode");
+
+    ccnxTlvDictionary_Release(&truth);
+    parcBuffer_Release(&packetBuffer);
     ccnxTlvDictionary_Release(&output);
     ccnxCodecNetworkBufferIoVec_Release(&vec);
     ccnxCodecNetworkBuffer_Release(&netbuff);
@@ -211,6 +232,14 @@ LONGBOW_TEST_CASE(Global, rtaTlvPacket_IoVecDecode_SeveralBuffer)
     runIoVecTest(maxalloc);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_IoVecDecode_SmallBuffers)
+{
+    // After bookkeeping this leaves only a few bytes per memory block (8 bytes on LP64),
+    // so many fields straddle block boundaries and are decoded piecewise
+    AllocatorArg maxalloc = { .maxallocation = 48 };
+    runIoVecTest(maxalloc);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncode_V1)
 {
     CCNxName *name = ccnxName_CreateFromURI("lci:/Antidisestablishmentarianism");
@@ -235,6 +264,83 @@ LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncode_VFF)
     ccnxTlvDictionary_Release(&message);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_GetEncodedLength)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/Antidisestablishmentarianism");
+    CCNxTlvDictionary *message =
+        ccnxInterest_CreateWithImpl(&CCNxInterestFacadeV1_Implementation,
+                                    name, CCNxInterestDefault_LifetimeMilliseconds, NULL, NULL, CCNxInterestDefault_HopLimit);
+
+    ssize_t length = ccnxCodecTlvPacket_GetEncodedLength(message, NULL);
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncode(message, NULL);
+    assertNotNull(iovec, "Got null iovec on a good dictionary");
+    assertTrue(length == ccnxCodecNetworkBufferIoVec_Length(iovec),
+               "Wrong encoded length, expected %zu got %zd", ccnxCodecNetworkBufferIoVec_Length(iovec), length);
+
+    CCNxTlvDictionary *unknown = ccnxTlvDictionary_Create(20, 20);
+    ccnxTlvDictionary_SetMessageType_Interest(unknown, 0xFF);
+    assertTrue(ccnxCodecTlvPacket_GetEncodedLength(unknown, NULL) == -1, "Should have gotten -1 for schema version 255");
+
+    ccnxTlvDictionary_Release(&unknown);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    ccnxTlvDictionary_Release(&message);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_EncodeBatch)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    PARCBuffer *payload = parcBuffer_WrapCString("payload");
+
+    CCNxTlvDictionary *messages[] = {
+        ccnxContentObject_CreateWithDataPayload(name, payload),
+        ccnxTlvDictionary_Create(20, 20),
+        ccnxInterest_CreateSimple(name),
+    };
+    size_t count = sizeof(messages) / sizeof(messages[0]);
+
+    struct msghdr headers[count];
+    struct msghdr *messageHeaders[count];
+    memset(headers, 0, sizeof(headers));
+    for (size_t i = 0; i < count; i++) {
+        messageHeaders[i] = &headers[i];
+    }
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_EncodeBatch(messages, count, NULL, messageHeaders);
+    assertNotNull(vec, "Got null batch");
+
+    assertTrue(headers[1].msg_iovlen == 0 && headers[1].msg_iov == NULL, "The unknown dictionary should have no iovecs");
+
+    size_t indexes[] = { 0, 2 };
+    for (size_t k = 0; k < 2; k++) {
+        size_t i = indexes[k];
+        assertTrue(headers[i].msg_iovlen > 0, "Message %zu has no iovecs", i);
+
+        // Decoding the iovecs must give back the same message
+        CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+        for (size_t j = 0; j < (size_t) headers[i].msg_iovlen; j++) {
+            ccnxCodecNetworkBuffer_PutArray(netbuff, headers[i].msg_iov[j].iov_len, headers[i].msg_iov[j].iov_base);
+        }
+        PARCBuffer *wireFormat = ccnxCodecNetworkBuffer_CreateParcBuffer(netbuff);
+        CCNxTlvDictionary *decoded = ccnxCodecTlvPacket_Decode(wireFormat);
+        assertNotNull(decoded, "Message %zu did not decode", i);
+        assertTrue(ccnxTlvDictionary_IsInterest(decoded) == ccnxTlvDictionary_IsInterest(messages[i]),
+                   "Message %zu decoded to the wrong type", i);
+
+        ccnxTlvDictionary_Release(&decoded);
+        parcBuffer_Release(&wireFormat);
+        ccnxCodecNetworkBuffer_Release(&netbuff);
+    }
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    for (size_t i = 0; i < count; i++) {
+        ccnxTlvDictionary_Release(&messages[i]);
+    }
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_Decode_V1)
 {
     PARCBuffer *packetBuffer = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields));
@@ -260,6 +366,116 @@ LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_Decode_VFF)
     parcBuffer_Release(&packetBuffer);
 }
 
+static void
+_assertLazyDecodeEqualsDecode(uint8_t *packet, size_t length)
+{
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, length, 0, length);
+
+    uint32_t before = parcMemory_Outstanding();
+    CCNxTlvDictionary *eager = ccnxCodecTlvPacket_Decode(packetBuffer);
+    uint32_t eagerAllocations = parcMemory_Outstanding() - before;
+
+    before = parcMemory_Outstanding();
+    CCNxTlvDictionary *lazy = ccnxCodecTlvPacket_LazyDecode(packetBuffer);
+    uint32_t lazyAllocations = parcMemory_Outstanding() - before;
+
+    assertNotNull(lazy, "Got null dictionary lazy decoding good packet");
+    assertTrue(lazyAllocations < eagerAllocations,
+               "Lazy decode should hold fewer allocations, got %u expected less than %u", lazyAllocations, eagerAllocations);
+
+    // Equals resolves every lazy value
+    assertTrue(ccnxTlvDictionary_Equals(lazy, eager), "Lazy decode does not equal eager decode")
+    {
+        ccnxTlvDictionary_Display(eager, 3);
+        ccnxTlvDictionary_Display(lazy, 3);
+    }
+
+    ccnxTlvDictionary_Release(&lazy);
+    ccnxTlvDictionary_Release(&eager);
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_Interest)
+{
+    _assertLazyDecodeEqualsDecode(v1_interest_all_fields, sizeof(v1_interest_all_fields));
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_ContentObject)
+{
+    _assertLazyDecodeEqualsDecode(v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256));
+}
+
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch)
+{
+    PARCBuffer *packets[] = {
+        parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields)),
+        parcBuffer_Wrap(v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256), 0, sizeof(v1_content_nameA_keyid1_rsasha256)),
+        parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields)),
+    };
+    size_t count = sizeof(packets) / sizeof(packets[0]);
+    CCNxTlvDictionary *out[count];
+
+    size_t decoded = ccnxCodecTlvPacket_DecodeBatch(packets, count, out);
+    assertTrue(decoded == count, "Wrong decode count, got %zu expected %zu", decoded, count);
+
+    for (size_t i = 0; i < count; i++) {
+        CCNxTlvDictionary *truth = ccnxCodecTlvPacket_Decode(packets[i]);
+        assertTrue(ccnxTlvDictionary_Equals(out[i], truth), "Batch decode of packet %zu does not equal scalar decode", i)
+        {
+            ccnxTlvDictionary_Display(truth, 3);
+            ccnxTlvDictionary_Display(out[i], 3);
+        }
+        assertTrue(parcBuffer_Position(packets[i]) == 0, "Batch decode should not move the packet position");
+
+        ccnxTlvDictionary_Release(&truth);
+        ccnxTlvDictionary_Release(&out[i]);
+        parcBuffer_Release(&packets[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch_Errors)
+{
+    uint8_t versionFF[] = {
+        0xFF, 0x00, 0x00, 0x08,
+        0x00, 0x00, 0x00, 0x08
+    };
+    uint8_t tooShort[] = { 0x01, 0x00, 0x00 };
+
+    PARCBuffer *packets[] = {
+        parcBuffer_Wrap(versionFF, sizeof(versionFF), 0, sizeof(versionFF)),
+        parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields)),
+        NULL,
+        parcBuffer_Wrap(tooShort, sizeof(tooShort), 0, sizeof(tooShort)),
+        parcBuffer_Wrap(v1_interest_bad_message_length, sizeof(v1_interest_bad_message_length), 0, sizeof(v1_interest_bad_message_length)),
+        parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields)),
+    };
+    size_t count = sizeof(packets) / sizeof(packets[0]);
+    CCNxTlvDictionary *out[count];
+
+    size_t decoded = ccnxCodecTlvPacket_DecodeBatch(packets, count, out);
+    assertTrue(decoded == 2, "Wrong decode count, got %zu expected 2", decoded);
+
+    for (size_t i = 0; i < count; i++) {
+        bool good = (i == 1 || i == 5);
+        if (good) {
+            assertNotNull(out[i], "Packet %zu should have decoded", i);
+            ccnxTlvDictionary_Release(&out[i]);
+        } else {
+            assertNull(out[i], "Packet %zu should not have decoded", i);
+        }
+
+        if (packets[i]) {
+            parcBuffer_Release(&packets[i]);
+        }
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch_Empty)
+{
+    size_t decoded = ccnxCodecTlvPacket_DecodeBatch(NULL, 0, NULL);
+    assertTrue(decoded == 0, "Wrong decode count, got %zu expected 0", decoded);
+}
 
 LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_EncodeWithSignature)
 {
@@ -423,6 +639,134 @@ LONGBOW_TEST_CASE(Global, _decodeV1_Error)
 
 // =================================================================
 
+/*
+ * A memory provider that counts allocator calls and passes them through to stdlib memory.
+ * Used to report the number of allocations needed to decode a packet.
+ */
+static unsigned _allocationCount;
+
+static void *
+_countingAllocate(size_t size)
+{
+    _allocationCount++;
+    return ((void *(*)(size_t))PARCStdlibMemoryAsPARCMemory.Allocate)(size);
+}
+
+static void *
+_countingAllocateAndClear(size_t size)
+{
+    _allocationCount++;
+    return ((void *(*)(size_t))PARCStdlibMemoryAsPARCMemory.AllocateAndClear)(size);
+}
+
+static int
+_countingMemAlign(void **pointer, size_t alignment, size_t size)
+{
+    _allocationCount++;
+    return ((int (*)(void **, size_t, size_t))PARCStdlibMemoryAsPARCMemory.MemAlign)(pointer, alignment, size);
+}
+
+static void
+_countingDeallocate(void **pointer)
+{
+    ((void (*)(void **))PARCStdlibMemoryAsPARCMemory.Deallocate)(pointer);
+}
+
+static void *
+_countingReallocate(void *pointer, size_t newSize)
+{
+    _allocationCount++;
+    return ((void *(*)(void *, size_t))PARCStdlibMemoryAsPARCMemory.Reallocate)(pointer, newSize);
+}
+
+static char *
+_countingStringDuplicate(const char *string, size_t length)
+{
+    _allocationCount++;
+    return ((char *(*)(const char *, size_t))PARCStdlibMemoryAsPARCMemory.StringDuplicate)(string, length);
+}
+
+static uint32_t
+_countingOutstanding(void)
+{
+    return ((uint32_t (*)(void))PARCStdlibMemoryAsPARCMemory.Outstanding)();
+}
+
+static PARCMemoryInterface _countingMemory = {
+    .Allocate         = (uintptr_t) _countingAllocate,
+    .AllocateAndClear = (uintptr_t) _countingAllocateAndClear,
+    .MemAlign         = (uintptr_t) _countingMemAlign,
+    .Deallocate       = (uintptr_t) _countingDeallocate,
+    .Reallocate       = (uintptr_t) _countingReallocate,
+    .StringDuplicate  = (uintptr_t) _countingStringDuplicate,
+    .Outstanding      = (uintptr_t) _countingOutstanding
+};
+
+static const PARCMemoryInterface *_originalMemoryProvider;
+
+/**
+ * Decodes the packet `reps` times and prints the allocator calls and time per decode.
+ */
+static void
+_benchmarkDecode(const char *label, CCNxTlvDictionary *(*decode)(PARCBuffer *), uint8_t *packet, size_t length, unsigned reps)
+{
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, length, 0, length);
+
+    _allocationCount = 0;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (unsigned i = 0; i < reps; i++) {
+        CCNxTlvDictionary *dict = decode(packetBuffer);
+        assertNotNull(dict, "Failed to decode %s", label);
+        ccnxTlvDictionary_Release(&dict);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double nanoseconds = (t1.tv_sec - t0.tv_sec) * 1E9 + (t1.tv_nsec - t0.tv_nsec);
+    printf("%-40s %8.2f allocations/packet %10.1f ns/packet\n",
+           label, (double) _allocationCount / reps, nanoseconds / reps);
+
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecTlvPacket_Decode);
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecTlvPacket_LazyDecode);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    _originalMemoryProvider = parcMemory_SetInterface(&_countingMemory);
+
+    // A receive thread reuses its dictionaries, as a decode context would
+    ccnxTlvDictionary_SetThreadPoolCapacity(4);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(0);
+    parcMemory_SetInterface(_originalMemoryProvider);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxCodecTlvPacket_Decode)
+{
+    unsigned reps = 100000;
+    _benchmarkDecode("v1_interest_all_fields", ccnxCodecTlvPacket_Decode, v1_interest_all_fields, sizeof(v1_interest_all_fields), reps);
+    _benchmarkDecode("v1_content_nameA_keyid1_rsasha256", ccnxCodecTlvPacket_Decode, v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256), reps);
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxCodecTlvPacket_LazyDecode)
+{
+    unsigned reps = 100000;
+    _benchmarkDecode("lazy v1_interest_all_fields", ccnxCodecTlvPacket_LazyDecode, v1_interest_all_fields, sizeof(v1_interest_all_fields), reps);
+    _benchmarkDecode("lazy v1_content_nameA_keyid1_rsasha256", ccnxCodecTlvPacket_LazyDecode, v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256), reps);
+}
+
+// =================================================================
+
 int
 main(int argc, char *argv[])
 {
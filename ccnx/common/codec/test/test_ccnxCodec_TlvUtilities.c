@@ -126,9 +126,11 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_DecodeSubcontainer);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_PutAsName);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_PutAsBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_PutAsBuffer_Lazy);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_PutAsListBuffer);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_NestedEncode);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_EncodeCustomList);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvUtilities_GetCustomListLength);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -165,6 +167,24 @@ LONGBOW_TEST_CASE(Global, ccnxCodecTlvUtilities_PutAsBuffer)
     assertTrue(version == data->version, "Wrong version, got %d expected %d", version, data->version);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvUtilities_PutAsBuffer_Lazy)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->dictionary, data->fixedHeader);
+
+    uint32_t type = 1;
+    uint32_t length = 8;
+
+    bool success = ccnxCodecTlvUtilities_PutAsBuffer(data->decoder, data->dictionary, type, length,
+                                                     CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_FixedHeader);
+
+    assertTrue(success, "Failed to save lazy value");
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(data->decoder), "Decoder should have advanced past the lazy value");
+
+    int version = ccnxCodecSchemaV1FixedHeaderDecoder_GetVersion(data->dictionary);
+    assertTrue(version == data->version, "Wrong version, got %d expected %d", version, data->version);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxCodecTlvUtilities_GetVarInt)
 {
     struct test_vector {
@@ -453,6 +473,34 @@ LONGBOW_TEST_CASE(Global, ccnxCodecTlvUtilities_EncodeCustomList)
     ccnxTlvDictionary_Release(&dictionary);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvUtilities_GetCustomListLength)
+{
+    uint8_t array[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+
+    PARCBuffer *buffers[3];
+    buffers[0] = parcBuffer_Wrap(array, sizeof(array), 0, 2);
+    buffers[1] = parcBuffer_Wrap(array, sizeof(array), 2, 3);
+    buffers[2] = parcBuffer_Wrap(array, sizeof(array), 3, 6);
+
+    CCNxTlvDictionary *dictionary = ccnxTlvDictionary_Create(10, 10);
+
+    int listkey = 1;
+    assertTrue(ccnxCodecTlvUtilities_GetCustomListLength(dictionary, listkey) == 0, "Empty list should have zero length");
+
+    ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 2, buffers[2]);
+    ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 1, buffers[1]);
+    ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 0, buffers[0]);
+
+    // 3 TLV headers plus 6 bytes of values, the same as the EncodeCustomList truth
+    ssize_t length = ccnxCodecTlvUtilities_GetCustomListLength(dictionary, listkey);
+    assertTrue(length == 18, "Wrong length, expected 18 got %zd", length);
+
+    parcBuffer_Release(&buffers[0]);
+    parcBuffer_Release(&buffers[1]);
+    parcBuffer_Release(&buffers[2]);
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
 // ====================================================================================
 
 LONGBOW_TEST_FIXTURE(Local)
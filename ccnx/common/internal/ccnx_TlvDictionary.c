@@ -32,9 +32,12 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
+#include <time.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <pthread.h>
 
 #include <ccnx/common/ccnx_Name.h>
 
@@ -51,6 +54,7 @@
 
 struct ccnx_tlv_dictionary_entry;
 typedef struct ccnx_tlv_list_entry _CCNxTlvDictionaryListEntry;
+typedef struct ccnx_tlv_list _CCNxTlvDictionaryList;
 
 typedef enum {
     CCNxTlvDictionaryType_Unknown,
@@ -60,19 +64,38 @@ typedef enum {
     CCNxTlvDictionaryType_InterestReturn,
 } _CCNxTlvDictionaryType;
 
-// These form a singly linked list
 struct ccnx_tlv_list_entry {
-    _CCNxTlvDictionaryListEntry *next;
+    // NULL for a lazy entry until someone asks for it, then it is a slice of the lazy source
     PARCBuffer *buffer;
+    uint32_t offset;
+    uint32_t length;
+
     uint16_t key;
 };
 
+// The number of entries a list holds before it allocates overflow storage.
+#define INLINE_LIST_ENTRIES 2
+
+// The first overflow allocation, after which the capacity doubles.
+#define OVERFLOW_LIST_ENTRIES 8
+
+// Entries are kept in insertion order, so list position 0 (the most recently inserted
+// entry) is entries[count - 1].  Once allocated, the overflow storage is kept until the
+// dictionary is deallocated, so a reset or pooled dictionary does not allocate again.
+struct ccnx_tlv_list {
+    uint32_t count;
+    uint32_t capacity;
+    _CCNxTlvDictionaryListEntry *overflow;
+    _CCNxTlvDictionaryListEntry inlineEntries[INLINE_LIST_ENTRIES];
+};
+
 #define ENTRY_UNSET   ((int) 0)
 #define ENTRY_BUFFER  ((int) 1)
 #define ENTRY_NAME    ((int) 2)
 #define ENTRY_INTEGER ((int) 3)
 #define ENTRY_IOVEC   ((int) 4)
 #define ENTRY_JSON    ((int) 5)
+#define ENTRY_LAZY    ((int) 6)
 
 static struct dictionary_type_string {
     _CCNxTlvDictionaryType type;
@@ -96,6 +119,7 @@ static struct dictionary_entry_type_string {
     { .type = ENTRY_INTEGER, .string = "Integer" },
     { .type = ENTRY_IOVEC,   .string = "IoVec"   },
     { .type = ENTRY_JSON,    .string = "Json"    },
+    { .type = ENTRY_LAZY,    .string = "Lazy"    },
     { .type = UINT32_MAX,    .string = NULL      },
 };
 
@@ -132,17 +156,23 @@ typedef struct ccnx_tlv_dictionary_entry {
         CCNxName   *name;
         CCNxCodecNetworkBufferIoVec *vec;
         PARCJSON   *json;
+
+        // A buffer not yet sliced out of the lazy source
+        struct {
+            uint32_t offset;
+            uint32_t length;
+        } lazy;
     } _entry;
 } _CCNxTlvDictionaryEntry;
 
 struct ccnx_tlv_dictionary {
 #define FIXED_LIST_LENGTH 8
-    // These are linked lists where we put unknown TLV types.  This one static allocation should
+    // These are lists where we put unknown TLV types.  This one static allocation should
     // be enough for all the current packet formats.
-    _CCNxTlvDictionaryListEntry *fixedListHeads[FIXED_LIST_LENGTH];
+    _CCNxTlvDictionaryList fixedLists[FIXED_LIST_LENGTH];
 
     // if we need to allocate beyond FIXED_LIST_LENGTH, put them here
-    _CCNxTlvDictionaryListEntry **extraListHeads;
+    _CCNxTlvDictionaryList *extraLists;
 
     size_t fastArraySize;
     size_t listSize;
@@ -163,47 +193,111 @@ struct ccnx_tlv_dictionary {
     // the wire, it will need to be initialized based on the dictionaryType and schemaVersion.
     CCNxMessageInterface *messageInterface;
 
+    // The wire format that lazy entries point in to.  NULL if not decoding lazily.
+    PARCBuffer *lazySource;
+
+    // Set by ccnxTlvDictionary_Clone() on the source and the clone, whose values are shared
+    bool copyOnWrite;
+
+    // Links released dictionaries in the per-thread pool
+    struct ccnx_tlv_dictionary *poolNext;
+
     // will be allocated as part of the ccnx_tlv_dictionary
     _CCNxTlvDictionaryEntry directArray[];
 };
 
 static _CCNxTlvDictionaryListEntry *
-_ccnxTlvDictionaryListEntry_Create(uint32_t key, const PARCBuffer *buffer)
+_ccnxTlvDictionaryList_Entries(_CCNxTlvDictionaryList *list)
 {
-    _CCNxTlvDictionaryListEntry *entry = parcMemory_AllocateAndClear(sizeof(_CCNxTlvDictionaryListEntry));
-    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxTlvDictionaryListEntry));
-    entry->key = key;
-    entry->buffer = parcBuffer_Acquire(buffer);
+    return (list->overflow != NULL) ? list->overflow : list->inlineEntries;
+}
 
+/**
+ * Returns the entry at list position `position`, where position 0 is the most recently added entry.
+ */
+static _CCNxTlvDictionaryListEntry *
+_ccnxTlvDictionaryList_GetByPosition(const _CCNxTlvDictionaryList *list, size_t position)
+{
+    _CCNxTlvDictionaryListEntry *entries = _ccnxTlvDictionaryList_Entries((_CCNxTlvDictionaryList *) list);
+    return &entries[list->count - 1 - position];
+}
+
+/**
+ * Appends a cleared entry to the list, moving the list to overflow storage when the inline entries are used up.
+ */
+static _CCNxTlvDictionaryListEntry *
+_ccnxTlvDictionaryList_Append(_CCNxTlvDictionaryList *list, uint32_t key)
+{
+    size_t capacity = (list->overflow != NULL) ? list->capacity : INLINE_LIST_ENTRIES;
+    if (list->count == capacity) {
+        if (list->overflow == NULL) {
+            list->capacity = OVERFLOW_LIST_ENTRIES;
+            list->overflow = parcMemory_Allocate(list->capacity * sizeof(_CCNxTlvDictionaryListEntry));
+            assertNotNull(list->overflow, "parcMemory_Allocate(%zu) returned NULL", list->capacity * sizeof(_CCNxTlvDictionaryListEntry));
+            memcpy(list->overflow, list->inlineEntries, list->count * sizeof(_CCNxTlvDictionaryListEntry));
+        } else {
+            list->capacity *= 2;
+            list->overflow = parcMemory_Reallocate(list->overflow, list->capacity * sizeof(_CCNxTlvDictionaryListEntry));
+            assertNotNull(list->overflow, "parcMemory_Reallocate(%zu) returned NULL", list->capacity * sizeof(_CCNxTlvDictionaryListEntry));
+        }
+    }
+
+    _CCNxTlvDictionaryListEntry *entry = &_ccnxTlvDictionaryList_Entries(list)[list->count++];
+    memset(entry, 0, sizeof(_CCNxTlvDictionaryListEntry));
+    entry->key = key;
     return entry;
 }
 
+/**
+ * Releases the buffers held by the list and empties it, keeping any overflow storage.
+ */
 static void
-_ccnxTlvDictionaryListEntry_Release(_CCNxTlvDictionaryListEntry **entryPtr)
+_ccnxTlvDictionaryList_Clear(_CCNxTlvDictionaryList *list)
 {
-    _CCNxTlvDictionaryListEntry *entry = *entryPtr;
-    parcBuffer_Release(&entry->buffer);
-    parcMemory_Deallocate((void **) &entry);
-    *entryPtr = NULL;
+    _CCNxTlvDictionaryListEntry *entries = _ccnxTlvDictionaryList_Entries(list);
+    for (size_t i = 0; i < list->count; i++) {
+        if (entries[i].buffer) {
+            parcBuffer_Release(&entries[i].buffer);
+        }
+    }
+    list->count = 0;
 }
 
 static void
-_ccnxTlvDictionaryEntry_ListRelease(_CCNxTlvDictionaryListEntry **listHeadPtr)
+_ccnxTlvDictionaryList_Release(_CCNxTlvDictionaryList *list)
 {
-    _CCNxTlvDictionaryListEntry *listHead = *listHeadPtr;
-    while (listHead) {
-        _CCNxTlvDictionaryListEntry *next = listHead->next;
-        _ccnxTlvDictionaryListEntry_Release(&listHead);
-        listHead = next;
+    _ccnxTlvDictionaryList_Clear(list);
+    if (list->overflow != NULL) {
+        parcMemory_Deallocate((void **) &list->overflow);
     }
-    *listHeadPtr = NULL;
+    list->capacity = 0;
 }
 
-static void
-_ccnxTlvDictionary_FinalRelease(CCNxTlvDictionary **dictionaryPtr)
+static _CCNxTlvDictionaryList *
+_getList(const CCNxTlvDictionary *dictionary, uint32_t listKey)
 {
-    CCNxTlvDictionary *dictionary = *dictionaryPtr;
+    if (listKey < FIXED_LIST_LENGTH) {
+        return (_CCNxTlvDictionaryList *) &dictionary->fixedLists[listKey];
+    } else {
+        if (dictionary->extraLists == NULL) {
+            ((CCNxTlvDictionary *) dictionary)->extraLists =
+                parcMemory_AllocateAndClear(sizeof(_CCNxTlvDictionaryList) * (dictionary->listSize - FIXED_LIST_LENGTH));
+            assertNotNull(dictionary->extraLists, "parcMemory_AllocateAndClear(%zu) returned NULL",
+                          sizeof(_CCNxTlvDictionaryList) * (dictionary->listSize - FIXED_LIST_LENGTH));
+        }
+
+        return &dictionary->extraLists[listKey - FIXED_LIST_LENGTH];
+    }
+}
 
+/**
+ * Release everything the dictionary holds and leave every entry unset.
+ *
+ * The dictionary allocation, including extraLists and list overflow storage, is kept so the dictionary may be reused.
+ */
+static void
+_ccnxTlvDictionary_ReleaseEntries(CCNxTlvDictionary *dictionary)
+{
     // release any entries stored in the fast array
     for (int i = 0; i < dictionary->fastArraySize; i++) {
         switch (dictionary->directArray[i].entryType) {
@@ -224,25 +318,46 @@ _ccnxTlvDictionary_FinalRelease(CCNxTlvDictionary **dictionaryPtr)
                 break;
         }
     }
+    memset(dictionary->directArray, 0, sizeof(_CCNxTlvDictionaryEntry) * dictionary->fastArraySize);
 
     for (int i = 0; i < FIXED_LIST_LENGTH; i++) {
-        if (dictionary->fixedListHeads[i]) {
-            _ccnxTlvDictionaryEntry_ListRelease(&dictionary->fixedListHeads[i]);
-        }
+        _ccnxTlvDictionaryList_Clear(&dictionary->fixedLists[i]);
     }
 
-    if (dictionary->extraListHeads) {
+    if (dictionary->extraLists) {
         for (int i = FIXED_LIST_LENGTH; i < dictionary->listSize; i++) {
-            if (dictionary->extraListHeads[i - FIXED_LIST_LENGTH]) {
-                _ccnxTlvDictionaryEntry_ListRelease(&dictionary->extraListHeads[i - FIXED_LIST_LENGTH]);
-            }
+            _ccnxTlvDictionaryList_Clear(&dictionary->extraLists[i - FIXED_LIST_LENGTH]);
         }
-        parcMemory_Deallocate((void **) &(dictionary->extraListHeads));
     }
 
     if (dictionary->infoFreeFunction) {
         dictionary->infoFreeFunction(&dictionary->info);
     }
+    dictionary->infoFreeFunction = NULL;
+    dictionary->info = NULL;
+
+    if (dictionary->lazySource) {
+        parcBuffer_Release(&dictionary->lazySource);
+    }
+}
+
+static void
+_ccnxTlvDictionary_FinalRelease(CCNxTlvDictionary **dictionaryPtr)
+{
+    CCNxTlvDictionary *dictionary = *dictionaryPtr;
+
+    _ccnxTlvDictionary_ReleaseEntries(dictionary);
+
+    for (int i = 0; i < FIXED_LIST_LENGTH; i++) {
+        _ccnxTlvDictionaryList_Release(&dictionary->fixedLists[i]);
+    }
+
+    if (dictionary->extraLists) {
+        for (int i = FIXED_LIST_LENGTH; i < dictionary->listSize; i++) {
+            _ccnxTlvDictionaryList_Release(&dictionary->extraLists[i - FIXED_LIST_LENGTH]);
+        }
+        parcMemory_Deallocate((void **) &(dictionary->extraLists));
+    }
 
 #if DEBUG_ALLOCS
     printf("finalize dictionary %p (final)\n", dictionary);
@@ -254,23 +369,288 @@ parcObject_ExtendPARCObject(CCNxTlvDictionary, _ccnxTlvDictionary_FinalRelease,
 
 parcObject_ImplementAcquire(ccnxTlvDictionary, CCNxTlvDictionary);
 
-parcObject_ImplementRelease(ccnxTlvDictionary, CCNxTlvDictionary);
-
 static void
 _ccnxTlvDictionary_GetTimeOfDay(struct timeval *outputTime)
 {
 #ifdef DEBUG
-    // if in debug mode, time messages
+    // if in debug mode, time messages.  The coarse clock is a fraction of the cost of gettimeofday.
+#ifdef CLOCK_REALTIME_COARSE
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME_COARSE, &now);
+    outputTime->tv_sec = now.tv_sec;
+    outputTime->tv_usec = (suseconds_t) (now.tv_nsec / 1000);
+#else
     gettimeofday(outputTime, NULL);
+#endif
 #else
     *outputTime = (struct timeval) { 0, 0 };
 #endif
 }
 
+// =============================================================
+// Per-thread pool of released dictionaries
+
+// The number of distinct (fastArraySize, listSize) shapes pooled per thread.  The V1 schema
+// uses a single shape for all message types.
+#define _CCNxTlvDictionaryPool_Shapes 4
+
+typedef struct ccnx_tlv_dictionary_pool_shape {
+    size_t fastArraySize;
+    size_t listSize;
+    size_t count;
+    CCNxTlvDictionary *head;
+} _CCNxTlvDictionaryPoolShape;
+
+typedef struct ccnx_tlv_dictionary_pool {
+    size_t capacity;
+    _CCNxTlvDictionaryPoolShape shapes[_CCNxTlvDictionaryPool_Shapes];
+} _CCNxTlvDictionaryPool;
+
+static pthread_key_t _ccnxTlvDictionaryPool_Key;
+static pthread_once_t _ccnxTlvDictionaryPool_KeyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * Free the dictionaries in each shape beyond the first `keep`.
+ */
+static void
+_ccnxTlvDictionaryPool_Trim(_CCNxTlvDictionaryPool *pool, size_t keep)
+{
+    for (int i = 0; i < _CCNxTlvDictionaryPool_Shapes; i++) {
+        _CCNxTlvDictionaryPoolShape *shape = &pool->shapes[i];
+        while (shape->count > keep) {
+            CCNxTlvDictionary *dictionary = shape->head;
+            shape->head = dictionary->poolNext;
+            shape->count--;
+            parcObject_Release((PARCObject **) &dictionary);
+        }
+    }
+}
+
+static void
+_ccnxTlvDictionaryPool_Destroy(void *context)
+{
+    _CCNxTlvDictionaryPool *pool = context;
+    _ccnxTlvDictionaryPool_Trim(pool, 0);
+    parcMemory_Deallocate((void **) &pool);
+}
+
+static void
+_ccnxTlvDictionaryPool_CreateKey(void)
+{
+    int failure = pthread_key_create(&_ccnxTlvDictionaryPool_Key, _ccnxTlvDictionaryPool_Destroy);
+    assertFalse(failure, "pthread_key_create failed: %d", failure);
+}
+
+static _CCNxTlvDictionaryPool *
+_ccnxTlvDictionaryPool_Get(void)
+{
+    pthread_once(&_ccnxTlvDictionaryPool_KeyOnce, _ccnxTlvDictionaryPool_CreateKey);
+    return pthread_getspecific(_ccnxTlvDictionaryPool_Key);
+}
+
+/**
+ * Take a dictionary of the given shape from this thread's pool.
+ *
+ * @return NULL if the pool has no dictionary of that shape.
+ */
+static CCNxTlvDictionary *
+_ccnxTlvDictionaryPool_Take(size_t fastArraySize, size_t listSize)
+{
+    _CCNxTlvDictionaryPool *pool = _ccnxTlvDictionaryPool_Get();
+    if (pool != NULL) {
+        for (int i = 0; i < _CCNxTlvDictionaryPool_Shapes; i++) {
+            _CCNxTlvDictionaryPoolShape *shape = &pool->shapes[i];
+            if (shape->head != NULL && shape->fastArraySize == fastArraySize && shape->listSize == listSize) {
+                CCNxTlvDictionary *dictionary = shape->head;
+                shape->head = dictionary->poolNext;
+                shape->count--;
+                dictionary->poolNext = NULL;
+                return dictionary;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Reset the dictionary and put it in this thread's pool.
+ *
+ * @return false The thread has no pool, or the pool is full for the dictionary's shape.
+ */
+static bool
+_ccnxTlvDictionaryPool_Put(CCNxTlvDictionary *dictionary)
+{
+    _CCNxTlvDictionaryPool *pool = _ccnxTlvDictionaryPool_Get();
+    if (pool == NULL) {
+        return false;
+    }
+
+    _CCNxTlvDictionaryPoolShape *found = NULL;
+    for (int i = 0; i < _CCNxTlvDictionaryPool_Shapes; i++) {
+        _CCNxTlvDictionaryPoolShape *shape = &pool->shapes[i];
+        if (shape->fastArraySize == dictionary->fastArraySize && shape->listSize == dictionary->listSize) {
+            found = shape;
+            break;
+        }
+        if (found == NULL && shape->count == 0) {
+            found = shape;
+        }
+    }
+
+    if (found == NULL || found->count >= pool->capacity) {
+        return false;
+    }
+
+    ccnxTlvDictionary_Reset(dictionary);
+    found->fastArraySize = dictionary->fastArraySize;
+    found->listSize = dictionary->listSize;
+    dictionary->poolNext = found->head;
+    found->head = dictionary;
+    found->count++;
+    return true;
+}
+
+void
+ccnxTlvDictionary_SetThreadPoolCapacity(size_t capacity)
+{
+    _CCNxTlvDictionaryPool *pool = _ccnxTlvDictionaryPool_Get();
+
+    if (capacity == 0) {
+        if (pool != NULL) {
+            pthread_setspecific(_ccnxTlvDictionaryPool_Key, NULL);
+            _ccnxTlvDictionaryPool_Destroy(pool);
+        }
+        return;
+    }
+
+    if (pool == NULL) {
+        pool = parcMemory_AllocateAndClear(sizeof(_CCNxTlvDictionaryPool));
+        assertNotNull(pool, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxTlvDictionaryPool));
+        pthread_setspecific(_ccnxTlvDictionaryPool_Key, pool);
+    }
+    pool->capacity = capacity;
+    _ccnxTlvDictionaryPool_Trim(pool, capacity);
+}
+
+size_t
+ccnxTlvDictionary_GetThreadPoolCapacity(void)
+{
+    _CCNxTlvDictionaryPool *pool = _ccnxTlvDictionaryPool_Get();
+    return (pool == NULL) ? 0 : pool->capacity;
+}
+
+void
+ccnxTlvDictionary_Release(CCNxTlvDictionary **dictionaryPtr)
+{
+    CCNxTlvDictionary *dictionary = *dictionaryPtr;
+
+    // Only the holder of the last reference may recycle the dictionary
+    if (dictionary != NULL && parcObject_GetReferenceCount(dictionary) == 1 && _ccnxTlvDictionaryPool_Put(dictionary)) {
+        *dictionaryPtr = NULL;
+    } else {
+        parcObject_Release((PARCObject **) dictionaryPtr);
+    }
+}
+
+void
+ccnxTlvDictionary_Reset(CCNxTlvDictionary *dictionary)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+
+    _ccnxTlvDictionary_ReleaseEntries(dictionary);
+
+    dictionary->dictionaryType = CCNxTlvDictionaryType_Unknown;
+    dictionary->schemaVersion = 0;
+    dictionary->generation = 0;
+    dictionary->messageInterface = NULL;
+    dictionary->copyOnWrite = false;
+    _ccnxTlvDictionary_GetTimeOfDay(&dictionary->creationTime);
+}
+
+/**
+ * Serializes resolving lazy entries, which getters do on a `const` dictionary that several
+ * threads may read.  Resolution happens once per entry, so one lock for every dictionary is enough.
+ */
+static pthread_mutex_t _ccnxTlvDictionary_LazyLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Slices [offset, offset + length) out of the lazy source.
+ *
+ * The lazy source itself is never moved, so readers and clones sharing it always see all of it.
+ */
+static PARCBuffer *
+_ccnxTlvDictionary_SliceLazySource(const CCNxTlvDictionary *dictionary, uint32_t offset, uint32_t length)
+{
+    PARCBuffer *window = parcBuffer_Duplicate(dictionary->lazySource);
+    parcBuffer_SetLimit(window, offset + length);
+    parcBuffer_SetPosition(window, offset);
+    PARCBuffer *slice = parcBuffer_Slice(window);
+    parcBuffer_Release(&window);
+    return slice;
+}
+
+/**
+ * If the entry at `key` is lazy, replace it with its buffer.  This modifies the dictionary even
+ * when called from a getter, the same as a cache would.
+ *
+ * The buffer is stored before the entry type is published, so a reader that sees ENTRY_BUFFER
+ * without the lock also sees the buffer.  The lazy offset and length, which share storage with
+ * the buffer, are only read under the lock.
+ */
+static void
+_ccnxTlvDictionary_ResolveLazyEntry(const CCNxTlvDictionary *dictionary, uint32_t key)
+{
+    _CCNxTlvDictionaryEntry *entry = (_CCNxTlvDictionaryEntry *) &dictionary->directArray[key];
+    if (__atomic_load_n(&entry->entryType, __ATOMIC_ACQUIRE) == ENTRY_LAZY) {
+        pthread_mutex_lock(&_ccnxTlvDictionary_LazyLock);
+        if (entry->entryType == ENTRY_LAZY) {
+            PARCBuffer *buffer = _ccnxTlvDictionary_SliceLazySource(dictionary, entry->_entry.lazy.offset, entry->_entry.lazy.length);
+            entry->_entry.buffer = buffer;
+            __atomic_store_n(&entry->entryType, ENTRY_BUFFER, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&_ccnxTlvDictionary_LazyLock);
+    }
+}
+
+/**
+ * Returns the buffer of a list entry, slicing it out of the lazy source the first time.
+ *
+ * As for _ccnxTlvDictionary_ResolveLazyEntry(), the buffer is published with release ordering.
+ */
+static PARCBuffer *
+_ccnxTlvDictionary_ListEntryBuffer(const CCNxTlvDictionary *dictionary, _CCNxTlvDictionaryListEntry *entry)
+{
+    PARCBuffer *buffer = __atomic_load_n(&entry->buffer, __ATOMIC_ACQUIRE);
+    if (buffer == NULL) {
+        pthread_mutex_lock(&_ccnxTlvDictionary_LazyLock);
+        buffer = entry->buffer;
+        if (buffer == NULL) {
+            buffer = _ccnxTlvDictionary_SliceLazySource(dictionary, entry->offset, entry->length);
+            __atomic_store_n(&entry->buffer, buffer, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&_ccnxTlvDictionary_LazyLock);
+    }
+    return buffer;
+}
+
+static void
+_ccnxTlvDictionary_ResolveLazyList(const CCNxTlvDictionary *dictionary, _CCNxTlvDictionaryList *list)
+{
+    _CCNxTlvDictionaryListEntry *entries = _ccnxTlvDictionaryList_Entries(list);
+    for (size_t i = 0; i < list->count; i++) {
+        (void) _ccnxTlvDictionary_ListEntryBuffer(dictionary, &entries[i]);
+    }
+}
 
 CCNxTlvDictionary *
 ccnxTlvDictionary_Create(size_t bufferCount, size_t listCount)
 {
+    CCNxTlvDictionary *pooled = _ccnxTlvDictionaryPool_Take(bufferCount, listCount);
+    if (pooled != NULL) {
+        _ccnxTlvDictionary_GetTimeOfDay(&pooled->creationTime);
+        return pooled;
+    }
+
     size_t allocation = sizeof(CCNxTlvDictionary) + sizeof(_CCNxTlvDictionaryEntry) * bufferCount;
     CCNxTlvDictionary *dictionary = (CCNxTlvDictionary *)parcObject_CreateAndClearInstanceImpl(allocation, &parcObject_DescriptorName(CCNxTlvDictionary));
 
@@ -284,7 +664,7 @@ ccnxTlvDictionary_Create(size_t bufferCount, size_t listCount)
         dictionary->infoFreeFunction = NULL;
         dictionary->info = NULL;
 
-        dictionary->extraListHeads = NULL;
+        dictionary->extraLists = NULL;
         // dictionary->directArray is allocated as part of parcObject
     }
 
@@ -295,6 +675,61 @@ ccnxTlvDictionary_Create(size_t bufferCount, size_t listCount)
     return dictionary;
 }
 
+/**
+ * Copy every fast array and list entry of `source` in to the empty dictionary `copy`, sharing the values.
+ *
+ * Lazy entries stay lazy when `keepLazy` is true, in which case `copy` must have its own lazy source
+ * over the same bytes.  Otherwise they are resolved in `source` first.
+ */
+static void
+_ccnxTlvDictionary_CopyEntries(CCNxTlvDictionary *copy, const CCNxTlvDictionary *source, bool keepLazy)
+{
+    for (uint32_t key = 0; key < source->fastArraySize; ++key) {
+        if (!keepLazy) {
+            _ccnxTlvDictionary_ResolveLazyEntry(source, key);
+        }
+
+        const _CCNxTlvDictionaryEntry *entry = &source->directArray[key];
+        copy->directArray[key] = *entry;
+        switch (entry->entryType) {
+            case ENTRY_BUFFER:
+                parcBuffer_Acquire(entry->_entry.buffer);
+                break;
+            case ENTRY_NAME:
+                ccnxName_Acquire(entry->_entry.name);
+                break;
+            case ENTRY_IOVEC:
+                ccnxCodecNetworkBufferIoVec_Acquire(entry->_entry.vec);
+                break;
+            case ENTRY_JSON:
+                parcJSON_Acquire(entry->_entry.json);
+                break;
+            default:
+                // other types are direct storage
+                break;
+        }
+    }
+
+    for (uint32_t listKey = 0; listKey < source->listSize; ++listKey) {
+        _CCNxTlvDictionaryList *list = _getList(source, listKey);
+        if (list->count > 0) {
+            if (!keepLazy) {
+                _ccnxTlvDictionary_ResolveLazyList(source, list);
+            }
+
+            _CCNxTlvDictionaryList *copyList = _getList(copy, listKey);
+            const _CCNxTlvDictionaryListEntry *entries = _ccnxTlvDictionaryList_Entries(list);
+            for (size_t i = 0; i < list->count; i++) {
+                _CCNxTlvDictionaryListEntry *entry = _ccnxTlvDictionaryList_Append(copyList, entries[i].key);
+                *entry = entries[i];
+                if (entry->buffer) {
+                    parcBuffer_Acquire(entry->buffer);
+                }
+            }
+        }
+    }
+}
+
 CCNxTlvDictionary *
 ccnxTlvDictionary_ShallowCopy(const CCNxTlvDictionary *source)
 {
@@ -310,45 +745,75 @@ ccnxTlvDictionary_ShallowCopy(const CCNxTlvDictionary *source)
         newDictionary->messageInterface = source->messageInterface;
         newDictionary->info = source->info;
         newDictionary->infoFreeFunction = source->infoFreeFunction;
+        newDictionary->copyOnWrite = source->copyOnWrite;
 
-        //Update listHeads
-        for (uint32_t key = 0; key < source->listSize; ++key) {
-            size_t listSize = ccnxTlvDictionary_ListSize(source, key);
-            for (size_t i = 0; i < listSize; ++i) {
-                PARCBuffer *buffer;
-                uint32_t bKey;
-                ccnxTlvDictionary_ListGetByPosition(source, key, i, &buffer, &bKey);
-                parcBuffer_Acquire(buffer);
-                ccnxTlvDictionary_PutListBuffer(newDictionary, key, bKey, buffer);
-                parcBuffer_Release(&buffer);
-            }
-        }
+        _ccnxTlvDictionary_CopyEntries(newDictionary, source, false);
+    }
 
-        //Update directArray
-        for (uint32_t key = 0; key < source->fastArraySize; ++key) {
-            switch (source->directArray[key].entryType) {
-                case ENTRY_BUFFER:
-                    ccnxTlvDictionary_PutBuffer(newDictionary, key, ccnxTlvDictionary_GetBuffer(source, key));
-                    break;
-                case ENTRY_NAME:
-                    ccnxTlvDictionary_PutName(newDictionary, key, ccnxTlvDictionary_GetName(source, key));
-                    break;
-                case ENTRY_IOVEC:
-                    ccnxTlvDictionary_PutIoVec(newDictionary, key, ccnxTlvDictionary_GetIoVec(source, key));
-                    break;
-                case ENTRY_JSON:
-                    ccnxTlvDictionary_PutJson(newDictionary, key, ccnxTlvDictionary_GetJson(source, key));
-                    break;
-                case ENTRY_INTEGER:
-                    ccnxTlvDictionary_PutInteger(newDictionary, key, ccnxTlvDictionary_GetInteger(source, key));
-                    break;
-                default:
-                    break;
-            }
+    return newDictionary;
+}
+
+CCNxTlvDictionary *
+ccnxTlvDictionary_Clone(CCNxTlvDictionary *source)
+{
+    assertNotNull(source, "Parameter source must be non-null");
+
+    CCNxTlvDictionary *clone = ccnxTlvDictionary_Create(source->fastArraySize, source->listSize);
+
+    if (clone != NULL) {
+        clone->dictionaryType = source->dictionaryType;
+        clone->schemaVersion = source->schemaVersion;
+        clone->messageInterface = source->messageInterface;
+
+        // Lazy entries never move the lazy source, so the clone shares it as is
+        if (source->lazySource) {
+            clone->lazySource = parcBuffer_Acquire(source->lazySource);
         }
+
+        _ccnxTlvDictionary_CopyEntries(clone, source, true);
+
+        source->copyOnWrite = true;
+        clone->copyOnWrite = true;
     }
 
-    return newDictionary;
+    return clone;
+}
+
+bool
+ccnxTlvDictionary_IsCopyOnWrite(const CCNxTlvDictionary *dictionary)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    return dictionary->copyOnWrite;
+}
+
+bool
+ccnxTlvDictionary_RemoveValue(CCNxTlvDictionary *dictionary, uint32_t key)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+
+    _CCNxTlvDictionaryEntry *entry = &dictionary->directArray[key];
+    switch (entry->entryType) {
+        case ENTRY_UNSET:
+            return false;
+        case ENTRY_BUFFER:
+            parcBuffer_Release(&entry->_entry.buffer);
+            break;
+        case ENTRY_NAME:
+            ccnxName_Release(&entry->_entry.name);
+            break;
+        case ENTRY_IOVEC:
+            ccnxCodecNetworkBufferIoVec_Release(&entry->_entry.vec);
+            break;
+        case ENTRY_JSON:
+            parcJSON_Release(&entry->_entry.json);
+            break;
+        default:
+            // other types are direct storage
+            break;
+    }
+    memset(entry, 0, sizeof(_CCNxTlvDictionaryEntry));
+    return true;
 }
 
 bool
@@ -366,6 +831,42 @@ ccnxTlvDictionary_PutBuffer(CCNxTlvDictionary *dictionary, uint32_t key, const P
     return false;
 }
 
+void
+ccnxTlvDictionary_SetLazySource(CCNxTlvDictionary *dictionary, const PARCBuffer *wireFormat)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    assertNotNull(wireFormat, "Parameter wireFormat must be non-null");
+    assertNull(dictionary->lazySource, "The lazy source may only be set once");
+
+    dictionary->lazySource = parcBuffer_Slice(wireFormat);
+}
+
+bool
+ccnxTlvDictionary_IsLazy(const CCNxTlvDictionary *dictionary)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    return (dictionary->lazySource != NULL);
+}
+
+bool
+ccnxTlvDictionary_PutLazyBuffer(CCNxTlvDictionary *dictionary, uint32_t key, size_t offset, size_t length)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    assertNotNull(dictionary->lazySource, "Dictionary has no lazy source");
+    assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    assertTrue(offset + length <= parcBuffer_Capacity(dictionary->lazySource),
+               "Lazy value [%zu, %zu) beyond the lazy source capacity %zu",
+               offset, offset + length, parcBuffer_Capacity(dictionary->lazySource));
+
+    if (dictionary->directArray[key].entryType == ENTRY_UNSET) {
+        dictionary->directArray[key].entryType = ENTRY_LAZY;
+        dictionary->directArray[key]._entry.lazy.offset = (uint32_t) offset;
+        dictionary->directArray[key]._entry.lazy.length = (uint32_t) length;
+        return true;
+    }
+    return false;
+}
+
 bool
 ccnxTlvDictionary_PutName(CCNxTlvDictionary *dictionary, uint32_t key, const CCNxName *name)
 {
@@ -437,29 +938,6 @@ ccnxTlvDictionary_GetIoVec(const CCNxTlvDictionary *dictionary, uint32_t key)
     return NULL;
 }
 
-// If you need to change the list head, use this
-static _CCNxTlvDictionaryListEntry **
-_getListHeadReference(CCNxTlvDictionary *dictionary, uint32_t listKey)
-{
-    if (listKey < FIXED_LIST_LENGTH) {
-        return &dictionary->fixedListHeads[listKey];
-    } else {
-        if (dictionary->extraListHeads == NULL) {
-            dictionary->extraListHeads = parcMemory_AllocateAndClear(sizeof(_CCNxTlvDictionaryListEntry *) * (dictionary->listSize - FIXED_LIST_LENGTH));
-        }
-
-        return &dictionary->extraListHeads[listKey - FIXED_LIST_LENGTH];
-    }
-}
-
-// If not going to modify the list, use this
-static _CCNxTlvDictionaryListEntry *
-_getListHead(const CCNxTlvDictionary *dictionary, uint32_t listKey)
-{
-    _CCNxTlvDictionaryListEntry **head = _getListHeadReference((CCNxTlvDictionary *) dictionary, listKey);
-    return *head;
-}
-
 bool
 ccnxTlvDictionary_PutListBuffer(CCNxTlvDictionary *dictionary, uint32_t listKey, uint32_t key, const PARCBuffer *buffer)
 {
@@ -467,17 +945,26 @@ ccnxTlvDictionary_PutListBuffer(CCNxTlvDictionary *dictionary, uint32_t listKey,
     assertNotNull(buffer, "Parameter buffer must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
 
-    _CCNxTlvDictionaryListEntry *entry = _ccnxTlvDictionaryListEntry_Create(key, buffer);
+    // The new value becomes list position 0
+    _CCNxTlvDictionaryListEntry *entry = _ccnxTlvDictionaryList_Append(_getList(dictionary, listKey), key);
+    entry->buffer = parcBuffer_Acquire(buffer);
+    return true;
+}
 
-    _CCNxTlvDictionaryListEntry **head = _getListHeadReference(dictionary, listKey);
-    if (*head) {
-        // insert new value at list head
-        entry->next = *head;
-        *head = entry;
-    } else {
-        // new value is the list head
-        *head = entry;
-    }
+bool
+ccnxTlvDictionary_PutLazyListBuffer(CCNxTlvDictionary *dictionary, uint32_t listKey, uint32_t key, size_t offset, size_t length)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    assertNotNull(dictionary->lazySource, "Dictionary has no lazy source");
+    assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
+    assertTrue(offset + length <= parcBuffer_Capacity(dictionary->lazySource),
+               "Lazy value [%zu, %zu) beyond the lazy source capacity %zu",
+               offset, offset + length, parcBuffer_Capacity(dictionary->lazySource));
+
+    // The new value becomes list position 0, same as ccnxTlvDictionary_PutListBuffer()
+    _CCNxTlvDictionaryListEntry *entry = _ccnxTlvDictionaryList_Append(_getList(dictionary, listKey), key);
+    entry->offset = (uint32_t) offset;
+    entry->length = (uint32_t) length;
     return true;
 }
 
@@ -486,7 +973,7 @@ ccnxTlvDictionary_IsValueBuffer(const CCNxTlvDictionary *dictionary, uint32_t ke
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
-    return (dictionary->directArray[key].entryType == ENTRY_BUFFER);
+    return (dictionary->directArray[key].entryType == ENTRY_BUFFER || dictionary->directArray[key].entryType == ENTRY_LAZY);
 }
 
 bool
@@ -527,6 +1014,8 @@ ccnxTlvDictionary_GetBuffer(const CCNxTlvDictionary *dictionary, uint32_t key)
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
 
+    _ccnxTlvDictionary_ResolveLazyEntry(dictionary, key);
+
     // For now return NULL for backward compatability with prior code, case 1011
     if (dictionary->directArray[key].entryType == ENTRY_BUFFER) {
         return dictionary->directArray[key]._entry.buffer;
@@ -584,15 +1073,12 @@ ccnxTlvDictionary_ListGetByPosition(const CCNxTlvDictionary *dictionary, uint32_
     assertNotNull(keyPtr, "Parameter keyPtr must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
 
-    _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, listKey);
-    while (entry) {
-        if (listPosition == 0) {
-            *bufferPtr = entry->buffer;
-            *keyPtr = entry->key;
-            return true;
-        }
-        entry = entry->next;
-        --listPosition;
+    _CCNxTlvDictionaryList *list = _getList(dictionary, listKey);
+    if (listPosition < list->count) {
+        _CCNxTlvDictionaryListEntry *entry = _ccnxTlvDictionaryList_GetByPosition(list, listPosition);
+        *bufferPtr = _ccnxTlvDictionary_ListEntryBuffer(dictionary, entry);
+        *keyPtr = entry->key;
+        return true;
     }
 
     return false;
@@ -605,17 +1091,16 @@ ccnxTlvDictionary_ListGetByType(const CCNxTlvDictionary *dictionary, uint32_t li
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
 
-    PARCBuffer *buffer = NULL;
-    _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, listKey);
-    while (entry) {
-        if (entry->key == type) {
-            buffer = entry->buffer;
-            break;
+    // Search from list position 0, the most recently added entry
+    _CCNxTlvDictionaryList *list = _getList(dictionary, listKey);
+    _CCNxTlvDictionaryListEntry *entries = _ccnxTlvDictionaryList_Entries(list);
+    for (size_t i = list->count; i > 0; i--) {
+        if (entries[i - 1].key == type) {
+            return _ccnxTlvDictionary_ListEntryBuffer(dictionary, &entries[i - 1]);
         }
-        entry = entry->next;
     }
 
-    return buffer;
+    return NULL;
 }
 
 
@@ -625,14 +1110,40 @@ ccnxTlvDictionary_ListSize(const CCNxTlvDictionary *dictionary, uint32_t listKey
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
 
-    size_t size = 0;
-    _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, listKey);
-    while (entry) {
-        size++;
-        entry = entry->next;
+    return _getList(dictionary, listKey)->count;
+}
+
+CCNxTlvDictionaryListIterator
+ccnxTlvDictionary_ListIterator(const CCNxTlvDictionary *dictionary, uint32_t listKey)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
+
+    CCNxTlvDictionaryListIterator iterator = {
+        .dictionary = dictionary,
+        .listKey    = listKey,
+        .position   = 0,
+    };
+    return iterator;
+}
+
+bool
+ccnxTlvDictionaryListIterator_Next(CCNxTlvDictionaryListIterator *iterator, PARCBuffer **bufferPtr, uint32_t *keyPtr)
+{
+    assertNotNull(iterator, "Parameter iterator must be non-null");
+    assertNotNull(bufferPtr, "Parameter bufferPtr must be non-null");
+    assertNotNull(keyPtr, "Parameter keyPtr must be non-null");
+
+    _CCNxTlvDictionaryList *list = _getList(iterator->dictionary, iterator->listKey);
+    if (iterator->position < list->count) {
+        _CCNxTlvDictionaryListEntry *entry = _ccnxTlvDictionaryList_GetByPosition(list, iterator->position);
+        *bufferPtr = _ccnxTlvDictionary_ListEntryBuffer(iterator->dictionary, entry);
+        *keyPtr = entry->key;
+        iterator->position++;
+        return true;
     }
 
-    return size;
+    return false;
 }
 
 void
@@ -743,6 +1254,13 @@ _ccnxTlvDictionary_DisplayJson(const _CCNxTlvDictionaryEntry *entry, int index)
     parcMemory_Deallocate((void **) &string);
 }
 
+static void
+_ccnxTlvDictionary_DisplayLazy(const _CCNxTlvDictionaryEntry *entry, int index)
+{
+    printf("     Entry %3d type %8s offset %u length %u\n", index, _ccnxTlvDictionaryEntryTypeToString(entry->entryType),
+           entry->_entry.lazy.offset, entry->_entry.lazy.length);
+}
+
 static void
 _ccnxTlvDictionary_DisplayName(const _CCNxTlvDictionaryEntry *entry, int index)
 {
@@ -759,8 +1277,12 @@ _ccnxTlvDictionary_DisplayUnknown(const _CCNxTlvDictionaryEntry *entry, int inde
 static void
 _ccnxTlvDictionary_DisplayListEntry(const _CCNxTlvDictionaryListEntry *entry, int listIndex, int position)
 {
-    printf("     List %3d Position %3d key 0x%04X pointer %p\n", listIndex, position, entry->key, (void *) entry->buffer);
-    parcBuffer_Display(entry->buffer, 6);
+    if (entry->buffer) {
+        printf("     List %3d Position %3d key 0x%04X pointer %p\n", listIndex, position, entry->key, (void *) entry->buffer);
+        parcBuffer_Display(entry->buffer, 6);
+    } else {
+        printf("     List %3d Position %3d key 0x%04X offset %u length %u\n", listIndex, position, entry->key, entry->offset, entry->length);
+    }
 }
 
 void
@@ -803,6 +1325,10 @@ ccnxTlvDictionary_Display(const CCNxTlvDictionary *dictionary, int indent)
                     _ccnxTlvDictionary_DisplayName(&dictionary->directArray[i], i);
                     break;
 
+                case ENTRY_LAZY:
+                    _ccnxTlvDictionary_DisplayLazy(&dictionary->directArray[i], i);
+                    break;
+
                 default:
                     _ccnxTlvDictionary_DisplayUnknown(&dictionary->directArray[i], i);
             }
@@ -810,13 +1336,11 @@ ccnxTlvDictionary_Display(const CCNxTlvDictionary *dictionary, int indent)
     }
 
     for (int i = 0; i < dictionary->listSize; i++) {
-        _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, i);
-        if (entry) {
-            int position = 0;
-            printf("   Displaying custom entry list index %3d head %p\n", i, (void *) entry);
-            while (entry) {
-                _ccnxTlvDictionary_DisplayListEntry(entry, i, position);
-                entry = entry->next;
+        _CCNxTlvDictionaryList *list = _getList(dictionary, i);
+        if (list->count > 0) {
+            printf("   Displaying custom entry list index %3d count %u\n", i, list->count);
+            for (int position = 0; position < list->count; position++) {
+                _ccnxTlvDictionary_DisplayListEntry(_ccnxTlvDictionaryList_GetByPosition(list, position), i, position);
             }
         }
     }
@@ -887,31 +1411,20 @@ _ccnxTlvDictionaryListEntry_Equals(const _CCNxTlvDictionaryListEntry *a, const _
 }
 
 static bool
-_ccnxTlvDictionary_ListEquals(const _CCNxTlvDictionaryListEntry *listHeadA, const _CCNxTlvDictionaryListEntry *listHeadB)
+_ccnxTlvDictionary_ListEquals(const _CCNxTlvDictionaryList *listA, const _CCNxTlvDictionaryList *listB)
 {
-    if (listHeadA == NULL && listHeadB == NULL) {
-        return true;
-    }
-
-    if (listHeadA == NULL || listHeadB == NULL) {
+    if (listA->count != listB->count) {
         return false;
     }
 
-    // walk both linked lists in parallel
-    while (listHeadA && listHeadB) {
-        if (!_ccnxTlvDictionaryListEntry_Equals(listHeadA, listHeadB)) {
+    const _CCNxTlvDictionaryListEntry *entriesA = _ccnxTlvDictionaryList_Entries((_CCNxTlvDictionaryList *) listA);
+    const _CCNxTlvDictionaryListEntry *entriesB = _ccnxTlvDictionaryList_Entries((_CCNxTlvDictionaryList *) listB);
+    for (size_t i = 0; i < listA->count; i++) {
+        if (!_ccnxTlvDictionaryListEntry_Equals(&entriesA[i], &entriesB[i])) {
             return false;
         }
-
-        listHeadA = listHeadA->next;
-        listHeadB = listHeadB->next;
     }
-
-    // they must both be NULL otherwise the lists did not end at same place
-    if (listHeadA == NULL && listHeadB == NULL) {
-        return true;
-    }
-    return false;
+    return true;
 }
 
 /*
@@ -922,6 +1435,9 @@ _ccnxTlvDictionary_FastArrayEquals(const CCNxTlvDictionary *a, const CCNxTlvDict
 {
     bool equals = true;
     for (int i = 0; i < a->fastArraySize && equals; i++) {
+        // A lazy entry equals the buffer it stands for
+        _ccnxTlvDictionary_ResolveLazyEntry(a, i);
+        _ccnxTlvDictionary_ResolveLazyEntry(b, i);
         equals = _ccnxTlvDictionaryEntry_Equals(&a->directArray[i], &b->directArray[i]);
     }
     return equals;
@@ -935,9 +1451,12 @@ _ccnxTlvDictionary_ListsEquals(const CCNxTlvDictionary *a, const CCNxTlvDictiona
 {
     bool equals = true;
     for (int i = 0; i < a->listSize && equals; i++) {
-        _CCNxTlvDictionaryListEntry *entry_a = _getListHead(a, i);
-        _CCNxTlvDictionaryListEntry *entry_b = _getListHead(b, i);
-        equals = _ccnxTlvDictionary_ListEquals(entry_a, entry_b);
+        _CCNxTlvDictionaryList *list_a = _getList(a, i);
+        _CCNxTlvDictionaryList *list_b = _getList(b, i);
+        // A lazy list entry equals the buffer it stands for
+        _ccnxTlvDictionary_ResolveLazyList(a, list_a);
+        _ccnxTlvDictionary_ResolveLazyList(b, list_b);
+        equals = _ccnxTlvDictionary_ListEquals(list_a, list_b);
     }
     return equals;
 }
@@ -70,6 +70,18 @@ typedef enum {
     CCNxTlvDictionary_SchemaVersion_V1 = 1,
 } CCNxTlvDictionary_SchemaVersion;
 
+/**
+ * @typedef CCNxTlvDictionaryListIterator
+ * @brief Walks one dictionary list from position 0, see {@link ccnxTlvDictionary_ListIterator}.
+ *
+ * The fields are private.  The iterator is a value on the caller's stack and needs no release.
+ */
+typedef struct ccnx_tlv_dictionary_list_iterator {
+    const CCNxTlvDictionary *dictionary;
+    uint32_t listKey;
+    size_t position;
+} CCNxTlvDictionaryListIterator;
+
 
 /**
  * Creates a new TLV dictionary with the given size
@@ -80,6 +92,9 @@ typedef enum {
  * @param [in] bufferCount The number of Buffer elements to allocate within the dictionary.
  * @param [in] listCount The number of List elements to allocate within the dictionary.
  *
+ * If the calling thread has a dictionary pool (see {@link ccnxTlvDictionary_SetThreadPoolCapacity}) holding a
+ * dictionary of the same size, that dictionary is returned instead of a new allocation.
+ *
  * @return NULL A new CCNxTlvDictionary object could not be allocated.
  * @return CCNxTlvDictionary A new CCNxTlvDictionary instance with bufferCount Buffer and listCount List elements.
  *
@@ -128,6 +143,8 @@ CCNxTlvDictionary *ccnxTlvDictionary_Acquire(const CCNxTlvDictionary *dictionary
  * If the invocation causes the last reference to the instance to be released,
  * the instance is deallocated and the instance's implementation will perform
  * additional cleanup and release other privately held references.
+ * If the calling thread has a dictionary pool with room, the instance is reset
+ * and kept in the pool instead of being deallocated.
  *
  * @param [in] dictionaryPtr A pointer to a pointer to the instance to release.
  *
@@ -145,6 +162,73 @@ CCNxTlvDictionary *ccnxTlvDictionary_Acquire(const CCNxTlvDictionary *dictionary
  */
 void ccnxTlvDictionary_Release(CCNxTlvDictionary **dictionaryPtr);
 
+/**
+ * Release every entry of the dictionary, keeping its allocation.
+ *
+ * Afterwards the dictionary is the same as one returned by {@link ccnxTlvDictionary_Create} with the
+ * same sizes: every key is unset, every list is empty, and the message type, schema version, message
+ * interface, info and lazy source are cleared.
+ *
+ * The caller should hold the only reference to the dictionary.
+ *
+ * @param [in] dictionary The dictionary to reset
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dict = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+ *     while (_receive(packetBuffer)) {
+ *         ccnxCodecTlvPacket_BufferDecode(packetBuffer, dict);
+ *         _process(dict);
+ *         ccnxTlvDictionary_Reset(dict);
+ *         ccnxTlvDictionary_SetMessageType_Interest(dict, CCNxTlvDictionary_SchemaVersion_V1);
+ *     }
+ *     ccnxTlvDictionary_Release(&dict);
+ * }
+ * @endcode
+ */
+void ccnxTlvDictionary_Reset(CCNxTlvDictionary *dictionary);
+
+/**
+ * Keep up to `capacity` released dictionaries of each size for reuse by the calling thread.
+ *
+ * Once a thread has a pool, {@link ccnxTlvDictionary_Release} resets a dictionary whose last reference
+ * it drops and keeps it in the pool, and {@link ccnxTlvDictionary_Create} takes a pooled dictionary of
+ * the requested (bufferCount, listCount) before allocating.  Up to 4 different sizes are pooled.
+ *
+ * A capacity of 0, the default, disables the pool and deallocates the dictionaries in it.  The pool is
+ * also deallocated when the thread exits.  Pooled dictionaries are counted by `parcMemory_Outstanding`,
+ * so a thread that checks for leaks should set the capacity to 0 first.
+ *
+ * @param [in] capacity The maximum number of pooled dictionaries of each size.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxTlvDictionary_SetThreadPoolCapacity(64);
+ *     _forwarderLoop();
+ *     ccnxTlvDictionary_SetThreadPoolCapacity(0);
+ * }
+ * @endcode
+ */
+void ccnxTlvDictionary_SetThreadPoolCapacity(size_t capacity);
+
+/**
+ * The capacity of the calling thread's dictionary pool.
+ *
+ * @return The value last given to {@link ccnxTlvDictionary_SetThreadPoolCapacity} on this thread, or 0.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (ccnxTlvDictionary_GetThreadPoolCapacity() == 0) {
+ *         ccnxTlvDictionary_SetThreadPoolCapacity(64);
+ *     }
+ * }
+ * @endcode
+ */
+size_t ccnxTlvDictionary_GetThreadPoolCapacity(void);
+
 /**
  * Adds a buffer to a dictionary entry
  *
@@ -171,6 +255,79 @@ void ccnxTlvDictionary_Release(CCNxTlvDictionary **dictionaryPtr);
  */
 bool ccnxTlvDictionary_PutBuffer(CCNxTlvDictionary *dictionary, uint32_t key, const PARCBuffer *buffer);
 
+/**
+ * Sets the wire format that lazy entries point in to.
+ *
+ * A decoder sets this before putting lazy entries.  The dictionary keeps its own slice
+ * of `wireFormat` from the current position to the limit, and offsets of lazy entries
+ * are relative to that position.  May only be set once.
+ *
+ * The getters resolve a lazy entry the first time it is read.  Resolution never moves the
+ * lazy source and publishes each entry under a lock, so a dictionary that is no longer
+ * being modified may be read from several threads at once.
+ *
+ * @param [in] dictionary The dictionary instance to be modified
+ * @param [in] wireFormat The encoded packet
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dict = ccnxTlvDictionary_Create(5, 3);
+ *     ccnxTlvDictionary_SetLazySource(dict, packetBuffer);
+ *     ccnxTlvDictionary_PutLazyBuffer(dict, 1, 12, 4);
+ * }
+ * @endcode
+ */
+void ccnxTlvDictionary_SetLazySource(CCNxTlvDictionary *dictionary, const PARCBuffer *wireFormat);
+
+/**
+ * Determines if the dictionary has a lazy source
+ *
+ * @param [in] dictionary The dictionary instance which will be examined.
+ *
+ * @return true ccnxTlvDictionary_SetLazySource() was called
+ * @return false The dictionary only holds materialized values
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dict = ccnxTlvDictionary_Create(5, 3);
+ *     ccnxTlvDictionary_SetLazySource(dict, packetBuffer);
+ *     bool truthy = ccnxTlvDictionary_IsLazy(dict);
+ *     // truthy will be true
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionary_IsLazy(const CCNxTlvDictionary *dictionary);
+
+/**
+ * Put a Buffer entry that is only sliced out of the lazy source when first used.
+ *
+ * The entry behaves exactly like one set with ccnxTlvDictionary_PutBuffer(), but
+ * no PARCBuffer is created unless ccnxTlvDictionary_GetBuffer() (or a function using it)
+ * asks for the value.  The dictionary must have a lazy source.
+ *
+ * @param [in] dictionary An CCNxTlvDictionary instance to which the Buffer entry will be added.
+ * @param [in] key The integer key that is to be associated with the new Buffer entry.
+ * @param [in] offset The offset of the value in the lazy source
+ * @param [in] length The length of the value
+ *
+ * @return true Key was not previously set
+ * @return false Key already has a value assigned to it
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dict = ccnxTlvDictionary_Create(5, 3);
+ *     ccnxTlvDictionary_SetLazySource(dict, packetBuffer);
+ *     ccnxTlvDictionary_PutLazyBuffer(dict, 1, 12, 4);
+ *     // the slice is made here
+ *     PARCBuffer *value = ccnxTlvDictionary_GetBuffer(dict, 1);
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionary_PutLazyBuffer(CCNxTlvDictionary *dictionary, uint32_t key, size_t offset, size_t length);
+
 /**
  * Determine if the value associated with the specified key is a Buffer.
  *
@@ -487,6 +644,31 @@ CCNxCodecNetworkBufferIoVec *ccnxTlvDictionary_GetIoVec(const CCNxTlvDictionary
  */
 bool ccnxTlvDictionary_PutListBuffer(CCNxTlvDictionary *dictionary, uint32_t listKey, uint32_t key, const PARCBuffer *buffer);
 
+/**
+ * Insert a new List item that is only sliced out of the lazy source when first used.
+ *
+ * Same as ccnxTlvDictionary_PutListBuffer(), but the buffer is created when the list
+ * item is first retrieved.  The dictionary must have a lazy source.
+ *
+ * @param [in] dictionary The dictionary instance to be modified
+ * @param [in] listKey The list key used when indexing the dictionary lists
+ * @param [in] key The key type of the element being inserted into the list
+ * @param [in] offset The offset of the value in the lazy source
+ * @param [in] length The length of the value
+ *
+ * @return true If the put was successful.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dict = ccnxTlvDictionary_Create(5, 3);
+ *     ccnxTlvDictionary_SetLazySource(dict, packetBuffer);
+ *     bool success = ccnxTlvDictionary_PutLazyListBuffer(dict, 1, 1, 12, 4);
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionary_PutLazyListBuffer(CCNxTlvDictionary *dictionary, uint32_t listKey, uint32_t key, size_t offset, size_t length);
+
 /**
  * Insert a new `PARCJSON` instance into the dictionary.
  *
@@ -646,6 +828,58 @@ PARCBuffer *ccnxTlvDictionary_ListGetByType(const CCNxTlvDictionary *dictionary,
  */
 size_t ccnxTlvDictionary_ListSize(const CCNxTlvDictionary *dictionary, uint32_t listKey);
 
+/**
+ * Create an iterator over the list identified by 'listKey'
+ *
+ * The iterator returns the list entries in position order, the same order as
+ * {@link ccnxTlvDictionary_ListGetByPosition}, at O(1) per entry.  Adding to the list
+ * while iterating is not supported.
+ *
+ * @param [in] dictionary The dictionary instance to be examined
+ * @param [in] listKey The key used to index into the dictionary lists
+ *
+ * @return An iterator positioned before the first entry of the list
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionaryListIterator iterator = ccnxTlvDictionary_ListIterator(dict, CCNxCodecSchemaV1TlvDictionary_Lists_HEADERS);
+ *     PARCBuffer *buffer;
+ *     uint32_t key;
+ *     while (ccnxTlvDictionaryListIterator_Next(&iterator, &buffer, &key)) {
+ *         _processCustomHeader(key, buffer);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxTlvDictionaryListIterator ccnxTlvDictionary_ListIterator(const CCNxTlvDictionary *dictionary, uint32_t listKey);
+
+/**
+ * Advance the iterator and return the next list entry
+ *
+ * The returned buffer is owned by the dictionary; acquire it to keep it beyond the dictionary's life.
+ *
+ * @param [in,out] iterator An iterator from {@link ccnxTlvDictionary_ListIterator}
+ * @param [out] bufferPtr If there is a next entry, its buffer
+ * @param [out] keyPtr If there is a next entry, its key
+ *
+ * @return true The entry was returned in bufferPtr and keyPtr
+ * @return false The iterator is at the end of the list
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionaryListIterator iterator = ccnxTlvDictionary_ListIterator(dict, 1);
+ *     PARCBuffer *buffer;
+ *     uint32_t key;
+ *     while (ccnxTlvDictionaryListIterator_Next(&iterator, &buffer, &key)) {
+ *         parcBuffer_Display(buffer, 0);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionaryListIterator_Next(CCNxTlvDictionaryListIterator *iterator, PARCBuffer **bufferPtr, uint32_t *keyPtr);
+
 /**
  * Set the type of message which this dictionary stores/represents to be an Interest.
  *
@@ -967,6 +1201,76 @@ bool ccnxTlvDictionary_Equals(const CCNxTlvDictionary *a, const CCNxTlvDictionar
  */
 CCNxTlvDictionary *ccnxTlvDictionary_ShallowCopy(const CCNxTlvDictionary *source);
 
+/**
+ * Create a copy-on-write clone of a dictionary.
+ *
+ * The clone shares every value of `source` by reference, in time linear in the number of entries.
+ * Lazy entries stay lazy.  The dictionary info, which its free function owns, is not shared.
+ *
+ * Both `source` and the clone are marked copy-on-write (see {@link ccnxTlvDictionary_IsCopyOnWrite}).
+ * Code that writes in to a shared value, such as the wire format, must first replace the value
+ * with a private copy (see {@link ccnxTlvDictionary_RemoveValue}).
+ *
+ * @param [in] source The dictionary to clone
+ *
+ * @return CCNxTlvDictionary A new dictionary equal to `source`
+ *
+ * Example:
+ * @code
+ * {
+ *     for (int i = 0; i < faceCount; i++) {
+ *         CCNxTlvDictionary *clone = ccnxTlvDictionary_Clone(contentObject);
+ *         ccnxWireFormatMessage_SetHopLimit(clone, hopLimit[i]);
+ *         _send(faces[i], clone);
+ *         ccnxTlvDictionary_Release(&clone);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxTlvDictionary *ccnxTlvDictionary_Clone(CCNxTlvDictionary *source);
+
+/**
+ * Determine if the dictionary may share its values with a clone.
+ *
+ * @param [in] dictionary The dictionary instance to examine
+ *
+ * @return true The dictionary is a clone or has been cloned, see {@link ccnxTlvDictionary_Clone}
+ * @return false The dictionary's values are not shared by a clone
+ *
+ * Example:
+ * @code
+ * {
+ *     if (ccnxTlvDictionary_IsCopyOnWrite(dictionary)) {
+ *         // copy the value before writing to it
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionary_IsCopyOnWrite(const CCNxTlvDictionary *dictionary);
+
+/**
+ * Release the value of a fast array key, leaving it UNSET.
+ *
+ * A new value may then be put at the key.
+ *
+ * @param [in] dictionary The dictionary instance to be modified
+ * @param [in] key The fast array key, less than the dictionary's bufferCount
+ *
+ * @return true The key had a value, which was removed
+ * @return false The key was already UNSET
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dict = ccnxTlvDictionary_Create(5, 3);
+ *     ccnxTlvDictionary_PutBuffer(dict, 1, oldValue);
+ *     ccnxTlvDictionary_RemoveValue(dict, 1);
+ *     ccnxTlvDictionary_PutBuffer(dict, 1, newValue);
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionary_RemoveValue(CCNxTlvDictionary *dictionary, uint32_t key);
+
 /**
  * Set the pointer to the implementation used to create the message type represented by this
  * CCNxTlvDictionary. For example, if the CCNxTlvDictionary represents a V1 ContentObject,
@@ -79,11 +79,65 @@ _ccnxWireFormatFacadeV1_FromControlPacketType(const PARCBuffer *wireFormat)
     return dictionary;
 }
 
+/**
+ * The length of the fixed header plus optional headers, clamped to the packet length.
+ */
+static size_t
+_ccnxWireFormatFacadeV1_HeaderLength(const uint8_t *fixedHeader, size_t packetLength)
+{
+    size_t headerLength = ((const CCNxCodecSchemaV1FixedHeader *) fixedHeader)->headerLength;
+    if (headerLength < sizeof(CCNxCodecSchemaV1FixedHeader)) {
+        headerLength = sizeof(CCNxCodecSchemaV1FixedHeader);
+    }
+    return (headerLength < packetLength) ? headerLength : packetLength;
+}
+
+/**
+ * If the wire format is shared with a clone, replace it with an io vector whose first
+ * element is a private copy of the fixed and optional headers.  The rest of the packet
+ * stays shared.  Afterwards the headers may be written in place.
+ */
+static void
+_ccnxWireFormatFacadeV1_UnshareHeaders(CCNxTlvDictionary *dictionary)
+{
+    if (!ccnxTlvDictionary_IsCopyOnWrite(dictionary)) {
+        return;
+    }
+
+    CCNxCodecNetworkBufferIoVec *copy = NULL;
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxWireFormatMessage_GetIoVec(dictionary);
+    if (iovec) {
+        if (ccnxCodecNetworkBufferIoVec_GetReferenceCount(iovec) > 1) {
+            const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+            assertTrue(iov[0].iov_len >= sizeof(CCNxCodecSchemaV1FixedHeader),
+                       "Header not contained in first element of io vector");
+            size_t headerLength = _ccnxWireFormatFacadeV1_HeaderLength(iov[0].iov_base, ccnxCodecNetworkBufferIoVec_Length(iovec));
+            copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopy(iovec, headerLength);
+        }
+    } else {
+        PARCBuffer *wireFormatBuffer = ccnxWireFormatMessage_GetWireFormatBuffer(dictionary);
+        if (wireFormatBuffer && parcBuffer_Remaining(wireFormatBuffer) >= sizeof(CCNxCodecSchemaV1FixedHeader)) {
+            // The caller may hold the buffer too, so a buffer is always copied
+            size_t headerLength = _ccnxWireFormatFacadeV1_HeaderLength(parcBuffer_Overlay(wireFormatBuffer, 0), parcBuffer_Remaining(wireFormatBuffer));
+            copy = ccnxCodecNetworkBufferIoVec_CreateHeaderCopyFromBuffer(wireFormatBuffer, headerLength);
+        }
+    }
+
+    if (copy) {
+        ccnxTlvDictionary_RemoveValue(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat);
+        ccnxTlvDictionary_PutIoVec(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat, copy);
+        ccnxCodecNetworkBufferIoVec_Release(&copy);
+    }
+}
+
 static void
 _ccnxWireFormatFacadeV1_SetHopLimit(const CCNxTlvDictionary *dictionary, uint32_t hopLimit)
 {
     CCNxCodecSchemaV1InterestHeader *header;
 
+    // The interface takes a const dictionary, but a clone must swap in its own copy of the headers
+    _ccnxWireFormatFacadeV1_UnshareHeaders((CCNxTlvDictionary *) dictionary);
+
     // Currently there is only one of either a PARCBuffer or an IoVec ...
 
     // Update attached iovec
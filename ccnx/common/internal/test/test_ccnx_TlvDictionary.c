@@ -120,6 +120,8 @@ LONGBOW_TEST_RUNNER(rta_TlvDictionary)
     LONGBOW_RUN_TEST_FIXTURE(IoVec);
     LONGBOW_RUN_TEST_FIXTURE(Json);
     LONGBOW_RUN_TEST_FIXTURE(Name);
+    LONGBOW_RUN_TEST_FIXTURE(Lazy);
+    LONGBOW_RUN_TEST_FIXTURE(Pool);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -143,6 +145,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_Acquire);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_Create);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_Release);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_Reset);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetMessageType_ContentObject);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetMessageType_Interest);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetMessageType_Control);
@@ -152,6 +155,10 @@ LONGBOW_TEST_FIXTURE(Global)
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_Equals);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_Clone);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_IsCopyOnWrite);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_RemoveValue);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_RemoveValue_Unset);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -198,12 +205,35 @@ LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_Acquire)
     ccnxTlvDictionary_Release(&first);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_Reset)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetMessageType_Interest(data->dictionary, CCNxTlvDictionary_SchemaVersion_V1);
+
+    PARCBuffer *buffer = parcBuffer_Allocate(3);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, SchemaEnd + 1, 1000, buffer);
+    parcBuffer_Release(&buffer);
+
+    ccnxTlvDictionary_Reset(data->dictionary);
+
+    for (uint32_t key = 0; key < data->fastArraySize; key++) {
+        assertTrue(data->dictionary->directArray[key].entryType == ENTRY_UNSET, "Key %u should be empty after reset", key);
+    }
+    assertTrue(ccnxTlvDictionary_ListSize(data->dictionary, SchemaEnd + 1) == 0, "List should be empty after reset");
+    assertFalse(ccnxTlvDictionary_IsInterest(data->dictionary), "Message type should be cleared by reset");
+    assertFalse(ccnxTlvDictionary_IsLazy(data->dictionary), "Lazy source should be cleared by reset");
+
+    CCNxTlvDictionary *empty = ccnxTlvDictionary_Create(data->fastArraySize, data->listSize);
+    assertTrue(ccnxTlvDictionary_Equals(data->dictionary, empty), "Reset dictionary should equal a new dictionary");
+    ccnxTlvDictionary_Release(&empty);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_Create)
 {
     CCNxTlvDictionary *dictionary = ccnxTlvDictionary_Create(20, 30);
     assertNotNull(dictionary, "Got null dictionary from Create");
     assertNotNull(dictionary->directArray, "DirectArray is null");
-    assertNotNull(dictionary->fixedListHeads, "fixedListHeads is null");
+    assertNotNull(dictionary->fixedLists, "fixedLists is null");
 
     ccnxTlvDictionary_Release(&dictionary);
 }
@@ -335,6 +365,64 @@ LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy)
     ccnxTlvDictionary_Release(&b);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_Clone)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetMessageType_ContentObject(data->dictionary, CCNxTlvDictionary_SchemaVersion_V1);
+
+    PARCBuffer *a = parcBuffer_Allocate(1);
+    PARCBuffer *b = parcBuffer_Allocate(2);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, SchemaEnd, 1000, a);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, SchemaEnd, 1001, b);
+
+    CCNxTlvDictionary *clone = ccnxTlvDictionary_Clone(data->dictionary);
+    assertTrue(ccnxTlvDictionary_Equals(data->dictionary, clone), "Expected the clone to equal its source");
+    assertTrue(ccnxTlvDictionary_IsContentObject(clone), "The clone should keep the message type");
+    assertTrue(ccnxTlvDictionary_GetBuffer(clone, SchemaBuffer) == ccnxTlvDictionary_GetBuffer(data->dictionary, SchemaBuffer),
+               "The clone should share the buffer");
+    assertTrue(ccnxTlvDictionary_GetIoVec(clone, SchemaIoVec) == ccnxTlvDictionary_GetIoVec(data->dictionary, SchemaIoVec),
+               "The clone should share the io vector");
+    assertTrue(ccnxTlvDictionary_ListGetByType(clone, SchemaEnd, 1000) == a, "The clone should share the list buffers");
+
+    ccnxTlvDictionary_Release(&clone);
+    parcBuffer_Release(&a);
+    parcBuffer_Release(&b);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_IsCopyOnWrite)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    assertFalse(ccnxTlvDictionary_IsCopyOnWrite(data->dictionary), "A new dictionary is not copy-on-write");
+
+    CCNxTlvDictionary *clone = ccnxTlvDictionary_Clone(data->dictionary);
+    assertTrue(ccnxTlvDictionary_IsCopyOnWrite(data->dictionary), "A cloned dictionary is copy-on-write");
+    assertTrue(ccnxTlvDictionary_IsCopyOnWrite(clone), "A clone is copy-on-write");
+    ccnxTlvDictionary_Release(&clone);
+
+    ccnxTlvDictionary_Reset(data->dictionary);
+    assertFalse(ccnxTlvDictionary_IsCopyOnWrite(data->dictionary), "A reset dictionary is not copy-on-write");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_RemoveValue)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    for (uint32_t key = SchemaBuffer; key < SchemaEnd; key++) {
+        assertTrue(ccnxTlvDictionary_RemoveValue(data->dictionary, key), "Key %u should have had a value", key);
+        assertTrue(data->dictionary->directArray[key].entryType == ENTRY_UNSET, "Key %u should be unset", key);
+    }
+
+    PARCBuffer *buffer = parcBuffer_Allocate(1);
+    assertTrue(ccnxTlvDictionary_PutBuffer(data->dictionary, SchemaBuffer, buffer), "Should be able to put a removed key");
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_RemoveValue_Unset)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    assertFalse(ccnxTlvDictionary_RemoveValue(data->dictionary, SchemaFree), "An unset key has no value to remove");
+}
+
 // ================================================================
 
 LONGBOW_TEST_FIXTURE(KnownKeys)
@@ -455,6 +543,12 @@ LONGBOW_TEST_FIXTURE(UnknownKeys)
     LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType);
     LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListSize);
     LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListEquals);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType_Newest);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListIterator);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListIterator_Empty);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_Overflow);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_ResetKeepsStorage);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_ShallowCopy);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(UnknownKeys)
@@ -586,7 +680,7 @@ LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListEquals)
     ccnxTlvDictionary_PutListBuffer(data->dictionary, 7, 1001, b);
     ccnxTlvDictionary_PutListBuffer(data->dictionary, 7, 1002, c);
 
-    bool equals = _ccnxTlvDictionary_ListEquals(_getListHead(data->dictionary, 6), _getListHead(data->dictionary, 7));
+    bool equals = _ccnxTlvDictionary_ListEquals(_getList(data->dictionary, 6), _getList(data->dictionary, 7));
     assertTrue(equals, "Lists should be equal");
 
     parcBuffer_Release(&a);
@@ -594,6 +688,138 @@ LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListEquals)
     parcBuffer_Release(&c);
 }
 
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType_Newest)
+{
+    uint32_t listKey = SchemaEnd;
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *a = parcBuffer_Allocate(1);
+    PARCBuffer *b = parcBuffer_Allocate(1);
+
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 1000, a);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 1000, b);
+
+    PARCBuffer *test = ccnxTlvDictionary_ListGetByType(data->dictionary, listKey, 1000);
+    assertTrue(test == b, "Expected the most recent buffer %p, got %p", (void *) b, (void *) test);
+
+    parcBuffer_Release(&a);
+    parcBuffer_Release(&b);
+}
+
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListIterator)
+{
+    uint32_t listKey = SchemaEnd;
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffers[5];
+    for (int i = 0; i < 5; i++) {
+        buffers[i] = parcBuffer_Allocate(1);
+        ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 1000 + i, buffers[i]);
+    }
+
+    CCNxTlvDictionaryListIterator iterator = ccnxTlvDictionary_ListIterator(data->dictionary, listKey);
+    PARCBuffer *test;
+    uint32_t testkey;
+    size_t position = 0;
+    while (ccnxTlvDictionaryListIterator_Next(&iterator, &test, &testkey)) {
+        PARCBuffer *expected;
+        uint32_t expectedKey;
+        ccnxTlvDictionary_ListGetByPosition(data->dictionary, listKey, position, &expected, &expectedKey);
+        assertTrue(test == expected, "Wrong buffer at position %zu, expected %p got %p", position, (void *) expected, (void *) test);
+        assertTrue(testkey == expectedKey, "Wrong key at position %zu, expected %u got %u", position, expectedKey, testkey);
+        position++;
+    }
+    assertTrue(position == 5, "Wrong iteration count, expected 5 got %zu", position);
+
+    for (int i = 0; i < 5; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListIterator_Empty)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTlvDictionaryListIterator iterator = ccnxTlvDictionary_ListIterator(data->dictionary, SchemaEnd);
+    PARCBuffer *test;
+    uint32_t testkey;
+    assertFalse(ccnxTlvDictionaryListIterator_Next(&iterator, &test, &testkey), "An empty list should have no entries");
+}
+
+/*
+ * Put enough entries in a fixed list and an extra list to need overflow storage more than once
+ */
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_Overflow)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    uint32_t listKeys[] = { SchemaEnd, FIXED_LIST_LENGTH + 1 };
+    size_t count = OVERFLOW_LIST_ENTRIES * 4 + 1;
+
+    for (int k = 0; k < 2; k++) {
+        for (size_t i = 0; i < count; i++) {
+            PARCBuffer *buffer = parcBuffer_Allocate(sizeof(uint32_t));
+            parcBuffer_PutUint32(buffer, (uint32_t) i);
+            ccnxTlvDictionary_PutListBuffer(data->dictionary, listKeys[k], (uint32_t) i, buffer);
+            parcBuffer_Release(&buffer);
+        }
+
+        size_t length = ccnxTlvDictionary_ListSize(data->dictionary, listKeys[k]);
+        assertTrue(length == count, "Wrong length, expected %zu got %zu", count, length);
+
+        for (size_t position = 0; position < count; position++) {
+            PARCBuffer *test;
+            uint32_t testkey;
+            ccnxTlvDictionary_ListGetByPosition(data->dictionary, listKeys[k], position, &test, &testkey);
+            uint32_t expected = (uint32_t) (count - 1 - position);
+            assertTrue(testkey == expected, "Wrong key at position %zu, expected %u got %u", position, expected, testkey);
+            assertTrue(parcBuffer_GetUint32(parcBuffer_Rewind(test)) == expected, "Wrong buffer at position %zu", position);
+        }
+
+        PARCBuffer *first = ccnxTlvDictionary_ListGetByType(data->dictionary, listKeys[k], 0);
+        assertNotNull(first, "Did not find the first entry after the list grew");
+    }
+}
+
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_ResetKeepsStorage)
+{
+    uint32_t listKey = SchemaEnd;
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = parcBuffer_Allocate(1);
+    for (int i = 0; i < OVERFLOW_LIST_ENTRIES; i++) {
+        ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, i, buffer);
+    }
+
+    ccnxTlvDictionary_Reset(data->dictionary);
+    assertTrue(ccnxTlvDictionary_ListSize(data->dictionary, listKey) == 0, "List should be empty after reset");
+
+    uint32_t before = parcMemory_Outstanding();
+    for (int i = 0; i < OVERFLOW_LIST_ENTRIES; i++) {
+        ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, i, buffer);
+    }
+    uint32_t after = parcMemory_Outstanding();
+    assertTrue(before == after, "Refilling a reset list should not allocate, got %u allocations", after - before);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_ShallowCopy)
+{
+    uint32_t listKey = SchemaEnd;
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *a = parcBuffer_Allocate(1);
+    PARCBuffer *b = parcBuffer_Allocate(2);
+    PARCBuffer *c = parcBuffer_Allocate(3);
+
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 1000, a);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 1001, b);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 1002, c);
+
+    CCNxTlvDictionary *copy = ccnxTlvDictionary_ShallowCopy(data->dictionary);
+    assertTrue(ccnxTlvDictionary_Equals(data->dictionary, copy), "Shallow copy should keep the list order");
+    ccnxTlvDictionary_Release(&copy);
+
+    parcBuffer_Release(&a);
+    parcBuffer_Release(&b);
+    parcBuffer_Release(&c);
+}
+
 
 
 // =============================================================
@@ -1145,6 +1371,386 @@ LONGBOW_TEST_CASE(Local, _rtaTlvEntry_Equals_Name)
 
 // =============================================================
 
+LONGBOW_TEST_FIXTURE(Lazy)
+{
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_IsLazy_False);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_IsLazy_True);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_PutLazyBuffer_OK);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_PutLazyBuffer_Duplicate);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_IsValueBuffer_Lazy);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_PutLazyListBuffer);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_Equals_LazyEager);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_ShallowCopy_Lazy);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_Clone_Lazy);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_Clone_AfterGetBuffer);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxTlvDictionary_GetBuffer_Lazy_Threads);
+}
+
+typedef struct lazy_data {
+    PARCBuffer *wireFormat;
+    CCNxTlvDictionary *lazy;
+    CCNxTlvDictionary *eager;
+} LazyData;
+
+static const char _lazyWireFormat[] = "0123456789abcdefghij";
+
+LONGBOW_TEST_FIXTURE_SETUP(Lazy)
+{
+    LazyData *data = parcMemory_AllocateAndClear(sizeof(LazyData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(LazyData));
+    data->wireFormat = parcBuffer_Wrap((void *) _lazyWireFormat, sizeof(_lazyWireFormat) - 1, 0, sizeof(_lazyWireFormat) - 1);
+    data->lazy = ccnxTlvDictionary_Create(SchemaEnd + 2, SchemaEnd + 10);
+    data->eager = ccnxTlvDictionary_Create(SchemaEnd + 2, SchemaEnd + 10);
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Lazy)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_Release(&data->eager);
+    ccnxTlvDictionary_Release(&data->lazy);
+    parcBuffer_Release(&data->wireFormat);
+    parcMemory_Deallocate((void **) &data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCBuffer *
+_lazyExpected(size_t offset, size_t length)
+{
+    return parcBuffer_Wrap((void *) _lazyWireFormat, sizeof(_lazyWireFormat) - 1, offset, offset + length);
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_IsLazy_False)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    assertFalse(ccnxTlvDictionary_IsLazy(data->eager), "Dictionary without a lazy source should not be lazy");
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_IsLazy_True)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+    assertTrue(ccnxTlvDictionary_IsLazy(data->lazy), "Dictionary with a lazy source should be lazy");
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_PutLazyBuffer_OK)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+
+    bool success = ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 4, 6);
+    assertTrue(success, "Did not put lazy buffer in to available slot");
+
+    PARCBuffer *expected = _lazyExpected(4, 6);
+    PARCBuffer *test = ccnxTlvDictionary_GetBuffer(data->lazy, SchemaBuffer);
+    assertTrue(parcBuffer_Equals(expected, test), "Wrong lazy value")
+    {
+        parcBuffer_Display(expected, 3);
+        parcBuffer_Display(test, 3);
+    }
+
+    // a second access returns the same resolved buffer
+    PARCBuffer *again = ccnxTlvDictionary_GetBuffer(data->lazy, SchemaBuffer);
+    assertTrue(again == test, "Lazy value should only be resolved once");
+    parcBuffer_Release(&expected);
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_PutLazyBuffer_Duplicate)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+
+    ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 0, 4);
+    bool success = ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 4, 4);
+    assertFalse(success, "Should have failed putting duplicate");
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_IsValueBuffer_Lazy)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+    ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 0, 4);
+
+    assertTrue(ccnxTlvDictionary_IsValueBuffer(data->lazy, SchemaBuffer), "Unresolved lazy value should be a buffer");
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_PutLazyListBuffer)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+
+    ccnxTlvDictionary_PutLazyListBuffer(data->lazy, SchemaBuffer, 100, 0, 3);
+    ccnxTlvDictionary_PutLazyListBuffer(data->lazy, SchemaBuffer, 101, 10, 5);
+
+    PARCBuffer *expected = _lazyExpected(10, 5);
+    PARCBuffer *test = ccnxTlvDictionary_ListGetByType(data->lazy, SchemaBuffer, 101);
+    assertTrue(parcBuffer_Equals(expected, test), "Wrong lazy list value by type");
+    parcBuffer_Release(&expected);
+
+    // list entries are inserted at the head
+    uint32_t key;
+    expected = _lazyExpected(0, 3);
+    ccnxTlvDictionary_ListGetByPosition(data->lazy, SchemaBuffer, 1, &test, &key);
+    assertTrue(key == 100, "Wrong key, expected 100 got %u", key);
+    assertTrue(parcBuffer_Equals(expected, test), "Wrong lazy list value by position");
+    parcBuffer_Release(&expected);
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_Equals_LazyEager)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+    ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 2, 8);
+    ccnxTlvDictionary_PutLazyListBuffer(data->lazy, SchemaIoVec, 100, 12, 4);
+
+    PARCBuffer *value = _lazyExpected(2, 8);
+    ccnxTlvDictionary_PutBuffer(data->eager, SchemaBuffer, value);
+    parcBuffer_Release(&value);
+    value = _lazyExpected(12, 4);
+    ccnxTlvDictionary_PutListBuffer(data->eager, SchemaIoVec, 100, value);
+    parcBuffer_Release(&value);
+
+    assertTrue(ccnxTlvDictionary_Equals(data->lazy, data->eager), "Lazy dictionary should equal its eager counterpart");
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_ShallowCopy_Lazy)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+    ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 2, 8);
+    ccnxTlvDictionary_PutLazyListBuffer(data->lazy, SchemaIoVec, 100, 12, 4);
+
+    CCNxTlvDictionary *copy = ccnxTlvDictionary_ShallowCopy(data->lazy);
+    assertTrue(ccnxTlvDictionary_Equals(data->lazy, copy), "Shallow copy should equal the lazy original");
+    ccnxTlvDictionary_Release(&copy);
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_Clone_Lazy)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+    ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 2, 8);
+    ccnxTlvDictionary_PutLazyListBuffer(data->lazy, SchemaIoVec, 100, 12, 4);
+
+    CCNxTlvDictionary *clone = ccnxTlvDictionary_Clone(data->lazy);
+    assertTrue(clone->directArray[SchemaBuffer].entryType == ENTRY_LAZY, "The clone should not resolve lazy entries");
+    assertTrue(ccnxTlvDictionary_IsLazy(clone), "The clone should have a lazy source");
+
+    PARCBuffer *expected = _lazyExpected(2, 8);
+    assertTrue(parcBuffer_Equals(expected, ccnxTlvDictionary_GetBuffer(clone, SchemaBuffer)), "Wrong lazy value in clone");
+    parcBuffer_Release(&expected);
+
+    assertTrue(ccnxTlvDictionary_Equals(data->lazy, clone), "Clone should equal the lazy original");
+    ccnxTlvDictionary_Release(&clone);
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_Clone_AfterGetBuffer)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+    ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 2, 4);
+    ccnxTlvDictionary_PutLazyListBuffer(data->lazy, SchemaIoVec, 100, 12, 8);
+
+    // resolve a short entry first, the clone must still reach the rest of the wire format
+    ccnxTlvDictionary_GetBuffer(data->lazy, SchemaBuffer);
+    CCNxTlvDictionary *clone = ccnxTlvDictionary_Clone(data->lazy);
+
+    PARCBuffer *expected = _lazyExpected(12, 8);
+    assertTrue(parcBuffer_Equals(expected, ccnxTlvDictionary_ListGetByType(clone, SchemaIoVec, 100)),
+               "Wrong lazy list value in a clone made after a lazy read");
+    parcBuffer_Release(&expected);
+
+    assertTrue(ccnxTlvDictionary_Equals(data->lazy, clone), "Clone should equal the lazy original");
+    ccnxTlvDictionary_Release(&clone);
+}
+
+static void *
+_lazyReader(void *arg)
+{
+    CCNxTlvDictionary *dictionary = arg;
+    PARCBuffer *expected = _lazyExpected(2, 8);
+    PARCBuffer *listExpected = _lazyExpected(12, 4);
+    bool same = parcBuffer_Equals(expected, ccnxTlvDictionary_GetBuffer(dictionary, SchemaBuffer))
+                && parcBuffer_Equals(listExpected, ccnxTlvDictionary_ListGetByType(dictionary, SchemaIoVec, 100));
+    parcBuffer_Release(&listExpected);
+    parcBuffer_Release(&expected);
+    return same ? dictionary : NULL;
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxTlvDictionary_GetBuffer_Lazy_Threads)
+{
+    LazyData *data = longBowTestCase_GetClipBoardData(testCase);
+    ccnxTlvDictionary_SetLazySource(data->lazy, data->wireFormat);
+    ccnxTlvDictionary_PutLazyBuffer(data->lazy, SchemaBuffer, 2, 8);
+    ccnxTlvDictionary_PutLazyListBuffer(data->lazy, SchemaIoVec, 100, 12, 4);
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, _lazyReader, data->lazy);
+    }
+    for (int i = 0; i < 4; i++) {
+        void *result;
+        pthread_join(threads[i], &result);
+        assertTrue(result == data->lazy, "Reader %d got the wrong lazy values", i);
+    }
+
+    assertTrue(parcBuffer_Position(data->lazy->lazySource) == 0 && parcBuffer_Remaining(data->lazy->lazySource) == sizeof(_lazyWireFormat) - 1,
+               "Resolving lazy entries should not move the lazy source");
+}
+
+// =============================================================
+
+LONGBOW_TEST_FIXTURE(Pool)
+{
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_GetThreadPoolCapacity_Default);
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_SetThreadPoolCapacity);
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_Release_Reuse);
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_Release_Reuse_Empty);
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_Release_Shared);
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_Release_Capacity);
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_Create_OtherShape);
+    LONGBOW_RUN_TEST_CASE(Pool, ccnxTlvDictionary_Create_Disabled);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Pool)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Pool)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(0);
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_GetThreadPoolCapacity_Default)
+{
+    assertTrue(ccnxTlvDictionary_GetThreadPoolCapacity() == 0,
+               "Expected no pool by default, got capacity %zu", ccnxTlvDictionary_GetThreadPoolCapacity());
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_SetThreadPoolCapacity)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(8);
+    assertTrue(ccnxTlvDictionary_GetThreadPoolCapacity() == 8,
+               "Wrong capacity, got %zu expected 8", ccnxTlvDictionary_GetThreadPoolCapacity());
+    ccnxTlvDictionary_SetThreadPoolCapacity(0);
+    assertTrue(ccnxTlvDictionary_GetThreadPoolCapacity() == 0,
+               "Wrong capacity, got %zu expected 0", ccnxTlvDictionary_GetThreadPoolCapacity());
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_Release_Reuse)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(4);
+
+    CCNxTlvDictionary *first = ccnxTlvDictionary_Create(10, 20);
+    CCNxTlvDictionary *expected = first;
+    ccnxTlvDictionary_Release(&first);
+    assertNull(first, "Release should null the pointer even when the dictionary is pooled");
+
+    CCNxTlvDictionary *second = ccnxTlvDictionary_Create(10, 20);
+    assertTrue(second == expected, "Expected the pooled dictionary %p, got %p", (void *) expected, (void *) second);
+    assertTrue(parcObject_GetReferenceCount(second) == 1,
+               "Wrong ref count, got %" PRIu64 " expected 1", parcObject_GetReferenceCount(second));
+    ccnxTlvDictionary_Release(&second);
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_Release_Reuse_Empty)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(4);
+
+    TestData *data = _commonSetup();
+    ccnxTlvDictionary_SetMessageType_ContentObject(data->dictionary, CCNxTlvDictionary_SchemaVersion_V1);
+    PARCBuffer *buffer = parcBuffer_Allocate(3);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, SchemaEnd + 1, 1000, buffer);
+    parcBuffer_Release(&buffer);
+    _commonTeardown(data);
+
+    CCNxTlvDictionary *reused = ccnxTlvDictionary_Create(SchemaEnd + 2, SchemaEnd + 10);
+    CCNxTlvDictionary *empty = ccnxTlvDictionary_Create(SchemaEnd + 2, SchemaEnd + 10);
+    assertTrue(ccnxTlvDictionary_Equals(reused, empty), "Pooled dictionary should be empty");
+    assertFalse(ccnxTlvDictionary_IsContentObject(reused), "Pooled dictionary should have no message type");
+    ccnxTlvDictionary_Release(&empty);
+    ccnxTlvDictionary_Release(&reused);
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_Release_Shared)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(4);
+
+    CCNxTlvDictionary *first = ccnxTlvDictionary_Create(10, 20);
+    ccnxTlvDictionary_PutInteger(first, 1, 42);
+    CCNxTlvDictionary *second = ccnxTlvDictionary_Acquire(first);
+    ccnxTlvDictionary_Release(&first);
+
+    assertTrue(ccnxTlvDictionary_GetInteger(second, 1) == 42, "A shared dictionary must not be reset by release");
+
+    CCNxTlvDictionary *other = ccnxTlvDictionary_Create(10, 20);
+    assertTrue(other != second, "A shared dictionary must not be pooled");
+    ccnxTlvDictionary_Release(&other);
+    ccnxTlvDictionary_Release(&second);
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_Release_Capacity)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(2);
+
+    CCNxTlvDictionary *dictionaries[3];
+    for (int i = 0; i < 3; i++) {
+        dictionaries[i] = ccnxTlvDictionary_Create(10, 20);
+    }
+    for (int i = 0; i < 3; i++) {
+        ccnxTlvDictionary_Release(&dictionaries[i]);
+    }
+
+    _CCNxTlvDictionaryPool *pool = _ccnxTlvDictionaryPool_Get();
+    assertNotNull(pool, "Expected a pool for this thread");
+    size_t pooled = 0;
+    for (int i = 0; i < _CCNxTlvDictionaryPool_Shapes; i++) {
+        pooled += pool->shapes[i].count;
+    }
+    assertTrue(pooled == 2, "Wrong pooled count, got %zu expected 2", pooled);
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_Create_OtherShape)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(4);
+
+    CCNxTlvDictionary *first = ccnxTlvDictionary_Create(10, 20);
+    CCNxTlvDictionary *pooled = first;
+    ccnxTlvDictionary_Release(&first);
+
+    CCNxTlvDictionary *second = ccnxTlvDictionary_Create(11, 20);
+    assertTrue(second != pooled, "A dictionary of another size must not come from the pool");
+    assertTrue(second->fastArraySize == 11, "Wrong fast array size, got %zu expected 11", second->fastArraySize);
+    ccnxTlvDictionary_Release(&second);
+}
+
+LONGBOW_TEST_CASE(Pool, ccnxTlvDictionary_Create_Disabled)
+{
+    ccnxTlvDictionary_SetThreadPoolCapacity(4);
+    CCNxTlvDictionary *first = ccnxTlvDictionary_Create(10, 20);
+    ccnxTlvDictionary_Release(&first);
+    ccnxTlvDictionary_SetThreadPoolCapacity(0);
+
+    assertTrue(parcMemory_Outstanding() == 0,
+               "Disabling the pool should free pooled dictionaries, %u outstanding", parcMemory_Outstanding());
+}
+
+// =============================================================
+
 int
 main(int argc, char *argv[])
 {
@@ -128,6 +128,8 @@ LONGBOW_TEST_FIXTURE(SchemaV1)
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_FromInterestPacketTypeIoVec);
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_GetIoVec);
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetHopLimit);
+    LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetHopLimit_Clone_Buffer);
+    LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetHopLimit_Clone_IoVec);
 
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetProtectedRegionStart);
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetProtectedRegionLength);
@@ -306,6 +308,77 @@ LONGBOW_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetHopLimit)
     parcBuffer_Release(&buffer);
 }
 
+/*
+ * Each clone gets its own hop limit, the original packet memory is not written
+ */
+LONGBOW_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetHopLimit_Clone_Buffer)
+{
+    uint8_t packetCopy[sizeof(v1_content_nameA_crc32c)];
+    memcpy(packetCopy, v1_content_nameA_crc32c, sizeof(packetCopy));
+    PARCBuffer *wireFormat = parcBuffer_Wrap(packetCopy, sizeof(packetCopy), 0, sizeof(packetCopy));
+    CCNxTlvDictionary *packet = _ccnxWireFormatFacadeV1_CreateFromV1(wireFormat);
+
+    CCNxTlvDictionary *clones[3];
+    for (int i = 0; i < 3; i++) {
+        clones[i] = ccnxWireFormatMessage_Clone(packet);
+        _ccnxWireFormatFacadeV1_SetHopLimit(clones[i], 10 + i);
+    }
+
+    assertTrue(memcmp(packetCopy, v1_content_nameA_crc32c, sizeof(packetCopy)) == 0, "Setting a clone hop limit changed the shared packet");
+    assertTrue(_ccnxWireFormatFacadeV1_GetWireFormatBuffer(packet) == wireFormat, "The original should keep its wire format buffer");
+
+    for (int i = 0; i < 3; i++) {
+        CCNxCodecNetworkBufferIoVec *vec = _ccnxWireFormatFacadeV1_GetIoVec(clones[i]);
+        assertNotNull(vec, "A clone with its own headers should have an io vector");
+        assertTrue(ccnxCodecNetworkBufferIoVec_Length(vec) == sizeof(packetCopy),
+                   "Wrong length, expected %zu got %zu", sizeof(packetCopy), ccnxCodecNetworkBufferIoVec_Length(vec));
+
+        const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+        const CCNxCodecSchemaV1FixedHeader *header = iov[0].iov_base;
+        assertTrue(iov[0].iov_len == header->headerLength,
+                   "Only the headers should be copied, expected %u got %zu", header->headerLength, iov[0].iov_len);
+        assertTrue(((CCNxCodecSchemaV1InterestHeader *) iov[0].iov_base)->hopLimit == 10 + i, "Wrong hop limit for clone %d", i);
+        assertTrue(iov[1].iov_base == packetCopy + header->headerLength, "The rest of the packet should be shared");
+    }
+
+    for (int i = 0; i < 3; i++) {
+        ccnxTlvDictionary_Release(&clones[i]);
+    }
+    ccnxTlvDictionary_Release(&packet);
+    parcBuffer_Release(&wireFormat);
+}
+
+LONGBOW_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetHopLimit_Clone_IoVec)
+{
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+    ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(v1_content_nameA_crc32c), v1_content_nameA_crc32c);
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+
+    CCNxTlvDictionary *packet = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    _ccnxWireFormatFacadeV1_PutIoVec(packet, iovec);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+
+    CCNxTlvDictionary *clone = ccnxWireFormatMessage_Clone(packet);
+    _ccnxWireFormatFacadeV1_SetHopLimit(clone, 7);
+
+    CCNxCodecNetworkBufferIoVec *original = _ccnxWireFormatFacadeV1_GetIoVec(packet);
+    CCNxCodecNetworkBufferIoVec *copy = _ccnxWireFormatFacadeV1_GetIoVec(clone);
+    assertTrue(original != copy, "The clone should have its own io vector");
+    uint8_t originalHopLimit = ((CCNxCodecSchemaV1InterestHeader *) ccnxCodecNetworkBufferIoVec_GetArray(original)[0].iov_base)->hopLimit;
+    uint8_t expectedHopLimit = ((CCNxCodecSchemaV1InterestHeader *) v1_content_nameA_crc32c)->hopLimit;
+    assertTrue(originalHopLimit == expectedHopLimit, "Original hop limit changed, expected %u got %u", expectedHopLimit, originalHopLimit);
+    assertTrue(((CCNxCodecSchemaV1InterestHeader *) ccnxCodecNetworkBufferIoVec_GetArray(copy)[0].iov_base)->hopLimit == 7,
+               "Wrong clone hop limit");
+
+    // Once the original is the only holder of its io vector, it is written in place
+    ccnxTlvDictionary_Release(&clone);
+    _ccnxWireFormatFacadeV1_SetHopLimit(packet, 3);
+    assertTrue(_ccnxWireFormatFacadeV1_GetIoVec(packet) == original, "An unshared io vector should be written in place");
+
+    ccnxTlvDictionary_Release(&packet);
+}
+
 LONGBOW_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_SetProtectedRegionStart)
 {
     const char string[] = "Hello dev null\n";
@@ -0,0 +1,753 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnx_ChunkingPipeline.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include <openssl/x509.h>
+
+#include <parc/security/parc_PublicKeySignerPkcs12Store.h>
+
+#include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
+#include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+#include <ccnx/common/validation/ccnxValidation_Pipeline.h>
+
+#define _maxChunks 512
+
+/*
+ * Keeps every chunk the pipeline emits, in order
+ */
+typedef struct collected {
+    CCNxContentObject *objects[_maxChunks];
+    uint8_t digests[_maxChunks][CCNxChunkingPipeline_DigestLength];
+    size_t count;
+} _Collected;
+
+static void
+_collect(void *context, uint64_t chunk, CCNxContentObject *chunkObject, const uint8_t *digest)
+{
+    _Collected *collected = context;
+    assertTrue(collected->count < _maxChunks, "Too many chunks emitted");
+    assertTrue(chunk == collected->count, "Chunk %" PRIu64 " emitted out of order, expected %zu", chunk, collected->count);
+
+    collected->objects[collected->count] = ccnxContentObject_Acquire(chunkObject);
+    memcpy(collected->digests[collected->count], digest, CCNxChunkingPipeline_DigestLength);
+    collected->count++;
+}
+
+static void
+_discard(void *context, uint64_t chunk, CCNxContentObject *chunkObject, const uint8_t *digest)
+{
+}
+
+static void
+_releaseCollected(_Collected *collected)
+{
+    for (size_t i = 0; i < collected->count; i++) {
+        ccnxContentObject_Release(&collected->objects[i]);
+    }
+    collected->count = 0;
+}
+
+/*
+ * Copies the attached wire format of an emitted chunk and decodes it the way a receiver would
+ */
+static CCNxWireFormatMessage *
+_decodeChunk(CCNxContentObject *object)
+{
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxWireFormatMessage_GetIoVec(object);
+    assertNotNull(iovec, "Emitted chunk has no wire format");
+
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    PARCBuffer *packet = parcBuffer_Allocate(ccnxCodecNetworkBufferIoVec_Length(iovec));
+    for (int i = 0; i < ccnxCodecNetworkBufferIoVec_GetCount(iovec); i++) {
+        parcBuffer_PutArray(packet, array[i].iov_len, array[i].iov_base);
+    }
+    parcBuffer_Flip(packet);
+
+    CCNxWireFormatMessage *message = ccnxWireFormatMessage_Create(packet);
+    bool success = ccnxCodecTlvPacket_BufferDecode(packet, ccnxWireFormatMessage_GetDictionary(message));
+    assertTrue(success, "Could not decode an emitted chunk");
+    parcBuffer_Release(&packet);
+    return message;
+}
+
+/*
+ * Checks the emitted chunks carry `length` bytes of `data` in order, with the right names, the
+ * EndChunkNumber on the last chunk only, and the ContentObjectHash a receiver computes.
+ */
+static void
+_assertChunks(_Collected *collected, const CCNxName *baseName, const uint8_t *data, size_t length, size_t chunkSize)
+{
+    size_t expectedCount = (length == 0) ? 1 : (length + chunkSize - 1) / chunkSize;
+    assertTrue(collected->count == expectedCount, "Expected %zu chunks, got %zu", expectedCount, collected->count);
+
+    for (size_t i = 0; i < collected->count; i++) {
+        CCNxWireFormatMessage *message = _decodeChunk(collected->objects[i]);
+        CCNxContentObject *decoded = ccnxWireFormatMessage_GetDictionary(message);
+
+        CCNxName *expectedName = _ccnxChunkingPipeline_CreateChunkName(baseName, i);
+        assertTrue(ccnxName_Equals(expectedName, ccnxContentObject_GetName(decoded)), "Chunk %zu has the wrong name", i);
+        ccnxName_Release(&expectedName);
+
+        size_t offset = i * chunkSize;
+        size_t expectedLength = (length - offset > chunkSize) ? chunkSize : length - offset;
+        PARCBuffer *payload = ccnxContentObject_GetPayload(decoded);
+        size_t payloadLength = (payload == NULL) ? 0 : parcBuffer_Remaining(payload);
+        assertTrue(payloadLength == expectedLength, "Chunk %zu expected %zu bytes, got %zu", i, expectedLength, payloadLength);
+        if (expectedLength > 0) {
+            assertTrue(memcmp(parcBuffer_Overlay(payload, 0), &data[offset], expectedLength) == 0, "Chunk %zu has the wrong payload", i);
+        }
+
+        bool isLast = (i + 1 == collected->count);
+        assertTrue(ccnxContentObject_HasFinalChunkNumber(decoded) == isLast, "Chunk %zu EndChunkNumber presence wrong", i);
+        if (isLast) {
+            assertTrue(ccnxContentObject_GetFinalChunkNumber(decoded) == i, "Wrong EndChunkNumber %" PRIu64, ccnxContentObject_GetFinalChunkNumber(decoded));
+        }
+
+        PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(message);
+        assertNotNull(hash, "Could not hash chunk %zu", i);
+        assertTrue(memcmp(parcBuffer_Overlay(parcCryptoHash_GetDigest(hash), 0), collected->digests[i], CCNxChunkingPipeline_DigestLength) == 0,
+                   "Chunk %zu has the wrong digest", i);
+        parcCryptoHash_Release(&hash);
+
+        ccnxWireFormatMessage_Release(&message);
+    }
+}
+
+static uint8_t *
+_createData(size_t length)
+{
+    uint8_t *data = parcMemory_Allocate(length + 1);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = (uint8_t) (i * 7 + i / 251);
+    }
+    return data;
+}
+
+/*
+ * Writes `length` bytes to an unlinked temporary file and returns it open at the start
+ */
+static int
+_createFile(const uint8_t *data, size_t length)
+{
+    char template[] = "/tmp/test_ccnx_ChunkingPipeline.XXXXXX";
+    int fd = mkstemp(template);
+    assertTrue(fd >= 0, "mkstemp failed: %s", strerror(errno));
+    unlink(template);
+
+    ssize_t nwritten = write(fd, data, length);
+    assertTrue(nwritten == (ssize_t) length, "Short write %zd", nwritten);
+    lseek(fd, 0, SEEK_SET);
+    return fd;
+}
+
+typedef struct test_data {
+    CCNxName *baseName;
+    _Collected collected;
+} TestData;
+
+LONGBOW_TEST_RUNNER(ccnx_ChunkingPipeline)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnx_ChunkingPipeline)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_ChunkingPipeline)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_ManyBatches);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_ExactBatch);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_Position);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceRegion);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_ExactBatch);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_Pipe);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_BadDescriptor);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_Signed_Crc32c);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_Signed_Hmac);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxChunkingPipeline_Signed_Rsa);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+    data->baseName = ccnxName_CreateFromURI("lci:/foo/bar/object");
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    _releaseCollected(&data->collected);
+    ccnxName_Release(&data->baseName);
+    parcMemory_Deallocate((void **) &data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_Create)
+{
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(1000, NULL, 3);
+    assertNotNull(pipeline, "Got null pipeline");
+    assertTrue(ccnxChunkingPipeline_GetChunkSize(pipeline) == 1000, "Wrong chunk size %zu", ccnxChunkingPipeline_GetChunkSize(pipeline));
+    assertTrue(ccnxChunkingPipeline_GetWorkerCount(pipeline) == 3, "Wrong worker count %zu", ccnxChunkingPipeline_GetWorkerCount(pipeline));
+
+    ccnxChunkingPipeline_Release(&pipeline);
+    assertNull(pipeline, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_Acquire)
+{
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(1000, NULL, 0);
+
+    CCNxChunkingPipeline *copy = ccnxChunkingPipeline_Acquire(pipeline);
+    assertTrue(copy == pipeline, "Acquire should return the same pipeline");
+
+    ccnxChunkingPipeline_Release(&copy);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 2);
+
+    // 10 full chunks and a partial one
+    size_t length = 1050;
+    uint8_t *bytes = _createData(length);
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, length, 0, length);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 100);
+
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_ManyBatches)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // 1 worker makes batches of 2 * _chunksPerThread chunks
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(50, NULL, 1);
+    size_t length = 50 * (4 * _chunksPerThread + 3) + 7;
+    uint8_t *bytes = _createData(length);
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, length, 0, length);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 50);
+
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+/*
+ * An object that ends exactly on a batch boundary gets its EndChunkNumber in the last full batch
+ */
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_ExactBatch)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(10, NULL, 0);
+    size_t length = 10 * 2 * _chunksPerThread;
+    uint8_t *bytes = _createData(length);
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, length, 0, length);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 10);
+
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_Empty)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 2);
+    PARCBuffer *buffer = parcBuffer_Allocate(0);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, NULL, 0, 100);
+
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceBuffer_Position)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 1);
+    size_t length = 500;
+    uint8_t *bytes = _createData(length);
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, length, 30, 430);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, &bytes[30], 400, 100);
+    assertTrue(parcBuffer_Position(buffer) == 30, "Position changed to %zu", parcBuffer_Position(buffer));
+    assertTrue(parcBuffer_Limit(buffer) == 430, "Limit changed to %zu", parcBuffer_Limit(buffer));
+
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceRegion)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(64, NULL, 2);
+    size_t length = 64 * 70 + 1;
+    uint8_t *bytes = _createData(length);
+
+    bool success = ccnxChunkingPipeline_ProduceRegion(pipeline, data->baseName, length, bytes, _collect, &data->collected);
+    assertTrue(success, "ProduceRegion failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 64);
+    _releaseCollected(&data->collected);
+
+    success = ccnxChunkingPipeline_ProduceRegion(pipeline, data->baseName, 0, NULL, _collect, &data->collected);
+    assertTrue(success, "ProduceRegion of an empty region failed");
+    _assertChunks(&data->collected, data->baseName, NULL, 0, 64);
+
+    _releaseCollected(&data->collected);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 3);
+    size_t length = 100 * 150 + 42;
+    uint8_t *bytes = _createData(length);
+    int fd = _createFile(bytes, length);
+
+    bool success = ccnxChunkingPipeline_ProduceFile(pipeline, data->baseName, fd, _collect, &data->collected);
+    assertTrue(success, "ProduceFile failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 100);
+
+    close(fd);
+    _releaseCollected(&data->collected);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+/*
+ * A file that ends on a batch boundary is only known to end after reading ahead
+ */
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_ExactBatch)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 1);
+    size_t length = 100 * 2 * _chunksPerThread * 3;
+    uint8_t *bytes = _createData(length);
+    int fd = _createFile(bytes, length);
+
+    bool success = ccnxChunkingPipeline_ProduceFile(pipeline, data->baseName, fd, _collect, &data->collected);
+    assertTrue(success, "ProduceFile failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 100);
+
+    close(fd);
+    _releaseCollected(&data->collected);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_Empty)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 1);
+    int fd = _createFile(NULL, 0);
+
+    bool success = ccnxChunkingPipeline_ProduceFile(pipeline, data->baseName, fd, _collect, &data->collected);
+    assertTrue(success, "ProduceFile failed");
+    _assertChunks(&data->collected, data->baseName, NULL, 0, 100);
+
+    close(fd);
+    _releaseCollected(&data->collected);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_Pipe)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 2);
+
+    // Small enough to fit in the pipe without a reader
+    size_t length = 4000;
+    uint8_t *bytes = _createData(length);
+    int fds[2];
+    assertTrue(pipe(fds) == 0, "pipe failed: %s", strerror(errno));
+    ssize_t nwritten = write(fds[1], bytes, length);
+    assertTrue(nwritten == (ssize_t) length, "Short write %zd", nwritten);
+    close(fds[1]);
+
+    bool success = ccnxChunkingPipeline_ProduceFile(pipeline, data->baseName, fds[0], _collect, &data->collected);
+    assertTrue(success, "ProduceFile failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 100);
+
+    close(fds[0]);
+    _releaseCollected(&data->collected);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_ProduceFile_BadDescriptor)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, NULL, 1);
+
+    bool success = ccnxChunkingPipeline_ProduceFile(pipeline, data->baseName, -1, _collect, &data->collected);
+    assertFalse(success, "ProduceFile should fail on a bad descriptor");
+    assertTrue(data->collected.count == 0, "Expected no chunks, got %zu", data->collected.count);
+
+    ccnxChunkingPipeline_Release(&pipeline);
+}
+
+/*
+ * The CRC32C signer is not keyed, so every thread signs through its own hasher
+ */
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_Signed_Crc32c)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, signer, 3);
+
+    size_t length = 100 * 200 + 1;
+    uint8_t *bytes = _createData(length);
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, length, 0, length);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 100);
+
+    CCNxTlvDictionary *messages[_maxChunks];
+    bool results[_maxChunks];
+    for (size_t i = 0; i < data->collected.count; i++) {
+        messages[i] = _decodeChunk(data->collected.objects[i]);
+    }
+
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+    CCNxValidationPipeline *validation = ccnxValidationPipeline_Create(verifier, 0);
+    size_t valid = ccnxValidationPipeline_Verify(validation, data->collected.count, messages, results);
+    assertTrue(valid == data->collected.count, "Expected %zu valid chunks, got %zu", data->collected.count, valid);
+
+    for (size_t i = 0; i < data->collected.count; i++) {
+        ccnxTlvDictionary_Release(&messages[i]);
+    }
+    ccnxValidationPipeline_Release(&validation);
+    parcVerifier_Destroy(&verifier);
+
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+    parcSigner_Release(&signer);
+}
+
+/*
+ * An HMAC signer's hasher holds its key, so the threads take turns signing with it
+ */
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_Signed_Hmac)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *secretKey = parcBuffer_WrapCString("chunking pipeline secret key");
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(secretKey);
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, signer, 3);
+    assertNull(pipeline->threadSigner, "A keyed signer should not get thread signers");
+
+    size_t length = 100 * 100 + 1;
+    uint8_t *bytes = _createData(length);
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, length, 0, length);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 100);
+
+    for (size_t i = 0; i < data->collected.count; i++) {
+        CCNxWireFormatMessage *message = _decodeChunk(data->collected.objects[i]);
+        CCNxTlvDictionary *dictionary = ccnxWireFormatMessage_GetDictionary(message);
+
+        size_t start = ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedStart);
+        size_t protectedLength = ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedLength);
+        PARCBuffer *wireFormat = ccnxWireFormatMessage_GetWireFormatBuffer(message);
+
+        uint8_t mac[SHA256_DIGEST_LENGTH];
+        unsigned macLength;
+        HMAC(EVP_sha256(), parcBuffer_Overlay(secretKey, 0), (int) parcBuffer_Remaining(secretKey),
+             (uint8_t *) parcBuffer_Overlay(wireFormat, 0) + start, protectedLength, mac, &macLength);
+
+        PARCBuffer *payload = ccnxValidationFacadeV1_GetPayload(dictionary);
+        assertNotNull(payload, "Chunk %zu has no signature", i);
+        assertTrue(parcBuffer_Remaining(payload) == macLength && memcmp(parcBuffer_Overlay(payload, 0), mac, macLength) == 0,
+                   "Chunk %zu has the wrong HMAC", i);
+
+        ccnxWireFormatMessage_Release(&message);
+    }
+
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&secretKey);
+}
+
+/*
+ * An RSA signer is not keyed, so every thread signs through its own hasher.  The validation
+ * encoder asks the thread signer for the public key to size the signature.
+ */
+LONGBOW_TEST_CASE(Global, ccnxChunkingPipeline_Signed_Rsa)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    const char *keystore = "test_ccnx_ChunkingPipeline.p12";
+    bool created = parcPublicKeySignerPkcs12Store_CreateFile(keystore, "blueberry", "ccnxuser", 1024, 365);
+    assertTrue(created, "parcPublicKeySignerPkcs12Store_CreateFile() failed");
+    PARCSigner *signer = parcSigner_Create(parcPublicKeySignerPkcs12Store_Open(keystore, "blueberry", PARC_HASH_SHA256));
+    unlink(keystore);
+
+    CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(100, signer, 3);
+    assertNotNull(pipeline->threadSigner, "An RSA signer should get thread signers");
+
+    size_t length = 100 * 50 + 1;
+    uint8_t *bytes = _createData(length);
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, length, 0, length);
+
+    bool success = ccnxChunkingPipeline_ProduceBuffer(pipeline, data->baseName, buffer, _collect, &data->collected);
+    assertTrue(success, "ProduceBuffer failed");
+    _assertChunks(&data->collected, data->baseName, bytes, length, 100);
+
+    PARCBuffer *derPublicKey = parcSigner_GetDEREncodedPublicKey(signer);
+    const uint8_t *der = parcBuffer_Overlay(derPublicKey, 0);
+    EVP_PKEY *publicKey = d2i_PUBKEY(NULL, &der, (long) parcBuffer_Remaining(derPublicKey));
+    assertNotNull(publicKey, "Could not decode the signer's public key");
+
+    for (size_t i = 0; i < data->collected.count; i++) {
+        CCNxWireFormatMessage *message = _decodeChunk(data->collected.objects[i]);
+        CCNxTlvDictionary *dictionary = ccnxWireFormatMessage_GetDictionary(message);
+
+        size_t start = ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedStart);
+        size_t protectedLength = ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedLength);
+        PARCBuffer *wireFormat = ccnxWireFormatMessage_GetWireFormatBuffer(message);
+
+        PARCBuffer *payload = ccnxValidationFacadeV1_GetPayload(dictionary);
+        assertNotNull(payload, "Chunk %zu has no signature", i);
+        assertTrue(parcBuffer_Remaining(payload) == (size_t) EVP_PKEY_size(publicKey),
+                   "Chunk %zu has a %zu byte signature, expected %d", i, parcBuffer_Remaining(payload), EVP_PKEY_size(publicKey));
+
+        EVP_MD_CTX *context = EVP_MD_CTX_new();
+        EVP_DigestVerifyInit(context, NULL, EVP_sha256(), NULL, publicKey);
+        int verified = EVP_DigestVerify(context, parcBuffer_Overlay(payload, 0), parcBuffer_Remaining(payload),
+                                        (uint8_t *) parcBuffer_Overlay(wireFormat, 0) + start, protectedLength);
+        EVP_MD_CTX_free(context);
+        assertTrue(verified == 1, "Chunk %zu has the wrong RSA signature", i);
+
+        ccnxWireFormatMessage_Release(&message);
+    }
+
+    EVP_PKEY_free(publicKey);
+    parcBuffer_Release(&derPublicKey);
+    _releaseCollected(&data->collected);
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate((void **) &bytes);
+    ccnxChunkingPipeline_Release(&pipeline);
+    parcSigner_Release(&signer);
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxChunkingPipeline_CreateThreadSigner);
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxChunkingPipeline_CreateThreadSigner_Keyed);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Local, _ccnxChunkingPipeline_CreateThreadSigner)
+{
+    assertNull(_ccnxChunkingPipeline_CreateThreadSigner(NULL), "A NULL signer should have no thread signer");
+
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+    PARCSigner *threadSigner = _ccnxChunkingPipeline_CreateThreadSigner(signer);
+    assertNotNull(threadSigner, "Expected a thread signer");
+
+    assertTrue(parcSigner_GetSigningAlgorithm(threadSigner) == parcSigner_GetSigningAlgorithm(signer), "Wrong signing algorithm");
+    assertTrue(parcSigner_GetCryptoHashType(threadSigner) == parcSigner_GetCryptoHashType(signer), "Wrong hash type");
+    assertTrue(parcSigner_GetCryptoHasher(threadSigner) != parcSigner_GetCryptoHasher(signer), "The thread signer must not share the hasher");
+
+    // Signing the same digest through either gives the same signature
+    PARCCryptoHasher *hasher = parcSigner_GetCryptoHasher(threadSigner);
+    parcCryptoHasher_Init(hasher);
+    parcCryptoHasher_UpdateBytes(hasher, (const uint8_t *) "hello", 5);
+    PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
+
+    PARCSignature *truth = parcSigner_SignDigest(signer, hash);
+    PARCSignature *test = parcSigner_SignDigest(threadSigner, hash);
+    assertTrue(parcBuffer_Equals(parcSignature_GetSignature(truth), parcSignature_GetSignature(test)), "Signatures differ");
+
+    parcSignature_Release(&test);
+    parcSignature_Release(&truth);
+    parcCryptoHash_Release(&hash);
+    parcSigner_Release(&threadSigner);
+    parcSigner_Release(&signer);
+}
+
+LONGBOW_TEST_CASE(Local, _ccnxChunkingPipeline_CreateThreadSigner_Keyed)
+{
+    PARCBuffer *secretKey = parcBuffer_WrapCString("chunking pipeline secret key");
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(secretKey);
+
+    assertNull(_ccnxChunkingPipeline_CreateThreadSigner(signer), "A keyed signer should have no thread signer");
+
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&secretKey);
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxChunkingPipeline_ProduceBuffer_Workers);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Chunks 64 MB in 4 KB chunks, signed with CRC32C, with 0 and 3 workers
+ */
+LONGBOW_TEST_CASE(Performance, ccnxChunkingPipeline_ProduceBuffer_Workers)
+{
+    CCNxName *baseName = ccnxName_CreateFromURI("lci:/foo/bar/object");
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+
+    size_t length = 64 * 1024 * 1024;
+    PARCBuffer *buffer = parcBuffer_Allocate(length);
+
+    size_t workerCounts[] = { 0, 3 };
+    for (size_t w = 0; w < sizeof(workerCounts) / sizeof(workerCounts[0]); w++) {
+        CCNxChunkingPipeline *pipeline = ccnxChunkingPipeline_Create(4096, signer, workerCounts[w]);
+
+        struct timeval t0, t1;
+        gettimeofday(&t0, NULL);
+        ccnxChunkingPipeline_ProduceBuffer(pipeline, baseName, buffer, _discard, NULL);
+        gettimeofday(&t1, NULL);
+
+        timersub(&t1, &t0, &t1);
+        printf("%zu workers: %zu bytes, %.6f sec\n", workerCounts[w], length, t1.tv_sec + t1.tv_usec * 1E-6);
+
+        ccnxChunkingPipeline_Release(&pipeline);
+    }
+
+    parcBuffer_Release(&buffer);
+    parcSigner_Release(&signer);
+    ccnxName_Release(&baseName);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_ChunkingPipeline);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,642 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnx_ManifestBuilder.c"
+
+#include <LongBow/unit-test.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <inttypes.h>
+#include <sys/time.h>
+
+#include <ccnx/common/ccnx_Manifest.h>
+
+#define _maxEmitted 512
+
+/*
+ * Keeps every manifest the builder emits, in order
+ */
+typedef struct emitted {
+    CCNxContentObject *objects[_maxEmitted];
+    bool isRoot[_maxEmitted];
+    size_t count;
+} _Emitted;
+
+static void
+_collect(void *context, CCNxContentObject *manifestObject, bool isRoot)
+{
+    _Emitted *emitted = context;
+    assertTrue(emitted->count < _maxEmitted, "Too many manifests emitted");
+    emitted->objects[emitted->count] = ccnxContentObject_Acquire(manifestObject);
+    emitted->isRoot[emitted->count] = isRoot;
+    emitted->count++;
+}
+
+static void
+_discard(void *context, CCNxContentObject *manifestObject, bool isRoot)
+{
+}
+
+typedef struct test_data {
+    CCNxName *manifestName;
+    CCNxName *dataName;
+    PARCBuffer *signatureBits;
+    PARCSignature *signature;
+    _Emitted emitted;
+} TestData;
+
+/*
+ * A unique digest for chunk `chunk`
+ */
+static void
+_fillDigest(uint64_t chunk, uint8_t *digest)
+{
+    memset(digest, (int) (chunk & 0xFF), CCNxManifestSection_DigestLength);
+    memcpy(digest, &chunk, sizeof(chunk));
+}
+
+/*
+ * The ContentObjectHash of an emitted manifest, computed the way a consumer would:
+ * decode the wire format and hash it with ccnxWireFormatMessage_CreateContentObjectHash()
+ */
+static void
+_contentObjectHash(CCNxContentObject *object, uint8_t *digest)
+{
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxWireFormatMessage_GetIoVec(object);
+    assertNotNull(iovec, "Emitted manifest has no wire format");
+
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    PARCBuffer *packet = parcBuffer_Allocate(ccnxCodecNetworkBufferIoVec_Length(iovec));
+    for (int i = 0; i < ccnxCodecNetworkBufferIoVec_GetCount(iovec); i++) {
+        parcBuffer_PutArray(packet, array[i].iov_len, array[i].iov_base);
+    }
+    parcBuffer_Flip(packet);
+
+    CCNxWireFormatMessage *message = ccnxWireFormatMessage_Create(packet);
+    bool success = ccnxCodecTlvPacket_BufferDecode(packet, ccnxWireFormatMessage_GetDictionary(message));
+    assertTrue(success, "Could not decode an emitted manifest");
+
+    PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(message);
+    assertNotNull(hash, "Could not hash an emitted manifest");
+    memcpy(digest, parcBuffer_Overlay(parcCryptoHash_GetDigest(hash), 0), CCNxManifestSection_DigestLength);
+
+    parcCryptoHash_Release(&hash);
+    ccnxWireFormatMessage_Release(&message);
+    parcBuffer_Release(&packet);
+}
+
+static CCNxManifest *
+_decodeManifest(TestData *data, CCNxContentObject *object)
+{
+    assertTrue(ccnxContentObject_GetPayloadType(object) == CCNxPayloadType_MANIFEST, "Emitted object is not a manifest");
+
+    PARCBuffer *payload = ccnxContentObject_GetPayload(object);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(payload);
+    CCNxManifest *manifest = ccnxCodecSchemaV1ManifestCodec_DecodeValue(decoder, (uint16_t) parcBuffer_Remaining(payload), data->signature);
+    assertNotNull(manifest, "Could not decode manifest: %s", ccnxCodecError_ToString(ccnxCodecTlvDecoder_GetError(decoder)));
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    return manifest;
+}
+
+/*
+ * Creates an encoded data chunk `dataName/CHUNK=chunk`
+ */
+static PARCBuffer *
+_createChunkPacket(const CCNxName *dataName, uint64_t chunk)
+{
+    CCNxName *name = _ccnxManifestBuilder_CreateNumberedName(dataName, CCNxNameLabelType_CHUNK, chunk);
+    PARCBuffer *payload = parcBuffer_Allocate(100);
+    parcBuffer_PutUint64(payload, chunk);
+    parcBuffer_Flip(payload);
+
+    CCNxContentObject *object = ccnxContentObject_CreateWithDataPayload(name, payload);
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncode(object, NULL);
+    assertNotNull(iovec, "Could not encode chunk %" PRIu64, chunk);
+
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    PARCBuffer *packet = parcBuffer_Allocate(ccnxCodecNetworkBufferIoVec_Length(iovec));
+    for (int i = 0; i < ccnxCodecNetworkBufferIoVec_GetCount(iovec); i++) {
+        parcBuffer_PutArray(packet, array[i].iov_len, array[i].iov_base);
+    }
+    parcBuffer_Flip(packet);
+
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    ccnxContentObject_Release(&object);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+    return packet;
+}
+
+/*
+ * Checks that the emitted manifests form one tree: the root is last and every other manifest's
+ * hash is in exactly one other manifest.  Each leaf digest must be chunk `i` of dataName for
+ * the digest from _fillDigest(i).
+ */
+static void
+_assertTree(TestData *data, uint64_t chunkCount)
+{
+    _Emitted *emitted = &data->emitted;
+    assertTrue(emitted->count > 0, "Nothing was emitted");
+
+    CCNxManifestSection *sections[_maxEmitted];
+    for (size_t i = 0; i < emitted->count; i++) {
+        assertTrue(emitted->isRoot[i] == (i == emitted->count - 1), "Only the last manifest may be the root, manifest %zu", i);
+
+        CCNxManifest *manifest = _decodeManifest(data, emitted->objects[i]);
+        sections[i] = ccnxManifestSection_Acquire(ccnxManifest_GetPayloadSection(manifest));
+        ccnxManifest_Release(&manifest);
+    }
+    assertTrue(ccnxName_Equals(data->manifestName, ccnxContentObject_GetName(emitted->objects[emitted->count - 1])), "Wrong root name");
+
+    for (size_t i = 0; i + 1 < emitted->count; i++) {
+        uint8_t digest[CCNxManifestSection_DigestLength];
+        _contentObjectHash(emitted->objects[i], digest);
+
+        size_t parents = 0;
+        for (size_t j = 0; j < emitted->count; j++) {
+            size_t hashIndex;
+            if (ccnxManifestSection_FindDigest(sections[j], digest, &hashIndex)) {
+                assertTrue(j > i, "Manifest %zu is emitted before its parent %zu", i, j);
+                parents++;
+            }
+        }
+        assertTrue(parents == 1, "Manifest %zu has %zu parents", i, parents);
+    }
+
+    for (uint64_t chunk = 0; chunk < chunkCount; chunk++) {
+        uint8_t digest[CCNxManifestSection_DigestLength];
+        _fillDigest(chunk, digest);
+
+        size_t found = 0;
+        for (size_t j = 0; j < emitted->count; j++) {
+            size_t hashIndex;
+            if (ccnxManifestSection_FindDigest(sections[j], digest, &hashIndex)) {
+                assertTrue(ccnxName_Equals(data->dataName, ccnxManifestSection_GetNameFromHashIndex(sections[j], hashIndex)),
+                           "Chunk %" PRIu64 " has the wrong name", chunk);
+                size_t foundChunk = ccnxManifestSection_GetNameChunkFromHashIndex(sections[j], hashIndex);
+                assertTrue(foundChunk == chunk, "Expected chunk %" PRIu64 ", got %zu", chunk, foundChunk);
+                found++;
+            }
+        }
+        assertTrue(found == 1, "Chunk %" PRIu64 " is in %zu manifests", chunk, found);
+    }
+
+    for (size_t i = 0; i < emitted->count; i++) {
+        ccnxManifestSection_Release(&sections[i]);
+    }
+}
+
+static void
+_addDigests(CCNxManifestBuilder *builder, uint64_t count)
+{
+    for (uint64_t chunk = 0; chunk < count; chunk++) {
+        uint8_t digest[CCNxManifestSection_DigestLength];
+        _fillDigest(chunk, digest);
+        assertTrue(ccnxManifestBuilder_AddDigest(builder, digest), "Could not add chunk %" PRIu64, chunk);
+    }
+}
+
+LONGBOW_TEST_RUNNER(ccnx_ManifestBuilder)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnx_ManifestBuilder)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_ManifestBuilder)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Finish_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Finish_OneManifest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Finish_ExactlyFull);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Finish_Tree);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AddDigestArray);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AddPackets);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AddPackets_NotContentObject);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AfterFinish);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+    data->manifestName = ccnxName_CreateFromURI("lci:/foo/bar/manifest");
+    data->dataName = ccnxName_CreateFromURI("lci:/foo/bar");
+    data->signatureBits = parcBuffer_Allocate(10);
+    data->signature = parcSignature_Create(PARCSigningAlgorithm_RSA, PARC_HASH_SHA256, data->signatureBits);
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    for (size_t i = 0; i < data->emitted.count; i++) {
+        ccnxContentObject_Release(&data->emitted.objects[i]);
+    }
+    ccnxName_Release(&data->manifestName);
+    ccnxName_Release(&data->dataName);
+    parcSignature_Release(&data->signature);
+    parcBuffer_Release(&data->signatureBits);
+    parcMemory_Deallocate((void **) &data);
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Create)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 4096, NULL, 2, _collect, &data->emitted);
+    assertNotNull(builder, "Got null builder");
+    assertTrue(ccnxManifestBuilder_GetChunkCount(builder) == 0, "Expected no chunks");
+    assertTrue(ccnxManifestBuilder_GetManifestCount(builder) == 0, "Expected no manifests");
+
+    ccnxManifestBuilder_Release(&builder);
+    assertNull(builder, "Release did not null the pointer");
+    assertTrue(data->emitted.count == 0, "Release without Finish should emit nothing");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Acquire)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 4096, NULL, 0, _collect, &data->emitted);
+
+    CCNxManifestBuilder *copy = ccnxManifestBuilder_Acquire(builder);
+    assertTrue(copy == builder, "Acquire should return the same builder");
+
+    ccnxManifestBuilder_Release(&copy);
+    ccnxManifestBuilder_Release(&builder);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Finish_Empty)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 4096, NULL, 0, _collect, &data->emitted);
+
+    assertTrue(ccnxManifestBuilder_Finish(builder), "Finish failed");
+    assertTrue(data->emitted.count == 1, "Expected only the root, got %zu manifests", data->emitted.count);
+    assertTrue(data->emitted.isRoot[0], "Expected the manifest to be the root");
+
+    CCNxManifest *manifest = _decodeManifest(data, data->emitted.objects[0]);
+    CCNxManifestSection *section = ccnxManifest_GetPayloadSection(manifest);
+    assertTrue(ccnxManifestSection_GetHashCount(section) == 0, "Expected no hashes, got %zu", ccnxManifestSection_GetHashCount(section));
+    assertTrue(ccnxName_Equals(data->manifestName, ccnxLink_GetName(ccnxManifest_GetNameLink(manifest))), "Wrong name link");
+    ccnxManifest_Release(&manifest);
+
+    ccnxManifestBuilder_Release(&builder);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Finish_OneManifest)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 4096, NULL, 0, _collect, &data->emitted);
+
+    _addDigests(builder, 10);
+    assertTrue(data->emitted.count == 0, "Nothing should be emitted before Finish");
+    assertTrue(ccnxManifestBuilder_Finish(builder), "Finish failed");
+
+    assertTrue(data->emitted.count == 1, "Expected one manifest, got %zu", data->emitted.count);
+    assertTrue(ccnxManifestBuilder_GetManifestCount(builder) == 1, "Expected a manifest count of 1");
+    _assertTree(data, 10);
+
+    ccnxManifestBuilder_Release(&builder);
+}
+
+/*
+ * A leaf that is exactly full when Finish is called becomes the root rather than getting a parent of one
+ */
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Finish_ExactlyFull)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // The first manifest is emitted when the digest after a full manifest arrives
+    CCNxManifestBuilder *probe = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 512, NULL, 0, _discard, NULL);
+    uint64_t capacity = 0;
+    uint8_t digest[CCNxManifestSection_DigestLength];
+    while (ccnxManifestBuilder_GetManifestCount(probe) == 0) {
+        _fillDigest(capacity, digest);
+        ccnxManifestBuilder_AddDigest(probe, digest);
+        capacity++;
+    }
+    capacity--;
+    ccnxManifestBuilder_Release(&probe);
+    assertTrue(capacity >= 2, "Expected room for at least 2 digests, got %" PRIu64, capacity);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 512, NULL, 0, _collect, &data->emitted);
+    _addDigests(builder, capacity);
+    assertTrue(ccnxManifestBuilder_Finish(builder), "Finish failed");
+
+    assertTrue(data->emitted.count == 1, "Expected one manifest, got %zu", data->emitted.count);
+    _assertTree(data, capacity);
+
+    ccnxManifestBuilder_Release(&builder);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Finish_Tree)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // Small manifests so 1000 chunks need three levels
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 400, NULL, 0, _collect, &data->emitted);
+    _addDigests(builder, 1000);
+    assertTrue(ccnxManifestBuilder_Finish(builder), "Finish failed");
+
+    assertTrue(ccnxManifestBuilder_GetChunkCount(builder) == 1000, "Expected 1000 chunks, got %" PRIu64, ccnxManifestBuilder_GetChunkCount(builder));
+    assertTrue(ccnxManifestBuilder_GetManifestCount(builder) == data->emitted.count, "Manifest count does not match the emitted manifests");
+    assertTrue(builder->levelCount >= 3, "Expected at least 3 levels, got %zu", builder->levelCount);
+    _assertTree(data, 1000);
+
+    ccnxManifestBuilder_Release(&builder);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AddDigestArray)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 400, NULL, 0, _collect, &data->emitted);
+
+    uint8_t digests[100 * CCNxManifestSection_DigestLength];
+    for (uint64_t chunk = 0; chunk < 100; chunk++) {
+        _fillDigest(chunk, &digests[chunk * CCNxManifestSection_DigestLength]);
+    }
+
+    // Uneven batches cross manifest boundaries
+    assertTrue(ccnxManifestBuilder_AddDigestArray(builder, 7, digests), "Could not add the first batch");
+    assertTrue(ccnxManifestBuilder_AddDigestArray(builder, 0, NULL), "Could not add an empty batch");
+    assertTrue(ccnxManifestBuilder_AddDigestArray(builder, 93, &digests[7 * CCNxManifestSection_DigestLength]), "Could not add the second batch");
+    assertTrue(ccnxManifestBuilder_Finish(builder), "Finish failed");
+
+    _assertTree(data, 100);
+
+    ccnxManifestBuilder_Release(&builder);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AddPackets)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 400, NULL, 3, _collect, &data->emitted);
+
+    PARCBuffer *packets[40];
+    for (uint64_t chunk = 0; chunk < 40; chunk++) {
+        packets[chunk] = _createChunkPacket(data->dataName, chunk);
+    }
+
+    assertTrue(ccnxManifestBuilder_AddPackets(builder, 25, packets), "Could not add the first batch");
+    assertTrue(ccnxManifestBuilder_AddPackets(builder, 15, &packets[25]), "Could not add the second batch");
+    assertTrue(ccnxManifestBuilder_Finish(builder), "Finish failed");
+
+    // Every chunk's ContentObjectHash, as a consumer computes it, must be in a leaf as that chunk
+    size_t found = 0;
+    for (size_t i = 0; i < data->emitted.count; i++) {
+        CCNxManifest *manifest = _decodeManifest(data, data->emitted.objects[i]);
+        CCNxManifestSection *section = ccnxManifest_GetPayloadSection(manifest);
+
+        for (uint64_t chunk = 0; chunk < 40; chunk++) {
+            CCNxWireFormatMessage *message = ccnxWireFormatMessage_Create(packets[chunk]);
+            ccnxCodecTlvPacket_BufferDecode(packets[chunk], ccnxWireFormatMessage_GetDictionary(message));
+            PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(message);
+
+            size_t chunkNumber;
+            if (ccnxManifestSection_FindHash(section, hash, NULL, &chunkNumber)) {
+                assertTrue(chunkNumber == chunk, "Expected chunk %" PRIu64 ", got %zu", chunk, chunkNumber);
+                found++;
+            }
+            parcCryptoHash_Release(&hash);
+            ccnxWireFormatMessage_Release(&message);
+        }
+        ccnxManifest_Release(&manifest);
+    }
+    assertTrue(found == 40, "Expected to find all 40 chunks, found %zu", found);
+
+    for (size_t i = 0; i < 40; i++) {
+        parcBuffer_Release(&packets[i]);
+    }
+    ccnxManifestBuilder_Release(&builder);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AddPackets_NotContentObject)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 400, NULL, 2, _collect, &data->emitted);
+
+    uint8_t garbage[] = { 1, 0, 0, 20, 0, 0, 0, 8, 0, 1, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0 };
+    PARCBuffer *packets[] = { _createChunkPacket(data->dataName, 0), parcBuffer_Wrap(garbage, sizeof(garbage), 0, sizeof(garbage)) };
+
+    assertFalse(ccnxManifestBuilder_AddPackets(builder, 2, packets), "An Interest packet should not be accepted");
+    assertTrue(ccnxManifestBuilder_GetChunkCount(builder) == 0, "Expected no chunks added, got %" PRIu64, ccnxManifestBuilder_GetChunkCount(builder));
+
+    assertTrue(ccnxManifestBuilder_AddPackets(builder, 1, packets), "The Content Object alone should be accepted");
+    assertTrue(ccnxManifestBuilder_GetChunkCount(builder) == 1, "Expected 1 chunk, got %" PRIu64, ccnxManifestBuilder_GetChunkCount(builder));
+
+    parcBuffer_Release(&packets[0]);
+    parcBuffer_Release(&packets[1]);
+    ccnxManifestBuilder_Release(&builder);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AfterFinish)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(data->manifestName, data->dataName, 4096, NULL, 0, _collect, &data->emitted);
+
+    _addDigests(builder, 3);
+    assertTrue(ccnxManifestBuilder_Finish(builder), "Finish failed");
+
+    uint8_t digest[CCNxManifestSection_DigestLength];
+    _fillDigest(3, digest);
+    assertFalse(ccnxManifestBuilder_AddDigest(builder, digest), "AddDigest should fail after Finish");
+    assertFalse(ccnxManifestBuilder_Finish(builder), "A second Finish should fail");
+    assertTrue(data->emitted.count == 1, "Expected one manifest, got %zu", data->emitted.count);
+
+    ccnxManifestBuilder_Release(&builder);
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxManifestBuilder_HashPacket_IoVec);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * A packet split across iovecs, including inside the fixed header, hashes the same as one buffer
+ */
+LONGBOW_TEST_CASE(Local, _ccnxManifestBuilder_HashPacket_IoVec)
+{
+    CCNxName *dataName = ccnxName_CreateFromURI("lci:/foo/bar");
+    PARCBuffer *packet = _createChunkPacket(dataName, 5);
+    uint8_t *bytes = parcBuffer_Overlay(packet, 0);
+    size_t length = parcBuffer_Remaining(packet);
+
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARC_HASH_SHA256);
+
+    uint8_t truth[CCNxManifestSection_DigestLength];
+    struct iovec one = { .iov_base = bytes, .iov_len = length };
+    assertTrue(_ccnxManifestBuilder_HashPacket(hasher, 1, &one, truth), "Could not hash the packet");
+
+    uint8_t test[CCNxManifestSection_DigestLength];
+    struct iovec split[] = {
+        { .iov_base = bytes,      .iov_len = 3              },
+        { .iov_base = bytes + 3,  .iov_len = 0              },
+        { .iov_base = bytes + 3,  .iov_len = 20             },
+        { .iov_base = bytes + 23, .iov_len = length - 23    },
+    };
+    assertTrue(_ccnxManifestBuilder_HashPacket(hasher, 4, split, test), "Could not hash the split packet");
+    assertTrue(memcmp(truth, test, sizeof(truth)) == 0, "Split packet hashed differently");
+
+    struct iovec shortPacket = { .iov_base = bytes, .iov_len = length - 1 };
+    assertFalse(_ccnxManifestBuilder_HashPacket(hasher, 1, &shortPacket, test), "A truncated packet should not hash");
+
+    parcCryptoHasher_Release(&hasher);
+    parcBuffer_Release(&packet);
+    ccnxName_Release(&dataName);
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxManifestBuilder_AddPackets_Workers);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Hashes 64 MB of 8 KB chunks with 0 and 3 workers
+ */
+LONGBOW_TEST_CASE(Performance, ccnxManifestBuilder_AddPackets_Workers)
+{
+    CCNxName *manifestName = ccnxName_CreateFromURI("lci:/foo/bar/manifest");
+    CCNxName *dataName = ccnxName_CreateFromURI("lci:/foo/bar");
+
+    const size_t batchSize = 64;
+    PARCBuffer *packets[batchSize];
+    for (size_t i = 0; i < batchSize; i++) {
+        PARCBuffer *payload = parcBuffer_Allocate(8192);
+        parcBuffer_SetPosition(payload, 8192);
+        parcBuffer_Flip(payload);
+        CCNxName *name = _ccnxManifestBuilder_CreateNumberedName(dataName, CCNxNameLabelType_CHUNK, i);
+        CCNxContentObject *object = ccnxContentObject_CreateWithDataPayload(name, payload);
+        CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncode(object, NULL);
+
+        const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+        packets[i] = parcBuffer_Allocate(ccnxCodecNetworkBufferIoVec_Length(iovec));
+        for (int j = 0; j < ccnxCodecNetworkBufferIoVec_GetCount(iovec); j++) {
+            parcBuffer_PutArray(packets[i], array[j].iov_len, array[j].iov_base);
+        }
+        parcBuffer_Flip(packets[i]);
+
+        ccnxCodecNetworkBufferIoVec_Release(&iovec);
+        ccnxContentObject_Release(&object);
+        ccnxName_Release(&name);
+        parcBuffer_Release(&payload);
+    }
+
+    size_t workerCounts[] = { 0, 3 };
+    for (size_t w = 0; w < sizeof(workerCounts) / sizeof(workerCounts[0]); w++) {
+        CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(manifestName, dataName, 4096, NULL, workerCounts[w], _discard, NULL);
+
+        struct timeval t0, t1;
+        gettimeofday(&t0, NULL);
+        for (size_t pass = 0; pass < 128; pass++) {
+            ccnxManifestBuilder_AddPackets(builder, batchSize, packets);
+        }
+        ccnxManifestBuilder_Finish(builder);
+        gettimeofday(&t1, NULL);
+
+        timersub(&t1, &t0, &t1);
+        printf("%zu workers: %" PRIu64 " chunks, %" PRIu64 " manifests, %.6f sec\n", workerCounts[w],
+               ccnxManifestBuilder_GetChunkCount(builder), ccnxManifestBuilder_GetManifestCount(builder),
+               t1.tv_sec + t1.tv_usec * 1E-6);
+
+        ccnxManifestBuilder_Release(&builder);
+    }
+
+    for (size_t i = 0; i < batchSize; i++) {
+        parcBuffer_Release(&packets[i]);
+    }
+    ccnxName_Release(&manifestName);
+    ccnxName_Release(&dataName);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_ManifestBuilder);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(testRunner);
+    exit(exitStatus);
+}
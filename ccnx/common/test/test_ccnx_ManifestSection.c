@@ -34,6 +34,7 @@
 #include "../ccnx_ManifestSection.c"
 
 #include <inttypes.h>
+#include <pthread.h>
 #include <ccnx/common/ccnx_Manifest.h>
 
 #include <ccnx/common/ccnx_Link.h>
@@ -41,7 +42,77 @@
 #include <LongBow/unit-test.h>
 #include <parc/algol/parc_SafeMemory.h>
 #include <parc/algol/parc_Object.h>
-#include <parc/algol/parc_ArrayList.h>
+
+/*
+ * A CCNxManifestSection_DigestLength byte digest that starts with the string and is zero padded
+ */
+static PARCBuffer *
+_createDigest(const char *string)
+{
+    size_t length = strlen(string);
+    assertTrue(length <= CCNxManifestSection_DigestLength, "String too long for a digest: %s", string);
+
+    PARCBuffer *digest = parcBuffer_Allocate(CCNxManifestSection_DigestLength);
+    parcBuffer_PutArray(digest, length, (const uint8_t *) string);
+    while (parcBuffer_HasRemaining(digest)) {
+        parcBuffer_PutUint8(digest, 0);
+    }
+    return parcBuffer_Flip(digest);
+}
+
+static PARCBuffer *
+_createNumberedDigest(size_t number)
+{
+    char string[CCNxManifestSection_DigestLength];
+    snprintf(string, sizeof(string), "chunk%zu", number);
+    return _createDigest(string);
+}
+
+#define _ThreadCount 4
+#define _ThreadHashCount 500
+
+/*
+ * A section with _ThreadHashCount numbered digests, and nothing built lazily yet
+ */
+static CCNxManifestSection *
+_createThreadSection(CCNxName *name)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    size_t nameIndex = ccnxManifestSection_AddName(section, name, 0);
+    for (size_t i = 0; i < _ThreadHashCount; i++) {
+        PARCBuffer *digest = _createNumberedDigest(i);
+        ccnxManifestSection_AddHash(section, nameIndex, digest);
+        parcBuffer_Release(&digest);
+    }
+    return section;
+}
+
+static void *
+_findDigestReader(void *arg)
+{
+    const CCNxManifestSection *section = arg;
+    for (size_t i = 0; i < _ThreadHashCount; i++) {
+        PARCBuffer *digest = _createNumberedDigest(i);
+        size_t hashIndex = SIZE_MAX;
+        bool found = ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(digest, 0), &hashIndex);
+        parcBuffer_Release(&digest);
+        if (!found || hashIndex != i) {
+            return (void *) 1;
+        }
+    }
+    return NULL;
+}
+
+static void *
+_getHashReader(void *arg)
+{
+    const CCNxManifestSection *section = arg;
+    PARCBuffer **hashes = parcMemory_AllocateAndClear(_ThreadHashCount * sizeof(PARCBuffer *));
+    for (size_t i = 0; i < _ThreadHashCount; i++) {
+        hashes[i] = ccnxManifestSection_GetHashAtIndex(section, i);
+    }
+    return hashes;
+}
 
 LONGBOW_TEST_RUNNER(ccnx_Manifest)
 {
@@ -66,6 +137,24 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_Acquire_Release);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_AddNameEntry);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_AddName_AddHash);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_AddHash_NoName);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_AddNameEntry_WrongDigestLength);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_AddHashArray);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_CreateWithCapacity);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_GetDigestArray);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_GetHashAtIndex_Growth);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_GetHashAtIndex_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_HashIterator);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_HashIterator_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_FindDigest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_FindDigest_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_FindDigest_AddAfterLookup);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_FindDigest_Duplicate);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_FindDigest_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_BuildDigestIndex);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_FindHash);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_FindHash_WrongType);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_GetACSLink);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestSection_GetNameCount);
@@ -117,7 +206,7 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_AddNameEntry)
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     bool result = ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
     assertTrue(result, "Expected successful addition of new name entry");
@@ -134,6 +223,440 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_AddNameEntry)
     ccnxName_Release(&elementName);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_AddName_AddHash)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+
+    PARCBuffer *first = _createDigest("first");
+    PARCBuffer *second = _createDigest("second");
+    PARCBuffer *third = _createDigest("third");
+    CCNxName *nameA = ccnxName_CreateFromURI("lci:/foo/bar/a");
+    CCNxName *nameB = ccnxName_CreateFromURI("lci:/foo/bar/b");
+
+    size_t indexA = ccnxManifestSection_AddName(section, nameA, 3);
+    size_t indexB = ccnxManifestSection_AddName(section, nameB, 7);
+    assertTrue(indexA == 0 && indexB == 1, "Expected name indexes 0 and 1, got %zu and %zu", indexA, indexB);
+
+    assertTrue(ccnxManifestSection_AddHash(section, indexB, first), "Expected successful addition of hash");
+    assertTrue(ccnxManifestSection_AddHash(section, indexB, second), "Expected successful addition of hash");
+    assertTrue(ccnxManifestSection_AddHash(section, indexA, third), "Expected successful addition of hash");
+
+    assertTrue(ccnxManifestSection_GetNameCount(section) == 2, "Expected 2 names, got %zu", ccnxManifestSection_GetNameCount(section));
+    assertTrue(ccnxManifestSection_GetHashCount(section) == 3, "Expected 3 hashes, got %zu", ccnxManifestSection_GetHashCount(section));
+
+    assertTrue(ccnxName_Equals(nameB, ccnxManifestSection_GetNameAtIndex(section, 1)), "Wrong name at index 1");
+    assertTrue(ccnxManifestSection_GetChunkAtIndex(section, 1) == 7, "Wrong chunk at index 1");
+
+    assertTrue(ccnxManifestSection_GetNameIndexFromHashIndex(section, 1) == indexB, "Wrong name index for hash 1");
+    assertTrue(ccnxManifestSection_GetNameIndexFromHashIndex(section, 2) == indexA, "Wrong name index for hash 2");
+    assertTrue(ccnxName_Equals(nameA, ccnxManifestSection_GetNameFromHashIndex(section, 2)), "Wrong name for hash 2");
+    assertTrue(ccnxManifestSection_GetNameChunkFromHashIndex(section, 0) == 7, "Wrong chunk for hash 0");
+    assertTrue(ccnxManifestSection_GetNameChunkFromHashIndex(section, 1) == 8, "Wrong chunk for hash 1, expected the next chunk of name B");
+    assertTrue(ccnxManifestSection_GetNameChunkFromHashIndex(section, 2) == 3, "Wrong chunk for hash 2");
+    assertTrue(parcBuffer_Equals(second, ccnxManifestSection_GetHashAtIndex(section, 1)), "Wrong digest for hash 1");
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&nameA);
+    ccnxName_Release(&nameB);
+    parcBuffer_Release(&first);
+    parcBuffer_Release(&second);
+    parcBuffer_Release(&third);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_AddHash_NoName)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    PARCBuffer *buffer = _createDigest("test");
+
+    bool result = ccnxManifestSection_AddHash(section, 0, buffer);
+    assertFalse(result, "Expected a hash without a name entry to be rejected");
+    assertTrue(ccnxManifestSection_GetHashCount(section) == 0, "Expected 0 hashes, got %zu", ccnxManifestSection_GetHashCount(section));
+
+    ccnxManifestSection_Release(&section);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_AddNameEntry_WrongDigestLength)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
+
+    bool result = ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
+    assertFalse(result, "Expected a 4 byte digest to be rejected");
+    assertTrue(ccnxManifestSection_GetNameCount(section) == 0, "Expected 0 names, got %zu", ccnxManifestSection_GetNameCount(section));
+
+    size_t nameIndex = ccnxManifestSection_AddName(section, elementName, 0);
+    result = ccnxManifestSection_AddHash(section, nameIndex, buffer);
+    assertFalse(result, "Expected a 4 byte digest to be rejected");
+    assertTrue(ccnxManifestSection_GetHashCount(section) == 0, "Expected 0 hashes, got %zu", ccnxManifestSection_GetHashCount(section));
+
+    ccnxManifestSection_Release(&section);
+    parcBuffer_Release(&buffer);
+    ccnxName_Release(&elementName);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_AddHashArray)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
+
+    uint8_t digests[3 * CCNxManifestSection_DigestLength];
+    for (size_t i = 0; i < sizeof(digests); i++) {
+        digests[i] = (uint8_t) i;
+    }
+
+    assertFalse(ccnxManifestSection_AddHashArray(section, 0, 3, digests), "Expected hashes without a name entry to be rejected");
+
+    size_t nameIndex = ccnxManifestSection_AddName(section, elementName, 0);
+    bool result = ccnxManifestSection_AddHashArray(section, nameIndex, 3, digests);
+    assertTrue(result, "Expected successful addition of 3 hashes");
+    assertTrue(ccnxManifestSection_GetHashCount(section) == 3, "Expected 3 hashes, got %zu", ccnxManifestSection_GetHashCount(section));
+
+    for (size_t i = 0; i < 3; i++) {
+        const uint8_t *digest = ccnxManifestSection_GetDigestAtIndex(section, i);
+        assertTrue(memcmp(digest, &digests[i * CCNxManifestSection_DigestLength], CCNxManifestSection_DigestLength) == 0, "Wrong digest %zu", i);
+        assertTrue(ccnxManifestSection_GetNameIndexFromHashIndex(section, i) == nameIndex, "Wrong name index %zu", i);
+    }
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&elementName);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_CreateWithCapacity)
+{
+    CCNxManifestSection *section = ccnxManifestSection_CreateWithCapacity(NULL, 100);
+    assertNotNull(section, "Expected non-null section");
+    assertTrue(section->hashCapacity >= 100, "Expected capacity of at least 100, got %zu", section->hashCapacity);
+    assertTrue(ccnxManifestSection_GetHashCount(section) == 0, "Expected 0 hashes, got %zu", ccnxManifestSection_GetHashCount(section));
+
+    ccnxManifestSection_Release(&section);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetDigestArray)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    assertNull(ccnxManifestSection_GetDigestArray(section), "Expected no digest array for an empty section");
+
+    CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
+    PARCBuffer *first = _createDigest("first");
+    PARCBuffer *second = _createDigest("second");
+    ccnxManifestSection_AddNameEntry(section, elementName, 0, first);
+    ccnxManifestSection_AddNameEntry(section, elementName, 1, second);
+
+    const uint8_t *digests = ccnxManifestSection_GetDigestArray(section);
+    assertTrue(memcmp(digests, parcBuffer_Overlay(first, 0), CCNxManifestSection_DigestLength) == 0, "Wrong first digest");
+    assertTrue(memcmp(&digests[CCNxManifestSection_DigestLength], parcBuffer_Overlay(second, 0), CCNxManifestSection_DigestLength) == 0,
+               "Wrong second digest");
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&elementName);
+    parcBuffer_Release(&first);
+    parcBuffer_Release(&second);
+}
+
+/*
+ * Buffers handed out by GetHashAtIndex must stay valid as the digest array grows
+ */
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetHashAtIndex_Growth)
+{
+    CCNxManifestSection *section = ccnxManifestSection_CreateWithCapacity(NULL, 1);
+    CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
+    PARCBuffer *first = _createDigest("first");
+    PARCBuffer *other = _createDigest("other");
+
+    size_t nameIndex = ccnxManifestSection_AddName(section, elementName, 0);
+    ccnxManifestSection_AddHash(section, nameIndex, first);
+    PARCBuffer *handle = ccnxManifestSection_GetHashAtIndex(section, 0);
+    assertTrue(ccnxManifestSection_GetHashAtIndex(section, 0) == handle, "Expected the same buffer for the same index");
+
+    for (int i = 0; i < 100; i++) {
+        ccnxManifestSection_AddHash(section, nameIndex, other);
+    }
+
+    assertTrue(parcBuffer_Equals(first, handle), "Expected the first buffer to survive growth");
+    assertTrue(parcBuffer_Equals(other, ccnxManifestSection_GetHashAtIndex(section, 100)), "Wrong buffer for the last hash");
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&elementName);
+    parcBuffer_Release(&first);
+    parcBuffer_Release(&other);
+}
+
+/*
+ * Readers on several threads asking for the same indexes must all get the section's one buffer
+ */
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetHashAtIndex_Threads)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    CCNxManifestSection *section = _createThreadSection(name);
+
+    pthread_t threads[_ThreadCount];
+    for (int t = 0; t < _ThreadCount; t++) {
+        pthread_create(&threads[t], NULL, _getHashReader, section);
+    }
+
+    PARCBuffer **hashes[_ThreadCount];
+    for (int t = 0; t < _ThreadCount; t++) {
+        pthread_join(threads[t], (void **) &hashes[t]);
+    }
+
+    for (size_t i = 0; i < _ThreadHashCount; i++) {
+        PARCBuffer *expected = _createNumberedDigest(i);
+        PARCBuffer *hash = ccnxManifestSection_GetHashAtIndex(section, i);
+        assertTrue(parcBuffer_Equals(expected, hash), "Wrong buffer for hash %zu", i);
+        for (int t = 0; t < _ThreadCount; t++) {
+            assertTrue(hashes[t][i] == hash, "Thread %d got a different buffer for hash %zu", t, i);
+        }
+        parcBuffer_Release(&expected);
+    }
+
+    for (int t = 0; t < _ThreadCount; t++) {
+        parcMemory_Deallocate((void **) &hashes[t]);
+    }
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_HashIterator)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    CCNxName *nameA = ccnxName_CreateFromURI("lci:/foo/bar/a");
+    CCNxName *nameB = ccnxName_CreateFromURI("lci:/foo/bar/b");
+    PARCBuffer *digests[] = { _createDigest("zero"), _createDigest("one"), _createDigest("two") };
+
+    size_t indexA = ccnxManifestSection_AddName(section, nameA, 0);
+    size_t indexB = ccnxManifestSection_AddName(section, nameB, 0);
+    ccnxManifestSection_AddHash(section, indexA, digests[0]);
+    ccnxManifestSection_AddHash(section, indexB, digests[1]);
+    ccnxManifestSection_AddHash(section, indexA, digests[2]);
+    size_t truthIndexes[] = { indexA, indexB, indexA };
+
+    CCNxManifestSectionHashIterator iterator = ccnxManifestSection_HashIterator(section);
+    const uint8_t *digest;
+    size_t nameIndex;
+    size_t count = 0;
+    while (ccnxManifestSectionHashIterator_Next(&iterator, &digest, &nameIndex)) {
+        assertTrue(count < 3, "Iterator returned too many entries");
+        assertTrue(memcmp(digest, parcBuffer_Overlay(digests[count], 0), CCNxManifestSection_DigestLength) == 0, "Wrong digest %zu", count);
+        assertTrue(nameIndex == truthIndexes[count], "Wrong name index %zu", count);
+        count++;
+    }
+    assertTrue(count == 3, "Expected 3 entries, got %zu", count);
+    assertFalse(ccnxManifestSectionHashIterator_Next(&iterator, &digest, NULL), "Expected the iterator to stay at the end");
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&nameA);
+    ccnxName_Release(&nameB);
+    for (int i = 0; i < 3; i++) {
+        parcBuffer_Release(&digests[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_HashIterator_Empty)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+
+    CCNxManifestSectionHashIterator iterator = ccnxManifestSection_HashIterator(section);
+    const uint8_t *digest;
+    assertFalse(ccnxManifestSectionHashIterator_Next(&iterator, &digest, NULL), "Expected no entries");
+
+    ccnxManifestSection_Release(&section);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_FindDigest)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    CCNxName *nameA = ccnxName_CreateFromURI("lci:/foo/bar/a");
+    CCNxName *nameB = ccnxName_CreateFromURI("lci:/foo/bar/b");
+    size_t indexA = ccnxManifestSection_AddName(section, nameA, 0);
+    size_t indexB = ccnxManifestSection_AddName(section, nameB, 1);
+
+    size_t count = 1000;
+    for (size_t i = 0; i < count; i++) {
+        PARCBuffer *digest = _createNumberedDigest(i);
+        ccnxManifestSection_AddHash(section, (i % 2) ? indexB : indexA, digest);
+        parcBuffer_Release(&digest);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        PARCBuffer *digest = _createNumberedDigest(i);
+        size_t hashIndex = SIZE_MAX;
+        bool found = ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(digest, 0), &hashIndex);
+        assertTrue(found, "Expected to find digest %zu", i);
+        assertTrue(hashIndex == i, "Expected hash index %zu, got %zu", i, hashIndex);
+        parcBuffer_Release(&digest);
+    }
+
+    PARCBuffer *missing = _createNumberedDigest(count);
+    size_t hashIndex = SIZE_MAX;
+    assertFalse(ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(missing, 0), &hashIndex), "Expected not to find a digest that was not added");
+    assertTrue(hashIndex == SIZE_MAX, "Expected the hash index to be untouched, got %zu", hashIndex);
+    parcBuffer_Release(&missing);
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&nameA);
+    ccnxName_Release(&nameB);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_FindDigest_Empty)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    PARCBuffer *digest = _createDigest("test");
+
+    size_t hashIndex;
+    assertFalse(ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(digest, 0), &hashIndex), "Expected not to find a digest in an empty section");
+
+    parcBuffer_Release(&digest);
+    ccnxManifestSection_Release(&section);
+}
+
+/*
+ * Hashes added after the index is built must be found, including when the index has to grow
+ */
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_FindDigest_AddAfterLookup)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    size_t nameIndex = ccnxManifestSection_AddName(section, name, 0);
+
+    PARCBuffer *first = _createNumberedDigest(0);
+    ccnxManifestSection_AddHash(section, nameIndex, first);
+
+    size_t hashIndex;
+    assertTrue(ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(first, 0), &hashIndex), "Expected to find the first digest");
+
+    for (size_t i = 1; i < 100; i++) {
+        PARCBuffer *digest = _createNumberedDigest(i);
+        ccnxManifestSection_AddHash(section, nameIndex, digest);
+        assertTrue(ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(digest, 0), &hashIndex), "Expected to find digest %zu", i);
+        assertTrue(hashIndex == i, "Expected hash index %zu, got %zu", i, hashIndex);
+        parcBuffer_Release(&digest);
+    }
+
+    assertTrue(ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(first, 0), &hashIndex), "Expected to still find the first digest");
+    assertTrue(hashIndex == 0, "Expected hash index 0, got %zu", hashIndex);
+
+    parcBuffer_Release(&first);
+    ccnxName_Release(&name);
+    ccnxManifestSection_Release(&section);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_FindDigest_Duplicate)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    size_t nameIndex = ccnxManifestSection_AddName(section, name, 0);
+    PARCBuffer *repeated = _createDigest("repeated");
+    PARCBuffer *other = _createDigest("other");
+
+    ccnxManifestSection_AddHash(section, nameIndex, other);
+    ccnxManifestSection_AddHash(section, nameIndex, repeated);
+    ccnxManifestSection_AddHash(section, nameIndex, repeated);
+
+    size_t hashIndex;
+    assertTrue(ccnxManifestSection_FindDigest(section, parcBuffer_Overlay(repeated, 0), &hashIndex), "Expected to find the repeated digest");
+    assertTrue(hashIndex == 1, "Expected the lowest hash index 1, got %zu", hashIndex);
+
+    parcBuffer_Release(&repeated);
+    parcBuffer_Release(&other);
+    ccnxName_Release(&name);
+    ccnxManifestSection_Release(&section);
+}
+
+/*
+ * The first lookups of a shared section race to build the index
+ */
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_FindDigest_Threads)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    CCNxManifestSection *section = _createThreadSection(name);
+
+    pthread_t threads[_ThreadCount];
+    for (int t = 0; t < _ThreadCount; t++) {
+        pthread_create(&threads[t], NULL, _findDigestReader, section);
+    }
+    for (int t = 0; t < _ThreadCount; t++) {
+        void *failed;
+        pthread_join(threads[t], &failed);
+        assertNull(failed, "Thread %d did not find every digest", t);
+    }
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_BuildDigestIndex)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    CCNxManifestSection *section = _createThreadSection(name);
+
+    ccnxManifestSection_BuildDigestIndex(section);
+    assertNotNull(section->digestSlots, "Expected the index to be built");
+    assertTrue(section->indexedHashes == _ThreadHashCount, "Expected %d indexed hashes, got %zu", _ThreadHashCount, section->indexedHashes);
+
+    uint32_t *digestSlots = section->digestSlots;
+    assertNull(_findDigestReader(section), "Expected to find every digest");
+    assertTrue(section->digestSlots == digestSlots, "Lookups should not rebuild an up to date index");
+
+    ccnxManifestSection_Release(&section);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_FindHash)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    CCNxName *nameA = ccnxName_CreateFromURI("lci:/foo/bar/a");
+    CCNxName *nameB = ccnxName_CreateFromURI("lci:/foo/bar/b");
+    PARCBuffer *digestA = _createDigest("a");
+    PARCBuffer *digestB = _createDigest("b");
+    ccnxManifestSection_AddNameEntry(section, nameA, 3, digestA);
+    ccnxManifestSection_AddNameEntry(section, nameB, 7, digestB);
+
+    PARCCryptoHash *hash = parcCryptoHash_Create(PARC_HASH_SHA256, digestB);
+    size_t nameIndex = SIZE_MAX;
+    size_t chunk = SIZE_MAX;
+    assertTrue(ccnxManifestSection_FindHash(section, hash, &nameIndex, &chunk), "Expected to find the hash");
+    assertTrue(nameIndex == 1, "Expected name index 1, got %zu", nameIndex);
+    assertTrue(chunk == 7, "Expected chunk 7, got %zu", chunk);
+    assertTrue(ccnxManifestSection_FindHash(section, hash, NULL, NULL), "Expected NULL outputs to be allowed");
+    parcCryptoHash_Release(&hash);
+
+    PARCBuffer *missing = _createDigest("c");
+    hash = parcCryptoHash_Create(PARC_HASH_SHA256, missing);
+    assertFalse(ccnxManifestSection_FindHash(section, hash, &nameIndex, &chunk), "Expected not to find a hash that was not added");
+    parcCryptoHash_Release(&hash);
+    parcBuffer_Release(&missing);
+
+    parcBuffer_Release(&digestA);
+    parcBuffer_Release(&digestB);
+    ccnxName_Release(&nameA);
+    ccnxName_Release(&nameB);
+    ccnxManifestSection_Release(&section);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestSection_FindHash_WrongType)
+{
+    CCNxManifestSection *section = ccnxManifestSection_Create(NULL);
+    CCNxName *name = ccnxName_CreateFromURI("lci:/foo/bar");
+    PARCBuffer *digest = _createDigest("a");
+    ccnxManifestSection_AddNameEntry(section, name, 0, digest);
+
+    PARCCryptoHash *hash = parcCryptoHash_Create(PARC_HASH_SHA512, digest);
+    assertFalse(ccnxManifestSection_FindHash(section, hash, NULL, NULL), "Expected a SHA-512 hash never to match");
+    parcCryptoHash_Release(&hash);
+
+    PARCBuffer *shortDigest = parcBuffer_WrapCString("a");
+    hash = parcCryptoHash_Create(PARC_HASH_SHA256, shortDigest);
+    assertFalse(ccnxManifestSection_FindHash(section, hash, NULL, NULL), "Expected a short digest never to match");
+    parcCryptoHash_Release(&hash);
+    parcBuffer_Release(&shortDigest);
+
+    parcBuffer_Release(&digest);
+    ccnxName_Release(&name);
+    ccnxManifestSection_Release(&section);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxManifestSection_Acquire_Release)
 {
     CCNxName *acsName = ccnxName_CreateFromURI("lci:/foo/bar/manifest/acs");
@@ -187,7 +710,7 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetNameCount)
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     bool result = ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
     assertTrue(result, "Expected successful addition of new name entry");
@@ -211,7 +734,7 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetHashCount)
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     bool result = ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
     assertTrue(result, "Expected successful addition of new name entry");
@@ -235,7 +758,7 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetHash)
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     bool result = ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
     assertTrue(result, "Expected successful addition of new name entry");
@@ -259,7 +782,7 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetNameFromHashIndex)
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     bool result = ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
     assertTrue(result, "Expected successful addition of new name entry");
@@ -283,7 +806,7 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_GetNameChunkFromHashIndex)
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     bool result = ccnxManifestSection_AddNameEntry(section, elementName, 10, buffer);
     assertTrue(result, "Expected successful addition of new name entry");
@@ -307,7 +830,7 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_Create_ToString)
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     bool result = ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
     assertTrue(result, "Expected successful addition of new name entry");
@@ -333,7 +856,7 @@ _createFullManifestSection()
 
     assertNotNull(section, "Expected non-null section");
 
-    PARCBuffer *buffer = parcBuffer_WrapCString("test");
+    PARCBuffer *buffer = _createDigest("test");
     CCNxName *elementName = ccnxName_CreateFromURI("lci:/foo/bar/1");
     ccnxManifestSection_AddNameEntry(section, elementName, 0, buffer);
 
@@ -357,34 +880,29 @@ LONGBOW_TEST_CASE(Global, ccnxManifestSection_Equals)
     CCNxLink *acsLink = ccnxLink_Create(acsName, NULL, NULL);
     u1->acsLink = acsLink;
 
+    // an extra hash entry
     CCNxManifestSection *u2 = _createFullManifestSection();
-    u2->numberOfHashes = 100;
+    PARCBuffer *buffer2 = _createDigest("another hash");
+    ccnxManifestSection_AddHash(u2, 0, buffer2);
+    parcBuffer_Release(&buffer2);
 
+    // an extra name entry
     CCNxManifestSection *u3 = _createFullManifestSection();
-    u3->numberOfNames = 100;
+    CCNxName *elementName3 = ccnxName_CreateFromURI("lci:/foo/bar/2");
+    ccnxManifestSection_AddName(u3, elementName3, 0);
+    ccnxName_Release(&elementName3);
 
     // different hash entry
-    CCNxManifestSection *u4 = _createFullManifestSection();
-    parcList_Release(&u4->listOfHashes);
-    parcList_Release(&u4->listOfNames);
-    PARCArrayList *hashList4 = parcArrayList_Create((void (*)(void **))_ccnxManifestSectionHashEntry_Release);
-    u4->listOfHashes = parcList(hashList4, PARCArrayListAsPARCList);
-    PARCArrayList *nameList4 = parcArrayList_Create((void (*)(void **))_ccnxManifestSectionHashEntry_Release);
-    u4->listOfNames = parcList(nameList4, PARCArrayListAsPARCList);
-    PARCBuffer *buffer4 = parcBuffer_WrapCString("THIS HASH IS DIFFERENT");
+    CCNxManifestSection *u4 = ccnxManifestSection_Create(x->acsLink);
+    PARCBuffer *buffer4 = _createDigest("THIS HASH IS DIFFERENT");
     CCNxName *elementName4 = ccnxName_CreateFromURI("lci:/foo/bar/1");
     ccnxManifestSection_AddNameEntry(u4, elementName4, 0, buffer4);
     parcBuffer_Release(&buffer4);
     ccnxName_Release(&elementName4);
 
-    CCNxManifestSection *u5 = _createFullManifestSection();
-    parcList_Release(&u5->listOfHashes);
-    parcList_Release(&u5->listOfNames);
-    PARCArrayList *hashList5 = parcArrayList_Create((void (*)(void **))_ccnxManifestSectionHashEntry_Release);
-    u5->listOfHashes = parcList(hashList5, PARCArrayListAsPARCList);
-    PARCArrayList *nameList5 = parcArrayList_Create((void (*)(void **))_ccnxManifestSectionHashEntry_Release);
-    u5->listOfNames = parcList(nameList5, PARCArrayListAsPARCList);
-    PARCBuffer *buffer5 = parcBuffer_WrapCString("test");
+    // different name entry
+    CCNxManifestSection *u5 = ccnxManifestSection_Create(x->acsLink);
+    PARCBuffer *buffer5 = _createDigest("test");
     CCNxName *elementName5 = ccnxName_CreateFromURI("lci:/foo/bar/somethingdifferent");
     ccnxManifestSection_AddNameEntry(u5, elementName5, 0, buffer5);
     parcBuffer_Release(&buffer5);
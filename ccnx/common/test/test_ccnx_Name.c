@@ -35,6 +35,7 @@
 
 #include <stdio.h>
 #include <limits.h>
+#include <pthread.h>
 
 #include <parc/algol/parc_SafeMemory.h>
 
@@ -64,14 +65,25 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromURI_NoScheme);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromURI_ZeroComponents);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromEncodedSegments);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromEncodedSegments_Overrun);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromEncodedSegments_BadName);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromEncodedArray);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_GetEncodedSegments);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_GetSegment_Appended);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_GetSegment_Threads);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_IsValid_True);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_IsValid_False);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_Equals);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_Equals_Parameter);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_HashCode);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_LeftMostHashCode);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_HashCode_LeftMostHashCode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_HashCode_Unequal);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_LeftMostHashCode_Prefixes);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_LeftMostHashCode_Decoded);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_ToString);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_ToString_Root);
@@ -82,9 +94,11 @@ LONGBOW_TEST_FIXTURE(Global)
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_Trim);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_Trim_MAXINT);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_Trim_Append);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_StartsWith_True);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_StartsWith_FalseShorterPrefix);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_StartsWith_FalseLongerPrefix);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_StartsWith_FalseType);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_Compare);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_ComposeNAME);
@@ -161,6 +175,161 @@ LONGBOW_TEST_CASE(Global, ccnxName_Equals)
     ccnxName_Release(&u2);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxName_CreateFromEncodedSegments)
+{
+    uint8_t encoded[] = {
+        0x00, 0x01, 0x00, 0x01, 'a',
+        0x00, 0x10, 0x00, 0x02, 'b', 'c',
+        0x00, 0x01, 0x00, 0x00
+    };
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+
+    CCNxName *name = ccnxName_CreateFromEncodedSegments(buffer);
+    assertNotNull(name, "Expected non-null");
+    assertTrue(parcBuffer_Position(buffer) == 0, "The buffer position should not change");
+
+    size_t count = ccnxName_GetSegmentCount(name);
+    assertTrue(count == 3, "Expected 3 segments, actual %zu", count);
+
+    CCNxName *expected = ccnxName_CreateFromURI("lci:/a/" CCNxNameLabel_Chunk "=bc");
+    CCNxNameSegment *empty = ccnxNameSegment_CreateTypeValueArray(CCNxNameLabelType_NAME, 0, "");
+    ccnxName_Append(expected, empty);
+    ccnxNameSegment_Release(&empty);
+
+    assertTrue(ccnxName_Equals(expected, name), "Decoded name does not match")
+    {
+        ccnxName_Display(expected, 3);
+        ccnxName_Display(name, 3);
+    }
+
+    ccnxName_Release(&expected);
+    ccnxName_Release(&name);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_CreateFromEncodedArray)
+{
+    uint8_t encoded[] = {
+        0x00, 0x01, 0x00, 0x01, 'a',
+        0x00, 0x10, 0x00, 0x02, 'b', 'c'
+    };
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+
+    CCNxName *name = ccnxName_CreateFromEncodedArray(sizeof(encoded), encoded);
+    CCNxName *expected = ccnxName_CreateFromEncodedSegments(buffer);
+    assertNotNull(name, "Expected non-null");
+    assertTrue(ccnxName_Equals(expected, name), "Name from the array does not match the name from the buffer");
+
+    // A segment that runs past the end
+    assertNull(ccnxName_CreateFromEncodedArray(sizeof(encoded) - 1, encoded), "Expected null for a truncated segment");
+
+    ccnxName_Release(&expected);
+    ccnxName_Release(&name);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_CreateFromEncodedSegments_Overrun)
+{
+    uint8_t encoded[] = {
+        0x00, 0x01, 0x00, 0x01, 'a',
+        0x00, 0x01, 0x00, 0x05, 'b', 'c'
+    };
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+
+    CCNxName *name = ccnxName_CreateFromEncodedSegments(buffer);
+    assertNull(name, "Expected null for a segment past the end of the name");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_CreateFromEncodedSegments_BadName)
+{
+    uint8_t encoded[] = {
+        0x00, 0x00, 0x00, 0x01, 'a'
+    };
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+
+    CCNxName *name = ccnxName_CreateFromEncodedSegments(buffer);
+    assertNull(name, "Expected null for a segment of type 0");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_GetEncodedSegments)
+{
+    uint8_t expected[] = {
+        0x00, 0x01, 0x00, 0x01, 'a',
+        0x00, 0x13, 0x00, 0x02, 'b', 'c'
+    };
+
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a/" CCNxNameLabel_Serial "=bc");
+
+    size_t length = ccnxName_GetEncodedLength(name);
+    assertTrue(length == sizeof(expected), "Expected length %zu, actual %zu", sizeof(expected), length);
+    assertTrue(memcmp(expected, ccnxName_GetEncodedSegments(name), length) == 0, "Wrong encoded segments");
+
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_GetSegment_Appended)
+{
+    CCNxName *name = ccnxName_Create();
+    CCNxNameSegment *segment = ccnxNameSegment_CreateTypeValueArray(CCNxNameLabelType_NAME, 3, "abc");
+    ccnxName_Append(name, segment);
+
+    CCNxNameSegment *actual = ccnxName_GetSegment(name, 0);
+    assertTrue(actual == segment, "Expected the appended segment back");
+
+    ccnxNameSegment_Release(&segment);
+    ccnxName_Release(&name);
+}
+
+static void *
+_getSegments(void *arg)
+{
+    const CCNxName *name = arg;
+    return ccnxName_GetSegment(name, ccnxName_GetSegmentCount(name) - 1);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_GetSegment_Threads)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a/b/c/d/e/f");
+
+    void *results[4];
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, _getSegments, name);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], &results[i]);
+    }
+
+    CCNxNameSegment *segment = ccnxName_GetSegment(name, 5);
+    for (int i = 0; i < 4; i++) {
+        assertTrue(results[i] == segment, "Thread %d got a different segment instance", i);
+    }
+
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_Equals_Parameter)
+{
+    // The label parameter is not in the encoded form, but still distinguishes names
+    CCNxName *x = ccnxName_CreateFromURI("lci:/a/" CCNxNameLabel_Name ":p=b");
+    CCNxName *y = ccnxName_CreateFromURI("lci:/a/" CCNxNameLabel_Name ":p=b");
+    CCNxName *z = ccnxName_Copy(x);
+    CCNxName *u1 = ccnxName_CreateFromURI("lci:/a/b");
+    CCNxName *u2 = ccnxName_CreateFromURI("lci:/a/" CCNxNameLabel_Name ":q=b");
+
+    assertEqualsContract(ccnxName_Equals, x, y, z, u1, u2);
+
+    ccnxName_Release(&x);
+    ccnxName_Release(&y);
+    ccnxName_Release(&z);
+    ccnxName_Release(&u1);
+    ccnxName_Release(&u2);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxName_ToString_Root)
 {
     const char *expected = "lci:/";
@@ -230,6 +399,22 @@ LONGBOW_TEST_CASE(Global, ccnxName_Trim_MAXINT)
     ccnxName_Release(&name);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxName_Trim_Append)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a/b/c");
+    CCNxName *expected = ccnxName_CreateFromURI("lci:/a/d");
+
+    ccnxName_Trim(name, 2);
+    CCNxNameSegment *segment = ccnxNameSegment_CreateTypeValueArray(CCNxNameLabelType_NAME, 1, "d");
+    ccnxName_Append(name, segment);
+    ccnxNameSegment_Release(&segment);
+
+    assertTrue(ccnxName_Equals(expected, name), "Expected lci:/a/d after trim and append");
+
+    ccnxName_Release(&expected);
+    ccnxName_Release(&name);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxName_Copy_Zero)
 {
     const char *uri = "lci:/"; // A Name with 1 zero-length segment
@@ -325,6 +510,69 @@ LONGBOW_TEST_CASE(Global, ccnxName_LeftMostHashCode)
     ccnxName_Release(&nameB);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxName_HashCode_Unequal)
+{
+    CCNxName *nameA = ccnxName_CreateFromURI("lci:/a/b/c");
+    CCNxName *nameB = ccnxName_CreateFromURI("lci:/a/b/d");
+    CCNxName *nameC = ccnxName_CreateFromURI("lci:/a/" CCNxNameLabel_Chunk "=b/c");
+
+    PARCHashCode codeA = ccnxName_HashCode(nameA);
+    PARCHashCode codeB = ccnxName_HashCode(nameB);
+    PARCHashCode codeC = ccnxName_HashCode(nameC);
+
+    assertTrue(codeA != codeB, "Expected different hash codes for different last segments");
+    assertTrue(codeA != codeC, "Expected different hash codes for different segment types");
+
+    ccnxName_Release(&nameA);
+    ccnxName_Release(&nameB);
+    ccnxName_Release(&nameC);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_LeftMostHashCode_Prefixes)
+{
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a/b/c/d/e");
+    size_t count = ccnxName_GetSegmentCount(name);
+
+    // Each prefix hash is the hash of the name trimmed to that prefix, and they are all different
+    for (size_t k = 0; k <= count; k++) {
+        CCNxName *prefix = ccnxName_Trim(ccnxName_Copy(name), count - k);
+
+        PARCHashCode expected = ccnxName_HashCode(prefix);
+        PARCHashCode actual = ccnxName_LeftMostHashCode(name, k);
+        assertTrue(expected == actual, "Prefix %zu: expected %" PRIPARCHashCode " got %" PRIPARCHashCode, k, expected, actual);
+
+        if (k > 0) {
+            PARCHashCode shorter = ccnxName_LeftMostHashCode(name, k - 1);
+            assertTrue(shorter != actual, "Prefixes %zu and %zu have the same hash", k - 1, k);
+        }
+        ccnxName_Release(&prefix);
+    }
+
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_LeftMostHashCode_Decoded)
+{
+    uint8_t encoded[] = {
+        0x00, 0x01, 0x00, 0x01, 'a',
+        0x00, 0x01, 0x00, 0x01, 'b'
+    };
+    PARCBuffer *buffer = parcBuffer_Wrap(encoded, sizeof(encoded), 0, sizeof(encoded));
+
+    CCNxName *decoded = ccnxName_CreateFromEncodedSegments(buffer);
+    CCNxName *parsed = ccnxName_CreateFromURI("lci:/a/b/c");
+
+    for (size_t k = 0; k <= 2; k++) {
+        PARCHashCode expected = ccnxName_LeftMostHashCode(parsed, k);
+        PARCHashCode actual = ccnxName_LeftMostHashCode(decoded, k);
+        assertTrue(expected == actual, "Prefix %zu: expected %" PRIPARCHashCode " got %" PRIPARCHashCode, k, expected, actual);
+    }
+
+    ccnxName_Release(&parsed);
+    ccnxName_Release(&decoded);
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxName_CreateAndDestroy)
 {
     CCNxName *name = ccnxName_Create();
@@ -523,6 +771,22 @@ LONGBOW_TEST_CASE(Global, ccnxName_StartsWith_FalseLongerPrefix)
     ccnxName_Release(&nameB);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxName_StartsWith_FalseType)
+{
+    const char *uriA = "lci:/a/b/c";
+    const char *prefix = "lci:/a/" CCNxNameLabel_Chunk "=b";
+
+    CCNxName *nameA = ccnxName_CreateFromURI(uriA);
+    CCNxName *nameB = ccnxName_CreateFromURI(prefix);
+
+    bool actual = ccnxName_StartsWith(nameA, nameB);
+
+    assertFalse(actual, "Expected false, the segment types differ");
+
+    ccnxName_Release(&nameA);
+    ccnxName_Release(&nameB);
+}
+
 static CCNxNameSegment *
 createSegment(PARCBuffer *buffer, size_t start, size_t end)
 {
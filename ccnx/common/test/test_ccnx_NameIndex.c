@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+
+#include "../ccnx_NameIndex.c"
+
+#include <LongBow/unit-test.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+
+LONGBOW_TEST_RUNNER(ccnx_NameIndex)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(ccnx_NameIndex)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_NameIndex)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Insert);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Insert_Duplicate);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Insert_Grow);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Get_Missing);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Remove);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Remove_Missing);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_Remove_Many);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch_Root);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch_SegmentType);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_ForEachPrefix);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_ForEachPrefix_Stop);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameIndex_ForEachUnder);
+}
+
+static size_t _longBowGlobal_Global_outstanding;
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    _longBowGlobal_Global_outstanding = parcMemory_Outstanding();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    LongBowStatus result = LONGBOW_STATUS_SUCCEEDED;
+
+    size_t allocationsLeaked = parcMemory_Outstanding() - _longBowGlobal_Global_outstanding;
+
+    if (allocationsLeaked > 0) {
+        printf("%s leaks memory by %zd allocations\n", longBowTestCase_GetName(testCase), allocationsLeaked);
+        parcSafeMemory_ReportAllocation(STDERR_FILENO);
+        result = LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return result;
+}
+
+/**
+ * Insert the name given by `uri` with the value `value`.
+ */
+static void
+_insert(CCNxNameIndex *index, const char *uri, void *value)
+{
+    CCNxName *name = ccnxName_CreateFromURI(uri);
+    bool inserted = ccnxNameIndex_Insert(index, name, value);
+    assertTrue(inserted, "Expected %s to be inserted", uri);
+    ccnxName_Release(&name);
+}
+
+/**
+ * The longest prefix match of `uri` as a URI, or NULL.  The caller must deallocate the string.
+ */
+static char *
+_longestPrefixMatch(const CCNxNameIndex *index, const char *uri, void **valuePtr)
+{
+    CCNxName *name = ccnxName_CreateFromURI(uri);
+    const CCNxName *match = ccnxNameIndex_LongestPrefixMatch(index, name, valuePtr);
+    char *result = (match == NULL) ? NULL : ccnxName_ToString(match);
+    ccnxName_Release(&name);
+    return result;
+}
+
+static void
+_assertLongestPrefixMatch(const CCNxNameIndex *index, const char *uri, const char *expected, void *expectedValue)
+{
+    void *value = NULL;
+    char *actual = _longestPrefixMatch(index, uri, &value);
+    if (expected == NULL) {
+        assertNull(actual, "Expected no match for %s, got %s", uri, actual);
+    } else {
+        assertNotNull(actual, "Expected %s to match %s", uri, expected);
+        assertTrue(strcmp(actual, expected) == 0, "Expected %s to match %s, got %s", uri, expected, actual);
+        assertTrue(value == expectedValue, "Expected value %p, got %p", expectedValue, value);
+        parcMemory_Deallocate((void **) &actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Create)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    assertNotNull(index, "Expected non-null result from ccnxNameIndex_Create");
+    assertTrue(ccnxNameIndex_Size(index) == 0, "Expected an empty index, got %zu", ccnxNameIndex_Size(index));
+    ccnxNameIndex_Release(&index);
+    assertNull(index, "Expected ccnxNameIndex_Release to null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_AcquireRelease)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    _insert(index, "lci:/a/b", index);
+
+    CCNxNameIndex *reference = ccnxNameIndex_Acquire(index);
+    ccnxNameIndex_Release(&index);
+    assertTrue(ccnxNameIndex_Size(reference) == 1, "Expected the acquired reference to hold 1 entry");
+    ccnxNameIndex_Release(&reference);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Insert)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    int value = 7;
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a/b/c");
+    assertTrue(ccnxNameIndex_Insert(index, name, &value), "Expected insert to succeed");
+    assertTrue(ccnxNameIndex_Size(index) == 1, "Expected 1 entry, got %zu", ccnxNameIndex_Size(index));
+
+    CCNxName *other = ccnxName_CreateFromURI("lci:/a/b/c");
+    void *actual = NULL;
+    assertTrue(ccnxNameIndex_Get(index, other, &actual), "Expected an equal name to be found");
+    assertTrue(actual == &value, "Expected value %p, got %p", (void *) &value, actual);
+    assertTrue(ccnxNameIndex_Get(index, other, NULL), "Expected Get to accept a NULL value pointer");
+
+    ccnxName_Release(&other);
+    ccnxName_Release(&name);
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Insert_Duplicate)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    int first, second;
+    _insert(index, "lci:/a/b", &first);
+
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a/b");
+    assertFalse(ccnxNameIndex_Insert(index, name, &second), "Expected a duplicate insert to fail");
+    assertTrue(ccnxNameIndex_Size(index) == 1, "Expected 1 entry, got %zu", ccnxNameIndex_Size(index));
+
+    void *actual = NULL;
+    ccnxNameIndex_Get(index, name, &actual);
+    assertTrue(actual == &first, "Expected the original value to be kept");
+
+    ccnxName_Release(&name);
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Insert_Grow)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    const size_t count = 1000;
+    char uri[64];
+
+    for (size_t i = 0; i < count; i++) {
+        sprintf(uri, "lci:/grow/%zu", i);
+        _insert(index, uri, (void *) (i + 1));
+    }
+    assertTrue(ccnxNameIndex_Size(index) == count, "Expected %zu entries, got %zu", count, ccnxNameIndex_Size(index));
+
+    for (size_t i = 0; i < count; i++) {
+        sprintf(uri, "lci:/grow/%zu", i);
+        CCNxName *name = ccnxName_CreateFromURI(uri);
+        void *actual = NULL;
+        assertTrue(ccnxNameIndex_Get(index, name, &actual), "Expected to find %s", uri);
+        assertTrue(actual == (void *) (i + 1), "Wrong value for %s", uri);
+        ccnxName_Release(&name);
+    }
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Get_Missing)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    _insert(index, "lci:/a/b", NULL);
+
+    CCNxName *prefix = ccnxName_CreateFromURI("lci:/a");
+    CCNxName *longer = ccnxName_CreateFromURI("lci:/a/b/c");
+    assertFalse(ccnxNameIndex_Get(index, prefix, NULL), "A prefix of an entry is not an exact match");
+    assertFalse(ccnxNameIndex_Get(index, longer, NULL), "An extension of an entry is not an exact match");
+
+    ccnxName_Release(&longer);
+    ccnxName_Release(&prefix);
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Remove)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    int value;
+    _insert(index, "lci:/a/b", &value);
+    _insert(index, "lci:/a", NULL);
+
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a/b");
+    void *actual = NULL;
+    assertTrue(ccnxNameIndex_Remove(index, name, &actual), "Expected remove to succeed");
+    assertTrue(actual == &value, "Expected the removed value to be returned");
+    assertTrue(ccnxNameIndex_Size(index) == 1, "Expected 1 entry, got %zu", ccnxNameIndex_Size(index));
+    assertFalse(ccnxNameIndex_Get(index, name, NULL), "Expected the name to be gone");
+
+    _assertLongestPrefixMatch(index, "lci:/a/b/c", "lci:/a", NULL);
+
+    ccnxName_Release(&name);
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Remove_Missing)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    _insert(index, "lci:/a/b", NULL);
+
+    CCNxName *name = ccnxName_CreateFromURI("lci:/a");
+    assertFalse(ccnxNameIndex_Remove(index, name, NULL), "Expected remove of a missing name to fail");
+    assertTrue(ccnxNameIndex_Size(index) == 1, "Expected 1 entry, got %zu", ccnxNameIndex_Size(index));
+
+    ccnxName_Release(&name);
+    ccnxNameIndex_Release(&index);
+}
+
+/*
+ * Removing entries out of the middle of probe sequences must leave every other entry reachable.
+ */
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_Remove_Many)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    const size_t count = 500;
+    char uri[64];
+
+    for (size_t i = 0; i < count; i++) {
+        sprintf(uri, "lci:/many/%zu/x", i);
+        _insert(index, uri, (void *) (i + 1));
+    }
+
+    for (size_t i = 0; i < count; i += 3) {
+        sprintf(uri, "lci:/many/%zu/x", i);
+        CCNxName *name = ccnxName_CreateFromURI(uri);
+        assertTrue(ccnxNameIndex_Remove(index, name, NULL), "Expected to remove %s", uri);
+        ccnxName_Release(&name);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        sprintf(uri, "lci:/many/%zu/x", i);
+        CCNxName *name = ccnxName_CreateFromURI(uri);
+        void *actual = NULL;
+        bool found = ccnxNameIndex_Get(index, name, &actual);
+        if (i % 3 == 0) {
+            assertFalse(found, "Expected %s to be removed", uri);
+        } else {
+            assertTrue(found, "Expected %s to be found", uri);
+            assertTrue(actual == (void *) (i + 1), "Wrong value for %s", uri);
+        }
+        ccnxName_Release(&name);
+    }
+    assertTrue(ccnxNameIndex_Size(index) == count - (count + 2) / 3, "Wrong size %zu", ccnxNameIndex_Size(index));
+
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    int a, abc, xy;
+    _insert(index, "lci:/a", &a);
+    _insert(index, "lci:/a/b/c", &abc);
+    _insert(index, "lci:/x/y", &xy);
+
+    _assertLongestPrefixMatch(index, "lci:/a/b/c/d/e", "lci:/a/b/c", &abc);
+    _assertLongestPrefixMatch(index, "lci:/a/b/c", "lci:/a/b/c", &abc);
+    _assertLongestPrefixMatch(index, "lci:/a/b", "lci:/a", &a);
+    _assertLongestPrefixMatch(index, "lci:/a/bb/c", "lci:/a", &a);
+    _assertLongestPrefixMatch(index, "lci:/x/y/z", "lci:/x/y", &xy);
+    _assertLongestPrefixMatch(index, "lci:/x", NULL, NULL);
+    _assertLongestPrefixMatch(index, "lci:/b/a", NULL, NULL);
+
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch_Root)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    int root, ab;
+    CCNxName *empty = ccnxName_Create();
+    assertTrue(ccnxNameIndex_Insert(index, empty, &root), "Expected the 0-segment name to be inserted");
+    _insert(index, "lci:/a/b", &ab);
+
+    _assertLongestPrefixMatch(index, "lci:/a/b/c", "lci:/a/b", &ab);
+
+    void *value = NULL;
+    CCNxName *query = ccnxName_CreateFromURI("lci:/q/r");
+    const CCNxName *match = ccnxNameIndex_LongestPrefixMatch(index, query, &value);
+    assertTrue(ccnxName_Equals(match, empty), "Expected the 0-segment name to match everything");
+    assertTrue(value == &root, "Expected the value of the 0-segment name");
+
+    ccnxName_Release(&query);
+    ccnxName_Release(&empty);
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch_Empty)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    _assertLongestPrefixMatch(index, "lci:/a/b", NULL, NULL);
+    ccnxNameIndex_Release(&index);
+}
+
+/*
+ * Segments with equal values but different types are different prefixes.
+ */
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_LongestPrefixMatch_SegmentType)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    int a;
+    _insert(index, "lci:/a", &a);
+    _insert(index, "lci:/a/" CCNxNameLabel_Name "=b", NULL);
+
+    _assertLongestPrefixMatch(index, "lci:/a/" CCNxNameLabel_Chunk "=b/c", "lci:/a", &a);
+
+    ccnxNameIndex_Release(&index);
+}
+
+typedef struct {
+    size_t count;
+    size_t stopAfter;
+    const CCNxName *names[8];
+} _Visit;
+
+static bool
+_visit(const CCNxName *name, void *value, void *context)
+{
+    _Visit *visit = context;
+    visit->names[visit->count++] = name;
+    return visit->count < visit->stopAfter;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_ForEachPrefix)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    _insert(index, "lci:/a", NULL);
+    _insert(index, "lci:/a/b/c", NULL);
+    _insert(index, "lci:/a/b/d", NULL);
+    _insert(index, "lci:/z", NULL);
+
+    CCNxName *query = ccnxName_CreateFromURI("lci:/a/b/c/d");
+    _Visit visit = { .count = 0, .stopAfter = 8 };
+    size_t visited = ccnxNameIndex_ForEachPrefix(index, query, _visit, &visit);
+    assertTrue(visited == 2, "Expected 2 prefixes, got %zu", visited);
+    assertTrue(ccnxName_GetSegmentCount(visit.names[0]) == 3, "Expected the longest prefix first");
+    assertTrue(ccnxName_GetSegmentCount(visit.names[1]) == 1, "Expected the shortest prefix last");
+
+    ccnxName_Release(&query);
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_ForEachPrefix_Stop)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    _insert(index, "lci:/a", NULL);
+    _insert(index, "lci:/a/b", NULL);
+
+    CCNxName *query = ccnxName_CreateFromURI("lci:/a/b/c");
+    _Visit visit = { .count = 0, .stopAfter = 1 };
+    size_t visited = ccnxNameIndex_ForEachPrefix(index, query, _visit, &visit);
+    assertTrue(visited == 1, "Expected the callback to stop the walk, got %zu", visited);
+
+    ccnxName_Release(&query);
+    ccnxNameIndex_Release(&index);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameIndex_ForEachUnder)
+{
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+    _insert(index, "lci:/a", NULL);
+    _insert(index, "lci:/a/b/c", NULL);
+    _insert(index, "lci:/a/b/d", NULL);
+    _insert(index, "lci:/a/bb", NULL);
+    _insert(index, "lci:/z", NULL);
+
+    CCNxName *prefix = ccnxName_CreateFromURI("lci:/a/b");
+    _Visit visit = { .count = 0, .stopAfter = 8 };
+    size_t visited = ccnxNameIndex_ForEachUnder(index, prefix, _visit, &visit);
+    assertTrue(visited == 2, "Expected 2 names under the prefix, got %zu", visited);
+    for (size_t i = 0; i < visit.count; i++) {
+        assertTrue(ccnxName_StartsWith(visit.names[i], prefix), "Visited a name not under the prefix");
+    }
+
+    ccnxName_Release(&prefix);
+    ccnxNameIndex_Release(&index);
+}
+
+// =================================================================
+
+/*
+ * A memory provider that counts allocator calls and passes them through to stdlib memory.
+ * Used to show that lookups do not allocate.
+ */
+static unsigned _allocationCount;
+
+static void *
+_countingAllocate(size_t size)
+{
+    _allocationCount++;
+    return ((void *(*)(size_t))PARCStdlibMemoryAsPARCMemory.Allocate)(size);
+}
+
+static void *
+_countingAllocateAndClear(size_t size)
+{
+    _allocationCount++;
+    return ((void *(*)(size_t))PARCStdlibMemoryAsPARCMemory.AllocateAndClear)(size);
+}
+
+static int
+_countingMemAlign(void **pointer, size_t alignment, size_t size)
+{
+    _allocationCount++;
+    return ((int (*)(void **, size_t, size_t))PARCStdlibMemoryAsPARCMemory.MemAlign)(pointer, alignment, size);
+}
+
+static void
+_countingDeallocate(void **pointer)
+{
+    ((void (*)(void **))PARCStdlibMemoryAsPARCMemory.Deallocate)(pointer);
+}
+
+static void *
+_countingReallocate(void *pointer, size_t newSize)
+{
+    _allocationCount++;
+    return ((void *(*)(void *, size_t))PARCStdlibMemoryAsPARCMemory.Reallocate)(pointer, newSize);
+}
+
+static char *
+_countingStringDuplicate(const char *string, size_t length)
+{
+    _allocationCount++;
+    return ((char *(*)(const char *, size_t))PARCStdlibMemoryAsPARCMemory.StringDuplicate)(string, length);
+}
+
+static uint32_t
+_countingOutstanding(void)
+{
+    return ((uint32_t (*)(void))PARCStdlibMemoryAsPARCMemory.Outstanding)();
+}
+
+static PARCMemoryInterface _countingMemory = {
+    .Allocate         = (uintptr_t) _countingAllocate,
+    .AllocateAndClear = (uintptr_t) _countingAllocateAndClear,
+    .MemAlign         = (uintptr_t) _countingMemAlign,
+    .Deallocate       = (uintptr_t) _countingDeallocate,
+    .Reallocate       = (uintptr_t) _countingReallocate,
+    .StringDuplicate  = (uintptr_t) _countingStringDuplicate,
+    .Outstanding      = (uintptr_t) _countingOutstanding
+};
+
+static const PARCMemoryInterface *_originalMemoryProvider;
+
+/*
+ * Route names: 2 to 8 segments, weighted towards 3 to 5, each segment 3 to 12 bytes.
+ * The same seed always produces the same name.
+ */
+static CCNxName *
+_createRouteName(uint32_t seed)
+{
+    static const unsigned lengths[] = { 2, 3, 3, 4, 4, 4, 5, 5, 6, 8 };
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+    uint32_t state = seed * 2654435761u + 1;
+    unsigned segmentCount = lengths[state % (sizeof(lengths) / sizeof(lengths[0]))];
+
+    CCNxName *name = ccnxName_Create();
+    for (unsigned i = 0; i < segmentCount; i++) {
+        char value[13];
+        state = state * 1103515245u + 12345u;
+        unsigned length = 3 + (state >> 16) % 10;
+        for (unsigned j = 0; j < length; j++) {
+            state = state * 1103515245u + 12345u;
+            value[j] = alphabet[(state >> 16) % (sizeof(alphabet) - 1)];
+        }
+        // The first segments are drawn from a small set so that routes share prefixes
+        if (i == 0) {
+            length = 3;
+            value[0] = alphabet[seed % 16];
+        }
+        PARCBuffer *buffer = parcBuffer_Wrap(value, length, 0, length);
+        CCNxNameSegment *segment = ccnxNameSegment_CreateTypeValue(CCNxNameLabelType_NAME, buffer);
+        ccnxName_Append(name, segment);
+        ccnxNameSegment_Release(&segment);
+        parcBuffer_Release(&buffer);
+    }
+    return name;
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxNameIndex_LongestPrefixMatch_1M);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    _originalMemoryProvider = parcMemory_SetInterface(&_countingMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcMemory_SetInterface(_originalMemoryProvider);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Build an index of 1M routes, then look up names that extend a route by 1 to 3 segments
+ * (a forwarder looking up an Interest name) and names that match nothing.
+ */
+LONGBOW_TEST_CASE(Performance, ccnxNameIndex_LongestPrefixMatch_1M)
+{
+    const uint32_t routes = 1000000;
+    const uint32_t queries = 100000;
+
+    CCNxNameIndex *index = ccnxNameIndex_Create();
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < routes; i++) {
+        CCNxName *name = _createRouteName(i);
+        ccnxNameIndex_Insert(index, name, (void *) (uintptr_t) (i + 1));
+        ccnxName_Release(&name);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double nanoseconds = (t1.tv_sec - t0.tv_sec) * 1E9 + (t1.tv_nsec - t0.tv_nsec);
+    printf("%-40s %zu entries %10.1f ns/insert (including name creation)\n", "ccnxNameIndex_Insert", ccnxNameIndex_Size(index), nanoseconds / routes);
+
+    CCNxName **hits = parcMemory_Allocate(queries * sizeof(CCNxName *));
+    CCNxName **misses = parcMemory_Allocate(queries * sizeof(CCNxName *));
+    for (uint32_t i = 0; i < queries; i++) {
+        hits[i] = _createRouteName(i * 7919 % routes);
+        for (uint32_t extra = 1 + i % 3; extra > 0; extra--) {
+            char chunk = (char) extra;
+            CCNxNameSegment *segment = ccnxNameSegment_CreateTypeValueArray(CCNxNameLabelType_CHUNK, 1, &chunk);
+            ccnxName_Append(hits[i], segment);
+            ccnxNameSegment_Release(&segment);
+        }
+        misses[i] = _createRouteName(routes + i);
+    }
+
+    CCNxName **sets[] = { hits, misses };
+    const char *labels[] = { "ccnxNameIndex_LongestPrefixMatch hit", "ccnxNameIndex_LongestPrefixMatch miss" };
+    for (int set = 0; set < 2; set++) {
+        size_t matched = 0;
+        _allocationCount = 0;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (uint32_t i = 0; i < queries; i++) {
+            void *value;
+            if (ccnxNameIndex_LongestPrefixMatch(index, sets[set][i], &value) != NULL) {
+                matched++;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        nanoseconds = (t1.tv_sec - t0.tv_sec) * 1E9 + (t1.tv_nsec - t0.tv_nsec);
+        printf("%-40s %8.2f allocations/lookup %10.1f ns/lookup (%zu matched)\n",
+               labels[set], (double) _allocationCount / queries, nanoseconds / queries, matched);
+        assertTrue(_allocationCount == 0, "Lookups must not allocate, got %u allocations", _allocationCount);
+    }
+
+    for (uint32_t i = 0; i < queries; i++) {
+        ccnxName_Release(&hits[i]);
+        ccnxName_Release(&misses[i]);
+    }
+    parcMemory_Deallocate((void **) &hits);
+    parcMemory_Deallocate((void **) &misses);
+    ccnxNameIndex_Release(&index);
+}
+
+// =================================================================
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_NameIndex);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
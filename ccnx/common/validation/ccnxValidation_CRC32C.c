@@ -35,17 +35,32 @@
  */
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
+#include <pthread.h>
 #include <LongBow/runtime.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/security/parc_CryptoHasher.h>
 
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
 #include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
 
 #include <fcntl.h>
 #include <errno.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _CRC32C_HAVE_SSE42 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32) && defined(__linux__)
+#define _CRC32C_HAVE_ARMV8 1
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
 typedef struct crc32_signer {
     PARCCryptoHasher *hasher;
 } CRC32CSigner;
@@ -93,6 +108,392 @@ static const PARCVerifierInterface crc32c_verifierinterface_template = {
     .Destroy            = crc32cVerifierInterface_Destroy,
 };
 
+// ========================================================================================
+// CRC32C engine
+//
+// The signer and verifier above must go through a PARCCryptoHasher.  The functions below compute
+// the CRC directly, with the CPU's CRC32C instruction when it has one, and are used by
+// ccnxValidationCRC32C_Compute() and the packet verify functions.
+
+/*
+ * Updates a running (pre-inverted) CRC with `length` bytes.
+ */
+typedef uint32_t (_CRC32CUpdate)(uint32_t crc, const uint8_t *bytes, size_t length);
+
+/*
+ * Updates three running CRCs, each with `length` bytes of its own buffer, and advances the buffers.
+ * The three dependency chains are interleaved so the CRC instruction's latency is hidden.
+ */
+typedef void (_CRC32CUpdate3)(uint32_t crc[3], const uint8_t *bytes[3], size_t length);
+
+typedef struct crc32c_implementation {
+    const char *name;
+    _CRC32CUpdate *update;
+    _CRC32CUpdate3 *update3;    // NULL if the implementation gains nothing from interleaving
+} _CRC32CImplementation;
+
+// Reflected CRC-32C (Castagnoli) polynomial
+#define _CRC32C_POLYNOMIAL 0x82F63B78
+
+static uint32_t _crc32cTable[8][256];
+
+static void
+_crc32c_InitializeTable(void)
+{
+    for (unsigned i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? _CRC32C_POLYNOMIAL : 0);
+        }
+        _crc32cTable[0][i] = crc;
+    }
+
+    for (unsigned i = 0; i < 256; i++) {
+        for (int slice = 1; slice < 8; slice++) {
+            uint32_t previous = _crc32cTable[slice - 1][i];
+            _crc32cTable[slice][i] = (previous >> 8) ^ _crc32cTable[0][previous & 0xFF];
+        }
+    }
+}
+
+/*
+ * Slicing-by-8: eight table lookups per 8 bytes.  Works on any byte order and alignment.
+ */
+static uint32_t
+_crc32c_UpdateSoftware(uint32_t crc, const uint8_t *bytes, size_t length)
+{
+    while (length >= 8) {
+        uint32_t low = crc ^ ((uint32_t) bytes[0] | ((uint32_t) bytes[1] << 8) | ((uint32_t) bytes[2] << 16) | ((uint32_t) bytes[3] << 24));
+        crc = _crc32cTable[7][low & 0xFF] ^ _crc32cTable[6][(low >> 8) & 0xFF]
+              ^ _crc32cTable[5][(low >> 16) & 0xFF] ^ _crc32cTable[4][low >> 24]
+              ^ _crc32cTable[3][bytes[4]] ^ _crc32cTable[2][bytes[5]]
+              ^ _crc32cTable[1][bytes[6]] ^ _crc32cTable[0][bytes[7]];
+        bytes += 8;
+        length -= 8;
+    }
+
+    while (length > 0) {
+        crc = _crc32cTable[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+        bytes++;
+        length--;
+    }
+    return crc;
+}
+
+static const _CRC32CImplementation _crc32cSoftware = {
+    .name    = "software",
+    .update  = _crc32c_UpdateSoftware,
+    .update3 = NULL
+};
+
+#ifdef _CRC32C_HAVE_SSE42
+__attribute__((target("sse4.2")))
+static uint32_t
+_crc32c_UpdateSse42(uint32_t crc, const uint8_t *bytes, size_t length)
+{
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        crc64 = __builtin_ia32_crc32di(crc64, word);
+        bytes += 8;
+        length -= 8;
+    }
+    crc = (uint32_t) crc64;
+#endif
+
+    while (length >= 4) {
+        uint32_t word;
+        memcpy(&word, bytes, sizeof(word));
+        crc = __builtin_ia32_crc32si(crc, word);
+        bytes += 4;
+        length -= 4;
+    }
+
+    while (length > 0) {
+        crc = __builtin_ia32_crc32qi(crc, *bytes);
+        bytes++;
+        length--;
+    }
+    return crc;
+}
+
+__attribute__((target("sse4.2")))
+static void
+_crc32c_Update3Sse42(uint32_t crc[3], const uint8_t *bytes[3], size_t length)
+{
+#if defined(__x86_64__)
+    uint64_t crc0 = crc[0], crc1 = crc[1], crc2 = crc[2];
+    const uint8_t *bytes0 = bytes[0], *bytes1 = bytes[1], *bytes2 = bytes[2];
+    size_t words = length / 8;
+
+    for (size_t i = 0; i < words; i++) {
+        uint64_t word0, word1, word2;
+        memcpy(&word0, bytes0, sizeof(word0));
+        memcpy(&word1, bytes1, sizeof(word1));
+        memcpy(&word2, bytes2, sizeof(word2));
+        crc0 = __builtin_ia32_crc32di(crc0, word0);
+        crc1 = __builtin_ia32_crc32di(crc1, word1);
+        crc2 = __builtin_ia32_crc32di(crc2, word2);
+        bytes0 += 8;
+        bytes1 += 8;
+        bytes2 += 8;
+    }
+
+    size_t done = words * 8;
+    crc[0] = (uint32_t) crc0;
+    crc[1] = (uint32_t) crc1;
+    crc[2] = (uint32_t) crc2;
+    bytes[0] += done;
+    bytes[1] += done;
+    bytes[2] += done;
+    length -= done;
+#endif
+
+    for (int i = 0; i < 3; i++) {
+        crc[i] = _crc32c_UpdateSse42(crc[i], bytes[i], length);
+        bytes[i] += length;
+    }
+}
+
+static const _CRC32CImplementation _crc32cSse42 = {
+    .name    = "sse4.2",
+    .update  = _crc32c_UpdateSse42,
+    .update3 = _crc32c_Update3Sse42
+};
+#endif // _CRC32C_HAVE_SSE42
+
+#ifdef _CRC32C_HAVE_ARMV8
+static uint32_t
+_crc32c_UpdateArmv8(uint32_t crc, const uint8_t *bytes, size_t length)
+{
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        crc = __crc32cd(crc, word);
+        bytes += 8;
+        length -= 8;
+    }
+
+    while (length > 0) {
+        crc = __crc32cb(crc, *bytes);
+        bytes++;
+        length--;
+    }
+    return crc;
+}
+
+static void
+_crc32c_Update3Armv8(uint32_t crc[3], const uint8_t *bytes[3], size_t length)
+{
+    size_t words = length / 8;
+    for (size_t i = 0; i < words; i++) {
+        uint64_t word0, word1, word2;
+        memcpy(&word0, bytes[0] + 8 * i, sizeof(word0));
+        memcpy(&word1, bytes[1] + 8 * i, sizeof(word1));
+        memcpy(&word2, bytes[2] + 8 * i, sizeof(word2));
+        crc[0] = __crc32cd(crc[0], word0);
+        crc[1] = __crc32cd(crc[1], word1);
+        crc[2] = __crc32cd(crc[2], word2);
+    }
+
+    size_t done = words * 8;
+    for (int i = 0; i < 3; i++) {
+        crc[i] = _crc32c_UpdateArmv8(crc[i], bytes[i] + done, length - done);
+        bytes[i] += length;
+    }
+}
+
+static const _CRC32CImplementation _crc32cArmv8 = {
+    .name    = "armv8",
+    .update  = _crc32c_UpdateArmv8,
+    .update3 = _crc32c_Update3Armv8
+};
+#endif // _CRC32C_HAVE_ARMV8
+
+static pthread_once_t _crc32cOnce = PTHREAD_ONCE_INIT;
+static const _CRC32CImplementation *_crc32cImplementation = &_crc32cSoftware;
+
+static void
+_crc32c_Initialize(void)
+{
+    _crc32c_InitializeTable();
+
+#ifdef _CRC32C_HAVE_SSE42
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        _crc32cImplementation = &_crc32cSse42;
+    }
+#endif
+
+#ifdef _CRC32C_HAVE_ARMV8
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32) {
+        _crc32cImplementation = &_crc32cArmv8;
+    }
+#endif
+}
+
+static const _CRC32CImplementation *
+_crc32c_GetImplementation(void)
+{
+    pthread_once(&_crc32cOnce, _crc32c_Initialize);
+    return _crc32cImplementation;
+}
+
+static uint16_t
+_crc32c_GetUint16(const uint8_t *bytes)
+{
+    return (uint16_t) ((bytes[0] << 8) | bytes[1]);
+}
+
+/*
+ * Finds the bytes covered by a CRC32C validation payload in a V1 wire format packet.
+ * The signed region is from the end of the fixed and optional headers to the start of the
+ * ValidationPayload TLV, the same range the encoder marks for the signer.
+ *
+ * Returns false if the packet is malformed or is not validated with CRC32C.
+ */
+static bool
+_ccnxValidationCRC32C_FindSignedRegion(size_t length, const uint8_t packet[length], size_t *startPtr, size_t *endPtr, uint32_t *crcPtr)
+{
+    // version, packet type, packet length, hop limit, reserved, flags, header length
+    if (length < 8 || packet[0] != 1) {
+        return false;
+    }
+
+    size_t packetLength = _crc32c_GetUint16(&packet[2]);
+    size_t headerLength = packet[7];
+    if (packetLength > length || headerLength < 8 || headerLength > packetLength) {
+        return false;
+    }
+
+    // Skip the CCNx message
+    size_t offset = headerLength;
+    if (offset + 4 > packetLength) {
+        return false;
+    }
+    offset += 4 + _crc32c_GetUint16(&packet[offset + 2]);
+
+    // The ValidationAlg must hold a CRC32C suite
+    if (offset + 8 > packetLength
+        || _crc32c_GetUint16(&packet[offset]) != CCNxCodecSchemaV1Types_MessageType_ValidationAlg
+        || _crc32c_GetUint16(&packet[offset + 4]) != CCNxCodecSchemaV1Types_ValidationAlg_CRC32C) {
+        return false;
+    }
+    offset += 4 + _crc32c_GetUint16(&packet[offset + 2]);
+
+    // The ValidationPayload must be the 4 byte CRC and end the packet
+    if (offset + 8 != packetLength
+        || _crc32c_GetUint16(&packet[offset]) != CCNxCodecSchemaV1Types_MessageType_ValidationPayload
+        || _crc32c_GetUint16(&packet[offset + 2]) != 4) {
+        return false;
+    }
+
+    *startPtr = headerLength;
+    *endPtr = offset;
+    *crcPtr = ((uint32_t) packet[offset + 4] << 24) | ((uint32_t) packet[offset + 5] << 16)
+              | ((uint32_t) packet[offset + 6] << 8) | (uint32_t) packet[offset + 7];
+    return true;
+}
+
+// ========================================================================================
+
+uint32_t
+ccnxValidationCRC32C_Compute(size_t length, const uint8_t bytes[length])
+{
+    assertTrue(length == 0 || bytes != NULL, "Parameter bytes must be non-null");
+    const _CRC32CImplementation *implementation = _crc32c_GetImplementation();
+    return implementation->update(0xFFFFFFFF, bytes, length) ^ 0xFFFFFFFF;
+}
+
+const char *
+ccnxValidationCRC32C_GetImplementationName(void)
+{
+    return _crc32c_GetImplementation()->name;
+}
+
+bool
+ccnxValidationCRC32C_VerifyPacket(size_t length, const uint8_t packet[length])
+{
+    assertNotNull(packet, "Parameter packet must be non-null");
+
+    size_t start;
+    size_t end;
+    uint32_t expected;
+    if (!_ccnxValidationCRC32C_FindSignedRegion(length, packet, &start, &end, &expected)) {
+        return false;
+    }
+
+    return ccnxValidationCRC32C_Compute(end - start, packet + start) == expected;
+}
+
+size_t
+ccnxValidationCRC32C_VerifyPackets(size_t count, const struct iovec packets[count], bool results[count])
+{
+    assertTrue(count == 0 || packets != NULL, "Parameter packets must be non-null");
+    assertTrue(count == 0 || results != NULL, "Parameter results must be non-null");
+
+    const _CRC32CImplementation *implementation = _crc32c_GetImplementation();
+
+    // Packets waiting to be checked three at a time
+    size_t index[3];
+    const uint8_t *bytes[3];
+    size_t remaining[3];
+    uint32_t expected[3];
+    size_t pending = 0;
+
+    size_t verified = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *packet = packets[i].iov_base;
+        size_t start;
+        size_t end;
+        results[i] = false;
+        if (packet == NULL || !_ccnxValidationCRC32C_FindSignedRegion(packets[i].iov_len, packet, &start, &end, &expected[pending])) {
+            continue;
+        }
+
+        index[pending] = i;
+        bytes[pending] = packet + start;
+        remaining[pending] = end - start;
+        pending++;
+
+        if (pending == 3) {
+            uint32_t crc[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+
+            if (implementation->update3 != NULL) {
+                size_t shortest = remaining[0];
+                shortest = (remaining[1] < shortest) ? remaining[1] : shortest;
+                shortest = (remaining[2] < shortest) ? remaining[2] : shortest;
+                implementation->update3(crc, bytes, shortest);
+                for (int j = 0; j < 3; j++) {
+                    remaining[j] -= shortest;
+                }
+            }
+
+            for (size_t j = 0; j < pending; j++) {
+                crc[j] = implementation->update(crc[j], bytes[j], remaining[j]) ^ 0xFFFFFFFF;
+                if (crc[j] == expected[j]) {
+                    results[index[j]] = true;
+                    verified++;
+                }
+            }
+            pending = 0;
+        }
+    }
+
+    // Fewer than three packets left over
+    for (size_t j = 0; j < pending; j++) {
+        uint32_t crc = implementation->update(0xFFFFFFFF, bytes[j], remaining[j]) ^ 0xFFFFFFFF;
+        if (crc == expected[j]) {
+            results[index[j]] = true;
+            verified++;
+        }
+    }
+
+    return verified;
+}
+
 // ========================================================================================
 
 bool
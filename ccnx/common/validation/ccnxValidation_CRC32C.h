@@ -36,6 +36,10 @@
 #ifndef CCNx_Common_ccnxValidation_CRC32C_h
 #define CCNx_Common_ccnxValidation_CRC32C_h
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
 #include <parc/security/parc_Signer.h>
 #include <parc/security/parc_Verifier.h>
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
@@ -97,4 +101,91 @@ PARCSigner *ccnxValidationCRC32C_CreateSigner(void);
  * @endcode
  */
 PARCVerifier *ccnxValidationCRC32C_CreateVerifier(void);
+
+/**
+ * Computes the CRC32C of a byte array
+ *
+ * Uses the CPU's CRC32C instruction (SSE4.2 on x86, the CRC extension on ARMv8) if it has one,
+ * otherwise a table driven implementation.  The choice is made once, at the first call.
+ *
+ * @param [in] length The number of bytes
+ * @param [in] bytes The bytes to check, may be NULL if `length` is 0
+ *
+ * @return number The CRC32C, with the initial value and final XOR of 0xFFFFFFFF
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t digits[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+ *     uint32_t crc = ccnxValidationCRC32C_Compute(sizeof(digits), digits);
+ *     // crc == 0xE3069283
+ * }
+ * @endcode
+ */
+uint32_t ccnxValidationCRC32C_Compute(size_t length, const uint8_t bytes[length]);
+
+/**
+ * The name of the implementation ccnxValidationCRC32C_Compute() uses on this machine
+ *
+ * @return "sse4.2", "armv8" or "software"
+ *
+ * Example:
+ * @code
+ * {
+ *     printf("CRC32C using %s\n", ccnxValidationCRC32C_GetImplementationName());
+ * }
+ * @endcode
+ */
+const char *ccnxValidationCRC32C_GetImplementationName(void);
+
+/**
+ * Verifies the CRC32C of a V1 wire format packet
+ *
+ * The packet must end with a ValidationAlg of CRC32C and a 4 byte ValidationPayload.  The CRC is
+ * computed from the end of the fixed and optional headers to the start of the ValidationPayload,
+ * directly on `packet`.  Nothing is allocated and the packet is not decoded.
+ *
+ * @param [in] length The bytes in `packet`, at least the packet length in the fixed header
+ * @param [in] packet A V1 packet
+ *
+ * @return true The packet uses CRC32C and the CRC matches
+ * @return false The CRC does not match, the packet does not use CRC32C, or it is malformed
+ *
+ * Example:
+ * @code
+ * {
+ *     ssize_t nread = read(fd, packet, sizeof(packet));
+ *     if (nread > 0 && ccnxValidationCRC32C_VerifyPacket(nread, packet)) {
+ *         // process the packet
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxValidationCRC32C_VerifyPacket(size_t length, const uint8_t packet[length]);
+
+/**
+ * Verifies the CRC32C of many V1 wire format packets
+ *
+ * Each packet is checked as ccnxValidationCRC32C_VerifyPacket() would.  With a hardware CRC32C
+ * instruction, three packets are checked at a time with their instructions interleaved, which is
+ * faster than checking them one after another.
+ *
+ * @param [in] count The number of packets
+ * @param [in] packets Each entry is one packet, e.g. the buffers filled by recvmmsg()
+ * @param [out] results Set to the result for each packet
+ *
+ * @return number The number of packets that verified
+ *
+ * Example:
+ * @code
+ * {
+ *     bool results[count];
+ *     size_t verified = ccnxValidationCRC32C_VerifyPackets(count, packets, results);
+ *     if (verified < count) {
+ *         // drop the packets whose result is false
+ *     }
+ * }
+ * @endcode
+ */
+size_t ccnxValidationCRC32C_VerifyPackets(size_t count, const struct iovec packets[count], bool results[count]);
 #endif // CCNx_Common_ccnxValidation_CRC32C_h
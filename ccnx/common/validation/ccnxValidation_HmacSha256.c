@@ -30,13 +30,76 @@
  */
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
 #include <LongBow/runtime.h>
 
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
 
+#include <parc/algol/parc_Memory.h>
+#include <parc/security/parc_CryptoHasher.h>
+#include <parc/security/parc_Key.h>
 #include <parc/security/parc_Verifier.h>
 #include <parc/security/parc_SymmetricSignerFileStore.h>
 
+/*
+ * One secret key known to the verifier.
+ *
+ * The SHA-256 state after hashing (key XOR ipad) and (key XOR opad) is computed when the key is
+ * added.  Each message copies those states instead of re-hashing the padded key, so an HMAC costs
+ * the message plus two compression runs for the outer hash.
+ *
+ * The key owns the hasher that hmacSha256VerifierInterface_GetCryptoHasher() lends out for it.
+ */
+typedef struct hmac_sha256_key {
+    struct hmac_sha256_key *next;
+    PARCKeyId *keyid;
+    PARCCryptoHasher *hasher;
+    EVP_MD_CTX *inner;
+    EVP_MD_CTX *outer;
+} _HmacSha256Key;
+
+typedef struct hmac_sha256_verifier {
+    _HmacSha256Key *keys;
+
+    // The key given to ccnxValidationHmacSha256_CreateVerifier(), used when a message has no KeyId
+    _HmacSha256Key *defaultKey;
+} HmacSha256Verifier;
+
+/*
+ * The per-hasher state: the key, a copy of its inner state advanced by the message bytes, and
+ * a copy of its outer state for finishing the HMAC
+ */
+typedef struct hmac_sha256_hasher {
+    _HmacSha256Key *key;
+    EVP_MD_CTX *inner;
+    EVP_MD_CTX *outer;
+} _HmacSha256Hasher;
+
+// ==================================================
+// HMAC-SHA256 Prototypes PARCVerifier
+
+static PARCVerifierInterface *hmacSha256VerifierInterface_Create(void);
+static PARCCryptoHasher *hmacSha256VerifierInterface_GetCryptoHasher(void *interfaceContext, PARCKeyId *keyid, PARCCryptoHashType hashType);
+static bool              hmacSha256VerifierInterface_VerifyDigest(void *interfaceContext, PARCKeyId *keyid, PARCCryptoHash *locallyComputedHash,
+                                                                  PARCCryptoSuite suite, PARCSignature *signatureToVerify);
+static void              hmacSha256VerifierInterface_AddKey(void *interfaceContext, PARCKey *key);
+static void              hmacSha256VerifierInterface_RemoveKeyId(void *interfaceContext, PARCKeyId *keyid);
+static bool              hmacSha256VerifierInterface_AllowedCryptoSuite(void *interfaceContext, PARCKeyId *keyid, PARCCryptoSuite suite);
+static void              hmacSha256VerifierInterface_Destroy(struct parc_verifier_interface **interfaceContextPtr);
+
+static const PARCVerifierInterface hmacSha256_verifierinterface_template = {
+    .interfaceContext   = NULL,
+    .GetCryptoHasher    = hmacSha256VerifierInterface_GetCryptoHasher,
+    .VerifyDigest       = hmacSha256VerifierInterface_VerifyDigest,
+    .AddKey             = hmacSha256VerifierInterface_AddKey,
+    .RemoveKeyId        = hmacSha256VerifierInterface_RemoveKeyId,
+    .AllowedCryptoSuite = hmacSha256VerifierInterface_AllowedCryptoSuite,
+    .Destroy            = hmacSha256VerifierInterface_Destroy,
+};
+
 /**
  * Sets the Validation algorithm to HMAC with SHA-256 hash
  *
@@ -96,5 +159,298 @@ ccnxValidationHmacSha256_CreateSigner(PARCBuffer *secretKey)
 PARCVerifier *
 ccnxValidationHmacSha256_CreateVerifier(PARCBuffer *secretKey)
 {
-    trapNotImplemented("not finished yet");
+    PARCVerifierInterface *interface = hmacSha256VerifierInterface_Create();
+
+    if (secretKey) {
+        // Same KeyId as the signer: the SHA-256 digest of the secret key
+        PARCBuffer *digest = parcBuffer_Allocate(SHA256_DIGEST_LENGTH);
+        SHA256(parcBuffer_Overlay(secretKey, 0), parcBuffer_Remaining(secretKey), parcBuffer_Overlay(digest, 0));
+        PARCKeyId *keyid = parcKeyId_Create(digest);
+
+        PARCKey *key = parcKey_CreateFromSymmetricKey(keyid, PARCSigningAlgorithm_HMAC, secretKey);
+        hmacSha256VerifierInterface_AddKey(interface->interfaceContext, key);
+
+        HmacSha256Verifier *verifier = interface->interfaceContext;
+        verifier->defaultKey = verifier->keys;
+
+        parcKey_Release(&key);
+        parcKeyId_Release(&keyid);
+        parcBuffer_Release(&digest);
+    }
+
+    return parcVerifier_Create(interface);
+}
+
+// ==================================================
+// HMAC-SHA256 computation
+
+#define _HMAC_SHA256_BLOCK_SIZE 64
+
+/*
+ * Hash (key XOR ipad) and (key XOR opad) once.  A key longer than the block size is first
+ * replaced by its digest (RFC 2104).
+ */
+static void
+_hmacSha256Key_Precompute(_HmacSha256Key *key, size_t length, const uint8_t secret[length])
+{
+    uint8_t block[_HMAC_SHA256_BLOCK_SIZE];
+    memset(block, 0, sizeof(block));
+    if (length > _HMAC_SHA256_BLOCK_SIZE) {
+        SHA256(secret, length, block);
+    } else if (length > 0) {
+        memcpy(block, secret, length);
+    }
+
+    uint8_t pad[_HMAC_SHA256_BLOCK_SIZE];
+    for (int i = 0; i < _HMAC_SHA256_BLOCK_SIZE; i++) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    key->inner = EVP_MD_CTX_new();
+    assertNotNull(key->inner, "EVP_MD_CTX_new() returned NULL");
+    EVP_DigestInit_ex(key->inner, EVP_sha256(), NULL);
+    EVP_DigestUpdate(key->inner, pad, sizeof(pad));
+
+    for (int i = 0; i < _HMAC_SHA256_BLOCK_SIZE; i++) {
+        pad[i] = block[i] ^ 0x5C;
+    }
+    key->outer = EVP_MD_CTX_new();
+    assertNotNull(key->outer, "EVP_MD_CTX_new() returned NULL");
+    EVP_DigestInit_ex(key->outer, EVP_sha256(), NULL);
+    EVP_DigestUpdate(key->outer, pad, sizeof(pad));
+
+    // do not leave key material on the stack
+    memset(block, 0, sizeof(block));
+    memset(pad, 0, sizeof(pad));
+}
+
+static void *
+_hmacSha256Hasher_Setup(void *env)
+{
+    _HmacSha256Hasher *hasher = parcMemory_AllocateAndClear(sizeof(_HmacSha256Hasher));
+    assertNotNull(hasher, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_HmacSha256Hasher));
+    hasher->key = env;
+    hasher->inner = EVP_MD_CTX_new();
+    hasher->outer = EVP_MD_CTX_new();
+    assertTrue(hasher->inner != NULL && hasher->outer != NULL, "EVP_MD_CTX_new() returned NULL");
+    return hasher;
+}
+
+static int
+_hmacSha256Hasher_Init(void *ctx)
+{
+    _HmacSha256Hasher *hasher = ctx;
+    return (EVP_MD_CTX_copy_ex(hasher->inner, hasher->key->inner) == 1) ? 0 : -1;
+}
+
+static int
+_hmacSha256Hasher_Update(void *ctx, const void *buffer, size_t length)
+{
+    _HmacSha256Hasher *hasher = ctx;
+    return (EVP_DigestUpdate(hasher->inner, buffer, length) == 1) ? 0 : -1;
+}
+
+/*
+ * Finish the HMAC: hash the inner digest from a copy of the key's outer state.
+ */
+static PARCBuffer *
+_hmacSha256Hasher_Finalize(void *ctx)
+{
+    _HmacSha256Hasher *hasher = ctx;
+
+    uint8_t innerDigest[SHA256_DIGEST_LENGTH];
+    EVP_DigestFinal_ex(hasher->inner, innerDigest, NULL);
+
+    PARCBuffer *mac = parcBuffer_Allocate(SHA256_DIGEST_LENGTH);
+    EVP_MD_CTX_copy_ex(hasher->outer, hasher->key->outer);
+    EVP_DigestUpdate(hasher->outer, innerDigest, sizeof(innerDigest));
+    EVP_DigestFinal_ex(hasher->outer, parcBuffer_Overlay(mac, 0), NULL);
+    return mac;
+}
+
+static void
+_hmacSha256Hasher_Destroy(void **ctxPtr)
+{
+    _HmacSha256Hasher *hasher = *ctxPtr;
+    EVP_MD_CTX_free(hasher->inner);
+    EVP_MD_CTX_free(hasher->outer);
+    parcMemory_Deallocate(ctxPtr);
+    *ctxPtr = NULL;
+}
+
+/*
+ * A new hasher that computes the HMAC of whatever is hashed with it.  It must not outlive the key.
+ */
+static PARCCryptoHasher *
+_hmacSha256Key_CreateHasher(_HmacSha256Key *key)
+{
+    PARCCryptoHasherInterface functor = {
+        .functor_env     = key,
+        .hasher_setup    = _hmacSha256Hasher_Setup,
+        .hasher_init     = _hmacSha256Hasher_Init,
+        .hasher_update   = _hmacSha256Hasher_Update,
+        .hasher_finalize = _hmacSha256Hasher_Finalize,
+        .hasher_destroy  = _hmacSha256Hasher_Destroy
+    };
+    return parcCryptoHasher_CustomHasher(PARC_HASH_SHA256, functor);
+}
+
+static _HmacSha256Key *
+_hmacSha256Key_Create(PARCKeyId *keyid, PARCBuffer *secret)
+{
+    _HmacSha256Key *key = parcMemory_AllocateAndClear(sizeof(_HmacSha256Key));
+    assertNotNull(key, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_HmacSha256Key));
+    key->keyid = parcKeyId_Acquire(keyid);
+    _hmacSha256Key_Precompute(key, parcBuffer_Remaining(secret), parcBuffer_Overlay(secret, 0));
+    key->hasher = _hmacSha256Key_CreateHasher(key);
+    return key;
+}
+
+static void
+_hmacSha256Key_Destroy(_HmacSha256Key **keyPtr)
+{
+    _HmacSha256Key *key = *keyPtr;
+    parcCryptoHasher_Release(&key->hasher);
+    parcKeyId_Release(&key->keyid);
+    EVP_MD_CTX_free(key->inner);
+    EVP_MD_CTX_free(key->outer);
+    parcMemory_Deallocate((void **) keyPtr);
+    *keyPtr = NULL;
+}
+
+static _HmacSha256Key *
+_hmacSha256Verifier_FindKey(HmacSha256Verifier *verifier, const PARCKeyId *keyid)
+{
+    if (keyid == NULL) {
+        return verifier->defaultKey;
+    }
+
+    for (_HmacSha256Key *key = verifier->keys; key; key = key->next) {
+        if (parcKeyId_Equals(key->keyid, keyid)) {
+            return key;
+        }
+    }
+    return NULL;
+}
+
+// ==================================================
+// HMAC-SHA256 Implementation PARCVerifierInterface
+
+static PARCVerifierInterface *
+hmacSha256VerifierInterface_Create(void)
+{
+    HmacSha256Verifier *verifier = parcMemory_AllocateAndClear(sizeof(HmacSha256Verifier));
+    assertNotNull(verifier, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(HmacSha256Verifier));
+
+    PARCVerifierInterface *interface = parcMemory_AllocateAndClear(sizeof(PARCVerifierInterface));
+    assertNotNull(interface, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCVerifierInterface));
+    *interface = hmacSha256_verifierinterface_template;
+    interface->interfaceContext = verifier;
+    return interface;
+}
+
+/*
+ * Returns the key's hasher, which computes the HMAC of whatever is hashed with it.  The verifier
+ * owns it; the caller must not release it.  Returns NULL if the key is not known.  A NULL keyid
+ * means the key given to ccnxValidationHmacSha256_CreateVerifier().
+ */
+static PARCCryptoHasher *
+hmacSha256VerifierInterface_GetCryptoHasher(void *interfaceContext, PARCKeyId *keyid, PARCCryptoHashType hashType)
+{
+    assertTrue(hashType == PARC_HASH_SHA256, "Only supports PARC_HASH_SHA256, got request for %s", parcCryptoHashType_ToString(hashType));
+
+    _HmacSha256Key *key = _hmacSha256Verifier_FindKey(interfaceContext, keyid);
+    return (key != NULL) ? key->hasher : NULL;
+}
+
+static bool
+hmacSha256VerifierInterface_VerifyDigest(void *interfaceContext, PARCKeyId *keyid, PARCCryptoHash *locallyComputedHash,
+                                         PARCCryptoSuite suite, PARCSignature *signatureToVerify)
+{
+    assertTrue(suite == PARCCryptoSuite_HMAC_SHA256, "Only supports PARCCryptoSuite_HMAC_SHA256, got request for %d", suite);
+
+    if (_hmacSha256Verifier_FindKey(interfaceContext, keyid) == NULL) {
+        return false;
+    }
+
+    // The locally computed "hash" is the HMAC, so compare it to the signature
+    PARCBuffer *calculated = parcCryptoHash_GetDigest(locallyComputedHash);
+    PARCBuffer *received = parcSignature_GetSignature(signatureToVerify);
+
+    size_t length = parcBuffer_Remaining(calculated);
+    if (length != SHA256_DIGEST_LENGTH || parcBuffer_Remaining(received) != length) {
+        return false;
+    }
+
+    // Constant time, so the comparison does not tell an attacker how many bytes matched
+    const uint8_t *a = parcBuffer_Overlay(calculated, 0);
+    const uint8_t *b = parcBuffer_Overlay(received, 0);
+    uint8_t difference = 0;
+    for (size_t i = 0; i < length; i++) {
+        difference |= a[i] ^ b[i];
+    }
+    return difference == 0;
+}
+
+static void
+hmacSha256VerifierInterface_AddKey(void *interfaceContext, PARCKey *key)
+{
+    assertTrue(parcKey_GetSigningAlgorithm(key) == PARCSigningAlgorithm_HMAC, "Only supports HMAC keys, got %d", parcKey_GetSigningAlgorithm(key));
+
+    HmacSha256Verifier *verifier = interfaceContext;
+    PARCKeyId *keyid = parcKey_GetKeyId(key);
+
+    // Adding a key again replaces it, and a replaced default key stays the default
+    _HmacSha256Key *existing = _hmacSha256Verifier_FindKey(verifier, keyid);
+    bool wasDefault = (existing != NULL && existing == verifier->defaultKey);
+    hmacSha256VerifierInterface_RemoveKeyId(interfaceContext, keyid);
+
+    _HmacSha256Key *entry = _hmacSha256Key_Create(keyid, parcKey_GetKey(key));
+    entry->next = verifier->keys;
+    verifier->keys = entry;
+    if (wasDefault) {
+        verifier->defaultKey = entry;
+    }
+}
+
+static void
+hmacSha256VerifierInterface_RemoveKeyId(void *interfaceContext, PARCKeyId *keyid)
+{
+    HmacSha256Verifier *verifier = interfaceContext;
+
+    _HmacSha256Key **link = &verifier->keys;
+    while (*link) {
+        _HmacSha256Key *key = *link;
+        if (parcKeyId_Equals(key->keyid, keyid)) {
+            *link = key->next;
+            if (verifier->defaultKey == key) {
+                verifier->defaultKey = NULL;
+            }
+            _hmacSha256Key_Destroy(&key);
+            return;
+        }
+        link = &key->next;
+    }
+}
+
+static bool
+hmacSha256VerifierInterface_AllowedCryptoSuite(void *interfaceContext, PARCKeyId *keyid, PARCCryptoSuite suite)
+{
+    return (suite == PARCCryptoSuite_HMAC_SHA256);
+}
+
+static void
+hmacSha256VerifierInterface_Destroy(struct parc_verifier_interface **interfaceContextPtr)
+{
+    PARCVerifierInterface *interface = (PARCVerifierInterface *) *interfaceContextPtr;
+
+    HmacSha256Verifier *verifier = interface->interfaceContext;
+    while (verifier->keys) {
+        _HmacSha256Key *key = verifier->keys;
+        verifier->keys = key->next;
+        _hmacSha256Key_Destroy(&key);
+    }
+
+    parcMemory_Deallocate((void **) &verifier);
+    parcMemory_Deallocate((void **) &interface);
+    *interfaceContextPtr = NULL;
 }
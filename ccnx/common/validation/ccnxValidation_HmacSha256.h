@@ -93,11 +93,18 @@ bool ccnxValidationHmacSha256_Test(const CCNxTlvDictionary *message);
 PARCSigner *ccnxValidationHmacSha256_CreateSigner(PARCBuffer *secretKey);
 
 /**
- * Creates a verifier to check a CRC32C "signature"
+ * Creates a verifier to check an HMAC-SHA256 authenticator
  *
  * Once the Verifier is created, you can add more keys using
  * parcVerifier_AddKey().  If you provide a secretKey in the call, it will
- * be added to the verifier automatically.
+ * be added to the verifier automatically, with a KeyId of the SHA-256 digest of the key.
+ * It is also the key used when parcVerifier_GetCryptoHasher() is given a NULL KeyId.
+ *
+ * The keyed inner and outer SHA-256 states are computed once, when a key is added.  The hasher
+ * returned by parcVerifier_GetCryptoHasher() for a KeyId starts each message from a copy of
+ * that state, so the HMAC of a message costs hashing the message plus two compression runs.
+ * parcVerifier_GetCryptoHasher() returns NULL for an unknown KeyId.  Adding a key with the KeyId
+ * of the default key replaces the default key.
  *
  * @param [in] secretKey (Optional) The key to use as the authenticator, or NULL.
  *
@@ -106,7 +113,19 @@ PARCSigner *ccnxValidationHmacSha256_CreateSigner(PARCBuffer *secretKey);
  *
  * Example:
  * @code
- * <#example#>
+ * {
+ *     PARCVerifier *verifier = ccnxValidationHmacSha256_CreateVerifier(secretKey);
+ *
+ *     PARCCryptoHasher *hasher = parcVerifier_GetCryptoHasher(verifier, keyid, PARC_HASH_SHA256);
+ *     parcCryptoHasher_Init(hasher);
+ *     parcCryptoHasher_UpdateBytes(hasher, signedBytes, signedLength);
+ *     PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
+ *
+ *     bool valid = parcVerifier_VerifySignature(verifier, keyid, hash, PARCCryptoSuite_HMAC_SHA256, signature);
+ *
+ *     parcCryptoHash_Release(&hash);
+ *     parcVerifier_Destroy(&verifier);
+ * }
  * @endcode
  */
 PARCVerifier *ccnxValidationHmacSha256_CreateVerifier(PARCBuffer *secretKey);
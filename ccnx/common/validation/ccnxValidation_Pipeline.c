@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/security/parc_CryptoHasher.h>
+#include <parc/security/parc_CryptoSuite.h>
+#include <parc/security/parc_KeyId.h>
+#include <parc/security/parc_Signature.h>
+#include <LongBow/runtime.h>
+
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+
+#include <ccnx/common/validation/ccnxValidation_Pipeline.h>
+
+/*
+ * What the verifier needs to know about a crypto suite.  A keyed suite is hashed with the
+ * verifier's hasher for the KeyId, so it cannot be hashed by a worker.
+ */
+typedef struct ccnx_validation_pipeline_suite {
+    PARCCryptoSuite suite;
+    PARCSigningAlgorithm signingAlgorithm;
+    PARCCryptoHashType hashType;
+    bool keyed;
+} _CCNxValidationPipelineSuite;
+
+static const _CCNxValidationPipelineSuite _ccnxValidationPipeline_Suites[] = {
+    { .suite = PARCCryptoSuite_RSA_SHA256,    .signingAlgorithm = PARCSigningAlgorithm_RSA,   .hashType = PARC_HASH_SHA256, .keyed = false },
+    { .suite = PARCCryptoSuite_RSA_SHA512,    .signingAlgorithm = PARCSigningAlgorithm_RSA,   .hashType = PARC_HASH_SHA512, .keyed = false },
+    { .suite = PARCCryptoSuite_DSA_SHA256,    .signingAlgorithm = PARCSigningAlgorithm_DSA,   .hashType = PARC_HASH_SHA256, .keyed = false },
+    { .suite = PARCCryptoSuite_EC_SECP_256K1, .signingAlgorithm = PARCSigningAlgorithm_ECDSA, .hashType = PARC_HASH_SHA256, .keyed = false },
+    { .suite = PARCCryptoSuite_NULL_CRC32C,   .signingAlgorithm = PARCSigningAlgortihm_NULL,  .hashType = PARC_HASH_CRC32C, .keyed = false },
+    { .suite = PARCCryptoSuite_HMAC_SHA256,   .signingAlgorithm = PARCSigningAlgorithm_HMAC,  .hashType = PARC_HASH_SHA256, .keyed = true  },
+    { .suite = PARCCryptoSuite_HMAC_SHA512,   .signingAlgorithm = PARCSigningAlgorithm_HMAC,  .hashType = PARC_HASH_SHA512, .keyed = true  },
+};
+
+#define _ccnxValidationPipeline_SuiteCount (sizeof(_ccnxValidationPipeline_Suites) / sizeof(_ccnxValidationPipeline_Suites[0]))
+
+// One hasher per hash type, created the first time a thread needs it
+typedef struct ccnx_validation_pipeline_hashers {
+    PARCCryptoHasher *sha256;
+    PARCCryptoHasher *sha512;
+    PARCCryptoHasher *crc32c;
+} _CCNxValidationPipelineHashers;
+
+/*
+ * The state of one message during a batch.  `keyid` and `payload` belong to the message.
+ * `hash` is NULL until the message is hashed, by a worker for an un-keyed suite or by the
+ * calling thread for a keyed suite.
+ */
+typedef struct ccnx_validation_pipeline_entry {
+    size_t index;
+    CCNxTlvDictionary *message;
+    const _CCNxValidationPipelineSuite *suite;
+    PARCBuffer *keyid;
+    PARCHashCode keyidHashCode;
+    PARCBuffer *payload;
+    PARCCryptoHash *hash;
+} _CCNxValidationPipelineEntry;
+
+typedef struct ccnx_validation_pipeline_batch {
+    _CCNxValidationPipelineEntry *entries;
+    size_t count;
+
+    // The next entry to prepare, taken with an atomic add by every thread working on the batch
+    size_t next;
+} _CCNxValidationPipelineBatch;
+
+typedef struct ccnx_validation_pipeline_worker {
+    CCNxValidationPipeline *pipeline;
+    pthread_t thread;
+    _CCNxValidationPipelineHashers hashers;
+} _CCNxValidationPipelineWorker;
+
+struct ccnx_validation_pipeline {
+    PARCVerifier *verifier;
+
+    size_t workerCount;
+    _CCNxValidationPipelineWorker *workers;
+
+    // The calling thread's hashers, protected by batchLock
+    _CCNxValidationPipelineHashers hashers;
+
+    // Held for the whole of a batch so only one batch runs at a time
+    pthread_mutex_t batchLock;
+
+    // Protects everything below
+    pthread_mutex_t lock;
+    pthread_cond_t batchReady;
+    pthread_cond_t batchDone;
+    _CCNxValidationPipelineBatch *batch;
+    uint64_t generation;
+    size_t busyWorkers;
+    bool shutdown;
+};
+
+// ================================================================================
+
+static const _CCNxValidationPipelineSuite *
+_ccnxValidationPipeline_FindSuite(uint64_t suite)
+{
+    for (size_t i = 0; i < _ccnxValidationPipeline_SuiteCount; i++) {
+        if (_ccnxValidationPipeline_Suites[i].suite == suite) {
+            return &_ccnxValidationPipeline_Suites[i];
+        }
+    }
+    return NULL;
+}
+
+static PARCCryptoHasher *
+_ccnxValidationPipeline_GetHasher(_CCNxValidationPipelineHashers *hashers, PARCCryptoHashType hashType)
+{
+    PARCCryptoHasher **hasherPtr = NULL;
+    switch (hashType) {
+        case PARC_HASH_SHA256:
+            hasherPtr = &hashers->sha256;
+            break;
+        case PARC_HASH_SHA512:
+            hasherPtr = &hashers->sha512;
+            break;
+        case PARC_HASH_CRC32C:
+            hasherPtr = &hashers->crc32c;
+            break;
+        default:
+            trapIllegalValue(hashType, "Unsupported hash type: %d", hashType);
+    }
+
+    if (*hasherPtr == NULL) {
+        *hasherPtr = parcCryptoHasher_Create(hashType);
+    }
+    return *hasherPtr;
+}
+
+static void
+_ccnxValidationPipeline_ReleaseHashers(_CCNxValidationPipelineHashers *hashers)
+{
+    if (hashers->sha256 != NULL) {
+        parcCryptoHasher_Release(&hashers->sha256);
+    }
+    if (hashers->sha512 != NULL) {
+        parcCryptoHasher_Release(&hashers->sha512);
+    }
+    if (hashers->crc32c != NULL) {
+        parcCryptoHasher_Release(&hashers->crc32c);
+    }
+}
+
+/**
+ * Reads what the verifier needs out of the message and, for an un-keyed suite, hashes the protected region.
+ *
+ * Runs on a worker or the calling thread.  Each entry is prepared by exactly one thread, so
+ * reading the message (which may decode lazy fields) needs no lock.  On any failure `suite`
+ * is left NULL and the message fails validation.
+ */
+static void
+_ccnxValidationPipeline_Prepare(_CCNxValidationPipelineEntry *entry, _CCNxValidationPipelineHashers *hashers)
+{
+    CCNxTlvDictionary *message = entry->message;
+    if (message == NULL || !ccnxTlvDictionary_IsValueInteger(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE)) {
+        return;
+    }
+
+    const _CCNxValidationPipelineSuite *suite =
+        _ccnxValidationPipeline_FindSuite(ccnxTlvDictionary_GetInteger(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE));
+    if (suite == NULL) {
+        return;
+    }
+
+    entry->payload = ccnxValidationFacadeV1_GetPayload(message);
+    if (entry->payload == NULL) {
+        return;
+    }
+
+    entry->keyid = ccnxValidationFacadeV1_GetKeyId(message);
+    entry->keyidHashCode = (entry->keyid == NULL) ? 0 : parcBuffer_HashCode(entry->keyid);
+
+    if (!suite->keyed) {
+        PARCCryptoHasher *hasher = _ccnxValidationPipeline_GetHasher(hashers, suite->hashType);
+        entry->hash = ccnxWireFormatMessage_HashProtectedRegion(message, hasher);
+        if (entry->hash == NULL) {
+            return;
+        }
+    }
+
+    entry->suite = suite;
+}
+
+static void
+_ccnxValidationPipeline_PrepareBatch(_CCNxValidationPipelineBatch *batch, _CCNxValidationPipelineHashers *hashers)
+{
+    size_t i;
+    while ((i = __atomic_fetch_add(&batch->next, 1, __ATOMIC_RELAXED)) < batch->count) {
+        _ccnxValidationPipeline_Prepare(&batch->entries[i], hashers);
+    }
+}
+
+static void *
+_ccnxValidationPipeline_WorkerMain(void *arg)
+{
+    _CCNxValidationPipelineWorker *worker = arg;
+    CCNxValidationPipeline *pipeline = worker->pipeline;
+
+    uint64_t generation = 0;
+
+    pthread_mutex_lock(&pipeline->lock);
+    while (!pipeline->shutdown) {
+        if (pipeline->generation == generation) {
+            pthread_cond_wait(&pipeline->batchReady, &pipeline->lock);
+            continue;
+        }
+
+        generation = pipeline->generation;
+        _CCNxValidationPipelineBatch *batch = pipeline->batch;
+        pthread_mutex_unlock(&pipeline->lock);
+
+        _ccnxValidationPipeline_PrepareBatch(batch, &worker->hashers);
+
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->busyWorkers--;
+        if (pipeline->busyWorkers == 0) {
+            pthread_cond_signal(&pipeline->batchDone);
+        }
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+
+    _ccnxValidationPipeline_ReleaseHashers(&worker->hashers);
+    return NULL;
+}
+
+/*
+ * Sorts prepared entries so each (suite, KeyId) group is contiguous.  Entries without a KeyId
+ * sort ahead of those with one.  The order within a group is not significant.
+ */
+static int
+_ccnxValidationPipeline_CompareEntries(const void *a, const void *b)
+{
+    const _CCNxValidationPipelineEntry *entryA = *(_CCNxValidationPipelineEntry * const *) a;
+    const _CCNxValidationPipelineEntry *entryB = *(_CCNxValidationPipelineEntry * const *) b;
+
+    if (entryA->suite != entryB->suite) {
+        return (entryA->suite < entryB->suite) ? -1 : 1;
+    }
+    if (entryA->keyid == NULL || entryB->keyid == NULL) {
+        return (entryA->keyid != NULL) - (entryB->keyid != NULL);
+    }
+    if (entryA->keyidHashCode != entryB->keyidHashCode) {
+        return (entryA->keyidHashCode < entryB->keyidHashCode) ? -1 : 1;
+    }
+    return parcBuffer_Compare(entryA->keyid, entryB->keyid);
+}
+
+static bool
+_ccnxValidationPipeline_SameGroup(const _CCNxValidationPipelineEntry *a, const _CCNxValidationPipelineEntry *b)
+{
+    return _ccnxValidationPipeline_CompareEntries(&a, &b) == 0;
+}
+
+static bool
+_ccnxValidationPipeline_VerifyEntry(CCNxValidationPipeline *pipeline, _CCNxValidationPipelineEntry *entry, PARCKeyId *keyid)
+{
+    if (entry->hash == NULL) {
+        return false;
+    }
+
+    PARCSignature *signature = parcSignature_Create(entry->suite->signingAlgorithm, entry->suite->hashType, entry->payload);
+    bool valid = parcVerifier_VerifySignature(pipeline->verifier, keyid, entry->hash, entry->suite->suite, signature);
+    parcSignature_Release(&signature);
+    return valid;
+}
+
+/**
+ * Verifies the prepared entries one (suite, KeyId) group at a time on the calling thread.
+ *
+ * The PARCKeyId is created once per group.  A keyed group gets its hasher from the verifier once
+ * and hashes each message with it; if the verifier does not know the KeyId, the group fails.
+ * The hasher is borrowed from the verifier and is not released.
+ */
+static size_t
+_ccnxValidationPipeline_VerifyGroups(CCNxValidationPipeline *pipeline, size_t count, _CCNxValidationPipelineEntry *sorted[count],
+                                     bool results[], CCNxValidationPipelineCompletion *completion, void *context)
+{
+    size_t verified = 0;
+
+    size_t start = 0;
+    while (start < count) {
+        size_t end = start + 1;
+        while (end < count && _ccnxValidationPipeline_SameGroup(sorted[start], sorted[end])) {
+            end++;
+        }
+
+        const _CCNxValidationPipelineSuite *suite = sorted[start]->suite;
+        PARCKeyId *keyid = (sorted[start]->keyid == NULL) ? NULL : parcKeyId_Create(sorted[start]->keyid);
+
+        PARCCryptoHasher *hasher = NULL;
+        if (suite->keyed) {
+            hasher = parcVerifier_GetCryptoHasher(pipeline->verifier, keyid, suite->hashType);
+        }
+
+        for (size_t i = start; i < end; i++) {
+            _CCNxValidationPipelineEntry *entry = sorted[i];
+            if (hasher != NULL) {
+                entry->hash = ccnxWireFormatMessage_HashProtectedRegion(entry->message, hasher);
+            }
+
+            bool valid = _ccnxValidationPipeline_VerifyEntry(pipeline, entry, keyid);
+            if (valid) {
+                verified++;
+            }
+            if (results != NULL) {
+                results[entry->index] = valid;
+            }
+            if (completion != NULL) {
+                completion(context, entry->index, entry->message, valid);
+            }
+        }
+
+        if (keyid != NULL) {
+            parcKeyId_Release(&keyid);
+        }
+        start = end;
+    }
+
+    return verified;
+}
+
+static size_t
+_ccnxValidationPipeline_RunBatch(CCNxValidationPipeline *pipeline, size_t count, CCNxTlvDictionary *messages[count],
+                                 bool results[], CCNxValidationPipelineCompletion *completion, void *context)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+    assertTrue(count == 0 || messages != NULL, "Parameter messages must be non-null");
+
+    if (count == 0) {
+        return 0;
+    }
+
+    _CCNxValidationPipelineEntry *entries = parcMemory_AllocateAndClear(count * sizeof(_CCNxValidationPipelineEntry));
+    assertNotNull(entries, "parcMemory_AllocateAndClear(%zu) returned NULL", count * sizeof(_CCNxValidationPipelineEntry));
+    for (size_t i = 0; i < count; i++) {
+        entries[i].index = i;
+        entries[i].message = messages[i];
+    }
+
+    _CCNxValidationPipelineBatch batch = { .entries = entries, .count = count, .next = 0 };
+
+    pthread_mutex_lock(&pipeline->batchLock);
+
+    // Hand the batch to the workers and work on it alongside them
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->batch = &batch;
+    pipeline->busyWorkers = pipeline->workerCount;
+    pipeline->generation++;
+    pthread_cond_broadcast(&pipeline->batchReady);
+    pthread_mutex_unlock(&pipeline->lock);
+
+    _ccnxValidationPipeline_PrepareBatch(&batch, &pipeline->hashers);
+
+    pthread_mutex_lock(&pipeline->lock);
+    while (pipeline->busyWorkers > 0) {
+        pthread_cond_wait(&pipeline->batchDone, &pipeline->lock);
+    }
+    pipeline->batch = NULL;
+    pthread_mutex_unlock(&pipeline->lock);
+
+    // Messages that could not be prepared fail without reaching the verifier
+    _CCNxValidationPipelineEntry **sorted = parcMemory_Allocate(count * sizeof(_CCNxValidationPipelineEntry *));
+    assertNotNull(sorted, "parcMemory_Allocate(%zu) returned NULL", count * sizeof(_CCNxValidationPipelineEntry *));
+    size_t prepared = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (entries[i].suite != NULL) {
+            sorted[prepared++] = &entries[i];
+        } else {
+            if (results != NULL) {
+                results[i] = false;
+            }
+            if (completion != NULL) {
+                completion(context, i, messages[i], false);
+            }
+        }
+    }
+
+    qsort(sorted, prepared, sizeof(_CCNxValidationPipelineEntry *), _ccnxValidationPipeline_CompareEntries);
+    size_t verified = _ccnxValidationPipeline_VerifyGroups(pipeline, prepared, sorted, results, completion, context);
+
+    pthread_mutex_unlock(&pipeline->batchLock);
+
+    for (size_t i = 0; i < count; i++) {
+        if (entries[i].hash != NULL) {
+            parcCryptoHash_Release(&entries[i].hash);
+        }
+    }
+    parcMemory_Deallocate((void **) &sorted);
+    parcMemory_Deallocate((void **) &entries);
+
+    return verified;
+}
+
+// ================================================================================
+
+static void
+_ccnxValidationPipeline_FinalRelease(CCNxValidationPipeline **pipelinePtr)
+{
+    CCNxValidationPipeline *pipeline = *pipelinePtr;
+
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->shutdown = true;
+    pthread_cond_broadcast(&pipeline->batchReady);
+    pthread_mutex_unlock(&pipeline->lock);
+
+    for (size_t i = 0; i < pipeline->workerCount; i++) {
+        pthread_join(pipeline->workers[i].thread, NULL);
+    }
+
+    if (pipeline->workers != NULL) {
+        parcMemory_Deallocate((void **) &pipeline->workers);
+    }
+    _ccnxValidationPipeline_ReleaseHashers(&pipeline->hashers);
+
+    pthread_cond_destroy(&pipeline->batchDone);
+    pthread_cond_destroy(&pipeline->batchReady);
+    pthread_mutex_destroy(&pipeline->lock);
+    pthread_mutex_destroy(&pipeline->batchLock);
+}
+
+parcObject_ExtendPARCObject(CCNxValidationPipeline, _ccnxValidationPipeline_FinalRelease, NULL, NULL, NULL, NULL, NULL, NULL);
+
+parcObject_ImplementAcquire(ccnxValidationPipeline, CCNxValidationPipeline);
+
+parcObject_ImplementRelease(ccnxValidationPipeline, CCNxValidationPipeline);
+
+CCNxValidationPipeline *
+ccnxValidationPipeline_Create(PARCVerifier *verifier, size_t workerCount)
+{
+    assertNotNull(verifier, "Parameter verifier must be non-null");
+
+    CCNxValidationPipeline *pipeline = parcObject_CreateInstance(CCNxValidationPipeline);
+    assertNotNull(pipeline, "parcObject_CreateInstance returned NULL");
+
+    pipeline->verifier = verifier;
+    pipeline->workerCount = workerCount;
+    pipeline->workers = NULL;
+    pipeline->hashers = (_CCNxValidationPipelineHashers) { NULL, NULL, NULL };
+    pipeline->batch = NULL;
+    pipeline->generation = 0;
+    pipeline->busyWorkers = 0;
+    pipeline->shutdown = false;
+
+    pthread_mutex_init(&pipeline->batchLock, NULL);
+    pthread_mutex_init(&pipeline->lock, NULL);
+    pthread_cond_init(&pipeline->batchReady, NULL);
+    pthread_cond_init(&pipeline->batchDone, NULL);
+
+    if (workerCount > 0) {
+        pipeline->workers = parcMemory_AllocateAndClear(workerCount * sizeof(_CCNxValidationPipelineWorker));
+        assertNotNull(pipeline->workers, "parcMemory_AllocateAndClear(%zu) returned NULL", workerCount * sizeof(_CCNxValidationPipelineWorker));
+
+        for (size_t i = 0; i < workerCount; i++) {
+            pipeline->workers[i].pipeline = pipeline;
+            int failure = pthread_create(&pipeline->workers[i].thread, NULL, _ccnxValidationPipeline_WorkerMain, &pipeline->workers[i]);
+            assertFalse(failure, "pthread_create failed: %d", failure);
+        }
+    }
+
+    return pipeline;
+}
+
+size_t
+ccnxValidationPipeline_GetWorkerCount(const CCNxValidationPipeline *pipeline)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+    return pipeline->workerCount;
+}
+
+size_t
+ccnxValidationPipeline_Verify(CCNxValidationPipeline *pipeline, size_t count, CCNxTlvDictionary *messages[count], bool results[count])
+{
+    assertTrue(count == 0 || results != NULL, "Parameter results must be non-null");
+    return _ccnxValidationPipeline_RunBatch(pipeline, count, messages, results, NULL, NULL);
+}
+
+size_t
+ccnxValidationPipeline_VerifyWithCompletion(CCNxValidationPipeline *pipeline, size_t count, CCNxTlvDictionary *messages[count],
+                                            CCNxValidationPipelineCompletion *completion, void *context)
+{
+    assertNotNull(completion, "Parameter completion must be non-null");
+    return _ccnxValidationPipeline_RunBatch(pipeline, count, messages, NULL, completion, context);
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file ccnxValidation_Pipeline.h
+ * @brief Verifies the signatures of a batch of decoded messages
+ *
+ * Verifying one message at a time hashes its protected region, looks up its KeyId in the
+ * verifier, and checks the signature, all on the calling thread.  A validation pipeline takes a
+ * batch of wire format messages decoded with ccnxCodecTlvPacket_BufferDecode() and splits that work:
+ *
+ *   - A pool of worker threads hashes the protected regions of the batch in parallel.  Each worker
+ *     keeps its own PARCCryptoHasher for each hash type, so hashing takes no lock.
+ *   - The calling thread then sorts the batch by crypto suite and KeyId and calls the verifier
+ *     once per message, creating the PARCKeyId once per group.  Consecutive calls for the same
+ *     KeyId find the same cached key object in the verifier.
+ *
+ * A keyed suite (HMAC-SHA256, HMAC-SHA512) can only be hashed with the verifier's hasher for the
+ * KeyId, so those messages are hashed on the calling thread, once per group.
+ *
+ * A message with no crypto suite, no validation payload, or no protected region fails validation.
+ *
+ * @code
+ * {
+ *     PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+ *     CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 3);
+ *
+ *     bool results[count];
+ *     size_t valid = ccnxValidationPipeline_Verify(pipeline, count, messages, results);
+ *
+ *     ccnxValidationPipeline_Release(&pipeline);
+ *     parcVerifier_Destroy(&verifier);
+ * }
+ * @endcode
+ *
+ */
+#ifndef CCNx_Common_ccnxValidation_Pipeline_h
+#define CCNx_Common_ccnxValidation_Pipeline_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <parc/security/parc_Verifier.h>
+#include <ccnx/common/internal/ccnx_TlvDictionary.h>
+
+struct ccnx_validation_pipeline;
+/**
+ * @typedef CCNxValidationPipeline
+ * @brief A worker pool that verifies batches of messages with one verifier
+ */
+typedef struct ccnx_validation_pipeline CCNxValidationPipeline;
+
+/**
+ * @typedef CCNxValidationPipelineCompletion
+ * @brief Called once for each message of a batch with its validation result
+ *
+ * `index` is the position of `message` in the batch.  Completions run on the thread that
+ * called ccnxValidationPipeline_VerifyWithCompletion(), grouped by KeyId, not in batch order.
+ */
+typedef void (CCNxValidationPipelineCompletion)(void *context, size_t index, CCNxTlvDictionary *message, bool valid);
+
+/**
+ * Creates a validation pipeline
+ *
+ * The pipeline starts `workerCount` threads that wait for batches.  The calling thread also hashes
+ * messages during a batch, so a `workerCount` of 0 verifies the whole batch on the calling thread.
+ *
+ * The pipeline does not take ownership of the verifier.  The verifier must outlive the pipeline and
+ * must not be used by another thread while a batch is running.
+ *
+ * @param [in] verifier The verifier used for every batch
+ * @param [in] workerCount The number of worker threads to start
+ *
+ * @return non-null An allocated pipeline
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 3);
+ *     ccnxValidationPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+CCNxValidationPipeline *ccnxValidationPipeline_Create(PARCVerifier *verifier, size_t workerCount);
+
+/**
+ * Returns a reference counted copy of the pipeline
+ *
+ * @param [in] pipeline An allocated pipeline
+ *
+ * @return non-null A reference counted copy
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationPipeline *copy = ccnxValidationPipeline_Acquire(pipeline);
+ *     ccnxValidationPipeline_Release(&copy);
+ * }
+ * @endcode
+ */
+CCNxValidationPipeline *ccnxValidationPipeline_Acquire(const CCNxValidationPipeline *pipeline);
+
+/**
+ * Releases a reference to the pipeline
+ *
+ * On the final release the worker threads are stopped and joined.
+ *
+ * @param [in,out] pipelinePtr A pointer to the pipeline, will be NULL'd
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 3);
+ *     ccnxValidationPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+void ccnxValidationPipeline_Release(CCNxValidationPipeline **pipelinePtr);
+
+/**
+ * The number of worker threads in the pipeline
+ *
+ * @param [in] pipeline An allocated pipeline
+ *
+ * @return number The workerCount given to ccnxValidationPipeline_Create()
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 3);
+ *     size_t workers = ccnxValidationPipeline_GetWorkerCount(pipeline);
+ *     // workers == 3
+ *     ccnxValidationPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+size_t ccnxValidationPipeline_GetWorkerCount(const CCNxValidationPipeline *pipeline);
+
+/**
+ * Verifies a batch of messages and stores the results in an array
+ *
+ * Each message must be a wire format message (ccnxWireFormatMessage_Create()) decoded with
+ * ccnxCodecTlvPacket_BufferDecode(), which sets its protected region.  The call returns when every message has been verified.  Only one batch
+ * runs at a time; a second caller waits for the first batch to finish.
+ *
+ * @param [in] pipeline An allocated pipeline
+ * @param [in] count The number of messages
+ * @param [in] messages The decoded messages
+ * @param [out] results `results[i]` is true if `messages[i]` has a valid signature
+ *
+ * @return number The number of messages with a valid signature
+ *
+ * Example:
+ * @code
+ * {
+ *     bool results[count];
+ *     size_t valid = ccnxValidationPipeline_Verify(pipeline, count, messages, results);
+ * }
+ * @endcode
+ */
+size_t ccnxValidationPipeline_Verify(CCNxValidationPipeline *pipeline, size_t count, CCNxTlvDictionary *messages[count], bool results[count]);
+
+/**
+ * Verifies a batch of messages and reports each result to a completion function
+ *
+ * Same as ccnxValidationPipeline_Verify(), except `completion` is called once for each message
+ * instead of filling in an array.  The completion runs on the calling thread before this function returns.
+ *
+ * @param [in] pipeline An allocated pipeline
+ * @param [in] count The number of messages
+ * @param [in] messages The decoded messages
+ * @param [in] completion Called with `context` for every message
+ * @param [in] context Passed to `completion`
+ *
+ * @return number The number of messages with a valid signature
+ *
+ * Example:
+ * @code
+ * static void
+ * _onVerified(void *context, size_t index, CCNxTlvDictionary *message, bool valid)
+ * {
+ *     if (valid) {
+ *         forwardMessage(context, message);
+ *     }
+ * }
+ *
+ * {
+ *     ccnxValidationPipeline_VerifyWithCompletion(pipeline, count, messages, _onVerified, forwarder);
+ * }
+ * @endcode
+ */
+size_t ccnxValidationPipeline_VerifyWithCompletion(CCNxValidationPipeline *pipeline, size_t count, CCNxTlvDictionary *messages[count],
+                                                   CCNxValidationPipelineCompletion *completion, void *context);
+#endif // CCNx_Common_ccnxValidation_Pipeline_h
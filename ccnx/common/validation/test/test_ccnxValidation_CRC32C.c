@@ -39,6 +39,11 @@
 
 #include <sys/time.h>
 
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_nameA_crc32c.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_crc32c.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_nameA_badcrc32c.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_keyid1_rsasha256.h>
+
 /*
  * Ground truth set derived from CRC RevEng http://reveng.sourceforge.net
  * e.g. reveng -c  -m CRC-32C 313233343536373839 gives the canonical check value 0xe306928e
@@ -71,6 +76,7 @@ LONGBOW_TEST_RUNNER(ccnxValidation_CRC32C)
     // Test Fixtures are run in the order specified, but all tests should be idempotent.
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -94,6 +100,12 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_CreateSigner);
     LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_CreateVerifier);
     LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_DictionaryCryptoSuiteValue);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_Compute);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_Compute_MatchesSoftware);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPacket);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPacket_Corrupt);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPacket_Truncated);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPackets);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -206,6 +218,200 @@ LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_DictionaryCryptoSuiteValue)
     ccnxTlvDictionary_Release(&dictionary);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_Compute)
+{
+    for (int i = 0; vectors[i].buffer != NULL; i++) {
+        uint32_t testCrc = ccnxValidationCRC32C_Compute(vectors[i].length, vectors[i].buffer);
+        assertTrue(testCrc == vectors[i].crc32c,
+                   "CRC32C values wrong (%s), index %d got 0x%08x expected 0x%08x\n",
+                   ccnxValidationCRC32C_GetImplementationName(), i, testCrc, vectors[i].crc32c);
+    }
+
+    assertTrue(ccnxValidationCRC32C_Compute(0, NULL) == 0, "CRC32C of nothing should be 0");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_Compute_MatchesSoftware)
+{
+    // Every length and alignment through a few words must match the table implementation
+    uint8_t buffer[300];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t) (i * 31 + 7);
+    }
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length + offset <= sizeof(buffer); length++) {
+            uint32_t truth = _crc32c_UpdateSoftware(0xFFFFFFFF, buffer + offset, length) ^ 0xFFFFFFFF;
+            uint32_t test = ccnxValidationCRC32C_Compute(length, buffer + offset);
+            assertTrue(test == truth, "%s differs from software, offset %zu length %zu got 0x%08x expected 0x%08x",
+                       ccnxValidationCRC32C_GetImplementationName(), offset, length, test, truth);
+        }
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPacket)
+{
+    assertTrue(ccnxValidationCRC32C_VerifyPacket(sizeof(v1_interest_nameA_crc32c), v1_interest_nameA_crc32c),
+               "Interest should verify");
+    assertTrue(ccnxValidationCRC32C_VerifyPacket(sizeof(v1_content_nameA_crc32c), v1_content_nameA_crc32c),
+               "Content Object should verify");
+    assertFalse(ccnxValidationCRC32C_VerifyPacket(sizeof(v1_interest_nameA_badcrc32c), v1_interest_nameA_badcrc32c),
+                "Bad CRC should not verify");
+    assertFalse(ccnxValidationCRC32C_VerifyPacket(sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256),
+                "RSA-SHA256 packet should not verify as CRC32C");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPacket_Corrupt)
+{
+    uint8_t packet[sizeof(v1_interest_nameA_crc32c)];
+
+    // Flip one bit at a time in the signed region and in the CRC
+    size_t start = v1_interest_nameA_crc32c[7];
+    for (size_t i = start; i < sizeof(packet); i++) {
+        memcpy(packet, v1_interest_nameA_crc32c, sizeof(packet));
+        packet[i] ^= 0x10;
+        assertFalse(ccnxValidationCRC32C_VerifyPacket(sizeof(packet), packet), "Corrupt byte %zu should not verify", i);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPacket_Truncated)
+{
+    for (size_t length = 0; length < sizeof(v1_interest_nameA_crc32c); length++) {
+        assertFalse(ccnxValidationCRC32C_VerifyPacket(length, v1_interest_nameA_crc32c), "Truncated to %zu should not verify", length);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_VerifyPackets)
+{
+    uint8_t corrupt[sizeof(v1_interest_nameA_crc32c)];
+    memcpy(corrupt, v1_interest_nameA_crc32c, sizeof(corrupt));
+    corrupt[40] ^= 0x01;
+
+    // Mixed lengths, so the interleaved path has to finish each packet on its own
+    struct iovec packets[] = {
+        { .iov_base = v1_interest_nameA_crc32c,           .iov_len = sizeof(v1_interest_nameA_crc32c)           },
+        { .iov_base = v1_content_nameA_crc32c,            .iov_len = sizeof(v1_content_nameA_crc32c)            },
+        { .iov_base = v1_interest_nameA_crc32c,           .iov_len = sizeof(v1_interest_nameA_crc32c)           },
+        { .iov_base = corrupt,                            .iov_len = sizeof(corrupt)                            },
+        { .iov_base = v1_content_nameA_keyid1_rsasha256,  .iov_len = sizeof(v1_content_nameA_keyid1_rsasha256)  },
+        { .iov_base = v1_content_nameA_crc32c,            .iov_len = sizeof(v1_content_nameA_crc32c)            },
+        { .iov_base = v1_interest_nameA_badcrc32c,        .iov_len = sizeof(v1_interest_nameA_badcrc32c)        },
+        { .iov_base = v1_interest_nameA_crc32c,           .iov_len = sizeof(v1_interest_nameA_crc32c)           },
+        { .iov_base = v1_content_nameA_crc32c,            .iov_len = sizeof(v1_content_nameA_crc32c)            },
+        { .iov_base = v1_interest_nameA_crc32c,           .iov_len = 10                                         },
+    };
+    bool truth[] = { true, true, true, false, false, true, false, true, true, false };
+    size_t count = sizeof(packets) / sizeof(packets[0]);
+
+    bool results[count];
+    size_t verified = ccnxValidationCRC32C_VerifyPackets(count, packets, results);
+    assertTrue(verified == 6, "Wrong verified count, got %zu expected 6", verified);
+    for (size_t i = 0; i < count; i++) {
+        assertTrue(results[i] == truth[i], "Wrong result for packet %zu, got %d expected %d", i, results[i], truth[i]);
+    }
+
+    assertTrue(ccnxValidationCRC32C_VerifyPackets(0, NULL, NULL) == 0, "Empty batch should verify nothing");
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxValidationCRC32C_Verify);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_elapsedMicroseconds(struct timeval *start, struct timeval *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1E+6 + (end->tv_usec - start->tv_usec);
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxValidationCRC32C_Verify)
+{
+    // 1500 byte packets: 24 byte header, a Content Object, CRC32C validation
+    const size_t packetLength = 1500;
+    const size_t batch = 32;
+    const int iterations = 2000;
+
+    uint8_t *packets = parcMemory_Allocate(packetLength * batch);
+    assertNotNull(packets, "parcMemory_Allocate(%zu) returned NULL", packetLength * batch);
+    struct iovec vec[batch];
+
+    for (size_t i = 0; i < batch; i++) {
+        uint8_t *packet = packets + i * packetLength;
+        size_t messageLength = packetLength - 8 - 8 - 8 - 4;
+        memset(packet, 0, packetLength);
+        packet[0] = 1;
+        packet[1] = 1;
+        packet[2] = (uint8_t) (packetLength >> 8);
+        packet[3] = (uint8_t) packetLength;
+        packet[7] = 8;
+        packet[9] = CCNxCodecSchemaV1Types_MessageType_ContentObject;
+        packet[10] = (uint8_t) (messageLength >> 8);
+        packet[11] = (uint8_t) messageLength;
+        for (size_t j = 0; j < messageLength; j++) {
+            packet[12 + j] = (uint8_t) (i + j);
+        }
+
+        uint8_t *alg = packet + 12 + messageLength;
+        alg[1] = CCNxCodecSchemaV1Types_MessageType_ValidationAlg;
+        alg[3] = 4;
+        alg[5] = CCNxCodecSchemaV1Types_ValidationAlg_CRC32C;
+
+        uint8_t *payload = alg + 8;
+        uint32_t crc = ccnxValidationCRC32C_Compute(payload - (packet + 8), packet + 8);
+        payload[1] = CCNxCodecSchemaV1Types_MessageType_ValidationPayload;
+        payload[3] = 4;
+        payload[4] = (uint8_t) (crc >> 24);
+        payload[5] = (uint8_t) (crc >> 16);
+        payload[6] = (uint8_t) (crc >> 8);
+        payload[7] = (uint8_t) crc;
+
+        vec[i].iov_base = packet;
+        vec[i].iov_len = packetLength;
+    }
+
+    struct timeval t0, t1;
+    bool results[batch];
+
+    const _CRC32CImplementation *selected = _crc32c_GetImplementation();
+    const _CRC32CImplementation *implementations[] = { &_crc32cSoftware, selected };
+    for (int k = 0; k < 2; k++) {
+        _crc32cImplementation = implementations[k];
+
+        gettimeofday(&t0, NULL);
+        for (int i = 0; i < iterations; i++) {
+            for (size_t j = 0; j < batch; j++) {
+                assertTrue(ccnxValidationCRC32C_VerifyPacket(packetLength, vec[j].iov_base), "Packet %zu did not verify", j);
+            }
+        }
+        gettimeofday(&t1, NULL);
+        printf("%-10s VerifyPacket  %8.1f ns/packet\n", _crc32cImplementation->name,
+               _elapsedMicroseconds(&t0, &t1) * 1000.0 / (iterations * batch));
+
+        gettimeofday(&t0, NULL);
+        for (int i = 0; i < iterations; i++) {
+            size_t verified = ccnxValidationCRC32C_VerifyPackets(batch, vec, results);
+            assertTrue(verified == batch, "Only %zu of %zu verified", verified, batch);
+        }
+        gettimeofday(&t1, NULL);
+        printf("%-10s VerifyPackets %8.1f ns/packet\n", _crc32cImplementation->name,
+               _elapsedMicroseconds(&t0, &t1) * 1000.0 / (iterations * batch));
+    }
+    _crc32cImplementation = selected;
+
+    parcMemory_Deallocate((void **) &packets);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Patent rights are not granted under this agreement. Patent rights are
+ *       available under FRAND terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX or PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
+ * @copyright 2013-2015, Xerox Corporation (Xerox)and Palo Alto Research Center (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxValidation_Pipeline.c"
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <LongBow/unit-test.h>
+
+#include <sys/time.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
+#include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_crc32c.h>
+
+// The offset of the 'h' of "hello" in v1_content_nameA_crc32c, inside the protected region
+#define _crc32cNameOffset 56
+
+/*
+ * Decodes a copy of v1_content_nameA_crc32c.  If `corrupt` is true, one byte of the name is
+ * changed so the CRC no longer matches.
+ */
+static CCNxTlvDictionary *
+_createCrc32cMessage(bool corrupt)
+{
+    PARCBuffer *packet = parcBuffer_Allocate(sizeof(v1_content_nameA_crc32c));
+    parcBuffer_PutArray(packet, sizeof(v1_content_nameA_crc32c), v1_content_nameA_crc32c);
+    parcBuffer_Flip(packet);
+
+    if (corrupt) {
+        uint8_t *bytes = parcBuffer_Overlay(packet, 0);
+        bytes[_crc32cNameOffset] ^= 0x01;
+    }
+
+    // The wire format message keeps the packet so the protected region can be hashed
+    CCNxWireFormatMessage *message = ccnxWireFormatMessage_Create(packet);
+    bool success = ccnxCodecTlvPacket_BufferDecode(packet, ccnxWireFormatMessage_GetDictionary(message));
+    assertTrue(success, "Could not decode v1_content_nameA_crc32c");
+    parcBuffer_Release(&packet);
+    return message;
+}
+
+/*
+ * Creates a wire format message whose whole body is protected by an HMAC-SHA256 with `secretKey`.
+ */
+static CCNxTlvDictionary *
+_createHmacMessage(PARCBuffer *secretKey, PARCBuffer *keyid, uint8_t fill, bool corrupt)
+{
+    uint8_t body[100];
+    memset(body, fill, sizeof(body));
+
+    uint8_t mac[SHA256_DIGEST_LENGTH];
+    unsigned macLength;
+    HMAC(EVP_sha256(), parcBuffer_Overlay(secretKey, 0), (int) parcBuffer_Remaining(secretKey), body, sizeof(body), mac, &macLength);
+
+    if (corrupt) {
+        body[50] ^= 0x01;
+    }
+
+    PARCBuffer *wireFormat = parcBuffer_Allocate(sizeof(body));
+    parcBuffer_PutArray(wireFormat, sizeof(body), body);
+    parcBuffer_Flip(wireFormat);
+
+    CCNxTlvDictionary *message = ccnxWireFormatMessage_FromContentObjectPacketType(CCNxTlvDictionary_SchemaVersion_V1, wireFormat);
+    ccnxWireFormatMessage_SetProtectedRegionStart(message, 0);
+    ccnxWireFormatMessage_SetProtectedRegionLength(message, sizeof(body));
+
+    ccnxTlvDictionary_PutInteger(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE, PARCCryptoSuite_HMAC_SHA256);
+    if (keyid != NULL) {
+        ccnxValidationFacadeV1_SetKeyId(message, keyid);
+    }
+
+    PARCBuffer *payload = parcBuffer_Allocate(macLength);
+    parcBuffer_PutArray(payload, macLength, mac);
+    parcBuffer_Flip(payload);
+    ccnxValidationFacadeV1_SetPayload(message, payload);
+
+    parcBuffer_Release(&payload);
+    parcBuffer_Release(&wireFormat);
+    return message;
+}
+
+static void
+_releaseMessages(size_t count, CCNxTlvDictionary *messages[count])
+{
+    for (size_t i = 0; i < count; i++) {
+        ccnxTlvDictionary_Release(&messages[i]);
+    }
+}
+
+LONGBOW_TEST_RUNNER(ccnxValidation_Pipeline)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxValidation_Pipeline)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxValidation_Pipeline)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_Verify_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_Verify_Crc32c);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_Verify_NoWorkers);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_Verify_HmacKeyGroups);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_Verify_Unsigned);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationPipeline_VerifyWithCompletion);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_Create)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 3);
+    assertNotNull(pipeline, "Got null pipeline");
+    assertTrue(ccnxValidationPipeline_GetWorkerCount(pipeline) == 3,
+               "Wrong worker count, got %zu expected 3", ccnxValidationPipeline_GetWorkerCount(pipeline));
+
+    ccnxValidationPipeline_Release(&pipeline);
+    assertNull(pipeline, "Release did not null the pointer");
+    parcVerifier_Destroy(&verifier);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_Acquire)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 1);
+
+    CCNxValidationPipeline *copy = ccnxValidationPipeline_Acquire(pipeline);
+    assertTrue(copy == pipeline, "Acquire should return the same pipeline");
+
+    ccnxValidationPipeline_Release(&copy);
+    ccnxValidationPipeline_Release(&pipeline);
+    parcVerifier_Destroy(&verifier);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_Verify_Empty)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 2);
+
+    size_t valid = ccnxValidationPipeline_Verify(pipeline, 0, NULL, NULL);
+    assertTrue(valid == 0, "An empty batch should have no valid messages, got %zu", valid);
+
+    ccnxValidationPipeline_Release(&pipeline);
+    parcVerifier_Destroy(&verifier);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_Verify_Crc32c)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 3);
+
+    const size_t count = 64;
+    CCNxTlvDictionary *messages[count];
+    bool results[count];
+    for (size_t i = 0; i < count; i++) {
+        messages[i] = _createCrc32cMessage(i % 7 == 3);
+    }
+
+    // Each batch reuses the same workers
+    for (int pass = 0; pass < 3; pass++) {
+        memset(results, 0, sizeof(results));
+        size_t valid = ccnxValidationPipeline_Verify(pipeline, count, messages, results);
+
+        size_t expected = 0;
+        for (size_t i = 0; i < count; i++) {
+            bool good = (i % 7 != 3);
+            expected += good ? 1 : 0;
+            assertTrue(results[i] == good, "Pass %d message %zu wrong result, got %d expected %d", pass, i, results[i], good);
+        }
+        assertTrue(valid == expected, "Pass %d wrong valid count, got %zu expected %zu", pass, valid, expected);
+    }
+
+    _releaseMessages(count, messages);
+    ccnxValidationPipeline_Release(&pipeline);
+    parcVerifier_Destroy(&verifier);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_Verify_NoWorkers)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 0);
+
+    CCNxTlvDictionary *messages[] = { _createCrc32cMessage(false), _createCrc32cMessage(true) };
+    bool results[2];
+    size_t valid = ccnxValidationPipeline_Verify(pipeline, 2, messages, results);
+
+    assertTrue(valid == 1, "Wrong valid count, got %zu expected 1", valid);
+    assertTrue(results[0], "The good message should verify");
+    assertFalse(results[1], "The corrupt message should not verify");
+
+    _releaseMessages(2, messages);
+    ccnxValidationPipeline_Release(&pipeline);
+    parcVerifier_Destroy(&verifier);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_Verify_HmacKeyGroups)
+{
+    char keyString1[] = "0123456789ABCDEF0123456789ABCDEF";
+    char keyString2[] = "the other secret key";
+    char keyString3[] = "a key the verifier does not have";
+    PARCBuffer *secretKeys[] = {
+        parcBuffer_WrapCString(keyString1),
+        parcBuffer_WrapCString(keyString2),
+        parcBuffer_WrapCString(keyString3),
+    };
+    PARCBuffer *keyids[] = {
+        parcBuffer_WrapCString("keyid one"),
+        parcBuffer_WrapCString("keyid two"),
+        parcBuffer_WrapCString("keyid three"),
+    };
+
+    PARCVerifier *verifier = ccnxValidationHmacSha256_CreateVerifier(NULL);
+    for (int k = 0; k < 2; k++) {
+        PARCKeyId *keyid = parcKeyId_Create(keyids[k]);
+        PARCKey *key = parcKey_CreateFromSymmetricKey(keyid, PARCSigningAlgorithm_HMAC, secretKeys[k]);
+        parcVerifier_AddKey(verifier, key);
+        parcKey_Release(&key);
+        parcKeyId_Release(&keyid);
+    }
+
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 2);
+
+    // The keys are interleaved so the pipeline has to regroup them
+    const size_t count = 30;
+    CCNxTlvDictionary *messages[count];
+    bool expected[count];
+    for (size_t i = 0; i < count; i++) {
+        size_t k = i % 3;
+        bool corrupt = (i == 4);
+        messages[i] = _createHmacMessage(secretKeys[k], keyids[k], (uint8_t) i, corrupt);
+        expected[i] = (k != 2) && !corrupt;
+    }
+
+    bool results[count];
+    size_t valid = ccnxValidationPipeline_Verify(pipeline, count, messages, results);
+
+    size_t expectedValid = 0;
+    for (size_t i = 0; i < count; i++) {
+        expectedValid += expected[i] ? 1 : 0;
+        assertTrue(results[i] == expected[i], "Message %zu wrong result, got %d expected %d", i, results[i], expected[i]);
+    }
+    assertTrue(valid == expectedValid, "Wrong valid count, got %zu expected %zu", valid, expectedValid);
+
+    _releaseMessages(count, messages);
+    ccnxValidationPipeline_Release(&pipeline);
+    parcVerifier_Destroy(&verifier);
+    for (int k = 0; k < 3; k++) {
+        parcBuffer_Release(&secretKeys[k]);
+        parcBuffer_Release(&keyids[k]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_Verify_Unsigned)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 2);
+
+    // No crypto suite
+    PARCBuffer *wireFormat = parcBuffer_Allocate(16);
+    CCNxTlvDictionary *unsigned1 = ccnxWireFormatMessage_FromContentObjectPacketType(CCNxTlvDictionary_SchemaVersion_V1, wireFormat);
+
+    // A crypto suite, but no validation payload
+    CCNxTlvDictionary *unsigned2 = ccnxWireFormatMessage_FromContentObjectPacketType(CCNxTlvDictionary_SchemaVersion_V1, wireFormat);
+    ccnxTlvDictionary_PutInteger(unsigned2, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE, PARCCryptoSuite_NULL_CRC32C);
+
+    CCNxTlvDictionary *messages[] = { unsigned1, _createCrc32cMessage(false), unsigned2 };
+    bool results[3];
+    size_t valid = ccnxValidationPipeline_Verify(pipeline, 3, messages, results);
+
+    assertTrue(valid == 1, "Wrong valid count, got %zu expected 1", valid);
+    assertFalse(results[0], "A message without a crypto suite should not verify");
+    assertTrue(results[1], "The signed message should verify");
+    assertFalse(results[2], "A message without a validation payload should not verify");
+
+    _releaseMessages(3, messages);
+    parcBuffer_Release(&wireFormat);
+    ccnxValidationPipeline_Release(&pipeline);
+    parcVerifier_Destroy(&verifier);
+}
+
+typedef struct completion_state {
+    size_t calls;
+    size_t validCalls;
+    bool seen[16];
+    bool valid[16];
+} _CompletionState;
+
+static void
+_testCompletion(void *context, size_t index, CCNxTlvDictionary *message, bool valid)
+{
+    _CompletionState *state = context;
+    assertTrue(index < 16, "Index out of range: %zu", index);
+    assertFalse(state->seen[index], "Index %zu completed twice", index);
+    assertNotNull(message, "Completion got a null message");
+
+    state->seen[index] = true;
+    state->valid[index] = valid;
+    state->calls++;
+    state->validCalls += valid ? 1 : 0;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationPipeline_VerifyWithCompletion)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+    CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, 3);
+
+    CCNxTlvDictionary *messages[16];
+    for (size_t i = 0; i < 16; i++) {
+        messages[i] = _createCrc32cMessage(i == 5 || i == 11);
+    }
+
+    _CompletionState state;
+    memset(&state, 0, sizeof(state));
+    size_t valid = ccnxValidationPipeline_VerifyWithCompletion(pipeline, 16, messages, _testCompletion, &state);
+
+    assertTrue(state.calls == 16, "Wrong number of completions, got %zu expected 16", state.calls);
+    assertTrue(valid == 14 && state.validCalls == 14, "Wrong valid count, got %zu and %zu expected 14", valid, state.validCalls);
+    for (size_t i = 0; i < 16; i++) {
+        bool good = !(i == 5 || i == 11);
+        assertTrue(state.valid[i] == good, "Message %zu wrong result, got %d expected %d", i, state.valid[i], good);
+    }
+
+    _releaseMessages(16, messages);
+    ccnxValidationPipeline_Release(&pipeline);
+    parcVerifier_Destroy(&verifier);
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxValidationPipeline_FindSuite);
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxValidationPipeline_CompareEntries);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Local, _ccnxValidationPipeline_FindSuite)
+{
+    const _CCNxValidationPipelineSuite *suite = _ccnxValidationPipeline_FindSuite(PARCCryptoSuite_EC_SECP_256K1);
+    assertNotNull(suite, "EC-SECP-256K1 should be supported");
+    assertFalse(suite->keyed, "EC-SECP-256K1 should be hashed by the workers");
+    assertTrue(suite->hashType == PARC_HASH_SHA256, "EC-SECP-256K1 should use SHA-256");
+
+    suite = _ccnxValidationPipeline_FindSuite(PARCCryptoSuite_HMAC_SHA256);
+    assertNotNull(suite, "HMAC-SHA256 should be supported");
+    assertTrue(suite->keyed, "HMAC-SHA256 should be hashed with the verifier's hasher");
+
+    assertNull(_ccnxValidationPipeline_FindSuite(PARCCryptoSuite_UNKNOWN), "An unknown suite should not be found");
+}
+
+LONGBOW_TEST_CASE(Local, _ccnxValidationPipeline_CompareEntries)
+{
+    const _CCNxValidationPipelineSuite *suite = _ccnxValidationPipeline_FindSuite(PARCCryptoSuite_RSA_SHA256);
+    PARCBuffer *keyidA = parcBuffer_WrapCString("key a");
+    PARCBuffer *keyidA2 = parcBuffer_WrapCString("key a");
+    PARCBuffer *keyidB = parcBuffer_WrapCString("key b");
+
+    _CCNxValidationPipelineEntry a = { .suite = suite, .keyid = keyidA, .keyidHashCode = parcBuffer_HashCode(keyidA) };
+    _CCNxValidationPipelineEntry a2 = { .suite = suite, .keyid = keyidA2, .keyidHashCode = parcBuffer_HashCode(keyidA2) };
+    _CCNxValidationPipelineEntry b = { .suite = suite, .keyid = keyidB, .keyidHashCode = parcBuffer_HashCode(keyidB) };
+    _CCNxValidationPipelineEntry none = { .suite = suite, .keyid = NULL, .keyidHashCode = 0 };
+
+    assertTrue(_ccnxValidationPipeline_SameGroup(&a, &a2), "Equal KeyIds should be in the same group");
+    assertFalse(_ccnxValidationPipeline_SameGroup(&a, &b), "Different KeyIds should be in different groups");
+    assertTrue(_ccnxValidationPipeline_SameGroup(&none, &none), "Entries without a KeyId should be in the same group");
+    assertFalse(_ccnxValidationPipeline_SameGroup(&none, &a), "No KeyId and a KeyId should be in different groups");
+
+    const _CCNxValidationPipelineEntry *pa = &a;
+    const _CCNxValidationPipelineEntry *pnone = &none;
+    assertTrue(_ccnxValidationPipeline_CompareEntries(&pnone, &pa) < 0, "No KeyId should sort first");
+    assertTrue(_ccnxValidationPipeline_CompareEntries(&pa, &pnone) > 0, "No KeyId should sort first");
+
+    parcBuffer_Release(&keyidA);
+    parcBuffer_Release(&keyidA2);
+    parcBuffer_Release(&keyidB);
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxValidationPipeline_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_elapsedMicroseconds(struct timeval *start, struct timeval *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1E+6 + (end->tv_usec - start->tv_usec);
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxValidationPipeline_Throughput)
+{
+    PARCVerifier *verifier = ccnxValidationCRC32C_CreateVerifier();
+
+    const size_t count = 4096;
+    CCNxTlvDictionary **messages = parcMemory_Allocate(count * sizeof(CCNxTlvDictionary *));
+    bool *results = parcMemory_Allocate(count * sizeof(bool));
+    for (size_t i = 0; i < count; i++) {
+        messages[i] = _createCrc32cMessage(false);
+    }
+
+    size_t workerCounts[] = { 0, 1, 3, 7 };
+    for (size_t w = 0; w < sizeof(workerCounts) / sizeof(workerCounts[0]); w++) {
+        CCNxValidationPipeline *pipeline = ccnxValidationPipeline_Create(verifier, workerCounts[w]);
+
+        struct timeval t0, t1;
+        gettimeofday(&t0, NULL);
+        size_t valid = ccnxValidationPipeline_Verify(pipeline, count, messages, results);
+        gettimeofday(&t1, NULL);
+        assertTrue(valid == count, "Wrong valid count, got %zu expected %zu", valid, count);
+
+        printf("workers %zu: %.3f usec/message\n", workerCounts[w], _elapsedMicroseconds(&t0, &t1) / count);
+        ccnxValidationPipeline_Release(&pipeline);
+    }
+
+    _releaseMessages(count, messages);
+    parcMemory_Deallocate((void **) &results);
+    parcMemory_Deallocate((void **) &messages);
+    parcVerifier_Destroy(&verifier);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxValidation_Pipeline);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}